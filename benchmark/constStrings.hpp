@@ -33,6 +33,8 @@ std::string const pySuffix = "]\n"
                              "    g.savefig('%1%.png', bbox_inches='tight', dpi=150)\n";
 
 std::string const bench_mpp = "\nBenchmarking mp++.";
+std::string const bench_mpp_batch = "\n\nBenchmarking mp++ (batch).";
+std::string const bench_mpp_dot = "\n\nBenchmarking mp++ (dot).";
 std::string const bench_cpp_int = "\n\nBenchmarking cpp_int.";
 std::string const bench_mpz_int = "\n\nBenchmarking mpz_int.";
 std::string const bench_fmpzxx =  "\n\nBenchmarking fmpzxx.";
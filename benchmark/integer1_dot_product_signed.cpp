@@ -92,6 +92,43 @@ int main()
         s += "['mp++','total'," + std::to_string(st1.elapsed()) + "],";
         std::cout << totalRuntime;
     }
+    {
+        std::cout << bench_mpp_batch;
+        simple_timer st1;
+        double init_time;
+        auto p = get_init_vectors<integer_t>(init_time);
+        std::vector<integer_t> prods(size);
+        s += "['mp++ (batch)','init'," + std::to_string(init_time) + "],";
+        {
+            simple_timer st2;
+            batch::mul(prods.data(), p.first.data(), p.second.data(), size);
+            integer_t ret(0);
+            for (auto i = 0ul; i < size; ++i) {
+                add(ret, ret, prods[i]);
+            }
+            std::cout << " / " << ret;
+            s += "['mp++ (batch)','operation'," + std::to_string(st2.elapsed()) + "],";
+            std::cout << operRuntime;
+        }
+        s += "['mp++ (batch)','total'," + std::to_string(st1.elapsed()) + "],";
+        std::cout << totalRuntime;
+    }
+    {
+        std::cout << bench_mpp_dot;
+        simple_timer st1;
+        double init_time;
+        auto p = get_init_vectors<integer_t>(init_time);
+        s += "['mp++ (dot)','init'," + std::to_string(init_time) + "],";
+        {
+            simple_timer st2;
+            const auto ret = dot(p.first.begin(), p.first.end(), p.second.begin(), integer_t{});
+            std::cout << " / " << ret;
+            s += "['mp++ (dot)','operation'," + std::to_string(st2.elapsed()) + "],";
+            std::cout << operRuntime;
+        }
+        s += "['mp++ (dot)','total'," + std::to_string(st1.elapsed()) + "],";
+        std::cout << totalRuntime;
+    }
     {
         std::cout << "\n\nBenchmarking int64.";
         simple_timer st1;
@@ -0,0 +1,94 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <mp++/mp++.hpp>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "constStrings.hpp"
+#include "simple_timer.hpp"
+
+#include <boost/format.hpp>
+
+using namespace mppp;
+using namespace mppp_bench;
+
+static std::mt19937 rng;
+
+using integer_t = integer<1>;
+static const std::string name = "integer1_parallel_reductions";
+
+constexpr auto size = 30000000ul;
+constexpr auto prod_size = 300000ul;
+
+static inline std::vector<integer_t> get_init_vector(unsigned long n, int min, int max)
+{
+    std::uniform_int_distribution<int> dist(min, max);
+    std::vector<integer_t> retval(n);
+    std::generate(retval.begin(), retval.end(), [&dist]() { return integer_t(dist(rng)); });
+    return retval;
+}
+
+int main()
+{
+    // Warm up.
+    for (auto volatile counter = 0ull; counter < 1000000000ull; ++counter) {
+    }
+    // Setup of the python output.
+    std::string s = pyPrefix;
+    rng.seed(1);
+    std::cout << "\nParallel reductions 1\n----------------------------------" << std::endl;
+    std::vector<integer_t> v1, v2, v3;
+    {
+        simple_timer st;
+        v1 = get_init_vector(size, -10, 10);
+        v2 = get_init_vector(size, -10, 10);
+        v3 = get_init_vector(prod_size, 1, 10);
+        std::cout << initRuntime;
+    }
+    const auto max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    for (auto nt = 1u; nt <= max_threads; ++nt) {
+        const auto lib_name = "mp++ (" + std::to_string(nt) + " thread" + (nt > 1u ? "s" : "") + ")";
+        std::cout << "\n\nBenchmarking " << lib_name << ".";
+        simple_timer st1;
+        {
+            simple_timer st2;
+            const auto ret = parallel_sum(v1.begin(), v1.end(), nt);
+            std::cout << " / " << ret;
+            s += "['" + lib_name + "','sum'," + std::to_string(st2.elapsed()) + "],";
+            std::cout << operRuntime;
+        }
+        {
+            simple_timer st2;
+            const auto ret = parallel_dot(v1.begin(), v1.end(), v2.begin(), nt);
+            std::cout << " / " << ret;
+            s += "['" + lib_name + "','dot'," + std::to_string(st2.elapsed()) + "],";
+            std::cout << operRuntime;
+        }
+        {
+            simple_timer st2;
+            const auto ret = parallel_product(v3.begin(), v3.end(), nt);
+            std::cout << " / " << ret.nbits() << " bits";
+            s += "['" + lib_name + "','product'," + std::to_string(st2.elapsed()) + "],";
+            std::cout << operRuntime;
+        }
+        s += "['" + lib_name + "','total'," + std::to_string(st1.elapsed()) + "],";
+        std::cout << totalRuntime;
+    }
+    s += boost::str(boost::format(pySuffix) % name);
+    std::ofstream of(name + ".py", std::ios_base::trunc);
+    of << s;
+    of.close();
+    std::cout << "\n\n" << std::flush;
+}
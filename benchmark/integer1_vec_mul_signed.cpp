@@ -96,6 +96,23 @@ int main()
         s += "['mp++','total'," + std::to_string(st1.elapsed()) + "],";
         std::cout << totalRuntime;
     }
+    {
+        std::cout << bench_mpp_batch;
+        simple_timer st1;
+        double init_time;
+        auto p = get_init_vectors<integer_t>(init_time);
+        s += "['mp++ (batch)','init'," + std::to_string(init_time) + "],";
+        {
+            simple_timer st2;
+            batch::mul(std::get<3>(p).data(), std::get<0>(p).data(), std::get<1>(p).data(), size);
+            batch::add(std::get<3>(p).data(), std::get<2>(p).data(), std::get<3>(p).data(), size);
+            std::cout << " / " << std::get<3>(p)[size - 1u];
+            s += "['mp++ (batch)','operation'," + std::to_string(st2.elapsed()) + "],";
+            std::cout << operRuntime;
+        }
+        s += "['mp++ (batch)','total'," + std::to_string(st1.elapsed()) + "],";
+        std::cout << totalRuntime;
+    }
     {
         std::cout << "\n\nBenchmarking int64.";
         simple_timer st1;
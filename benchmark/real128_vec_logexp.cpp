@@ -0,0 +1,121 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <mp++/mp++.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "constStrings.hpp"
+#include "simple_timer.hpp"
+
+#include <boost/format.hpp>
+
+using namespace mppp;
+using namespace mppp_bench;
+
+static std::mt19937 rng;
+
+static const std::string name = "real128_vec_logexp";
+
+constexpr auto size = 1000000ul;
+
+static inline std::vector<real128> get_init_vector(double &init_time)
+{
+    rng.seed(1);
+    std::uniform_real_distribution<double> dist(0.001, 100.);
+    simple_timer st;
+    std::vector<real128> v(size);
+    std::generate(v.begin(), v.end(), [&dist]() { return real128{dist(rng)} / 3; });
+    std::cout << initRuntime;
+    init_time = st.elapsed();
+    return v;
+}
+
+int main()
+{
+    // Warm up.
+    for (auto volatile counter = 0ull; counter < 1000000000ull; ++counter) {
+    }
+    // Setup of the python output.
+    std::string s = pyPrefix;
+    std::cout << "\nVector exp/log/sin/cos real128\n----------------------------------" << std::endl;
+    double init_time;
+    const auto v = get_init_vector(init_time);
+    std::vector<real128> out(size);
+    {
+        std::cout << "\n" << bench_mpp;
+        simple_timer st1;
+        s += "['mp++','init'," + std::to_string(init_time) + "],";
+        {
+            simple_timer st2;
+            std::transform(v.begin(), v.end(), out.begin(), [](const real128 &x) { return exp(x); });
+            std::cout << " / " << out[size - 1u];
+            s += "['mp++','exp'," + std::to_string(st2.elapsed()) + "],";
+        }
+        {
+            simple_timer st2;
+            std::transform(v.begin(), v.end(), out.begin(), [](const real128 &x) { return log(x); });
+            std::cout << " / " << out[size - 1u];
+            s += "['mp++','log'," + std::to_string(st2.elapsed()) + "],";
+        }
+        {
+            simple_timer st2;
+            std::transform(v.begin(), v.end(), out.begin(), [](const real128 &x) { return sin(x); });
+            std::cout << " / " << out[size - 1u];
+            s += "['mp++','sin'," + std::to_string(st2.elapsed()) + "],";
+        }
+        {
+            simple_timer st2;
+            std::transform(v.begin(), v.end(), out.begin(), [](const real128 &x) { return cos(x); });
+            std::cout << " / " << out[size - 1u];
+            s += "['mp++','cos'," + std::to_string(st2.elapsed()) + "],";
+        }
+        s += "['mp++','total'," + std::to_string(st1.elapsed()) + "],";
+        std::cout << totalRuntime;
+    }
+    {
+        std::cout << bench_mpp_batch;
+        simple_timer st1;
+        s += "['mp++ (batch)','init'," + std::to_string(init_time) + "],";
+        {
+            simple_timer st2;
+            batch::exp(out.data(), v.data(), size);
+            std::cout << " / " << out[size - 1u];
+            s += "['mp++ (batch)','exp'," + std::to_string(st2.elapsed()) + "],";
+        }
+        {
+            simple_timer st2;
+            batch::log(out.data(), v.data(), size);
+            std::cout << " / " << out[size - 1u];
+            s += "['mp++ (batch)','log'," + std::to_string(st2.elapsed()) + "],";
+        }
+        {
+            simple_timer st2;
+            batch::sin(out.data(), v.data(), size);
+            std::cout << " / " << out[size - 1u];
+            s += "['mp++ (batch)','sin'," + std::to_string(st2.elapsed()) + "],";
+        }
+        {
+            simple_timer st2;
+            batch::cos(out.data(), v.data(), size);
+            std::cout << " / " << out[size - 1u];
+            s += "['mp++ (batch)','cos'," + std::to_string(st2.elapsed()) + "],";
+        }
+        s += "['mp++ (batch)','total'," + std::to_string(st1.elapsed()) + "],";
+        std::cout << totalRuntime;
+    }
+    s += boost::str(boost::format(pySuffix) % name);
+    std::ofstream of(name + ".py", std::ios_base::trunc);
+    of << s;
+    of.close();
+    std::cout << "\n\n" << std::flush;
+}
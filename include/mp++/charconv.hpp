@@ -0,0 +1,31 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_CHARCONV_HPP
+#define MPPP_CHARCONV_HPP
+
+#include <system_error>
+
+namespace mppp
+{
+
+// Result of the to_chars() overloads.
+struct to_chars_result {
+    char *ptr;
+    std::errc ec;
+};
+
+// Result of the from_chars() overloads.
+struct from_chars_result {
+    const char *ptr;
+    std::errc ec;
+};
+
+} // namespace mppp
+
+#endif
@@ -0,0 +1,1135 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_COMPLEX_HPP
+#define MPPP_COMPLEX_HPP
+
+#include <mp++/config.hpp>
+
+#if defined(MPPP_WITH_MPFR)
+
+#include <complex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <mp++/concepts.hpp>
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/detail/visibility.hpp>
+#include <mp++/real.hpp>
+
+namespace mppp
+{
+
+class complex;
+
+namespace detail
+{
+
+// The kernels of the complex functions (defined in the source file).
+// In all kernels, the return value may overlap with the operands,
+// and its precision is set to the largest precision among the operands.
+struct MPPP_DLL_PUBLIC complex_ops {
+    static ::mpfr_prec_t check_init_prec(::mpfr_prec_t);
+    static ::mpfr_prec_t check_set_prec(::mpfr_prec_t);
+    static void add(complex &, const complex &, const complex &);
+    static void sub(complex &, const complex &, const complex &);
+    static void mul(complex &, const complex &, const complex &);
+    static void div(complex &, const complex &, const complex &);
+    static void mul_add(complex &, const complex &, const complex &, const complex &);
+    static void add_r(complex &, const complex &, const real &);
+    static void sub_r(complex &, const complex &, const real &);
+    static void r_sub(complex &, const real &, const complex &);
+    static void mul_r(complex &, const complex &, const real &);
+    static void div_r(complex &, const complex &, const real &);
+    static void neg(complex &, const complex &);
+    static void conj(complex &, const complex &);
+    static void sqr(complex &, const complex &);
+    static void sqrt(complex &, const complex &);
+    static void exp(complex &, const complex &);
+    static void log(complex &, const complex &);
+    static void norm(real &, const complex &);
+};
+
+} // namespace detail
+
+// Strongly-typed precision for the constructors of complex. This allows to
+// disambiguate a precision value from the imaginary part.
+enum class complex_prec_t : ::mpfr_prec_t {};
+
+template <typename T>
+using is_complex_component = detail::disjunction<std::is_same<real, T>, is_real_interoperable<T>>;
+
+template <typename T>
+using is_complex_interoperable = detail::disjunction<is_complex_component<T>, is_cpp_complex<T>>;
+
+#if defined(MPPP_HAVE_CONCEPTS)
+
+template <typename T>
+MPPP_CONCEPT_DECL ComplexComponent = is_complex_component<T>::value;
+
+template <typename T>
+MPPP_CONCEPT_DECL ComplexInteroperable = is_complex_interoperable<T>::value;
+
+template <typename T>
+MPPP_CONCEPT_DECL CvrComplex = std::is_same<detail::uncvref_t<T>, complex>::value;
+
+#else
+
+template <typename T>
+using complex_component_enabler = detail::enable_if_t<is_complex_component<T>::value, int>;
+
+template <typename T>
+using complex_interoperable_enabler = detail::enable_if_t<is_complex_interoperable<T>::value, int>;
+
+template <typename... Args>
+using cvr_complex_enabler
+    = detail::enable_if_t<detail::conjunction<std::is_same<detail::uncvref_t<Args>, complex>...>::value, int>;
+
+#endif
+
+template <typename T, typename U>
+using are_complex_op_types = detail::disjunction<
+    detail::conjunction<std::is_same<complex, detail::uncvref_t<T>>, std::is_same<complex, detail::uncvref_t<U>>>,
+    detail::conjunction<std::is_same<complex, detail::uncvref_t<T>>, is_complex_interoperable<detail::uncvref_t<U>>>,
+    detail::conjunction<std::is_same<complex, detail::uncvref_t<U>>, is_complex_interoperable<detail::uncvref_t<T>>>>;
+
+template <typename T, typename U>
+using are_complex_in_place_op_types
+    = detail::conjunction<std::is_same<complex, detail::unref_t<T>>,
+                          detail::disjunction<std::is_same<complex, detail::uncvref_t<U>>,
+                                              is_complex_interoperable<detail::uncvref_t<U>>>>;
+
+#if defined(MPPP_HAVE_CONCEPTS)
+
+template <typename T, typename U>
+MPPP_CONCEPT_DECL ComplexOpTypes = are_complex_op_types<T, U>::value;
+
+template <typename T, typename U>
+MPPP_CONCEPT_DECL ComplexInPlaceOpTypes = are_complex_in_place_op_types<T, U>::value;
+
+#else
+
+template <typename T, typename U>
+using complex_op_types_enabler = detail::enable_if_t<are_complex_op_types<T, U>::value, int>;
+
+template <typename T, typename U>
+using complex_in_place_op_types_enabler = detail::enable_if_t<are_complex_in_place_op_types<T, U>::value, int>;
+
+#endif
+
+namespace detail
+{
+
+// Convert x into a component of a complex, with precision p.
+// If p is zero, the precision of x is used (if x is a real),
+// or it is deduced from x (otherwise).
+inline real complex_component(const real &x, ::mpfr_prec_t p)
+{
+    return p ? real{x, p} : x;
+}
+
+template <typename T>
+inline real complex_component(const T &x, ::mpfr_prec_t p)
+{
+    return real{x, p};
+}
+
+} // namespace detail
+
+/// Multiprecision complex class.
+/**
+ * \rststar
+ * *#include <mp++/complex.hpp>*
+ *
+ * .. versionadded:: 0.20
+ *
+ * This class represents a complex number whose real and imaginary parts are
+ * :cpp:class:`~mppp::real` objects with the same precision.
+ *
+ * The arithmetic operators and the functions return values with a precision equal to the highest precision
+ * among the operands, following the same conventions of :cpp:class:`~mppp::real`. In mixed-mode operations,
+ * operands of type :cpp:class:`~mppp::real` and of the types satisfying :cpp:concept:`~mppp::RealInteroperable`
+ * are treated as complex numbers with a zero imaginary part, without being converted to
+ * :cpp:class:`~mppp::complex` (so that, e.g., the product of a :cpp:class:`~mppp::complex`
+ * by a :cpp:class:`~mppp::real` requires only two real multiplications), while ``std::complex`` operands are
+ * first converted to :cpp:class:`~mppp::complex`.
+ *
+ * Like for :cpp:class:`~mppp::real`, the functions and operators try to re-use the storage
+ * of rvalue operands for the return value.
+ *
+ * The components of the results of the addition, subtraction and multiplication operations,
+ * of :cpp:func:`~mppp::mul_add()` and of :cpp:func:`~mppp::sqr()` are correctly rounded. The multiplication
+ * of operands with a precision of at least 512 bits uses the 3-multiplication Karatsuba scheme
+ * at a slightly higher working precision, and it falls back to exact products
+ * if the result cannot be proven to be correctly rounded.
+ * The other functions (e.g., division, square root, exponential) are computed at a higher working precision,
+ * and they are accurate to a few units in the last place.
+ *
+ * Precision values for the constructors are passed via the :cpp:enum:`~mppp::complex_prec_t`
+ * type, in order to disambiguate them from the imaginary part:
+ *
+ * .. code-block:: c++
+ *
+ *    complex c1{1, 2};                      // 1 + 2i.
+ *    complex c2{1, complex_prec_t(128)};    // 1 + 0i, with 128 bits of precision.
+ *    complex c3{1, 2, complex_prec_t(128)}; // 1 + 2i, with 128 bits of precision.
+ * \endrststar
+ */
+class MPPP_DLL_PUBLIC complex
+{
+    friend struct detail::complex_ops;
+
+public:
+    /// Default constructor.
+    /**
+     * The real and imaginary parts are default-constructed (see mppp::real::real()).
+     */
+    complex() = default;
+    /// Defaulted copy constructor.
+    complex(const complex &) = default;
+    /// Defaulted move constructor.
+    complex(complex &&) = default;
+    // Copy constructor with custom precision.
+    explicit complex(const complex &, complex_prec_t);
+    // Constructor from real and imaginary parts.
+    explicit complex(real &&, real &&);
+
+private:
+    template <typename T>
+    void dispatch_construction(const T &x, ::mpfr_prec_t p)
+    {
+        m_re = detail::complex_component(x, p);
+        m_im = real{real_kind::zero, m_re.get_prec()};
+    }
+    template <typename T>
+    void dispatch_construction(const std::complex<T> &c, ::mpfr_prec_t p)
+    {
+        m_re = detail::complex_component(c.real(), p);
+        m_im = detail::complex_component(c.imag(), p);
+        unify_prec();
+    }
+    // Set the precision of both components to the
+    // largest precision among them.
+    void unify_prec()
+    {
+        const auto p = detail::c_max(m_re.get_prec(), m_im.get_prec());
+        m_re.prec_round(p);
+        m_im.prec_round(p);
+    }
+
+public:
+    /// Generic constructor.
+    /**
+     * \rststar
+     * If ``x`` is a :cpp:class:`~mppp::real` or satisfies :cpp:concept:`~mppp::RealInteroperable`,
+     * the real part will be initialised from ``x`` and the imaginary part will be set to zero.
+     * If ``x`` is an ``std::complex``, the real and imaginary parts will be initialised from
+     * the components of ``x``.
+     *
+     * The precision of the constructed :cpp:class:`~mppp::complex` is the precision of ``x``
+     * (if ``x`` is a :cpp:class:`~mppp::real`), or it is determined as explained in the generic
+     * constructor of :cpp:class:`~mppp::real`.
+     * \endrststar
+     *
+     * @param x the construction argument.
+     *
+     * @throws unspecified any exception thrown by the constructors of \link mppp::real real\endlink.
+     */
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <ComplexInteroperable T>
+#else
+    template <typename T, complex_interoperable_enabler<T> = 0>
+#endif
+    explicit complex(const T &x)
+    {
+        dispatch_construction(x, 0);
+    }
+    /// Generic constructor with custom precision.
+    /**
+     * This constructor is equivalent to the generic constructor, but the precision of the constructed
+     * \link mppp::complex complex\endlink will be \p p.
+     *
+     * @param x the construction argument.
+     * @param p the desired precision.
+     *
+     * @throws std::invalid_argument if \p p is outside the range established by
+     * \link mppp::real_prec_min() real_prec_min()\endlink and \link mppp::real_prec_max() real_prec_max()\endlink.
+     * @throws unspecified any exception thrown by the constructors of \link mppp::real real\endlink.
+     */
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <ComplexInteroperable T>
+#else
+    template <typename T, complex_interoperable_enabler<T> = 0>
+#endif
+    explicit complex(const T &x, complex_prec_t p)
+    {
+        dispatch_construction(x, detail::complex_ops::check_init_prec(static_cast<::mpfr_prec_t>(p)));
+    }
+    /// Constructor from real and imaginary parts.
+    /**
+     * \rststar
+     * The real and imaginary parts will be initialised from ``re`` and ``im``. The precision
+     * of the constructed :cpp:class:`~mppp::complex` is the largest precision among the components, as
+     * established by the generic constructor.
+     * \endrststar
+     *
+     * @param re the real part.
+     * @param im the imaginary part.
+     *
+     * @throws unspecified any exception thrown by the constructors of \link mppp::real real\endlink.
+     */
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <ComplexComponent T, ComplexComponent U>
+#else
+    template <typename T, typename U, complex_component_enabler<T> = 0, complex_component_enabler<U> = 0>
+#endif
+    explicit complex(const T &re, const U &im)
+        : m_re(detail::complex_component(re, 0)), m_im(detail::complex_component(im, 0))
+    {
+        unify_prec();
+    }
+    /// Constructor from real and imaginary parts with custom precision.
+    /**
+     * @param re the real part.
+     * @param im the imaginary part.
+     * @param p the desired precision.
+     *
+     * @throws std::invalid_argument if \p p is outside the range established by
+     * \link mppp::real_prec_min() real_prec_min()\endlink and \link mppp::real_prec_max() real_prec_max()\endlink.
+     * @throws unspecified any exception thrown by the constructors of \link mppp::real real\endlink.
+     */
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <ComplexComponent T, ComplexComponent U>
+#else
+    template <typename T, typename U, complex_component_enabler<T> = 0, complex_component_enabler<U> = 0>
+#endif
+    explicit complex(const T &re, const U &im, complex_prec_t p)
+        : m_re(detail::complex_component(re, detail::complex_ops::check_init_prec(static_cast<::mpfr_prec_t>(p)))),
+          m_im(detail::complex_component(im, static_cast<::mpfr_prec_t>(p)))
+    {
+    }
+
+    /// Defaulted copy assignment operator.
+    /**
+     * @return a reference to \p this.
+     */
+    complex &operator=(const complex &) = default;
+    /// Defaulted move assignment operator.
+    /**
+     * @return a reference to \p this.
+     */
+    complex &operator=(complex &&) = default;
+    /// Generic assignment operator.
+    /**
+     * \rststar
+     * The value and the precision of ``this`` will be set to those of a :cpp:class:`~mppp::complex`
+     * constructed from ``x`` via the generic constructor.
+     * \endrststar
+     *
+     * @param x the assignment argument.
+     *
+     * @return a reference to \p this.
+     *
+     * @throws unspecified any exception thrown by the generic constructor.
+     */
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <ComplexInteroperable T>
+#else
+    template <typename T, complex_interoperable_enabler<T> = 0>
+#endif
+    complex &operator=(const T &x)
+    {
+        return *this = complex{x};
+    }
+
+    /// Check validity.
+    /**
+     * @return \p false if \p this has been moved from, \p true otherwise.
+     */
+    bool is_valid() const noexcept
+    {
+        return m_re.is_valid() && m_im.is_valid();
+    }
+
+    /// Getter for the real part.
+    /**
+     * @return a const reference to the real part.
+     */
+    const real &re() const
+    {
+        return m_re;
+    }
+    /// Getter for the imaginary part.
+    /**
+     * @return a const reference to the imaginary part.
+     */
+    const real &im() const
+    {
+        return m_im;
+    }
+
+    /// Get the precision.
+    /**
+     * @return the precision of the real and imaginary parts.
+     */
+    ::mpfr_prec_t get_prec() const
+    {
+        return m_re.get_prec();
+    }
+    // Destructively set the precision.
+    complex &set_prec(::mpfr_prec_t);
+    // Set the precision, rounding the value.
+    complex &prec_round(::mpfr_prec_t);
+
+    /// Detect zero.
+    /**
+     * @return \p true if both the real and imaginary parts are zero, \p false otherwise.
+     */
+    bool zero_p() const
+    {
+        return m_re.zero_p() && m_im.zero_p();
+    }
+
+    // Convert to string.
+    std::string to_string(int base = 10) const;
+
+    /// Conversion to ``std::complex``.
+    /**
+     * \rststar
+     * The real and imaginary parts are converted to ``T`` via the conversion operator
+     * of :cpp:class:`~mppp::real`.
+     * \endrststar
+     *
+     * @return \p this converted to ``std::complex<T>``.
+     */
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <CppFloatingPointInteroperable T>
+#else
+    template <typename T, cpp_floating_point_interoperable_enabler<T> = 0>
+#endif
+    explicit operator std::complex<T>() const
+    {
+        return std::complex<T>(static_cast<T>(m_re), static_cast<T>(m_im));
+    }
+
+    /// In-place negation.
+    /**
+     * @return a reference to \p this.
+     */
+    complex &neg()
+    {
+        detail::complex_ops::neg(*this, *this);
+        return *this;
+    }
+    /// In-place conjugate.
+    /**
+     * @return a reference to \p this.
+     */
+    complex &conj()
+    {
+        detail::complex_ops::conj(*this, *this);
+        return *this;
+    }
+    /// In-place square.
+    /**
+     * @return a reference to \p this.
+     */
+    complex &sqr()
+    {
+        detail::complex_ops::sqr(*this, *this);
+        return *this;
+    }
+    /// In-place square root.
+    /**
+     * @return a reference to \p this.
+     */
+    complex &sqrt()
+    {
+        detail::complex_ops::sqrt(*this, *this);
+        return *this;
+    }
+    /// In-place exponential.
+    /**
+     * @return a reference to \p this.
+     */
+    complex &exp()
+    {
+        detail::complex_ops::exp(*this, *this);
+        return *this;
+    }
+    /// In-place logarithm.
+    /**
+     * @return a reference to \p this.
+     */
+    complex &log()
+    {
+        detail::complex_ops::log(*this, *this);
+        return *this;
+    }
+
+    friend void swap(complex &, complex &) noexcept;
+
+private:
+    real m_re, m_im;
+};
+
+/// Swap \link mppp::complex complex\endlink objects.
+/**
+ * This function will efficiently swap the contents of \p a and \p b.
+ *
+ * @param a the first operand.
+ * @param b the second operand.
+ */
+inline void swap(complex &a, complex &b) noexcept
+{
+    swap(a.m_re, b.m_re);
+    swap(a.m_im, b.m_im);
+}
+
+// Output stream operator.
+MPPP_DLL_PUBLIC std::ostream &operator<<(std::ostream &, const complex &);
+
+namespace detail
+{
+
+#if !defined(MPPP_DOXYGEN_INVOKED)
+
+// Get a pointer to x, if x is a complex from which
+// we can steal resources, or a null pointer otherwise.
+template <typename T, enable_if_t<!is_ncrvr<T &&>::value, int> = 0>
+inline complex *complex_steal_candidate(T &&)
+{
+    return nullptr;
+}
+
+template <typename T, enable_if_t<is_ncrvr<T &&>::value, int> = 0>
+inline complex *complex_steal_candidate(T &&x)
+{
+    return &x;
+}
+
+// Determine the largest-precision complex among the arguments
+// from which we can steal resources, and the max precision among the arguments.
+inline void complex_nary_op_check_steal(std::pair<complex *, ::mpfr_prec_t> &) {}
+
+template <typename Arg0, typename... Args>
+inline void complex_nary_op_check_steal(std::pair<complex *, ::mpfr_prec_t> &p, Arg0 &&arg0, Args &&... args)
+{
+    const auto prec0 = arg0.get_prec();
+    const auto c = complex_steal_candidate(std::forward<Arg0>(arg0));
+    if (c && (!p.first || prec0 > p.first->get_prec())) {
+        p.first = c;
+    }
+    p.second = c_max(prec0, p.second);
+    complex_nary_op_check_steal(p, std::forward<Args>(args)...);
+}
+
+// Apply the kernel f with return value rop and complex arguments args. As in mpfr_nary_op_impl(),
+// the precision of rop will be the largest precision among the arguments (but not less than min_prec),
+// and, if rop does not have enough precision, the storage of an rvalue argument may be used
+// to compute the result, which is then swapped into rop.
+template <typename F, typename... Args>
+inline complex &complex_nary_op_impl(::mpfr_prec_t min_prec, const F &f, complex &rop, Args &&... args)
+{
+    std::pair<complex *, ::mpfr_prec_t> p{nullptr, min_prec};
+    complex_nary_op_check_steal(p, std::forward<Args>(args)...);
+    if (rop.get_prec() < p.second && p.first && p.first->get_prec() == p.second) {
+        f(*p.first, args...);
+        swap(*p.first, rop);
+    } else {
+        f(rop, args...);
+    }
+    return rop;
+}
+
+// Apply the kernel f with complex arguments args, returning the result. The storage
+// of an rvalue argument with enough precision will be re-used for the return value, if possible.
+template <typename F, typename... Args>
+inline complex complex_nary_op_return_impl(::mpfr_prec_t min_prec, const F &f, Args &&... args)
+{
+    std::pair<complex *, ::mpfr_prec_t> p{nullptr, min_prec};
+    complex_nary_op_check_steal(p, std::forward<Args>(args)...);
+    if (p.first && p.first->get_prec() == p.second) {
+        f(*p.first, args...);
+        return std::move(*p.first);
+    }
+    complex retval{real{real_kind::zero, p.second}, real{real_kind::zero, p.second}};
+    f(retval, args...);
+    return retval;
+}
+
+#endif
+
+} // namespace detail
+
+// Ternary addition.
+#if defined(MPPP_HAVE_CONCEPTS)
+template <CvrComplex T, CvrComplex U>
+#else
+template <typename T, typename U, cvr_complex_enabler<T, U> = 0>
+#endif
+inline complex &add(complex &rop, T &&a, U &&b)
+{
+    return detail::complex_nary_op_impl(0, detail::complex_ops::add, rop, std::forward<T>(a), std::forward<U>(b));
+}
+
+// Ternary subtraction.
+#if defined(MPPP_HAVE_CONCEPTS)
+template <CvrComplex T, CvrComplex U>
+#else
+template <typename T, typename U, cvr_complex_enabler<T, U> = 0>
+#endif
+inline complex &sub(complex &rop, T &&a, U &&b)
+{
+    return detail::complex_nary_op_impl(0, detail::complex_ops::sub, rop, std::forward<T>(a), std::forward<U>(b));
+}
+
+// Ternary multiplication.
+#if defined(MPPP_HAVE_CONCEPTS)
+template <CvrComplex T, CvrComplex U>
+#else
+template <typename T, typename U, cvr_complex_enabler<T, U> = 0>
+#endif
+inline complex &mul(complex &rop, T &&a, U &&b)
+{
+    return detail::complex_nary_op_impl(0, detail::complex_ops::mul, rop, std::forward<T>(a), std::forward<U>(b));
+}
+
+// Ternary division.
+#if defined(MPPP_HAVE_CONCEPTS)
+template <CvrComplex T, CvrComplex U>
+#else
+template <typename T, typename U, cvr_complex_enabler<T, U> = 0>
+#endif
+inline complex &div(complex &rop, T &&a, U &&b)
+{
+    return detail::complex_nary_op_impl(0, detail::complex_ops::div, rop, std::forward<T>(a), std::forward<U>(b));
+}
+
+// Quaternary fused multiply-add.
+#if defined(MPPP_HAVE_CONCEPTS)
+template <CvrComplex T, CvrComplex U, CvrComplex V>
+#else
+template <typename T, typename U, typename V, cvr_complex_enabler<T, U, V> = 0>
+#endif
+inline complex &mul_add(complex &rop, T &&a, U &&b, V &&c)
+{
+    return detail::complex_nary_op_impl(0, detail::complex_ops::mul_add, rop, std::forward<T>(a),
+                                        std::forward<U>(b), std::forward<V>(c));
+}
+
+// Ternary fused multiply-add.
+#if defined(MPPP_HAVE_CONCEPTS)
+template <CvrComplex T, CvrComplex U, CvrComplex V>
+#else
+template <typename T, typename U, typename V, cvr_complex_enabler<T, U, V> = 0>
+#endif
+inline complex mul_add(T &&a, U &&b, V &&c)
+{
+    return detail::complex_nary_op_return_impl(0, detail::complex_ops::mul_add, std::forward<T>(a),
+                                               std::forward<U>(b), std::forward<V>(c));
+}
+
+#if defined(MPPP_HAVE_CONCEPTS)
+#define MPPP_COMPLEX_UNARY_HEADER template <CvrComplex T>
+#else
+#define MPPP_COMPLEX_UNARY_HEADER template <typename T, cvr_complex_enabler<T> = 0>
+#endif
+
+// Helper macro to declare the ternary and binary forms of
+// the unary complex functions.
+#define MPPP_COMPLEX_UNARY(name)                                                                                       \
+    MPPP_COMPLEX_UNARY_HEADER inline complex &name(complex &rop, T &&op)                                               \
+    {                                                                                                                  \
+        return detail::complex_nary_op_impl(0, detail::complex_ops::name, rop, std::forward<T>(op));                   \
+    }                                                                                                                  \
+    MPPP_COMPLEX_UNARY_HEADER inline complex name(T &&op)                                                              \
+    {                                                                                                                  \
+        return detail::complex_nary_op_return_impl(0, detail::complex_ops::name, std::forward<T>(op));                 \
+    }
+
+MPPP_COMPLEX_UNARY(neg)
+MPPP_COMPLEX_UNARY(conj)
+MPPP_COMPLEX_UNARY(sqr)
+MPPP_COMPLEX_UNARY(sqrt)
+MPPP_COMPLEX_UNARY(exp)
+MPPP_COMPLEX_UNARY(log)
+
+#undef MPPP_COMPLEX_UNARY
+#undef MPPP_COMPLEX_UNARY_HEADER
+
+/// Absolute value of a \link mppp::complex complex\endlink.
+/**
+ * The result is correctly rounded, and its precision is the precision of \p z.
+ *
+ * @param rop the return value.
+ * @param z the operand.
+ *
+ * @return a reference to \p rop.
+ */
+inline real &abs(real &rop, const complex &z)
+{
+    return hypot(rop, z.re(), z.im());
+}
+
+/// Absolute value of a \link mppp::complex complex\endlink.
+/**
+ * The result is correctly rounded, and its precision is the precision of \p z.
+ *
+ * @param z the operand.
+ *
+ * @return \f$\left|z\right|\f$.
+ */
+inline real abs(const complex &z)
+{
+    return hypot(z.re(), z.im());
+}
+
+/// Squared absolute value of a \link mppp::complex complex\endlink.
+/**
+ * The result is correctly rounded, and its precision is the precision of \p z.
+ *
+ * @param rop the return value.
+ * @param z the operand.
+ *
+ * @return a reference to \p rop.
+ */
+inline real &norm(real &rop, const complex &z)
+{
+    detail::complex_ops::norm(rop, z);
+    return rop;
+}
+
+/// Squared absolute value of a \link mppp::complex complex\endlink.
+/**
+ * The result is correctly rounded, and its precision is the precision of \p z.
+ *
+ * @param z the operand.
+ *
+ * @return \f$\left|z\right|^2\f$.
+ */
+inline real norm(const complex &z)
+{
+    real retval{real_kind::zero, z.get_prec()};
+    detail::complex_ops::norm(retval, z);
+    return retval;
+}
+
+/// Argument of a \link mppp::complex complex\endlink.
+/**
+ * The result is correctly rounded, its precision is the precision of \p z,
+ * and it is in the range \f$\left[-\pi, \pi\right]\f$.
+ *
+ * @param rop the return value.
+ * @param z the operand.
+ *
+ * @return a reference to \p rop.
+ */
+inline real &arg(real &rop, const complex &z)
+{
+    return atan2(rop, z.im(), z.re());
+}
+
+/// Argument of a \link mppp::complex complex\endlink.
+/**
+ * The result is correctly rounded, its precision is the precision of \p z,
+ * and it is in the range \f$\left[-\pi, \pi\right]\f$.
+ *
+ * @param z the operand.
+ *
+ * @return the argument of \p z.
+ */
+inline real arg(const complex &z)
+{
+    return atan2(z.im(), z.re());
+}
+
+namespace detail
+{
+
+#if !defined(MPPP_DOXYGEN_INVOKED)
+
+// Convert x into a real, for the mixed-mode operations.
+inline const real &complex_real_arg(const real &x)
+{
+    return x;
+}
+
+template <typename T>
+inline real complex_real_arg(const T &x)
+{
+    real retval;
+    retval = x;
+    return retval;
+}
+
+// The kernels of the binary operators. cr and rc are used for mixed-mode
+// operations with a real (or a real-interoperable type converted to real).
+struct complex_add_op {
+    static void cc(complex &rop, const complex &a, const complex &b)
+    {
+        complex_ops::add(rop, a, b);
+    }
+    static void cr(complex &rop, const complex &a, const real &x)
+    {
+        complex_ops::add_r(rop, a, x);
+    }
+    static void rc(complex &rop, const real &x, const complex &a)
+    {
+        complex_ops::add_r(rop, a, x);
+    }
+};
+
+struct complex_sub_op {
+    static void cc(complex &rop, const complex &a, const complex &b)
+    {
+        complex_ops::sub(rop, a, b);
+    }
+    static void cr(complex &rop, const complex &a, const real &x)
+    {
+        complex_ops::sub_r(rop, a, x);
+    }
+    static void rc(complex &rop, const real &x, const complex &a)
+    {
+        complex_ops::r_sub(rop, x, a);
+    }
+};
+
+struct complex_mul_op {
+    static void cc(complex &rop, const complex &a, const complex &b)
+    {
+        complex_ops::mul(rop, a, b);
+    }
+    static void cr(complex &rop, const complex &a, const real &x)
+    {
+        complex_ops::mul_r(rop, a, x);
+    }
+    static void rc(complex &rop, const real &x, const complex &a)
+    {
+        complex_ops::mul_r(rop, a, x);
+    }
+};
+
+struct complex_div_op {
+    static void cc(complex &rop, const complex &a, const complex &b)
+    {
+        complex_ops::div(rop, a, b);
+    }
+    static void cr(complex &rop, const complex &a, const real &x)
+    {
+        complex_ops::div_r(rop, a, x);
+    }
+    static void rc(complex &rop, const real &x, const complex &a)
+    {
+        complex_ops::div(rop, complex{x}, a);
+    }
+};
+
+template <typename Op, typename T, typename U,
+          enable_if_t<conjunction<std::is_same<complex, uncvref_t<T>>, std::is_same<complex, uncvref_t<U>>>::value,
+                      int> = 0>
+inline complex dispatch_complex_binary(T &&a, U &&b)
+{
+    return complex_nary_op_return_impl(0, Op::cc, std::forward<T>(a), std::forward<U>(b));
+}
+
+template <typename Op, typename T, typename U,
+          enable_if_t<conjunction<std::is_same<complex, uncvref_t<T>>, is_complex_component<U>>::value, int> = 0>
+inline complex dispatch_complex_binary(T &&a, const U &y)
+{
+    const auto &x = complex_real_arg(y);
+    return complex_nary_op_return_impl(
+        x.get_prec(), [&x](complex &rop, const complex &z) { Op::cr(rop, z, x); }, std::forward<T>(a));
+}
+
+template <typename Op, typename T, typename U,
+          enable_if_t<conjunction<is_complex_component<T>, std::is_same<complex, uncvref_t<U>>>::value, int> = 0>
+inline complex dispatch_complex_binary(const T &y, U &&a)
+{
+    const auto &x = complex_real_arg(y);
+    return complex_nary_op_return_impl(
+        x.get_prec(), [&x](complex &rop, const complex &z) { Op::rc(rop, x, z); }, std::forward<U>(a));
+}
+
+template <typename Op, typename T, typename U,
+          enable_if_t<conjunction<std::is_same<complex, uncvref_t<T>>, is_cpp_complex<U>>::value, int> = 0>
+inline complex dispatch_complex_binary(T &&a, const U &c)
+{
+    return dispatch_complex_binary<Op>(std::forward<T>(a), complex{c});
+}
+
+template <typename Op, typename T, typename U,
+          enable_if_t<conjunction<is_cpp_complex<T>, std::is_same<complex, uncvref_t<U>>>::value, int> = 0>
+inline complex dispatch_complex_binary(const T &c, U &&a)
+{
+    return dispatch_complex_binary<Op>(complex{c}, std::forward<U>(a));
+}
+
+template <typename Op, typename U, enable_if_t<std::is_same<complex, uncvref_t<U>>::value, int> = 0>
+inline void dispatch_complex_in_place(complex &a, U &&b)
+{
+    complex_nary_op_impl(0, Op::cc, a, a, std::forward<U>(b));
+}
+
+template <typename Op, typename U, enable_if_t<is_complex_component<U>::value, int> = 0>
+inline void dispatch_complex_in_place(complex &a, const U &y)
+{
+    const auto &x = complex_real_arg(y);
+    complex_nary_op_impl(
+        x.get_prec(), [&x](complex &rop, const complex &z) { Op::cr(rop, z, x); }, a, a);
+}
+
+template <typename Op, typename U, enable_if_t<is_cpp_complex<U>::value, int> = 0>
+inline void dispatch_complex_in_place(complex &a, const U &c)
+{
+    dispatch_complex_in_place<Op>(a, complex{c});
+}
+
+inline bool dispatch_complex_equality(const complex &a, const complex &b)
+{
+    return a.re() == b.re() && a.im() == b.im();
+}
+
+template <typename T, enable_if_t<is_complex_component<T>::value, int> = 0>
+inline bool dispatch_complex_equality(const complex &a, const T &x)
+{
+    return a.im().zero_p() && a.re() == x;
+}
+
+template <typename T>
+inline bool dispatch_complex_equality(const complex &a, const std::complex<T> &c)
+{
+    return a.re() == c.real() && a.im() == c.imag();
+}
+
+template <typename T, enable_if_t<!std::is_same<complex, T>::value, int> = 0>
+inline bool dispatch_complex_equality(const T &x, const complex &a)
+{
+    return dispatch_complex_equality(a, x);
+}
+
+#endif
+
+} // namespace detail
+
+/// Identity operator for \link mppp::complex complex\endlink.
+/**
+ * @param z the \link mppp::complex complex\endlink that will be copied.
+ *
+ * @return a copy of \p z.
+ */
+#if defined(MPPP_HAVE_CONCEPTS)
+template <CvrComplex T>
+#else
+template <typename T, cvr_complex_enabler<T> = 0>
+#endif
+inline complex operator+(T &&z)
+{
+    return std::forward<T>(z);
+}
+
+/// Negated copy for \link mppp::complex complex\endlink.
+/**
+ * @param z the \link mppp::complex complex\endlink that will be negated.
+ *
+ * @return a negated copy of \p z.
+ */
+#if defined(MPPP_HAVE_CONCEPTS)
+template <CvrComplex T>
+#else
+template <typename T, cvr_complex_enabler<T> = 0>
+#endif
+inline complex operator-(T &&z)
+{
+    return neg(std::forward<T>(z));
+}
+
+// Binary arithmetic operators.
+#if defined(MPPP_HAVE_CONCEPTS)
+template <typename T, typename U>
+requires ComplexOpTypes<T, U>
+#else
+template <typename T, typename U, complex_op_types_enabler<T, U> = 0>
+#endif
+    inline complex operator+(T &&a, U &&b)
+{
+    return detail::dispatch_complex_binary<detail::complex_add_op>(std::forward<T>(a), std::forward<U>(b));
+}
+
+#if defined(MPPP_HAVE_CONCEPTS)
+template <typename T, typename U>
+requires ComplexOpTypes<T, U>
+#else
+template <typename T, typename U, complex_op_types_enabler<T, U> = 0>
+#endif
+    inline complex operator-(T &&a, U &&b)
+{
+    return detail::dispatch_complex_binary<detail::complex_sub_op>(std::forward<T>(a), std::forward<U>(b));
+}
+
+#if defined(MPPP_HAVE_CONCEPTS)
+template <typename T, typename U>
+requires ComplexOpTypes<T, U>
+#else
+template <typename T, typename U, complex_op_types_enabler<T, U> = 0>
+#endif
+    inline complex operator*(T &&a, U &&b)
+{
+    return detail::dispatch_complex_binary<detail::complex_mul_op>(std::forward<T>(a), std::forward<U>(b));
+}
+
+#if defined(MPPP_HAVE_CONCEPTS)
+template <typename T, typename U>
+requires ComplexOpTypes<T, U>
+#else
+template <typename T, typename U, complex_op_types_enabler<T, U> = 0>
+#endif
+    inline complex operator/(T &&a, U &&b)
+{
+    return detail::dispatch_complex_binary<detail::complex_div_op>(std::forward<T>(a), std::forward<U>(b));
+}
+
+// In-place arithmetic operators.
+#if defined(MPPP_HAVE_CONCEPTS)
+template <typename T, typename U>
+requires ComplexInPlaceOpTypes<T, U>
+#else
+template <typename T, typename U, complex_in_place_op_types_enabler<T, U> = 0>
+#endif
+    inline complex &operator+=(T &a, U &&b)
+{
+    detail::dispatch_complex_in_place<detail::complex_add_op>(a, std::forward<U>(b));
+    return a;
+}
+
+#if defined(MPPP_HAVE_CONCEPTS)
+template <typename T, typename U>
+requires ComplexInPlaceOpTypes<T, U>
+#else
+template <typename T, typename U, complex_in_place_op_types_enabler<T, U> = 0>
+#endif
+    inline complex &operator-=(T &a, U &&b)
+{
+    detail::dispatch_complex_in_place<detail::complex_sub_op>(a, std::forward<U>(b));
+    return a;
+}
+
+#if defined(MPPP_HAVE_CONCEPTS)
+template <typename T, typename U>
+requires ComplexInPlaceOpTypes<T, U>
+#else
+template <typename T, typename U, complex_in_place_op_types_enabler<T, U> = 0>
+#endif
+    inline complex &operator*=(T &a, U &&b)
+{
+    detail::dispatch_complex_in_place<detail::complex_mul_op>(a, std::forward<U>(b));
+    return a;
+}
+
+#if defined(MPPP_HAVE_CONCEPTS)
+template <typename T, typename U>
+requires ComplexInPlaceOpTypes<T, U>
+#else
+template <typename T, typename U, complex_in_place_op_types_enabler<T, U> = 0>
+#endif
+    inline complex &operator/=(T &a, U &&b)
+{
+    detail::dispatch_complex_in_place<detail::complex_div_op>(a, std::forward<U>(b));
+    return a;
+}
+
+/// Prefix increment for \link mppp::complex complex\endlink.
+/**
+ * This operator will increment the real part of \p z by one.
+ *
+ * @param z the \link mppp::complex complex\endlink that will be increased.
+ *
+ * @return a reference to \p z after the increment.
+ */
+inline complex &operator++(complex &z)
+{
+    return z += 1;
+}
+
+/// Suffix increment for \link mppp::complex complex\endlink.
+/**
+ * This operator will increment the real part of \p z by one and return a copy of \p z as it was before
+ * the increment.
+ *
+ * @param z the \link mppp::complex complex\endlink that will be increased.
+ *
+ * @return a copy of \p z before the increment.
+ */
+inline complex operator++(complex &z, int)
+{
+    auto retval(z);
+    ++z;
+    return retval;
+}
+
+/// Prefix decrement for \link mppp::complex complex\endlink.
+/**
+ * This operator will decrement the real part of \p z by one.
+ *
+ * @param z the \link mppp::complex complex\endlink that will be decreased.
+ *
+ * @return a reference to \p z after the decrement.
+ */
+inline complex &operator--(complex &z)
+{
+    return z -= 1;
+}
+
+/// Suffix decrement for \link mppp::complex complex\endlink.
+/**
+ * This operator will decrement the real part of \p z by one and return a copy of \p z as it was before
+ * the decrement.
+ *
+ * @param z the \link mppp::complex complex\endlink that will be decreased.
+ *
+ * @return a copy of \p z before the decrement.
+ */
+inline complex operator--(complex &z, int)
+{
+    auto retval(z);
+    --z;
+    return retval;
+}
+
+// Equality operators.
+#if defined(MPPP_HAVE_CONCEPTS)
+template <typename T, typename U>
+requires ComplexOpTypes<T, U>
+#else
+template <typename T, typename U, complex_op_types_enabler<T, U> = 0>
+#endif
+    inline bool operator==(const T &a, const U &b)
+{
+    return detail::dispatch_complex_equality(a, b);
+}
+
+#if defined(MPPP_HAVE_CONCEPTS)
+template <typename T, typename U>
+requires ComplexOpTypes<T, U>
+#else
+template <typename T, typename U, complex_op_types_enabler<T, U> = 0>
+#endif
+    inline bool operator!=(const T &a, const U &b)
+{
+    return !(a == b);
+}
+
+} // namespace mppp
+
+#endif
+
+#endif
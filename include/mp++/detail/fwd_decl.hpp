@@ -21,6 +21,14 @@ template <std::size_t>
 class rational;
 
 class real;
+
+namespace detail
+{
+
+template <typename>
+struct s11n_traits;
+
+} // namespace detail
 } // namespace mppp
 
 #endif
@@ -230,8 +230,10 @@ constexpr Int digit_to_value(char c)
 
 #endif
 
+// NOTE: in C++20, the result can be computed
+// at compile time if it fits in static storage.
 template <std::size_t SSize, char... Chars>
-inline integer<SSize> integer_literal_impl()
+inline MPPP_CONSTEXPR_20 integer<SSize> integer_literal_impl()
 {
     // Turn the sequence of input chars
     // into a null-terminated char array.
@@ -305,73 +307,59 @@ inline integer<SSize> integer_literal_impl()
         return integer<SSize>{l};
     } else {
         // The literal needs more than 1 limb:
-        // build an array of limbs from the literal
-        // and use it to construct the integer
-        // arithmetically.
+        // compute the limb representation of the
+        // literal at compile time, and use it
+        // to construct the integer.
+
+        // An upper bound for the number of limbs
+        // needed to represent the literal (each digit
+        // requires at most 4 bits).
+        constexpr auto max_nlimbs = ndigits * 4u / unsigned(GMP_NUMB_BITS) + 1u;
 
         // Small wrapper to return an array
-        // from a lambda.
+        // (and its effective size) from a lambda.
         struct arr_wrap {
-            ::mp_limb_t arr[nlimbs];
+            ::mp_limb_t arr[max_nlimbs];
+            std::size_t size;
         };
 
-        constexpr auto limb_arr = [parse_limb]() {
+        constexpr auto limb_arr = []() {
             arr_wrap retval{};
 
-            // Manually compute the first limb, which might
-            // contain fewer digits than the others (in which
-            // case rem is non-null).
-            constexpr auto rem = ndigits % nd_limb;
-            const auto idx_end1 = sizeof...(Chars) - ndigits + (rem == 0u ? nd_limb : rem);
-            retval.arr[0] = parse_limb(sizeof...(Chars) - ndigits, idx_end1);
-
-            for (std::size_t i = 1; i < nlimbs; ++i) {
-                retval.arr[i] = parse_limb(idx_end1 + (i - 1u) * nd_limb, idx_end1 + i * nd_limb);
+            // Helper to compute l * base + c, where c < base. The
+            // low limb of the result is returned, the high limb (which is
+            // less than base) is written into c.
+            // NOTE: split l in two halves in order to avoid overflow.
+            auto mul_add = [](::mp_limb_t l, ::mp_limb_t &c) {
+                constexpr unsigned h = unsigned(GMP_NUMB_BITS) / 2u;
+                constexpr ::mp_limb_t h_mask = (::mp_limb_t(1) << h) - 1u;
+
+                const auto t0 = (l & h_mask) * static_cast<::mp_limb_t>(base) + c;
+                const auto t1 = (l >> h) * static_cast<::mp_limb_t>(base) + (t0 >> h);
+
+                c = t1 >> (unsigned(GMP_NUMB_BITS) - h);
+                return static_cast<::mp_limb_t>(((t1 << h) | (t0 & h_mask)) & GMP_NUMB_MASK);
+            };
+
+            // Accumulate the digits via Horner's scheme.
+            for (auto i = sizeof...(Chars) - ndigits; i < sizeof...(Chars); ++i) {
+                auto c = digit_to_value<base, ::mp_limb_t>(arr[i]);
+
+                for (std::size_t j = 0; j < retval.size; ++j) {
+                    retval.arr[j] = mul_add(retval.arr[j], c);
+                }
+
+                // NOTE: the most significant limb is always nonzero.
+                if (c != 0u) {
+                    assert(retval.size < max_nlimbs);
+                    retval.arr[retval.size++] = c;
+                }
             }
 
             return retval;
         }();
 
-        // Turn the limb array into an integer.
-        // Start with the least significant limb.
-        integer<SSize> retval{limb_arr.arr[nlimbs - 1u]}, tmp;
-
-        // A couple of variables used only in base 10.
-        [[maybe_unused]] const auto factor10 = []() {
-            if constexpr (base == 10) {
-                return mppp::pow_ui(integer<SSize>{10}, nd_limb);
-            } else {
-                return 0;
-            }
-        }();
-        [[maybe_unused]] auto cur_factor10(factor10);
-
-        if constexpr (base != 10) {
-            // NOTE: for bases other than 10, we will use bit shifting below.
-            // Make sure that we can represent the max shift amount
-            // via std::size_t.
-            static_assert(nlimbs <= std::numeric_limits<std::size_t>::max()
-                                        / static_cast<unsigned>(std::numeric_limits<::mp_limb_t>::digits));
-        }
-
-        for (std::size_t i = nlimbs - 1u; i > 0u; --i) {
-            tmp = limb_arr.arr[i - 1u];
-
-            if constexpr (base == 2) {
-                tmp <<= (nd_limb * (nlimbs - i));
-            } else if constexpr (base == 8) {
-                tmp <<= (nd_limb * 3u * (nlimbs - i));
-            } else if constexpr (base == 16) {
-                tmp <<= (nd_limb * 4u * (nlimbs - i));
-            } else {
-                tmp *= cur_factor10;
-                cur_factor10 *= factor10;
-            }
-
-            retval += tmp;
-        }
-
-        return retval;
+        return integer<SSize>{limb_arr.arr, limb_arr.size};
     }
 #else
     // Run the checks on the char sequence, and determine the base.
@@ -398,7 +386,7 @@ inline namespace literals
 
 #define MPPP_DECLARE_INTEGRAL_UDL(n)                                                                                   \
     template <char... Chars>                                                                                           \
-    inline integer<n> operator"" _z##n()                                                                               \
+    inline MPPP_CONSTEXPR_20 integer<n> operator"" _z##n()                                                             \
     {                                                                                                                  \
         return detail::integer_literal_impl<n, Chars...>();                                                            \
     }
@@ -258,6 +258,39 @@ constexpr int ignore(Args &&...)
     return 0;
 }
 
+// Wrapper around std::is_constant_evaluated(). If the constexpr
+// implementation of integer is not available, this will always
+// return false.
+constexpr bool is_constant_evaluated() noexcept
+{
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+// Value of the digit c in base base, following the conventions of mpz_set_str()
+// (which are shared by mpfr_set_str()). Returns -1 if c is not a valid digit.
+inline int str_digit_value(char c, int base)
+{
+    int retval;
+    if (c >= '0' && c <= '9') {
+        retval = c - '0';
+    } else if (c >= 'A' && c <= 'Z') {
+        retval = c - 'A' + 10;
+    } else if (c >= 'a' && c <= 'z') {
+        retval = c - 'a' + (base <= 36 ? 10 : 36);
+    } else {
+        return -1;
+    }
+    return retval < base ? retval : -1;
+}
+
+// End of the longest prefix of [first, last) which may be consumed by the parsing
+// of a floating-point value in base base via mpfr_strtofr() or strtod() (and similar).
+MPPP_DLL_PUBLIC const char *fp_str_prefix_end(const char *, const char *, int);
+
 #if defined(_MSC_VER)
 
 #pragma warning(pop)
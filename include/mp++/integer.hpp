@@ -30,6 +30,7 @@
 #include <new>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -39,6 +40,11 @@
 #include <string_view>
 #endif
 
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+#include <memory>
+#endif
+
+#include <mp++/charconv.hpp>
 #include <mp++/concepts.hpp>
 #include <mp++/detail/fwd_decl.hpp>
 #include <mp++/detail/gmp.hpp>
@@ -115,19 +121,53 @@ inline std::size_t get_mpz_size(const ::mpz_t n)
 
 // Structure for caching allocated arrays of limbs.
 // NOTE: needs to be public for testing purposes.
+// NOTE: the cached arrays are grouped in size classes. The classes
+// 0-15 contain arrays of exactly 1-16 limbs, the other classes
+// are geometrically spaced (4 classes per power of two) up to
+// max_supported_size limbs. Each class is a singly-linked list,
+// whose links are stored in the cached arrays themselves.
 struct MPPP_DLL_PUBLIC mpz_alloc_cache {
-    // Arrays up to this size will be cached.
-    static constexpr std::size_t max_size = 10;
-    // Max number of arrays to cache for each size.
-    static constexpr std::size_t max_entries = 100;
-    // The actual cache.
-    std::array<std::array<::mp_limb_t *, max_entries>, max_size> caches;
-    // The number of arrays actually stored in each cache entry.
-    std::array<std::size_t, max_size> sizes;
+    // Largest array size that can be cached.
+    static constexpr std::size_t max_supported_size = 8192;
+    // Number of size classes.
+    static constexpr std::size_t nclasses = 52;
+    // Default values for the runtime limits.
+    static constexpr std::size_t default_max_size = 10;
+    static constexpr std::size_t default_max_entries = 100;
+    // The heads of the lists of cached arrays.
+    std::array<::mp_limb_t *, nclasses> heads;
+    // The number of arrays actually stored in each size class.
+    std::array<std::size_t, nclasses> sizes;
+    // Runtime limits: arrays larger than max_size limbs will not be cached,
+    // and each size class will contain at most max_entries arrays.
+    std::size_t max_size;
+    std::size_t max_entries;
+    // Total number of bytes currently held by the cache.
+    std::size_t nbytes;
+    // Statistics.
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long evictions;
     // NOTE: use round brackets init for the usual GCC 4.8 workaround.
-    // NOTE: this will zero initialise recursively both members: we will
-    // have all nullptrs in the caches, and all cache sizes will be zeroes.
-    constexpr mpz_alloc_cache() : caches(), sizes() {}
+    // NOTE: this will zero initialise recursively both arrays: we will
+    // have all nullptrs in the heads, and all cache sizes will be zeroes.
+    constexpr mpz_alloc_cache()
+        : heads(), sizes(), max_size(default_max_size), max_entries(default_max_entries), nbytes(0), hits(0),
+          misses(0), evictions(0)
+    {
+    }
+    // Try to fetch from the cache an array of at least nlimbs limbs. On success,
+    // the array is returned and its size is written into alloc. Otherwise, nullptr is returned.
+    ::mp_limb_t *get(std::size_t nlimbs, std::size_t &alloc) noexcept;
+    // Try to store into the cache an array of alloc limbs. Returns false if the array
+    // could not be stored.
+    bool put(::mp_limb_t *ptr, std::size_t alloc) noexcept;
+    // Number of limbs that should be allocated, in case of a cache miss, for
+    // a request of nlimbs limbs. This rounds up nlimbs to the lower bound
+    // of a size class, so that the array can be reused for any request in the same class.
+    std::size_t alloc_size(std::size_t nlimbs) const noexcept;
+    // Deallocate cached arrays until the cache holds at most max_bytes bytes.
+    void trim(std::size_t max_bytes) noexcept;
     // Clear the cache, deallocating all the data in the arrays.
     void clear() noexcept;
     ~mpz_alloc_cache()
@@ -175,8 +215,38 @@ inline void mpz_init_set_nlimbs(mpz_struct_t &m0, const mpz_struct_t &m1)
 }
 
 // Convert an mpz to a string in a specific base, to be written into out.
+// NOTE: values with at most two limbs are converted without going through
+// mpz_get_str() in base 10 and in the power-of-two bases, and very large
+// values can be converted in parallel (see set_integer_str_nthreads()).
 MPPP_DLL_PUBLIC void mpz_to_str(std::vector<char> &, const mpz_struct_t *, int = 10);
 
+// Fast conversion of a string representing a value with at most two limbs. On success,
+// the limbs and the signed size of the value are written into the output arguments.
+// Returns false if the string cannot be handled by the fast path (this includes
+// invalid strings).
+MPPP_DLL_PUBLIC bool str_to_small_limbs(const char *, int, ::mp_limb_t *, mpz_size_t &);
+
+// Wrapper around mpz_set_str() which can convert very long strings in parallel.
+MPPP_DLL_PUBLIC int mpz_set_str_wrap(mpz_struct_t &, const char *, int);
+
+// Write the representation of an mpz in a specific base into a character range,
+// without terminator.
+MPPP_DLL_PUBLIC to_chars_result mpz_to_chars(char *, char *, const mpz_struct_t *, int);
+
+// Compute the shortest string of digits in base base which, multiplied by base**exp, rounds to
+// nearest (with ties to even) to the binary floating-point value m * 2**e. m is a positive integer
+// whose bit size is the precision of the value, lower_closer signals that the lower neighbour of the
+// value is at half the distance of the upper one (i.e., m is a power of two and the value is not the
+// smallest normal value). The digits are written into out as a null-terminated string, exp is returned.
+MPPP_DLL_PUBLIC long long fp_shortest_digits(std::vector<char> &, const mpz_struct_t *, long long, bool, int);
+
+// Parse the integer at the beginning of a character range in a specific base. On success,
+// if the value fits in two limbs its limbs and signed size are written into the output arguments
+// and the output mpz pointer is set to null, otherwise the output mpz pointer
+// is set to a thread-local mpz containing the value.
+MPPP_DLL_PUBLIC from_chars_result mpz_from_chars(const char *, const char *, int, ::mp_limb_t *, mpz_size_t &,
+                                                 const mpz_struct_t *&);
+
 // Convenience overload for the above.
 inline std::string mpz_to_str(const mpz_struct_t *mpz, int base = 10)
 {
@@ -186,7 +256,7 @@ inline std::string mpz_to_str(const mpz_struct_t *mpz, int base = 10)
 }
 
 // Small wrapper to copy limbs.
-inline void copy_limbs(const ::mp_limb_t *begin, const ::mp_limb_t *end, ::mp_limb_t *out)
+inline MPPP_CONSTEXPR_20 void copy_limbs(const ::mp_limb_t *begin, const ::mp_limb_t *end, ::mp_limb_t *out)
 {
     for (; begin != end; ++begin, ++out) {
         *out = *begin;
@@ -194,7 +264,8 @@ inline void copy_limbs(const ::mp_limb_t *begin, const ::mp_limb_t *end, ::mp_li
 }
 
 // The version with non-overlapping ranges.
-inline void copy_limbs_no(const ::mp_limb_t *begin, const ::mp_limb_t *end, ::mp_limb_t *MPPP_RESTRICT out)
+inline MPPP_CONSTEXPR_20 void copy_limbs_no(const ::mp_limb_t *begin, const ::mp_limb_t *end,
+                                              ::mp_limb_t *MPPP_RESTRICT out)
 {
     assert(begin != out);
     for (; begin != end; ++begin, ++out) {
@@ -296,14 +367,14 @@ using limb_array_t = typename limb_array_t_<T>::type;
 // If GMP_NUMB_BITS is not smaller than the bit size of T, then an assertion will fire. We need this
 // little helper in order to avoid compiler warnings.
 template <typename T>
-inline void u_checked_rshift(T &n, const std::true_type &)
+inline MPPP_CONSTEXPR_20 void u_checked_rshift(T &n, const std::true_type &)
 {
     static_assert(is_integral<T>::value && is_unsigned<T>::value, "Invalid type.");
     n >>= GMP_NUMB_BITS;
 }
 
 template <typename T>
-inline void u_checked_rshift(T &, const std::false_type &)
+inline MPPP_CONSTEXPR_20 void u_checked_rshift(T &, const std::false_type &)
 {
     static_assert(is_integral<T>::value && is_unsigned<T>::value, "Invalid type.");
     assert(false);
@@ -312,7 +383,7 @@ inline void u_checked_rshift(T &, const std::false_type &)
 // Convert a large unsigned integer into a limb array, and return the effective size.
 // n must be > GMP_NUMB_MAX.
 template <typename T>
-inline std::size_t uint_to_limb_array(limb_array_t<T> &rop, T n)
+inline MPPP_CONSTEXPR_20 std::size_t uint_to_limb_array(limb_array_t<T> &rop, T n)
 {
     static_assert(is_integral<T>::value && is_unsigned<T>::value, "Invalid type.");
     assert(n > GMP_NUMB_MAX);
@@ -405,9 +476,11 @@ struct static_int {
     static const std::size_t opt_size = 2;
     // Zero the limbs from index idx up to the end of the limbs array, but only
     // if the static size is a target for special optimisations.
-    void zero_upper_limbs(std::size_t idx)
+    // NOTE: during constant evaluation, we always zero the upper limbs,
+    // as the value of a constant expression cannot contain uninited limbs.
+    MPPP_CONSTEXPR_20 void zero_upper_limbs(std::size_t idx)
     {
-        if (SSize <= opt_size) {
+        if (SSize <= opt_size || is_constant_evaluated()) {
             std::fill(m_limbs.begin() + idx, m_limbs.end(), ::mp_limb_t(0));
         }
     }
@@ -416,21 +489,21 @@ struct static_int {
     // This is normally not needed, but it is useful when using the GMP mpn api on a static int:
     // the GMP api does not clear unused limbs, but we rely on unused limbs being zero when optimizing operations
     // for few static limbs.
-    void zero_unused_limbs()
+    MPPP_CONSTEXPR_20 void zero_unused_limbs()
     {
         zero_upper_limbs(static_cast<std::size_t>(abs_size()));
     }
     // Default constructor, inits to zero.
-    static_int() : _mp_size(0)
+    MPPP_CONSTEXPR_20 static_int() : _mp_size(0)
     {
         // Zero the limbs, if needed.
         zero_upper_limbs(0);
     }
     // Let's avoid copying the _mp_alloc member, as it is never written to and it must always
     // have the same value.
-    static_int(const static_int &other) : _mp_size(other._mp_size)
+    MPPP_CONSTEXPR_20 static_int(const static_int &other) : _mp_size(other._mp_size)
     {
-        if (SSize <= opt_size) {
+        if (SSize <= opt_size || is_constant_evaluated()) {
             // In this case, we know that other's upper limbs are already
             // properly zeroed.
             m_limbs = other.m_limbs;
@@ -443,11 +516,11 @@ struct static_int {
         }
     }
     // Same as copy constructor.
-    static_int(static_int &&other) noexcept : static_int(other) {}
+    MPPP_CONSTEXPR_20 static_int(static_int &&other) noexcept : static_int(other) {}
     // These 2 constructors are used in the generic constructor of integer_union.
     //
     // Constructor from a size and a single limb (will be the least significant limb).
-    explicit static_int(mpz_size_t size, ::mp_limb_t l) : _mp_size(size)
+    MPPP_CONSTEXPR_20 explicit static_int(mpz_size_t size, ::mp_limb_t l) : _mp_size(size)
     {
         // Input sanity checks.
         assert(size <= s_size && size >= -s_size);
@@ -465,7 +538,8 @@ struct static_int {
     }
     // Constructor from a (signed) size and a limb range. The limbs in the range will be
     // copied as the least significant limbs.
-    explicit static_int(mpz_size_t size, const ::mp_limb_t *begin, std::size_t asize) : _mp_size(size)
+    MPPP_CONSTEXPR_20 explicit static_int(mpz_size_t size, const ::mp_limb_t *begin, std::size_t asize)
+        : _mp_size(size)
     {
         // Input sanity checks.
         assert(asize <= SSize);
@@ -478,10 +552,10 @@ struct static_int {
         // Zero fill the remaining limbs, if needed.
         zero_upper_limbs(asize);
     }
-    static_int &operator=(const static_int &other)
+    MPPP_CONSTEXPR_20 static_int &operator=(const static_int &other)
     {
         _mp_size = other._mp_size;
-        if (SSize <= opt_size) {
+        if (SSize <= opt_size || is_constant_evaluated()) {
             // In this case, we know other's upper limbs are properly zeroed out.
             // NOTE: self assignment of std::array should be fine.
             m_limbs = other.m_limbs;
@@ -494,7 +568,7 @@ struct static_int {
         }
         return *this;
     }
-    static_int &operator=(static_int &&other) noexcept
+    MPPP_CONSTEXPR_20 static_int &operator=(static_int &&other) noexcept
     {
         // Just forward to the copy assignment.
         return operator=(other);
@@ -531,7 +605,7 @@ struct static_int {
 #pragma GCC diagnostic ignored "-Wsuggest-attribute=pure"
 
 #endif
-    bool dtor_checks() const
+    MPPP_CONSTEXPR_20 bool dtor_checks() const
     {
         // LCOV_EXCL_START
         const auto asize = abs_size();
@@ -564,14 +638,15 @@ struct static_int {
 #pragma GCC diagnostic pop
 
 #endif
-    ~static_int()
+    MPPP_CONSTEXPR_20 ~static_int()
     {
         assert(dtor_checks());
     }
     // Size in limbs (absolute value of the _mp_size member).
-    mpz_size_t abs_size() const
+    // NOTE: avoid std::abs(), which is not constexpr.
+    MPPP_CONSTEXPR_20 mpz_size_t abs_size() const
     {
-        return std::abs(_mp_size);
+        return _mp_size >= 0 ? _mp_size : -_mp_size;
     }
     // NOTE: the retval here can be used only in read-only mode, otherwise
     // we will have UB due to the const_cast use.
@@ -589,13 +664,25 @@ template <std::size_t SSize>
 union integer_union {
     using s_storage = static_int<SSize>;
     using d_storage = mpz_struct_t;
+    // Activate the static member, constructing it from args.
+    // NOTE: placement new cannot be used in constant expressions,
+    // use std::construct_at() if available.
+    template <typename... Args>
+    MPPP_CONSTEXPR_20 void construct_st(Args &&... args)
+    {
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+        std::construct_at(&m_st, std::forward<Args>(args)...);
+#else
+        ::new (static_cast<void *>(&m_st)) s_storage(std::forward<Args>(args)...);
+#endif
+    }
     // Def ctor, will init to static.
-    integer_union() : m_st() {}
+    MPPP_CONSTEXPR_20 integer_union() : m_st() {}
     // Copy constructor, does a deep copy maintaining the storage class of other.
-    integer_union(const integer_union &other)
+    MPPP_CONSTEXPR_20 integer_union(const integer_union &other)
     {
         if (other.is_static()) {
-            ::new (static_cast<void *>(&m_st)) s_storage(other.g_st());
+            construct_st(other.g_st());
         } else {
             ::new (static_cast<void *>(&m_dy)) d_storage;
             mpz_init_set_nlimbs(m_dy, other.g_dy());
@@ -603,11 +690,11 @@ union integer_union {
         }
     }
     // Move constructor. Will downgrade other to a static zero integer if other is dynamic.
-    integer_union(integer_union &&other) noexcept
+    MPPP_CONSTEXPR_20 integer_union(integer_union &&other) noexcept
     {
         if (other.is_static()) {
             // Activate the static member with a copy.
-            ::new (static_cast<void *>(&m_st)) s_storage(other.g_st());
+            construct_st(other.g_st());
         } else {
             // Activate dynamic member and shallow copy it from other.
             ::new (static_cast<void *>(&m_dy)) d_storage(other.g_dy());
@@ -617,20 +704,20 @@ union integer_union {
         }
     }
     // Special casing for bool.
-    void dispatch_generic_ctor(bool b)
+    MPPP_CONSTEXPR_20 void dispatch_generic_ctor(bool b)
     {
         // Construct the static. No need for masking in the only limb.
-        ::new (static_cast<void *>(&m_st)) s_storage{static_cast<mpz_size_t>(b), static_cast<::mp_limb_t>(b)};
+        construct_st(static_cast<mpz_size_t>(b), static_cast<::mp_limb_t>(b));
     }
     // Construction from unsigned ints. The Neg flag will negate the integer after construction, it is for use in
     // the constructor from signed ints.
     template <typename T, bool Neg = false, enable_if_t<conjunction<is_integral<T>, is_unsigned<T>>::value, int> = 0>
-    void dispatch_generic_ctor(T n)
+    MPPP_CONSTEXPR_20 void dispatch_generic_ctor(T n)
     {
         if (n <= GMP_NUMB_MAX) {
             // Special codepath if n fits directly in a single limb.
             // No need for the mask as we are sure that n <= GMP_NUMB_MAX.
-            ::new (static_cast<void *>(&m_st)) s_storage{Neg ? -(n != 0u) : (n != 0u), static_cast<::mp_limb_t>(n)};
+            construct_st(static_cast<mpz_size_t>(Neg ? -(n != 0u) : (n != 0u)), static_cast<::mp_limb_t>(n));
             return;
         }
         // Convert n into an array of limbs.
@@ -644,7 +731,7 @@ union integer_union {
     }
     // Construction from signed ints.
     template <typename T, enable_if_t<conjunction<is_integral<T>, is_signed<T>>::value, int> = 0>
-    void dispatch_generic_ctor(T n)
+    MPPP_CONSTEXPR_20 void dispatch_generic_ctor(T n)
     {
         if (n >= T(0)) {
             // Positive value, just cast to unsigned.
@@ -685,7 +772,7 @@ union integer_union {
 #endif
     // The generic constructor.
     template <typename T>
-    explicit integer_union(const T &x)
+    MPPP_CONSTEXPR_20 explicit integer_union(const T &x)
     {
         dispatch_generic_ctor(x);
     }
@@ -697,8 +784,16 @@ union integer_union {
                 "In the constructor of integer from string, a base of " + to_string(base)
                 + " was specified, but the only valid values are 0 and any value in the [2,62] range");
         }
+        // Fast path for short strings, which does not need a temporary mpz.
+        ::mp_limb_t limbs[2];
+        mpz_size_t size;
+        if (str_to_small_limbs(s, base, limbs, size)) {
+            const mpz_struct_t view{2, size, limbs};
+            dispatch_mpz_ctor(&view);
+            return;
+        }
         MPPP_MAYBE_TLS mpz_raii mpz;
-        if (mppp_unlikely(::mpz_set_str(&mpz.m_mpz, s, base))) {
+        if (mppp_unlikely(mpz_set_str_wrap(mpz.m_mpz, s, base))) {
             if (base) {
                 throw std::invalid_argument(std::string("The string '") + s + "' is not a valid integer in base "
                                             + to_string(base));
@@ -761,7 +856,7 @@ union integer_union {
     // Implementation of the ctor from an array of limbs. CheckArray establishes
     // if p is checked for sanity.
     template <bool CheckArray>
-    void construct_from_limb_array(const ::mp_limb_t *p, std::size_t size)
+    MPPP_CONSTEXPR_20 void construct_from_limb_array(const ::mp_limb_t *p, std::size_t size)
     {
         if (CheckArray) {
             // If size is not zero, then the most significant limb must contain something.
@@ -785,7 +880,7 @@ union integer_union {
         if (size <= SSize) {
             // Fits into small. This constructor will take care
             // of zeroing out the top limbs as well.
-            ::new (static_cast<void *>(&m_st)) s_storage{static_cast<mpz_size_t>(size), p, size};
+            construct_st(static_cast<mpz_size_t>(size), p, size);
         } else {
             // Convert size to mpz_size_t before anything else, for exception safety.
             const auto s = safe_cast<mpz_size_t>(size);
@@ -806,7 +901,7 @@ union integer_union {
         }
     }
     // Constructor from array of limbs.
-    explicit integer_union(const ::mp_limb_t *p, std::size_t size)
+    MPPP_CONSTEXPR_20 explicit integer_union(const ::mp_limb_t *p, std::size_t size)
     {
         construct_from_limb_array<true>(p, size);
     }
@@ -826,7 +921,7 @@ union integer_union {
         }
     }
     // Copy assignment operator, performs a deep copy maintaining the storage class.
-    integer_union &operator=(const integer_union &other)
+    MPPP_CONSTEXPR_20 integer_union &operator=(const integer_union &other)
     {
         const bool s1 = is_static(), s2 = other.is_static();
         if (s1 && s2) {
@@ -853,7 +948,7 @@ union integer_union {
     }
     // Move assignment, same as above plus possibly steals resources. If this is static
     // and other is dynamic, other is downgraded to a zero static.
-    integer_union &operator=(integer_union &&other) noexcept
+    MPPP_CONSTEXPR_20 integer_union &operator=(integer_union &&other) noexcept
     {
         const bool s1 = is_static(), s2 = other.is_static();
         if (s1 && s2) {
@@ -878,7 +973,7 @@ union integer_union {
         }
         return *this;
     }
-    ~integer_union()
+    MPPP_CONSTEXPR_20 ~integer_union()
     {
         if (is_static()) {
             g_st().~s_storage();
@@ -895,31 +990,31 @@ union integer_union {
         g_dy().~d_storage();
     }
     // Check storage type.
-    bool is_static() const
+    MPPP_CONSTEXPR_20 bool is_static() const
     {
         return m_st._mp_alloc == s_storage::s_alloc;
     }
-    bool is_dynamic() const
+    MPPP_CONSTEXPR_20 bool is_dynamic() const
     {
         return m_st._mp_alloc != s_storage::s_alloc;
     }
     // Getters for st and dy.
-    const s_storage &g_st() const
+    MPPP_CONSTEXPR_20 const s_storage &g_st() const
     {
         assert(is_static());
         return m_st;
     }
-    s_storage &g_st()
+    MPPP_CONSTEXPR_20 s_storage &g_st()
     {
         assert(is_static());
         return m_st;
     }
-    const d_storage &g_dy() const
+    MPPP_CONSTEXPR_20 const d_storage &g_dy() const
     {
         assert(is_dynamic());
         return m_dy;
     }
-    d_storage &g_dy()
+    MPPP_CONSTEXPR_20 d_storage &g_dy()
     {
         assert(is_dynamic());
         return m_dy;
@@ -969,7 +1064,7 @@ union integer_union {
         return true;
     }
     // Negation.
-    void neg()
+    MPPP_CONSTEXPR_20 void neg()
     {
         if (is_static()) {
             g_st()._mp_size = -g_st()._mp_size;
@@ -981,6 +1076,175 @@ union integer_union {
     s_storage m_st;
     d_storage m_dy;
 };
+
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+
+// Constexpr implementations of the basic arithmetic primitives
+// for static integers. These are used in place of the mpn functions
+// and of the optimised kernels during constant evaluation. They
+// operate only on static integers, and they throw if the result
+// does not fit in static storage.
+
+// Add a, b and the carry c, store the result in res and return the new carry.
+constexpr ::mp_limb_t constexpr_limb_add(::mp_limb_t a, ::mp_limb_t b, ::mp_limb_t c, ::mp_limb_t &res)
+{
+    if constexpr (GMP_NAIL_BITS == 0) {
+        const ::mp_limb_t s = a + b, r = s + c;
+        res = r;
+        return static_cast<::mp_limb_t>(s < a) + static_cast<::mp_limb_t>(r < s);
+    } else {
+        const ::mp_limb_t r = a + b + c;
+        res = r & GMP_NUMB_MASK;
+        return r >> GMP_NUMB_BITS;
+    }
+}
+
+// Subtract b and the borrow c from a, store the result in res and return the new borrow.
+constexpr ::mp_limb_t constexpr_limb_sub(::mp_limb_t a, ::mp_limb_t b, ::mp_limb_t c, ::mp_limb_t &res)
+{
+    if constexpr (GMP_NAIL_BITS == 0) {
+        const ::mp_limb_t d = a - b, r = d - c;
+        res = r;
+        return static_cast<::mp_limb_t>(a < b) + static_cast<::mp_limb_t>(d < c);
+    } else {
+        const ::mp_limb_t r = a - b - c;
+        res = r & GMP_NUMB_MASK;
+        return r >> (nl_digits<::mp_limb_t>() - 1);
+    }
+}
+
+// Multiply a by b, store the high limb of the result in hi and return the low limb.
+constexpr ::mp_limb_t constexpr_limb_mul(::mp_limb_t a, ::mp_limb_t b, ::mp_limb_t &hi)
+{
+    // Compute the double-width product.
+    ::mp_limb_t lo_w = 0, hi_w = 0;
+#if defined(MPPP_HAVE_GCC_INT128)
+    if constexpr (nl_digits<::mp_limb_t>() == 64) {
+        const auto prod = static_cast<__uint128_t>(a) * b;
+        lo_w = static_cast<::mp_limb_t>(prod);
+        hi_w = static_cast<::mp_limb_t>(prod >> 64);
+    } else
+#endif
+    {
+        // Schoolbook multiplication on half-limbs.
+        constexpr unsigned half = unsigned(nl_digits<::mp_limb_t>()) / 2u;
+        constexpr ::mp_limb_t lo_mask = (::mp_limb_t(1) << half) - 1u;
+        const auto a0 = a & lo_mask, a1 = a >> half, b0 = b & lo_mask, b1 = b >> half;
+        const auto p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+        const auto mid = (p00 >> half) + (p01 & lo_mask) + (p10 & lo_mask);
+        hi_w = p11 + (p01 >> half) + (p10 >> half) + (mid >> half);
+        lo_w = (p00 & lo_mask) | (mid << half);
+    }
+    // Split the product at GMP_NUMB_BITS.
+    if constexpr (GMP_NAIL_BITS == 0) {
+        hi = hi_w;
+        return lo_w;
+    } else {
+        hi = (hi_w << GMP_NAIL_BITS) | (lo_w >> GMP_NUMB_BITS);
+        return lo_w & GMP_NUMB_MASK;
+    }
+}
+
+// Compare the n limbs in a and b.
+constexpr int constexpr_mpn_cmp(const ::mp_limb_t *a, const ::mp_limb_t *b, std::size_t n)
+{
+    while (n != 0u) {
+        --n;
+        if ((a[n] & GMP_NUMB_MASK) != (b[n] & GMP_NUMB_MASK)) {
+            return (a[n] & GMP_NUMB_MASK) > (b[n] & GMP_NUMB_MASK) ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+template <std::size_t SSize>
+constexpr int constexpr_static_cmp(const static_int<SSize> &n1, const static_int<SSize> &n2)
+{
+    if (n1._mp_size != n2._mp_size) {
+        return n1._mp_size < n2._mp_size ? -1 : 1;
+    }
+    const int cmp_abs
+        = constexpr_mpn_cmp(n1.m_limbs.data(), n2.m_limbs.data(), static_cast<std::size_t>(n1.abs_size()));
+    return n1._mp_size >= 0 ? cmp_abs : -cmp_abs;
+}
+
+// Assign to rop the result of a computation stored in the first asize limbs of the array tmp.
+template <std::size_t SSize, std::size_t N>
+constexpr void constexpr_static_assign(static_int<SSize> &rop, const std::array<::mp_limb_t, N> &tmp,
+                                       std::size_t asize, bool negative)
+{
+    // Normalise the size.
+    while (asize != 0u && tmp[asize - 1u] == 0u) {
+        --asize;
+    }
+    if (asize > SSize) {
+        throw std::overflow_error("The result of a constant-evaluated integer operation does not fit in "
+                                  + to_string(SSize) + " static limb(s)");
+    }
+    const auto size = static_cast<mpz_size_t>(asize);
+    rop = static_int<SSize>(negative ? -size : size, tmp.data(), asize);
+}
+
+// Addition (AddOrSub == true) or subtraction (AddOrSub == false).
+template <bool AddOrSub, std::size_t SSize>
+constexpr void constexpr_static_addsub(static_int<SSize> &rop, const static_int<SSize> &op1,
+                                       const static_int<SSize> &op2)
+{
+    const auto asize1 = static_cast<std::size_t>(op1.abs_size()), asize2 = static_cast<std::size_t>(op2.abs_size());
+    const bool neg1 = op1._mp_size < 0, neg2 = AddOrSub ? (op2._mp_size < 0) : (op2._mp_size > 0);
+    // NOTE: the result is computed in a local buffer, as rop might
+    // overlap with op1 and/or op2.
+    std::array<::mp_limb_t, SSize + 1u> tmp{};
+    const ::mp_limb_t *data1 = op1.m_limbs.data(), *data2 = op2.m_limbs.data();
+    if (neg1 == neg2 || asize2 == 0u) {
+        // Same sign: add the absolute values.
+        ::mp_limb_t c = 0;
+        const auto max_asize = c_max(asize1, asize2);
+        for (std::size_t i = 0; i < max_asize; ++i) {
+            c = constexpr_limb_add(i < asize1 ? data1[i] : 0u, i < asize2 ? data2[i] : 0u, c, tmp[i]);
+        }
+        tmp[max_asize] = c;
+        constexpr_static_assign(rop, tmp, max_asize + 1u, asize1 ? neg1 : neg2);
+        return;
+    }
+    // Different signs: subtract the smaller absolute value from the larger one.
+    int cmp_abs = asize1 == asize2 ? constexpr_mpn_cmp(data1, data2, asize1) : (asize1 > asize2 ? 1 : -1);
+    bool negative = neg1;
+    if (cmp_abs < 0) {
+        std::swap(data1, data2);
+        negative = neg2;
+    }
+    const auto max_asize = c_max(asize1, asize2), min_asize = c_min(asize1, asize2);
+    ::mp_limb_t c = 0;
+    for (std::size_t i = 0; i < max_asize; ++i) {
+        c = constexpr_limb_sub(data1[i], i < min_asize ? data2[i] : 0u, c, tmp[i]);
+    }
+    assert(c == 0u);
+    constexpr_static_assign(rop, tmp, max_asize, negative);
+}
+
+// Multiplication.
+template <std::size_t SSize>
+constexpr void constexpr_static_mul(static_int<SSize> &rop, const static_int<SSize> &op1,
+                                    const static_int<SSize> &op2)
+{
+    const auto asize1 = static_cast<std::size_t>(op1.abs_size()), asize2 = static_cast<std::size_t>(op2.abs_size());
+    std::array<::mp_limb_t, SSize * 2u> tmp{};
+    for (std::size_t i = 0; i < asize1; ++i) {
+        ::mp_limb_t c = 0;
+        for (std::size_t j = 0; j < asize2; ++j) {
+            ::mp_limb_t hi = 0;
+            const auto lo = constexpr_limb_mul(op1.m_limbs[i] & GMP_NUMB_MASK, op2.m_limbs[j] & GMP_NUMB_MASK, hi);
+            // NOTE: hi + the carry of the addition cannot overflow.
+            c = static_cast<::mp_limb_t>(hi + constexpr_limb_add(tmp[i + j], lo, c, tmp[i + j]));
+        }
+        tmp[i + asize2] = c;
+    }
+    constexpr_static_assign(rop, tmp, asize1 + asize2, (op1._mp_size < 0) != (op2._mp_size < 0));
+}
+
+#endif
+
 } // namespace detail
 
 // Fwd declarations.
@@ -1194,6 +1458,22 @@ void nextprime_impl(integer<SSize> &, const integer<SSize> &);
  * promoted to :cpp:class:`~mppp::integer` if they are both integral types, otherwise they are promoted to the type
  * of the floating-point argument).
  *
+ * .. versionadded:: 0.20
+ *
+ * In C++20, the construction from integral values and from arrays of limbs, the copy and move operations,
+ * the addition, subtraction, multiplication, negation and comparison of :cpp:class:`~mppp::integer` objects
+ * with each other and with :cpp:concept:`~mppp::CppIntegralInteroperable` values, and the
+ * :ref:`user-defined literals <integer_literals>` can be used in constant expressions, provided that
+ * all the values involved fit in static storage (a result which does not fit in static storage is a
+ * compile-time error). This makes it possible, e.g., to compute tables of multiprecision values at
+ * compile time:
+ *
+ * .. code-block:: c++
+ *
+ *    constexpr auto a = 18446744073709551616_z2; // 2**64.
+ *    constexpr auto b = a * a - 1; // 2**128 - 1.
+ *    static_assert(b > a);
+ *
  * Several facilities for interfacing with the GMP library are provided. Specifically, :cpp:class:`~mppp::integer`
  * features:
  *
@@ -1222,7 +1502,8 @@ void nextprime_impl(integer<SSize> &, const integer<SSize> &);
  * The :cpp:class:`~mppp::integer` class supports a simple binary serialisation API, through member functions
  * such as :cpp:func:`~mppp::integer::binary_save()` and :cpp:func:`~mppp::integer::binary_load()`, and the
  * corresponding :ref:`free function overloads <integer_s11n>`. Examples of usage are described in the
- * :ref:`integer tutorial <tutorial_integer_s11n>`.
+ * :ref:`integer tutorial <tutorial_integer_s11n>`. A platform-independent format suitable for long-term
+ * storage is available via the :ref:`portable serialisation <serialization_reference>` functions.
  * \endrststar
  */
 template <std::size_t SSize>
@@ -1296,6 +1577,9 @@ class integer
     // Make friends with rational.
     template <std::size_t>
     friend class rational;
+    // Make friends with the portable serialisation machinery.
+    template <typename>
+    friend struct detail::s11n_traits;
 
 public:
     /// Alias for the template parameter \p SSize.
@@ -1356,7 +1640,7 @@ public:
      * one element of the ``p`` array is greater than ``GMP_NUMB_MAX``.
      * @throws std::overflow_error if ``size`` is larger than an implementation-defined limit.
      */
-    explicit integer(const ::mp_limb_t *p, std::size_t size) : m_int(p, size) {}
+    MPPP_CONSTEXPR_20 explicit integer(const ::mp_limb_t *p, std::size_t size) : m_int(p, size) {}
     /// Constructor from number of bits.
     /**
      * \rststar
@@ -1392,7 +1676,7 @@ public:
 #else
     template <typename T, cpp_interoperable_enabler<T> = 0>
 #endif
-    explicit integer(const T &x) : m_int(x)
+    MPPP_CONSTEXPR_20 explicit integer(const T &x) : m_int(x)
     {
     }
     /// Generic constructor from a C++ complex type.
@@ -1546,7 +1830,7 @@ private:
     // Implementation of the assignment from unsigned C++ integral.
     template <typename T, bool Neg = false,
               detail::enable_if_t<detail::conjunction<detail::is_integral<T>, detail::is_unsigned<T>>::value, int> = 0>
-    void dispatch_assignment(T n)
+    MPPP_CONSTEXPR_20 void dispatch_assignment(T n)
     {
         const auto s = is_static();
         if (n <= GMP_NUMB_MAX) {
@@ -1625,7 +1909,7 @@ private:
     // Assignment from signed integral: take its abs() and negate if necessary, as usual.
     template <typename T,
               detail::enable_if_t<detail::conjunction<detail::is_integral<T>, detail::is_signed<T>>::value, int> = 0>
-    void dispatch_assignment(T n)
+    MPPP_CONSTEXPR_20 void dispatch_assignment(T n)
     {
         if (n >= T(0)) {
             // Positive value, just cast to unsigned.
@@ -1636,7 +1920,7 @@ private:
         }
     }
     // Special casing for bool.
-    void dispatch_assignment(bool n)
+    MPPP_CONSTEXPR_20 void dispatch_assignment(bool n)
     {
         if (is_static()) {
             m_int.g_st()._mp_size = static_cast<detail::mpz_size_t>(n);
@@ -1702,7 +1986,7 @@ public:
 #else
     template <typename T, cpp_interoperable_enabler<T> = 0>
 #endif
-    integer &operator=(const T &x)
+    MPPP_CONSTEXPR_20 integer &operator=(const T &x)
     {
         dispatch_assignment(x);
         return *this;
@@ -1956,7 +2240,7 @@ public:
     /**
      * @return \p true if the storage type is static, \p false otherwise.
      */
-    bool is_static() const
+    MPPP_CONSTEXPR_20 bool is_static() const
     {
         return m_int.is_static();
     }
@@ -1964,7 +2248,7 @@ public:
     /**
      * @return \p true if the storage type is dynamic, \p false otherwise.
      */
-    bool is_dynamic() const
+    MPPP_CONSTEXPR_20 bool is_dynamic() const
     {
         return m_int.is_dynamic();
     }
@@ -2372,7 +2656,7 @@ public:
     /**
      * @return the number of limbs needed to represent \p this. If \p this is zero, zero will be returned.
      */
-    std::size_t size() const
+    MPPP_CONSTEXPR_20 std::size_t size() const
     {
         // NOTE: the idea here is that, regardless of what mpz_size_t is exactly, the
         // asize of an integer represents ultimately the size of a limb array, and as such
@@ -2384,7 +2668,7 @@ public:
     /**
      * @return 0 if \p this is zero, 1 if \p this is positive, -1 if \p this is negative.
      */
-    int sgn() const
+    MPPP_CONSTEXPR_20 int sgn() const
     {
         // NOTE: size is part of the common initial sequence.
         return detail::integral_sign(m_int.m_st._mp_size);
@@ -2426,7 +2710,7 @@ public:
      *
      * @return a reference to \p this.
      */
-    integer &neg()
+    MPPP_CONSTEXPR_20 integer &neg()
     {
         m_int.neg();
         return *this;
@@ -2536,7 +2820,7 @@ public:
      *
      * @return a reference to the internal union member.
      */
-    detail::integer_union<SSize> &_get_union()
+    MPPP_CONSTEXPR_20 detail::integer_union<SSize> &_get_union()
     {
         return m_int;
     }
@@ -2546,7 +2830,7 @@ public:
      *
      * @return a const reference to the internal union member.
      */
-    const detail::integer_union<SSize> &_get_union() const
+    MPPP_CONSTEXPR_20 const detail::integer_union<SSize> &_get_union() const
     {
         return m_int;
     }
@@ -2576,7 +2860,7 @@ public:
     /**
      * @return \p true if the value represented by \p this is zero, \p false otherwise.
      */
-    bool is_zero() const
+    MPPP_CONSTEXPR_20 bool is_zero() const
     {
         return m_int.m_st._mp_size == 0;
     }
@@ -2848,17 +3132,13 @@ private:
         // that a value in the std::size_t range was written into the buffer.
         return std::make_pair(size, size >= 0 ? detail::make_unsigned(size) : detail::nint_abs(size));
     }
-    // Low level implementation of binary load. src must point to the start of the serialised
-    // limb array.
-    void binary_load_impl(const char *src, const detail::mpz_size_t &size,
-                          const detail::make_unsigned_t<detail::mpz_size_t> &asize)
+    // Prepare the storage of this for the deserialisation of a value with signed size size
+    // and absolute size asize, and then invoke fill() on the limb array. fill() must write
+    // exactly asize limbs.
+    template <typename F>
+    void binary_load_limbs(const detail::mpz_size_t &size, const detail::make_unsigned_t<detail::mpz_size_t> &asize,
+                           const F &fill)
     {
-        // Check for overflow in asize.
-        // LCOV_EXCL_START
-        if (mppp_unlikely(asize > std::numeric_limits<std::size_t>::max() / sizeof(::mp_limb_t))) {
-            throw std::overflow_error(binary_size_errmsg);
-        }
-        // LCOV_EXCL_STOP
         // Detect current storage.
         const bool s = is_static();
         if (s && asize <= SSize) {
@@ -2866,12 +3146,9 @@ private:
             // Set the size.
             m_int.g_st()._mp_size = size;
             // Copy over the data from the source.
-            std::copy(src, src + static_cast<std::size_t>(sizeof(::mp_limb_t) * asize),
-                      detail::make_uai(reinterpret_cast<char *>(m_int.g_st().m_limbs.data())));
+            fill(m_int.g_st().m_limbs.data());
             // Clear the upper limbs, if needed.
             m_int.g_st().zero_upper_limbs(static_cast<std::size_t>(asize));
-            // Check the deserialised value.
-            bl_static_check(asize);
         } else if (s && asize > SSize) {
             // this is static, the content of src do not fit into static storage.
             // Destroy static storage.
@@ -2883,10 +3160,7 @@ private:
             // Set the size.
             m_int.g_dy()._mp_size = size;
             // Copy over the data from the source.
-            std::copy(src, src + static_cast<std::size_t>(sizeof(::mp_limb_t) * asize),
-                      detail::make_uai(reinterpret_cast<char *>(m_int.g_dy()._mp_d)));
-            // Check the deserialised value.
-            bl_dynamic_check(asize);
+            fill(m_int.g_dy()._mp_d);
         } else if (!s && asize <= SSize) {
             // this is dynamic, src contains a static integer.
             // Destroy the dynamic this.
@@ -2896,12 +3170,9 @@ private:
             // Set the size.
             m_int.g_st()._mp_size = size;
             // Copy over the data from the source.
-            std::copy(src, src + static_cast<std::size_t>(sizeof(::mp_limb_t) * asize),
-                      detail::make_uai(reinterpret_cast<char *>(m_int.g_st().m_limbs.data())));
             // NOTE: no need to clear the upper limbs: they were already zeroed out
             // by the default constructor of static_int.
-            // Check the deserialised value.
-            bl_static_check(asize);
+            fill(m_int.g_st().m_limbs.data());
         } else {
             // this is dynamic, src contains a dynamic integer.
             // If this does not have enough storage, we need to allocate.
@@ -2917,9 +3188,28 @@ private:
             // Set the size.
             m_int.g_dy()._mp_size = size;
             // Copy over the data from the source.
+            fill(m_int.g_dy()._mp_d);
+        }
+    }
+    // Low level implementation of binary load. src must point to the start of the serialised
+    // limb array.
+    void binary_load_impl(const char *src, const detail::mpz_size_t &size,
+                          const detail::make_unsigned_t<detail::mpz_size_t> &asize)
+    {
+        // Check for overflow in asize.
+        // LCOV_EXCL_START
+        if (mppp_unlikely(asize > std::numeric_limits<std::size_t>::max() / sizeof(::mp_limb_t))) {
+            throw std::overflow_error(binary_size_errmsg);
+        }
+        // LCOV_EXCL_STOP
+        binary_load_limbs(size, asize, [src, &asize](::mp_limb_t *rop) {
             std::copy(src, src + static_cast<std::size_t>(sizeof(::mp_limb_t) * asize),
-                      detail::make_uai(reinterpret_cast<char *>(m_int.g_dy()._mp_d)));
-            // Check the deserialised value.
+                      detail::make_uai(reinterpret_cast<char *>(rop)));
+        });
+        // Check the deserialised value.
+        if (is_static()) {
+            bl_static_check(asize);
+        } else {
             bl_dynamic_check(asize);
         }
     }
@@ -3660,8 +3950,15 @@ inline bool static_addsub(static_int<SSize> &rop, const static_int<SSize> &op1,
  * @return a reference to \p rop.
  */
 template <std::size_t SSize>
-inline integer<SSize> &add(integer<SSize> &rop, const integer<SSize> &op1, const integer<SSize> &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> &add(integer<SSize> &rop, const integer<SSize> &op1, const integer<SSize> &op2)
 {
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+    if (std::is_constant_evaluated()) {
+        detail::constexpr_static_addsub<true>(rop._get_union().g_st(), op1._get_union().g_st(),
+                                              op2._get_union().g_st());
+        return rop;
+    }
+#endif
     const bool s1 = op1.is_static(), s2 = op2.is_static();
     bool sr = rop.is_static();
     if (mppp_likely(s1 && s2)) {
@@ -3940,12 +4237,17 @@ inline integer<SSize> &add_ui_impl(integer<SSize> &rop, const integer<SSize> &op
  */
 #if defined(MPPP_HAVE_CONCEPTS)
 template <std::size_t SSize, CppUnsignedIntegralInteroperable T>
-inline integer<SSize> &add_ui(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> &add_ui(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
 #else
 template <std::size_t SSize, typename T, cpp_unsigned_integral_interoperable_enabler<T> = 0>
-inline integer<SSize> &add_ui(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> &add_ui(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
 #endif
 {
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+    if (std::is_constant_evaluated()) {
+        return add(rop, op1, integer<SSize>{op2});
+    }
+#endif
     return detail::add_ui_impl(rop, op1, op2);
 }
 
@@ -3965,10 +4267,10 @@ inline integer<SSize> &add_ui(integer<SSize> &rop, const integer<SSize> &op1, co
  */
 #if defined(MPPP_HAVE_CONCEPTS)
 template <std::size_t SSize, CppSignedIntegralInteroperable T>
-inline integer<SSize> &add_si(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> &add_si(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
 #else
 template <std::size_t SSize, typename T, cpp_signed_integral_interoperable_enabler<T> = 0>
-inline integer<SSize> &add_si(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> &add_si(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
 #endif
 {
     if (op2 >= detail::uncvref_t<decltype(op2)>(0)) {
@@ -3988,8 +4290,15 @@ inline integer<SSize> &add_si(integer<SSize> &rop, const integer<SSize> &op1, co
  * @return a reference to \p rop.
  */
 template <std::size_t SSize>
-inline integer<SSize> &sub(integer<SSize> &rop, const integer<SSize> &op1, const integer<SSize> &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> &sub(integer<SSize> &rop, const integer<SSize> &op1, const integer<SSize> &op2)
 {
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+    if (std::is_constant_evaluated()) {
+        detail::constexpr_static_addsub<false>(rop._get_union().g_st(), op1._get_union().g_st(),
+                                              op2._get_union().g_st());
+        return rop;
+    }
+#endif
     const bool s1 = op1.is_static(), s2 = op2.is_static();
     bool sr = rop.is_static();
     if (mppp_likely(s1 && s2)) {
@@ -4074,12 +4383,17 @@ inline integer<SSize> &sub_ui_impl(integer<SSize> &rop, const integer<SSize> &op
  */
 #if defined(MPPP_HAVE_CONCEPTS)
 template <std::size_t SSize, CppUnsignedIntegralInteroperable T>
-inline integer<SSize> &sub_ui(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> &sub_ui(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
 #else
 template <std::size_t SSize, typename T, cpp_unsigned_integral_interoperable_enabler<T> = 0>
-inline integer<SSize> &sub_ui(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> &sub_ui(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
 #endif
 {
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+    if (std::is_constant_evaluated()) {
+        return sub(rop, op1, integer<SSize>{op2});
+    }
+#endif
     return detail::sub_ui_impl(rop, op1, op2);
 }
 
@@ -4099,10 +4413,10 @@ inline integer<SSize> &sub_ui(integer<SSize> &rop, const integer<SSize> &op1, co
  */
 #if defined(MPPP_HAVE_CONCEPTS)
 template <std::size_t SSize, CppSignedIntegralInteroperable T>
-inline integer<SSize> &sub_si(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> &sub_si(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
 #else
 template <std::size_t SSize, typename T, cpp_signed_integral_interoperable_enabler<T> = 0>
-inline integer<SSize> &sub_si(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> &sub_si(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
 #endif
 {
     if (op2 >= detail::uncvref_t<decltype(op2)>(0)) {
@@ -4326,8 +4640,14 @@ inline std::size_t static_mul(static_int<SSize> &rop, const static_int<SSize> &o
  * @return a reference to \p rop.
  */
 template <std::size_t SSize>
-inline integer<SSize> &mul(integer<SSize> &rop, const integer<SSize> &op1, const integer<SSize> &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> &mul(integer<SSize> &rop, const integer<SSize> &op1, const integer<SSize> &op2)
 {
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+    if (std::is_constant_evaluated()) {
+        detail::constexpr_static_mul(rop._get_union().g_st(), op1._get_union().g_st(), op2._get_union().g_st());
+        return rop;
+    }
+#endif
     const bool s1 = op1.is_static(), s2 = op2.is_static();
     bool sr = rop.is_static();
     std::size_t size_hint = 0u;
@@ -4604,6 +4924,221 @@ inline integer<SSize> &submul(integer<SSize> &rop, const integer<SSize> &op1, co
     return rop;
 }
 
+#if !defined(MPPP_DOXYGEN_INVOKED)
+
+// Batched arithmetic.
+// NOTE: these functions run the static kernels directly in the loop, and they
+// resort to the GMP API only for the elements which are (or become) dynamic.
+// The ranges must either coincide or not overlap at all.
+namespace batch
+{
+
+template <std::size_t SSize>
+inline void add(integer<SSize> *rop, const integer<SSize> *op1, const integer<SSize> *op2, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        auto &r = rop[i];
+        const auto &a = op1[i], &b = op2[i];
+        if (mppp_likely(r.is_static() && a.is_static() && b.is_static())) {
+            if (mppp_likely(
+                    detail::static_addsub<true>(r._get_union().g_st(), a._get_union().g_st(), b._get_union().g_st()))) {
+                continue;
+            }
+            // NOTE: the static kernels do not touch rop on failure,
+            // thus we can go straight to the mpz API.
+            r._get_union().promote(SSize + 1u);
+            ::mpz_add(&r._get_union().g_dy(), a.get_mpz_view(), b.get_mpz_view());
+        } else {
+            mppp::add(r, a, b);
+        }
+    }
+}
+
+template <std::size_t SSize>
+inline void sub(integer<SSize> *rop, const integer<SSize> *op1, const integer<SSize> *op2, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        auto &r = rop[i];
+        const auto &a = op1[i], &b = op2[i];
+        if (mppp_likely(r.is_static() && a.is_static() && b.is_static())) {
+            if (mppp_likely(detail::static_addsub<false>(r._get_union().g_st(), a._get_union().g_st(),
+                                                         b._get_union().g_st()))) {
+                continue;
+            }
+            r._get_union().promote(SSize + 1u);
+            ::mpz_sub(&r._get_union().g_dy(), a.get_mpz_view(), b.get_mpz_view());
+        } else {
+            mppp::sub(r, a, b);
+        }
+    }
+}
+
+template <std::size_t SSize>
+inline void mul(integer<SSize> *rop, const integer<SSize> *op1, const integer<SSize> *op2, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        auto &r = rop[i];
+        const auto &a = op1[i], &b = op2[i];
+        if (mppp_likely(r.is_static() && a.is_static() && b.is_static())) {
+            const auto size_hint = detail::static_mul(r._get_union().g_st(), a._get_union().g_st(), b._get_union().g_st());
+            if (mppp_likely(size_hint == 0u)) {
+                continue;
+            }
+            r._get_union().promote(size_hint);
+            ::mpz_mul(&r._get_union().g_dy(), a.get_mpz_view(), b.get_mpz_view());
+        } else {
+            mppp::mul(r, a, b);
+        }
+    }
+}
+
+template <std::size_t SSize>
+inline void addmul(integer<SSize> *rop, const integer<SSize> *op1, const integer<SSize> *op2, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        auto &r = rop[i];
+        const auto &a = op1[i], &b = op2[i];
+        if (mppp_likely(r.is_static() && a.is_static() && b.is_static())) {
+            const auto size_hint
+                = detail::static_addsubmul<true>(r._get_union().g_st(), a._get_union().g_st(), b._get_union().g_st());
+            if (mppp_likely(size_hint == 0u)) {
+                continue;
+            }
+            r._get_union().promote(size_hint);
+            ::mpz_addmul(&r._get_union().g_dy(), a.get_mpz_view(), b.get_mpz_view());
+        } else {
+            mppp::addmul(r, a, b);
+        }
+    }
+}
+
+template <std::size_t SSize>
+inline void submul(integer<SSize> *rop, const integer<SSize> *op1, const integer<SSize> *op2, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        auto &r = rop[i];
+        const auto &a = op1[i], &b = op2[i];
+        if (mppp_likely(r.is_static() && a.is_static() && b.is_static())) {
+            const auto size_hint
+                = detail::static_addsubmul<false>(r._get_union().g_st(), a._get_union().g_st(), b._get_union().g_st());
+            if (mppp_likely(size_hint == 0u)) {
+                continue;
+            }
+            r._get_union().promote(size_hint);
+            ::mpz_submul(&r._get_union().g_dy(), a.get_mpz_view(), b.get_mpz_view());
+        } else {
+            mppp::submul(r, a, b);
+        }
+    }
+}
+
+} // namespace batch
+
+#endif
+
+namespace detail
+{
+
+// Metaprogramming for selecting the algorithm for mppp::dot().
+// The selection happens via an std::integral_constant with 2 possible values:
+// - 0 (default case): repeated addmul() into the return value,
+// - 1: products of 1-limb operands are accumulated without normalisation in
+//   3-limb unsigned accumulators (selected when the dlimb primitives are available).
+using integer_dot_algo = std::integral_constant<int, (integer_have_dlimb_mul::value && !GMP_NAIL_BITS) ? 1 : 0>;
+
+template <typename It1, typename It2, std::size_t SSize>
+inline void integer_dot_impl(integer<SSize> &rop, It1 first1, It1 last1, It2 first2,
+                             const std::integral_constant<int, 0> &)
+{
+    for (; first1 != last1; ++first1, ++first2) {
+        mppp::addmul(rop, *first1, *first2);
+    }
+}
+
+// Unsigned 3-limb accumulator for 2-limb products.
+struct integer_dot_acc {
+    // Add the 2-limb value (lo, hi).
+    // NOTE: the caller must ensure that m_limbs[2] < GMP_NUMB_MAX, so that the top limb cannot overflow.
+    void add(::mp_limb_t lo, ::mp_limb_t hi)
+    {
+        assert(m_limbs[2] < GMP_NUMB_MAX);
+        const auto c0 = limb_add_overflow(m_limbs[0], lo, &m_limbs[0]);
+        // NOTE: hi is the high limb of a 1-limb x 1-limb product, thus it is at most
+        // GMP_NUMB_MAX - 1 and hi + c0 cannot overflow.
+        const auto c1 = limb_add_overflow(m_limbs[1], hi + c0, &m_limbs[1]);
+        m_limbs[2] += c1;
+    }
+    // Add (or subtract) the accumulated value to rop, and reset the accumulator.
+    template <std::size_t SSize>
+    void flush(integer<SSize> &rop, bool neg)
+    {
+        std::size_t size = 3;
+        while (size && !m_limbs[size - 1u]) {
+            --size;
+        }
+        if (size) {
+            const integer<SSize> tmp{m_limbs, size};
+            if (neg) {
+                mppp::sub(rop, rop, tmp);
+            } else {
+                mppp::add(rop, rop, tmp);
+            }
+        }
+        m_limbs[0] = m_limbs[1] = m_limbs[2] = 0u;
+    }
+    ::mp_limb_t m_limbs[3] = {0u, 0u, 0u};
+};
+
+template <typename It1, typename It2, std::size_t SSize>
+inline void integer_dot_impl(integer<SSize> &rop, It1 first1, It1 last1, It2 first2,
+                             const std::integral_constant<int, 1> &)
+{
+    // Accumulators for the positive and negative products.
+    integer_dot_acc acc[2];
+    for (; first1 != last1; ++first1, ++first2) {
+        const integer<SSize> &a = *first1, &b = *first2;
+        if (mppp_likely(a.is_static() && b.is_static())) {
+            const auto &sa = a._get_union().g_st(), &sb = b._get_union().g_st();
+            const auto size1 = sa._mp_size, size2 = sb._mp_size;
+            if (mppp_likely(size1 >= -1 && size1 <= 1 && size2 >= -1 && size2 <= 1)) {
+                // NOTE: for SSize > opt_size the limbs of a zero static integer
+                // are not guaranteed to be zero, thus we need to skip zero products explicitly.
+                if (!size1 || !size2) {
+                    continue;
+                }
+                const bool neg = (size1 ^ size2) < 0;
+                auto &cur = acc[neg];
+                if (mppp_unlikely(cur.m_limbs[2] == GMP_NUMB_MAX)) {
+                    // The accumulator might overflow, flush it.
+                    // NOTE: this requires a number of iterations too large to be tested.
+                    cur.flush(rop, neg); // LCOV_EXCL_LINE
+                }
+                ::mp_limb_t hi;
+                const auto lo = dlimb_mul(sa.m_limbs[0], sb.m_limbs[0], &hi);
+                cur.add(lo, hi);
+                continue;
+            }
+        }
+        // Operands larger than 1 limb go directly into rop.
+        mppp::addmul(rop, a, b);
+    }
+    acc[0].flush(rop, false);
+    acc[1].flush(rop, true);
+}
+
+} // namespace detail
+
+#if !defined(MPPP_DOXYGEN_INVOKED)
+
+template <typename It1, typename It2, std::size_t SSize>
+inline integer<SSize> dot(It1 first1, It1 last1, It2 first2, integer<SSize> init)
+{
+    detail::integer_dot_impl(init, first1, last1, first2, detail::integer_dot_algo{});
+    return init;
+}
+
+#endif
+
 namespace detail
 {
 
@@ -6119,8 +6654,13 @@ inline int static_cmp(const static_int<2> &n1, const static_int<2> &n2)
  * <tt>op1 > op2</tt>.
  */
 template <std::size_t SSize>
-inline int cmp(const integer<SSize> &op1, const integer<SSize> &op2)
+inline MPPP_CONSTEXPR_20 int cmp(const integer<SSize> &op1, const integer<SSize> &op2)
 {
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+    if (std::is_constant_evaluated()) {
+        return detail::constexpr_static_cmp(op1._get_union().g_st(), op2._get_union().g_st());
+    }
+#endif
     const bool s1 = op1.is_static(), s2 = op2.is_static();
     if (mppp_likely(s1 && s2)) {
         return static_cmp(op1._get_union().g_st(), op2._get_union().g_st());
@@ -6135,7 +6675,7 @@ inline int cmp(const integer<SSize> &op1, const integer<SSize> &op2)
  * @return 0 if \p n is zero, 1 if \p n is positive, -1 if \p n is negative.
  */
 template <std::size_t SSize>
-inline int sgn(const integer<SSize> &n)
+inline MPPP_CONSTEXPR_20 int sgn(const integer<SSize> &n)
 {
     return n.sgn();
 }
@@ -7889,6 +8429,35 @@ inline std::ostream &operator<<(std::ostream &os, const integer<SSize> &n)
     return detail::integer_stream_operator_impl(os, n.get_mpz_view(), n.sgn());
 }
 
+// Write the representation of n into [first, last).
+template <std::size_t SSize>
+inline to_chars_result to_chars(char *first, char *last, const integer<SSize> &n, int base = 10)
+{
+    if (mppp_unlikely(base < 2 || base > 62)) {
+        return {last, std::errc::invalid_argument};
+    }
+    return detail::mpz_to_chars(first, last, n.get_mpz_view(), base);
+}
+
+// Parse the integer at the beginning of [first, last) into n.
+template <std::size_t SSize>
+inline from_chars_result from_chars(const char *first, const char *last, integer<SSize> &n, int base = 10)
+{
+    ::mp_limb_t limbs[2];
+    detail::mpz_size_t size = 0;
+    const detail::mpz_struct_t *mpz = nullptr;
+    const auto ret = detail::mpz_from_chars(first, last, base, limbs, size, mpz);
+    if (ret.ec == std::errc{}) {
+        if (mpz) {
+            n = mpz;
+        } else {
+            const detail::mpz_struct_t view{2, size, limbs};
+            n = &view;
+        }
+    }
+    return ret;
+}
+
 /** @defgroup integer_s11n integer_s11n
  *  @{
  */
@@ -8003,6 +8572,49 @@ inline std::size_t binary_load(integer<SSize> &n, T &&src)
 
 /** @} */
 
+/// Statistics of the \link mppp::integer integer\endlink caches.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * Objects of this type are returned by :cpp:func:`~mppp::get_integer_cache_stats()`.
+ * \endrststar
+ */
+struct integer_cache_stats {
+    /// Number of allocations served by the cache.
+    unsigned long long hits;
+    /// Number of allocations which could not be served by the cache.
+    unsigned long long misses;
+    /// Number of deallocated arrays which could not be stored in the cache.
+    /**
+     * An array is not stored in the cache if it is too large or if its size class is full.
+     * The arrays freed explicitly (e.g., via mppp::trim_integer_caches()) are not counted.
+     */
+    unsigned long long evictions;
+    /// Number of bytes currently held by the cache.
+    std::size_t nbytes;
+};
+
+namespace detail
+{
+
+// Hash the value represented by the signed size size and the limbs starting at ptr.
+inline std::size_t integer_hash_impl(mpz_size_t size, const ::mp_limb_t *ptr)
+{
+    const std::size_t asize = size >= 0 ? static_cast<std::size_t>(size) : static_cast<std::size_t>(nint_abs(size));
+    // Init the retval as the signed size.
+    auto retval = static_cast<std::size_t>(size);
+    // Combine the limbs.
+    for (std::size_t i = 0; i < asize; ++i) {
+        // The hash combiner. This is lifted directly from Boost. See also:
+        // http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2014/n3876.pdf
+        retval ^= (ptr[i] & GMP_NUMB_MASK) + std::size_t(0x9e3779b9ul) + (retval << 6) + (retval >> 2);
+    }
+    return retval;
+}
+
+} // namespace detail
+
 /** @defgroup integer_other integer_other
  *  @{
  */
@@ -8024,20 +8636,9 @@ inline std::size_t binary_load(integer<SSize> &n, T &&src)
 template <std::size_t SSize>
 inline std::size_t hash(const integer<SSize> &n)
 {
-    const detail::mpz_size_t size = n._get_union().m_st._mp_size;
-    const std::size_t asize
-        = size >= 0 ? static_cast<std::size_t>(size) : static_cast<std::size_t>(detail::nint_abs(size));
-    const ::mp_limb_t *ptr
-        = n._get_union().is_static() ? n._get_union().g_st().m_limbs.data() : n._get_union().g_dy()._mp_d;
-    // Init the retval as the signed size.
-    auto retval = static_cast<std::size_t>(size);
-    // Combine the limbs.
-    for (std::size_t i = 0; i < asize; ++i) {
-        // The hash combiner. This is lifted directly from Boost. See also:
-        // http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2014/n3876.pdf
-        retval ^= (ptr[i] & GMP_NUMB_MASK) + std::size_t(0x9e3779b9ul) + (retval << 6) + (retval >> 2);
-    }
-    return retval;
+    return detail::integer_hash_impl(
+        n._get_union().m_st._mp_size,
+        n._get_union().is_static() ? n._get_union().g_st().m_limbs.data() : n._get_union().g_dy()._mp_d);
 }
 
 /// Free the \link mppp::integer integer\endlink caches.
@@ -8056,6 +8657,118 @@ inline std::size_t hash(const integer<SSize> &n)
  */
 MPPP_DLL_PUBLIC void free_integer_caches();
 
+/// Trim the \link mppp::integer integer\endlink caches.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * This function will free memory held by the :cpp:class:`~mppp::integer` cache
+ * of the calling thread (starting from the largest cached arrays) until the cache holds
+ * at most ``max_bytes`` bytes. ``trim_integer_caches(0)`` is equivalent to
+ * :cpp:func:`~mppp::free_integer_caches()`.
+ *
+ * On platforms where thread local storage is not supported, this funcion will be a no-op.
+ * \endrststar
+ *
+ * @param max_bytes the maximum number of bytes that will be retained in the cache.
+ */
+MPPP_DLL_PUBLIC void trim_integer_caches(std::size_t max_bytes);
+
+/// Set the limits of the \link mppp::integer integer\endlink caches.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * This function will set the limits of the :cpp:class:`~mppp::integer` cache of the calling thread:
+ * arrays of limbs with more than ``max_size`` limbs will not be cached, and at most ``max_entries``
+ * arrays will be cached for each size class. The cache has exact size classes for up to 16 limbs, and
+ * 4 size classes per power of two above that. Setting either value to zero disables the cache.
+ *
+ * If the new limits are lower than the old ones, the arrays in excess will be freed immediately.
+ *
+ * The limits are thread-local: they apply only to the calling thread, and newly-created threads
+ * start with the default limits (10 limbs and 100 entries). On platforms where thread local storage
+ * is not supported, this function will check its arguments and then do nothing.
+ * \endrststar
+ *
+ * @param max_size the maximum number of limbs of the cached arrays.
+ * @param max_entries the maximum number of arrays cached for each size class.
+ *
+ * @throws std::invalid_argument if \p max_size is larger than an implementation-defined limit
+ * (currently 8192 limbs).
+ */
+MPPP_DLL_PUBLIC void set_integer_cache_limits(std::size_t max_size, std::size_t max_entries);
+
+/// Get the limits of the \link mppp::integer integer\endlink caches.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * On platforms where thread local storage is not supported, this function will return
+ * a pair of zeroes.
+ * \endrststar
+ *
+ * @return a pair containing the maximum number of limbs of the cached arrays and the maximum
+ * number of cached arrays per size class for the calling thread, as set by
+ * mppp::set_integer_cache_limits().
+ */
+MPPP_DLL_PUBLIC std::pair<std::size_t, std::size_t> get_integer_cache_limits();
+
+/// Get the statistics of the \link mppp::integer integer\endlink caches.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * On platforms where thread local storage is not supported, all the statistics will be zero.
+ * \endrststar
+ *
+ * @return the statistics of the cache of the calling thread.
+ */
+MPPP_DLL_PUBLIC integer_cache_stats get_integer_cache_stats();
+
+/// Reset the statistics of the \link mppp::integer integer\endlink caches.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * This function will reset the counters of the cache of the calling thread.
+ * The cache content is not affected.
+ * \endrststar
+ */
+MPPP_DLL_PUBLIC void reset_integer_cache_stats();
+
+/// Set the number of threads used in the string conversions of \link mppp::integer integer\endlink.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * The conversions to and from string of very large :cpp:class:`~mppp::integer` values
+ * (tens of thousands of limbs) can be split across multiple threads. This function sets the
+ * maximum number of threads used by such conversions. A value of 1 (the default) means
+ * that the conversions are performed serially in the calling thread, while a value of zero
+ * means that the number of threads will be the value returned by ``std::thread::hardware_concurrency()``.
+ *
+ * The number of threads actually used is a power of two never greater than ``n``, than the
+ * value returned by ``std::thread::hardware_concurrency()`` (if nonzero) or than 64. If a thread
+ * cannot be created, the conversion continues serially in the calling thread.
+ *
+ * The setting is global, and it is safe to read and modify it concurrently from multiple threads.
+ * \endrststar
+ *
+ * @param n the maximum number of threads.
+ */
+MPPP_DLL_PUBLIC void set_integer_str_nthreads(unsigned n);
+
+/// Get the number of threads used in the string conversions of \link mppp::integer integer\endlink.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ * \endrststar
+ *
+ * @return the value set by mppp::set_integer_str_nthreads().
+ */
+MPPP_DLL_PUBLIC unsigned get_integer_str_nthreads();
+
 /** @} */
 
 /** @defgroup integer_operators integer_operators
@@ -8067,7 +8780,7 @@ namespace detail
 
 // Dispatching for the binary addition operator.
 template <std::size_t SSize>
-inline integer<SSize> dispatch_binary_add(const integer<SSize> &op1, const integer<SSize> &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> dispatch_binary_add(const integer<SSize> &op1, const integer<SSize> &op2)
 {
     integer<SSize> retval;
     add(retval, op1, op2);
@@ -8076,7 +8789,7 @@ inline integer<SSize> dispatch_binary_add(const integer<SSize> &op1, const integ
 
 // NOTE: use the add_si/add_ui functions when adding to C++ integrals.
 template <std::size_t SSize, typename T, enable_if_t<is_cpp_unsigned_integral_interoperable<T>::value, int> = 0>
-inline integer<SSize> dispatch_binary_add(const integer<SSize> &op1, T n)
+inline MPPP_CONSTEXPR_20 integer<SSize> dispatch_binary_add(const integer<SSize> &op1, T n)
 {
     integer<SSize> retval;
     add_ui(retval, op1, n);
@@ -8084,7 +8797,7 @@ inline integer<SSize> dispatch_binary_add(const integer<SSize> &op1, T n)
 }
 
 template <std::size_t SSize, typename T, enable_if_t<is_cpp_signed_integral_interoperable<T>::value, int> = 0>
-inline integer<SSize> dispatch_binary_add(const integer<SSize> &op1, T n)
+inline MPPP_CONSTEXPR_20 integer<SSize> dispatch_binary_add(const integer<SSize> &op1, T n)
 {
     integer<SSize> retval;
     add_si(retval, op1, n);
@@ -8092,7 +8805,7 @@ inline integer<SSize> dispatch_binary_add(const integer<SSize> &op1, T n)
 }
 
 template <std::size_t SSize, typename T, enable_if_t<is_cpp_integral_interoperable<T>::value, int> = 0>
-inline integer<SSize> dispatch_binary_add(T n, const integer<SSize> &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> dispatch_binary_add(T n, const integer<SSize> &op2)
 {
     return dispatch_binary_add(op2, n);
 }
@@ -8113,19 +8826,19 @@ inline T dispatch_binary_add(T x, const integer<SSize> &op2)
 
 // Dispatching for in-place add.
 template <std::size_t SSize>
-inline void dispatch_in_place_add(integer<SSize> &retval, const integer<SSize> &n)
+inline MPPP_CONSTEXPR_20 void dispatch_in_place_add(integer<SSize> &retval, const integer<SSize> &n)
 {
     add(retval, retval, n);
 }
 
 template <std::size_t SSize, typename T, enable_if_t<is_cpp_unsigned_integral_interoperable<T>::value, int> = 0>
-inline void dispatch_in_place_add(integer<SSize> &retval, const T &n)
+inline MPPP_CONSTEXPR_20 void dispatch_in_place_add(integer<SSize> &retval, const T &n)
 {
     add_ui(retval, retval, n);
 }
 
 template <std::size_t SSize, typename T, enable_if_t<is_cpp_signed_integral_interoperable<T>::value, int> = 0>
-inline void dispatch_in_place_add(integer<SSize> &retval, const T &n)
+inline MPPP_CONSTEXPR_20 void dispatch_in_place_add(integer<SSize> &retval, const T &n)
 {
     add_si(retval, retval, n);
 }
@@ -8153,7 +8866,7 @@ inline void dispatch_in_place_add(T &rop, const integer<SSize> &op)
  * @return a copy of \p n.
  */
 template <std::size_t SSize>
-inline integer<SSize> operator+(const integer<SSize> &n)
+inline MPPP_CONSTEXPR_20 integer<SSize> operator+(const integer<SSize> &n)
 {
     // NOTE: here potentially we could avoid a copy via either
     // a universal reference or maybe passing by copy n and then
@@ -8180,9 +8893,9 @@ inline integer<SSize> operator+(const integer<SSize> &n)
  */
 template <typename T, typename U>
 #if defined(MPPP_HAVE_CONCEPTS)
-requires IntegerOpTypes<T, U> inline auto
+requires IntegerOpTypes<T, U> inline MPPP_CONSTEXPR_20 auto
 #else
-inline detail::integer_common_t<T, U>
+inline MPPP_CONSTEXPR_20 detail::integer_common_t<T, U>
 #endif
 operator+(const T &op1, const U &op2)
 {
@@ -8205,7 +8918,7 @@ requires IntegerOpTypes<T, U>
 #else
 template <typename T, typename U, integer_op_types_enabler<T, U> = 0>
 #endif
-    inline T &operator+=(T &rop, const U &op)
+    inline MPPP_CONSTEXPR_20 T &operator+=(T &rop, const U &op)
 {
     detail::dispatch_in_place_add(rop, op);
     return rop;
@@ -8220,7 +8933,7 @@ template <typename T, typename U, integer_op_types_enabler<T, U> = 0>
  * @return a reference to \p n after the increment.
  */
 template <std::size_t SSize>
-inline integer<SSize> &operator++(integer<SSize> &n)
+inline MPPP_CONSTEXPR_20 integer<SSize> &operator++(integer<SSize> &n)
 {
     add_ui(n, n, 1u);
     return n;
@@ -8235,7 +8948,7 @@ inline integer<SSize> &operator++(integer<SSize> &n)
  * @return a copy of \p n before the increment.
  */
 template <std::size_t SSize>
-inline integer<SSize> operator++(integer<SSize> &n, int)
+inline MPPP_CONSTEXPR_20 integer<SSize> operator++(integer<SSize> &n, int)
 {
     auto retval(n);
     ++n;
@@ -8247,7 +8960,7 @@ namespace detail
 
 // Dispatching for the binary subtraction operator.
 template <std::size_t SSize>
-inline integer<SSize> dispatch_binary_sub(const integer<SSize> &op1, const integer<SSize> &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> dispatch_binary_sub(const integer<SSize> &op1, const integer<SSize> &op2)
 {
     integer<SSize> retval;
     sub(retval, op1, op2);
@@ -8255,7 +8968,7 @@ inline integer<SSize> dispatch_binary_sub(const integer<SSize> &op1, const integ
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_unsigned_integral_interoperable<T>::value, int> = 0>
-inline integer<SSize> dispatch_binary_sub(const integer<SSize> &op1, T n)
+inline MPPP_CONSTEXPR_20 integer<SSize> dispatch_binary_sub(const integer<SSize> &op1, T n)
 {
     integer<SSize> retval;
     sub_ui(retval, op1, n);
@@ -8263,7 +8976,7 @@ inline integer<SSize> dispatch_binary_sub(const integer<SSize> &op1, T n)
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_signed_integral_interoperable<T>::value, int> = 0>
-inline integer<SSize> dispatch_binary_sub(const integer<SSize> &op1, T n)
+inline MPPP_CONSTEXPR_20 integer<SSize> dispatch_binary_sub(const integer<SSize> &op1, T n)
 {
     integer<SSize> retval;
     sub_si(retval, op1, n);
@@ -8271,7 +8984,7 @@ inline integer<SSize> dispatch_binary_sub(const integer<SSize> &op1, T n)
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral_interoperable<T>::value, int> = 0>
-inline integer<SSize> dispatch_binary_sub(T n, const integer<SSize> &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> dispatch_binary_sub(T n, const integer<SSize> &op2)
 {
     auto retval = dispatch_binary_sub(op2, n);
     retval.neg();
@@ -8294,19 +9007,19 @@ inline T dispatch_binary_sub(T x, const integer<SSize> &op2)
 
 // Dispatching for in-place sub.
 template <std::size_t SSize>
-inline void dispatch_in_place_sub(integer<SSize> &retval, const integer<SSize> &n)
+inline MPPP_CONSTEXPR_20 void dispatch_in_place_sub(integer<SSize> &retval, const integer<SSize> &n)
 {
     sub(retval, retval, n);
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_unsigned_integral_interoperable<T>::value, int> = 0>
-inline void dispatch_in_place_sub(integer<SSize> &retval, const T &n)
+inline MPPP_CONSTEXPR_20 void dispatch_in_place_sub(integer<SSize> &retval, const T &n)
 {
     sub_ui(retval, retval, n);
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_signed_integral_interoperable<T>::value, int> = 0>
-inline void dispatch_in_place_sub(integer<SSize> &retval, const T &n)
+inline MPPP_CONSTEXPR_20 void dispatch_in_place_sub(integer<SSize> &retval, const T &n)
 {
     sub_si(retval, retval, n);
 }
@@ -8334,7 +9047,7 @@ inline void dispatch_in_place_sub(T &rop, const integer<SSize> &op)
  * @return a negated copy of \p n.
  */
 template <std::size_t SSize>
-integer<SSize> operator-(const integer<SSize> &n)
+MPPP_CONSTEXPR_20 integer<SSize> operator-(const integer<SSize> &n)
 {
     auto retval(n);
     retval.neg();
@@ -8359,9 +9072,9 @@ integer<SSize> operator-(const integer<SSize> &n)
  */
 template <typename T, typename U>
 #if defined(MPPP_HAVE_CONCEPTS)
-requires IntegerOpTypes<T, U> inline auto
+requires IntegerOpTypes<T, U> inline MPPP_CONSTEXPR_20 auto
 #else
-inline detail::integer_common_t<T, U>
+inline MPPP_CONSTEXPR_20 detail::integer_common_t<T, U>
 #endif
 operator-(const T &op1, const U &op2)
 {
@@ -8384,7 +9097,7 @@ requires IntegerOpTypes<T, U>
 #else
 template <typename T, typename U, integer_op_types_enabler<T, U> = 0>
 #endif
-    inline T &operator-=(T &rop, const U &op)
+    inline MPPP_CONSTEXPR_20 T &operator-=(T &rop, const U &op)
 {
     detail::dispatch_in_place_sub(rop, op);
     return rop;
@@ -8399,7 +9112,7 @@ template <typename T, typename U, integer_op_types_enabler<T, U> = 0>
  * @return a reference to \p n after the decrement.
  */
 template <std::size_t SSize>
-inline integer<SSize> &operator--(integer<SSize> &n)
+inline MPPP_CONSTEXPR_20 integer<SSize> &operator--(integer<SSize> &n)
 {
     sub_ui(n, n, 1u);
     return n;
@@ -8414,7 +9127,7 @@ inline integer<SSize> &operator--(integer<SSize> &n)
  * @return a copy of \p n before the decrement.
  */
 template <std::size_t SSize>
-inline integer<SSize> operator--(integer<SSize> &n, int)
+inline MPPP_CONSTEXPR_20 integer<SSize> operator--(integer<SSize> &n, int)
 {
     auto retval(n);
     --n;
@@ -8426,7 +9139,7 @@ namespace detail
 
 // Dispatching for the binary multiplication operator.
 template <std::size_t SSize>
-inline integer<SSize> dispatch_binary_mul(const integer<SSize> &op1, const integer<SSize> &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> dispatch_binary_mul(const integer<SSize> &op1, const integer<SSize> &op2)
 {
     integer<SSize> retval;
     mul(retval, op1, op2);
@@ -8434,7 +9147,7 @@ inline integer<SSize> dispatch_binary_mul(const integer<SSize> &op1, const integ
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral_interoperable<T>::value, int> = 0>
-inline integer<SSize> dispatch_binary_mul(const integer<SSize> &op1, T n)
+inline MPPP_CONSTEXPR_20 integer<SSize> dispatch_binary_mul(const integer<SSize> &op1, T n)
 {
     // NOTE: with respect to addition, here we separate the retval
     // from the operands. Having a separate destination is generally better
@@ -8445,7 +9158,7 @@ inline integer<SSize> dispatch_binary_mul(const integer<SSize> &op1, T n)
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral_interoperable<T>::value, int> = 0>
-inline integer<SSize> dispatch_binary_mul(T n, const integer<SSize> &op2)
+inline MPPP_CONSTEXPR_20 integer<SSize> dispatch_binary_mul(T n, const integer<SSize> &op2)
 {
     return dispatch_binary_mul(op2, n);
 }
@@ -8466,13 +9179,13 @@ inline T dispatch_binary_mul(T x, const integer<SSize> &op2)
 
 // Dispatching for in-place multiplication.
 template <std::size_t SSize>
-inline void dispatch_in_place_mul(integer<SSize> &retval, const integer<SSize> &n)
+inline MPPP_CONSTEXPR_20 void dispatch_in_place_mul(integer<SSize> &retval, const integer<SSize> &n)
 {
     mul(retval, retval, n);
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral_interoperable<T>::value, int> = 0>
-inline void dispatch_in_place_mul(integer<SSize> &retval, const T &n)
+inline MPPP_CONSTEXPR_20 void dispatch_in_place_mul(integer<SSize> &retval, const T &n)
 {
     mul(retval, retval, integer<SSize>{n});
 }
@@ -8511,9 +9224,9 @@ inline void dispatch_in_place_mul(T &rop, const integer<SSize> &op)
  */
 template <typename T, typename U>
 #if defined(MPPP_HAVE_CONCEPTS)
-requires IntegerOpTypes<T, U> inline auto
+requires IntegerOpTypes<T, U> inline MPPP_CONSTEXPR_20 auto
 #else
-inline detail::integer_common_t<T, U>
+inline MPPP_CONSTEXPR_20 detail::integer_common_t<T, U>
 #endif
 operator*(const T &op1, const U &op2)
 {
@@ -8536,7 +9249,7 @@ requires IntegerOpTypes<T, U>
 #else
 template <typename T, typename U, integer_op_types_enabler<T, U> = 0>
 #endif
-    inline T &operator*=(T &rop, const U &op)
+    inline MPPP_CONSTEXPR_20 T &operator*=(T &rop, const U &op)
 {
     detail::dispatch_in_place_mul(rop, op);
     return rop;
@@ -8844,8 +9557,13 @@ namespace detail
 // Equality operator.
 // NOTE: special implementation instead of using cmp, this should be faster.
 template <std::size_t SSize>
-inline bool dispatch_equality(const integer<SSize> &a, const integer<SSize> &b)
+inline MPPP_CONSTEXPR_20 bool dispatch_equality(const integer<SSize> &a, const integer<SSize> &b)
 {
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+    if (std::is_constant_evaluated()) {
+        return constexpr_static_cmp(a._get_union().g_st(), b._get_union().g_st()) == 0;
+    }
+#endif
     const mp_size_t size_a = a._get_union().m_st._mp_size, size_b = b._get_union().m_st._mp_size;
     if (size_a != size_b) {
         return false;
@@ -8862,13 +9580,13 @@ inline bool dispatch_equality(const integer<SSize> &a, const integer<SSize> &b)
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral_interoperable<T>::value, int> = 0>
-inline bool dispatch_equality(const integer<SSize> &a, T n)
+inline MPPP_CONSTEXPR_20 bool dispatch_equality(const integer<SSize> &a, T n)
 {
     return dispatch_equality(a, integer<SSize>{n});
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral_interoperable<T>::value, int> = 0>
-inline bool dispatch_equality(T n, const integer<SSize> &a)
+inline MPPP_CONSTEXPR_20 bool dispatch_equality(T n, const integer<SSize> &a)
 {
     return dispatch_equality(a, n);
 }
@@ -8947,8 +9665,13 @@ inline bool static_less_than(const static_int<SSize> &n1, const static_int<SSize
 }
 
 template <std::size_t SSize>
-inline bool dispatch_less_than(const integer<SSize> &op1, const integer<SSize> &op2)
+inline MPPP_CONSTEXPR_20 bool dispatch_less_than(const integer<SSize> &op1, const integer<SSize> &op2)
 {
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+    if (std::is_constant_evaluated()) {
+        return constexpr_static_cmp(op1._get_union().g_st(), op2._get_union().g_st()) < 0;
+    }
+#endif
     const bool s1 = op1.is_static(), s2 = op2.is_static();
     if (mppp_likely(s1 && s2)) {
         return static_less_than(op1._get_union().g_st(), op2._get_union().g_st());
@@ -8958,13 +9681,13 @@ inline bool dispatch_less_than(const integer<SSize> &op1, const integer<SSize> &
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral_interoperable<T>::value, int> = 0>
-inline bool dispatch_less_than(const integer<SSize> &a, T n)
+inline MPPP_CONSTEXPR_20 bool dispatch_less_than(const integer<SSize> &a, T n)
 {
     return dispatch_less_than(a, integer<SSize>{n});
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral_interoperable<T>::value, int> = 0>
-bool dispatch_less_than(T, const integer<SSize> &);
+MPPP_CONSTEXPR_20 bool dispatch_less_than(T, const integer<SSize> &);
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_floating_point_interoperable<T>::value, int> = 0>
 inline bool dispatch_less_than(const integer<SSize> &a, T x)
@@ -9018,8 +9741,13 @@ inline bool static_greater_than(const static_int<SSize> &n1, const static_int<SS
 }
 
 template <std::size_t SSize>
-inline bool dispatch_greater_than(const integer<SSize> &op1, const integer<SSize> &op2)
+inline MPPP_CONSTEXPR_20 bool dispatch_greater_than(const integer<SSize> &op1, const integer<SSize> &op2)
 {
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+    if (std::is_constant_evaluated()) {
+        return constexpr_static_cmp(op1._get_union().g_st(), op2._get_union().g_st()) > 0;
+    }
+#endif
     const bool s1 = op1.is_static(), s2 = op2.is_static();
     if (mppp_likely(s1 && s2)) {
         return static_greater_than(op1._get_union().g_st(), op2._get_union().g_st());
@@ -9029,13 +9757,13 @@ inline bool dispatch_greater_than(const integer<SSize> &op1, const integer<SSize
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral_interoperable<T>::value, int> = 0>
-inline bool dispatch_greater_than(const integer<SSize> &a, T n)
+inline MPPP_CONSTEXPR_20 bool dispatch_greater_than(const integer<SSize> &a, T n)
 {
     return dispatch_greater_than(a, integer<SSize>{n});
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral_interoperable<T>::value, int> = 0>
-inline bool dispatch_greater_than(T n, const integer<SSize> &a)
+inline MPPP_CONSTEXPR_20 bool dispatch_greater_than(T n, const integer<SSize> &a)
 {
     return dispatch_less_than(a, integer<SSize>{n});
 }
@@ -9054,7 +9782,7 @@ inline bool dispatch_greater_than(T x, const integer<SSize> &a)
 
 // NOTE: implement these here as we need visibility of dispatch_greater_than().
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral_interoperable<T>::value, int>>
-inline bool dispatch_less_than(T n, const integer<SSize> &a)
+inline MPPP_CONSTEXPR_20 bool dispatch_less_than(T n, const integer<SSize> &a)
 {
     return dispatch_greater_than(a, integer<SSize>{n});
 }
@@ -9079,7 +9807,7 @@ requires IntegerOpTypes<T, U>
 #else
 template <typename T, typename U, integer_op_types_enabler<T, U> = 0>
 #endif
-    inline bool operator==(const T &op1, const U &op2)
+    inline MPPP_CONSTEXPR_20 bool operator==(const T &op1, const U &op2)
 {
     return detail::dispatch_equality(op1, op2);
 }
@@ -9097,7 +9825,7 @@ requires IntegerOpTypes<T, U>
 #else
 template <typename T, typename U, integer_op_types_enabler<T, U> = 0>
 #endif
-    inline bool operator!=(const T &op1, const U &op2)
+    inline MPPP_CONSTEXPR_20 bool operator!=(const T &op1, const U &op2)
 {
     return !(op1 == op2);
 }
@@ -9115,7 +9843,7 @@ requires IntegerRealOpTypes<T, U>
 #else
 template <typename T, typename U, integer_real_op_types_enabler<T, U> = 0>
 #endif
-    inline bool operator<(const T &op1, const U &op2)
+    inline MPPP_CONSTEXPR_20 bool operator<(const T &op1, const U &op2)
 {
     return detail::dispatch_less_than(op1, op2);
 }
@@ -9133,7 +9861,7 @@ requires IntegerRealOpTypes<T, U>
 #else
 template <typename T, typename U, integer_real_op_types_enabler<T, U> = 0>
 #endif
-    inline bool operator<=(const T &op1, const U &op2)
+    inline MPPP_CONSTEXPR_20 bool operator<=(const T &op1, const U &op2)
 {
     return !(op1 > op2);
 }
@@ -9151,7 +9879,7 @@ requires IntegerRealOpTypes<T, U>
 #else
 template <typename T, typename U, integer_real_op_types_enabler<T, U> = 0>
 #endif
-    inline bool operator>(const T &op1, const U &op2)
+    inline MPPP_CONSTEXPR_20 bool operator>(const T &op1, const U &op2)
 {
     return detail::dispatch_greater_than(op1, op2);
 }
@@ -9169,7 +9897,7 @@ requires IntegerRealOpTypes<T, U>
 #else
 template <typename T, typename U, integer_real_op_types_enabler<T, U> = 0>
 #endif
-    inline bool operator>=(const T &op1, const U &op2)
+    inline MPPP_CONSTEXPR_20 bool operator>=(const T &op1, const U &op2)
 {
     return !(op1 < op2);
 }
@@ -0,0 +1,703 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_INTEGER_CVIEW_HPP
+#define MPPP_INTEGER_CVIEW_HPP
+
+#include <mp++/config.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <mp++/concepts.hpp>
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/type_name.hpp>
+
+namespace mppp
+{
+
+class integer_cview;
+
+namespace detail
+{
+
+// The static size of the integers used as temporaries in integer_cview.
+// It is large enough to represent any value of any C++ integral type.
+constexpr std::size_t integer_cview_tmp_ssize = 128u / unsigned(GMP_NUMB_BITS) + 1u;
+
+// Read-only limb representing the value zero, used in the mpz struct
+// of integer_cview, so that the limb pointer is never null.
+inline const ::mp_limb_t *integer_cview_zero_limb()
+{
+    static const ::mp_limb_t zero = 0;
+    return &zero;
+}
+
+// Number of padding bytes to be placed at the address (or at the offset
+// within a limb-aligned buffer) addr before a serialised integer, so that
+// its limbs are aligned.
+constexpr std::size_t integer_cview_padding(std::uintptr_t addr)
+{
+    return (alignof(::mp_limb_t) - (addr + sizeof(mpz_size_t)) % alignof(::mp_limb_t)) % alignof(::mp_limb_t);
+}
+
+// Detect the types which can be compared with integer_cview.
+template <typename T>
+struct is_integer_cview_operand : is_cpp_integral_interoperable<T> {
+};
+
+template <>
+struct is_integer_cview_operand<integer_cview> : std::true_type {
+};
+
+template <std::size_t SSize>
+struct is_integer_cview_operand<integer<SSize>> : std::true_type {
+};
+
+template <typename T, typename U>
+using are_integer_cview_op_types
+    = conjunction<is_integer_cview_operand<T>, is_integer_cview_operand<U>,
+                  disjunction<std::is_same<T, integer_cview>, std::is_same<U, integer_cview>>>;
+
+} // namespace detail
+
+template <typename T, typename U>
+using integer_cview_op_types_enabler = detail::enable_if_t<detail::are_integer_cview_op_types<T, U>::value, int>;
+
+/// Read-only integer view.
+/**
+ * \rststar
+ * *#include <mp++/integer_cview.hpp>*
+ *
+ * .. versionadded:: 0.20
+ *
+ * This class represents a read-only view on an arbitrary-precision integer whose limbs
+ * are stored in memory not owned by the view. The view consists only of a GMP ``mpz_t`` struct
+ * pointing to the borrowed limbs, and it does not depend on the static size of
+ * :cpp:class:`~mppp::integer`.
+ *
+ * The typical use case is the zero-copy access to the serialised representations
+ * of integers produced by :cpp:func:`mppp::integer::binary_save()` and stored in large memory
+ * buffers (e.g., memory-mapped files): the :cpp:func:`~mppp::integer_cview::binary_load()`
+ * member functions will point the view directly to the limbs stored in the buffer, without any copy
+ * or allocation. The value of the view can then be passed to the read-only GMP API via
+ * :cpp:func:`~mppp::integer_cview::get_mpz_view()`, compared with other views, integers and C++ integral
+ * values, hashed (consistently with :cpp:func:`mppp::hash()`), printed and converted.
+ *
+ * The memory referenced by a view must outlive the view and must not be modified
+ * while the view is in use.
+ * \endrststar
+ */
+class integer_cview
+{
+    // Shortcut for the type of the integers used as temporaries.
+    using tmp_t = integer<detail::integer_cview_tmp_ssize>;
+
+public:
+    /// Default constructor.
+    /**
+     * The default constructor will initialise a view representing the value zero.
+     */
+    integer_cview() : m_mpz{0, 0, const_cast<::mp_limb_t *>(detail::integer_cview_zero_limb())} {}
+    /// Constructor from an array of limbs.
+    /**
+     * \rststar
+     * This constructor will initialise a view on the array of limbs starting at ``p``,
+     * whose absolute size is ``|size|``. The value of the view will have the same sign
+     * as ``size``. As in :cpp:class:`~mppp::integer`, the limbs are ordered from the least significant
+     * to the most significant, and they are required not to be greater than the
+     * ``GMP_NUMB_MAX`` GMP constant (this requirement is not checked).
+     *
+     * If ``size`` is zero, the view will represent the value zero and ``p`` will never be dereferenced.
+     * \endrststar
+     *
+     * @param p a pointer to the beginning of the limbs array.
+     * @param size the signed size of the limbs array.
+     *
+     * @throws std::invalid_argument if ``size`` is nonzero and the most significant limb of the array is zero.
+     */
+    integer_cview(const ::mp_limb_t *p, detail::mpz_size_t size) : integer_cview()
+    {
+        if (size) {
+            set(p, size);
+        }
+    }
+    /// Constructor from an integer.
+    /**
+     * \rststar
+     * This constructor will initialise a view on the limbs of ``n``. The view will become
+     * invalid if ``n`` is destroyed or modified.
+     * \endrststar
+     *
+     * @param n the integer on which the view will be constructed.
+     */
+    template <std::size_t SSize>
+    explicit integer_cview(const integer<SSize> &n)
+        : m_mpz(n.is_static() ? n._get_union().g_st().get_mpz_view() : n._get_union().g_dy())
+    {
+    }
+
+private:
+    // Error message in case of invalid data.
+    static const char *data_errmsg()
+    {
+        return "Invalid data detected in the construction of an integer_cview: the most "
+               "significant limb of the value cannot be zero";
+    }
+    void set(const ::mp_limb_t *p, detail::mpz_size_t size)
+    {
+        assert(size);
+        const auto asize = static_cast<std::size_t>(size >= 0 ? detail::make_unsigned(size) : detail::nint_abs(size));
+        if (mppp_unlikely(!(p[asize - 1u] & GMP_NUMB_MASK))) {
+            throw std::invalid_argument(data_errmsg());
+        }
+        // NOTE: the alloc member is unused by the read-only GMP API.
+        m_mpz._mp_alloc = size >= 0 ? size : -size;
+        m_mpz._mp_size = size;
+        m_mpz._mp_d = const_cast<::mp_limb_t *>(p);
+    }
+
+public:
+    /// Point the view to a serialised integer.
+    /**
+     * \rststar
+     * This member function will point ``this`` to the limbs of the serialised representation of an
+     * :cpp:class:`~mppp::integer` produced by one of the :cpp:func:`~mppp::integer::binary_save()`
+     * overloads and stored at the beginning of the memory buffer starting at ``src``. No data
+     * is copied, and the view will become invalid if the buffer is destroyed or modified.
+     *
+     * Unlike :cpp:func:`mppp::integer::binary_load()`, this member function requires the limbs
+     * in the serialised representation (which start ``sizeof(mpz_size_t)`` bytes after the beginning
+     * of the representation) to be suitably aligned for the ``mp_limb_t`` type. If that is
+     * not the case, an error will be raised. Buffers of serialised integers meeting this
+     * requirement can be produced via :cpp:func:`~mppp::integer_cview::binary_save_aligned()`.
+     *
+     * .. warning::
+     *
+     *    Although this member function performs a few consistency checks on the data in ``src``,
+     *    it cannot ensure complete safety against maliciously crafted data. Users are
+     *    advised to use this member function only with trusted data.
+     * \endrststar
+     *
+     * @param src the source memory buffer.
+     *
+     * @return the number of bytes occupied by the serialised representation in ``src``.
+     *
+     * @throws std::invalid_argument if the limbs in ``src`` are not suitably aligned, or if invalid data
+     * is detected in ``src``.
+     */
+    std::size_t binary_load(const char *src)
+    {
+        detail::mpz_size_t size;
+        std::copy(src, src + sizeof(detail::mpz_size_t), detail::make_uai(reinterpret_cast<char *>(&size)));
+        const auto asize = static_cast<std::size_t>(size >= 0 ? detail::make_unsigned(size) : detail::nint_abs(size));
+        const auto lptr = src + sizeof(detail::mpz_size_t);
+        if (mppp_unlikely(reinterpret_cast<std::uintptr_t>(lptr) % alignof(::mp_limb_t))) {
+            throw std::invalid_argument("Cannot construct an integer_cview from a serialised integer whose limbs are "
+                                        "not aligned to a multiple of "
+                                        + detail::to_string(alignof(::mp_limb_t)) + " bytes");
+        }
+        if (size) {
+            // NOTE: the alignment was checked above, go through void *
+            // in order to avoid spurious alignment warnings.
+            set(static_cast<const ::mp_limb_t *>(static_cast<const void *>(lptr)), size);
+        } else {
+            *this = integer_cview{};
+        }
+        return static_cast<std::size_t>(sizeof(detail::mpz_size_t) + asize * sizeof(::mp_limb_t));
+    }
+    /// Point the view to a serialised integer in a bounded memory buffer.
+    /**
+     * \rststar
+     * This member function is equivalent to the other :cpp:func:`~mppp::integer_cview::binary_load()` overload,
+     * but it additionally checks that the serialised representation fits within the memory buffer
+     * of size ``size`` starting at ``src``.
+     * \endrststar
+     *
+     * @param src the source memory buffer.
+     * @param size the size of the source memory buffer.
+     *
+     * @return the number of bytes occupied by the serialised representation in ``src``.
+     *
+     * @throws std::invalid_argument if the serialised representation does not fit in the buffer.
+     * @throws unspecified any exception thrown by the other binary_load() overload.
+     */
+    std::size_t binary_load(const char *src, std::size_t size)
+    {
+        if (mppp_unlikely(size < sizeof(detail::mpz_size_t))) {
+            throw std::invalid_argument("Invalid buffer size in the construction of an integer_cview: the buffer "
+                                        "size must be at least "
+                                        + detail::to_string(sizeof(detail::mpz_size_t)) + " bytes, but it is only "
+                                        + detail::to_string(size) + " bytes");
+        }
+        detail::mpz_size_t s;
+        std::copy(src, src + sizeof(detail::mpz_size_t), detail::make_uai(reinterpret_cast<char *>(&s)));
+        const auto asize = s >= 0 ? detail::make_unsigned(s) : detail::nint_abs(s);
+        if (mppp_unlikely((size - sizeof(detail::mpz_size_t)) / sizeof(::mp_limb_t) < asize)) {
+            throw std::invalid_argument("Invalid buffer size in the construction of an integer_cview: the number "
+                                        "of limbs stored in the buffer ("
+                                        + detail::to_string((size - sizeof(detail::mpz_size_t)) / sizeof(::mp_limb_t))
+                                        + ") is less than the integer size in limbs stored in the header ("
+                                        + detail::to_string(asize) + ")");
+        }
+        return binary_load(src);
+    }
+    /// Aligned serialised size.
+    /**
+     * \rststar
+     * This static member function will return the number of bytes that
+     * :cpp:func:`~mppp::integer_cview::binary_save_aligned()` writes when serialising ``n``
+     * at the offset ``offset`` of a memory buffer whose beginning is aligned for the ``mp_limb_t`` type
+     * (e.g., the storage of a ``std::vector<mp_limb_t>`` or a memory-mapped file). The returned value
+     * is at most ``alignof(mp_limb_t) - 1`` bytes larger than :cpp:func:`mppp::integer::binary_size()`.
+     * \endrststar
+     *
+     * @param offset the offset in the buffer at which ``n`` will be serialised.
+     * @param n the integer to be serialised.
+     *
+     * @return the number of bytes needed to serialise ``n`` at the offset ``offset``.
+     *
+     * @throws unspecified any exception thrown by mppp::integer::binary_size().
+     */
+    template <std::size_t SSize>
+    static std::size_t binary_size_aligned(std::size_t offset, const integer<SSize> &n)
+    {
+        return detail::integer_cview_padding(offset) + n.binary_size();
+    }
+    /// Serialise an integer for use with integer_cview.
+    /**
+     * \rststar
+     * This static member function will write into ``dest`` a number of zero padding bytes
+     * followed by the serialised representation of ``n`` produced by :cpp:func:`mppp::integer::binary_save()`.
+     * The amount of padding is the minimum needed for the limbs of the serialised representation to be suitably
+     * aligned for the ``mp_limb_t`` type, so that the representation can be read back without copies by
+     * :cpp:func:`~mppp::integer_cview::binary_load_aligned()`. Integers saved back-to-back
+     * with this function can thus be viewed directly in the destination buffer.
+     *
+     * ``dest`` must point to a memory area whose size is at least
+     * ``n.binary_size() + alignof(mp_limb_t) - 1`` bytes (or the exact size computed via
+     * :cpp:func:`~mppp::integer_cview::binary_size_aligned()`), otherwise the behaviour will be undefined.
+     * \endrststar
+     *
+     * @param dest a pointer to a memory area.
+     * @param n the integer to be serialised.
+     *
+     * @return the number of bytes written into ``dest``, including the padding.
+     *
+     * @throws unspecified any exception thrown by mppp::integer::binary_save().
+     */
+    template <std::size_t SSize>
+    static std::size_t binary_save_aligned(char *dest, const integer<SSize> &n)
+    {
+        const auto pad = detail::integer_cview_padding(reinterpret_cast<std::uintptr_t>(dest));
+        std::fill(dest, dest + pad, char(0));
+        return pad + n.binary_save(dest + pad);
+    }
+    /// Point the view to an aligned serialised integer.
+    /**
+     * \rststar
+     * This member function will point ``this`` to the serialised integer written into ``src``
+     * by :cpp:func:`~mppp::integer_cview::binary_save_aligned()`, skipping the padding bytes.
+     * \endrststar
+     *
+     * @param src the source memory buffer.
+     *
+     * @return the number of bytes occupied by the serialised representation in ``src``, including the padding.
+     *
+     * @throws unspecified any exception thrown by binary_load().
+     */
+    std::size_t binary_load_aligned(const char *src)
+    {
+        const auto pad = detail::integer_cview_padding(reinterpret_cast<std::uintptr_t>(src));
+        return pad + binary_load(src + pad);
+    }
+    /// Point the view to an aligned serialised integer in a bounded memory buffer.
+    /**
+     * \rststar
+     * This member function is equivalent to the other
+     * :cpp:func:`~mppp::integer_cview::binary_load_aligned()` overload,
+     * but it additionally checks that the padding and the serialised representation fit within
+     * the memory buffer of size ``size`` starting at ``src``.
+     * \endrststar
+     *
+     * @param src the source memory buffer.
+     * @param size the size of the source memory buffer.
+     *
+     * @return the number of bytes occupied by the serialised representation in ``src``, including the padding.
+     *
+     * @throws std::invalid_argument if the padding does not fit in the buffer.
+     * @throws unspecified any exception thrown by binary_load().
+     */
+    std::size_t binary_load_aligned(const char *src, std::size_t size)
+    {
+        const auto pad = detail::integer_cview_padding(reinterpret_cast<std::uintptr_t>(src));
+        if (mppp_unlikely(size < pad)) {
+            throw std::invalid_argument("Invalid buffer size in the construction of an integer_cview: the buffer "
+                                        "size ("
+                                        + detail::to_string(size) + ") is less than the alignment padding ("
+                                        + detail::to_string(pad) + ")");
+        }
+        return pad + binary_load(src + pad, size - pad);
+    }
+    /// Get a const reference to an ``mpz_struct_t``.
+    /**
+     * \rststar
+     * The returned pointer can be passed as a read-only argument to the GMP API. Unlike
+     * :cpp:func:`mppp::integer::get_mpz_view()`, the returned pointer is valid for as long
+     * as ``this`` (and the memory it refers to) is valid.
+     * \endrststar
+     *
+     * @return a pointer to the ``mpz_struct_t`` of ``this``.
+     */
+    const detail::mpz_struct_t *get_mpz_view() const
+    {
+        return &m_mpz;
+    }
+    /// Pointer to the limbs.
+    /**
+     * @return a pointer to the limbs referenced by \p this.
+     */
+    const ::mp_limb_t *data() const
+    {
+        return m_mpz._mp_d;
+    }
+    /// Size in limbs.
+    /**
+     * @return the number of limbs needed to represent \p this. If \p this is zero, zero will be returned.
+     */
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(m_mpz._mp_size >= 0 ? detail::make_unsigned(m_mpz._mp_size)
+                                                             : detail::nint_abs(m_mpz._mp_size));
+    }
+    /// Sign.
+    /**
+     * @return 0 if \p this is zero, 1 if \p this is positive, -1 if \p this is negative.
+     */
+    int sgn() const
+    {
+        return detail::integral_sign(m_mpz._mp_size);
+    }
+    /// Test if the value is zero.
+    /**
+     * @return \p true if the value represented by \p this is 0, \p false otherwise.
+     */
+    bool is_zero() const
+    {
+        return m_mpz._mp_size == 0;
+    }
+    /// Size in bits.
+    /**
+     * @return the number of bits needed to represent \p this. If \p this is zero, zero will be returned.
+     *
+     * @throws std::overflow_error if the size in bits of \p this is larger than an implementation-defined value.
+     */
+    std::size_t nbits() const
+    {
+        const auto ls = size();
+        if (!ls) {
+            return 0;
+        }
+        // LCOV_EXCL_START
+        if (mppp_unlikely(ls > detail::nl_max<std::size_t>() / unsigned(GMP_NUMB_BITS))) {
+            throw std::overflow_error("Overflow in the computation of the number of bits required to represent an "
+                                      "integer_cview - the limb size is "
+                                      + detail::to_string(ls));
+        }
+        // LCOV_EXCL_STOP
+        return static_cast<std::size_t>((ls - 1u) * unsigned(GMP_NUMB_BITS)
+                                        + detail::limb_size_nbits(m_mpz._mp_d[ls - 1u]));
+    }
+    /// Conversion to string.
+    /**
+     * @param base the desired base.
+     *
+     * @return a string representation of \p this.
+     *
+     * @throws std::invalid_argument if \p base is smaller than 2 or greater than 62.
+     */
+    std::string to_string(int base = 10) const
+    {
+        if (mppp_unlikely(base < 2 || base > 62)) {
+            throw std::invalid_argument("Invalid base for string conversion: the base must be between "
+                                        "2 and 62, but a value of "
+                                        + detail::to_string(base) + " was provided instead");
+        }
+        return detail::mpz_to_str(&m_mpz, base);
+    }
+    /// Conversion to integer.
+    /**
+     * @return a copy of the value represented by \p this.
+     *
+     * @throws unspecified any exception thrown by the constructor of \link mppp::integer integer\endlink
+     * from ``mpz_t``.
+     */
+    template <std::size_t SSize>
+    explicit operator integer<SSize>() const
+    {
+        return integer<SSize>{&m_mpz};
+    }
+
+private:
+    // Conversion of values too large to be represented by any C++ integral type.
+    template <typename T, detail::enable_if_t<std::is_same<bool, T>::value, int> = 0>
+    T large_conversion() const
+    {
+        return true;
+    }
+    template <typename T, detail::enable_if_t<detail::conjunction<detail::is_integral<T>,
+                                                                  detail::negation<std::is_same<bool, T>>>::value,
+                                              int> = 0>
+    T large_conversion() const
+    {
+        throw std::overflow_error("The conversion of the integer " + to_string() + " to the type '" + type_name<T>()
+                                  + "' results in overflow");
+    }
+    template <typename T,
+              detail::enable_if_t<detail::disjunction<std::is_same<T, float>, std::is_same<T, double>>::value, int> = 0>
+    T large_conversion() const
+    {
+        return static_cast<T>(::mpz_get_d(&m_mpz));
+    }
+    template <typename T, detail::enable_if_t<std::is_same<T, long double>::value, int> = 0>
+    T large_conversion() const
+    {
+        return static_cast<T>(integer<1>{&m_mpz});
+    }
+
+public:
+    /// Generic conversion operator to a C++ fundamental type.
+    /**
+     * \rststar
+     * This operator will convert ``this`` to a :cpp:concept:`~mppp::CppInteroperable` type,
+     * following the same rules as the conversion operator of :cpp:class:`~mppp::integer`.
+     * \endrststar
+     *
+     * @return \p this converted to the target type.
+     *
+     * @throws std::overflow_error if the target type is an integral type and the value of ``this`` cannot be
+     * represented by it.
+     */
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <CppInteroperable T>
+#else
+    template <typename T, cpp_interoperable_enabler<T> = 0>
+#endif
+    explicit operator T() const
+    {
+        const auto s = size();
+        if (s <= detail::integer_cview_tmp_ssize) {
+            // NOTE: small values are copied into a static integer,
+            // so that no allocation takes place.
+            tmp_t tmp{m_mpz._mp_d, s};
+            if (m_mpz._mp_size < 0) {
+                tmp.neg();
+            }
+            return static_cast<T>(tmp);
+        }
+        return large_conversion<T>();
+    }
+
+private:
+    detail::mpz_struct_t m_mpz;
+};
+
+namespace detail
+{
+
+// Three-way comparison between the operands of the comparison operators.
+inline int integer_cview_cmp(const integer_cview &a, const integer_cview &b)
+{
+    return ::mpz_cmp(a.get_mpz_view(), b.get_mpz_view());
+}
+
+template <std::size_t SSize>
+inline int integer_cview_cmp(const integer_cview &a, const integer<SSize> &b)
+{
+    return integer_cview_cmp(a, integer_cview{b});
+}
+
+template <std::size_t SSize>
+inline int integer_cview_cmp(const integer<SSize> &a, const integer_cview &b)
+{
+    return integer_cview_cmp(integer_cview{a}, b);
+}
+
+// NOTE: integral values are converted to static integers,
+// which never require memory allocations.
+template <typename T, enable_if_t<is_cpp_integral_interoperable<T>::value, int> = 0>
+inline int integer_cview_cmp(const integer_cview &a, const T &b)
+{
+    const integer<integer_cview_tmp_ssize> tmp{b};
+    return integer_cview_cmp(a, integer_cview{tmp});
+}
+
+template <typename T, enable_if_t<is_cpp_integral_interoperable<T>::value, int> = 0>
+inline int integer_cview_cmp(const T &a, const integer_cview &b)
+{
+    const integer<integer_cview_tmp_ssize> tmp{a};
+    return integer_cview_cmp(integer_cview{tmp}, b);
+}
+
+} // namespace detail
+
+/** @defgroup integer_cview_functions integer_cview_functions
+ *  @{
+ */
+
+/// Hash value.
+/**
+ * \rststar
+ * The hash value of an :cpp:class:`~mppp::integer_cview` is equal to the hash value
+ * of an :cpp:class:`~mppp::integer` with the same value, as computed by :cpp:func:`mppp::hash()`.
+ * \endrststar
+ *
+ * @param v the view whose hash value will be computed.
+ *
+ * @return a hash value for \p v.
+ */
+inline std::size_t hash(const integer_cview &v)
+{
+    return detail::integer_hash_impl(v.get_mpz_view()->_mp_size, v.data());
+}
+
+/// Output stream operator.
+/**
+ * \rststar
+ * This operator will print ``v`` to the stream ``os``, following the same conventions
+ * as the stream operator of :cpp:class:`~mppp::integer`.
+ * \endrststar
+ *
+ * @param os the target stream.
+ * @param v the view that will be printed.
+ *
+ * @return a reference to \p os.
+ *
+ * @throws unspecified any exception thrown by the stream operator of \link mppp::integer integer\endlink.
+ */
+inline std::ostream &operator<<(std::ostream &os, const integer_cview &v)
+{
+    return detail::integer_stream_operator_impl(os, v.get_mpz_view(), v.sgn());
+}
+
+/// Equality operator involving \link mppp::integer_cview integer_cview\endlink.
+/**
+ * \rststar
+ * The operands can be views, :cpp:class:`~mppp::integer` objects or :cpp:concept:`C++ integral types
+ * <mppp::CppIntegralInteroperable>`, and at least one operand must be a view.
+ * \endrststar
+ *
+ * @param a the first operand.
+ * @param b the second operand.
+ *
+ * @return \p true if <tt>a == b</tt>, \p false otherwise.
+ */
+template <typename T, typename U, integer_cview_op_types_enabler<T, U> = 0>
+inline bool operator==(const T &a, const U &b)
+{
+    return detail::integer_cview_cmp(a, b) == 0;
+}
+
+/// Inequality operator involving \link mppp::integer_cview integer_cview\endlink.
+/**
+ * @param a the first operand.
+ * @param b the second operand.
+ *
+ * @return \p true if <tt>a != b</tt>, \p false otherwise.
+ */
+template <typename T, typename U, integer_cview_op_types_enabler<T, U> = 0>
+inline bool operator!=(const T &a, const U &b)
+{
+    return detail::integer_cview_cmp(a, b) != 0;
+}
+
+/// Less-than operator involving \link mppp::integer_cview integer_cview\endlink.
+/**
+ * @param a the first operand.
+ * @param b the second operand.
+ *
+ * @return \p true if <tt>a < b</tt>, \p false otherwise.
+ */
+template <typename T, typename U, integer_cview_op_types_enabler<T, U> = 0>
+inline bool operator<(const T &a, const U &b)
+{
+    return detail::integer_cview_cmp(a, b) < 0;
+}
+
+/// Less-than or equal operator involving \link mppp::integer_cview integer_cview\endlink.
+/**
+ * @param a the first operand.
+ * @param b the second operand.
+ *
+ * @return \p true if <tt>a <= b</tt>, \p false otherwise.
+ */
+template <typename T, typename U, integer_cview_op_types_enabler<T, U> = 0>
+inline bool operator<=(const T &a, const U &b)
+{
+    return detail::integer_cview_cmp(a, b) <= 0;
+}
+
+/// Greater-than operator involving \link mppp::integer_cview integer_cview\endlink.
+/**
+ * @param a the first operand.
+ * @param b the second operand.
+ *
+ * @return \p true if <tt>a > b</tt>, \p false otherwise.
+ */
+template <typename T, typename U, integer_cview_op_types_enabler<T, U> = 0>
+inline bool operator>(const T &a, const U &b)
+{
+    return detail::integer_cview_cmp(a, b) > 0;
+}
+
+/// Greater-than or equal operator involving \link mppp::integer_cview integer_cview\endlink.
+/**
+ * @param a the first operand.
+ * @param b the second operand.
+ *
+ * @return \p true if <tt>a >= b</tt>, \p false otherwise.
+ */
+template <typename T, typename U, integer_cview_op_types_enabler<T, U> = 0>
+inline bool operator>=(const T &a, const U &b)
+{
+    return detail::integer_cview_cmp(a, b) >= 0;
+}
+
+/** @} */
+
+} // namespace mppp
+
+namespace std
+{
+
+// Specialisation of std::hash for mppp::integer_cview.
+template <>
+struct hash<mppp::integer_cview> {
+#if MPPP_CPLUSPLUS < 201703L
+    using argument_type = mppp::integer_cview;
+    using result_type = size_t;
+#endif
+    size_t operator()(const mppp::integer_cview &v) const
+    {
+        return mppp::hash(v);
+    }
+};
+
+} // namespace std
+
+#endif
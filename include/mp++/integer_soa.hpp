@@ -0,0 +1,560 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_INTEGER_SOA_HPP
+#define MPPP_INTEGER_SOA_HPP
+
+#include <mp++/config.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/integer.hpp>
+
+namespace mppp
+{
+
+template <std::size_t>
+class integer_soa;
+
+namespace detail
+{
+
+// Metaprogramming for selecting the algorithm for the bulk add/sub and mul of integer_soa.
+// The selection happens via an std::integral_constant with 2 possible values:
+// - 0 (default case): element-wise implementation via integer,
+// - 1: selected when there are no nail bits and the static size is 1 (for mul, the dlimb
+//   primitives must be available as well).
+template <std::size_t SSize>
+using integer_soa_add_algo = std::integral_constant<int, (SSize == 1u && !GMP_NAIL_BITS) ? 1 : 0>;
+
+template <std::size_t SSize>
+using integer_soa_mul_algo
+    = std::integral_constant<int, (SSize == 1u && integer_have_dlimb_mul::value && !GMP_NAIL_BITS) ? 1 : 0>;
+
+// Special value in the sizes array of integer_soa signalling that the value is stored
+// in the side table. It cannot be confused with a valid static size.
+constexpr mpz_size_t integer_soa_dyn_size()
+{
+    return nl_max<mpz_size_t>();
+}
+
+// Fwd declare for friendship.
+template <bool, std::size_t SSize>
+void integer_soa_addsub_impl(integer_soa<SSize> &, const integer_soa<SSize> &, const integer_soa<SSize> &,
+                             std::size_t, const std::integral_constant<int, 1> &);
+
+template <std::size_t SSize>
+void integer_soa_mul_impl(integer_soa<SSize> &, const integer_soa<SSize> &, const integer_soa<SSize> &, std::size_t,
+                          const std::integral_constant<int, 1> &);
+
+} // namespace detail
+
+/// Structure-of-arrays container for \link mppp::integer integer\endlink.
+/**
+ * \rststar
+ * *#include <mp++/integer_soa.hpp>*
+ *
+ * .. versionadded:: 0.20
+ *
+ * This class stores a sequence of :cpp:class:`~mppp::integer` values with static size ``SSize``
+ * in structure-of-arrays form: the (signed) limb sizes of the values are stored in a contiguous array,
+ * and the ``i``-th limb of each value is stored in the ``i``-th of ``SSize`` contiguous limb arrays.
+ * Values which do not fit in ``SSize`` limbs are stored separately in a side table.
+ *
+ * With respect to ``std::vector<integer<SSize>>``, this layout allows to process the limbs of different
+ * values in SIMD lanes, and it reduces the memory bandwidth of bulk operations (the :cpp:class:`~mppp::integer`
+ * storage contains additional words which are not needed in this representation). The bulk arithmetic
+ * functions :cpp:func:`mppp::add()`, :cpp:func:`mppp::sub()` and :cpp:func:`mppp::mul()` overloaded for
+ * :cpp:class:`~mppp::integer_soa` are optimised for 1-limb values.
+ *
+ * Element access happens via :cpp:func:`~mppp::integer_soa::get()` and :cpp:func:`~mppp::integer_soa::set()`,
+ * or via the proxy object returned by the non-const subscript operator, which is convertible to and assignable
+ * from :cpp:class:`~mppp::integer`.
+ * \endrststar
+ */
+template <std::size_t SSize>
+class integer_soa
+{
+public:
+    /// The value type.
+    using value_type = integer<SSize>;
+    /// The size type.
+    using size_type = std::size_t;
+    /// Proxy class for element access.
+    /**
+     * Objects of this class are returned by the non-const subscript operator
+     * of \link mppp::integer_soa integer_soa\endlink.
+     */
+    class reference
+    {
+        friend class integer_soa;
+        explicit reference(integer_soa &c, size_type i) : m_c(c), m_i(i) {}
+
+    public:
+        /// Conversion to \link mppp::integer integer\endlink.
+        /**
+         * @return the value of the referenced element.
+         */
+        operator value_type() const
+        {
+            return m_c.get(m_i);
+        }
+        /// Assignment from \link mppp::integer integer\endlink.
+        /**
+         * @param n the value that will be assigned to the referenced element.
+         *
+         * @return a reference to \p this.
+         */
+        reference &operator=(const value_type &n)
+        {
+            m_c.set(m_i, n);
+            return *this;
+        }
+        /// Assignment from another proxy.
+        /**
+         * @param other the proxy whose referenced value will be assigned to the element referenced by \p this.
+         *
+         * @return a reference to \p this.
+         */
+        reference &operator=(const reference &other)
+        {
+            return operator=(static_cast<value_type>(other));
+        }
+
+    private:
+        integer_soa &m_c;
+        size_type m_i;
+    };
+    /// Default constructor.
+    /**
+     * The container will be empty.
+     */
+    integer_soa() = default;
+    /// Constructor from size.
+    /**
+     * @param n the number of elements in the container. All the elements will be initialised to zero.
+     */
+    explicit integer_soa(size_type n)
+    {
+        resize(n);
+    }
+    /// Constructor from range.
+    /**
+     * @param begin the start of a range of \link mppp::integer integer\endlink objects.
+     * @param end the end of a range of \link mppp::integer integer\endlink objects.
+     */
+    explicit integer_soa(const value_type *begin, const value_type *end)
+    {
+        assert(begin <= end);
+        resize(static_cast<size_type>(end - begin));
+        for (size_type i = 0; begin != end; ++begin, ++i) {
+            set(i, *begin);
+        }
+    }
+    /// Size.
+    /**
+     * @return the number of elements in the container.
+     */
+    size_type size() const
+    {
+        return m_sizes.size();
+    }
+    /// Resize.
+    /**
+     * If \p n is greater than the current size, the new elements will be initialised to zero.
+     *
+     * @param n the new number of elements in the container.
+     */
+    void resize(size_type n)
+    {
+        // Erase the side table entries beyond the new size.
+        for (auto i = n; i < m_sizes.size(); ++i) {
+            if (m_sizes[i] == detail::integer_soa_dyn_size()) {
+                m_dyn.erase(i);
+            }
+        }
+        m_sizes.resize(n, 0);
+        for (auto &l : m_limbs) {
+            l.resize(n, 0u);
+        }
+    }
+    /// Append an element.
+    /**
+     * @param n the value that will be appended to the container.
+     */
+    void push_back(const value_type &n)
+    {
+        resize(size() + 1u);
+        set(size() - 1u, n);
+    }
+    /// Get an element.
+    /**
+     * @param i the index of the element.
+     *
+     * @return the value of the element with index \p i.
+     */
+    value_type get(size_type i) const
+    {
+        assert(i < size());
+        const auto s = m_sizes[i];
+        if (mppp_unlikely(s == detail::integer_soa_dyn_size())) {
+            const auto it = m_dyn.find(i);
+            assert(it != m_dyn.end());
+            return it->second;
+        }
+        std::array<::mp_limb_t, SSize> tmp;
+        const auto asize = static_cast<size_type>(s >= 0 ? s : -s);
+        for (size_type j = 0; j < asize; ++j) {
+            tmp[j] = m_limbs[j][i];
+        }
+        value_type retval{tmp.data(), asize};
+        if (s < 0) {
+            retval.neg();
+        }
+        return retval;
+    }
+    /// Set an element.
+    /**
+     * If the value of \p n fits in \p SSize limbs, it will be stored in the arrays of
+     * sizes and limbs, otherwise it will be stored in the side table (regardless of the
+     * storage type of \p n).
+     *
+     * @param i the index of the element.
+     * @param n the new value of the element.
+     */
+    void set(size_type i, const value_type &n)
+    {
+        assert(i < size());
+        const auto asize = n.size();
+        if (mppp_unlikely(asize > SSize)) {
+            m_dyn[i] = n;
+            m_sizes[i] = detail::integer_soa_dyn_size();
+            zero_limbs(i);
+            return;
+        }
+        if (mppp_unlikely(m_sizes[i] == detail::integer_soa_dyn_size())) {
+            m_dyn.erase(i);
+        }
+        // NOTE: the view must be kept alive while we read from it.
+        const auto v = n.get_mpz_view();
+        const detail::mpz_struct_t *ptr = v;
+        m_sizes[i] = ptr->_mp_size;
+        size_type j = 0;
+        for (; j < asize; ++j) {
+            m_limbs[j][i] = ptr->_mp_d[j];
+        }
+        // Keep the unused limbs zeroed.
+        for (; j < SSize; ++j) {
+            m_limbs[j][i] = 0u;
+        }
+    }
+    /// Const subscript operator.
+    /**
+     * @param i the index of the element.
+     *
+     * @return the value of the element with index \p i.
+     */
+    value_type operator[](size_type i) const
+    {
+        return get(i);
+    }
+    /// Subscript operator.
+    /**
+     * @param i the index of the element.
+     *
+     * @return a proxy referencing the element with index \p i.
+     */
+    reference operator[](size_type i)
+    {
+        assert(i < size());
+        return reference(*this, i);
+    }
+    /// Test if an element is stored in the side table.
+    /**
+     * @param i the index of the element.
+     *
+     * @return \p true if the value of the element with index \p i does not fit in \p SSize limbs,
+     * \p false otherwise.
+     */
+    bool is_dynamic(size_type i) const
+    {
+        assert(i < size());
+        return m_sizes[i] == detail::integer_soa_dyn_size();
+    }
+    /// Get a pointer to the array of limb sizes.
+    /**
+     * The value at index \p i is the signed limb size of the element with index \p i
+     * (i.e., the \p _mp_size member of the equivalent \p mpz_t), or an
+     * unspecified value if the element is stored in the side table.
+     *
+     * @return a const pointer to the beginning of the array of limb sizes.
+     */
+    const detail::mpz_size_t *sizes_data() const
+    {
+        return m_sizes.data();
+    }
+    /// Get a pointer to an array of limbs.
+    /**
+     * The value at index \p i is the <tt>j</tt>-th limb of the element with index \p i.
+     * Unused limbs, and all the limbs of the elements stored in the side table, are zero.
+     *
+     * @param j the limb index.
+     *
+     * @return a const pointer to the beginning of the array of the <tt>j</tt>-th limbs.
+     */
+    const ::mp_limb_t *limbs_data(std::size_t j) const
+    {
+        assert(j < SSize);
+        return m_limbs[j].data();
+    }
+
+private:
+    template <bool, std::size_t S>
+    friend void detail::integer_soa_addsub_impl(integer_soa<S> &, const integer_soa<S> &, const integer_soa<S> &,
+                                                std::size_t, const std::integral_constant<int, 1> &);
+    template <std::size_t S>
+    friend void detail::integer_soa_mul_impl(integer_soa<S> &, const integer_soa<S> &, const integer_soa<S> &,
+                                             std::size_t, const std::integral_constant<int, 1> &);
+
+    // Mutable counterparts of sizes_data() and limbs_data(), used by the
+    // bulk arithmetic functions to write directly into the arrays.
+    detail::mpz_size_t *mutable_sizes_data()
+    {
+        return m_sizes.data();
+    }
+    ::mp_limb_t *mutable_limbs_data(std::size_t j)
+    {
+        assert(j < SSize);
+        return m_limbs[j].data();
+    }
+    void zero_limbs(size_type i)
+    {
+        for (auto &l : m_limbs) {
+            l[i] = 0u;
+        }
+    }
+
+    std::vector<detail::mpz_size_t> m_sizes;
+    std::array<std::vector<::mp_limb_t>, SSize> m_limbs;
+    std::unordered_map<size_type, value_type> m_dyn;
+};
+
+namespace detail
+{
+
+// Prepare rop for a bulk operation on op1 and op2, and return the number of elements.
+template <std::size_t SSize>
+inline std::size_t integer_soa_prepare(integer_soa<SSize> &rop, const integer_soa<SSize> &op1,
+                                       const integer_soa<SSize> &op2)
+{
+    if (mppp_unlikely(op1.size() != op2.size())) {
+        throw std::invalid_argument("Cannot perform a bulk operation on integer_soa objects of different sizes ("
+                                    + to_string(op1.size()) + " vs " + to_string(op2.size()) + ")");
+    }
+    if (&rop != &op1 && &rop != &op2) {
+        // NOTE: all the elements of rop will be overwritten.
+        rop = integer_soa<SSize>(op1.size());
+    }
+    return op1.size();
+}
+
+// Element-wise implementation of add/sub.
+template <bool AddOrSub, std::size_t SSize>
+inline void integer_soa_addsub_impl(integer_soa<SSize> &rop, const integer_soa<SSize> &op1,
+                                    const integer_soa<SSize> &op2, std::size_t n, const std::integral_constant<int, 0> &)
+{
+    integer<SSize> tmp;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (AddOrSub) {
+            add(tmp, op1.get(i), op2.get(i));
+        } else {
+            sub(tmp, op1.get(i), op2.get(i));
+        }
+        rop.set(i, tmp);
+    }
+}
+
+// 1-limb implementation of add/sub.
+template <bool AddOrSub, std::size_t SSize>
+inline void integer_soa_addsub_impl(integer_soa<SSize> &rop, const integer_soa<SSize> &op1,
+                                    const integer_soa<SSize> &op2, std::size_t n, const std::integral_constant<int, 1> &)
+{
+    const auto s1 = op1.sizes_data(), s2 = op2.sizes_data();
+    const auto l1 = op1.limbs_data(0), l2 = op2.limbs_data(0);
+    // NOTE: rop's arrays might coincide with op1's/op2's arrays, but element i
+    // of rop depends only on element i of op1 and op2.
+    const auto sr = rop.mutable_sizes_data();
+    const auto lr = rop.mutable_limbs_data(0);
+    // The elements for which the fast path failed (either because an operand is
+    // in the side table or because of overflow).
+    MPPP_MAYBE_TLS std::vector<std::size_t> failed;
+    failed.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto size1 = s1[i], size2 = s2[i];
+        const auto a = l1[i], b = l2[i];
+        const int sign1 = integral_sign(size1), sign2 = AddOrSub ? integral_sign(size2) : -integral_sign(size2);
+        // NOTE: if one operand is zero, its limb is zero and the addition
+        // codepath gives the correct result.
+        const bool same = (sign1 * sign2 >= 0);
+        ::mp_limb_t sum;
+        const auto cy = limb_add_overflow(a, b, &sum);
+        const bool a_ge_b = a >= b;
+        const ::mp_limb_t diff = a_ge_b ? a - b : b - a;
+        const ::mp_limb_t res = same ? sum : diff;
+        // NOTE: in the same sign case, at most one of the signs is zero, and sign1 | sign2
+        // is the sign of the nonzero operand.
+        const int sign = same ? (sign1 | sign2) : (a_ge_b ? sign1 : sign2);
+        if (mppp_unlikely(size1 == integer_soa_dyn_size() || size2 == integer_soa_dyn_size()
+                          || (same && cy))) {
+            failed.push_back(i);
+            continue;
+        }
+        sr[i] = sign * static_cast<mpz_size_t>(res != 0u);
+        lr[i] = res;
+    }
+    for (const auto i : failed) {
+        const auto a = op1.get(i), b = op2.get(i);
+        rop.set(i, AddOrSub ? a + b : a - b);
+    }
+}
+
+template <bool AddOrSub, std::size_t SSize>
+inline void integer_soa_addsub(integer_soa<SSize> &rop, const integer_soa<SSize> &op1, const integer_soa<SSize> &op2)
+{
+    const auto n = integer_soa_prepare(rop, op1, op2);
+    integer_soa_addsub_impl<AddOrSub>(rop, op1, op2, n, integer_soa_add_algo<SSize>{});
+}
+
+// Element-wise implementation of mul.
+template <std::size_t SSize>
+inline void integer_soa_mul_impl(integer_soa<SSize> &rop, const integer_soa<SSize> &op1, const integer_soa<SSize> &op2,
+                                 std::size_t n, const std::integral_constant<int, 0> &)
+{
+    integer<SSize> tmp;
+    for (std::size_t i = 0; i < n; ++i) {
+        mul(tmp, op1.get(i), op2.get(i));
+        rop.set(i, tmp);
+    }
+}
+
+// 1-limb implementation of mul via dlimb.
+template <std::size_t SSize>
+inline void integer_soa_mul_impl(integer_soa<SSize> &rop, const integer_soa<SSize> &op1, const integer_soa<SSize> &op2,
+                                 std::size_t n, const std::integral_constant<int, 1> &)
+{
+    const auto s1 = op1.sizes_data(), s2 = op2.sizes_data();
+    const auto l1 = op1.limbs_data(0), l2 = op2.limbs_data(0);
+    const auto sr = rop.mutable_sizes_data();
+    const auto lr = rop.mutable_limbs_data(0);
+    MPPP_MAYBE_TLS std::vector<std::size_t> failed;
+    failed.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto size1 = s1[i], size2 = s2[i];
+        ::mp_limb_t hi;
+        const auto lo = dlimb_mul(l1[i], l2[i], &hi);
+        if (mppp_unlikely(size1 == integer_soa_dyn_size() || size2 == integer_soa_dyn_size() || hi)) {
+            failed.push_back(i);
+            continue;
+        }
+        // NOTE: the static sizes are in the [-1, 1] range.
+        sr[i] = size1 * size2;
+        lr[i] = lo;
+    }
+    for (const auto i : failed) {
+        rop.set(i, op1.get(i) * op2.get(i));
+    }
+}
+
+template <std::size_t SSize>
+inline void integer_soa_mul(integer_soa<SSize> &rop, const integer_soa<SSize> &op1, const integer_soa<SSize> &op2)
+{
+    const auto n = integer_soa_prepare(rop, op1, op2);
+    integer_soa_mul_impl(rop, op1, op2, n, integer_soa_mul_algo<SSize>{});
+}
+
+} // namespace detail
+
+/** @defgroup integer_soa_arithmetic integer_soa_arithmetic
+ *  @{
+ */
+
+/// Bulk addition for \link mppp::integer_soa integer_soa\endlink.
+/**
+ * This function will set the <tt>i</tt>-th element of \p rop to the sum of the <tt>i</tt>-th elements
+ * of \p op1 and \p op2. After the operation, the size of \p rop will be the size of \p op1.
+ *
+ * @param rop the return value.
+ * @param op1 the first argument.
+ * @param op2 the second argument.
+ *
+ * @return a reference to \p rop.
+ *
+ * @throws std::invalid_argument if \p op1 and \p op2 have different sizes.
+ */
+template <std::size_t SSize>
+inline integer_soa<SSize> &add(integer_soa<SSize> &rop, const integer_soa<SSize> &op1, const integer_soa<SSize> &op2)
+{
+    detail::integer_soa_addsub<true>(rop, op1, op2);
+    return rop;
+}
+
+/// Bulk subtraction for \link mppp::integer_soa integer_soa\endlink.
+/**
+ * This function will set the <tt>i</tt>-th element of \p rop to the difference of the <tt>i</tt>-th elements
+ * of \p op1 and \p op2. After the operation, the size of \p rop will be the size of \p op1.
+ *
+ * @param rop the return value.
+ * @param op1 the first argument.
+ * @param op2 the second argument.
+ *
+ * @return a reference to \p rop.
+ *
+ * @throws std::invalid_argument if \p op1 and \p op2 have different sizes.
+ */
+template <std::size_t SSize>
+inline integer_soa<SSize> &sub(integer_soa<SSize> &rop, const integer_soa<SSize> &op1, const integer_soa<SSize> &op2)
+{
+    detail::integer_soa_addsub<false>(rop, op1, op2);
+    return rop;
+}
+
+/// Bulk multiplication for \link mppp::integer_soa integer_soa\endlink.
+/**
+ * This function will set the <tt>i</tt>-th element of \p rop to the product of the <tt>i</tt>-th elements
+ * of \p op1 and \p op2. After the operation, the size of \p rop will be the size of \p op1.
+ *
+ * @param rop the return value.
+ * @param op1 the first argument.
+ * @param op2 the second argument.
+ *
+ * @return a reference to \p rop.
+ *
+ * @throws std::invalid_argument if \p op1 and \p op2 have different sizes.
+ */
+template <std::size_t SSize>
+inline integer_soa<SSize> &mul(integer_soa<SSize> &rop, const integer_soa<SSize> &op1, const integer_soa<SSize> &op2)
+{
+    detail::integer_soa_mul(rop, op1, op2);
+    return rop;
+}
+
+/** @} */
+
+} // namespace mppp
+
+#endif
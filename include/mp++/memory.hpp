@@ -0,0 +1,284 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_MEMORY_HPP
+#define MPPP_MEMORY_HPP
+
+#include <mp++/config.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include <mp++/detail/visibility.hpp>
+
+namespace mppp
+{
+
+/// Memory resource for multiprecision storage.
+/**
+ * \rststar
+ * *#include <mp++/memory.hpp>*
+ *
+ * .. versionadded:: 0.20
+ *
+ * This abstract class defines the interface of the memory resources that can be used,
+ * via :cpp:class:`~mppp::memory_resource_scope`, to provide the significands of :cpp:class:`~mppp::real`
+ * objects and the dynamic storage of :cpp:class:`~mppp::integer` objects. The guarantees offered to the
+ * resource differ between the two cases:
+ *
+ * * the significand of a :cpp:class:`~mppp::real` is allocated, reallocated (e.g., when the precision
+ *   is changed) and deallocated exclusively by mp++ via the resource which allocated it. Any allocator
+ *   can thus be used (e.g., NUMA-local pools, tracking allocators, monotonic allocators, etc.);
+ * * the dynamic storage of an :cpp:class:`~mppp::integer` is only allocated by the resource.
+ *   GMP reallocates and deallocates it via its own memory functions (e.g., when an :cpp:class:`~mppp::integer`
+ *   grows as a result of an arithmetic operation), which mp++ does not alter. It follows that the blocks
+ *   handed out for the storage of :cpp:class:`~mppp::integer` objects must be compatible with the memory
+ *   functions installed in GMP (e.g., if GMP uses its default memory functions, the blocks must be
+ *   reallocatable via ``std::realloc()`` and deallocatable via ``std::free()``, as it is the case for the
+ *   blocks handed out by an allocator which replaces ``std::malloc()``), and that they are never handed
+ *   back to the resource. NUMA-local pools, tracking allocators and monotonic allocators which
+ *   are not compatible with GMP's memory functions cannot thus be used for the storage of
+ *   :cpp:class:`~mppp::integer` objects.
+ *
+ * The member functions of this class are invoked by mp++ in contexts in which exceptions
+ * cannot be propagated, and thus they cannot throw: memory allocation errors should be handled by aborting
+ * the program, like GMP does.
+ * \endrststar
+ */
+class MPPP_DLL_PUBLIC memory_resource
+{
+public:
+    /// Default constructor.
+    memory_resource() = default;
+    /// Deleted copy constructor.
+    memory_resource(const memory_resource &) = delete;
+    /// Deleted copy assignment.
+    memory_resource &operator=(const memory_resource &) = delete;
+    /// Destructor.
+    virtual ~memory_resource();
+    /// Allocate memory.
+    /**
+     * @param size the number of bytes to be allocated.
+     *
+     * @return a pointer to a memory block of at least \p size bytes, suitably aligned
+     * for any fundamental type.
+     */
+    virtual void *allocate(std::size_t size) noexcept = 0;
+    /// Deallocate memory.
+    /**
+     * @param ptr a pointer to a memory block owned by this resource.
+     * @param size the size of the memory block.
+     */
+    virtual void deallocate(void *ptr, std::size_t size) noexcept = 0;
+};
+
+namespace detail
+{
+
+// A monotonic (bump) allocator. The memory is requested in blocks
+// of geometrically increasing size, and it is released all at once
+// on destruction. Deallocation is a no-op, unless the block being deallocated
+// is the last one handed out.
+class MPPP_DLL_PUBLIC arena final : public memory_resource
+{
+public:
+    struct block {
+        unsigned char *ptr;
+        std::size_t size;
+        std::size_t top;
+    };
+    explicit arena(std::size_t);
+    ~arena() override;
+    void *allocate(std::size_t) noexcept override;
+    void deallocate(void *, std::size_t) noexcept override;
+    bool owns(const void *) const noexcept;
+    // The list of blocks.
+    std::vector<block> m_blocks;
+    // The minimum size of the next block.
+    std::size_t m_next_size;
+    // The number of bytes currently handed out.
+    std::size_t m_nbytes;
+    // The GMP memory functions used to allocate/deallocate the blocks.
+    void *(*m_alloc)(std::size_t);
+    void (*m_free)(void *, std::size_t);
+};
+
+// Node in the per-thread stack of memory resources. int_res and real_res
+// are the resources providing the storage of integer and real objects
+// (null if the storage is taken from the heap).
+struct memory_resource_node {
+    memory_resource *int_res;
+    memory_resource *real_res;
+    memory_resource_node *prev;
+};
+
+// Push/pop a node onto/from the stack of memory resources of the calling thread.
+MPPP_DLL_PUBLIC void push_memory_resource(memory_resource_node &);
+MPPP_DLL_PUBLIC void pop_memory_resource(memory_resource_node &);
+
+// Get the memory resources which currently provide the storage of
+// integer and real objects in the calling thread (null if there is none).
+MPPP_DLL_PUBLIC memory_resource *get_thread_local_integer_resource();
+MPPP_DLL_PUBLIC memory_resource *get_thread_local_real_resource();
+
+// RAII helper to take the storage of the objects created in the calling
+// thread from the heap, regardless of the active memory resources. It is used
+// for objects which may outlive the scopes (e.g., static or thread-local caches).
+class MPPP_DLL_PUBLIC heap_alloc_guard
+{
+public:
+    heap_alloc_guard();
+    heap_alloc_guard(const heap_alloc_guard &) = delete;
+    heap_alloc_guard(heap_alloc_guard &&) = delete;
+    heap_alloc_guard &operator=(const heap_alloc_guard &) = delete;
+    heap_alloc_guard &operator=(heap_alloc_guard &&) = delete;
+    ~heap_alloc_guard();
+
+private:
+    memory_resource_node m_node;
+};
+
+} // namespace detail
+
+/// Scoped memory resource.
+/**
+ * \rststar
+ * *#include <mp++/memory.hpp>*
+ *
+ * .. versionadded:: 0.20
+ *
+ * While an object of this class is alive, the significands of the :cpp:class:`~mppp::real` objects
+ * and the dynamic storage of the :cpp:class:`~mppp::integer` objects created in the calling thread are
+ * obtained from a user-supplied :cpp:class:`~mppp::memory_resource`, and the thread-local
+ * allocation caches are bypassed. Scopes can be nested (also with :cpp:class:`~mppp::arena_scope` objects),
+ * in which case the innermost scope is used for new allocations.
+ *
+ * GMP's memory functions are not altered, so that the memory management of other users of GMP in the
+ * same process is not affected. The significand of a :cpp:class:`~mppp::real` is returned to the resource
+ * which allocated it when the :cpp:class:`~mppp::real` is destroyed, and it is reallocated in the same
+ * resource if the precision of the :cpp:class:`~mppp::real` is changed. The storage of an
+ * :cpp:class:`~mppp::integer` is instead managed by GMP after the initial allocation (see the documentation
+ * of :cpp:class:`~mppp::memory_resource` for the requirements that this places on the resource).
+ * A memory resource can be made active for the whole lifetime of a thread by creating a scope at the
+ * beginning of the thread function. The user must ensure that:
+ *
+ * * the resource outlives all the :cpp:class:`~mppp::real` objects whose significand it allocated,
+ *   and it can be used concurrently from multiple threads if these objects are destroyed
+ *   or modified in a thread other than the one in which they were created;
+ * * the ``mpfr_t`` returned by :cpp:func:`mppp::real::get_mpfr_t()` for an object whose significand
+ *   was allocated by the resource is not passed to ``mpfr_set_prec()``, ``mpfr_prec_round()`` or ``mpfr_clear()``.
+ *
+ * On platforms where thread-local storage is not available, this class does nothing.
+ * \endrststar
+ */
+class MPPP_DLL_PUBLIC memory_resource_scope
+{
+public:
+    /// Constructor.
+    /**
+     * @param res the memory resource that will be used in the calling thread.
+     */
+    explicit memory_resource_scope(memory_resource &res);
+    /// Deleted copy constructor.
+    memory_resource_scope(const memory_resource_scope &) = delete;
+    /// Deleted move constructor.
+    memory_resource_scope(memory_resource_scope &&) = delete;
+    /// Deleted copy assignment.
+    memory_resource_scope &operator=(const memory_resource_scope &) = delete;
+    /// Deleted move assignment.
+    memory_resource_scope &operator=(memory_resource_scope &&) = delete;
+    /// Destructor.
+    ~memory_resource_scope();
+
+private:
+    detail::memory_resource_node m_node;
+};
+
+/// Scoped arena for multiprecision temporaries.
+/**
+ * \rststar
+ * *#include <mp++/memory.hpp>*
+ *
+ * .. versionadded:: 0.20
+ *
+ * While an object of this class is alive, the significands of the :cpp:class:`~mppp::real`
+ * objects created in the calling thread are obtained from a monotonic (bump) allocator,
+ * rather than from the heap. The storage is released all at once when the
+ * :cpp:class:`~mppp::arena_scope` is destroyed: freeing the storage of individual objects is
+ * a no-op, and the thread-local :cpp:class:`~mppp::real` allocation cache is bypassed. Arena scopes
+ * can be nested with each other and with :cpp:class:`~mppp::memory_resource_scope` objects,
+ * in which case the innermost scope is used for new allocations.
+ *
+ * The arena is meant to be used in phases of a computation which create a large number of
+ * short-lived multiprecision values. The arena does not alter GMP's memory functions: the memory
+ * it hands out is allocated, reallocated (e.g., when the precision of a :cpp:class:`~mppp::real`
+ * is changed) and deallocated exclusively by mp++. For this reason, the arena does not provide
+ * the dynamic storage of :cpp:class:`~mppp::integer` objects, which GMP reallocates and deallocates via its
+ * own memory functions. :cpp:class:`~mppp::integer` objects created while the arena is active keep on using
+ * the enclosing :cpp:class:`~mppp::memory_resource_scope`, if any, or the heap otherwise.
+ *
+ * The user must ensure that:
+ *
+ * * all the objects whose storage was obtained from the arena are destroyed, in the same thread,
+ *   before the arena is destroyed. A :cpp:class:`~mppp::real` whose storage was obtained from the arena keeps on
+ *   using the arena if its precision is changed. A value which must outlive the arena can be assigned to an object
+ *   which was created before the arena;
+ * * the ``mpfr_t`` returned by :cpp:func:`mppp::real::get_mpfr_t()` for an object whose storage was obtained
+ *   from the arena is not passed to ``mpfr_set_prec()``, ``mpfr_prec_round()`` or ``mpfr_clear()``.
+ *
+ * On platforms where thread-local storage is not available, this class does nothing.
+ * \endrststar
+ */
+class MPPP_DLL_PUBLIC arena_scope
+{
+public:
+    /// The default block size.
+    static constexpr std::size_t default_block_size = 65536u;
+    /// Constructor.
+    /**
+     * The arena will request memory in blocks of at least \p block_size bytes. The size of
+     * the blocks increases geometrically as the arena grows. The memory blocks are allocated
+     * via the memory functions installed in GMP.
+     *
+     * @param block_size the size (in bytes) of the first memory block.
+     *
+     * @throws std::invalid_argument if \p block_size is zero.
+     */
+    explicit arena_scope(std::size_t block_size = default_block_size);
+    /// Deleted copy constructor.
+    arena_scope(const arena_scope &) = delete;
+    /// Deleted move constructor.
+    arena_scope(arena_scope &&) = delete;
+    /// Deleted copy assignment.
+    arena_scope &operator=(const arena_scope &) = delete;
+    /// Deleted move assignment.
+    arena_scope &operator=(arena_scope &&) = delete;
+    /// Destructor.
+    /**
+     * The destructor will release all the memory blocks of the arena.
+     */
+    ~arena_scope();
+    /// Get the number of bytes in use.
+    /**
+     * @return the number of bytes which are currently handed out by the arena.
+     */
+    std::size_t get_nbytes() const;
+    /// Get the capacity.
+    /**
+     * @return the total size (in bytes) of the memory blocks of the arena.
+     */
+    std::size_t get_capacity() const;
+
+private:
+    detail::arena m_arena;
+    detail::memory_resource_node m_node;
+};
+
+} // namespace mppp
+
+#endif
@@ -0,0 +1,589 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_MOD_CONTEXT_HPP
+#define MPPP_MOD_CONTEXT_HPP
+
+#include <mp++/config.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/exceptions.hpp>
+#include <mp++/integer.hpp>
+
+namespace mppp
+{
+
+namespace detail
+{
+
+// The 1-limb algorithms of mod_context need both the double-limb
+// multiplication and division primitives.
+// NOTE: the integer_have_dlimb_mul and integer_have_dlimb_div machinery
+// already checks for lack of nail bits, bit sizes, etc.
+using mod_context_have_dlimb
+    = std::integral_constant<bool, integer_have_dlimb_mul::value && integer_have_dlimb_div::value>;
+
+// NOTE: the 1-limb kernels below are templates so that the dlimb primitives
+// are looked up only on instantiation, which happens only if
+// mod_context_have_dlimb is true.
+
+// Compute the reciprocal floor((B**2 - 1) / d) - B of the normalised limb d.
+template <typename Limb>
+inline Limb mod_context_reciprocal(Limb d)
+{
+    static_assert(std::is_same<Limb, ::mp_limb_t>::value, "Invalid limb type.");
+    assert(d >> (GMP_NUMB_BITS - 1));
+    Limb q1, q2;
+    // NOTE: the high limb of the dividend is ~d < d, thus the quotient fits in a limb.
+    dlimb_tdiv_q(Limb(-1), Limb(~d), d, Limb(0), &q1, &q2);
+    assert(q2 == 0u);
+    return q1;
+}
+
+// Compute op1 * op2 mod d, given the normalisation shift of d, the normalised
+// divisor dnorm and its reciprocal inv. op1 and op2 must be less than d.
+// This is algorithm 4 from Moller and Granlund, "Improved division by invariant integers".
+template <typename Limb>
+inline Limb mod_context_mulm_preinv(Limb op1, Limb op2, unsigned shift, Limb dnorm, Limb inv)
+{
+    static_assert(std::is_same<Limb, ::mp_limb_t>::value, "Invalid limb type.");
+    Limb hi;
+    auto lo = dlimb_mul(op1, op2, &hi);
+    if (shift) {
+        hi = (hi << shift) | (lo >> (unsigned(GMP_NUMB_BITS) - shift));
+        lo <<= shift;
+    }
+    // NOTE: the normalised product is less than dnorm * d, thus hi < dnorm.
+    assert(hi < dnorm);
+    Limb q1;
+    auto q0 = dlimb_mul(inv, hi, &q1);
+    q0 += lo;
+    q1 += hi + static_cast<Limb>(q0 < lo);
+    ++q1;
+    auto r = static_cast<Limb>(lo - q1 * dnorm);
+    if (r > q0) {
+        r += dnorm;
+    }
+    if (mppp_unlikely(r >= dnorm)) {
+        r -= dnorm;
+    }
+    return r >> shift;
+}
+
+// Montgomery multiplication op1 * op2 / B mod m, where m is odd and minv is -m**-1 mod B.
+// op1 and op2 must be less than m.
+template <typename Limb>
+inline Limb mod_context_mont_mul(Limb op1, Limb op2, Limb m, Limb minv)
+{
+    static_assert(std::is_same<Limb, ::mp_limb_t>::value, "Invalid limb type.");
+    Limb hi, qhi;
+    const auto lo = dlimb_mul(op1, op2, &hi);
+    const auto q = static_cast<Limb>(lo * minv);
+    dlimb_mul(q, m, &qhi);
+    // NOTE: the low limb of op1 * op2 + q * m is zero by construction,
+    // and the addition of the low limbs carries iff lo is not zero.
+    // The result is in the [0, 2 * m) range, and it may overflow
+    // a limb if m is greater than B / 2.
+    const auto c = static_cast<Limb>(lo != 0u);
+    auto r = static_cast<Limb>(hi + qhi);
+    auto carry = r < hi;
+    r = static_cast<Limb>(r + c);
+    carry = carry || r < c;
+    if (carry || r >= m) {
+        r = static_cast<Limb>(r - m);
+    }
+    return r;
+}
+
+} // namespace detail
+
+/// Modular arithmetic context.
+/**
+ * \rststar
+ * *#include <mp++/mod_context.hpp>*
+ *
+ * .. versionadded:: 0.20
+ *
+ * This class stores a positive modulus together with a set of constants, precomputed on construction,
+ * which speed up repeated modular multiplications, squarings and exponentiations with that modulus.
+ * The results of all the operations are in the :math:`\left[0, \mathrm{mod}\right)` range.
+ *
+ * When the modulus fits in static storage, the operations never allocate memory and they
+ * always produce results in static storage. For a modulus consisting of a single limb,
+ * the products are reduced via a precomputed reciprocal of the modulus (so that no division instruction
+ * is ever executed), and exponentiations with an odd modulus are computed via Montgomery multiplication.
+ * For larger moduli, the products are computed and divided via the low-level ``mpn`` GMP functions,
+ * and exponentiations are delegated to GMP's own Montgomery implementation. If the modulus
+ * does not fit in static storage, the ``mpz`` GMP API is used.
+ *
+ * The 1-limb algorithms are available only on platforms supporting the double-limb primitives
+ * used internally by :cpp:class:`~mppp::integer` (e.g., 64-bit GCC/clang builds).
+ *
+ * Operands which are not in the :math:`\left[0, \mathrm{mod}\right)` range are reduced
+ * before the operation via the GMP API. For best performance, the operands should thus
+ * already be reduced.
+ *
+ * .. seealso::
+ *
+ *    :cpp:func:`mppp::sqrm()`
+ * \endrststar
+ */
+template <std::size_t SSize>
+class mod_context
+{
+    using limb_array = std::array<::mp_limb_t, SSize>;
+
+public:
+    /// Constructor.
+    /**
+     * @param mod the modulus.
+     *
+     * @throws zero_division_error if \p mod is zero.
+     * @throws std::invalid_argument if \p mod is negative.
+     */
+    explicit mod_context(const integer<SSize> &mod)
+        : m_mod(mod), m_algo(0), m_nlimbs(0), m_limbs{}, m_shift(0), m_dnorm(0), m_inv(0), m_minv(0), m_r2(0),
+          m_one(0)
+    {
+        if (mppp_unlikely(mod.sgn() == 0)) {
+            throw zero_division_error("Cannot construct a modular arithmetic context with a zero modulus");
+        }
+        if (mppp_unlikely(mod.sgn() < 0)) {
+            throw std::invalid_argument("Cannot construct a modular arithmetic context with the negative modulus "
+                                        + mod.to_string());
+        }
+        // NOTE: make sure the modulus is stored in static
+        // storage, if possible.
+        m_mod.demote();
+        if (!m_mod.is_static()) {
+            return;
+        }
+        m_nlimbs = m_mod.size();
+        const auto data = m_mod._get_union().g_st().m_limbs.data();
+        detail::copy_limbs_no(data, data + m_nlimbs, m_limbs.data());
+        m_algo = 2;
+        init_1(detail::mod_context_have_dlimb{});
+    }
+
+    /// Get the modulus.
+    /**
+     * @return a const reference to the modulus.
+     */
+    const integer<SSize> &get_mod() const
+    {
+        return m_mod;
+    }
+
+    /// Modular multiplication.
+    /**
+     * This function will set \p rop to <tt>a * b</tt> modulo the modulus of this context.
+     *
+     * @param rop the return value.
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return a reference to \p rop.
+     */
+    integer<SSize> &mulm(integer<SSize> &rop, const integer<SSize> &a, const integer<SSize> &b) const
+    {
+        if (m_algo == 1) {
+            return store_1(rop, mulm_1(load_1(a), load_1(b), detail::mod_context_have_dlimb{}));
+        }
+        if (mppp_unlikely(!m_algo)) {
+            MPPP_MAYBE_TLS detail::mpz_raii tmp;
+            ::mpz_mul(&tmp.m_mpz, a.get_mpz_view(), b.get_mpz_view());
+            ::mpz_fdiv_r(&tmp.m_mpz, &tmp.m_mpz, m_mod.get_mpz_view());
+            return rop = &tmp.m_mpz;
+        }
+        limb_array x, y;
+        load(x, a);
+        load(y, b);
+        mulm_mpn(x, x, y);
+        return store(rop, x);
+    }
+
+    /// Modular squaring.
+    /**
+     * This function will set \p rop to <tt>a * a</tt> modulo the modulus of this context.
+     *
+     * @param rop the return value.
+     * @param a the operand.
+     *
+     * @return a reference to \p rop.
+     */
+    integer<SSize> &sqrm(integer<SSize> &rop, const integer<SSize> &a) const
+    {
+        if (m_algo == 1) {
+            const auto x = load_1(a);
+            return store_1(rop, mulm_1(x, x, detail::mod_context_have_dlimb{}));
+        }
+        if (mppp_unlikely(!m_algo)) {
+            MPPP_MAYBE_TLS detail::mpz_raii tmp;
+            ::mpz_mul(&tmp.m_mpz, a.get_mpz_view(), a.get_mpz_view());
+            ::mpz_fdiv_r(&tmp.m_mpz, &tmp.m_mpz, m_mod.get_mpz_view());
+            return rop = &tmp.m_mpz;
+        }
+        limb_array x;
+        load(x, a);
+        mulm_mpn(x, x, x);
+        return store(rop, x);
+    }
+
+    /// Modular exponentiation.
+    /**
+     * This function will set \p rop to <tt>base**exp</tt> modulo the modulus of this context.
+     *
+     * @param rop the return value.
+     * @param base the base.
+     * @param exp the exponent.
+     *
+     * @return a reference to \p rop.
+     *
+     * @throws std::domain_error if \p exp is negative.
+     */
+    integer<SSize> &powm(integer<SSize> &rop, const integer<SSize> &base, const integer<SSize> &exp) const
+    {
+        if (mppp_unlikely(exp.sgn() < 0)) {
+            throw std::domain_error("Cannot compute a modular power with the negative exponent " + exp.to_string());
+        }
+        if (m_algo == 1) {
+            return store_1(rop, powm_1(load_1(base), exp, detail::mod_context_have_dlimb{}));
+        }
+        // NOTE: for multi-limb moduli, GMP's exponentiation (which uses Montgomery
+        // multiplication with assembly kernels) is faster than anything we can do
+        // on top of the mpn API. If the modulus is static, the result
+        // will be written into rop without promotion.
+        MPPP_MAYBE_TLS detail::mpz_raii tmp;
+        ::mpz_powm(&tmp.m_mpz, base.get_mpz_view(), exp.get_mpz_view(), m_mod.get_mpz_view());
+        return rop = &tmp.m_mpz;
+    }
+
+private:
+    // Setup of the 1-limb algorithm.
+    void init_1(const std::true_type &)
+    {
+        if (m_nlimbs != 1u) {
+            return;
+        }
+        m_algo = 1;
+        const auto m = m_limbs[0];
+        m_shift = static_cast<unsigned>(GMP_NUMB_BITS) - detail::limb_size_nbits(m);
+        m_dnorm = static_cast<::mp_limb_t>(m << m_shift);
+        m_inv = detail::mod_context_reciprocal(m_dnorm);
+        if (m & 1u) {
+            // Compute -m**-1 mod B via Newton iteration. The initial
+            // value is correct to 3 bits, and each iteration doubles the
+            // number of correct bits.
+            auto inv = m;
+            for (unsigned nbits = 3; nbits < unsigned(GMP_NUMB_BITS); nbits *= 2u) {
+                inv = static_cast<::mp_limb_t>(inv * static_cast<::mp_limb_t>(2u - m * inv));
+            }
+            assert(static_cast<::mp_limb_t>(inv * m) == 1u);
+            m_minv = static_cast<::mp_limb_t>(-inv);
+            // Precompute B mod m and B**2 mod m.
+            ::mp_limb_t q1, q2, r2;
+            detail::dlimb_tdiv_qr(::mp_limb_t(0), ::mp_limb_t(1), m, ::mp_limb_t(0), &q1, &q2, &m_one, &r2);
+            m_r2 = mulm_1(m_one, m_one, std::true_type{});
+        }
+    }
+    void init_1(const std::false_type &) {}
+    // Load n mod m, for a 1-limb modulus.
+    ::mp_limb_t load_1(const integer<SSize> &n) const
+    {
+        if (mppp_likely(n.is_static())) {
+            const auto &st = n._get_union().g_st();
+            if (st._mp_size == 0) {
+                return 0;
+            }
+            if (st._mp_size == 1 && st.m_limbs[0] < m_limbs[0]) {
+                return st.m_limbs[0];
+            }
+        }
+        limb_array out;
+        load_reduce(out, n);
+        return out[0];
+    }
+    // Write the 1-limb value x into rop.
+    integer<SSize> &store_1(integer<SSize> &rop, ::mp_limb_t x) const
+    {
+        if (mppp_unlikely(!rop.is_static())) {
+            rop.set_zero();
+        }
+        auto &st = rop._get_union().g_st();
+        const auto old_size = st._mp_size;
+        st._mp_size = static_cast<detail::mpz_size_t>(x != 0u);
+        st.m_limbs[0] = x;
+        if (old_size > 1 || old_size < -1) {
+            // Zero the limbs of the old value, if needed.
+            st.zero_unused_limbs();
+        }
+        return rop;
+    }
+    // 1-limb multiplication.
+    ::mp_limb_t mulm_1(::mp_limb_t x, ::mp_limb_t y, const std::true_type &) const
+    {
+        return detail::mod_context_mulm_preinv(x, y, m_shift, m_dnorm, m_inv);
+    }
+    // LCOV_EXCL_START
+    ::mp_limb_t mulm_1(::mp_limb_t, ::mp_limb_t, const std::false_type &) const
+    {
+        assert(false);
+        return 0;
+    }
+    // LCOV_EXCL_STOP
+    // 1-limb exponentiation.
+    ::mp_limb_t powm_1(::mp_limb_t b, const integer<SSize> &exp, const std::true_type &) const
+    {
+        const auto m = m_limbs[0];
+        if (m & 1u) {
+            // Odd modulus, use the Montgomery representation.
+            const auto minv = m_minv;
+            auto mont_mul = [m, minv](::mp_limb_t x, ::mp_limb_t y) {
+                return detail::mod_context_mont_mul(x, y, m, minv);
+            };
+            const auto r = powm_impl(mont_mul(b, m_r2), m_one, exp, mont_mul);
+            // Convert back from the Montgomery representation.
+            return mont_mul(r, ::mp_limb_t(1));
+        }
+        const auto shift = m_shift;
+        const auto dnorm = m_dnorm, inv = m_inv;
+        return powm_impl(b, ::mp_limb_t(1), exp, [shift, dnorm, inv](::mp_limb_t x, ::mp_limb_t y) {
+            return detail::mod_context_mulm_preinv(x, y, shift, dnorm, inv);
+        });
+    }
+    // LCOV_EXCL_START
+    ::mp_limb_t powm_1(::mp_limb_t, const integer<SSize> &, const std::false_type &) const
+    {
+        assert(false);
+        return 0;
+    }
+    // LCOV_EXCL_STOP
+    // Left-to-right exponentiation with fixed windows of 4 bits,
+    // given the base b, the unit one and the multiplication function f.
+    // NOTE: if the modulus is 1, all the values are zero except
+    // possibly one, which is never returned unchanged as we always
+    // perform at least one multiplication.
+    template <typename F>
+    static ::mp_limb_t powm_impl(::mp_limb_t b, ::mp_limb_t one, const integer<SSize> &exp, const F &f)
+    {
+        // NOTE: exp might be dynamic, thus we go through the mpz view.
+        const auto v = exp.get_mpz_view();
+        const detail::mpz_struct_t *e = v;
+        const auto esize = static_cast<std::size_t>(e->_mp_size);
+        // Table of the powers of b from 0 to 15.
+        std::array<::mp_limb_t, 16> table;
+        table[0] = f(one, one);
+        for (std::size_t k = 1; k < 16u; ++k) {
+            table[k] = f(table[k - 1u], b);
+        }
+        if (!esize) {
+            return table[0];
+        }
+        const auto nbits = (esize - 1u) * unsigned(GMP_NUMB_BITS) + detail::limb_size_nbits(e->_mp_d[esize - 1u]);
+        auto r = table[0];
+        for (auto idx = nbits; idx > 0u;) {
+            unsigned w = 0;
+            for (unsigned k = 0; k < 4u && idx > 0u; ++k) {
+                --idx;
+                r = f(r, r);
+                w = (w << 1)
+                    | static_cast<unsigned>(
+                        (e->_mp_d[idx / unsigned(GMP_NUMB_BITS)] >> (idx % unsigned(GMP_NUMB_BITS))) & 1u);
+            }
+            r = f(r, table[w]);
+        }
+        return r;
+    }
+    // Load the limbs of n mod m into out, padding with zeroes up to m_nlimbs.
+    void load(limb_array &out, const integer<SSize> &n) const
+    {
+        if (mppp_likely(n.is_static())) {
+            const auto &st = n._get_union().g_st();
+            if (mppp_likely(st._mp_size >= 0 && static_cast<std::size_t>(st._mp_size) <= m_nlimbs)) {
+                const auto asize = static_cast<std::size_t>(st._mp_size);
+                // NOTE: plain loop instead of copy_limbs_no(), as the sizes
+                // involved are small.
+                for (std::size_t i = 0; i < m_nlimbs; ++i) {
+                    out[i] = i < asize ? st.m_limbs[i] : ::mp_limb_t(0);
+                }
+                if (asize < m_nlimbs || lt_mod(out)) {
+                    return;
+                }
+            }
+        }
+        load_reduce(out, n);
+    }
+    // Slow path of load(): n is not in the [0, m) range, reduce it.
+    void load_reduce(limb_array &out, const integer<SSize> &n) const
+    {
+        MPPP_MAYBE_TLS detail::mpz_raii tmp;
+        ::mpz_fdiv_r(&tmp.m_mpz, n.get_mpz_view(), m_mod.get_mpz_view());
+        const auto rsize = ::mpz_size(&tmp.m_mpz);
+        assert(rsize <= m_nlimbs);
+        detail::copy_limbs_no(tmp.m_mpz._mp_d, tmp.m_mpz._mp_d + rsize, out.data());
+        for (auto i = rsize; i < m_nlimbs; ++i) {
+            out[i] = 0;
+        }
+    }
+    // Check if x is less than the modulus.
+    bool lt_mod(const limb_array &x) const
+    {
+        for (auto i = m_nlimbs; i > 0u; --i) {
+            if (x[i - 1u] != m_limbs[i - 1u]) {
+                return x[i - 1u] < m_limbs[i - 1u];
+            }
+        }
+        return false;
+    }
+    // Write x into rop.
+    integer<SSize> &store(integer<SSize> &rop, const limb_array &x) const
+    {
+        if (mppp_unlikely(!rop.is_static())) {
+            rop.set_zero();
+        }
+        auto &st = rop._get_union().g_st();
+        auto size = m_nlimbs;
+        while (size && !(x[size - 1u] & GMP_NUMB_MASK)) {
+            --size;
+        }
+        const auto old_size = static_cast<std::size_t>(st.abs_size());
+        for (std::size_t i = 0; i < size; ++i) {
+            st.m_limbs[i] = x[i];
+        }
+        st._mp_size = static_cast<detail::mpz_size_t>(size);
+        if (old_size > size) {
+            // Zero the limbs of the old value, if needed.
+            st.zero_unused_limbs();
+        }
+        return rop;
+    }
+    // Multi-limb multiplication via the mpn functions. rop may
+    // overlap with op1 and/or op2.
+    void mulm_mpn(limb_array &rop, const limb_array &op1, const limb_array &op2) const
+    {
+        const auto n = static_cast<::mp_size_t>(m_nlimbs);
+        std::array<::mp_limb_t, SSize * 2u> prod, q;
+        if (&op1 == &op2) {
+            ::mpn_sqr(prod.data(), op1.data(), n);
+        } else {
+            ::mpn_mul_n(prod.data(), op1.data(), op2.data(), n);
+        }
+        ::mpn_tdiv_qr(q.data(), rop.data(), 0, prod.data(), 2 * n, m_limbs.data(), n);
+    }
+
+    integer<SSize> m_mod;
+    // The algorithm in use:
+    // - 0: dynamic modulus, mpz API,
+    // - 1: 1-limb modulus with double-limb primitives available,
+    // - 2: any other static modulus, mpn API.
+    int m_algo;
+    std::size_t m_nlimbs;
+    // The limbs of the modulus.
+    limb_array m_limbs;
+    // The normalisation shift, the normalised modulus
+    // and its reciprocal (algorithm 1).
+    unsigned m_shift;
+    ::mp_limb_t m_dnorm;
+    ::mp_limb_t m_inv;
+    // -m**-1 mod B, B**2 mod m and B mod m (algorithm 1 with an odd modulus).
+    ::mp_limb_t m_minv;
+    ::mp_limb_t m_r2;
+    ::mp_limb_t m_one;
+};
+
+#if !defined(MPPP_DOXYGEN_INVOKED)
+
+// Ternary modular multiplication.
+template <std::size_t SSize>
+inline integer<SSize> &mulm(integer<SSize> &rop, const integer<SSize> &a, const integer<SSize> &b,
+                            const mod_context<SSize> &ctx)
+{
+    return ctx.mulm(rop, a, b);
+}
+
+// Binary modular multiplication.
+template <std::size_t SSize>
+inline integer<SSize> mulm(const integer<SSize> &a, const integer<SSize> &b, const mod_context<SSize> &ctx)
+{
+    integer<SSize> retval;
+    ctx.mulm(retval, a, b);
+    return retval;
+}
+
+// Ternary modular squaring.
+template <std::size_t SSize>
+inline integer<SSize> &sqrm(integer<SSize> &rop, const integer<SSize> &a, const mod_context<SSize> &ctx)
+{
+    return ctx.sqrm(rop, a);
+}
+
+// Binary modular squaring.
+template <std::size_t SSize>
+inline integer<SSize> sqrm(const integer<SSize> &a, const mod_context<SSize> &ctx)
+{
+    integer<SSize> retval;
+    ctx.sqrm(retval, a);
+    return retval;
+}
+
+// Ternary modular exponentiation.
+template <std::size_t SSize>
+inline integer<SSize> &powm(integer<SSize> &rop, const integer<SSize> &base, const integer<SSize> &exp,
+                            const mod_context<SSize> &ctx)
+{
+    return ctx.powm(rop, base, exp);
+}
+
+// Binary modular exponentiation.
+template <std::size_t SSize>
+inline integer<SSize> powm(const integer<SSize> &base, const integer<SSize> &exp, const mod_context<SSize> &ctx)
+{
+    integer<SSize> retval;
+    ctx.powm(retval, base, exp);
+    return retval;
+}
+
+namespace batch
+{
+
+// Batched modular exponentiation.
+// NOTE: the ranges must either coincide or not overlap at all.
+template <std::size_t SSize>
+inline void powm(integer<SSize> *rop, const integer<SSize> *base, const integer<SSize> *exp, std::size_t n,
+                 const mod_context<SSize> &ctx)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        ctx.powm(rop[i], base[i], exp[i]);
+    }
+}
+
+// Batched modular exponentiation with a common exponent.
+template <std::size_t SSize>
+inline void powm(integer<SSize> *rop, const integer<SSize> *base, const integer<SSize> &exp, std::size_t n,
+                 const mod_context<SSize> &ctx)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        ctx.powm(rop[i], base[i], exp);
+    }
+}
+
+} // namespace batch
+
+#endif
+
+} // namespace mppp
+
+#endif
@@ -10,13 +10,29 @@
 #define MPPP_MPPP_HPP
 
 #include <mp++/config.hpp>
+#include <mp++/charconv.hpp>
 #include <mp++/exceptions.hpp>
 #include <mp++/integer.hpp>
+#include <mp++/integer_cview.hpp>
+#include <mp++/integer_soa.hpp>
+#include <mp++/memory.hpp>
+#include <mp++/mod_context.hpp>
+#include <mp++/parallel.hpp>
 #include <mp++/rational.hpp>
+#include <mp++/serialization.hpp>
 #include <mp++/type_name.hpp>
+#include <mp++/wide_uint.hpp>
 
 #if defined(MPPP_WITH_MPFR)
+#include <mp++/complex.hpp>
 #include <mp++/real.hpp>
+#include <mp++/real_eval.hpp>
+#include <mp++/real_expr.hpp>
+#include <mp++/real_fixed.hpp>
+#endif
+
+#if defined(MPPP_WITH_ARB)
+#include <mp++/real_ball.hpp>
 #endif
 
 #if defined(MPPP_WITH_QUADMATH)
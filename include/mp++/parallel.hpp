@@ -0,0 +1,285 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_PARALLEL_HPP
+#define MPPP_PARALLEL_HPP
+
+#include <mp++/config.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+namespace mppp
+{
+
+namespace detail
+{
+
+// Detect random-access iterators over integer or rational.
+template <typename It>
+using is_parallel_reduction_iterator = conjunction<
+    std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>,
+    disjunction<is_integer<typename std::iterator_traits<It>::value_type>,
+                is_rational<typename std::iterator_traits<It>::value_type>>>;
+
+template <typename It>
+using parallel_reduction_enabler = enable_if_t<is_parallel_reduction_iterator<It>::value, int>;
+
+// Establish the number of workers for a parallel reduction over n elements.
+inline unsigned parallel_nworkers(unsigned nthreads, std::size_t n)
+{
+    if (!nthreads) {
+        // NOTE: hardware_concurrency() may return zero if the value
+        // is not computable.
+        nthreads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    // Don't use more workers than elements (but always use at least one).
+    return static_cast<unsigned>(std::min(static_cast<std::size_t>(nthreads), std::max(n, std::size_t(1))));
+}
+
+// Split the range [0, n) into nw chunks, and compute f(begin, end) for each chunk in a separate
+// thread. The return values of f are returned in a vector. The first chunk is processed
+// by the calling thread.
+// NOTE: the mpz allocation cache is thread-local, thus each worker allocates/deallocates
+// limbs via its own cache without contention.
+template <typename T, typename F>
+inline std::vector<T> parallel_map_chunks(std::size_t n, unsigned nw, const F &f)
+{
+    assert(nw > 0u);
+    std::vector<T> retval(nw);
+    std::vector<std::exception_ptr> errors(nw);
+    const auto q = n / nw, r = n % nw;
+    auto worker = [&retval, &errors, &f, q, r](unsigned i) {
+        // NOTE: the first r chunks contain q + 1 elements, the others q elements.
+        const auto begin = static_cast<std::size_t>(i) * q + std::min(static_cast<std::size_t>(i), r),
+                   end = begin + q + static_cast<std::size_t>(i < r);
+        try {
+            retval[i] = f(begin, end);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(nw - 1u);
+    try {
+        for (unsigned i = 1; i < nw; ++i) {
+            threads.emplace_back(worker, i);
+        }
+        // LCOV_EXCL_START
+    } catch (...) {
+        // Thread creation failed: wait for the threads
+        // already created and rethrow.
+        for (auto &t : threads) {
+            t.join();
+        }
+        throw;
+    }
+    // LCOV_EXCL_STOP
+    worker(0);
+    for (auto &t : threads) {
+        t.join();
+    }
+    for (const auto &e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+    return retval;
+}
+
+// Combine in-place the values in v via the ternary function f, pairing
+// them in a balanced binary tree. The result is returned.
+template <typename T, typename F>
+inline T parallel_tree_reduce(std::vector<T> &v, const F &f)
+{
+    assert(!v.empty());
+    for (std::size_t stride = 1; stride < v.size(); stride *= 2u) {
+        for (std::size_t i = 0; i + stride < v.size(); i += 2u * stride) {
+            f(v[i], v[i], v[i + stride]);
+        }
+    }
+    return std::move(v[0]);
+}
+
+// Product of the n values starting at first via a balanced product tree.
+template <typename T, typename It>
+inline T product_tree(It first, std::size_t n)
+{
+    if (n == 0u) {
+        return T{1};
+    }
+    if (n == 1u) {
+        return *first;
+    }
+    const auto h = n / 2u;
+    auto retval = product_tree<T>(first, h);
+    mul(retval, retval, product_tree<T>(first + static_cast<typename std::iterator_traits<It>::difference_type>(h), n - h));
+    return retval;
+}
+
+// Sequential dot product for a chunk of integers or rationals.
+template <typename It1, typename It2, std::size_t SSize>
+inline integer<SSize> parallel_dot_chunk(It1 first1, It1 last1, It2 first2, const integer<SSize> &)
+{
+    return dot(first1, last1, first2, integer<SSize>{});
+}
+
+template <typename It1, typename It2, std::size_t SSize>
+inline rational<SSize> parallel_dot_chunk(It1 first1, It1 last1, It2 first2, const rational<SSize> &)
+{
+    rational<SSize> retval, tmp;
+    for (; first1 != last1; ++first1, ++first2) {
+        mul(tmp, *first1, *first2);
+        add(retval, retval, tmp);
+    }
+    return retval;
+}
+
+} // namespace detail
+
+/** @defgroup parallel_reductions parallel_reductions
+ *  @{
+ */
+
+/// Parallel sum.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * This function will compute the sum of the :cpp:class:`~mppp::integer` or :cpp:class:`~mppp::rational`
+ * values in the range :math:`\left[ first, last \right)`. The range is split in ``nthreads`` chunks of
+ * roughly equal size, the partial sums of the chunks are computed in separate threads, and they are then
+ * combined in a balanced binary tree. If ``nthreads`` is zero, the value returned by
+ * ``std::thread::hardware_concurrency()`` will be used instead.
+ *
+ * Each thread uses its own (thread-local) cache for the allocation of multiprecision values.
+ * \endrststar
+ *
+ * @param first the beginning of the range.
+ * @param last the end of the range.
+ * @param nthreads the number of threads to be used.
+ *
+ * @return the sum of the values in the input range (zero if the range is empty).
+ *
+ * @throws unspecified any exception thrown by the creation of threads or by the arithmetic
+ * operations (exceptions thrown in worker threads are propagated to the calling thread).
+ */
+template <typename It, detail::parallel_reduction_enabler<It> = 0>
+inline typename std::iterator_traits<It>::value_type parallel_sum(It first, It last, unsigned nthreads = 0)
+{
+    using value_t = typename std::iterator_traits<It>::value_type;
+    using diff_t = typename std::iterator_traits<It>::difference_type;
+    assert(last >= first);
+    const auto n = static_cast<std::size_t>(last - first);
+    auto partials = detail::parallel_map_chunks<value_t>(
+        n, detail::parallel_nworkers(nthreads, n), [first](std::size_t begin, std::size_t end) {
+            value_t retval;
+            for (auto it = first + static_cast<diff_t>(begin); it != first + static_cast<diff_t>(end); ++it) {
+                add(retval, retval, *it);
+            }
+            return retval;
+        });
+    return detail::parallel_tree_reduce(partials,
+                                        [](value_t &rop, const value_t &a, const value_t &b) { add(rop, a, b); });
+}
+
+/// Parallel dot product.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * This function will compute the dot product of the :cpp:class:`~mppp::integer` or :cpp:class:`~mppp::rational`
+ * values in the range :math:`\left[ first1, last1 \right)` with the values in the range starting at ``first2``.
+ * The computation is split across ``nthreads`` threads as explained in :cpp:func:`~mppp::parallel_sum()`.
+ * For :cpp:class:`~mppp::integer`, the partial dot products are computed via :cpp:func:`mppp::dot()`.
+ * \endrststar
+ *
+ * @param first1 the beginning of the first range.
+ * @param last1 the end of the first range.
+ * @param first2 the beginning of the second range.
+ * @param nthreads the number of threads to be used.
+ *
+ * @return the dot product of the input ranges (zero if the ranges are empty).
+ *
+ * @throws unspecified any exception thrown by the creation of threads or by the arithmetic
+ * operations (exceptions thrown in worker threads are propagated to the calling thread).
+ */
+template <typename It1, typename It2, detail::parallel_reduction_enabler<It1> = 0,
+          detail::enable_if_t<std::is_same<typename std::iterator_traits<It1>::value_type,
+                                           typename std::iterator_traits<It2>::value_type>::value,
+                              int> = 0,
+          detail::parallel_reduction_enabler<It2> = 0>
+inline typename std::iterator_traits<It1>::value_type parallel_dot(It1 first1, It1 last1, It2 first2,
+                                                                   unsigned nthreads = 0)
+{
+    using value_t = typename std::iterator_traits<It1>::value_type;
+    using diff1_t = typename std::iterator_traits<It1>::difference_type;
+    using diff2_t = typename std::iterator_traits<It2>::difference_type;
+    assert(last1 >= first1);
+    const auto n = static_cast<std::size_t>(last1 - first1);
+    auto partials = detail::parallel_map_chunks<value_t>(
+        n, detail::parallel_nworkers(nthreads, n), [first1, first2](std::size_t begin, std::size_t end) {
+            return detail::parallel_dot_chunk(first1 + static_cast<diff1_t>(begin), first1 + static_cast<diff1_t>(end),
+                                              first2 + static_cast<diff2_t>(begin), value_t{});
+        });
+    return detail::parallel_tree_reduce(partials,
+                                        [](value_t &rop, const value_t &a, const value_t &b) { add(rop, a, b); });
+}
+
+/// Parallel product.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * This function will compute the product of the :cpp:class:`~mppp::integer` or :cpp:class:`~mppp::rational`
+ * values in the range :math:`\left[ first, last \right)`. The computation is split across ``nthreads`` threads
+ * as explained in :cpp:func:`~mppp::parallel_sum()`. Both the partial products and their combination
+ * are computed via balanced product trees, so that the multiplications operate on operands of similar size
+ * (which allows GMP to use its subquadratic algorithms when the operands are large).
+ * \endrststar
+ *
+ * @param first the beginning of the range.
+ * @param last the end of the range.
+ * @param nthreads the number of threads to be used.
+ *
+ * @return the product of the values in the input range (one if the range is empty).
+ *
+ * @throws unspecified any exception thrown by the creation of threads or by the arithmetic
+ * operations (exceptions thrown in worker threads are propagated to the calling thread).
+ */
+template <typename It, detail::parallel_reduction_enabler<It> = 0>
+inline typename std::iterator_traits<It>::value_type parallel_product(It first, It last, unsigned nthreads = 0)
+{
+    using value_t = typename std::iterator_traits<It>::value_type;
+    using diff_t = typename std::iterator_traits<It>::difference_type;
+    assert(last >= first);
+    const auto n = static_cast<std::size_t>(last - first);
+    auto partials = detail::parallel_map_chunks<value_t>(
+        n, detail::parallel_nworkers(nthreads, n), [first](std::size_t begin, std::size_t end) {
+            return detail::product_tree<value_t>(first + static_cast<diff_t>(begin), end - begin);
+        });
+    return detail::parallel_tree_reduce(partials,
+                                        [](value_t &rop, const value_t &a, const value_t &b) { mul(rop, a, b); });
+}
+
+/** @} */
+
+} // namespace mppp
+
+#endif
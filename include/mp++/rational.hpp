@@ -21,6 +21,7 @@
 #include <limits>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -29,6 +30,7 @@
 #include <string_view>
 #endif
 
+#include <mp++/charconv.hpp>
 #include <mp++/concepts.hpp>
 #include <mp++/detail/fwd_decl.hpp>
 #include <mp++/detail/gmp.hpp>
@@ -1662,6 +1664,50 @@ inline std::ostream &operator<<(std::ostream &os, const rational<SSize> &q)
                                                  q.get_den().is_one());
 }
 
+// Write the representation of q into [first, last).
+template <std::size_t SSize>
+inline to_chars_result to_chars(char *first, char *last, const rational<SSize> &q, int base = 10)
+{
+    const auto ret = to_chars(first, last, q.get_num(), base);
+    if (ret.ec != std::errc{} || q.get_den().is_one()) {
+        return ret;
+    }
+    if (ret.ptr == last) {
+        return {last, std::errc::value_too_large};
+    }
+    *ret.ptr = '/';
+    return to_chars(ret.ptr + 1, last, q.get_den(), base);
+}
+
+// Parse the rational at the beginning of [first, last) into q.
+template <std::size_t SSize>
+inline from_chars_result from_chars(const char *first, const char *last, rational<SSize> &q, int base = 10)
+{
+    integer<SSize> num, den{1};
+    auto ret = from_chars(first, last, num, base);
+    if (ret.ec != std::errc{}) {
+        return ret;
+    }
+    // NOTE: the denominator, if present, must be a nonnegative integer. If the
+    // division operator is not followed by a valid denominator, it is not
+    // considered part of the representation.
+    if (ret.ptr != last && *ret.ptr == '/' && ret.ptr + 1 != last && ret.ptr[1] != '-') {
+        const auto dret = from_chars(ret.ptr + 1, last, den, base);
+        if (dret.ec == std::errc{}) {
+            if (mppp_unlikely(den.is_zero())) {
+                return {first, std::errc::invalid_argument};
+            }
+            ret.ptr = dret.ptr;
+        }
+    }
+    swap(q._get_num(), num);
+    swap(q._get_den(), den);
+    if (!q.get_den().is_one()) {
+        q.canonicalise();
+    }
+    return ret;
+}
+
 /** @defgroup rational_operators rational_operators
  *  @{
  */
@@ -14,6 +14,7 @@
 #if defined(MPPP_WITH_MPFR)
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cassert>
 #include <cmath>
@@ -31,6 +32,7 @@
 #include <string_view>
 #endif
 
+#include <mp++/charconv.hpp>
 #include <mp++/concepts.hpp>
 #include <mp++/detail/fwd_decl.hpp>
 #include <mp++/detail/gmp.hpp>
@@ -39,6 +41,7 @@
 #include <mp++/detail/utils.hpp>
 #include <mp++/detail/visibility.hpp>
 #include <mp++/integer.hpp>
+#include <mp++/memory.hpp>
 #include <mp++/rational.hpp>
 #include <mp++/type_name.hpp>
 
@@ -62,6 +65,71 @@ constexpr ::mpfr_prec_t clamp_mpfr_prec(::mpfr_prec_t p)
 // Helper function to print an mpfr to stream in a given base.
 MPPP_DLL_PUBLIC void mpfr_to_stream(const ::mpfr_t, std::ostream &, int);
 
+// Structure for caching the significands of low-precision mpfr_t objects.
+// NOTE: needs to be public for testing purposes.
+// NOTE: the cached significands are grouped in size classes by number of limbs
+// (the class i contains significands of i + 1 limbs). The significands are allocated
+// and reallocated exclusively by MPFR: a cached significand is reused via mpfr_set_prec(),
+// which does not reallocate the significand if the new precision does not need more limbs.
+// Each class is a singly-linked list, whose links are stored in the cached significands themselves.
+struct MPPP_DLL_PUBLIC mpfr_alloc_cache {
+    // Largest number of limbs of a cached significand.
+    static constexpr std::size_t max_size = 8;
+    // Largest number of significands in each size class.
+    static constexpr std::size_t max_entries = 100;
+    // The heads of the lists of cached significands.
+    std::array<::mp_limb_t *, max_size> heads;
+    // The number of significands actually stored in each size class.
+    std::array<std::size_t, max_size> sizes;
+    // NOTE: use round brackets init for the usual GCC 4.8 workaround.
+    constexpr mpfr_alloc_cache() : heads(), sizes() {}
+    // Try to init m with precision p and a significand fetched from the cache.
+    // Returns false if no suitable significand is available.
+    bool get(mpfr_struct_t &m, ::mpfr_prec_t p) noexcept;
+    // Try to store the significand of m into the cache. Returns false if the
+    // significand could not be stored.
+    bool put(mpfr_struct_t &m) noexcept;
+    // Clear the cache, deallocating all the significands.
+    void clear() noexcept;
+    ~mpfr_alloc_cache()
+    {
+        clear();
+    }
+};
+
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+
+// Get a reference to the thread-local mpfr allocation
+// cache. Used only for debugging.
+MPPP_DLL_PUBLIC mpfr_alloc_cache &get_thread_local_mpfr_cache();
+
+#endif
+
+// Init an mpfr_t with the given precision, taking the storage
+// for the significand from the active memory resource (if any)
+// or from the thread-local cache.
+MPPP_DLL_PUBLIC void mpfr_init2_wrap(::mpfr_t, ::mpfr_prec_t);
+
+// Clear an mpfr_t, returning the significand to its memory resource
+// or, if possible, to the thread-local cache.
+MPPP_DLL_PUBLIC void mpfr_clear_wrap(mpfr_struct_t &);
+
+// Wrappers for mpfr_set_prec() and mpfr_prec_round() (with MPFR_RNDN), which
+// reallocate the significands taken from a memory resource in the same resource.
+MPPP_DLL_PUBLIC void mpfr_set_prec_wrap(mpfr_struct_t &, ::mpfr_prec_t);
+MPPP_DLL_PUBLIC void mpfr_prec_round_wrap(mpfr_struct_t &, ::mpfr_prec_t);
+
+// Get the memory resource from which the significand of an mpfr_t
+// was taken (null if the significand was allocated by MPFR).
+MPPP_DLL_PUBLIC memory_resource *mpfr_get_resource(const mpfr_struct_t &);
+
+#if defined(MPPP_WITH_QUADMATH)
+
+// Set an mpfr_t to the value of a real128, rounding to the precision of the mpfr_t.
+MPPP_DLL_PUBLIC void mpfr_set_real128(::mpfr_t, const real128 &);
+
+#endif
+
 #if !defined(MPPP_DOXYGEN_INVOKED)
 
 // Helpers to deduce the precision when constructing/assigning a real via another type.
@@ -532,7 +600,7 @@ private:
     template <typename T>
     void dispatch_integral_init(::mpfr_prec_t p, const T &n)
     {
-        ::mpfr_init2(&m_mpfr, compute_init_precision(p, n));
+        detail::mpfr_init2_wrap(&m_mpfr, compute_init_precision(p, n));
     }
     // Special casing for bool, otherwise MSVC warns if we fold this into the
     // constructor from unsigned.
@@ -952,7 +1020,7 @@ public:
     real &operator=(::mpfr_t &&x)
     {
         // Clear this.
-        ::mpfr_clear(&m_mpfr);
+        detail::mpfr_clear_wrap(m_mpfr);
         // Shallow copy x.
         m_mpfr = *x;
         return *this;
@@ -1247,13 +1315,13 @@ private:
     template <bool Check>
     void set_prec_impl(::mpfr_prec_t p)
     {
-        ::mpfr_set_prec(&m_mpfr, Check ? check_set_prec(p) : p);
+        detail::mpfr_set_prec_wrap(m_mpfr, Check ? check_set_prec(p) : p);
     }
     // mpfr_prec_round() wrapper, with or without prec checking.
     template <bool Check>
     void prec_round_impl(::mpfr_prec_t p)
     {
-        ::mpfr_prec_round(&m_mpfr, Check ? check_set_prec(p) : p, MPFR_RNDN);
+        detail::mpfr_prec_round_wrap(m_mpfr, Check ? check_set_prec(p) : p);
     }
 
 public:
@@ -1741,6 +1809,15 @@ private:
 // Double check that real is a standard layout class.
 static_assert(std::is_standard_layout<real>::value, "real is not a standard layout class.");
 
+namespace detail
+{
+
+// Create a real whose storage is taken from the heap, regardless of the active memory
+// resources. Used for the thread-local temporaries, which outlive the scopes.
+MPPP_DLL_PUBLIC real make_heap_real();
+
+} // namespace detail
+
 template <typename T, typename U>
 using are_real_op_types = detail::disjunction<
     detail::conjunction<std::is_same<real, detail::uncvref_t<T>>, std::is_same<real, detail::uncvref_t<U>>>,
@@ -2626,7 +2703,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<std::is_same<real, uncvref_t<T>>, is_real_interoperable<U>>::value, int> = 0>
 inline real dispatch_pow(T &&a, const U &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_pow(std::forward<T>(a), tmp);
 }
@@ -2635,7 +2712,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<is_real_interoperable<T>, std::is_same<real, uncvref_t<U>>>::value, int> = 0>
 inline real dispatch_pow(const T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_pow(tmp, std::forward<U>(a));
 }
@@ -2758,7 +2835,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<std::is_same<real, uncvref_t<T>>, is_real_interoperable<U>>::value, int> = 0>
 inline real dispatch_atan2(T &&a, const U &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_atan2(std::forward<T>(a), tmp);
 }
@@ -2767,7 +2844,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<is_real_interoperable<T>, std::is_same<real, uncvref_t<U>>>::value, int> = 0>
 inline real dispatch_atan2(const T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_atan2(tmp, std::forward<U>(a));
 }
@@ -2914,7 +2991,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<std::is_same<real, uncvref_t<T>>, is_real_interoperable<U>>::value, int> = 0>
 inline real dispatch_gamma_inc(T &&a, const U &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_gamma_inc(std::forward<T>(a), tmp);
 }
@@ -2923,7 +3000,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<is_real_interoperable<T>, std::is_same<real, uncvref_t<U>>>::value, int> = 0>
 inline real dispatch_gamma_inc(const T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_gamma_inc(tmp, std::forward<U>(a));
 }
@@ -3055,7 +3132,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<std::is_same<real, uncvref_t<T>>, is_real_interoperable<U>>::value, int> = 0>
 inline real dispatch_beta(T &&a, const U &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_beta(std::forward<T>(a), tmp);
 }
@@ -3064,7 +3141,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<is_real_interoperable<T>, std::is_same<real, uncvref_t<U>>>::value, int> = 0>
 inline real dispatch_beta(const T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_beta(tmp, std::forward<U>(a));
 }
@@ -3113,7 +3190,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<std::is_same<real, uncvref_t<T>>, is_real_interoperable<U>>::value, int> = 0>
 inline real dispatch_hypot(T &&a, const U &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_hypot(std::forward<T>(a), tmp);
 }
@@ -3122,7 +3199,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<is_real_interoperable<T>, std::is_same<real, uncvref_t<U>>>::value, int> = 0>
 inline real dispatch_hypot(const T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_hypot(tmp, std::forward<U>(a));
 }
@@ -3171,7 +3248,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<std::is_same<real, uncvref_t<T>>, is_real_interoperable<U>>::value, int> = 0>
 inline real dispatch_log_hypot(T &&a, const U &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_log_hypot(std::forward<T>(a), tmp);
 }
@@ -3180,7 +3257,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<is_real_interoperable<T>, std::is_same<real, uncvref_t<U>>>::value, int> = 0>
 inline real dispatch_log_hypot(const T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_log_hypot(tmp, std::forward<U>(a));
 }
@@ -3199,6 +3276,21 @@ template <typename T, typename U, real_op_types_enabler<T, U> = 0>
     return detail::dispatch_log_hypot(std::forward<T>(x), std::forward<U>(y));
 }
 
+// Batched Arb functions.
+namespace batch
+{
+
+MPPP_DLL_PUBLIC void sqrt1pm1(real *, const real *, std::size_t);
+MPPP_DLL_PUBLIC void sin_pi(real *, const real *, std::size_t);
+MPPP_DLL_PUBLIC void cos_pi(real *, const real *, std::size_t);
+MPPP_DLL_PUBLIC void tan_pi(real *, const real *, std::size_t);
+MPPP_DLL_PUBLIC void cot_pi(real *, const real *, std::size_t);
+MPPP_DLL_PUBLIC void sinc(real *, const real *, std::size_t);
+MPPP_DLL_PUBLIC void sinc_pi(real *, const real *, std::size_t);
+MPPP_DLL_PUBLIC void log_hypot(real *, const real *, const real *, std::size_t);
+
+} // namespace batch
+
 #endif
 
 // Ternary agm.
@@ -3226,7 +3318,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<std::is_same<real, uncvref_t<T>>, is_real_interoperable<U>>::value, int> = 0>
 inline real dispatch_agm(T &&a, const U &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_agm(std::forward<T>(a), tmp);
 }
@@ -3235,7 +3327,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<is_real_interoperable<T>, std::is_same<real, uncvref_t<U>>>::value, int> = 0>
 inline real dispatch_agm(const T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_agm(tmp, std::forward<U>(a));
 }
@@ -3279,6 +3371,12 @@ inline real agm(T &&x, U &&y)
 // Output stream operator.
 MPPP_DLL_PUBLIC std::ostream &operator<<(std::ostream &, const real &);
 
+// Write the representation of r in base base into [first, last).
+MPPP_DLL_PUBLIC to_chars_result to_chars(char *, char *, const real &, int = 10);
+
+// Parse the real at the beginning of [first, last) in base base into r.
+MPPP_DLL_PUBLIC from_chars_result from_chars(const char *, const char *, real &, int = 10);
+
 /** @} */
 
 /** @defgroup real_constants real_constants
@@ -3306,6 +3404,101 @@ MPPP_DLL_PUBLIC real real_pi(::mpfr_prec_t p = 0);
 
 MPPP_DLL_PUBLIC real &real_pi(real &);
 
+/// \link mppp::real Real\endlink \f$\log 2\f$ constant.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * This function will return a :cpp:class:`~mppp::real` :math:`\log 2`
+ * with a precision of ``p``. If ``p`` is zero, the precision
+ * will be set to the value returned by :cpp:func:`~mppp::real_get_default_prec()`.
+ * If ``p`` is zero and no default precision has been set, an error will be raised.
+ * \endrststar
+ *
+ * @param p the desired precision.
+ *
+ * @return a \link mppp::real real\endlink \f$\log 2\f$.
+ *
+ * @throws std::invalid_argument if \p p is not within the bounds established by
+ * \link mppp::real_prec_min() real_prec_min()\endlink and \link mppp::real_prec_max() real_prec_max()\endlink,
+ * or if \p p is zero but no default precision has been set.
+ */
+MPPP_DLL_PUBLIC real real_log2(::mpfr_prec_t p = 0);
+
+MPPP_DLL_PUBLIC real &real_log2(real &);
+
+/// \link mppp::real Real\endlink Euler-Mascheroni constant.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * This function will return the Euler-Mascheroni constant :math:`\gamma` as a :cpp:class:`~mppp::real`
+ * with a precision of ``p``. If ``p`` is zero, the precision
+ * will be set to the value returned by :cpp:func:`~mppp::real_get_default_prec()`.
+ * If ``p`` is zero and no default precision has been set, an error will be raised.
+ * \endrststar
+ *
+ * @param p the desired precision.
+ *
+ * @return a \link mppp::real real\endlink \f$\gamma\f$.
+ *
+ * @throws std::invalid_argument if \p p is not within the bounds established by
+ * \link mppp::real_prec_min() real_prec_min()\endlink and \link mppp::real_prec_max() real_prec_max()\endlink,
+ * or if \p p is zero but no default precision has been set.
+ */
+MPPP_DLL_PUBLIC real real_euler(::mpfr_prec_t p = 0);
+
+MPPP_DLL_PUBLIC real &real_euler(real &);
+
+/// \link mppp::real Real\endlink Catalan constant.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * This function will return Catalan's constant :math:`G` as a :cpp:class:`~mppp::real`
+ * with a precision of ``p``. If ``p`` is zero, the precision
+ * will be set to the value returned by :cpp:func:`~mppp::real_get_default_prec()`.
+ * If ``p`` is zero and no default precision has been set, an error will be raised.
+ * \endrststar
+ *
+ * @param p the desired precision.
+ *
+ * @return a \link mppp::real real\endlink \f$G\f$.
+ *
+ * @throws std::invalid_argument if \p p is not within the bounds established by
+ * \link mppp::real_prec_min() real_prec_min()\endlink and \link mppp::real_prec_max() real_prec_max()\endlink,
+ * or if \p p is zero but no default precision has been set.
+ */
+MPPP_DLL_PUBLIC real real_catalan(::mpfr_prec_t p = 0);
+
+MPPP_DLL_PUBLIC real &real_catalan(real &);
+
+/// Precompute the \link mppp::real real\endlink constants.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * The values of the :cpp:class:`~mppp::real` constants (:math:`\pi`, :math:`\log 2`,
+ * :math:`\gamma` and :math:`G`) are stored in a cache shared by all threads, which contains
+ * each constant at the highest precision computed so far. Requests for a lower precision
+ * are then served by (correctly) rounding the cached value, rather than by recomputing
+ * the constant from scratch.
+ *
+ * This function will compute all the constants with a precision of ``p`` and store them
+ * in the cache, so that later requests up to precision ``p`` will not incur in
+ * any computation (e.g., in a latency-sensitive code path).
+ * If ``p`` is zero, the precision will be set to the value returned by
+ * :cpp:func:`~mppp::real_get_default_prec()`.
+ * \endrststar
+ *
+ * @param p the desired precision.
+ *
+ * @throws std::invalid_argument if \p p is not within the bounds established by
+ * \link mppp::real_prec_min() real_prec_min()\endlink and \link mppp::real_prec_max() real_prec_max()\endlink,
+ * or if \p p is zero but no default precision has been set.
+ */
+MPPP_DLL_PUBLIC void real_warm_up_constants(::mpfr_prec_t p = 0);
+
 /** @} */
 
 /** @defgroup real_intrem real_intrem
@@ -3410,7 +3603,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<std::is_same<real, uncvref_t<T>>, is_real_interoperable<U>>::value, int> = 0>
 inline real dispatch_binary_add(T &&a, const U &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_binary_add(std::forward<T>(a), tmp);
 }
@@ -3419,7 +3612,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<is_real_interoperable<T>, std::is_same<real, uncvref_t<U>>>::value, int> = 0>
 inline real dispatch_binary_add(const T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_binary_add(tmp, std::forward<U>(a));
 }
@@ -3469,7 +3662,7 @@ inline void dispatch_in_place_add(T &a, U &&b)
 template <typename T, enable_if_t<is_real_interoperable<T>::value, int> = 0>
 inline void dispatch_in_place_add(real &a, const T &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     dispatch_in_place_add(a, tmp);
 }
@@ -3487,7 +3680,7 @@ template <typename T, typename U,
                       int> = 0>
 inline void dispatch_in_place_add(T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     dispatch_in_place_add(tmp, std::forward<U>(a));
     x = static_cast<T>(tmp);
@@ -3524,7 +3717,7 @@ template <typename T, typename U,
                       int> = 0>
 inline void dispatch_in_place_add(T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     dispatch_in_place_add(tmp, std::forward<U>(a));
     real_in_place_convert(x, tmp, a, "addition");
@@ -3635,7 +3828,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<std::is_same<real, uncvref_t<T>>, is_real_interoperable<U>>::value, int> = 0>
 inline real dispatch_binary_sub(T &&a, const U &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_binary_sub(std::forward<T>(a), tmp);
 }
@@ -3644,7 +3837,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<is_real_interoperable<T>, std::is_same<real, uncvref_t<U>>>::value, int> = 0>
 inline real dispatch_binary_sub(const T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_binary_sub(tmp, std::forward<U>(a));
 }
@@ -3694,7 +3887,7 @@ inline void dispatch_in_place_sub(T &a, U &&b)
 template <typename T, enable_if_t<is_real_interoperable<T>::value, int> = 0>
 inline void dispatch_in_place_sub(real &a, const T &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     dispatch_in_place_sub(a, tmp);
 }
@@ -3710,7 +3903,7 @@ template <typename T, typename U,
                       int> = 0>
 inline void dispatch_in_place_sub(T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     dispatch_in_place_sub(tmp, std::forward<U>(a));
     x = static_cast<T>(tmp);
@@ -3721,7 +3914,7 @@ template <typename T, typename U,
                       int> = 0>
 inline void dispatch_in_place_sub(T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     dispatch_in_place_sub(tmp, std::forward<U>(a));
     real_in_place_convert(x, tmp, a, "subtraction");
@@ -3782,7 +3975,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<std::is_same<real, uncvref_t<T>>, is_real_interoperable<U>>::value, int> = 0>
 inline real dispatch_binary_mul(T &&a, const U &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_binary_mul(std::forward<T>(a), tmp);
 }
@@ -3791,7 +3984,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<is_real_interoperable<T>, std::is_same<real, uncvref_t<U>>>::value, int> = 0>
 inline real dispatch_binary_mul(const T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_binary_mul(tmp, std::forward<U>(a));
 }
@@ -3869,7 +4062,7 @@ inline void dispatch_in_place_mul(T &a, U &&b)
 template <typename T, enable_if_t<is_real_interoperable<T>::value, int> = 0>
 inline void dispatch_in_place_mul(real &a, const T &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     dispatch_in_place_mul(a, tmp);
 }
@@ -3885,7 +4078,7 @@ template <typename T, typename U,
                       int> = 0>
 inline void dispatch_in_place_mul(T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     dispatch_in_place_mul(tmp, std::forward<U>(a));
     x = static_cast<T>(tmp);
@@ -3896,7 +4089,7 @@ template <typename T, typename U,
                       int> = 0>
 inline void dispatch_in_place_mul(T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     dispatch_in_place_mul(tmp, std::forward<U>(a));
     real_in_place_convert(x, tmp, a, "multiplication");
@@ -3957,7 +4150,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<std::is_same<real, uncvref_t<T>>, is_real_interoperable<U>>::value, int> = 0>
 inline real dispatch_binary_div(T &&a, const U &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_binary_div(std::forward<T>(a), tmp);
 }
@@ -3966,7 +4159,7 @@ template <typename T, typename U,
           enable_if_t<conjunction<is_real_interoperable<T>, std::is_same<real, uncvref_t<U>>>::value, int> = 0>
 inline real dispatch_binary_div(const T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return dispatch_binary_div(tmp, std::forward<U>(a));
 }
@@ -4015,7 +4208,7 @@ inline void dispatch_in_place_div(T &a, U &&b)
 template <typename T, enable_if_t<is_real_interoperable<T>::value, int> = 0>
 inline void dispatch_in_place_div(real &a, const T &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     dispatch_in_place_div(a, tmp);
 }
@@ -4031,7 +4224,7 @@ template <typename T, typename U,
                       int> = 0>
 inline void dispatch_in_place_div(T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     dispatch_in_place_div(tmp, std::forward<U>(a));
     x = static_cast<T>(tmp);
@@ -4042,7 +4235,7 @@ template <typename T, typename U,
                       int> = 0>
 inline void dispatch_in_place_div(T &x, U &&a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     dispatch_in_place_div(tmp, std::forward<U>(a));
     real_in_place_convert(x, tmp, a, "division");
@@ -4096,7 +4289,7 @@ namespace detail
 template <typename F, typename T, enable_if_t<is_real_interoperable<T>::value, int> = 0>
 inline bool dispatch_real_comparison(const F &f, const real &a, const T &x)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return f(a.get_mpfr_t(), tmp.get_mpfr_t()) != 0;
 }
@@ -4104,7 +4297,7 @@ inline bool dispatch_real_comparison(const F &f, const real &a, const T &x)
 template <typename F, typename T, enable_if_t<is_real_interoperable<T>::value, int> = 0>
 inline bool dispatch_real_comparison(const F &f, const T &x, const real &a)
 {
-    MPPP_MAYBE_TLS real tmp;
+    MPPP_MAYBE_TLS real tmp = detail::make_heap_real();
     tmp = x;
     return f(tmp.get_mpfr_t(), a.get_mpfr_t()) != 0;
 }
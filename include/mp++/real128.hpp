@@ -17,6 +17,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <ostream>
@@ -30,6 +31,7 @@
 #include <string_view>
 #endif
 
+#include <mp++/charconv.hpp>
 #include <mp++/concepts.hpp>
 #include <mp++/detail/gmp.hpp>
 #include <mp++/detail/type_traits.hpp>
@@ -681,6 +683,12 @@ inline real128 scalbln(const real128 &x, long n)
 // Output stream operator.
 MPPP_DLL_PUBLIC std::ostream &operator<<(std::ostream &, const real128 &);
 
+// Write the representation of x into [first, last).
+MPPP_DLL_PUBLIC to_chars_result to_chars(char *, char *, const real128 &);
+
+// Parse the real128 at the beginning of [first, last) into x.
+MPPP_DLL_PUBLIC from_chars_result from_chars(const char *, const char *, real128 &);
+
 // Sign bit.
 inline bool signbit(const real128 &x)
 {
@@ -892,6 +900,33 @@ inline real128 erf(real128 x)
 // Next real128 from 'from' to 'to'.
 MPPP_DLL_PUBLIC real128 nextafter(const real128 &, const real128 &);
 
+// Batched functions.
+namespace batch
+{
+
+MPPP_DLL_PUBLIC void sqrt(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void cbrt(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void sin(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void cos(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void tan(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void asin(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void acos(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void atan(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void sinh(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void cosh(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void tanh(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void asinh(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void acosh(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void atanh(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void exp(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void log(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void log10(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void log2(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void lgamma(real128 *, const real128 *, std::size_t);
+MPPP_DLL_PUBLIC void erf(real128 *, const real128 *, std::size_t);
+
+} // namespace batch
+
 // Identity operator.
 constexpr real128 operator+(real128 x)
 {
@@ -0,0 +1,678 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_REAL_BALL_HPP
+#define MPPP_REAL_BALL_HPP
+
+#include <mp++/config.hpp>
+
+#if defined(MPPP_WITH_ARB)
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#if defined(MPPP_HAVE_STRING_VIEW)
+#include <string_view>
+#endif
+
+#include <mp++/concepts.hpp>
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/detail/visibility.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+#include <mp++/real.hpp>
+
+namespace mppp
+{
+
+namespace detail
+{
+
+// Implementation details of real_ball
+// (defined in the source file).
+struct real_ball_ops;
+
+// The precision of the radius of a real_ball. This is
+// the precision of the radius of an Arb ball.
+constexpr ::mpfr_prec_t real_ball_rad_prec = 30;
+
+// Deduce the precision of a real_ball from x. The result
+// is at least 2, which is the minimum precision supported by Arb.
+template <typename T>
+inline ::mpfr_prec_t real_ball_deduce_precision(const T &x)
+{
+    const auto p = clamp_mpfr_prec(real_deduce_precision(x));
+    return p < 2 ? 2 : p;
+}
+
+} // namespace detail
+
+template <typename T>
+using is_real_ball_interoperable = detail::disjunction<std::is_same<T, real>, is_real_interoperable<T>>;
+
+template <typename T>
+#if defined(MPPP_HAVE_CONCEPTS)
+MPPP_CONCEPT_DECL RealBallInteroperable = is_real_ball_interoperable<T>::value;
+#else
+using real_ball_interoperable_enabler = detail::enable_if_t<is_real_ball_interoperable<T>::value, int>;
+#endif
+
+/// Multiprecision ball class.
+/**
+ * \rststar
+ * *#include <mp++/real_ball.hpp>*
+ *
+ * .. versionadded:: 0.20
+ *
+ * .. note::
+ *
+ *    This class is available only if mp++ was
+ *    configured with the ``MPPP_WITH_ARB`` option enabled.
+ *
+ * This class represents a real number via a ball, that is, an interval :math:`\left[m - r, m + r\right]`
+ * defined by a midpoint :math:`m` and a radius :math:`r`. The midpoint is a :cpp:class:`~mppp::real`,
+ * while the radius is a non-negative :cpp:class:`~mppp::real` with a fixed precision of 30 bits.
+ * The precision of a ball is the precision of its midpoint.
+ *
+ * All the operations on balls are implemented via `Arb <https://arblib.org/>`__,
+ * and they guarantee that the resulting ball contains the exact result of the operation
+ * for every choice of the values of the operands within their balls. A single evaluation
+ * of an expression thus yields the result together with a rigorous error bound, and
+ * :cpp:func:`~mppp::real_ball::rel_accuracy_bits()` can then be used to establish
+ * whether or not the precision of the computation was high enough.
+ *
+ * The arithmetic operators and the functions return balls with a precision equal to the highest precision
+ * among the operands. Operands of type :cpp:class:`~mppp::real`, and of any type supported by the generic
+ * constructor, are first converted to :cpp:class:`~mppp::real_ball`.
+ *
+ * The comparison operators follow the semantics of Arb. That is, a comparison returns ``true`` only
+ * if it holds for every choice of the values within the operands' balls. In particular,
+ * ``a == b`` is ``true`` only if ``a`` and ``b`` are both exact and equal, and ``a != b`` is ``true``
+ * only if ``a`` and ``b`` do not overlap. Note that ``!(a == b)`` and ``a != b`` are not equivalent.
+ *
+ * Arb requires a precision of at least 2 bits: operations involving balls with a precision of 1 bit
+ * will raise an error.
+ * \endrststar
+ */
+class MPPP_DLL_PUBLIC real_ball
+{
+    friend struct detail::real_ball_ops;
+
+    // Tag for private constructors.
+    struct ptag {
+    };
+
+public:
+    /// Default constructor.
+    /**
+     * The midpoint is default-constructed (see mppp::real::real()), and the radius is set to zero.
+     */
+    real_ball();
+    /// Defaulted copy constructor.
+    real_ball(const real_ball &) = default;
+    /// Defaulted move constructor.
+    real_ball(real_ball &&) = default;
+    /// Constructor from a \link mppp::real real\endlink.
+    /**
+     * The ball will be exact (i.e., with a radius of zero) and with the same precision as \p mid.
+     *
+     * @param mid the midpoint.
+     */
+    explicit real_ball(const real &mid);
+    /// Constructor from a \link mppp::real real\endlink rvalue.
+    /**
+     * @param mid the midpoint, which will be moved into \p this.
+     */
+    explicit real_ball(real &&mid);
+    /// Constructor from midpoint and radius.
+    /**
+     * \rststar
+     * The radius of the ball is set to ``rad``, rounded up to 30 bits if necessary.
+     * \endrststar
+     *
+     * @param mid the midpoint.
+     * @param rad the radius.
+     *
+     * @throws std::invalid_argument if \p rad is NaN or negative.
+     */
+    explicit real_ball(const real &mid, const real &rad);
+
+private:
+    template <typename T>
+    explicit real_ball(const ptag &, const T &x, ::mpfr_prec_t p)
+        : real_ball(real{x, detail::real_ball_deduce_precision(x)})
+    {
+        if (p) {
+            prec_round(p);
+        }
+    }
+    template <std::size_t SSize>
+    explicit real_ball(const ptag &, const rational<SSize> &q, ::mpfr_prec_t p)
+        : real_ball(ptag{}, real{q.get_num(), detail::real_ball_deduce_precision(q.get_num())},
+                    real{q.get_den(), detail::real_ball_deduce_precision(q.get_den())},
+                    p ? p : detail::real_ball_deduce_precision(q))
+    {
+    }
+    explicit real_ball(const ptag &, const real &, const real &, ::mpfr_prec_t);
+
+public:
+    /// Generic constructor.
+    /**
+     * \rststar
+     * The generic constructor will set ``this`` to a ball containing ``x``.
+     *
+     * If ``p`` is zero, the precision of ``this`` is deduced from ``x`` with the same heuristics
+     * employed by the generic constructor of :cpp:class:`~mppp::real` (but ignoring the default
+     * precision). Except for rational values, the resulting ball is exact.
+     *
+     * Otherwise, the ball will have a precision of ``p``, and its radius will account for the rounding
+     * error (if any).
+     * \endrststar
+     *
+     * @param x the construction argument.
+     * @param p the desired precision.
+     *
+     * @throws std::invalid_argument if \p p is nonzero and outside the range established by
+     * \link mppp::real_prec_min() real_prec_min()\endlink and \link mppp::real_prec_max() real_prec_max()\endlink.
+     * @throws unspecified any exception thrown by the generic constructor of \link mppp::real real\endlink.
+     */
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <RealInteroperable T>
+#else
+    template <typename T, real_interoperable_enabler<T> = 0>
+#endif
+    explicit real_ball(const T &x, ::mpfr_prec_t p = 0) : real_ball(ptag{}, x, p)
+    {
+    }
+
+private:
+    explicit real_ball(const ptag &, const char *, ::mpfr_prec_t);
+    explicit real_ball(const ptag &, const std::string &, ::mpfr_prec_t);
+#if defined(MPPP_HAVE_STRING_VIEW)
+    explicit real_ball(const ptag &, const std::string_view &, ::mpfr_prec_t);
+#endif
+
+public:
+    /// Constructor from string.
+    /**
+     * \rststar
+     * This constructor will set ``this`` to a ball containing the decimal number represented by ``s``,
+     * with a precision of ``p``. If ``p`` is zero, the precision will be set to the value returned by
+     * :cpp:func:`~mppp::real_get_default_prec()`.
+     *
+     * In addition to the usual decimal representations of floating-point numbers (e.g., ``"-1.25e-3"``),
+     * balls in the format ``"[m +/- r]"`` (which is the format produced by
+     * :cpp:func:`~mppp::real_ball::to_string()`) are accepted as well.
+     * \endrststar
+     *
+     * @param s the input string.
+     * @param p the desired precision.
+     *
+     * @throws std::invalid_argument if \p s is not a valid representation of a ball, if \p p is not within
+     * the bounds established by \link mppp::real_prec_min() real_prec_min()\endlink and
+     * \link mppp::real_prec_max() real_prec_max()\endlink, or if \p p is zero but no default precision has been set.
+     */
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <StringType T>
+#else
+    template <typename T, string_type_enabler<T> = 0>
+#endif
+    explicit real_ball(const T &s, ::mpfr_prec_t p = 0) : real_ball(ptag{}, s, p)
+    {
+    }
+
+    /// Defaulted copy assignment operator.
+    /**
+     * @return a reference to \p this.
+     */
+    real_ball &operator=(const real_ball &) = default;
+    /// Defaulted move assignment operator.
+    /**
+     * @return a reference to \p this.
+     */
+    real_ball &operator=(real_ball &&) = default;
+
+    /// Midpoint getter.
+    /**
+     * @return a const reference to the midpoint.
+     */
+    const real &mid() const
+    {
+        return m_mid;
+    }
+    /// Radius getter.
+    /**
+     * @return a const reference to the radius.
+     */
+    const real &rad() const
+    {
+        return m_rad;
+    }
+    /// Precision getter.
+    /**
+     * @return the precision of the midpoint.
+     */
+    ::mpfr_prec_t get_prec() const
+    {
+        return m_mid.get_prec();
+    }
+    real_ball &prec_round(::mpfr_prec_t);
+
+    /// Lower bound.
+    /**
+     * @return a \link mppp::real real\endlink, with the same precision as \p this,
+     * which is less than or equal to every point in the ball.
+     */
+    real lower() const;
+    /// Upper bound.
+    /**
+     * @return a \link mppp::real real\endlink, with the same precision as \p this,
+     * which is greater than or equal to every point in the ball.
+     */
+    real upper() const;
+
+    /// Detect exact ball.
+    /**
+     * @return \p true if the radius is zero, \p false otherwise.
+     */
+    bool is_exact() const
+    {
+        return m_rad.zero_p();
+    }
+    /// Detect finite ball.
+    /**
+     * @return \p true if both the midpoint and the radius are finite, \p false otherwise.
+     */
+    bool is_finite() const
+    {
+        return m_mid.number_p() && m_rad.number_p();
+    }
+    bool contains(const real_ball &) const;
+    /// Check if the ball contains a value.
+    /**
+     * @param x the value to be checked.
+     *
+     * @return \p true if \p x is within the ball, \p false otherwise.
+     */
+    bool contains(const real &x) const
+    {
+        return contains(real_ball{x});
+    }
+    bool overlaps(const real_ball &) const;
+    long long rel_accuracy_bits() const;
+
+    std::string to_string() const;
+
+private:
+    real m_mid;
+    real m_rad;
+};
+
+/// Output stream operator for \link mppp::real_ball real_ball\endlink.
+/**
+ * \rststar
+ * The ball is printed in the format described in :cpp:func:`mppp::real_ball::to_string()`.
+ * \endrststar
+ *
+ * @param os the target stream.
+ * @param x the input ball.
+ *
+ * @return a reference to \p os.
+ *
+ * @throws unspecified any exception thrown by mppp::real_ball::to_string().
+ */
+inline std::ostream &operator<<(std::ostream &os, const real_ball &x)
+{
+    return os << x.to_string();
+}
+
+namespace detail
+{
+
+// Helpers to convert the operands of the real_ball
+// operators to real_ball.
+inline const real_ball &real_ball_arg(const real_ball &x)
+{
+    return x;
+}
+
+inline real_ball real_ball_arg(const real &x)
+{
+    return real_ball{x};
+}
+
+template <typename T, enable_if_t<is_real_interoperable<T>::value, int> = 0>
+inline real_ball real_ball_arg(const T &x)
+{
+    return real_ball{x};
+}
+
+} // namespace detail
+
+// Implementation of the unary functions for real_ball.
+#define MPPP_REAL_BALL_UNARY(name)                                                                                     \
+    MPPP_DLL_PUBLIC real_ball &name(real_ball &, const real_ball &);                                                   \
+    inline real_ball name(const real_ball &op)                                                                         \
+    {                                                                                                                  \
+        real_ball ret;                                                                                                 \
+        name(ret, op);                                                                                                 \
+        return ret;                                                                                                    \
+    }
+
+// Implementation of the binary functions for real_ball.
+// NOTE: the mixed-mode overloads convert the non-ball
+// operand to real_ball, as in the arithmetic operators.
+#if defined(MPPP_HAVE_CONCEPTS)
+#define MPPP_REAL_BALL_BINARY(name)                                                                                    \
+    MPPP_DLL_PUBLIC real_ball &name(real_ball &, const real_ball &, const real_ball &);                                \
+    inline real_ball name(const real_ball &a, const real_ball &b)                                                      \
+    {                                                                                                                  \
+        real_ball ret;                                                                                                 \
+        name(ret, a, b);                                                                                               \
+        return ret;                                                                                                    \
+    }                                                                                                                  \
+    template <RealBallInteroperable T>                                                                                 \
+    inline real_ball name(const real_ball &a, const T &b)                                                              \
+    {                                                                                                                  \
+        return name(a, detail::real_ball_arg(b));                                                                      \
+    }                                                                                                                  \
+    template <RealBallInteroperable T>                                                                                 \
+    inline real_ball name(const T &a, const real_ball &b)                                                              \
+    {                                                                                                                  \
+        return name(detail::real_ball_arg(a), b);                                                                      \
+    }
+#else
+#define MPPP_REAL_BALL_BINARY(name)                                                                                    \
+    MPPP_DLL_PUBLIC real_ball &name(real_ball &, const real_ball &, const real_ball &);                                \
+    inline real_ball name(const real_ball &a, const real_ball &b)                                                      \
+    {                                                                                                                  \
+        real_ball ret;                                                                                                 \
+        name(ret, a, b);                                                                                               \
+        return ret;                                                                                                    \
+    }                                                                                                                  \
+    template <typename T, real_ball_interoperable_enabler<T> = 0>                                                      \
+    inline real_ball name(const real_ball &a, const T &b)                                                              \
+    {                                                                                                                  \
+        return name(a, detail::real_ball_arg(b));                                                                      \
+    }                                                                                                                  \
+    template <typename T, real_ball_interoperable_enabler<T> = 0>                                                      \
+    inline real_ball name(const T &a, const real_ball &b)                                                              \
+    {                                                                                                                  \
+        return name(detail::real_ball_arg(a), b);                                                                      \
+    }
+#endif
+
+// Implementation of the ternary functions for real_ball.
+#define MPPP_REAL_BALL_TERNARY(name)                                                                                   \
+    MPPP_DLL_PUBLIC real_ball &name(real_ball &, const real_ball &, const real_ball &, const real_ball &);             \
+    inline real_ball name(const real_ball &a, const real_ball &b, const real_ball &c)                                  \
+    {                                                                                                                  \
+        real_ball ret;                                                                                                 \
+        name(ret, a, b, c);                                                                                            \
+        return ret;                                                                                                    \
+    }
+
+// Basic arithmetic.
+MPPP_REAL_BALL_BINARY(add)
+MPPP_REAL_BALL_BINARY(sub)
+MPPP_REAL_BALL_BINARY(mul)
+MPPP_REAL_BALL_BINARY(div)
+MPPP_REAL_BALL_UNARY(neg)
+MPPP_REAL_BALL_UNARY(abs)
+MPPP_REAL_BALL_TERNARY(fma)
+
+// Roots and powers.
+MPPP_REAL_BALL_UNARY(sqrt)
+MPPP_REAL_BALL_UNARY(rec_sqrt)
+MPPP_REAL_BALL_UNARY(sqrt1pm1)
+MPPP_REAL_BALL_UNARY(cbrt)
+MPPP_REAL_BALL_UNARY(sqr)
+MPPP_REAL_BALL_BINARY(pow)
+MPPP_REAL_BALL_BINARY(hypot)
+
+// Trigonometric functions.
+MPPP_REAL_BALL_UNARY(sin)
+MPPP_REAL_BALL_UNARY(cos)
+MPPP_REAL_BALL_UNARY(tan)
+MPPP_REAL_BALL_UNARY(cot)
+MPPP_REAL_BALL_UNARY(sec)
+MPPP_REAL_BALL_UNARY(csc)
+MPPP_REAL_BALL_UNARY(sin_pi)
+MPPP_REAL_BALL_UNARY(cos_pi)
+MPPP_REAL_BALL_UNARY(tan_pi)
+MPPP_REAL_BALL_UNARY(cot_pi)
+MPPP_REAL_BALL_UNARY(sinc)
+MPPP_REAL_BALL_UNARY(sinc_pi)
+MPPP_REAL_BALL_UNARY(asin)
+MPPP_REAL_BALL_UNARY(acos)
+MPPP_REAL_BALL_UNARY(atan)
+MPPP_REAL_BALL_BINARY(atan2)
+
+// Hyperbolic functions.
+MPPP_REAL_BALL_UNARY(sinh)
+MPPP_REAL_BALL_UNARY(cosh)
+MPPP_REAL_BALL_UNARY(tanh)
+MPPP_REAL_BALL_UNARY(coth)
+MPPP_REAL_BALL_UNARY(sech)
+MPPP_REAL_BALL_UNARY(csch)
+MPPP_REAL_BALL_UNARY(asinh)
+MPPP_REAL_BALL_UNARY(acosh)
+MPPP_REAL_BALL_UNARY(atanh)
+
+// Exponentials and logarithms.
+MPPP_REAL_BALL_UNARY(exp)
+MPPP_REAL_BALL_UNARY(exp2)
+MPPP_REAL_BALL_UNARY(exp10)
+MPPP_REAL_BALL_UNARY(expm1)
+MPPP_REAL_BALL_UNARY(log)
+MPPP_REAL_BALL_UNARY(log2)
+MPPP_REAL_BALL_UNARY(log10)
+MPPP_REAL_BALL_UNARY(log1p)
+MPPP_REAL_BALL_BINARY(log_hypot)
+
+// Gamma functions.
+MPPP_REAL_BALL_UNARY(gamma)
+MPPP_REAL_BALL_UNARY(lngamma)
+MPPP_REAL_BALL_UNARY(digamma)
+
+// Other special functions.
+MPPP_REAL_BALL_BINARY(agm)
+MPPP_REAL_BALL_UNARY(zeta)
+MPPP_REAL_BALL_UNARY(erf)
+MPPP_REAL_BALL_UNARY(erfc)
+
+#undef MPPP_REAL_BALL_UNARY
+#undef MPPP_REAL_BALL_BINARY
+#undef MPPP_REAL_BALL_TERNARY
+
+MPPP_DLL_PUBLIC real_ball real_ball_pi(::mpfr_prec_t = 0);
+
+/// Identity operator for \link mppp::real_ball real_ball\endlink.
+/**
+ * @param x the operand.
+ *
+ * @return a copy of \p x.
+ */
+inline real_ball operator+(const real_ball &x)
+{
+    return x;
+}
+
+/// Negation operator for \link mppp::real_ball real_ball\endlink.
+/**
+ * @param x the operand.
+ *
+ * @return the negative of \p x.
+ */
+inline real_ball operator-(const real_ball &x)
+{
+    return neg(x);
+}
+
+// Implementation of the arithmetic operators for real_ball.
+#if defined(MPPP_HAVE_CONCEPTS)
+#define MPPP_REAL_BALL_ARITH_OPERATOR(op, fname)                                                                       \
+    inline real_ball operator op(const real_ball &a, const real_ball &b)                                               \
+    {                                                                                                                  \
+        return fname(a, b);                                                                                            \
+    }                                                                                                                  \
+    template <RealBallInteroperable T>                                                                                 \
+    inline real_ball operator op(const real_ball &a, const T &b)                                                       \
+    {                                                                                                                  \
+        return fname(a, detail::real_ball_arg(b));                                                                     \
+    }                                                                                                                  \
+    template <RealBallInteroperable T>                                                                                 \
+    inline real_ball operator op(const T &a, const real_ball &b)                                                       \
+    {                                                                                                                  \
+        return fname(detail::real_ball_arg(a), b);                                                                     \
+    }                                                                                                                  \
+    inline real_ball &operator op##=(real_ball &a, const real_ball &b)                                                 \
+    {                                                                                                                  \
+        return fname(a, a, b);                                                                                         \
+    }                                                                                                                  \
+    template <RealBallInteroperable T>                                                                                 \
+    inline real_ball &operator op##=(real_ball &a, const T &b)                                                         \
+    {                                                                                                                  \
+        return fname(a, a, detail::real_ball_arg(b));                                                                  \
+    }
+#else
+#define MPPP_REAL_BALL_ARITH_OPERATOR(op, fname)                                                                       \
+    inline real_ball operator op(const real_ball &a, const real_ball &b)                                               \
+    {                                                                                                                  \
+        return fname(a, b);                                                                                            \
+    }                                                                                                                  \
+    template <typename T, real_ball_interoperable_enabler<T> = 0>                                                      \
+    inline real_ball operator op(const real_ball &a, const T &b)                                                       \
+    {                                                                                                                  \
+        return fname(a, detail::real_ball_arg(b));                                                                     \
+    }                                                                                                                  \
+    template <typename T, real_ball_interoperable_enabler<T> = 0>                                                      \
+    inline real_ball operator op(const T &a, const real_ball &b)                                                       \
+    {                                                                                                                  \
+        return fname(detail::real_ball_arg(a), b);                                                                     \
+    }                                                                                                                  \
+    inline real_ball &operator op##=(real_ball &a, const real_ball &b)                                                 \
+    {                                                                                                                  \
+        return fname(a, a, b);                                                                                         \
+    }                                                                                                                  \
+    template <typename T, real_ball_interoperable_enabler<T> = 0>                                                      \
+    inline real_ball &operator op##=(real_ball &a, const T &b)                                                         \
+    {                                                                                                                  \
+        return fname(a, a, detail::real_ball_arg(b));                                                                  \
+    }
+#endif
+
+MPPP_REAL_BALL_ARITH_OPERATOR(+, add)
+MPPP_REAL_BALL_ARITH_OPERATOR(-, sub)
+MPPP_REAL_BALL_ARITH_OPERATOR(*, mul)
+MPPP_REAL_BALL_ARITH_OPERATOR(/, div)
+
+#undef MPPP_REAL_BALL_ARITH_OPERATOR
+
+/// Prefix increment for \link mppp::real_ball real_ball\endlink.
+/**
+ * This operator will increment \p x by one.
+ *
+ * @param x the \link mppp::real_ball real_ball\endlink that will be increased.
+ *
+ * @return a reference to \p x after the increment.
+ */
+inline real_ball &operator++(real_ball &x)
+{
+    return x += 1;
+}
+
+/// Suffix increment for \link mppp::real_ball real_ball\endlink.
+/**
+ * This operator will increment \p x by one and return a copy of \p x as it was before the increment.
+ *
+ * @param x the \link mppp::real_ball real_ball\endlink that will be increased.
+ *
+ * @return a copy of \p x before the increment.
+ */
+inline real_ball operator++(real_ball &x, int)
+{
+    auto retval(x);
+    ++x;
+    return retval;
+}
+
+/// Prefix decrement for \link mppp::real_ball real_ball\endlink.
+/**
+ * This operator will decrement \p x by one.
+ *
+ * @param x the \link mppp::real_ball real_ball\endlink that will be decreased.
+ *
+ * @return a reference to \p x after the decrement.
+ */
+inline real_ball &operator--(real_ball &x)
+{
+    return x -= 1;
+}
+
+/// Suffix decrement for \link mppp::real_ball real_ball\endlink.
+/**
+ * This operator will decrement \p x by one and return a copy of \p x as it was before the decrement.
+ *
+ * @param x the \link mppp::real_ball real_ball\endlink that will be decreased.
+ *
+ * @return a copy of \p x before the decrement.
+ */
+inline real_ball operator--(real_ball &x, int)
+{
+    auto retval(x);
+    --x;
+    return retval;
+}
+
+// Implementation of the comparison operators for real_ball.
+#if defined(MPPP_HAVE_CONCEPTS)
+#define MPPP_REAL_BALL_CMP_OPERATOR(op)                                                                                \
+    MPPP_DLL_PUBLIC bool operator op(const real_ball &, const real_ball &);                                            \
+    template <RealBallInteroperable T>                                                                                 \
+    inline bool operator op(const real_ball &a, const T &b)                                                            \
+    {                                                                                                                  \
+        return a op detail::real_ball_arg(b);                                                                          \
+    }                                                                                                                  \
+    template <RealBallInteroperable T>                                                                                 \
+    inline bool operator op(const T &a, const real_ball &b)                                                            \
+    {                                                                                                                  \
+        return detail::real_ball_arg(a) op b;                                                                          \
+    }
+#else
+#define MPPP_REAL_BALL_CMP_OPERATOR(op)                                                                                \
+    MPPP_DLL_PUBLIC bool operator op(const real_ball &, const real_ball &);                                            \
+    template <typename T, real_ball_interoperable_enabler<T> = 0>                                                      \
+    inline bool operator op(const real_ball &a, const T &b)                                                            \
+    {                                                                                                                  \
+        return a op detail::real_ball_arg(b);                                                                          \
+    }                                                                                                                  \
+    template <typename T, real_ball_interoperable_enabler<T> = 0>                                                      \
+    inline bool operator op(const T &a, const real_ball &b)                                                            \
+    {                                                                                                                  \
+        return detail::real_ball_arg(a) op b;                                                                          \
+    }
+#endif
+
+MPPP_REAL_BALL_CMP_OPERATOR(==)
+MPPP_REAL_BALL_CMP_OPERATOR(!=)
+MPPP_REAL_BALL_CMP_OPERATOR(<)
+MPPP_REAL_BALL_CMP_OPERATOR(<=)
+MPPP_REAL_BALL_CMP_OPERATOR(>)
+MPPP_REAL_BALL_CMP_OPERATOR(>=)
+
+#undef MPPP_REAL_BALL_CMP_OPERATOR
+
+} // namespace mppp
+
+#endif
+
+#endif
@@ -0,0 +1,267 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_REAL_EVAL_HPP
+#define MPPP_REAL_EVAL_HPP
+
+#include <mp++/config.hpp>
+
+#if defined(MPPP_WITH_MPFR)
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <mp++/concepts.hpp>
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/real.hpp>
+
+#if defined(MPPP_WITH_ARB)
+
+#include <mp++/real_ball.hpp>
+
+#endif
+
+namespace mppp
+{
+
+template <typename T>
+using is_real_eval_argument = detail::disjunction<std::is_same<real, T>, is_real_interoperable<T>>;
+
+#if defined(MPPP_HAVE_CONCEPTS)
+
+template <typename T>
+MPPP_CONCEPT_DECL RealEvalArgument = is_real_eval_argument<T>::value;
+
+#else
+
+template <typename... Args>
+using real_eval_arguments_enabler
+    = detail::enable_if_t<detail::conjunction<is_real_eval_argument<Args>...>::value, int>;
+
+#endif
+
+namespace detail
+{
+
+// Number of guard bits added to the target accuracy in the first
+// step of eval_to_accuracy().
+constexpr ::mpfr_prec_t real_eval_guard_bits = 32;
+
+// Maximum number of times the working precision is doubled
+// in eval_to_accuracy() before giving up.
+constexpr unsigned real_eval_max_steps = 12;
+
+// Minimal C++11 replacement for std::index_sequence.
+template <std::size_t...>
+struct real_eval_index_seq {
+};
+
+template <std::size_t N, std::size_t... Is>
+struct real_eval_make_index_seq : real_eval_make_index_seq<N - 1u, N - 1u, Is...> {
+};
+
+template <std::size_t... Is>
+struct real_eval_make_index_seq<0, Is...> {
+    using type = real_eval_index_seq<Is...>;
+};
+
+// The type of the buffer holding the working copy of an argument.
+template <typename>
+struct real_eval_buffer {
+    using type = real;
+};
+
+// The type returned by the invocation of F on the working copies of Args.
+template <typename F, typename... Args>
+using real_eval_result_t = uncvref_t<decltype(std::declval<F &>()(
+    std::declval<::mpfr_prec_t>(), std::declval<const typename real_eval_buffer<Args>::type &>()...))>;
+
+// The convergence state of eval_to_accuracy(). This is specialised
+// for each supported result type.
+template <typename>
+struct real_eval_state {
+    static constexpr bool enabled = false;
+};
+
+// A real result is deemed accurate when it agrees with the result of the previous
+// step (computed with half the working precision) to the requested number of bits.
+template <>
+struct real_eval_state<real> {
+    static constexpr bool enabled = true;
+    // Check if cur agrees with the result of the previous step to target bits.
+    bool converged(const real &cur, ::mpfr_prec_t target)
+    {
+        if (!m_has_prev) {
+            return false;
+        }
+        const auto c = cur.get_mpfr_t(), p = m_prev.get_mpfr_t();
+        if (mpfr_regular_p(c) && mpfr_regular_p(p)) {
+            // NOTE: the difference is computed in a buffer which is
+            // reused across the steps, at the working precision of cur.
+            m_diff.set_prec(cur.get_prec());
+            ::mpfr_sub(m_diff._get_mpfr_t(), c, p, MPFR_RNDN);
+            const auto d = m_diff.get_mpfr_t();
+            // NOTE: |diff| < 2**exp(d) and |cur| >= 2**(exp(c) - 1), so exp(c) - exp(d) > target
+            // implies |diff| < |cur| * 2**-target. Both exponents are within the MPFR exponent
+            // range, thus the difference cannot overflow.
+            return mpfr_zero_p(d) || mpfr_get_exp(c) - mpfr_get_exp(d) > target;
+        }
+        // Zeroes, infinities and NaNs are stable only if they show
+        // up in two successive steps.
+        return (mpfr_nan_p(c) && mpfr_nan_p(p)) || (!mpfr_regular_p(c) && ::mpfr_equal_p(c, p) != 0);
+    }
+    // Store the result of the current step.
+    void next(real &cur)
+    {
+        swap(m_prev, cur);
+        m_has_prev = true;
+    }
+    // Round the final result to the target precision.
+    static void finalise(real &cur, ::mpfr_prec_t target)
+    {
+        cur.prec_round(target);
+    }
+    real m_prev, m_diff;
+    bool m_has_prev = false;
+};
+
+#if defined(MPPP_WITH_ARB)
+
+// A real_ball result is accurate when its radius guarantees
+// the requested number of bits.
+template <>
+struct real_eval_state<real_ball> {
+    static constexpr bool enabled = true;
+    static bool converged(const real_ball &cur, ::mpfr_prec_t target)
+    {
+        return cur.is_finite() && cur.rel_accuracy_bits() >= target;
+    }
+    static void next(real_ball &) {}
+    // NOTE: the ball is returned as-is, so that the caller
+    // has access to the error bound.
+    static void finalise(real_ball &, ::mpfr_prec_t) {}
+};
+
+#endif
+
+template <typename R, typename F, typename... Args, std::size_t... Is>
+inline R eval_to_accuracy_impl(F &f, ::mpfr_prec_t target, const real_eval_index_seq<Is...> &, const Args &... args)
+{
+    auto wp = clamp_mpfr_prec(target + real_eval_guard_bits);
+    // The working copies of the arguments. They are created
+    // once and re-set at each step with the new working precision.
+    std::array<real, sizeof...(Args)> bufs{{real{args, wp}...}};
+    ignore(bufs);
+    real_eval_state<R> state;
+
+    for (unsigned i = 0;; ++i) {
+        R cur = f(wp, bufs[Is]...);
+        if (state.converged(cur, target)) {
+            state.finalise(cur, target);
+            return cur;
+        }
+        if (i == real_eval_max_steps || wp == real_prec_max()) {
+            throw std::runtime_error("Could not evaluate a function to an accuracy of " + to_string(target)
+                                     + " bits: the last attempt used a working precision of " + to_string(wp)
+                                     + " bits");
+        }
+        state.next(cur);
+        // Double the working precision.
+        wp = wp > real_prec_max() / 2 ? real_prec_max() : wp * 2;
+        // NOTE: the leading zero keeps the array non-empty when there are no arguments.
+        const int expander[] = {0, (bufs[Is].set_prec(wp), bufs[Is].set(args), 0)...};
+        ignore(expander);
+    }
+}
+
+} // namespace detail
+
+/// Evaluate a function to a target accuracy.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * This function will evaluate the callable ``f`` at increasing working precisions,
+ * until the result is accurate to ``target_bits`` bits. At each step, ``f`` is invoked as
+ *
+ * .. code-block:: c++
+ *
+ *    f(wp, xs...)
+ *
+ * where ``wp`` is the working precision and ``xs...`` are :cpp:class:`~mppp::real` copies of ``args...``,
+ * rounded to the precision ``wp``. The working precision starts a few bits above ``target_bits``
+ * and it is doubled at each step. The copies of ``args...`` are created only once and
+ * their precision is changed in-place at each step (together with the internal buffers
+ * used to check the convergence), so that their storage is reused.
+ *
+ * The value returned by ``f`` can be either:
+ *
+ * * a :cpp:class:`~mppp::real`, in which case the iteration stops as soon as the results of two successive
+ *   steps agree to ``target_bits`` bits. The returned value is then the last result,
+ *   rounded to ``target_bits`` bits of precision. Note that this is a heuristic
+ *   criterion, which may be fooled by functions which are badly conditioned or
+ *   which converge slowly as the precision increases;
+ * * a :cpp:class:`~mppp::real_ball` (if mp++ was configured with the ``MPPP_WITH_ARB`` option enabled),
+ *   in which case the iteration stops as soon as the relative accuracy of the ball
+ *   is at least ``target_bits`` bits (see :cpp:func:`mppp::real_ball::rel_accuracy_bits()`).
+ *   The returned value is the last ball, whose radius provides a rigorous error bound.
+ *
+ * In order to compute at the working precision, ``f`` should create any intermediate
+ * :cpp:class:`~mppp::real` (e.g., constants such as :cpp:func:`~mppp::real_pi()`) with precision ``wp``.
+ *
+ * .. code-block:: c++
+ *
+ *    // Compute exp(pi * sqrt(163)) to 200 bits.
+ *    auto r = eval_to_accuracy([](mpfr_prec_t wp, const real &x) {
+ *        return exp(real_pi(wp) * sqrt(x));
+ *    }, 200, 163);
+ * \endrststar
+ *
+ * @param f the function to be evaluated.
+ * @param target_bits the desired number of correct bits.
+ * @param args the arguments of \p f.
+ *
+ * @return the value of \p f, accurate to \p target_bits bits.
+ *
+ * @throws std::invalid_argument if \p target_bits is outside the range established by
+ * \link mppp::real_prec_min() real_prec_min()\endlink and \link mppp::real_prec_max() real_prec_max()\endlink.
+ * @throws std::runtime_error if the target accuracy is not reached after doubling the working precision
+ * 12 times, or when the working precision reaches \link mppp::real_prec_max() real_prec_max()\endlink.
+ * @throws unspecified any exception thrown by \p f or by the conversion of \p args to \link mppp::real real\endlink.
+ */
+#if defined(MPPP_HAVE_CONCEPTS)
+template <typename F, RealEvalArgument... Args>
+#else
+template <typename F, typename... Args, real_eval_arguments_enabler<Args...> = 0>
+#endif
+inline detail::real_eval_result_t<F, Args...> eval_to_accuracy(F &&f, ::mpfr_prec_t target_bits, const Args &... args)
+{
+    using ret_t = detail::real_eval_result_t<F, Args...>;
+    static_assert(detail::real_eval_state<ret_t>::enabled,
+                  "The function passed to eval_to_accuracy() must return either a real or a real_ball.");
+
+    if (mppp_unlikely(!detail::real_prec_check(target_bits))) {
+        throw std::invalid_argument("Cannot evaluate a function to an accuracy of " + detail::to_string(target_bits)
+                                    + " bits: the value must be between " + detail::to_string(real_prec_min())
+                                    + " and " + detail::to_string(real_prec_max()));
+    }
+
+    return detail::eval_to_accuracy_impl<ret_t>(
+        f, target_bits, typename detail::real_eval_make_index_seq<sizeof...(Args)>::type{}, args...);
+}
+
+} // namespace mppp
+
+#endif
+
+#endif
@@ -0,0 +1,434 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_REAL_EXPR_HPP
+#define MPPP_REAL_EXPR_HPP
+
+#include <mp++/config.hpp>
+
+#if defined(MPPP_WITH_MPFR)
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/real.hpp>
+
+namespace mppp
+{
+
+namespace detail
+{
+
+// The arithmetic operations of the lazy expressions.
+struct real_lazy_add {
+    static void apply(mpfr_struct_t *rop, const mpfr_struct_t *a, const mpfr_struct_t *b)
+    {
+        ::mpfr_add(rop, a, b, MPFR_RNDN);
+    }
+};
+
+struct real_lazy_sub {
+    static void apply(mpfr_struct_t *rop, const mpfr_struct_t *a, const mpfr_struct_t *b)
+    {
+        ::mpfr_sub(rop, a, b, MPFR_RNDN);
+    }
+};
+
+struct real_lazy_mul {
+    static void apply(mpfr_struct_t *rop, const mpfr_struct_t *a, const mpfr_struct_t *b)
+    {
+        if (a == b) {
+            ::mpfr_sqr(rop, a, MPFR_RNDN);
+        } else {
+            ::mpfr_mul(rop, a, b, MPFR_RNDN);
+        }
+    }
+};
+
+struct real_lazy_div {
+    static void apply(mpfr_struct_t *rop, const mpfr_struct_t *a, const mpfr_struct_t *b)
+    {
+        ::mpfr_div(rop, a, b, MPFR_RNDN);
+    }
+};
+
+} // namespace detail
+
+// Leaf of a lazy expression: a reference to a real.
+class real_lazy_ref
+{
+public:
+    explicit real_lazy_ref(const real &r) : m_ptr(&r) {}
+    const real &get() const
+    {
+        return *m_ptr;
+    }
+    ::mpfr_prec_t get_prec() const
+    {
+        return m_ptr->get_prec();
+    }
+    bool refers_to(const real &r) const
+    {
+        return m_ptr == &r;
+    }
+
+private:
+    const real *m_ptr;
+};
+
+// Negation of a lazy expression.
+template <typename E>
+class real_lazy_neg
+{
+public:
+    explicit real_lazy_neg(const E &arg) : m_arg(arg) {}
+    const E &arg() const
+    {
+        return m_arg;
+    }
+    ::mpfr_prec_t get_prec() const
+    {
+        return m_arg.get_prec();
+    }
+    bool refers_to(const real &r) const
+    {
+        return m_arg.refers_to(r);
+    }
+
+private:
+    E m_arg;
+};
+
+// Binary arithmetic operation between lazy expressions.
+template <typename Op, typename L, typename R>
+class real_lazy_binary
+{
+public:
+    explicit real_lazy_binary(const L &lhs, const R &rhs) : m_lhs(lhs), m_rhs(rhs) {}
+    const L &lhs() const
+    {
+        return m_lhs;
+    }
+    const R &rhs() const
+    {
+        return m_rhs;
+    }
+    ::mpfr_prec_t get_prec() const
+    {
+        return std::max(m_lhs.get_prec(), m_rhs.get_prec());
+    }
+    bool refers_to(const real &r) const
+    {
+        return m_lhs.refers_to(r) || m_rhs.refers_to(r);
+    }
+
+private:
+    L m_lhs;
+    R m_rhs;
+};
+
+namespace detail
+{
+
+template <typename T>
+struct is_real_lazy_impl : std::false_type {
+};
+
+template <>
+struct is_real_lazy_impl<real_lazy_ref> : std::true_type {
+};
+
+template <typename E>
+struct is_real_lazy_impl<real_lazy_neg<E>> : std::true_type {
+};
+
+template <typename Op, typename L, typename R>
+struct is_real_lazy_impl<real_lazy_binary<Op, L, R>> : std::true_type {
+};
+
+} // namespace detail
+
+// Detect lazy expressions.
+template <typename T>
+using is_real_lazy = detail::is_real_lazy_impl<detail::uncvref_t<T>>;
+
+namespace detail
+{
+
+// Convert an operand of a lazy arithmetic operator into a lazy expression.
+inline real_lazy_ref real_lazy_wrap(const real &r)
+{
+    return real_lazy_ref{r};
+}
+
+template <typename E, enable_if_t<is_real_lazy<E>::value, int> = 0>
+inline const E &real_lazy_wrap(const E &e)
+{
+    return e;
+}
+
+template <typename T>
+using real_lazy_wrap_t = uncvref_t<decltype(real_lazy_wrap(std::declval<const T &>()))>;
+
+// An operand of a lazy arithmetic operator is either a lazy expression, or an lvalue real
+// (rvalue reals are rejected, as the expression would hold a dangling reference).
+template <typename T>
+using is_real_lazy_operand
+    = disjunction<is_real_lazy<T>, conjunction<std::is_lvalue_reference<T>, std::is_same<uncvref_t<T>, real>>>;
+
+// The lazy arithmetic operators are enabled if both operands are valid,
+// and at least one of them is a lazy expression.
+template <typename T, typename U>
+using real_lazy_op_enabler
+    = enable_if_t<conjunction<is_real_lazy_operand<T>, is_real_lazy_operand<U>,
+                              disjunction<is_real_lazy<T>, is_real_lazy<U>>>::value,
+                  int>;
+
+template <typename Op, typename T, typename U>
+using real_lazy_op_t = real_lazy_binary<Op, real_lazy_wrap_t<T>, real_lazy_wrap_t<U>>;
+
+// Evaluation of a lazy expression into rop. rop must have the precision of
+// the whole expression, and it cannot overlap with any leaf of the expression.
+template <typename Op, typename L, typename R>
+inline void real_lazy_eval(mpfr_struct_t *, const real_lazy_binary<Op, L, R> &);
+
+inline void real_lazy_eval(mpfr_struct_t *rop, const real_lazy_ref &e)
+{
+    ::mpfr_set(rop, e.get().get_mpfr_t(), MPFR_RNDN);
+}
+
+inline void real_lazy_eval(mpfr_struct_t *rop, const real_lazy_neg<real_lazy_ref> &e)
+{
+    ::mpfr_neg(rop, e.arg().get().get_mpfr_t(), MPFR_RNDN);
+}
+
+template <typename E>
+inline void real_lazy_eval(mpfr_struct_t *rop, const real_lazy_neg<E> &e)
+{
+    real_lazy_eval(rop, e.arg());
+    ::mpfr_neg(rop, rop, MPFR_RNDN);
+}
+
+// Generic binary operations. The operands which are not leaves are evaluated
+// into rop, and into a temporary value only if both operands are not leaves.
+template <typename Op>
+inline void real_lazy_eval_binary(mpfr_struct_t *rop, const Op &, const real_lazy_ref &l, const real_lazy_ref &r)
+{
+    Op::apply(rop, l.get().get_mpfr_t(), r.get().get_mpfr_t());
+}
+
+template <typename Op, typename L>
+inline void real_lazy_eval_binary(mpfr_struct_t *rop, const Op &, const L &l, const real_lazy_ref &r)
+{
+    real_lazy_eval(rop, l);
+    Op::apply(rop, rop, r.get().get_mpfr_t());
+}
+
+template <typename Op, typename R>
+inline void real_lazy_eval_binary(mpfr_struct_t *rop, const Op &, const real_lazy_ref &l, const R &r)
+{
+    real_lazy_eval(rop, r);
+    Op::apply(rop, l.get().get_mpfr_t(), rop);
+}
+
+template <typename Op, typename L, typename R>
+inline void real_lazy_eval_binary(mpfr_struct_t *rop, const Op &, const L &l, const R &r)
+{
+    real_lazy_eval(rop, l);
+    real tmp{real_kind::zero, mpfr_get_prec(rop)};
+    real_lazy_eval(tmp._get_mpfr_t(), r);
+    Op::apply(rop, rop, tmp.get_mpfr_t());
+}
+
+// Fused patterns.
+using real_lazy_prod = real_lazy_binary<real_lazy_mul, real_lazy_ref, real_lazy_ref>;
+
+// a * b + c and c + a * b.
+inline void real_lazy_eval_binary(mpfr_struct_t *rop, const real_lazy_add &, const real_lazy_prod &l,
+                                  const real_lazy_ref &r)
+{
+    ::mpfr_fma(rop, l.lhs().get().get_mpfr_t(), l.rhs().get().get_mpfr_t(), r.get().get_mpfr_t(), MPFR_RNDN);
+}
+
+inline void real_lazy_eval_binary(mpfr_struct_t *rop, const real_lazy_add &, const real_lazy_ref &l,
+                                  const real_lazy_prod &r)
+{
+    ::mpfr_fma(rop, r.lhs().get().get_mpfr_t(), r.rhs().get().get_mpfr_t(), l.get().get_mpfr_t(), MPFR_RNDN);
+}
+
+template <typename E>
+inline void real_lazy_eval_binary(mpfr_struct_t *rop, const real_lazy_add &, const real_lazy_prod &l, const E &r)
+{
+    real_lazy_eval(rop, r);
+    ::mpfr_fma(rop, l.lhs().get().get_mpfr_t(), l.rhs().get().get_mpfr_t(), rop, MPFR_RNDN);
+}
+
+template <typename E>
+inline void real_lazy_eval_binary(mpfr_struct_t *rop, const real_lazy_add &, const E &l, const real_lazy_prod &r)
+{
+    real_lazy_eval(rop, l);
+    ::mpfr_fma(rop, r.lhs().get().get_mpfr_t(), r.rhs().get().get_mpfr_t(), rop, MPFR_RNDN);
+}
+
+// a * b - c and c - a * b.
+// NOTE: c - a * b is computed as (-a) * b + c, rather than as -(a * b - c),
+// so that an exact cancellation yields +0 as in the eager evaluation.
+// Build in v a view of -x sharing the significand of x (the view is
+// only ever read, and it never overlaps with rop).
+inline void real_lazy_neg_view(mpfr_struct_t &v, const real &x)
+{
+    v = *x.get_mpfr_t();
+    v._mpfr_sign = -v._mpfr_sign;
+}
+
+inline void real_lazy_eval_binary(mpfr_struct_t *rop, const real_lazy_sub &, const real_lazy_prod &l,
+                                  const real_lazy_ref &r)
+{
+    ::mpfr_fms(rop, l.lhs().get().get_mpfr_t(), l.rhs().get().get_mpfr_t(), r.get().get_mpfr_t(), MPFR_RNDN);
+}
+
+inline void real_lazy_eval_binary(mpfr_struct_t *rop, const real_lazy_sub &, const real_lazy_ref &l,
+                                  const real_lazy_prod &r)
+{
+    mpfr_struct_t na;
+    real_lazy_neg_view(na, r.lhs().get());
+    ::mpfr_fma(rop, &na, r.rhs().get().get_mpfr_t(), l.get().get_mpfr_t(), MPFR_RNDN);
+}
+
+template <typename E>
+inline void real_lazy_eval_binary(mpfr_struct_t *rop, const real_lazy_sub &, const real_lazy_prod &l, const E &r)
+{
+    real_lazy_eval(rop, r);
+    ::mpfr_fms(rop, l.lhs().get().get_mpfr_t(), l.rhs().get().get_mpfr_t(), rop, MPFR_RNDN);
+}
+
+template <typename E>
+inline void real_lazy_eval_binary(mpfr_struct_t *rop, const real_lazy_sub &, const E &l, const real_lazy_prod &r)
+{
+    real_lazy_eval(rop, l);
+    mpfr_struct_t na;
+    real_lazy_neg_view(na, r.lhs().get());
+    ::mpfr_fma(rop, &na, r.rhs().get().get_mpfr_t(), rop, MPFR_RNDN);
+}
+
+// a * b + c * d and a * b - c * d.
+inline void real_lazy_eval_binary(mpfr_struct_t *rop, const real_lazy_add &, const real_lazy_prod &l,
+                                  const real_lazy_prod &r)
+{
+#if MPFR_VERSION_MAJOR >= 4
+    ::mpfr_fmma(rop, l.lhs().get().get_mpfr_t(), l.rhs().get().get_mpfr_t(), r.lhs().get().get_mpfr_t(),
+                r.rhs().get().get_mpfr_t(), MPFR_RNDN);
+#else
+    real_lazy_eval(rop, r);
+    ::mpfr_fma(rop, l.lhs().get().get_mpfr_t(), l.rhs().get().get_mpfr_t(), rop, MPFR_RNDN);
+#endif
+}
+
+inline void real_lazy_eval_binary(mpfr_struct_t *rop, const real_lazy_sub &, const real_lazy_prod &l,
+                                  const real_lazy_prod &r)
+{
+#if MPFR_VERSION_MAJOR >= 4
+    ::mpfr_fmms(rop, l.lhs().get().get_mpfr_t(), l.rhs().get().get_mpfr_t(), r.lhs().get().get_mpfr_t(),
+                r.rhs().get().get_mpfr_t(), MPFR_RNDN);
+#else
+    real_lazy_eval(rop, r);
+    ::mpfr_fms(rop, l.lhs().get().get_mpfr_t(), l.rhs().get().get_mpfr_t(), rop, MPFR_RNDN);
+#endif
+}
+
+template <typename Op, typename L, typename R>
+inline void real_lazy_eval(mpfr_struct_t *rop, const real_lazy_binary<Op, L, R> &e)
+{
+    real_lazy_eval_binary(rop, Op{}, e.lhs(), e.rhs());
+}
+
+} // namespace detail
+
+// Create a lazy expression from a real.
+inline real_lazy_ref lazy(const real &r)
+{
+    return real_lazy_ref{r};
+}
+
+// Lazy expressions must not be created from temporaries.
+void lazy(const real &&) = delete;
+
+// Lazy arithmetic operators.
+template <typename T, typename U, detail::real_lazy_op_enabler<T, U> = 0>
+inline detail::real_lazy_op_t<detail::real_lazy_add, T, U> operator+(T &&a, U &&b)
+{
+    return detail::real_lazy_op_t<detail::real_lazy_add, T, U>{detail::real_lazy_wrap(a), detail::real_lazy_wrap(b)};
+}
+
+template <typename T, typename U, detail::real_lazy_op_enabler<T, U> = 0>
+inline detail::real_lazy_op_t<detail::real_lazy_sub, T, U> operator-(T &&a, U &&b)
+{
+    return detail::real_lazy_op_t<detail::real_lazy_sub, T, U>{detail::real_lazy_wrap(a), detail::real_lazy_wrap(b)};
+}
+
+template <typename T, typename U, detail::real_lazy_op_enabler<T, U> = 0>
+inline detail::real_lazy_op_t<detail::real_lazy_mul, T, U> operator*(T &&a, U &&b)
+{
+    return detail::real_lazy_op_t<detail::real_lazy_mul, T, U>{detail::real_lazy_wrap(a), detail::real_lazy_wrap(b)};
+}
+
+template <typename T, typename U, detail::real_lazy_op_enabler<T, U> = 0>
+inline detail::real_lazy_op_t<detail::real_lazy_div, T, U> operator/(T &&a, U &&b)
+{
+    return detail::real_lazy_op_t<detail::real_lazy_div, T, U>{detail::real_lazy_wrap(a), detail::real_lazy_wrap(b)};
+}
+
+template <typename E, detail::enable_if_t<is_real_lazy<E>::value, int> = 0>
+inline real_lazy_neg<detail::uncvref_t<E>> operator-(const E &e)
+{
+    return real_lazy_neg<detail::uncvref_t<E>>{e};
+}
+
+template <typename E, detail::enable_if_t<is_real_lazy<E>::value, int> = 0>
+inline const E &operator+(const E &e)
+{
+    return e;
+}
+
+// Evaluate a lazy expression into rop.
+template <typename E, detail::enable_if_t<is_real_lazy<E>::value, int> = 0>
+inline real &eval(real &rop, const E &e)
+{
+    const auto p = e.get_prec();
+    if (e.refers_to(rop)) {
+        // rop is a leaf of the expression: evaluate into
+        // a temporary and move the result into rop.
+        real tmp{real_kind::zero, p};
+        detail::real_lazy_eval(tmp._get_mpfr_t(), e);
+        swap(tmp, rop);
+    } else {
+        if (rop.get_prec() != p) {
+            rop.set_prec(p);
+        }
+        detail::real_lazy_eval(rop._get_mpfr_t(), e);
+    }
+    return rop;
+}
+
+// Evaluate a lazy expression.
+template <typename E, detail::enable_if_t<is_real_lazy<E>::value, int> = 0>
+inline real eval(const E &e)
+{
+    real retval{real_kind::zero, e.get_prec()};
+    detail::real_lazy_eval(retval._get_mpfr_t(), e);
+    return retval;
+}
+
+} // namespace mppp
+
+#endif
+
+#endif
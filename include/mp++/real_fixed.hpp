@@ -0,0 +1,756 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_REAL_FIXED_HPP
+#define MPPP_REAL_FIXED_HPP
+
+#include <mp++/config.hpp>
+
+#if defined(MPPP_WITH_MPFR)
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#if defined(MPPP_HAVE_STRING_VIEW)
+#include <string_view>
+#endif
+
+#include <mp++/concepts.hpp>
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/rational.hpp>
+#include <mp++/real.hpp>
+
+#if defined(MPPP_WITH_QUADMATH)
+#include <mp++/real128.hpp>
+#endif
+
+namespace mppp
+{
+
+template <::mpfr_prec_t>
+class real_fixed;
+
+namespace detail
+{
+
+// Number of limbs needed to store the significand of a real with precision P.
+template <::mpfr_prec_t P>
+constexpr std::size_t real_fixed_nlimbs()
+{
+    return static_cast<std::size_t>((P + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS);
+}
+
+// Set the mpfr_t rop to the value of x, rounding if necessary. Used in the
+// construction of real_fixed objects, so that no temporary real is needed.
+inline void real_fixed_set(mpfr_struct_t *rop, const bool &b)
+{
+    ::mpfr_set_ui(rop, static_cast<unsigned long>(b), MPFR_RNDN);
+}
+
+template <typename T, enable_if_t<conjunction<is_integral<T>, is_unsigned<T>>::value, int> = 0>
+inline void real_fixed_set(mpfr_struct_t *rop, const T &n)
+{
+    if (n <= nl_max<unsigned long>()) {
+        ::mpfr_set_ui(rop, static_cast<unsigned long>(n), MPFR_RNDN);
+    } else {
+        ::mpfr_set_z(rop, integer<2>(n).get_mpz_view(), MPFR_RNDN);
+    }
+}
+
+template <typename T, enable_if_t<conjunction<is_integral<T>, is_signed<T>>::value, int> = 0>
+inline void real_fixed_set(mpfr_struct_t *rop, const T &n)
+{
+    if (n <= nl_max<long>() && n >= nl_min<long>()) {
+        ::mpfr_set_si(rop, static_cast<long>(n), MPFR_RNDN);
+    } else {
+        ::mpfr_set_z(rop, integer<2>(n).get_mpz_view(), MPFR_RNDN);
+    }
+}
+
+inline void real_fixed_set(mpfr_struct_t *rop, const float &x)
+{
+    ::mpfr_set_flt(rop, x, MPFR_RNDN);
+}
+
+inline void real_fixed_set(mpfr_struct_t *rop, const double &x)
+{
+    ::mpfr_set_d(rop, x, MPFR_RNDN);
+}
+
+inline void real_fixed_set(mpfr_struct_t *rop, const long double &x)
+{
+    ::mpfr_set_ld(rop, x, MPFR_RNDN);
+}
+
+template <std::size_t SSize>
+inline void real_fixed_set(mpfr_struct_t *rop, const integer<SSize> &n)
+{
+    ::mpfr_set_z(rop, n.get_mpz_view(), MPFR_RNDN);
+}
+
+template <std::size_t SSize>
+inline void real_fixed_set(mpfr_struct_t *rop, const rational<SSize> &q)
+{
+    const auto v = get_mpq_view(q);
+    ::mpfr_set_q(rop, &v, MPFR_RNDN);
+}
+
+#if defined(MPPP_WITH_QUADMATH)
+
+inline void real_fixed_set(mpfr_struct_t *rop, const real128 &x)
+{
+    mpfr_set_real128(rop, x);
+}
+
+#endif
+
+// Helper to run MPFR primitives on real_fixed objects. A real_fixed stores
+// the sign and exponent fields of an MPFR struct, and the significand in an inline
+// array of limbs. For each operation, we rebuild from these an mpfr_t view, which
+// is then passed to the MPFR primitives. Because no pointer is stored in the
+// real_fixed object, real_fixed is trivially copyable.
+template <::mpfr_prec_t P>
+struct real_fixed_ops {
+    // Build in v a view of x.
+    // NOTE: the const_cast is fine, as views of const objects are never written to.
+    static void view(mpfr_struct_t &v, const real_fixed<P> &x)
+    {
+        v._mpfr_prec = P;
+        v._mpfr_sign = x.m_sign;
+        v._mpfr_exp = x.m_exp;
+        v._mpfr_d = const_cast<::mp_limb_t *>(x.m_limbs.data());
+    }
+    // Write back into x the sign and exponent of the view v (the significand
+    // has already been written in place).
+    static void sync(real_fixed<P> &x, const mpfr_struct_t &v)
+    {
+        x.m_sign = v._mpfr_sign;
+        x.m_exp = v._mpfr_exp;
+    }
+    // Create a real_fixed whose value is meant to be overwritten.
+    static real_fixed<P> make()
+    {
+        return real_fixed<P>{typename real_fixed<P>::uninit_t{}};
+    }
+    // NOTE: in the helpers below, we build a single view for each distinct object,
+    // so that MPFR can detect overlapping arguments.
+    template <typename F>
+    static void unary(const F &f, real_fixed<P> &rop, const real_fixed<P> &op)
+    {
+        mpfr_struct_t rv, ov;
+        view(rv, rop);
+        auto op_ptr = &rv;
+        if (&op != &rop) {
+            view(ov, op);
+            op_ptr = &ov;
+        }
+        f(&rv, op_ptr, MPFR_RNDN);
+        sync(rop, rv);
+    }
+    template <typename F>
+    static void binary(const F &f, real_fixed<P> &rop, const real_fixed<P> &a, const real_fixed<P> &b)
+    {
+        mpfr_struct_t rv, av, bv;
+        view(rv, rop);
+        auto a_ptr = &rv, b_ptr = &rv;
+        if (&a != &rop) {
+            view(av, a);
+            a_ptr = &av;
+        }
+        if (&b == &a) {
+            b_ptr = a_ptr;
+        } else if (&b != &rop) {
+            view(bv, b);
+            b_ptr = &bv;
+        }
+        f(&rv, a_ptr, b_ptr, MPFR_RNDN);
+        sync(rop, rv);
+    }
+    template <typename F>
+    static void ternary(const F &f, real_fixed<P> &rop, const real_fixed<P> &a, const real_fixed<P> &b,
+                        const real_fixed<P> &c)
+    {
+        mpfr_struct_t rv, av, bv, cv;
+        view(rv, rop);
+        auto a_ptr = &rv, b_ptr = &rv, c_ptr = &rv;
+        if (&a != &rop) {
+            view(av, a);
+            a_ptr = &av;
+        }
+        if (&b == &a) {
+            b_ptr = a_ptr;
+        } else if (&b != &rop) {
+            view(bv, b);
+            b_ptr = &bv;
+        }
+        if (&c == &a) {
+            c_ptr = a_ptr;
+        } else if (&c == &b) {
+            c_ptr = b_ptr;
+        } else if (&c != &rop) {
+            view(cv, c);
+            c_ptr = &cv;
+        }
+        f(&rv, a_ptr, b_ptr, c_ptr, MPFR_RNDN);
+        sync(rop, rv);
+    }
+    // Set rop from an mpfr_t with arbitrary precision, rounding if necessary.
+    static void set(real_fixed<P> &rop, const mpfr_struct_t *x)
+    {
+        mpfr_struct_t rv;
+        view(rv, rop);
+        ::mpfr_set(&rv, x, MPFR_RNDN);
+        sync(rop, rv);
+    }
+    // Set rop from a real-interoperable value, rounding if necessary.
+    template <typename T>
+    static void set_value(real_fixed<P> &rop, const T &x)
+    {
+        mpfr_struct_t rv;
+        view(rv, rop);
+        real_fixed_set(&rv, x);
+        sync(rop, rv);
+    }
+    // Set rop from a string in base base, rounding if necessary.
+    static void set_str(real_fixed<P> &rop, const char *s, int base)
+    {
+        if (mppp_unlikely(base && (base < 2 || base > 62))) {
+            throw std::invalid_argument("Cannot construct a real_fixed from a string in base " + to_string(base)
+                                        + ": the base must either be zero or in the [2,62] range");
+        }
+        mpfr_struct_t rv;
+        view(rv, rop);
+        const auto ret = ::mpfr_set_str(&rv, s, base, MPFR_RNDN);
+        sync(rop, rv);
+        if (mppp_unlikely(ret == -1)) {
+            throw std::invalid_argument(std::string{"The string '"} + s
+                                        + "' does not represent a valid real_fixed in base " + to_string(base));
+        }
+    }
+    // Run a comparison function on two operands.
+    template <typename F>
+    static int cmp(const F &f, const real_fixed<P> &a, const real_fixed<P> &b)
+    {
+        mpfr_struct_t av, bv;
+        view(av, a);
+        view(bv, b);
+        return f(&av, &bv);
+    }
+};
+
+} // namespace detail
+
+/// Fixed-precision multiprecision floating-point class.
+/**
+ * \rststar
+ * *#include <mp++/real_fixed.hpp>*
+ *
+ * .. versionadded:: 0.20
+ *
+ * This class represents a multiprecision floating-point value whose precision, ``P`` bits, is a compile-time
+ * constant. The value is stored as a sign/exponent/significand triple, in which the significand
+ * occupies an inline array of limbs. On every operation, a temporary ``mpfr_t`` view of each operand
+ * is built by filling in the fields of an MPFR struct with the stored sign and exponent, and with a
+ * pointer to the inline limbs. The result is computed directly into the storage of the return value,
+ * with rounding to nearest.
+ *
+ * Compared to :cpp:class:`~mppp::real`:
+ *
+ * * objects of this class never allocate memory for the storage of their value, at any precision
+ *   (the construction from a ``std::string_view`` copies the string into a temporary, and some
+ *   MPFR primitives may allocate scratch memory internally at high precision);
+ * * there are no runtime checks on the precision of the operands, and there is no need to deduce
+ *   the precision of the return value;
+ * * the class is trivially copyable: copying or relocating a :cpp:class:`~mppp::real_fixed`
+ *   (e.g., when a ``std::vector`` grows) is a plain ``memcpy()``;
+ * * arithmetic is supported only between operands with the same precision. Mixed-mode operations
+ *   with other types require an explicit conversion to :cpp:class:`~mppp::real_fixed`
+ *   (or from :cpp:class:`~mppp::real_fixed` to :cpp:class:`~mppp::real`);
+ *
+ * All the MPFR functions available as :cpp:class:`~mppp::real` unary functions (e.g., :cpp:func:`mppp::sqrt()`,
+ * :cpp:func:`mppp::sin()`, :cpp:func:`mppp::lgamma()`, etc.) are available for :cpp:class:`~mppp::real_fixed`
+ * as well, both in the form ``f(rop, op)`` (writing the result into ``rop``) and in the form ``f(op)``
+ * (returning the result). Overlapping arguments are supported.
+ * \endrststar
+ */
+template <::mpfr_prec_t P>
+class real_fixed
+{
+    static_assert(detail::real_prec_check(P), "Invalid precision for a real_fixed.");
+
+    template <::mpfr_prec_t>
+    friend struct detail::real_fixed_ops;
+
+public:
+    /// Default constructor.
+    /**
+     * The value is initialised to positive zero.
+     */
+    real_fixed() : m_limbs{}
+    {
+        mpfr_struct_t v;
+        mpfr_custom_init_set(&v, MPFR_ZERO_KIND, 0, P, m_limbs.data());
+        detail::real_fixed_ops<P>::sync(*this, v);
+    }
+    /// Defaulted copy constructor.
+    real_fixed(const real_fixed &) = default;
+    /// Defaulted move constructor.
+    real_fixed(real_fixed &&) = default;
+    /// Constructor from a \link mppp::real real\endlink.
+    /**
+     * @param r the input value, which will be rounded to ``P`` bits if necessary.
+     */
+    explicit real_fixed(const real &r) : real_fixed(uninit_t{})
+    {
+        detail::real_fixed_ops<P>::set(*this, r.get_mpfr_t());
+    }
+    /// Generic constructor.
+    /**
+     * \rststar
+     * The value of *x* is rounded to ``P`` bits if necessary.
+     * \endrststar
+     *
+     * @param x the construction argument.
+     */
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <RealInteroperable T>
+#else
+    template <typename T, real_interoperable_enabler<T> = 0>
+#endif
+    explicit real_fixed(const T &x) : real_fixed(uninit_t{})
+    {
+        detail::real_fixed_ops<P>::set_value(*this, x);
+    }
+    /// Constructor from string.
+    /**
+     * \rststar
+     * The string is interpreted as in the string constructors of :cpp:class:`~mppp::real`,
+     * and the value is rounded to ``P`` bits if necessary.
+     * \endrststar
+     *
+     * @param s the input string.
+     * @param base the base used in the string representation.
+     *
+     * @throws std::invalid_argument if \p s cannot be parsed as a floating-point value in base \p base,
+     * or if the value of \p base is invalid.
+     * @throws unspecified any exception thrown by memory allocation errors in standard containers.
+     */
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <StringType T>
+#else
+    template <typename T, string_type_enabler<T> = 0>
+#endif
+    explicit real_fixed(const T &s, int base = 10) : real_fixed(uninit_t{})
+    {
+        string_ctor(s, base);
+    }
+    /// Defaulted copy assignment operator.
+    real_fixed &operator=(const real_fixed &) = default;
+    /// Defaulted move assignment operator.
+    real_fixed &operator=(real_fixed &&) = default;
+
+    /// Conversion to \link mppp::real real\endlink.
+    /**
+     * @return a \link mppp::real real\endlink with precision ``P`` and the same value as \p this.
+     */
+    explicit operator real() const
+    {
+        mpfr_struct_t v;
+        detail::real_fixed_ops<P>::view(v, *this);
+        return real{&v};
+    }
+    /// Generic conversion operator.
+    /**
+     * \rststar
+     * The conversion is performed via the conversion operator of :cpp:class:`~mppp::real`.
+     * \endrststar
+     *
+     * @return \p this converted to ``T``.
+     *
+     * @throws unspecified any exception thrown by the conversion operator of \link mppp::real real\endlink.
+     */
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <RealInteroperable T>
+#else
+    template <typename T, real_interoperable_enabler<T> = 0>
+#endif
+    explicit operator T() const
+    {
+        return static_cast<T>(static_cast<real>(*this));
+    }
+
+    /// Precision.
+    /**
+     * @return ``P``.
+     */
+    static constexpr ::mpfr_prec_t get_prec()
+    {
+        return P;
+    }
+
+    /// Convert to string.
+    /**
+     * @param base the base to be used for the string representation.
+     *
+     * @return \p this converted to a string.
+     *
+     * @throws unspecified any exception thrown by mppp::real::to_string().
+     */
+    std::string to_string(int base = 10) const
+    {
+        return static_cast<real>(*this).to_string(base);
+    }
+
+    /// Detect NaN.
+    /**
+     * @return \p true if \p this is NaN, \p false otherwise.
+     */
+    bool nan_p() const
+    {
+        return query([](const mpfr_struct_t *v) { return mpfr_nan_p(v) != 0; });
+    }
+    /// Detect infinity.
+    /**
+     * @return \p true if \p this is an infinity, \p false otherwise.
+     */
+    bool inf_p() const
+    {
+        return query([](const mpfr_struct_t *v) { return mpfr_inf_p(v) != 0; });
+    }
+    /// Detect finite number.
+    /**
+     * @return \p true if \p this is a finite number, \p false otherwise.
+     */
+    bool number_p() const
+    {
+        return query([](const mpfr_struct_t *v) { return mpfr_number_p(v) != 0; });
+    }
+    /// Detect zero.
+    /**
+     * @return \p true if \p this is zero, \p false otherwise.
+     */
+    bool zero_p() const
+    {
+        return query([](const mpfr_struct_t *v) { return mpfr_zero_p(v) != 0; });
+    }
+    /// Detect regular number.
+    /**
+     * @return \p true if \p this is a regular number (i.e., not NaN, infinity or zero), \p false otherwise.
+     */
+    bool regular_p() const
+    {
+        return query([](const mpfr_struct_t *v) { return mpfr_regular_p(v) != 0; });
+    }
+    /// Detect the sign.
+    /**
+     * @return a positive value if \p this is positive, zero if \p this is zero,
+     * a negative value if \p this is negative.
+     *
+     * @throws std::domain_error if \p this is NaN.
+     */
+    int sgn() const
+    {
+        if (mppp_unlikely(nan_p())) {
+            // NOTE: as in real::sgn(), avoid setting the MPFR erange flag.
+            throw std::domain_error("Cannot determine the sign of a real_fixed NaN");
+        }
+        return query([](const mpfr_struct_t *v) { return mpfr_sgn(v); });
+    }
+    /// Get the sign bit.
+    /**
+     * @return the sign bit of \p this.
+     */
+    bool signbit() const
+    {
+        return m_sign < 0;
+    }
+
+    /// Negate in-place.
+    /**
+     * @return a reference to \p this.
+     */
+    real_fixed &neg()
+    {
+        m_sign = -m_sign;
+        return *this;
+    }
+    /// In-place absolute value.
+    /**
+     * @return a reference to \p this.
+     */
+    real_fixed &abs()
+    {
+        m_sign = 1;
+        return *this;
+    }
+
+private:
+    // Constructor used by real_fixed_ops to create return values.
+    struct uninit_t {
+    };
+    // NOTE: the exponent is set to a valid value for a regular number, so that
+    // we never build views from indeterminate values. The significand
+    // is left uninitialised.
+    explicit real_fixed(const uninit_t &) : m_sign(1), m_exp(1) {}
+    // Implementation of the string constructors.
+    void string_ctor(const char *s, int base)
+    {
+        detail::real_fixed_ops<P>::set_str(*this, s, base);
+    }
+    void string_ctor(const std::string &s, int base)
+    {
+        string_ctor(s.c_str(), base);
+    }
+#if defined(MPPP_HAVE_STRING_VIEW)
+    void string_ctor(const std::string_view &s, int base)
+    {
+        // NOTE: mpfr_set_str() needs a null-terminated string.
+        string_ctor(std::string(s), base);
+    }
+#endif
+    // Run a query function on a view of this.
+    template <typename F>
+    auto query(const F &f) const -> decltype(f(static_cast<const mpfr_struct_t *>(nullptr)))
+    {
+        mpfr_struct_t v;
+        detail::real_fixed_ops<P>::view(v, *this);
+        return f(&v);
+    }
+
+    ::mpfr_sign_t m_sign;
+    ::mpfr_exp_t m_exp;
+    std::array<::mp_limb_t, detail::real_fixed_nlimbs<P>()> m_limbs;
+};
+
+/// Output stream operator for \link mppp::real_fixed real_fixed\endlink.
+/**
+ * @param os the target stream.
+ * @param x the input value.
+ *
+ * @return a reference to \p os.
+ *
+ * @throws unspecified any exception thrown by the stream operator of \link mppp::real real\endlink.
+ */
+template <::mpfr_prec_t P>
+inline std::ostream &operator<<(std::ostream &os, const real_fixed<P> &x)
+{
+    return os << static_cast<real>(x);
+}
+
+// Implementation of the unary MPFR functions for real_fixed.
+#define MPPP_REAL_FIXED_MPFR_UNARY(name, fname)                                                                        \
+    template <::mpfr_prec_t P>                                                                                         \
+    inline real_fixed<P> &name(real_fixed<P> &rop, const real_fixed<P> &op)                                            \
+    {                                                                                                                  \
+        detail::real_fixed_ops<P>::unary(fname, rop, op);                                                              \
+        return rop;                                                                                                    \
+    }                                                                                                                  \
+    template <::mpfr_prec_t P>                                                                                         \
+    inline real_fixed<P> name(const real_fixed<P> &op)                                                                 \
+    {                                                                                                                  \
+        auto ret = detail::real_fixed_ops<P>::make();                                                                  \
+        detail::real_fixed_ops<P>::unary(fname, ret, op);                                                              \
+        return ret;                                                                                                    \
+    }
+
+// Implementation of the binary MPFR functions for real_fixed.
+#define MPPP_REAL_FIXED_MPFR_BINARY(name, fname)                                                                       \
+    template <::mpfr_prec_t P>                                                                                         \
+    inline real_fixed<P> &name(real_fixed<P> &rop, const real_fixed<P> &a, const real_fixed<P> &b)                     \
+    {                                                                                                                  \
+        detail::real_fixed_ops<P>::binary(fname, rop, a, b);                                                           \
+        return rop;                                                                                                    \
+    }                                                                                                                  \
+    template <::mpfr_prec_t P>                                                                                         \
+    inline real_fixed<P> name(const real_fixed<P> &a, const real_fixed<P> &b)                                          \
+    {                                                                                                                  \
+        auto ret = detail::real_fixed_ops<P>::make();                                                                  \
+        detail::real_fixed_ops<P>::binary(fname, ret, a, b);                                                           \
+        return ret;                                                                                                    \
+    }
+
+// Implementation of the ternary MPFR functions for real_fixed.
+#define MPPP_REAL_FIXED_MPFR_TERNARY(name, fname)                                                                      \
+    template <::mpfr_prec_t P>                                                                                         \
+    inline real_fixed<P> &name(real_fixed<P> &rop, const real_fixed<P> &a, const real_fixed<P> &b,                     \
+                               const real_fixed<P> &c)                                                                 \
+    {                                                                                                                  \
+        detail::real_fixed_ops<P>::ternary(fname, rop, a, b, c);                                                       \
+        return rop;                                                                                                    \
+    }                                                                                                                  \
+    template <::mpfr_prec_t P>                                                                                         \
+    inline real_fixed<P> name(const real_fixed<P> &a, const real_fixed<P> &b, const real_fixed<P> &c)                  \
+    {                                                                                                                  \
+        auto ret = detail::real_fixed_ops<P>::make();                                                                  \
+        detail::real_fixed_ops<P>::ternary(fname, ret, a, b, c);                                                       \
+        return ret;                                                                                                    \
+    }
+
+// Basic arithmetic.
+MPPP_REAL_FIXED_MPFR_BINARY(add, ::mpfr_add)
+MPPP_REAL_FIXED_MPFR_BINARY(sub, ::mpfr_sub)
+MPPP_REAL_FIXED_MPFR_BINARY(mul, ::mpfr_mul)
+MPPP_REAL_FIXED_MPFR_BINARY(div, ::mpfr_div)
+MPPP_REAL_FIXED_MPFR_TERNARY(fma, ::mpfr_fma)
+MPPP_REAL_FIXED_MPFR_TERNARY(fms, ::mpfr_fms)
+MPPP_REAL_FIXED_MPFR_UNARY(neg, ::mpfr_neg)
+MPPP_REAL_FIXED_MPFR_UNARY(abs, ::mpfr_abs)
+
+// Roots and powers.
+MPPP_REAL_FIXED_MPFR_UNARY(sqrt, ::mpfr_sqrt)
+MPPP_REAL_FIXED_MPFR_UNARY(rec_sqrt, ::mpfr_rec_sqrt)
+MPPP_REAL_FIXED_MPFR_UNARY(cbrt, ::mpfr_cbrt)
+MPPP_REAL_FIXED_MPFR_UNARY(sqr, ::mpfr_sqr)
+MPPP_REAL_FIXED_MPFR_BINARY(pow, ::mpfr_pow)
+MPPP_REAL_FIXED_MPFR_BINARY(hypot, ::mpfr_hypot)
+
+// Trigonometric functions.
+MPPP_REAL_FIXED_MPFR_UNARY(sin, ::mpfr_sin)
+MPPP_REAL_FIXED_MPFR_UNARY(cos, ::mpfr_cos)
+MPPP_REAL_FIXED_MPFR_UNARY(tan, ::mpfr_tan)
+MPPP_REAL_FIXED_MPFR_UNARY(sec, ::mpfr_sec)
+MPPP_REAL_FIXED_MPFR_UNARY(csc, ::mpfr_csc)
+MPPP_REAL_FIXED_MPFR_UNARY(cot, ::mpfr_cot)
+MPPP_REAL_FIXED_MPFR_UNARY(asin, ::mpfr_asin)
+MPPP_REAL_FIXED_MPFR_UNARY(acos, ::mpfr_acos)
+MPPP_REAL_FIXED_MPFR_UNARY(atan, ::mpfr_atan)
+MPPP_REAL_FIXED_MPFR_BINARY(atan2, ::mpfr_atan2)
+
+// Hyperbolic functions.
+MPPP_REAL_FIXED_MPFR_UNARY(sinh, ::mpfr_sinh)
+MPPP_REAL_FIXED_MPFR_UNARY(cosh, ::mpfr_cosh)
+MPPP_REAL_FIXED_MPFR_UNARY(tanh, ::mpfr_tanh)
+MPPP_REAL_FIXED_MPFR_UNARY(sech, ::mpfr_sech)
+MPPP_REAL_FIXED_MPFR_UNARY(csch, ::mpfr_csch)
+MPPP_REAL_FIXED_MPFR_UNARY(coth, ::mpfr_coth)
+MPPP_REAL_FIXED_MPFR_UNARY(asinh, ::mpfr_asinh)
+MPPP_REAL_FIXED_MPFR_UNARY(acosh, ::mpfr_acosh)
+MPPP_REAL_FIXED_MPFR_UNARY(atanh, ::mpfr_atanh)
+
+// Exponentials and logarithms.
+MPPP_REAL_FIXED_MPFR_UNARY(exp, ::mpfr_exp)
+MPPP_REAL_FIXED_MPFR_UNARY(exp2, ::mpfr_exp2)
+MPPP_REAL_FIXED_MPFR_UNARY(exp10, ::mpfr_exp10)
+MPPP_REAL_FIXED_MPFR_UNARY(expm1, ::mpfr_expm1)
+MPPP_REAL_FIXED_MPFR_UNARY(log, ::mpfr_log)
+MPPP_REAL_FIXED_MPFR_UNARY(log2, ::mpfr_log2)
+MPPP_REAL_FIXED_MPFR_UNARY(log10, ::mpfr_log10)
+MPPP_REAL_FIXED_MPFR_UNARY(log1p, ::mpfr_log1p)
+
+// Gamma functions.
+MPPP_REAL_FIXED_MPFR_UNARY(gamma, ::mpfr_gamma)
+MPPP_REAL_FIXED_MPFR_UNARY(lngamma, ::mpfr_lngamma)
+MPPP_REAL_FIXED_MPFR_UNARY(lgamma, detail::real_lgamma_wrapper)
+MPPP_REAL_FIXED_MPFR_UNARY(digamma, ::mpfr_digamma)
+
+// Bessel functions.
+MPPP_REAL_FIXED_MPFR_UNARY(j0, ::mpfr_j0)
+MPPP_REAL_FIXED_MPFR_UNARY(j1, ::mpfr_j1)
+MPPP_REAL_FIXED_MPFR_UNARY(y0, ::mpfr_y0)
+MPPP_REAL_FIXED_MPFR_UNARY(y1, ::mpfr_y1)
+
+// Other special functions.
+MPPP_REAL_FIXED_MPFR_UNARY(li2, detail::real_li2_wrapper)
+MPPP_REAL_FIXED_MPFR_UNARY(eint, ::mpfr_eint)
+MPPP_REAL_FIXED_MPFR_UNARY(zeta, ::mpfr_zeta)
+MPPP_REAL_FIXED_MPFR_UNARY(erf, ::mpfr_erf)
+MPPP_REAL_FIXED_MPFR_UNARY(erfc, ::mpfr_erfc)
+MPPP_REAL_FIXED_MPFR_UNARY(ai, ::mpfr_ai)
+
+#undef MPPP_REAL_FIXED_MPFR_UNARY
+#undef MPPP_REAL_FIXED_MPFR_BINARY
+#undef MPPP_REAL_FIXED_MPFR_TERNARY
+
+/// Identity operator for \link mppp::real_fixed real_fixed\endlink.
+/**
+ * @param x the operand.
+ *
+ * @return a copy of \p x.
+ */
+template <::mpfr_prec_t P>
+inline real_fixed<P> operator+(const real_fixed<P> &x)
+{
+    return x;
+}
+
+/// Negation operator for \link mppp::real_fixed real_fixed\endlink.
+/**
+ * @param x the operand.
+ *
+ * @return the negative of \p x.
+ */
+template <::mpfr_prec_t P>
+inline real_fixed<P> operator-(const real_fixed<P> &x)
+{
+    auto ret(x);
+    ret.neg();
+    return ret;
+}
+
+// Implementation of the arithmetic operators for real_fixed.
+#define MPPP_REAL_FIXED_ARITH_OPERATOR(op, fname)                                                                      \
+    template <::mpfr_prec_t P>                                                                                         \
+    inline real_fixed<P> operator op(const real_fixed<P> &a, const real_fixed<P> &b)                                   \
+    {                                                                                                                  \
+        return fname(a, b);                                                                                            \
+    }                                                                                                                  \
+    template <::mpfr_prec_t P>                                                                                         \
+    inline real_fixed<P> &operator op##=(real_fixed<P> &a, const real_fixed<P> &b)                                     \
+    {                                                                                                                  \
+        return fname(a, a, b);                                                                                         \
+    }
+
+MPPP_REAL_FIXED_ARITH_OPERATOR(+, add)
+MPPP_REAL_FIXED_ARITH_OPERATOR(-, sub)
+MPPP_REAL_FIXED_ARITH_OPERATOR(*, mul)
+MPPP_REAL_FIXED_ARITH_OPERATOR(/, div)
+
+#undef MPPP_REAL_FIXED_ARITH_OPERATOR
+
+// Implementation of the comparison operators for real_fixed.
+// NOTE: these follow the IEEE semantics, i.e., all comparisons
+// involving NaN (except !=) return false.
+#define MPPP_REAL_FIXED_CMP_OPERATOR(op, fname)                                                                        \
+    template <::mpfr_prec_t P>                                                                                         \
+    inline bool operator op(const real_fixed<P> &a, const real_fixed<P> &b)                                            \
+    {                                                                                                                  \
+        return detail::real_fixed_ops<P>::cmp(fname, a, b) != 0;                                                       \
+    }
+
+MPPP_REAL_FIXED_CMP_OPERATOR(==, ::mpfr_equal_p)
+MPPP_REAL_FIXED_CMP_OPERATOR(<, ::mpfr_less_p)
+MPPP_REAL_FIXED_CMP_OPERATOR(<=, ::mpfr_lessequal_p)
+MPPP_REAL_FIXED_CMP_OPERATOR(>, ::mpfr_greater_p)
+MPPP_REAL_FIXED_CMP_OPERATOR(>=, ::mpfr_greaterequal_p)
+
+#undef MPPP_REAL_FIXED_CMP_OPERATOR
+
+/// Inequality operator for \link mppp::real_fixed real_fixed\endlink.
+/**
+ * @param a the first operand.
+ * @param b the second operand.
+ *
+ * @return \p true if \p a is different from \p b (or if at least one operand is NaN), \p false otherwise.
+ */
+template <::mpfr_prec_t P>
+inline bool operator!=(const real_fixed<P> &a, const real_fixed<P> &b)
+{
+    return !(a == b);
+}
+
+} // namespace mppp
+
+#endif
+
+#endif
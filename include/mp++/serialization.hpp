@@ -0,0 +1,1147 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_SERIALIZATION_HPP
+#define MPPP_SERIALIZATION_HPP
+
+#include <mp++/config.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <mp++/detail/fwd_decl.hpp>
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#if defined(MPPP_WITH_MPFR)
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/real.hpp>
+#endif
+
+#if defined(MPPP_WITH_QUADMATH)
+#include <mp++/real128.hpp>
+#endif
+
+namespace mppp
+{
+
+namespace detail
+{
+
+// The current version of the portable binary serialisation format.
+constexpr unsigned char s11n_version = 1;
+
+// Size in bytes of the header of a serialised value
+// (format version + type tag).
+constexpr std::size_t s11n_header_size = 2;
+
+// Size in bytes of a word in the serialised format.
+constexpr std::size_t s11n_word_size = 8;
+
+// Detect if the limbs can be copied verbatim into serialised words:
+// this requires a little-endian host and 64-bit limbs without nails.
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+
+constexpr bool s11n_native_limbs
+    = GMP_NUMB_BITS == 64 && nl_digits<::mp_limb_t>() == 64 && sizeof(::mp_limb_t) == s11n_word_size;
+
+#else
+
+constexpr bool s11n_native_limbs = false;
+
+#endif
+
+// Mask with the lowest n bits set, for n in [0, 64].
+constexpr std::uint_least64_t s11n_mask(unsigned n)
+{
+    return n >= 64u ? std::uint_least64_t(0xffffffffffffffffull)
+                    : static_cast<std::uint_least64_t>((std::uint_least64_t(1) << n) - 1u);
+}
+
+// Write/read a 64-bit word in little-endian order.
+inline void s11n_write_word(char *dest, std::uint_least64_t w)
+{
+    for (std::size_t i = 0; i < s11n_word_size; ++i) {
+        dest[i] = static_cast<char>(static_cast<unsigned char>((w >> (8u * i)) & 0xffu));
+    }
+}
+
+inline std::uint_least64_t s11n_read_word(const char *src)
+{
+    std::uint_least64_t retval = 0;
+    for (std::size_t i = 0; i < s11n_word_size; ++i) {
+        retval |= static_cast<std::uint_least64_t>(static_cast<unsigned char>(src[i])) << (8u * i);
+    }
+    return retval;
+}
+
+// Number of significant bits in a nonzero word.
+inline unsigned s11n_word_nbits(std::uint_least64_t w)
+{
+    unsigned retval = 0;
+    for (; w != 0u; w >>= 1) {
+        ++retval;
+    }
+    return retval;
+}
+
+// Size in bytes of the LEB128 encoding of n.
+inline std::size_t s11n_varint_size(std::uint_least64_t n)
+{
+    std::size_t retval = 1;
+    for (; n >= 128u; n >>= 7) {
+        ++retval;
+    }
+    return retval;
+}
+
+// Write the LEB128 encoding of n into dest, returning a pointer
+// past the last written byte.
+inline char *s11n_write_varint(char *dest, std::uint_least64_t n)
+{
+    for (; n >= 128u; n >>= 7) {
+        *dest++ = static_cast<char>(static_cast<unsigned char>((n & 127u) | 128u));
+    }
+    *dest++ = static_cast<char>(static_cast<unsigned char>(n));
+    return dest;
+}
+
+// Generic packing of the nl limbs at l (each holding NBits significant bits), shifted up by lshift
+// bits, into nw little-endian words starting at dest. Bits which do not fit in the nw words are
+// discarded, missing bits are set to zero.
+template <unsigned NBits, typename Limb>
+inline void s11n_pack_limbs(char *dest, std::size_t nw, const Limb *l, std::size_t nl, unsigned lshift)
+{
+    static_assert(NBits > 0u && NBits <= 64u, "Invalid number of bits.");
+    assert(lshift < 64u);
+    std::uint_least64_t acc = 0;
+    unsigned acc_bits = lshift;
+    std::size_t wi = 0;
+    for (std::size_t i = 0; i < nl && wi < nw; ++i) {
+        auto v = static_cast<std::uint_least64_t>(l[i]) & s11n_mask(NBits);
+        unsigned left = NBits;
+        while (left != 0u) {
+            const auto take = c_min(left, 64u - acc_bits);
+            acc |= (v & s11n_mask(take)) << acc_bits;
+            v = take == 64u ? 0u : (v >> take);
+            acc_bits += take;
+            left -= take;
+            if (acc_bits == 64u) {
+                if (wi < nw) {
+                    s11n_write_word(dest + wi * s11n_word_size, acc);
+                }
+                ++wi;
+                acc = 0;
+                acc_bits = 0;
+            }
+        }
+    }
+    if (acc_bits != 0u && wi < nw) {
+        s11n_write_word(dest + wi * s11n_word_size, acc);
+        ++wi;
+    }
+    for (; wi < nw; ++wi) {
+        s11n_write_word(dest + wi * s11n_word_size, 0);
+    }
+}
+
+// The inverse of s11n_pack_limbs(): read nl limbs (each holding NBits significant bits) into l
+// from the nw little-endian words starting at src, shifted down by rshift bits.
+template <unsigned NBits, typename Limb>
+inline void s11n_unpack_limbs(Limb *l, std::size_t nl, const char *src, std::size_t nw, unsigned rshift)
+{
+    static_assert(NBits > 0u && NBits <= 64u, "Invalid number of bits.");
+    assert(rshift < 64u);
+    std::size_t wi = 0;
+    auto next_word = [&wi, src, nw]() -> std::uint_least64_t {
+        return wi < nw ? s11n_read_word(src + (wi++) * s11n_word_size) : 0u;
+    };
+    auto cur = next_word() >> rshift;
+    auto avail = 64u - rshift;
+    for (std::size_t i = 0; i < nl; ++i) {
+        std::uint_least64_t v = 0;
+        unsigned got = 0;
+        while (got < NBits) {
+            if (avail == 0u) {
+                cur = next_word();
+                avail = 64u;
+            }
+            const auto take = c_min(NBits - got, avail);
+            v |= (cur & s11n_mask(take)) << got;
+            cur = take == 64u ? 0u : (cur >> take);
+            avail -= take;
+            got += take;
+        }
+        l[i] = static_cast<Limb>(v);
+    }
+}
+
+// Save/load GMP limbs, using a plain memory copy when possible.
+inline void s11n_save_limbs(char *dest, std::size_t nw, const ::mp_limb_t *l, std::size_t nl, unsigned lshift)
+{
+    if (s11n_native_limbs && lshift == 0u && nw == nl) {
+        if (nw) {
+            std::memcpy(dest, l, nw * s11n_word_size);
+        }
+    } else {
+        s11n_pack_limbs<unsigned(GMP_NUMB_BITS)>(dest, nw, l, nl, lshift);
+    }
+}
+
+inline void s11n_load_limbs(::mp_limb_t *l, std::size_t nl, const char *src, std::size_t nw, unsigned rshift)
+{
+    if (s11n_native_limbs && rshift == 0u && nw == nl) {
+        if (nl) {
+            std::memcpy(l, src, nl * s11n_word_size);
+        }
+    } else {
+        s11n_unpack_limbs<unsigned(GMP_NUMB_BITS)>(l, nl, src, nw, rshift);
+    }
+}
+
+// Readers used in the deserialisation routines. get(n) returns a pointer
+// to the next n bytes of input, which stays valid until the next invocation of get().
+// A null pointer is returned if the bytes cannot be read.
+
+// Reader from a memory buffer: throws if the buffer is too short.
+struct s11n_buffer_reader {
+    const char *get(std::size_t n)
+    {
+        if (mppp_unlikely(n > m_size - m_read)) {
+            throw std::invalid_argument("Truncated data detected in a portable binary deserialisation: "
+                                        + detail::to_string(n) + " byte(s) are needed, but only "
+                                        + detail::to_string(m_size - m_read) + " are available in the source buffer");
+        }
+        const auto retval = m_src + m_read;
+        m_read += n;
+        return retval;
+    }
+    const char *m_src;
+    std::size_t m_size;
+    std::size_t m_read;
+};
+
+// Reader from a stream: stream errors are signalled by returning a null pointer.
+struct s11n_stream_reader {
+    const char *get(std::size_t n)
+    {
+        if (n > m_buffer.size()) {
+            m_buffer.resize(safe_cast<decltype(m_buffer.size())>(n));
+        }
+        m_is.read(m_buffer.data(), safe_cast<std::streamsize>(n));
+        if (!m_is.good()) {
+            return nullptr;
+        }
+        m_read += n;
+        return m_buffer.data();
+    }
+    std::istream &m_is;
+    std::vector<char> &m_buffer;
+    std::size_t m_read;
+};
+
+// Read a LEB128-encoded value.
+template <typename Reader>
+inline bool s11n_read_varint(Reader &r, std::uint_least64_t &out)
+{
+    out = 0;
+    for (unsigned shift = 0;; shift += 7u) {
+        const auto ptr = r.get(1);
+        if (!ptr) {
+            return false;
+        }
+        const auto byte = static_cast<std::uint_least64_t>(static_cast<unsigned char>(*ptr));
+        if (mppp_unlikely(shift == 63u ? (byte & 127u) > 1u : shift > 63u)) {
+            throw std::invalid_argument(
+                "Invalid data detected in a portable binary deserialisation: a variable-length "
+                "integer does not fit in 64 bits");
+        }
+        out |= (byte & 127u) << shift;
+        if (!(byte & 128u)) {
+            return true;
+        }
+    }
+}
+
+// Small helper to compute the sum of two sizes, with overflow checking.
+inline std::size_t s11n_add_sizes(std::size_t a, std::size_t b)
+{
+    if (mppp_unlikely(b > nl_max<std::size_t>() - a)) {
+        throw std::overflow_error("Overflow in the computation of the portable binary size of a value");
+    }
+    return a + b;
+}
+
+// NOTE: this primary template is declared in fwd_decl.hpp. The specialisations
+// provide the type tag, a description for error messages, and the functions to compute the
+// size of the payload, to save the payload (returning a pointer past the end of the written data)
+// and to load the payload (returning false in case of stream errors).
+template <typename>
+struct s11n_traits {
+};
+
+template <std::size_t SSize>
+struct s11n_traits<integer<SSize>> {
+    static constexpr unsigned char tag = 0;
+    static constexpr const char *descr = "an integer";
+    // Range serialisation support.
+    static constexpr unsigned char range_tag = 4;
+    static constexpr const char *range_descr = "a range of integers";
+    using int_type = integer<SSize>;
+    // Number of words needed to represent the absolute value of n.
+    static std::size_t nwords(const integer<SSize> &n)
+    {
+        const auto nbits = n.nbits();
+        return nbits / 64u + static_cast<std::size_t>(nbits % 64u != 0u);
+    }
+    // The header of the payload: the number of words, shifted
+    // up by one bit to make room for the sign.
+    static std::uint_least64_t header(const integer<SSize> &n)
+    {
+        return (static_cast<std::uint_least64_t>(nwords(n)) << 1) | static_cast<std::uint_least64_t>(n.sgn() < 0);
+    }
+    static std::size_t payload_size(const integer<SSize> &n)
+    {
+        const auto nw = nwords(n);
+        // NOTE: no overflow is possible here, as nbits() is representable by std::size_t.
+        return s11n_varint_size(static_cast<std::uint_least64_t>(nw) << 1) + nw * s11n_word_size;
+    }
+    // Write the nw words representing the absolute value of n.
+    static char *save_words(char *dest, const integer<SSize> &n, std::size_t nw)
+    {
+        const auto &u = n._get_union();
+        s11n_save_limbs(dest, nw, u.is_static() ? u.g_st().m_limbs.data() : u.g_dy()._mp_d, n.size(), 0);
+        return dest + nw * s11n_word_size;
+    }
+    static char *save(char *dest, const integer<SSize> &n)
+    {
+        const auto hdr = header(n);
+        return save_words(s11n_write_varint(dest, hdr), n, static_cast<std::size_t>(hdr >> 1));
+    }
+    // Decode the header, returning the number of words and the sign.
+    template <typename Reader>
+    static bool load_header(Reader &r, std::size_t &nw, bool &neg)
+    {
+        std::uint_least64_t hdr;
+        if (!s11n_read_varint(r, hdr)) {
+            return false;
+        }
+        const auto nw64 = hdr >> 1;
+        neg = (hdr & 1u) != 0u;
+        if (mppp_unlikely(nw64 == 0u && neg)) {
+            throw std::invalid_argument("Invalid data detected in the portable binary deserialisation of an "
+                                        "integer: zero cannot be negative");
+        }
+        // NOTE: make sure that the size in bits of the value is representable by std::size_t.
+        if (mppp_unlikely(nw64 > nl_max<std::size_t>() / 64u)) {
+            throw std::overflow_error("Overflow in the computation of the size of an integer being deserialised "
+                                      "from the portable binary format");
+        }
+        nw = static_cast<std::size_t>(nw64);
+        return true;
+    }
+    // Load into n the value represented by the nw words at src and the sign neg.
+    static void load_words(integer<SSize> &n, const char *src, std::size_t nw, bool neg)
+    {
+        if (!nw) {
+            n.set_zero();
+            return;
+        }
+        const auto top = s11n_read_word(src + (nw - 1u) * s11n_word_size);
+        if (mppp_unlikely(!top)) {
+            throw std::invalid_argument("Invalid data detected in the portable binary deserialisation of an integer: "
+                                        "the most significant word of the value cannot be zero");
+        }
+        const auto nbits = (nw - 1u) * 64u + s11n_word_nbits(top);
+        const auto asize
+            = nbits / unsigned(GMP_NUMB_BITS) + static_cast<std::size_t>(nbits % unsigned(GMP_NUMB_BITS) != 0u);
+        const auto size = safe_cast<mpz_size_t>(asize);
+        // NOTE: the data is read directly into the storage of n.
+        n.binary_load_limbs(neg ? -size : size, make_unsigned(size),
+                            [src, nw, asize](::mp_limb_t *rop) { s11n_load_limbs(rop, asize, src, nw, 0); });
+    }
+    template <typename Reader>
+    static bool load(integer<SSize> &n, Reader &r)
+    {
+        std::size_t nw;
+        bool neg;
+        if (!load_header(r, nw, neg)) {
+            return false;
+        }
+        const auto src = nw ? r.get(nw * s11n_word_size) : nullptr;
+        if (nw && !src) {
+            return false;
+        }
+        load_words(n, src, nw, neg);
+        return true;
+    }
+};
+
+template <std::size_t SSize>
+struct s11n_traits<rational<SSize>> {
+    using int_traits = s11n_traits<integer<SSize>>;
+    static constexpr unsigned char tag = 1;
+    static constexpr const char *descr = "a rational";
+    static constexpr unsigned char range_tag = 5;
+    static constexpr const char *range_descr = "a range of rationals";
+    using int_type = integer<SSize>;
+    // The payload is the numerator followed by the denominator.
+    static std::size_t payload_size(const rational<SSize> &q)
+    {
+        return s11n_add_sizes(int_traits::payload_size(q.get_num()), int_traits::payload_size(q.get_den()));
+    }
+    static char *save(char *dest, const rational<SSize> &q)
+    {
+        return int_traits::save(int_traits::save(dest, q.get_num()), q.get_den());
+    }
+    // Reset q to zero.
+    static void reset(rational<SSize> &q)
+    {
+        q._get_num().set_zero();
+        q._get_den().set_one();
+    }
+    // Check a deserialised rational. If the check fails, q is reset to zero
+    // before throwing.
+    static void check(rational<SSize> &q)
+    {
+        if (mppp_unlikely(q.get_den().sgn() != 1)) {
+            reset(q);
+            throw std::invalid_argument("Invalid data detected in the portable binary deserialisation of a rational: "
+                                        "the denominator must be positive");
+        }
+        if (mppp_unlikely(!q.get_den().is_one() && !gcd(q.get_num(), q.get_den()).is_one())) {
+            reset(q);
+            throw std::invalid_argument("Invalid data detected in the portable binary deserialisation of a rational: "
+                                        "the value is not in canonical form");
+        }
+    }
+    template <typename Reader>
+    static bool load(rational<SSize> &q, Reader &r)
+    {
+        // NOTE: the numerator and the denominator are read directly into q. If
+        // anything goes wrong, reset q to zero before returning.
+        try {
+            if (!int_traits::load(q._get_num(), r) || !int_traits::load(q._get_den(), r)) {
+                reset(q);
+                return false;
+            }
+        } catch (...) {
+            reset(q);
+            throw;
+        }
+        check(q);
+        return true;
+    }
+};
+
+#if defined(MPPP_WITH_MPFR)
+
+template <>
+struct s11n_traits<real> {
+    static constexpr unsigned char tag = 2;
+    static constexpr const char *descr = "a real";
+    // The kinds of real values. The kind is stored in the lower
+    // 7 bits of a byte, the sign in the highest bit.
+    static constexpr unsigned char zero_kind = 0, regular_kind = 1, inf_kind = 2, nan_kind = 3;
+    // Number of limbs in the significand of a real with precision p.
+    static std::size_t nlimbs(::mpfr_prec_t p)
+    {
+        return static_cast<std::size_t>(p / GMP_NUMB_BITS + static_cast<::mpfr_prec_t>(p % GMP_NUMB_BITS != 0));
+    }
+    // Number of words in the serialised significand of a real with precision p.
+    static std::size_t nwords(::mpfr_prec_t p)
+    {
+        return static_cast<std::size_t>(p / 64 + static_cast<::mpfr_prec_t>(p % 64 != 0));
+    }
+    // Zigzag encoding of the exponent.
+    static std::uint_least64_t encode_exp(::mpfr_exp_t e)
+    {
+        return e >= 0 ? static_cast<std::uint_least64_t>(make_unsigned(e)) << 1
+                      : (static_cast<std::uint_least64_t>(nint_abs(e) - 1u) << 1) | 1u;
+    }
+    static std::size_t payload_size(const real &x)
+    {
+        const auto p = x.get_prec();
+        auto retval = s11n_varint_size(static_cast<std::uint_least64_t>(p)) + 1u;
+        if (x.regular_p()) {
+            retval += s11n_varint_size(encode_exp(mpfr_get_exp(x.get_mpfr_t()))) + nwords(p) * s11n_word_size;
+        }
+        return retval;
+    }
+    static char *save(char *dest, const real &x)
+    {
+        const auto p = x.get_prec();
+        dest = s11n_write_varint(dest, static_cast<std::uint_least64_t>(p));
+        if (x.nan_p()) {
+            *dest++ = static_cast<char>(nan_kind);
+            return dest;
+        }
+        const auto sign = static_cast<unsigned char>(x.signbit() ? 128u : 0u);
+        if (x.inf_p()) {
+            *dest++ = static_cast<char>(static_cast<unsigned char>(inf_kind | sign));
+            return dest;
+        }
+        if (x.zero_p()) {
+            *dest++ = static_cast<char>(static_cast<unsigned char>(zero_kind | sign));
+            return dest;
+        }
+        *dest++ = static_cast<char>(static_cast<unsigned char>(regular_kind | sign));
+        dest = s11n_write_varint(dest, encode_exp(mpfr_get_exp(x.get_mpfr_t())));
+        // NOTE: the significand is stored left-aligned in the words, exactly as MPFR
+        // stores it left-aligned in the limbs.
+        const auto nl = nlimbs(p), nw = nwords(p);
+        s11n_save_limbs(dest, nw, x.get_mpfr_t()->_mpfr_d, nl,
+                        static_cast<unsigned>(nw * 64u - nl * unsigned(GMP_NUMB_BITS)));
+        return dest + nw * s11n_word_size;
+    }
+    template <typename Reader>
+    static bool load(real &x, Reader &r)
+    {
+        std::uint_least64_t p64;
+        if (!s11n_read_varint(r, p64)) {
+            return false;
+        }
+        if (mppp_unlikely(p64 < make_unsigned(real_prec_min()) || p64 > make_unsigned(real_prec_max()))) {
+            throw std::invalid_argument("Invalid data detected in the portable binary deserialisation of a real: the "
+                                        "precision "
+                                        + detail::to_string(p64) + " is outside the allowed range");
+        }
+        const auto p = static_cast<::mpfr_prec_t>(p64);
+        const auto kptr = r.get(1);
+        if (!kptr) {
+            return false;
+        }
+        const auto kind = static_cast<unsigned char>(static_cast<unsigned char>(*kptr) & 127u);
+        const bool neg = (static_cast<unsigned char>(*kptr) & 128u) != 0u;
+        if (mppp_unlikely(kind > nan_kind || (kind == nan_kind && neg))) {
+            throw std::invalid_argument("Invalid data detected in the portable binary deserialisation of a real: "
+                                        "invalid kind byte "
+                                        + std::to_string(static_cast<unsigned>(static_cast<unsigned char>(*kptr))));
+        }
+        if (kind != regular_kind) {
+            x.set_prec(p);
+            switch (kind) {
+                case zero_kind:
+                    mpfr_set_zero(x._get_mpfr_t(), neg ? -1 : 1);
+                    break;
+                case inf_kind:
+                    ::mpfr_set_inf(x._get_mpfr_t(), neg ? -1 : 1);
+                    break;
+                default:
+                    // NOTE: set_prec() already set x to NaN.
+                    assert(kind == nan_kind);
+            }
+            return true;
+        }
+        // Decode the exponent, checking that it is within the current exponent range.
+        std::uint_least64_t e64;
+        if (!s11n_read_varint(r, e64)) {
+            return false;
+        }
+        const auto emin = ::mpfr_get_emin(), emax = ::mpfr_get_emax();
+        const auto e_abs = e64 >> 1;
+        const bool e_neg = (e64 & 1u) != 0u;
+        if (mppp_unlikely(e_neg ? (emin >= 0 || e_abs >= nint_abs(emin)) : (emax < 0 || e_abs > make_unsigned(emax)))) {
+            throw std::invalid_argument("Invalid data detected in the portable binary deserialisation of a real: the "
+                                        "exponent is outside the current exponent range");
+        }
+        const auto e = e_neg ? static_cast<::mpfr_exp_t>(-static_cast<::mpfr_exp_t>(e_abs) - 1)
+                             : static_cast<::mpfr_exp_t>(e_abs);
+        // Check the significand before touching x.
+        const auto nl = nlimbs(p), nw = nwords(p);
+        const auto src = r.get(nw * s11n_word_size);
+        if (!src) {
+            return false;
+        }
+        const auto pad = static_cast<unsigned>(nw * 64u - static_cast<std::size_t>(p));
+        if (mppp_unlikely(!(s11n_read_word(src + (nw - 1u) * s11n_word_size) >> 63)
+                          || (s11n_read_word(src) & s11n_mask(pad)) != 0u)) {
+            throw std::invalid_argument("Invalid data detected in the portable binary deserialisation of a real: the "
+                                        "significand is not normalised");
+        }
+        x.set_prec(p);
+        s11n_load_limbs(x._get_mpfr_t()->_mpfr_d, nl, src, nw,
+                        static_cast<unsigned>(nw * 64u - nl * unsigned(GMP_NUMB_BITS)));
+        mpfr_custom_init_set(x._get_mpfr_t(), neg ? -MPFR_REGULAR_KIND : MPFR_REGULAR_KIND, e, p,
+                             x._get_mpfr_t()->_mpfr_d);
+        return true;
+    }
+};
+
+#endif
+
+#if defined(MPPP_WITH_QUADMATH)
+
+template <>
+struct s11n_traits<real128> {
+    static constexpr unsigned char tag = 3;
+    static constexpr const char *descr = "a real128";
+    // The payload is the IEEE binary128 representation of the
+    // value, as a little-endian 128-bit unsigned integer.
+    static std::size_t payload_size(const real128 &)
+    {
+        return 2u * s11n_word_size;
+    }
+    static char *save(char *dest, const real128 &x)
+    {
+        ieee_float128 ie;
+        ie.value = x.m_value;
+        s11n_write_word(dest, static_cast<std::uint_least64_t>(ie.i_eee.mant_low));
+        s11n_write_word(dest + s11n_word_size, (static_cast<std::uint_least64_t>(ie.i_eee.negative) << 63)
+                                                   | (static_cast<std::uint_least64_t>(ie.i_eee.exponent) << 48)
+                                                   | static_cast<std::uint_least64_t>(ie.i_eee.mant_high));
+        return dest + 2u * s11n_word_size;
+    }
+    template <typename Reader>
+    static bool load(real128 &x, Reader &r)
+    {
+        const auto src = r.get(2u * s11n_word_size);
+        if (!src) {
+            return false;
+        }
+        const auto lo = s11n_read_word(src), hi = s11n_read_word(src + s11n_word_size);
+        ieee_float128 ie;
+        ie.i_eee.mant_low = lo & s11n_mask(64);
+        ie.i_eee.mant_high = hi & 0xffffffffffffull;
+        ie.i_eee.exponent = static_cast<std::uint_least16_t>((hi >> 48) & 0x7fffu);
+        ie.i_eee.negative = (hi >> 63) != 0u;
+        x = real128{ie.value};
+        return true;
+    }
+};
+
+#endif
+
+// Detect types supporting portable binary serialisation.
+template <typename T>
+using s11n_tag_t = decltype(s11n_traits<T>::tag);
+
+template <typename T>
+using is_portable_serialisable = is_detected<s11n_tag_t, T>;
+
+// Save x, including the header, into dest, returning the number of bytes written.
+template <typename T>
+inline std::size_t s11n_save_impl(char *dest, const T &x)
+{
+    dest[0] = static_cast<char>(s11n_version);
+    dest[1] = static_cast<char>(s11n_traits<T>::tag);
+    const auto end = s11n_traits<T>::save(dest + s11n_header_size, x);
+    return static_cast<std::size_t>(end - dest);
+}
+
+// Check the version and the type tag in the header of a serialised value.
+inline void s11n_check_header(const char *hdr, unsigned char expected_tag, const char *descr)
+{
+    const auto version = static_cast<unsigned char>(hdr[0]), tag = static_cast<unsigned char>(hdr[1]);
+    if (mppp_unlikely(version == 0u || version > s11n_version)) {
+        throw std::invalid_argument("Unsupported version " + std::to_string(static_cast<unsigned>(version))
+                                    + " of the portable binary serialisation format detected (the current version is "
+                                    + std::to_string(static_cast<unsigned>(s11n_version)) + ")");
+    }
+    if (mppp_unlikely(tag != expected_tag)) {
+        throw std::invalid_argument(std::string("Invalid type tag detected in the portable binary deserialisation of ")
+                                    + descr + ": the expected tag is "
+                                    + std::to_string(static_cast<unsigned>(expected_tag)) + ", but the tag "
+                                    + std::to_string(static_cast<unsigned>(tag)) + " was found instead");
+    }
+}
+
+// Load x, including the header, from r.
+template <typename T, typename Reader>
+inline bool s11n_load_impl(T &x, Reader &r)
+{
+    const auto hdr = r.get(s11n_header_size);
+    if (!hdr) {
+        return false;
+    }
+    s11n_check_header(hdr, s11n_traits<T>::tag, s11n_traits<T>::descr);
+    return s11n_traits<T>::load(x, r);
+}
+
+// Range serialisation. A range of values is serialised as a header (format version + range tag),
+// followed by the number of values, the total number of words of the integers in the range (stored
+// as a word), the words of all the integers in the range packed together and, finally, the
+// array of the headers of all the integers in the range.
+
+// Detect types supporting range serialisation.
+template <typename T>
+using s11n_range_tag_t = decltype(s11n_traits<T>::range_tag);
+
+template <typename T>
+using is_portable_range_serialisable = is_detected<s11n_range_tag_t, T>;
+
+// Apply f to the integers making up a value.
+template <std::size_t SSize, typename F>
+inline void s11n_for_each_int(const integer<SSize> &n, const F &f)
+{
+    f(n);
+}
+
+template <std::size_t SSize, typename F>
+inline void s11n_for_each_int(const rational<SSize> &q, const F &f)
+{
+    f(q.get_num());
+    f(q.get_den());
+}
+
+template <std::size_t SSize, typename F>
+inline void s11n_for_each_int(integer<SSize> &n, const F &f)
+{
+    f(n);
+}
+
+template <std::size_t SSize, typename F>
+inline void s11n_for_each_int(rational<SSize> &q, const F &f)
+{
+    f(q._get_num());
+    f(q._get_den());
+}
+
+// Check a value deserialised from a range.
+template <std::size_t SSize>
+inline void s11n_range_check(integer<SSize> &)
+{
+}
+
+template <std::size_t SSize>
+inline void s11n_range_check(rational<SSize> &q)
+{
+    s11n_traits<rational<SSize>>::check(q);
+}
+
+// Compute the size of the serialised representation of the range of n values starting at x.
+template <typename T>
+inline std::size_t s11n_range_size(const T *x, std::size_t n)
+{
+    using int_t = typename s11n_traits<T>::int_type;
+    std::size_t nw = 0, hdr_bytes = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        s11n_for_each_int(x[i], [&hdr_bytes, &nw](const int_t &m) {
+            const auto hdr = s11n_traits<int_t>::header(m);
+            hdr_bytes = s11n_add_sizes(hdr_bytes, s11n_varint_size(hdr));
+            nw = s11n_add_sizes(nw, static_cast<std::size_t>(hdr >> 1));
+        });
+    }
+    if (mppp_unlikely(nw > nl_max<std::size_t>() / s11n_word_size)) {
+        throw std::overflow_error("Overflow in the computation of the portable binary size of a range of values");
+    }
+    auto retval = s11n_add_sizes(s11n_header_size, s11n_varint_size(static_cast<std::uint_least64_t>(n)));
+    retval = s11n_add_sizes(retval, s11n_word_size);
+    retval = s11n_add_sizes(retval, nw * s11n_word_size);
+    return s11n_add_sizes(retval, hdr_bytes);
+}
+
+// Save the range of n values starting at x into dest, returning the number of bytes written.
+// NOTE: the range is saved in a single pass. The words are written directly into dest, while
+// the headers are accumulated into a thread-local buffer (which, in the long run, will not need
+// to allocate memory), and they are appended after the words at the end. The total number of
+// words, which is known only at the end, is written into a slot of fixed size.
+template <typename T>
+inline std::size_t s11n_save_range_impl(char *dest, const T *x, std::size_t n)
+{
+    using int_t = typename s11n_traits<T>::int_type;
+    dest[0] = static_cast<char>(s11n_version);
+    dest[1] = static_cast<char>(s11n_traits<T>::range_tag);
+    const auto nw_ptr = s11n_write_varint(dest + s11n_header_size, static_cast<std::uint_least64_t>(n));
+    const auto wbegin = nw_ptr + s11n_word_size;
+    auto wptr = wbegin;
+    MPPP_MAYBE_TLS std::vector<char> hdrs;
+    hdrs.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+        s11n_for_each_int(x[i], [&](const int_t &m) {
+            const auto hdr = s11n_traits<int_t>::header(m);
+            // NOTE: the LEB128 encoding of a 64-bit value needs at most 10 bytes.
+            char hbuf[10];
+            hdrs.insert(hdrs.end(), hbuf, s11n_write_varint(hbuf, hdr));
+            wptr = s11n_traits<int_t>::save_words(wptr, m, static_cast<std::size_t>(hdr >> 1));
+        });
+    }
+    s11n_write_word(nw_ptr, static_cast<std::uint_least64_t>(static_cast<std::size_t>(wptr - wbegin) / s11n_word_size));
+    return static_cast<std::size_t>(std::copy(hdrs.begin(), hdrs.end(), wptr) - dest);
+}
+
+// Load a range of values from the buffer of size size starting at src into out.
+template <typename T>
+inline std::size_t s11n_load_range_impl(std::vector<T> &out, const char *src, std::size_t size)
+{
+    using int_t = typename s11n_traits<T>::int_type;
+    s11n_buffer_reader r{src, size, 0};
+    s11n_check_header(r.get(s11n_header_size), s11n_traits<T>::range_tag, s11n_traits<T>::range_descr);
+    std::uint_least64_t n64;
+    s11n_read_varint(r, n64);
+    const auto nw64 = s11n_read_word(r.get(s11n_word_size));
+    if (mppp_unlikely(nw64 > nl_max<std::size_t>() / s11n_word_size)) {
+        throw std::overflow_error("Overflow in the computation of the size of a range of values being deserialised "
+                                  "from the portable binary format");
+    }
+    const auto wbytes = static_cast<std::size_t>(nw64) * s11n_word_size;
+    s11n_buffer_reader wr{r.get(wbytes), wbytes, 0};
+    // NOTE: each value needs at least one byte in the array of headers.
+    if (mppp_unlikely(n64 > size - r.m_read)) {
+        throw std::invalid_argument("Invalid data detected in the portable binary deserialisation of "
+                                    + std::string(s11n_traits<T>::range_descr)
+                                    + ": the number of values is larger than the size of the array of headers");
+    }
+    // NOTE: the existing values in out are reused, so that no allocation
+    // takes place if their storage is large enough.
+    out.resize(safe_cast<decltype(out.size())>(n64));
+    for (auto &x : out) {
+        s11n_for_each_int(x, [&r, &wr](int_t &m) {
+            std::size_t nw;
+            bool neg;
+            s11n_traits<int_t>::load_header(r, nw, neg);
+            if (mppp_unlikely(nw > (wr.m_size - wr.m_read) / s11n_word_size)) {
+                throw std::invalid_argument("Invalid data detected in the portable binary deserialisation of "
+                                            + std::string(s11n_traits<T>::range_descr)
+                                            + ": the number of words is inconsistent with the array of headers");
+            }
+            s11n_traits<int_t>::load_words(m, nw ? wr.get(nw * s11n_word_size) : nullptr, nw, neg);
+        });
+        s11n_range_check(x);
+    }
+    if (mppp_unlikely(wr.m_read != wbytes)) {
+        throw std::invalid_argument("Invalid data detected in the portable binary deserialisation of "
+                                    + std::string(s11n_traits<T>::range_descr)
+                                    + ": the number of words is inconsistent with the array of headers");
+    }
+    return r.m_read;
+}
+
+} // namespace detail
+
+template <typename T>
+using portable_serialisable_enabler = detail::enable_if_t<detail::is_portable_serialisable<T>::value, int>;
+
+template <typename T>
+using portable_range_serialisable_enabler
+    = detail::enable_if_t<detail::is_portable_range_serialisable<T>::value, int>;
+
+/** @defgroup portable_s11n portable_s11n
+ *  @{
+ */
+
+/// Size of the portable binary representation.
+/**
+ * \rststar
+ * This function will return the number of bytes necessary to serialise ``x`` via
+ * one of the :cpp:func:`~mppp::portable_binary_save()` overloads.
+ * \endrststar
+ *
+ * @param x the input value.
+ *
+ * @return the number of bytes needed for the portable binary serialisation of ``x``.
+ *
+ * @throws std::overflow_error if the size of the representation of ``x`` overflows an
+ * implementation-defined limit.
+ */
+template <typename T, portable_serialisable_enabler<T> = 0>
+inline std::size_t portable_binary_size(const T &x)
+{
+    return detail::s11n_add_sizes(detail::s11n_header_size, detail::s11n_traits<T>::payload_size(x));
+}
+
+/// Portable serialisation into a memory buffer.
+/**
+ * \rststar
+ * This function will write into ``dest`` the portable binary representation of ``x``. ``dest`` must
+ * point to a memory area whose size is at least equal to the value returned by
+ * :cpp:func:`~mppp::portable_binary_size()`, otherwise the behaviour will be undefined.
+ * ``dest`` does not have any special alignment requirements.
+ * \endrststar
+ *
+ * @param x the value to be serialised.
+ * @param dest a pointer to the destination memory buffer.
+ *
+ * @return the number of bytes written into ``dest``.
+ *
+ * @throws unspecified any exception thrown by mppp::portable_binary_size().
+ */
+template <typename T, portable_serialisable_enabler<T> = 0>
+inline std::size_t portable_binary_save(const T &x, char *dest)
+{
+    return detail::s11n_save_impl(dest, x);
+}
+
+/// Portable serialisation into a ``std::vector<char>``.
+/**
+ * \rststar
+ * This function will write into ``dest`` the portable binary representation of ``x``. If the size
+ * of ``dest`` is smaller than the value returned by :cpp:func:`~mppp::portable_binary_size()`,
+ * ``dest`` will be resized accordingly.
+ * \endrststar
+ *
+ * @param x the value to be serialised.
+ * @param dest the destination vector.
+ *
+ * @return the number of bytes written into ``dest``.
+ *
+ * @throws unspecified any exception thrown by mppp::portable_binary_size(), or by memory
+ * errors in standard containers.
+ */
+template <typename T, portable_serialisable_enabler<T> = 0>
+inline std::size_t portable_binary_save(const T &x, std::vector<char> &dest)
+{
+    const auto bs = portable_binary_size(x);
+    if (dest.size() < bs) {
+        dest.resize(detail::safe_cast<decltype(dest.size())>(bs));
+    }
+    return detail::s11n_save_impl(dest.data(), x);
+}
+
+/// Portable serialisation into a ``std::ostream``.
+/**
+ * \rststar
+ * This function will write into the output stream ``dest`` the portable binary representation of ``x``,
+ * starting from the current stream position. If no stream error state is detected in ``dest`` after the
+ * write operation, the number of bytes written will be returned. Otherwise, zero will be returned.
+ * \endrststar
+ *
+ * @param x the value to be serialised.
+ * @param dest the destination stream.
+ *
+ * @return the output of mppp::portable_binary_size() if the serialisation was successful, zero otherwise.
+ *
+ * @throws unspecified any exception thrown by mppp::portable_binary_size(), by memory
+ * errors in standard containers, or by the public interface of ``std::ostream``.
+ */
+template <typename T, portable_serialisable_enabler<T> = 0>
+inline std::size_t portable_binary_save(const T &x, std::ostream &dest)
+{
+    const auto bs = portable_binary_size(x);
+    MPPP_MAYBE_TLS std::vector<char> buffer;
+    if (buffer.size() < bs) {
+        buffer.resize(detail::safe_cast<decltype(buffer.size())>(bs));
+    }
+    detail::s11n_save_impl(buffer.data(), x);
+    dest.write(buffer.data(), detail::safe_cast<std::streamsize>(bs));
+    return dest.good() ? bs : 0u;
+}
+
+/// Portable deserialisation from a memory buffer.
+/**
+ * \rststar
+ * This function will load into ``x`` the portable binary representation stored at the beginning of
+ * the memory buffer of size ``size`` starting at ``src``. Data past the end of the serialised
+ * representation will be ignored.
+ *
+ * In case of errors, :cpp:class:`~mppp::integer` and :cpp:class:`~mppp::real128` values
+ * are left unmodified, while :cpp:class:`~mppp::rational` values are set to zero and
+ * :cpp:class:`~mppp::real` values are left in a valid but unspecified state.
+ * \endrststar
+ *
+ * @param x the return value.
+ * @param src the source buffer.
+ * @param size the size of the source buffer.
+ *
+ * @return the number of bytes read from ``src``.
+ *
+ * @throws std::invalid_argument if ``src`` is too short, or if invalid or unsupported data is
+ * detected in ``src``.
+ * @throws std::overflow_error if the size of the serialised value overflows an
+ * implementation-defined limit.
+ */
+template <typename T, portable_serialisable_enabler<T> = 0>
+inline std::size_t portable_binary_load(T &x, const char *src, std::size_t size)
+{
+    detail::s11n_buffer_reader r{src, size, 0};
+    detail::s11n_load_impl(x, r);
+    return r.m_read;
+}
+
+/// Portable deserialisation from a ``std::vector<char>``.
+/**
+ * \rststar
+ * Equivalent to :cpp:func:`~mppp::portable_binary_load()` invoked on the
+ * data and size of ``src``.
+ * \endrststar
+ *
+ * @param x the return value.
+ * @param src the source vector.
+ *
+ * @return the number of bytes read from ``src``.
+ *
+ * @throws unspecified any exception thrown by the pointer overload of
+ * mppp::portable_binary_load().
+ */
+template <typename T, portable_serialisable_enabler<T> = 0>
+inline std::size_t portable_binary_load(T &x, const std::vector<char> &src)
+{
+    return portable_binary_load(x, src.data(), static_cast<std::size_t>(src.size()));
+}
+
+/// Portable deserialisation from a ``std::istream``.
+/**
+ * \rststar
+ * This function will load into ``x`` the portable binary representation stored in ``src``,
+ * starting from the current stream position. If a stream error state is detected
+ * at any point of the deserialisation process, zero will be returned.
+ * \endrststar
+ *
+ * @param x the return value.
+ * @param src the source stream.
+ *
+ * @return the number of bytes read from ``src``, or zero if a stream error occurs.
+ *
+ * @throws unspecified any exception thrown by the pointer overload of
+ * mppp::portable_binary_load() (apart from the exception thrown by truncated input), by
+ * memory errors in standard containers, or by the public interface of ``std::istream``.
+ */
+template <typename T, portable_serialisable_enabler<T> = 0>
+inline std::size_t portable_binary_load(T &x, std::istream &src)
+{
+    MPPP_MAYBE_TLS std::vector<char> buffer;
+    detail::s11n_stream_reader r{src, buffer, 0};
+    return detail::s11n_load_impl(x, r) ? r.m_read : 0u;
+}
+
+/// Size of the portable binary representation of a range.
+/**
+ * \rststar
+ * This function will return the number of bytes necessary to serialise the ``n`` values
+ * starting at ``x`` via one of the :cpp:func:`~mppp::binary_save_range()` overloads.
+ * ``T`` must be either an :cpp:class:`~mppp::integer` or a :cpp:class:`~mppp::rational`.
+ * \endrststar
+ *
+ * @param x a pointer to the beginning of the range.
+ * @param n the number of values in the range.
+ *
+ * @return the number of bytes needed for the portable binary serialisation of the range.
+ *
+ * @throws std::overflow_error if the size of the representation of the range overflows an
+ * implementation-defined limit.
+ */
+template <typename T, portable_range_serialisable_enabler<T> = 0>
+inline std::size_t binary_range_size(const T *x, std::size_t n)
+{
+    return detail::s11n_range_size(x, n);
+}
+
+/// Portable serialisation of a range into a memory buffer.
+/**
+ * \rststar
+ * This function will write into ``dest`` the portable binary representation of the ``n`` values
+ * starting at ``x``. ``dest`` must point to a memory area whose size is at least equal to the value
+ * returned by :cpp:func:`~mppp::binary_range_size()`, otherwise the behaviour will be undefined.
+ * ``T`` must be either an :cpp:class:`~mppp::integer` or a :cpp:class:`~mppp::rational`.
+ *
+ * Rather than a sequence of individually-serialised values, the representation consists
+ * of a single header, an array containing the sizes and signs of all the integers in the range,
+ * and the absolute values of all the integers in the range packed together. This makes the
+ * serialisation of large ranges of small values considerably faster and more compact
+ * than repeated invocations of :cpp:func:`~mppp::portable_binary_save()`.
+ * \endrststar
+ *
+ * @param x a pointer to the beginning of the range.
+ * @param n the number of values in the range.
+ * @param dest a pointer to the destination memory buffer.
+ *
+ * @return the number of bytes written into ``dest``.
+ *
+ * @throws unspecified any exception thrown by mppp::binary_range_size().
+ */
+template <typename T, portable_range_serialisable_enabler<T> = 0>
+inline std::size_t binary_save_range(const T *x, std::size_t n, char *dest)
+{
+    return detail::s11n_save_range_impl(dest, x, n);
+}
+
+/// Portable serialisation of a range into a ``std::vector<char>``.
+/**
+ * \rststar
+ * This function will write into ``dest`` the portable binary representation of the ``n`` values
+ * starting at ``x``. If the size of ``dest`` is smaller than the value returned by
+ * :cpp:func:`~mppp::binary_range_size()`, ``dest`` will be resized accordingly.
+ * \endrststar
+ *
+ * @param x a pointer to the beginning of the range.
+ * @param n the number of values in the range.
+ * @param dest the destination vector.
+ *
+ * @return the number of bytes written into ``dest``.
+ *
+ * @throws unspecified any exception thrown by mppp::binary_range_size(), or by memory
+ * errors in standard containers.
+ */
+template <typename T, portable_range_serialisable_enabler<T> = 0>
+inline std::size_t binary_save_range(const T *x, std::size_t n, std::vector<char> &dest)
+{
+    const auto bs = detail::s11n_range_size(x, n);
+    if (dest.size() < bs) {
+        dest.resize(detail::safe_cast<decltype(dest.size())>(bs));
+    }
+    return detail::s11n_save_range_impl(dest.data(), x, n);
+}
+
+/// Portable deserialisation of a range from a memory buffer.
+/**
+ * \rststar
+ * This function will load into ``out`` the range of values whose portable binary representation,
+ * produced by one of the :cpp:func:`~mppp::binary_save_range()` overloads, is stored
+ * at the beginning of the memory buffer of size ``size`` starting at ``src``. ``out`` will be resized
+ * to the number of values in the range. The values already present in ``out`` are overwritten
+ * in-place, so that their storage is reused whenever possible.
+ *
+ * In case of errors, the values in ``out`` are left in a valid but unspecified state.
+ * \endrststar
+ *
+ * @param out the return value.
+ * @param src the source buffer.
+ * @param size the size of the source buffer.
+ *
+ * @return the number of bytes read from ``src``.
+ *
+ * @throws std::invalid_argument if ``src`` is too short, or if invalid or unsupported data is
+ * detected in ``src``.
+ * @throws std::overflow_error if the size of the serialised range overflows an
+ * implementation-defined limit.
+ * @throws unspecified any exception thrown by memory errors in standard containers.
+ */
+template <typename T, portable_range_serialisable_enabler<T> = 0>
+inline std::size_t binary_load_range(std::vector<T> &out, const char *src, std::size_t size)
+{
+    return detail::s11n_load_range_impl(out, src, size);
+}
+
+/// Portable deserialisation of a range from a ``std::vector<char>``.
+/**
+ * \rststar
+ * Equivalent to :cpp:func:`~mppp::binary_load_range()` invoked on the
+ * data and size of ``src``.
+ * \endrststar
+ *
+ * @param out the return value.
+ * @param src the source vector.
+ *
+ * @return the number of bytes read from ``src``.
+ *
+ * @throws unspecified any exception thrown by the pointer overload of
+ * mppp::binary_load_range().
+ */
+template <typename T, portable_range_serialisable_enabler<T> = 0>
+inline std::size_t binary_load_range(std::vector<T> &out, const std::vector<char> &src)
+{
+    return binary_load_range(out, src.data(), static_cast<std::size_t>(src.size()));
+}
+
+/** @} */
+
+} // namespace mppp
+
+#endif
@@ -0,0 +1,865 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_WIDE_UINT_HPP
+#define MPPP_WIDE_UINT_HPP
+
+#include <mp++/config.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include <mp++/concepts.hpp>
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/exceptions.hpp>
+#include <mp++/integer.hpp>
+
+namespace mppp
+{
+
+namespace detail
+{
+
+// Multiply two limbs, returning the lower half of the result and
+// writing the upper half into hi. This is a constexpr-friendly counterpart
+// of dlimb_mul().
+MPPP_CONSTEXPR_14 inline ::mp_limb_t wide_uint_mul_limb(::mp_limb_t a, ::mp_limb_t b, ::mp_limb_t &hi)
+{
+#if defined(MPPP_HAVE_GCC_INT128) && GMP_NUMB_BITS == 64
+    const auto ret = static_cast<__uint128_t>(a) * b;
+    hi = static_cast<::mp_limb_t>(ret >> 64);
+    return static_cast<::mp_limb_t>(ret);
+#else
+    // Schoolbook multiplication on half-limbs.
+    constexpr unsigned half = unsigned(GMP_NUMB_BITS) / 2u;
+    constexpr ::mp_limb_t lo_mask = (::mp_limb_t(1) << half) - 1u;
+    const auto a0 = a & lo_mask, a1 = a >> half, b0 = b & lo_mask, b1 = b >> half;
+    const auto p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    // NOTE: mid cannot overflow, as it is the sum of 3 half-limb values.
+    const auto mid = (p00 >> half) + (p01 & lo_mask) + (p10 & lo_mask);
+    hi = p11 + (p01 >> half) + (p10 >> half) + (mid >> half);
+    return (p00 & lo_mask) | (mid << half);
+#endif
+}
+
+} // namespace detail
+
+/// Fixed-width unsigned integer.
+/**
+ * \rststar
+ * *#include <mp++/wide_uint.hpp>*
+ *
+ * .. versionadded:: 0.20
+ *
+ * This class represents an unsigned integer with a width of ``Bits`` bits, which must be a positive multiple of
+ * ``GMP_NUMB_BITS``. The value is stored in an array of limbs (in little-endian order) with no
+ * dynamic fallback: arithmetic is performed modulo :math:`2^{\mathrm{Bits}}` (that is, it wraps around
+ * like the arithmetic of C++ unsigned integral types), and objects of this class never allocate memory.
+ * The functions :cpp:func:`~mppp::add_overflow()`, :cpp:func:`~mppp::sub_overflow()`
+ * and :cpp:func:`~mppp::mul_overflow()` can be used to detect wrap-around.
+ *
+ * Unlike :cpp:class:`~mppp::integer`, there is no branching on the storage type,
+ * and, in C++14 and later, all the operations except division, conversion to string and
+ * interoperability with :cpp:class:`~mppp::integer` are ``constexpr``. This makes this class suitable
+ * for hashing and fixed-size (e.g., 256 or 512 bits) arithmetic in tight loops where
+ * the bit width of the values is known in advance.
+ *
+ * Mixed-mode operations with C++ integral types are supported via the implicit
+ * constructor from C++ integral types (negative values are wrapped modulo :math:`2^{\mathrm{Bits}}`).
+ * \endrststar
+ */
+template <std::size_t Bits>
+class wide_uint
+{
+    static_assert(Bits > 0u && Bits % unsigned(GMP_NUMB_BITS) == 0u,
+                  "The width of a wide_uint must be a positive multiple of GMP_NUMB_BITS.");
+    static_assert(!GMP_NAIL_BITS, "wide_uint is not available when GMP uses nail bits.");
+
+public:
+    /// The number of limbs.
+    static constexpr std::size_t nlimbs = Bits / unsigned(GMP_NUMB_BITS);
+    /// Default constructor.
+    /**
+     * The value will be initialised to zero.
+     */
+    constexpr wide_uint() : m_limbs{} {}
+    /// Generic constructor from C++ integral types.
+    /**
+     * @param n the value that will be used for the initialisation, modulo \f$2^{\mathrm{Bits}}\f$.
+     */
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <CppIntegralInteroperable T>
+#else
+    template <typename T, cpp_integral_interoperable_enabler<T> = 0>
+#endif
+    MPPP_CONSTEXPR_14 wide_uint(const T &n) : m_limbs{}
+    {
+        init_from_integral(n, detail::is_signed<T>{});
+    }
+    /// Constructor from \link mppp::integer integer\endlink.
+    /**
+     * @param n the value that will be used for the initialisation, modulo \f$2^{\mathrm{Bits}}\f$.
+     */
+    template <std::size_t SSize>
+    explicit wide_uint(const integer<SSize> &n) : m_limbs{}
+    {
+        const auto v = n.get_mpz_view();
+        const detail::mpz_struct_t *ptr = v;
+        const auto size = ::mpz_size(ptr);
+        for (std::size_t i = 0; i < nlimbs && i < size; ++i) {
+            m_limbs[i] = ptr->_mp_d[i];
+        }
+        if (ptr->_mp_size < 0) {
+            neg();
+        }
+    }
+    /// Conversion to C++ unsigned integral types and \p bool.
+    /**
+     * The conversion to \p bool returns \p true if \p this is nonzero, otherwise
+     * the value of \p this is reduced modulo the range of \p T.
+     *
+     * @return the value of \p this converted to \p T.
+     */
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <CppUnsignedIntegralInteroperable T>
+#else
+    template <typename T, cpp_unsigned_integral_interoperable_enabler<T> = 0>
+#endif
+    MPPP_CONSTEXPR_14 explicit operator T() const
+    {
+        if (std::is_same<T, bool>::value) {
+            return static_cast<T>(!is_zero());
+        }
+        T retval(0);
+        unsigned shift = 0;
+        for (std::size_t i = 0; i < nlimbs && shift < unsigned(detail::nl_digits<T>()); ++i) {
+            retval = static_cast<T>(retval | static_cast<T>(static_cast<T>(m_limbs[i]) << shift));
+            shift += unsigned(GMP_NUMB_BITS);
+        }
+        return retval;
+    }
+    /// Conversion to \link mppp::integer integer\endlink.
+    /**
+     * @return the value of \p this as an \link mppp::integer integer\endlink.
+     */
+    template <std::size_t SSize>
+    explicit operator integer<SSize>() const
+    {
+        return integer<SSize>{m_limbs, size()};
+    }
+    /// Const limb access.
+    /**
+     * @return a pointer to the array of limbs (in little-endian order).
+     */
+    constexpr const ::mp_limb_t *data() const
+    {
+        return m_limbs;
+    }
+    /// Mutable limb access.
+    /**
+     * @return a pointer to the array of limbs (in little-endian order).
+     */
+    MPPP_CONSTEXPR_14 ::mp_limb_t *data()
+    {
+        return m_limbs;
+    }
+    /// Significant size.
+    /**
+     * @return the number of limbs needed to represent \p this (that is, the index of the most significant
+     * nonzero limb plus one, or zero if \p this is zero).
+     */
+    MPPP_CONSTEXPR_14 std::size_t size() const
+    {
+        std::size_t retval = nlimbs;
+        for (; retval && !m_limbs[retval - 1u]; --retval) {
+        }
+        return retval;
+    }
+    /// Test if zero.
+    /**
+     * @return \p true if \p this is zero, \p false otherwise.
+     */
+    MPPP_CONSTEXPR_14 bool is_zero() const
+    {
+        return size() == 0u;
+    }
+    /// Number of significant bits.
+    /**
+     * @return the number of bits needed to represent \p this (zero if \p this is zero).
+     */
+    MPPP_CONSTEXPR_14 std::size_t nbits() const
+    {
+        const auto s = size();
+        if (!s) {
+            return 0;
+        }
+        std::size_t retval = (s - 1u) * unsigned(GMP_NUMB_BITS);
+        for (auto l = m_limbs[s - 1u]; l; l >>= 1) {
+            ++retval;
+        }
+        return retval;
+    }
+    /// In-place negation.
+    /**
+     * This function will set \p this to \f$2^{\mathrm{Bits}} - \mathrm{this}\f$ (modulo \f$2^{\mathrm{Bits}}\f$).
+     *
+     * @return a reference to \p this.
+     */
+    MPPP_CONSTEXPR_14 wide_uint &neg()
+    {
+        ::mp_limb_t carry = 1;
+        for (std::size_t i = 0; i < nlimbs; ++i) {
+            m_limbs[i] = static_cast<::mp_limb_t>(~m_limbs[i] + carry);
+            carry = static_cast<::mp_limb_t>(carry && !m_limbs[i]);
+        }
+        return *this;
+    }
+    /// Convert to string.
+    /**
+     * @param base the desired base.
+     *
+     * @return a string representation of \p this in base \p base.
+     *
+     * @throws unspecified any exception thrown by mppp::integer::to_string().
+     */
+    std::string to_string(int base = 10) const
+    {
+        return static_cast<integer<1>>(*this).to_string(base);
+    }
+
+    /// Addition with carry detection.
+    /**
+     * @param rop the return value.
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return \p true if the sum wrapped around, \p false otherwise.
+     */
+    friend MPPP_CONSTEXPR_14 bool add_overflow(wide_uint &rop, const wide_uint &a, const wide_uint &b)
+    {
+        ::mp_limb_t carry = 0;
+        for (std::size_t i = 0; i < nlimbs; ++i) {
+            const auto s = static_cast<::mp_limb_t>(a.m_limbs[i] + b.m_limbs[i]);
+            const auto c1 = static_cast<::mp_limb_t>(s < a.m_limbs[i]);
+            rop.m_limbs[i] = static_cast<::mp_limb_t>(s + carry);
+            carry = static_cast<::mp_limb_t>(c1 | static_cast<::mp_limb_t>(rop.m_limbs[i] < s));
+        }
+        return carry != 0u;
+    }
+    /// Subtraction with borrow detection.
+    /**
+     * @param rop the return value.
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return \p true if the difference wrapped around (i.e., if \p a is less than \p b), \p false otherwise.
+     */
+    friend MPPP_CONSTEXPR_14 bool sub_overflow(wide_uint &rop, const wide_uint &a, const wide_uint &b)
+    {
+        ::mp_limb_t borrow = 0;
+        for (std::size_t i = 0; i < nlimbs; ++i) {
+            const auto d = static_cast<::mp_limb_t>(a.m_limbs[i] - b.m_limbs[i]);
+            const auto b1 = static_cast<::mp_limb_t>(a.m_limbs[i] < b.m_limbs[i]);
+            rop.m_limbs[i] = static_cast<::mp_limb_t>(d - borrow);
+            borrow = static_cast<::mp_limb_t>(b1 | static_cast<::mp_limb_t>(d < borrow));
+        }
+        return borrow != 0u;
+    }
+    /// Multiplication with overflow detection.
+    /**
+     * @param rop the return value.
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return \p true if the product wrapped around, \p false otherwise.
+     */
+    friend MPPP_CONSTEXPR_14 bool mul_overflow(wide_uint &rop, const wide_uint &a, const wide_uint &b)
+    {
+        // NOTE: compute the full product, then check the upper half.
+        ::mp_limb_t prod[nlimbs * 2u]{};
+        for (std::size_t i = 0; i < nlimbs; ++i) {
+            ::mp_limb_t carry = 0;
+            for (std::size_t j = 0; j < nlimbs; ++j) {
+                carry = mul_acc(prod[i + j], a.m_limbs[i], b.m_limbs[j], carry);
+            }
+            prod[i + nlimbs] = carry;
+        }
+        bool retval = false;
+        for (std::size_t i = 0; i < nlimbs; ++i) {
+            rop.m_limbs[i] = prod[i];
+            retval = retval || prod[i + nlimbs] != 0u;
+        }
+        return retval;
+    }
+
+    /// Identity operator.
+    /**
+     * @param a the operand.
+     *
+     * @return a copy of \p a.
+     */
+    friend constexpr wide_uint operator+(const wide_uint &a)
+    {
+        return a;
+    }
+    /// Binary addition.
+    /**
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return <tt>a + b</tt>, modulo \f$2^{\mathrm{Bits}}\f$.
+     */
+    friend MPPP_CONSTEXPR_14 wide_uint operator+(const wide_uint &a, const wide_uint &b)
+    {
+        wide_uint retval;
+        add_overflow(retval, a, b);
+        return retval;
+    }
+    /// Negation operator.
+    /**
+     * @param a the operand.
+     *
+     * @return <tt>-a</tt>, modulo \f$2^{\mathrm{Bits}}\f$.
+     */
+    friend MPPP_CONSTEXPR_14 wide_uint operator-(const wide_uint &a)
+    {
+        auto retval(a);
+        retval.neg();
+        return retval;
+    }
+    /// Binary subtraction.
+    /**
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return <tt>a - b</tt>, modulo \f$2^{\mathrm{Bits}}\f$.
+     */
+    friend MPPP_CONSTEXPR_14 wide_uint operator-(const wide_uint &a, const wide_uint &b)
+    {
+        wide_uint retval;
+        sub_overflow(retval, a, b);
+        return retval;
+    }
+    /// Binary multiplication.
+    /**
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return <tt>a * b</tt>, modulo \f$2^{\mathrm{Bits}}\f$.
+     */
+    friend MPPP_CONSTEXPR_14 wide_uint operator*(const wide_uint &a, const wide_uint &b)
+    {
+        // NOTE: compute only the lower half of the product.
+        wide_uint retval;
+        for (std::size_t i = 0; i < nlimbs; ++i) {
+            ::mp_limb_t carry = 0;
+            for (std::size_t j = 0; i + j < nlimbs; ++j) {
+                carry = mul_acc(retval.m_limbs[i + j], a.m_limbs[i], b.m_limbs[j], carry);
+            }
+        }
+        return retval;
+    }
+    /// Binary division.
+    /**
+     * @param a the dividend.
+     * @param b the divisor.
+     *
+     * @return the truncated quotient <tt>a / b</tt>.
+     *
+     * @throws zero_division_error if \p b is zero.
+     */
+    friend wide_uint operator/(const wide_uint &a, const wide_uint &b)
+    {
+        wide_uint q, r;
+        tdiv_qr(q, r, a, b);
+        return q;
+    }
+    /// Binary modulo.
+    /**
+     * @param a the dividend.
+     * @param b the divisor.
+     *
+     * @return the remainder <tt>a % b</tt>.
+     *
+     * @throws zero_division_error if \p b is zero.
+     */
+    friend wide_uint operator%(const wide_uint &a, const wide_uint &b)
+    {
+        wide_uint q, r;
+        tdiv_qr(q, r, a, b);
+        return r;
+    }
+    /// Truncated division with remainder.
+    /**
+     * @param q the quotient.
+     * @param r the remainder.
+     * @param a the dividend.
+     * @param b the divisor.
+     *
+     * @throws zero_division_error if \p b is zero.
+     */
+    friend void tdiv_qr(wide_uint &q, wide_uint &r, const wide_uint &a, const wide_uint &b)
+    {
+        const auto as = a.size(), bs = b.size();
+        if (mppp_unlikely(!bs)) {
+            throw zero_division_error("Integer division by zero");
+        }
+        if (as < bs) {
+            r = a;
+            q = wide_uint{};
+            return;
+        }
+        // NOTE: mpn_tdiv_qr() requires the outputs not to overlap with the inputs.
+        wide_uint q_tmp, r_tmp;
+        ::mpn_tdiv_qr(q_tmp.m_limbs, r_tmp.m_limbs, 0, a.m_limbs, static_cast<::mp_size_t>(as), b.m_limbs,
+                      static_cast<::mp_size_t>(bs));
+        q = q_tmp;
+        r = r_tmp;
+    }
+    /// Bitwise NOT.
+    /**
+     * @param a the operand.
+     *
+     * @return the one's complement of \p a.
+     */
+    friend MPPP_CONSTEXPR_14 wide_uint operator~(const wide_uint &a)
+    {
+        wide_uint retval;
+        for (std::size_t i = 0; i < nlimbs; ++i) {
+            retval.m_limbs[i] = static_cast<::mp_limb_t>(~a.m_limbs[i]);
+        }
+        return retval;
+    }
+    /// Bitwise AND.
+    /**
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return <tt>a & b</tt>.
+     */
+    friend MPPP_CONSTEXPR_14 wide_uint operator&(const wide_uint &a, const wide_uint &b)
+    {
+        wide_uint retval;
+        for (std::size_t i = 0; i < nlimbs; ++i) {
+            retval.m_limbs[i] = a.m_limbs[i] & b.m_limbs[i];
+        }
+        return retval;
+    }
+    /// Bitwise OR.
+    /**
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return <tt>a | b</tt>.
+     */
+    friend MPPP_CONSTEXPR_14 wide_uint operator|(const wide_uint &a, const wide_uint &b)
+    {
+        wide_uint retval;
+        for (std::size_t i = 0; i < nlimbs; ++i) {
+            retval.m_limbs[i] = a.m_limbs[i] | b.m_limbs[i];
+        }
+        return retval;
+    }
+    /// Bitwise XOR.
+    /**
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return <tt>a ^ b</tt>.
+     */
+    friend MPPP_CONSTEXPR_14 wide_uint operator^(const wide_uint &a, const wide_uint &b)
+    {
+        wide_uint retval;
+        for (std::size_t i = 0; i < nlimbs; ++i) {
+            retval.m_limbs[i] = a.m_limbs[i] ^ b.m_limbs[i];
+        }
+        return retval;
+    }
+    /// Left shift.
+    /**
+     * @param a the operand.
+     * @param s the shift amount.
+     *
+     * @return <tt>a * 2**s</tt>, modulo \f$2^{\mathrm{Bits}}\f$.
+     */
+    friend MPPP_CONSTEXPR_14 wide_uint operator<<(const wide_uint &a, std::size_t s)
+    {
+        wide_uint retval;
+        const auto ls = s / unsigned(GMP_NUMB_BITS);
+        const auto bs = static_cast<unsigned>(s % unsigned(GMP_NUMB_BITS));
+        for (std::size_t i = ls; i < nlimbs; ++i) {
+            retval.m_limbs[i] = static_cast<::mp_limb_t>(a.m_limbs[i - ls] << bs);
+            if (bs && i > ls) {
+                retval.m_limbs[i] |= a.m_limbs[i - ls - 1u] >> (unsigned(GMP_NUMB_BITS) - bs);
+            }
+        }
+        return retval;
+    }
+    /// Right shift.
+    /**
+     * @param a the operand.
+     * @param s the shift amount.
+     *
+     * @return <tt>a / 2**s</tt>.
+     */
+    friend MPPP_CONSTEXPR_14 wide_uint operator>>(const wide_uint &a, std::size_t s)
+    {
+        wide_uint retval;
+        const auto ls = s / unsigned(GMP_NUMB_BITS);
+        const auto bs = static_cast<unsigned>(s % unsigned(GMP_NUMB_BITS));
+        for (std::size_t i = 0; ls < nlimbs && i < nlimbs - ls; ++i) {
+            retval.m_limbs[i] = a.m_limbs[i + ls] >> bs;
+            if (bs && i + ls + 1u < nlimbs) {
+                retval.m_limbs[i] |= static_cast<::mp_limb_t>(a.m_limbs[i + ls + 1u] << (unsigned(GMP_NUMB_BITS) - bs));
+            }
+        }
+        return retval;
+    }
+    /// In-place addition.
+    /**
+     * @param b the second operand.
+     *
+     * @return a reference to \p this.
+     */
+    MPPP_CONSTEXPR_14 wide_uint &operator+=(const wide_uint &b)
+    {
+        add_overflow(*this, *this, b);
+        return *this;
+    }
+    /// In-place subtraction.
+    /**
+     * @param b the second operand.
+     *
+     * @return a reference to \p this.
+     */
+    MPPP_CONSTEXPR_14 wide_uint &operator-=(const wide_uint &b)
+    {
+        sub_overflow(*this, *this, b);
+        return *this;
+    }
+    /// In-place multiplication.
+    /**
+     * @param b the second operand.
+     *
+     * @return a reference to \p this.
+     */
+    MPPP_CONSTEXPR_14 wide_uint &operator*=(const wide_uint &b)
+    {
+        return *this = *this * b;
+    }
+    /// In-place division.
+    /**
+     * @param b the divisor.
+     *
+     * @return a reference to \p this.
+     *
+     * @throws zero_division_error if \p b is zero.
+     */
+    wide_uint &operator/=(const wide_uint &b)
+    {
+        return *this = *this / b;
+    }
+    /// In-place modulo.
+    /**
+     * @param b the divisor.
+     *
+     * @return a reference to \p this.
+     *
+     * @throws zero_division_error if \p b is zero.
+     */
+    wide_uint &operator%=(const wide_uint &b)
+    {
+        return *this = *this % b;
+    }
+    /// In-place bitwise AND.
+    /**
+     * @param b the second operand.
+     *
+     * @return a reference to \p this.
+     */
+    MPPP_CONSTEXPR_14 wide_uint &operator&=(const wide_uint &b)
+    {
+        return *this = *this & b;
+    }
+    /// In-place bitwise OR.
+    /**
+     * @param b the second operand.
+     *
+     * @return a reference to \p this.
+     */
+    MPPP_CONSTEXPR_14 wide_uint &operator|=(const wide_uint &b)
+    {
+        return *this = *this | b;
+    }
+    /// In-place bitwise XOR.
+    /**
+     * @param b the second operand.
+     *
+     * @return a reference to \p this.
+     */
+    MPPP_CONSTEXPR_14 wide_uint &operator^=(const wide_uint &b)
+    {
+        return *this = *this ^ b;
+    }
+    /// In-place left shift.
+    /**
+     * @param s the shift amount.
+     *
+     * @return a reference to \p this.
+     */
+    MPPP_CONSTEXPR_14 wide_uint &operator<<=(std::size_t s)
+    {
+        return *this = *this << s;
+    }
+    /// In-place right shift.
+    /**
+     * @param s the shift amount.
+     *
+     * @return a reference to \p this.
+     */
+    MPPP_CONSTEXPR_14 wide_uint &operator>>=(std::size_t s)
+    {
+        return *this = *this >> s;
+    }
+    /// Prefix increment.
+    /**
+     * @return a reference to \p this after the increment.
+     */
+    MPPP_CONSTEXPR_14 wide_uint &operator++()
+    {
+        for (std::size_t i = 0; i < nlimbs && !++m_limbs[i]; ++i) {
+        }
+        return *this;
+    }
+    /// Suffix increment.
+    /**
+     * @return a copy of \p this before the increment.
+     */
+    MPPP_CONSTEXPR_14 wide_uint operator++(int)
+    {
+        auto retval(*this);
+        ++*this;
+        return retval;
+    }
+    /// Prefix decrement.
+    /**
+     * @return a reference to \p this after the decrement.
+     */
+    MPPP_CONSTEXPR_14 wide_uint &operator--()
+    {
+        for (std::size_t i = 0; i < nlimbs && !m_limbs[i]--; ++i) {
+        }
+        return *this;
+    }
+    /// Suffix decrement.
+    /**
+     * @return a copy of \p this before the decrement.
+     */
+    MPPP_CONSTEXPR_14 wide_uint operator--(int)
+    {
+        auto retval(*this);
+        --*this;
+        return retval;
+    }
+    /// Equality operator.
+    /**
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return \p true if <tt>a == b</tt>, \p false otherwise.
+     */
+    friend MPPP_CONSTEXPR_14 bool operator==(const wide_uint &a, const wide_uint &b)
+    {
+        for (std::size_t i = 0; i < nlimbs; ++i) {
+            if (a.m_limbs[i] != b.m_limbs[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    /// Inequality operator.
+    /**
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return \p true if <tt>a != b</tt>, \p false otherwise.
+     */
+    friend MPPP_CONSTEXPR_14 bool operator!=(const wide_uint &a, const wide_uint &b)
+    {
+        return !(a == b);
+    }
+    /// Less-than operator.
+    /**
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return \p true if <tt>a < b</tt>, \p false otherwise.
+     */
+    friend MPPP_CONSTEXPR_14 bool operator<(const wide_uint &a, const wide_uint &b)
+    {
+        for (std::size_t i = nlimbs; i > 0u; --i) {
+            if (a.m_limbs[i - 1u] != b.m_limbs[i - 1u]) {
+                return a.m_limbs[i - 1u] < b.m_limbs[i - 1u];
+            }
+        }
+        return false;
+    }
+    /// Less-than or equal operator.
+    /**
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return \p true if <tt>a <= b</tt>, \p false otherwise.
+     */
+    friend MPPP_CONSTEXPR_14 bool operator<=(const wide_uint &a, const wide_uint &b)
+    {
+        return !(b < a);
+    }
+    /// Greater-than operator.
+    /**
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return \p true if <tt>a > b</tt>, \p false otherwise.
+     */
+    friend MPPP_CONSTEXPR_14 bool operator>(const wide_uint &a, const wide_uint &b)
+    {
+        return b < a;
+    }
+    /// Greater-than or equal operator.
+    /**
+     * @param a the first operand.
+     * @param b the second operand.
+     *
+     * @return \p true if <tt>a >= b</tt>, \p false otherwise.
+     */
+    friend MPPP_CONSTEXPR_14 bool operator>=(const wide_uint &a, const wide_uint &b)
+    {
+        return !(a < b);
+    }
+    /// Output stream operator.
+    /**
+     * @param os the target stream.
+     * @param a the value that will be printed.
+     *
+     * @return a reference to \p os.
+     *
+     * @throws unspecified any exception thrown by the stream operator of \link mppp::integer integer\endlink.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const wide_uint &a)
+    {
+        return os << static_cast<integer<1>>(a);
+    }
+
+private:
+    // Init from a C++ unsigned integral value.
+    template <typename T>
+    MPPP_CONSTEXPR_14 void init_from_unsigned(T u)
+    {
+        for (std::size_t i = 0; i < nlimbs && u; ++i) {
+            m_limbs[i] = static_cast<::mp_limb_t>(u & GMP_NUMB_MASK);
+            if (detail::nl_digits<T>() <= GMP_NUMB_BITS) {
+                break;
+            }
+            // NOTE: the modulo operation prevents shifts larger
+            // than the width of T (which would otherwise be
+            // instantiated, although never executed).
+            u = static_cast<T>(u >> (unsigned(GMP_NUMB_BITS) % unsigned(detail::nl_digits<T>())));
+        }
+    }
+    template <typename T>
+    MPPP_CONSTEXPR_14 void init_from_integral(const T &n, std::false_type)
+    {
+        init_from_unsigned(n);
+    }
+    template <typename T>
+    MPPP_CONSTEXPR_14 void init_from_integral(const T &n, std::true_type)
+    {
+        if (n < T(0)) {
+            init_from_unsigned(detail::nint_abs(n));
+            neg();
+        } else {
+            init_from_unsigned(detail::make_unsigned(n));
+        }
+    }
+    // Multiply-accumulate: r + x * y + carry. The lower half of the
+    // result is written into r, the upper half is returned.
+    static MPPP_CONSTEXPR_14 ::mp_limb_t mul_acc(::mp_limb_t &r, ::mp_limb_t x, ::mp_limb_t y, ::mp_limb_t carry)
+    {
+        ::mp_limb_t hi = 0;
+        auto lo = detail::wide_uint_mul_limb(x, y, hi);
+        lo = static_cast<::mp_limb_t>(lo + carry);
+        hi = static_cast<::mp_limb_t>(hi + static_cast<::mp_limb_t>(lo < carry));
+        r = static_cast<::mp_limb_t>(r + lo);
+        return static_cast<::mp_limb_t>(hi + static_cast<::mp_limb_t>(r < lo));
+    }
+
+    ::mp_limb_t m_limbs[nlimbs];
+};
+
+#if MPPP_CPLUSPLUS < 201703L
+
+template <std::size_t Bits>
+constexpr std::size_t wide_uint<Bits>::nlimbs;
+
+#endif
+
+/// Hash value for \link mppp::wide_uint wide_uint\endlink.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ *
+ * A specialisation of the standard ``std::hash`` functor is also provided, so that
+ * it is possible to use :cpp:class:`~mppp::wide_uint` in standard unordered associative containers out of the box.
+ * \endrststar
+ *
+ * @param a the input value.
+ *
+ * @return a hash value for \p a.
+ */
+template <std::size_t Bits>
+MPPP_CONSTEXPR_14 inline std::size_t hash(const wide_uint<Bits> &a)
+{
+    std::size_t retval = wide_uint<Bits>::nlimbs;
+    for (std::size_t i = 0; i < wide_uint<Bits>::nlimbs; ++i) {
+        // NOTE: same hash combiner as in the hash() function for integer.
+        retval ^= static_cast<std::size_t>(a.data()[i]) + std::size_t(0x9e3779b9ul) + (retval << 6) + (retval >> 2);
+    }
+    return retval;
+}
+
+} // namespace mppp
+
+namespace std
+{
+
+// Specialisation of \p std::hash for mppp::wide_uint.
+template <size_t Bits>
+struct hash<mppp::wide_uint<Bits>> {
+// NOTE: these typedefs have been deprecated in C++17.
+#if MPPP_CPLUSPLUS < 201703L
+    // The argument type.
+    using argument_type = mppp::wide_uint<Bits>;
+    // The result type.
+    using result_type = size_t;
+#endif
+    // Call operator.
+    size_t operator()(const mppp::wide_uint<Bits> &a) const
+    {
+        return mppp::hash(a);
+    }
+};
+
+} // namespace std
+
+#endif
@@ -0,0 +1,629 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <mp++/config.hpp>
+
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <mp++/complex.hpp>
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/real.hpp>
+
+namespace mppp
+{
+
+namespace detail
+{
+
+namespace
+{
+
+// Below this precision, the complex multiplication
+// is always computed via exact products.
+constexpr ::mpfr_prec_t complex_karatsuba_threshold = 512;
+
+// The extra precision used in the Karatsuba multiplication.
+constexpr ::mpfr_prec_t complex_karatsuba_guard_bits = 32;
+
+// The extra precision used in the functions which
+// are not correctly rounded.
+constexpr ::mpfr_prec_t complex_guard_bits = 16;
+
+// The working precision of the functions which are not correctly rounded.
+::mpfr_prec_t complex_working_prec(::mpfr_prec_t p)
+{
+    return p > real_prec_max() - complex_guard_bits ? real_prec_max() : p + complex_guard_bits;
+}
+
+// The precision needed to represent exactly the product of a and b.
+::mpfr_prec_t complex_exact_prod_prec(const mpfr_struct_t *a, const mpfr_struct_t *b)
+{
+    const auto pa = mpfr_get_prec(a), pb = mpfr_get_prec(b);
+    // LCOV_EXCL_START
+    if (mppp_unlikely(pa > real_prec_max() - pb)) {
+        throw std::overflow_error("The exact product of reals with precisions " + to_string(pa) + " and "
+                                  + to_string(pb) + " cannot be represented");
+    }
+    // LCOV_EXCL_STOP
+    return pa + pb;
+}
+
+// Compute a * b + c * d (or a * b - c * d, if sub is true)
+// with a single rounding. rop may overlap with the operands.
+void complex_fmma(mpfr_struct_t *rop, const mpfr_struct_t *a, const mpfr_struct_t *b, const mpfr_struct_t *c,
+                  const mpfr_struct_t *d, bool sub)
+{
+#if MPFR_VERSION_MAJOR >= 4
+    if (sub) {
+        ::mpfr_fmms(rop, a, b, c, d, MPFR_RNDN);
+    } else {
+        ::mpfr_fmma(rop, a, b, c, d, MPFR_RNDN);
+    }
+#else
+    // NOTE: compute the products exactly, then
+    // add/subtract them with a single rounding.
+    MPPP_MAYBE_TLS real ab = make_heap_real(), cd = make_heap_real();
+    ab.set_prec(complex_exact_prod_prec(a, b));
+    cd.set_prec(complex_exact_prod_prec(c, d));
+    ::mpfr_mul(ab._get_mpfr_t(), a, b, MPFR_RNDN);
+    ::mpfr_mul(cd._get_mpfr_t(), c, d, MPFR_RNDN);
+    if (sub) {
+        ::mpfr_sub(rop, ab.get_mpfr_t(), cd.get_mpfr_t(), MPFR_RNDN);
+    } else {
+        ::mpfr_add(rop, ab.get_mpfr_t(), cd.get_mpfr_t(), MPFR_RNDN);
+    }
+#endif
+}
+
+// Compute x + y + z with a single rounding.
+void complex_sum3(mpfr_struct_t *rop, const mpfr_struct_t *x, const mpfr_struct_t *y, const mpfr_struct_t *z)
+{
+    // NOTE: mpfr_sum() does not modify the summands,
+    // the const_casts are thus safe.
+    ::mpfr_ptr tab[] = {const_cast<::mpfr_ptr>(x), const_cast<::mpfr_ptr>(y), const_cast<::mpfr_ptr>(z)};
+    ::mpfr_sum(rop, tab, 3, MPFR_RNDN);
+}
+
+// Set rop to op, with precision p. p must not be less than the precision of op.
+// NOTE: this is also used to store into the return value the components computed in
+// the thread-local buffers below. The buffers must not be swapped with the return value,
+// as they would take ownership of its storage, which may belong to a memory resource.
+void complex_set_component(real &rop, const real &op, ::mpfr_prec_t p)
+{
+    if (&rop == &op) {
+        rop.prec_round(p);
+    } else {
+        rop.set_prec(p);
+        ::mpfr_set(rop._get_mpfr_t(), op.get_mpfr_t(), MPFR_RNDN);
+    }
+}
+
+// Round to rop (with precision p) the component x of a Karatsuba product computed
+// with working precision wp. emax is the largest exponent of the two
+// terms which were added/subtracted to compute x.
+// Return false if x cannot be correctly rounded.
+bool complex_karatsuba_round(real &rop, const real &x, ::mpfr_exp_t emax, ::mpfr_prec_t wp, ::mpfr_prec_t p)
+{
+    if (!mpfr_regular_p(x.get_mpfr_t())) {
+        return false;
+    }
+    // NOTE: each term has an error of less than 2**(e - wp + 2), where e is the exponent of the term
+    // (see complex_mul_karatsuba()). The final addition/subtraction adds a rounding error
+    // of at most 2**(exp(x) - wp) <= 2**(emax + 1 - wp). Thus, the error on x
+    // is less than 2**(emax - wp + 4) = 2**(exp(x) - err), with err = exp(x) - emax + wp - 4.
+    // NOTE: the exponents are within the MPFR exponent range, and exp(x) <= emax + 1. Hence,
+    // the computation of err cannot overflow.
+    const auto err = static_cast<::mpfr_exp_t>(mpfr_get_exp(x.get_mpfr_t()) - emax) + static_cast<::mpfr_exp_t>(wp - 4);
+    // NOTE: this is the idiom suggested in the MPFR documentation to check
+    // the possibility of a correct rounding to nearest.
+    if (err <= 0 || !::mpfr_can_round(x.get_mpfr_t(), err, MPFR_RNDN, MPFR_RNDZ, p + 1)) {
+        return false;
+    }
+    ::mpfr_set(rop._get_mpfr_t(), x.get_mpfr_t(), MPFR_RNDN);
+    return true;
+}
+
+// Try to compute (a + bi) * (c + di) with 3 real multiplications, writing the components into re and im
+// (which must have precision p). The products are computed with a few guard bits, and the function returns
+// false if the components cannot be proven to be correctly rounded (e.g., because of
+// catastrophic cancellation or special values).
+bool complex_mul_karatsuba(real &re, real &im, const real &a, const real &b, const real &c, const real &d,
+                           ::mpfr_prec_t p)
+{
+    if (!mpfr_regular_p(a.get_mpfr_t()) || !mpfr_regular_p(b.get_mpfr_t()) || !mpfr_regular_p(c.get_mpfr_t())
+        || !mpfr_regular_p(d.get_mpfr_t()) || p > real_prec_max() - complex_karatsuba_guard_bits) {
+        return false;
+    }
+    const auto wp = p + complex_karatsuba_guard_bits;
+
+    MPPP_MAYBE_TLS real s = make_heap_real(), k1 = make_heap_real(), k2 = make_heap_real(), k3 = make_heap_real();
+    s.set_prec(wp);
+    k1.set_prec(wp);
+    k2.set_prec(wp);
+    k3.set_prec(wp);
+
+    // NOTE: each product k is computed from exact operands as
+    // k = x * (y + z) * (1 + d0) * (1 + d1), with |d0|, |d1| <= 2**-wp.
+    // The error on k is thus less than 3 * 2**-wp * |k| < 2**(exp(k) - wp + 2).
+    // k1 = c * (a + b).
+    ::mpfr_add(s._get_mpfr_t(), a.get_mpfr_t(), b.get_mpfr_t(), MPFR_RNDN);
+    ::mpfr_mul(k1._get_mpfr_t(), c.get_mpfr_t(), s.get_mpfr_t(), MPFR_RNDN);
+    // k2 = a * (d - c).
+    ::mpfr_sub(s._get_mpfr_t(), d.get_mpfr_t(), c.get_mpfr_t(), MPFR_RNDN);
+    ::mpfr_mul(k2._get_mpfr_t(), a.get_mpfr_t(), s.get_mpfr_t(), MPFR_RNDN);
+    // k3 = b * (c + d).
+    ::mpfr_add(s._get_mpfr_t(), c.get_mpfr_t(), d.get_mpfr_t(), MPFR_RNDN);
+    ::mpfr_mul(k3._get_mpfr_t(), b.get_mpfr_t(), s.get_mpfr_t(), MPFR_RNDN);
+
+    if (!mpfr_regular_p(k1.get_mpfr_t()) || !mpfr_regular_p(k2.get_mpfr_t()) || !mpfr_regular_p(k3.get_mpfr_t())) {
+        return false;
+    }
+    const auto e1 = mpfr_get_exp(k1.get_mpfr_t()), e2 = mpfr_get_exp(k2.get_mpfr_t()),
+               e3 = mpfr_get_exp(k3.get_mpfr_t());
+
+    // Real part: k1 - k3. Imaginary part: k1 + k2.
+    ::mpfr_sub(k3._get_mpfr_t(), k1.get_mpfr_t(), k3.get_mpfr_t(), MPFR_RNDN);
+    ::mpfr_add(k2._get_mpfr_t(), k1.get_mpfr_t(), k2.get_mpfr_t(), MPFR_RNDN);
+
+    return complex_karatsuba_round(re, k3, c_max(e1, e3), wp, p)
+           && complex_karatsuba_round(im, k2, c_max(e1, e2), wp, p);
+}
+
+} // namespace
+
+::mpfr_prec_t complex_ops::check_init_prec(::mpfr_prec_t p)
+{
+    if (mppp_unlikely(!real_prec_check(p))) {
+        throw std::invalid_argument("Cannot init a complex with a precision of " + to_string(p)
+                                    + ": the maximum allowed precision is " + to_string(real_prec_max())
+                                    + ", the minimum allowed precision is " + to_string(real_prec_min()));
+    }
+    return p;
+}
+
+::mpfr_prec_t complex_ops::check_set_prec(::mpfr_prec_t p)
+{
+    if (mppp_unlikely(!real_prec_check(p))) {
+        throw std::invalid_argument("Cannot set the precision of a complex to the value " + to_string(p)
+                                    + ": the maximum allowed precision is " + to_string(real_prec_max())
+                                    + ", the minimum allowed precision is " + to_string(real_prec_min()));
+    }
+    return p;
+}
+
+void complex_ops::add(complex &rop, const complex &a, const complex &b)
+{
+    mppp::add(rop.m_re, a.m_re, b.m_re);
+    mppp::add(rop.m_im, a.m_im, b.m_im);
+}
+
+void complex_ops::sub(complex &rop, const complex &a, const complex &b)
+{
+    mppp::sub(rop.m_re, a.m_re, b.m_re);
+    mppp::sub(rop.m_im, a.m_im, b.m_im);
+}
+
+void complex_ops::mul(complex &rop, const complex &a, const complex &b)
+{
+    if (&a == &b) {
+        sqr(rop, a);
+        return;
+    }
+
+    const auto p = c_max(a.get_prec(), b.get_prec());
+
+    // NOTE: compute into separate buffers, as rop
+    // may overlap with a or b.
+    MPPP_MAYBE_TLS real re = make_heap_real(), im = make_heap_real();
+    re.set_prec(p);
+    im.set_prec(p);
+
+    // NOTE: at high precision, the Karatsuba scheme saves one of the four real
+    // multiplications. If the result cannot be proven to be correctly rounded,
+    // fall back to the exact products.
+    if (p < complex_karatsuba_threshold || !complex_mul_karatsuba(re, im, a.m_re, a.m_im, b.m_re, b.m_im, p)) {
+        complex_fmma(re._get_mpfr_t(), a.m_re.get_mpfr_t(), b.m_re.get_mpfr_t(), a.m_im.get_mpfr_t(),
+                     b.m_im.get_mpfr_t(), true);
+        complex_fmma(im._get_mpfr_t(), a.m_re.get_mpfr_t(), b.m_im.get_mpfr_t(), a.m_im.get_mpfr_t(),
+                     b.m_re.get_mpfr_t(), false);
+    }
+
+    complex_set_component(rop.m_re, re, p);
+    complex_set_component(rop.m_im, im, p);
+}
+
+void complex_ops::div(complex &rop, const complex &a, const complex &b)
+{
+    const auto wp = complex_working_prec(c_max(a.get_prec(), b.get_prec()));
+
+    MPPP_MAYBE_TLS real den = make_heap_real(), re = make_heap_real(), im = make_heap_real();
+    den.set_prec(wp);
+    re.set_prec(wp);
+    im.set_prec(wp);
+
+    // (x + yi) / (u + vi) = ((xu + yv) + (yu - xv)i) / (u**2 + v**2).
+    // NOTE: the numerators and the denominator are computed
+    // with a single rounding, so that there is no cancellation.
+    const auto x = a.m_re.get_mpfr_t(), y = a.m_im.get_mpfr_t(), u = b.m_re.get_mpfr_t(), v = b.m_im.get_mpfr_t();
+    complex_fmma(den._get_mpfr_t(), u, u, v, v, false);
+    complex_fmma(re._get_mpfr_t(), x, u, y, v, false);
+    complex_fmma(im._get_mpfr_t(), y, u, x, v, true);
+    ::mpfr_div(re._get_mpfr_t(), re.get_mpfr_t(), den.get_mpfr_t(), MPFR_RNDN);
+    ::mpfr_div(im._get_mpfr_t(), im.get_mpfr_t(), den.get_mpfr_t(), MPFR_RNDN);
+
+    const auto p = c_max(a.get_prec(), b.get_prec());
+    re.prec_round(p);
+    im.prec_round(p);
+    complex_set_component(rop.m_re, re, p);
+    complex_set_component(rop.m_im, im, p);
+}
+
+void complex_ops::mul_add(complex &rop, const complex &a, const complex &b, const complex &c)
+{
+    const auto p = c_max(c_max(a.get_prec(), b.get_prec()), c.get_prec());
+
+    MPPP_MAYBE_TLS real t0 = make_heap_real(), t1 = make_heap_real(), re = make_heap_real(), im = make_heap_real();
+    // NOTE: the products are computed exactly, and then they are
+    // summed to the components of c with a single rounding.
+    const auto pp = complex_exact_prod_prec(a.m_re.get_mpfr_t(), b.m_re.get_mpfr_t());
+    t0.set_prec(pp);
+    t1.set_prec(pp);
+    re.set_prec(p);
+    im.set_prec(p);
+
+    ::mpfr_mul(t0._get_mpfr_t(), a.m_re.get_mpfr_t(), b.m_re.get_mpfr_t(), MPFR_RNDN);
+    ::mpfr_mul(t1._get_mpfr_t(), a.m_im.get_mpfr_t(), b.m_im.get_mpfr_t(), MPFR_RNDN);
+    ::mpfr_neg(t1._get_mpfr_t(), t1.get_mpfr_t(), MPFR_RNDN);
+    complex_sum3(re._get_mpfr_t(), t0.get_mpfr_t(), t1.get_mpfr_t(), c.m_re.get_mpfr_t());
+
+    ::mpfr_mul(t0._get_mpfr_t(), a.m_re.get_mpfr_t(), b.m_im.get_mpfr_t(), MPFR_RNDN);
+    ::mpfr_mul(t1._get_mpfr_t(), a.m_im.get_mpfr_t(), b.m_re.get_mpfr_t(), MPFR_RNDN);
+    complex_sum3(im._get_mpfr_t(), t0.get_mpfr_t(), t1.get_mpfr_t(), c.m_im.get_mpfr_t());
+
+    complex_set_component(rop.m_re, re, p);
+    complex_set_component(rop.m_im, im, p);
+}
+
+void complex_ops::add_r(complex &rop, const complex &a, const real &x)
+{
+    if (&x == &rop.m_re || &x == &rop.m_im) {
+        // NOTE: x overlaps with the return value, make a copy.
+        const real tmp{x};
+        add_r(rop, a, tmp);
+        return;
+    }
+    const auto p = c_max(a.get_prec(), x.get_prec());
+    mppp::add(rop.m_re, a.m_re, x);
+    complex_set_component(rop.m_im, a.m_im, p);
+}
+
+void complex_ops::sub_r(complex &rop, const complex &a, const real &x)
+{
+    if (&x == &rop.m_re || &x == &rop.m_im) {
+        const real tmp{x};
+        sub_r(rop, a, tmp);
+        return;
+    }
+    const auto p = c_max(a.get_prec(), x.get_prec());
+    mppp::sub(rop.m_re, a.m_re, x);
+    complex_set_component(rop.m_im, a.m_im, p);
+}
+
+void complex_ops::r_sub(complex &rop, const real &x, const complex &a)
+{
+    if (&x == &rop.m_re || &x == &rop.m_im) {
+        const real tmp{x};
+        r_sub(rop, tmp, a);
+        return;
+    }
+    const auto p = c_max(a.get_prec(), x.get_prec());
+    mppp::sub(rop.m_re, x, a.m_re);
+    mppp::neg(rop.m_im, a.m_im);
+    rop.m_im.prec_round(p);
+}
+
+void complex_ops::mul_r(complex &rop, const complex &a, const real &x)
+{
+    if (&x == &rop.m_re || &x == &rop.m_im) {
+        const real tmp{x};
+        mul_r(rop, a, tmp);
+        return;
+    }
+    mppp::mul(rop.m_re, a.m_re, x);
+    mppp::mul(rop.m_im, a.m_im, x);
+}
+
+void complex_ops::div_r(complex &rop, const complex &a, const real &x)
+{
+    if (&x == &rop.m_re || &x == &rop.m_im) {
+        const real tmp{x};
+        div_r(rop, a, tmp);
+        return;
+    }
+    mppp::div(rop.m_re, a.m_re, x);
+    mppp::div(rop.m_im, a.m_im, x);
+}
+
+void complex_ops::neg(complex &rop, const complex &a)
+{
+    mppp::neg(rop.m_re, a.m_re);
+    mppp::neg(rop.m_im, a.m_im);
+}
+
+void complex_ops::conj(complex &rop, const complex &a)
+{
+    complex_set_component(rop.m_re, a.m_re, a.get_prec());
+    mppp::neg(rop.m_im, a.m_im);
+}
+
+void complex_ops::sqr(complex &rop, const complex &a)
+{
+    const auto p = a.get_prec();
+
+    MPPP_MAYBE_TLS real re = make_heap_real(), im = make_heap_real();
+    re.set_prec(p);
+    im.set_prec(p);
+
+    // (x + yi)**2 = (x**2 - y**2) + 2xyi.
+    const auto x = a.m_re.get_mpfr_t(), y = a.m_im.get_mpfr_t();
+    complex_fmma(re._get_mpfr_t(), x, x, y, y, true);
+    ::mpfr_mul(im._get_mpfr_t(), x, y, MPFR_RNDN);
+    ::mpfr_mul_2ui(im._get_mpfr_t(), im.get_mpfr_t(), 1, MPFR_RNDN);
+
+    complex_set_component(rop.m_re, re, p);
+    complex_set_component(rop.m_im, im, p);
+}
+
+void complex_ops::sqrt(complex &rop, const complex &a)
+{
+    const auto p = a.get_prec(), wp = complex_working_prec(p);
+    const auto x = a.m_re.get_mpfr_t(), y = a.m_im.get_mpfr_t();
+
+    MPPP_MAYBE_TLS real t = make_heap_real(), re = make_heap_real(), im = make_heap_real();
+    t.set_prec(wp);
+    re.set_prec(wp);
+    im.set_prec(wp);
+
+    if (mpfr_nan_p(x) || mpfr_nan_p(y)) {
+        ::mpfr_set_nan(re._get_mpfr_t());
+        ::mpfr_set_nan(im._get_mpfr_t());
+    } else if (mpfr_inf_p(y)) {
+        // sqrt(x +- inf * i) = inf +- inf * i.
+        ::mpfr_set_inf(re._get_mpfr_t(), 1);
+        ::mpfr_set(im._get_mpfr_t(), y, MPFR_RNDN);
+    } else if (mpfr_zero_p(x) && mpfr_zero_p(y)) {
+        // sqrt(+-0 +- 0 * i) = +0 +- 0 * i.
+        ::mpfr_set_zero(re._get_mpfr_t(), 1);
+        ::mpfr_set(im._get_mpfr_t(), y, MPFR_RNDN);
+    } else {
+        // NOTE: use the formulae which avoid cancellation:
+        // - if x >= 0, t = sqrt((|a| + x) / 2) and sqrt(a) = t + y / (2t) * i,
+        // - otherwise, t = sqrt((|a| - x) / 2) and sqrt(a) = |y| / (2t) + sign(y) * t * i.
+        ::mpfr_hypot(t._get_mpfr_t(), x, y, MPFR_RNDN);
+        const auto x_nonneg = mpfr_sgn(x) >= 0;
+        if (x_nonneg) {
+            ::mpfr_add(t._get_mpfr_t(), t.get_mpfr_t(), x, MPFR_RNDN);
+        } else {
+            ::mpfr_sub(t._get_mpfr_t(), t.get_mpfr_t(), x, MPFR_RNDN);
+        }
+        ::mpfr_div_2ui(t._get_mpfr_t(), t.get_mpfr_t(), 1, MPFR_RNDN);
+        ::mpfr_sqrt(t._get_mpfr_t(), t.get_mpfr_t(), MPFR_RNDN);
+        if (x_nonneg) {
+            ::mpfr_set(re._get_mpfr_t(), t.get_mpfr_t(), MPFR_RNDN);
+            ::mpfr_div(im._get_mpfr_t(), y, t.get_mpfr_t(), MPFR_RNDN);
+            ::mpfr_div_2ui(im._get_mpfr_t(), im.get_mpfr_t(), 1, MPFR_RNDN);
+        } else {
+            ::mpfr_abs(re._get_mpfr_t(), y, MPFR_RNDN);
+            ::mpfr_div(re._get_mpfr_t(), re.get_mpfr_t(), t.get_mpfr_t(), MPFR_RNDN);
+            ::mpfr_div_2ui(re._get_mpfr_t(), re.get_mpfr_t(), 1, MPFR_RNDN);
+            ::mpfr_setsign(im._get_mpfr_t(), t.get_mpfr_t(), mpfr_signbit(y), MPFR_RNDN);
+        }
+    }
+
+    re.prec_round(p);
+    im.prec_round(p);
+    complex_set_component(rop.m_re, re, p);
+    complex_set_component(rop.m_im, im, p);
+}
+
+void complex_ops::exp(complex &rop, const complex &a)
+{
+    const auto p = a.get_prec(), wp = complex_working_prec(p);
+    const auto x = a.m_re.get_mpfr_t(), y = a.m_im.get_mpfr_t();
+
+    MPPP_MAYBE_TLS real e = make_heap_real(), re = make_heap_real(), im = make_heap_real();
+
+    if (mpfr_zero_p(y)) {
+        // NOTE: for a real argument, the real part is computed
+        // directly with a single rounding.
+        re.set_prec(p);
+        im.set_prec(p);
+        ::mpfr_exp(re._get_mpfr_t(), x, MPFR_RNDN);
+        ::mpfr_set(im._get_mpfr_t(), y, MPFR_RNDN);
+    } else {
+        // exp(x + yi) = exp(x) * (cos(y) + sin(y) * i).
+        e.set_prec(wp);
+        re.set_prec(wp);
+        im.set_prec(wp);
+        ::mpfr_exp(e._get_mpfr_t(), x, MPFR_RNDN);
+        ::mpfr_sin_cos(im._get_mpfr_t(), re._get_mpfr_t(), y, MPFR_RNDN);
+        ::mpfr_mul(re._get_mpfr_t(), re.get_mpfr_t(), e.get_mpfr_t(), MPFR_RNDN);
+        ::mpfr_mul(im._get_mpfr_t(), im.get_mpfr_t(), e.get_mpfr_t(), MPFR_RNDN);
+        re.prec_round(p);
+        im.prec_round(p);
+    }
+
+    complex_set_component(rop.m_re, re, p);
+    complex_set_component(rop.m_im, im, p);
+}
+
+void complex_ops::log(complex &rop, const complex &a)
+{
+    const auto p = a.get_prec(), wp = complex_working_prec(p);
+    const auto x = a.m_re.get_mpfr_t(), y = a.m_im.get_mpfr_t();
+
+    MPPP_MAYBE_TLS real t = make_heap_real(), sx = make_heap_real(), sy = make_heap_real(), m1 = make_heap_real(),
+                        re = make_heap_real(), im = make_heap_real();
+    t.set_prec(wp);
+    re.set_prec(wp);
+    im.set_prec(p);
+
+    // log(x + yi) = log(|a|) + atan2(y, x) * i.
+    ::mpfr_hypot(t._get_mpfr_t(), x, y, MPFR_RNDN);
+    if (mpfr_regular_p(t.get_mpfr_t()) && (mpfr_get_exp(t.get_mpfr_t()) == 0 || mpfr_get_exp(t.get_mpfr_t()) == 1)) {
+        // NOTE: if |a| is in [0.5, 2), log(|a|) is affected by cancellation. Compute it
+        // as log1p(x**2 + y**2 - 1) / 2 instead, where x**2 + y**2 - 1 is computed with a single rounding.
+        sx.set_prec(complex_exact_prod_prec(x, x));
+        sy.set_prec(complex_exact_prod_prec(y, y));
+        m1.set_prec(real_prec_min());
+        ::mpfr_sqr(sx._get_mpfr_t(), x, MPFR_RNDN);
+        ::mpfr_sqr(sy._get_mpfr_t(), y, MPFR_RNDN);
+        ::mpfr_set_si(m1._get_mpfr_t(), -1, MPFR_RNDN);
+        complex_sum3(re._get_mpfr_t(), sx.get_mpfr_t(), sy.get_mpfr_t(), m1.get_mpfr_t());
+        ::mpfr_log1p(re._get_mpfr_t(), re.get_mpfr_t(), MPFR_RNDN);
+        ::mpfr_div_2ui(re._get_mpfr_t(), re.get_mpfr_t(), 1, MPFR_RNDN);
+    } else {
+        ::mpfr_log(re._get_mpfr_t(), t.get_mpfr_t(), MPFR_RNDN);
+    }
+    ::mpfr_atan2(im._get_mpfr_t(), y, x, MPFR_RNDN);
+
+    re.prec_round(p);
+    complex_set_component(rop.m_re, re, p);
+    complex_set_component(rop.m_im, im, p);
+}
+
+void complex_ops::norm(real &rop, const complex &a)
+{
+    rop.set_prec(a.get_prec());
+    const auto x = a.m_re.get_mpfr_t(), y = a.m_im.get_mpfr_t();
+    complex_fmma(rop._get_mpfr_t(), x, x, y, y, false);
+}
+
+} // namespace detail
+
+/// Copy constructor with custom precision.
+/**
+ * \rststar
+ * The real and imaginary parts of ``other`` will be rounded to the precision ``p``.
+ * \endrststar
+ *
+ * @param other the \link mppp::complex complex\endlink that will be copied.
+ * @param p the desired precision.
+ *
+ * @throws std::invalid_argument if \p p is outside the range established by
+ * \link mppp::real_prec_min() real_prec_min()\endlink and \link mppp::real_prec_max() real_prec_max()\endlink.
+ */
+complex::complex(const complex &other, complex_prec_t p)
+    : m_re(other.m_re, detail::complex_ops::check_init_prec(static_cast<::mpfr_prec_t>(p))),
+      m_im(other.m_im, static_cast<::mpfr_prec_t>(p))
+{
+}
+
+/// Constructor from real and imaginary parts.
+/**
+ * \rststar
+ * The real and imaginary parts will be moved from ``re`` and ``im``. The precision
+ * of the constructed :cpp:class:`~mppp::complex` is the largest precision among ``re`` and ``im``.
+ * \endrststar
+ *
+ * @param re the real part.
+ * @param im the imaginary part.
+ */
+complex::complex(real &&re, real &&im) : m_re(std::move(re)), m_im(std::move(im))
+{
+    unify_prec();
+}
+
+/// Destructively set the precision.
+/**
+ * \rststar
+ * This method will set the precision of ``this`` to exactly ``p`` bits. The real and imaginary
+ * parts will be set to NaN.
+ * \endrststar
+ *
+ * @param p the desired precision.
+ *
+ * @return a reference to \p this.
+ *
+ * @throws std::invalid_argument if \p p is outside the range established by
+ * \link mppp::real_prec_min() real_prec_min()\endlink and \link mppp::real_prec_max() real_prec_max()\endlink.
+ */
+complex &complex::set_prec(::mpfr_prec_t p)
+{
+    detail::complex_ops::check_set_prec(p);
+    m_re.set_prec(p);
+    m_im.set_prec(p);
+    return *this;
+}
+
+/// Set the precision maintaining the current value.
+/**
+ * \rststar
+ * This method will set the precision of ``this`` to exactly ``p`` bits. If ``p``
+ * is smaller than the current precision of ``this``, the real and imaginary parts
+ * will be rounded, otherwise the value will be preserved exactly.
+ * \endrststar
+ *
+ * @param p the desired precision.
+ *
+ * @return a reference to \p this.
+ *
+ * @throws std::invalid_argument if \p p is outside the range established by
+ * \link mppp::real_prec_min() real_prec_min()\endlink and \link mppp::real_prec_max() real_prec_max()\endlink.
+ */
+complex &complex::prec_round(::mpfr_prec_t p)
+{
+    detail::complex_ops::check_set_prec(p);
+    m_re.prec_round(p);
+    m_im.prec_round(p);
+    return *this;
+}
+
+/// Convert to string.
+/**
+ * \rststar
+ * This method will convert ``this`` to a string of the form ``(re,im)``, where ``re`` and ``im``
+ * are the representations in base ``base`` of the real and imaginary parts
+ * (see :cpp:func:`mppp::real::to_string()`).
+ * \endrststar
+ *
+ * @param base the base to be used for the string representation.
+ *
+ * @return \p this converted to a string.
+ *
+ * @throws unspecified any exception thrown by mppp::real::to_string().
+ */
+std::string complex::to_string(int base) const
+{
+    return '(' + m_re.to_string(base) + ',' + m_im.to_string(base) + ')';
+}
+
+/// Output stream operator for \link mppp::complex complex\endlink objects.
+/**
+ * \rststar
+ * This operator will insert into the stream ``os`` the string representation of ``z``
+ * in base 10 (see :cpp:func:`mppp::complex::to_string()`).
+ * \endrststar
+ *
+ * @param os the target stream.
+ * @param z the \link mppp::complex complex\endlink that will be inserted into \p os.
+ *
+ * @return a reference to \p os.
+ *
+ * @throws unspecified any exception thrown by mppp::complex::to_string().
+ */
+std::ostream &operator<<(std::ostream &os, const complex &z)
+{
+    return os << z.to_string();
+}
+
+} // namespace mppp
@@ -12,7 +12,10 @@
 #include <algorithm>
 #endif
 #include <cassert>
+#include <cctype>
+#include <clocale>
 #include <cstddef>
+#include <cstring>
 #if MPPP_CPLUSPLUS >= 201402L
 #include <iterator>
 #endif
@@ -100,6 +103,95 @@ std::string to_string(__int128_t n)
 
 #endif
 
+namespace
+{
+
+// Check if [first, last) begins with the lower-case string s, ignoring the case.
+bool str_starts_with_ci(const char *first, const char *last, const char *s)
+{
+    for (; *s != '\0'; ++first, ++s) {
+        if (first == last || std::tolower(static_cast<unsigned char>(*first)) != *s) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// NOTE: this is used in the implementation of from_chars(), so that only the characters
+// which may be part of the value are copied into a null-terminated buffer before parsing.
+// The returned prefix is scanned according to a superset of the syntaxes accepted by
+// mpfr_strtofr() and strtod(): an optional sign, an infinity or a NaN, or
+// a significand with an optional point followed by an optional exponent.
+const char *fp_str_prefix_end(const char *first, const char *last, int base)
+{
+    assert(base >= 2 && base <= 62);
+
+    const auto skip_digits = [&first, last, base]() {
+        while (first != last && str_digit_value(*first, base) >= 0) {
+            ++first;
+        }
+    };
+    const auto skip_sign = [&first, last]() {
+        if (first != last && (*first == '-' || *first == '+')) {
+            ++first;
+        }
+    };
+
+    skip_sign();
+
+    // Infinities and NaNs. The forms without the '@' delimiters
+    // are recognised by MPFR only in bases up to 16.
+    // NOTE: "infinity" must be checked before "inf".
+    const struct {
+        const char *str;
+        bool nan;
+    } specials[] = {{"@inf@", false}, {"@nan@", true}, {"infinity", false}, {"inf", false}, {"nan", true}};
+    for (const auto &sp : specials) {
+        if ((sp.str[0] == '@' || base <= 16) && str_starts_with_ci(first, last, sp.str)) {
+            first += std::strlen(sp.str);
+            // Optional n-char sequence after a NaN.
+            if (sp.nan && first != last && *first == '(') {
+                auto ptr = first + 1;
+                while (ptr != last && (std::isalnum(static_cast<unsigned char>(*ptr)) || *ptr == '_')) {
+                    ++ptr;
+                }
+                if (ptr != last && *ptr == ')') {
+                    first = ptr + 1;
+                }
+            }
+            return first;
+        }
+    }
+
+    // Base prefix.
+    if ((base == 2 || base == 16) && last - first >= 2 && first[0] == '0'
+        && std::tolower(static_cast<unsigned char>(first[1])) == (base == 2 ? 'b' : 'x')) {
+        first += 2;
+    }
+
+    // Significand. The decimal point may also be the one of the current locale.
+    skip_digits();
+    if (first != last && (*first == '.' || *first == *std::localeconv()->decimal_point)) {
+        ++first;
+        skip_digits();
+    }
+
+    // Exponent (always in base 10).
+    if (first != last
+        && (*first == '@' || (base <= 10 && (*first == 'e' || *first == 'E'))
+            || ((base == 2 || base == 16) && (*first == 'p' || *first == 'P')))) {
+        ++first;
+        skip_sign();
+        while (first != last && *first >= '0' && *first <= '9') {
+            ++first;
+        }
+    }
+
+    return first;
+}
+
 } // namespace detail
 
 } // namespace mppp
@@ -6,24 +6,34 @@
 // Public License v. 2.0. If a copy of the MPL was not distributed
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <exception>
 #include <ios>
 #include <iostream>
 #include <locale>
 #include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include <mp++/charconv.hpp>
 #include <mp++/config.hpp>
 #include <mp++/detail/gmp.hpp>
 #include <mp++/detail/type_traits.hpp>
 #include <mp++/detail/utils.hpp>
 #include <mp++/integer.hpp>
+#include <mp++/memory.hpp>
 
 namespace mppp
 {
@@ -85,28 +95,182 @@ static_assert(disjunction<std::is_same<::mp_limb_t, unsigned long>, std::is_same
                           std::is_same<::mp_limb_t, unsigned>>::value,
               "Invalid type for mp_limb_t.");
 
-} // namespace
+// Number of exact size classes.
+constexpr std::size_t mpz_cache_nexact = 16;
 
-void mpz_alloc_cache::clear() noexcept
+static_assert(mpz_alloc_cache::nclasses == mpz_cache_nexact + 36u && mpz_alloc_cache::max_supported_size == 8192u,
+              "Inconsistent size classes in the mpz alloc cache.");
+
+// Smallest array size (in limbs) stored in the size class c.
+std::size_t mpz_cache_class_lo(std::size_t c)
+{
+    assert(c < mpz_alloc_cache::nclasses);
+    if (c < mpz_cache_nexact) {
+        return c + 1u;
+    }
+    // Above the exact classes, the lower bounds are 2**k + j * 2**(k - 2),
+    // with k >= 4 and j in [1, 4].
+    const auto k = (c - mpz_cache_nexact) / 4u + 4u, j = (c - mpz_cache_nexact) % 4u + 1u;
+    return (std::size_t(1) << k) + j * (std::size_t(1) << (k - 2u));
+}
+
+// Index of the size class in which an array of n limbs is stored.
+// This is the largest class whose lower bound is not greater than n.
+std::size_t mpz_cache_class_floor(std::size_t n)
+{
+    assert(n > 0u && n <= mpz_alloc_cache::max_supported_size);
+    if (n <= mpz_cache_nexact) {
+        return n - 1u;
+    }
+    // Determine k such that 2**k <= n < 2**(k + 1).
+    std::size_t k = 4;
+    while ((std::size_t(1) << (k + 1u)) <= n) {
+        ++k;
+    }
+    const auto j = (n - (std::size_t(1) << k)) >> (k - 2u);
+    return mpz_cache_nexact + (k - 4u) * 4u + j - 1u;
+}
+
+// Index of the size class from which an array of at least n limbs can be fetched.
+// This is the smallest class whose lower bound is not less than n.
+std::size_t mpz_cache_class_ceil(std::size_t n)
+{
+    const auto c = mpz_cache_class_floor(n);
+    return mpz_cache_class_lo(c) < n ? c + 1u : c;
+}
+
+// Free an array of limbs via GMP's deallocation function.
+void mpz_cache_free(::mp_limb_t *ptr, std::size_t alloc) noexcept
 {
-#if !defined(NDEBUG)
-    std::cout << "Cleaning up the mpz alloc cache." << std::endl;
-#endif
     // Get the GMP free() function.
     void (*ffp)(void *, std::size_t) = nullptr;
     ::mp_get_memory_functions(nullptr, nullptr, &ffp);
     assert(ffp != nullptr);
-    for (std::size_t i = 0; i < max_size; ++i) {
-        // Free all the limbs arrays allocated for this size.
-        for (std::size_t j = 0; j < sizes[i]; ++j) {
-            ffp(static_cast<void *>(caches[i][j]), i + 1u);
+    ffp(static_cast<void *>(ptr), alloc * sizeof(::mp_limb_t));
+}
+
+// NOTE: the cached arrays store the pointer to the next array in the
+// list at the beginning of their storage. For the non-exact size classes,
+// the pointer is followed by the actual size of the array. We access
+// the storage via memcpy() in order to avoid aliasing issues.
+
+// Remove the first array from the size class c, and return it. Its size will be written into alloc.
+::mp_limb_t *mpz_cache_pop(mpz_alloc_cache &mpzc, std::size_t c, std::size_t &alloc) noexcept
+{
+    assert(mpzc.sizes[c] > 0u);
+    const auto retval = mpzc.heads[c];
+    assert(retval != nullptr);
+    std::memcpy(&mpzc.heads[c], retval, sizeof(::mp_limb_t *));
+    if (c < mpz_cache_nexact) {
+        alloc = c + 1u;
+    } else {
+        std::memcpy(&alloc, reinterpret_cast<const char *>(retval) + sizeof(::mp_limb_t *), sizeof(std::size_t));
+    }
+    --mpzc.sizes[c];
+    mpzc.nbytes -= alloc * sizeof(::mp_limb_t);
+    return retval;
+}
+
+// Insert the array ptr of size alloc at the beginning of the size class c.
+void mpz_cache_push(mpz_alloc_cache &mpzc, std::size_t c, ::mp_limb_t *ptr, std::size_t alloc) noexcept
+{
+    std::memcpy(ptr, &mpzc.heads[c], sizeof(::mp_limb_t *));
+    if (c >= mpz_cache_nexact) {
+        std::memcpy(reinterpret_cast<char *>(ptr) + sizeof(::mp_limb_t *), &alloc, sizeof(std::size_t));
+    }
+    mpzc.heads[c] = ptr;
+    ++mpzc.sizes[c];
+    mpzc.nbytes += alloc * sizeof(::mp_limb_t);
+}
+
+// Check if an array of alloc limbs can be stored in the size class c (disregarding the limits).
+bool mpz_cache_storable(std::size_t c, std::size_t alloc)
+{
+    if (c < mpz_cache_nexact) {
+        // NOTE: the exact classes do not record the size of the arrays, thus they can
+        // store only arrays of exactly c + 1 limbs. Arrays of 17-19 limbs, which
+        // are below the lower bound of the first geometric class, are not cached.
+        return alloc == c + 1u && alloc * sizeof(::mp_limb_t) >= sizeof(::mp_limb_t *);
+    }
+    // NOTE: the array must be large enough to contain the link and the size.
+    return alloc * sizeof(::mp_limb_t) >= sizeof(::mp_limb_t *) + sizeof(std::size_t);
+}
+
+} // namespace
+
+::mp_limb_t *mpz_alloc_cache::get(std::size_t nlimbs, std::size_t &alloc) noexcept
+{
+    if (!nlimbs || nlimbs > max_size) {
+        ++misses;
+        return nullptr;
+    }
+    const auto c = mpz_cache_class_ceil(nlimbs);
+    // NOTE: c might be past the last class if max_size == max_supported_size
+    // and nlimbs is larger than the lower bound of the last class.
+    if (c == nclasses || !sizes[c]) {
+        ++misses;
+        return nullptr;
+    }
+    ++hits;
+    return mpz_cache_pop(*this, c, alloc);
+}
+
+bool mpz_alloc_cache::put(::mp_limb_t *ptr, std::size_t alloc) noexcept
+{
+    if (!alloc || alloc > max_size) {
+        ++evictions;
+        return false;
+    }
+    const auto c = mpz_cache_class_floor(alloc);
+    if (sizes[c] >= max_entries || !mpz_cache_storable(c, alloc)) {
+        ++evictions;
+        return false;
+    }
+    mpz_cache_push(*this, c, ptr, alloc);
+    return true;
+}
+
+std::size_t mpz_alloc_cache::alloc_size(std::size_t nlimbs) const noexcept
+{
+    if (nlimbs <= mpz_cache_nexact || nlimbs > max_size) {
+        return nlimbs;
+    }
+    const auto c = mpz_cache_class_ceil(nlimbs);
+    // NOTE: don't round up past the maximum cacheable size.
+    return (c < nclasses && mpz_cache_class_lo(c) <= max_size) ? mpz_cache_class_lo(c) : nlimbs;
+}
+
+void mpz_alloc_cache::trim(std::size_t max_bytes) noexcept
+{
+    // Free starting from the largest arrays.
+    for (auto c = nclasses; c > 0u && nbytes > max_bytes; --c) {
+        while (sizes[c - 1u] && nbytes > max_bytes) {
+            std::size_t alloc = 0;
+            const auto ptr = mpz_cache_pop(*this, c - 1u, alloc);
+            mpz_cache_free(ptr, alloc);
         }
-        // Reset the number of limbs array present in this
-        // cache entry.
-        sizes[i] = 0u;
     }
 }
 
+#if MPPP_CPLUSPLUS < 201703L
+
+constexpr std::size_t mpz_alloc_cache::max_supported_size;
+constexpr std::size_t mpz_alloc_cache::nclasses;
+constexpr std::size_t mpz_alloc_cache::default_max_size;
+constexpr std::size_t mpz_alloc_cache::default_max_entries;
+
+#endif
+
+void mpz_alloc_cache::clear() noexcept
+{
+#if !defined(NDEBUG)
+    std::cout << "Cleaning up the mpz alloc cache." << std::endl;
+#endif
+    trim(0);
+    assert(nbytes == 0u);
+    assert(std::all_of(sizes.begin(), sizes.end(), [](std::size_t n) { return n == 0u; }));
+}
+
 #if defined(MPPP_HAVE_THREAD_LOCAL)
 
 namespace
@@ -150,18 +314,36 @@ thread_local mpz_alloc_cache mpz_alloc_cache_inst;
 // Implementation of the init of an mpz from cache.
 bool mpz_init_from_cache_impl(mpz_struct_t &rop, std::size_t nlimbs)
 {
-    auto &mpzc = mpz_alloc_cache_inst;
-    if (nlimbs && nlimbs <= mpzc.max_size && mpzc.sizes[nlimbs - 1u]) {
+    std::size_t alloc = 0;
+    if (const auto ptr = mpz_alloc_cache_inst.get(nlimbs, alloc)) {
         // LCOV_EXCL_START
-        if (mppp_unlikely(nlimbs > make_unsigned(nl_max<mpz_alloc_t>()))) {
+        if (mppp_unlikely(alloc > make_unsigned(nl_max<mpz_alloc_t>()))) {
+            std::abort();
+        }
+        // LCOV_EXCL_STOP
+        rop._mp_alloc = static_cast<mpz_alloc_t>(alloc);
+        rop._mp_size = 0;
+        rop._mp_d = ptr;
+        return true;
+    }
+    return false;
+}
+
+// Implementation of the init of an mpz from the active memory resource.
+bool mpz_init_from_resource_impl(mpz_struct_t &rop, std::size_t nlimbs)
+{
+    if (const auto res = get_thread_local_integer_resource()) {
+        // NOTE: like mpz_init2(), allocate at least 1 limb.
+        nlimbs = std::max(nlimbs, std::size_t(1));
+        // LCOV_EXCL_START
+        if (mppp_unlikely(nlimbs > make_unsigned(nl_max<mpz_alloc_t>())
+                          || nlimbs > nl_max<std::size_t>() / sizeof(::mp_limb_t))) {
             std::abort();
         }
         // LCOV_EXCL_STOP
-        const auto idx = nlimbs - 1u;
         rop._mp_alloc = static_cast<mpz_alloc_t>(nlimbs);
         rop._mp_size = 0;
-        rop._mp_d = mpzc.caches[idx][mpzc.sizes[idx] - 1u];
-        --mpzc.sizes[idx];
+        rop._mp_d = static_cast<::mp_limb_t *>(res->allocate(nlimbs * sizeof(::mp_limb_t)));
         return true;
     }
     return false;
@@ -179,7 +361,11 @@ mpz_alloc_cache &get_thread_local_mpz_cache()
 void mpz_init_nlimbs(mpz_struct_t &rop, std::size_t nlimbs)
 {
 #if defined(MPPP_HAVE_THREAD_LOCAL)
-    if (!mpz_init_from_cache_impl(rop, nlimbs)) {
+    // NOTE: if a memory resource is active, the cache is bypassed.
+    if (!mpz_init_from_resource_impl(rop, nlimbs) && !mpz_init_from_cache_impl(rop, nlimbs)) {
+        // Round up the size, so that the array
+        // can later be reused via the cache.
+        nlimbs = mpz_alloc_cache_inst.alloc_size(nlimbs);
 #endif
         // LCOV_EXCL_START
         // A bit of horrid overflow checking.
@@ -208,7 +394,15 @@ void mpz_init_nbits(mpz_struct_t &rop, ::mp_bitcnt_t nbits, std::size_t nlimbs)
     // Check nlimbs.
     assert(nlimbs == nbits_to_nlimbs(nbits));
 #if defined(MPPP_HAVE_THREAD_LOCAL)
-    if (!mpz_init_from_cache_impl(rop, nlimbs)) {
+    if (!mpz_init_from_resource_impl(rop, nlimbs) && !mpz_init_from_cache_impl(rop, nlimbs)) {
+        // Round up the size, so that the array
+        // can later be reused via the cache.
+        const auto alloc = mpz_alloc_cache_inst.alloc_size(nlimbs);
+        if (alloc != nlimbs) {
+            // NOTE: alloc is at most max_supported_size, thus
+            // the multiplication cannot overflow.
+            nbits = static_cast<::mp_bitcnt_t>(alloc * unsigned(GMP_NUMB_BITS));
+        }
 #endif
         ignore(nlimbs);
         // NOTE: nbits == 0 is allowed.
@@ -221,13 +415,9 @@ void mpz_init_nbits(mpz_struct_t &rop, ::mp_bitcnt_t nbits, std::size_t nlimbs)
 void mpz_clear_wrap(mpz_struct_t &m)
 {
 #if defined(MPPP_HAVE_THREAD_LOCAL)
-    auto &mpzc = mpz_alloc_cache_inst;
-    const auto ualloc = make_unsigned(m._mp_alloc);
-    if (ualloc && ualloc <= mpzc.max_size && mpzc.sizes[ualloc - 1u] < mpzc.max_entries) {
-        const auto idx = ualloc - 1u;
-        mpzc.caches[idx][mpzc.sizes[idx]] = m._mp_d;
-        ++mpzc.sizes[idx];
-    } else {
+    // NOTE: the limb arrays allocated by a memory resource are compatible
+    // with GMP's memory functions, thus they can end up in the cache.
+    if (!mpz_alloc_cache_inst.put(m._mp_d, static_cast<std::size_t>(make_unsigned(m._mp_alloc)))) {
 #endif
         ::mpz_clear(&m);
 #if defined(MPPP_HAVE_THREAD_LOCAL)
@@ -235,9 +425,420 @@ void mpz_clear_wrap(mpz_struct_t &m)
 #endif
 }
 
+namespace
+{
+
+// The digits used by GMP in the string representations of integers in bases up to 36.
+constexpr char str_digits_lower[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+// The largest number of digits in a given base which always fit in a limb,
+// together with the corresponding power of the base.
+struct str_chunk {
+    unsigned ndigits;
+    ::mp_limb_t pow;
+};
+
+const std::array<str_chunk, 63> &str_chunks()
+{
+    static const auto table = []() {
+        std::array<str_chunk, 63> retval{};
+        for (unsigned b = 2; b < retval.size(); ++b) {
+            unsigned nd = 0;
+            ::mp_limb_t p = 1;
+            while (p <= GMP_NUMB_MAX / b) {
+                p *= b;
+                ++nd;
+            }
+            retval[b] = str_chunk{nd, p};
+        }
+        return retval;
+    }();
+    return table;
+}
+
+// Determine the effective base of the string s (stripped of the sign) for the fast conversion
+// paths. Base 0 is supported only for decimal representations. Returns 0 if the fast paths
+// cannot be used.
+int str_effective_base(const char *s, int base)
+{
+    if (base) {
+        return base;
+    }
+    return (*s >= '1' && *s <= '9') ? 10 : 0;
+}
+
+// Pairs of decimal digits, used to convert two digits at a time.
+constexpr char str_digit_pairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                                   "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                                   "8081828384858687888990919293949596979899";
+
+// Write into the buffer ending at end the decimal digits of l, starting from the least significant.
+// If ndigits is nonzero, exactly ndigits digits are written (padding with zeroes), otherwise
+// the minimum number of digits (at least one) is written. Returns a pointer to the first digit.
+char *limb_to_str_10(char *end, ::mp_limb_t l, unsigned ndigits)
+{
+    const auto target = end - ndigits;
+    while (l >= 100u) {
+        const auto r = static_cast<std::size_t>(l % 100u);
+        l /= 100u;
+        *--end = str_digit_pairs[2u * r + 1u];
+        *--end = str_digit_pairs[2u * r];
+    }
+    if (l >= 10u) {
+        *--end = str_digit_pairs[2u * static_cast<std::size_t>(l) + 1u];
+        *--end = str_digit_pairs[2u * static_cast<std::size_t>(l)];
+    } else {
+        *--end = static_cast<char>('0' + static_cast<int>(l));
+    }
+    while (ndigits && end > target) {
+        *--end = '0';
+    }
+    return end;
+}
+
+// Check if the conversion to string in base base can use small_mpz_to_str().
+bool small_mpz_to_str_base(int base)
+{
+    return base == 10 || (base & (base - 1)) == 0;
+}
+
+// Size of a buffer large enough to hold the representation produced by small_mpz_to_chars()
+// (the sign and the digits of a 2-limb value in base 2).
+constexpr std::size_t small_mpz_str_max = 2u * unsigned(GMP_NUMB_BITS) + 1u;
+
+// Conversion to string of an mpz with at most two limbs in base 10 or in a power-of-two base.
+// Decimal digits are extracted one limb-sized chunk at a time, the digits in power-of-two bases
+// are extracted via shifts. No call to mpz_get_str() is needed. The representation is written
+// backwards into the buffer ending at end, and a pointer to its first character is returned.
+char *small_mpz_to_chars(char *end, const mpz_struct_t *mpz, int base)
+{
+    assert(small_mpz_to_str_base(base));
+    const auto size = mpz->_mp_size;
+    auto n = static_cast<std::size_t>(size >= 0 ? make_unsigned(size) : nint_abs(size));
+    assert(n <= 2u);
+    std::array<::mp_limb_t, 2> tmp{};
+    copy_limbs(mpz->_mp_d, mpz->_mp_d + n, tmp.data());
+    auto ptr = end;
+    if (base == 10) {
+        const auto &chunk = str_chunks()[10];
+        while (n > 1u) {
+            const auto r = ::mpn_divrem_1(tmp.data(), 0, tmp.data(), static_cast<::mp_size_t>(n), chunk.pow);
+            ptr = limb_to_str_10(ptr, r, chunk.ndigits);
+            n -= static_cast<std::size_t>(tmp[n - 1u] == 0u);
+        }
+        ptr = limb_to_str_10(ptr, tmp[0], 0);
+    } else {
+        unsigned shift = 0;
+        while ((1 << shift) != base) {
+            ++shift;
+        }
+        const auto mask = static_cast<::mp_limb_t>(base - 1);
+        auto lo = tmp[0], hi = tmp[1];
+        do {
+            *--ptr = str_digits_lower[lo & mask];
+            lo = ((lo >> shift) | (hi << (unsigned(GMP_NUMB_BITS) - shift))) & GMP_NUMB_MASK;
+            hi >>= shift;
+        } while (lo || hi);
+    }
+    if (size < 0) {
+        *--ptr = '-';
+    }
+    return ptr;
+}
+
+// Same as above, but the result is written into out as a null-terminated string.
+void small_mpz_to_str(std::vector<char> &out, const mpz_struct_t *mpz, int base)
+{
+    std::array<char, small_mpz_str_max> buffer;
+    const auto end = buffer.data() + buffer.size();
+    const auto ptr = small_mpz_to_chars(end, mpz, base);
+    out.resize(static_cast<std::vector<char>::size_type>(end - ptr) + 1u);
+    std::copy(ptr, end, out.data());
+    out.back() = '\0';
+}
+
+// Threshold (in limbs) above which the conversions between integers and strings
+// are split into chunks processed in parallel.
+constexpr std::size_t str_par_threshold = 10000;
+
+// Maximum number of threads used in the conversions, as set by set_integer_str_nthreads().
+std::atomic<unsigned> str_nthreads{1};
+
+// Number of times the parallel conversions are split in two (the number of threads
+// is two to the power of the depth). A depth of zero means that the conversions are serial.
+unsigned str_par_depth()
+{
+    auto nthreads = str_nthreads.load(std::memory_order_relaxed);
+    // NOTE: hardware_concurrency() may return zero if the value
+    // is not well defined or not computable. In such case, a nonzero
+    // number of threads requested by the user is honoured as is.
+    const auto hc = std::thread::hardware_concurrency();
+    if (!nthreads || (hc && nthreads > hc)) {
+        nthreads = hc;
+    }
+    unsigned retval = 0;
+    while (retval < 6u && (2u << retval) <= nthreads) {
+        ++retval;
+    }
+    return retval;
+}
+
+// Make sure that powers contains base**(2**i) for all i in [0, imax]. The powers of the
+// last base used are cached (and thus they persist across invocations if thread-local
+// storage is available).
+void str_powers_update(std::deque<mpz_raii> &powers, int &powers_base, int base, std::size_t imax)
+{
+    if (powers_base != base) {
+        powers.clear();
+        powers_base = base;
+    }
+    while (powers.size() <= imax) {
+        powers.emplace_back();
+        if (powers.size() == 1u) {
+            ::mpz_set_ui(&powers.back().m_mpz, static_cast<unsigned long>(base));
+        } else {
+            const auto &prev = powers[powers.size() - 2u].m_mpz;
+            ::mpz_mul(&powers.back().m_mpz, &prev, &prev);
+        }
+    }
+}
+
+// Index of the largest power base**(2**i) which can be used to split a value with nd digits
+// into two parts, such that the upper part has at least as many digits as the lower one.
+std::size_t str_split_idx(std::size_t nd)
+{
+    assert(nd >= 2u);
+    std::size_t i = 0;
+    while ((std::size_t(4) << i) <= nd) {
+        ++i;
+    }
+    return i;
+}
+
+// Run f0 in a separate thread and f1 in the current thread, propagating any exception.
+// If the thread cannot be created, f0 and f1 are run serially in the current thread.
+template <typename F0, typename F1>
+void str_par_invoke(const F0 &f0, const F1 &f1)
+{
+    std::exception_ptr eptr;
+    std::thread t;
+    try {
+        t = std::thread([&f0, &eptr]() {
+            try {
+                f0();
+            } catch (...) {
+                eptr = std::current_exception();
+            }
+        });
+    } catch (const std::system_error &) {
+        f0();
+        f1();
+        return;
+    }
+    try {
+        f1();
+    } catch (...) {
+        t.join();
+        throw;
+    }
+    t.join();
+    if (eptr) {
+        std::rethrow_exception(eptr);
+    }
+}
+
+// Divide-and-conquer conversion of the nonnegative value n to a string in base base, written into out.
+// If pad is nonzero, exactly pad digits are written (n must not have more than pad digits). At each
+// level, n is split into two parts using one of the powers, and the two parts are converted in parallel.
+void mpz_to_str_dc(std::string &out, const mpz_struct_t *n, int base, std::size_t pad,
+                   const std::deque<mpz_raii> &powers, unsigned depth)
+{
+    const auto nd = pad ? pad : ::mpz_sizeinbase(n, base);
+    if (!depth || get_mpz_size(n) < str_par_threshold || nd < 4u) {
+        std::vector<char> tmp(::mpz_sizeinbase(n, base) + 2u);
+        ::mpz_get_str(tmp.data(), base, n);
+        const auto len = std::strlen(tmp.data());
+        assert(!pad || len <= pad);
+        out.assign(pad ? pad - len : 0u, '0');
+        out.append(tmp.data(), len);
+        return;
+    }
+    const auto i = std::min(str_split_idx(nd), powers.size() - 1u);
+    const auto k = std::size_t(1) << i;
+    mpz_raii q, r;
+    ::mpz_tdiv_qr(&q.m_mpz, &r.m_mpz, n, &powers[i].m_mpz);
+    std::string hi, lo;
+    str_par_invoke([&]() { mpz_to_str_dc(hi, &q.m_mpz, base, pad ? pad - k : 0u, powers, depth - 1u); },
+                   [&]() { mpz_to_str_dc(lo, &r.m_mpz, base, k, powers, depth - 1u); });
+    out.swap(hi);
+    out += lo;
+}
+
+// Parallel conversion to string of a large value. Returns false if the parallel
+// conversion is not available.
+bool par_mpz_to_str(std::vector<char> &out, const mpz_struct_t *mpz, int base)
+{
+    const auto depth = str_par_depth();
+    if (!depth) {
+        return false;
+    }
+    MPPP_MAYBE_TLS std::deque<mpz_raii> powers;
+    MPPP_MAYBE_TLS int powers_base = 0;
+    // NOTE: the conversion works on the absolute value.
+    const mpz_struct_t abs_view{mpz->_mp_alloc, mpz->_mp_size >= 0 ? mpz->_mp_size : -mpz->_mp_size, mpz->_mp_d};
+    str_powers_update(powers, powers_base, base, str_split_idx(::mpz_sizeinbase(&abs_view, base)));
+    std::string tmp;
+    mpz_to_str_dc(tmp, &abs_view, base, 0, powers, depth);
+    const auto neg = static_cast<std::size_t>(mpz->_mp_size < 0);
+    out.resize(safe_cast<std::vector<char>::size_type>(tmp.size() + neg + 1u));
+    out[0] = '-';
+    std::copy(tmp.begin(), tmp.end(), out.begin() + static_cast<std::ptrdiff_t>(neg));
+    out.back() = '\0';
+    return true;
+}
+
+// Divide-and-conquer conversion of the (validated) digits in the [begin, end) range into rop.
+void str_to_mpz_dc(mpz_struct_t &rop, const char *begin, const char *end, int base, std::size_t threshold,
+                   const std::deque<mpz_raii> &powers, unsigned depth)
+{
+    const auto nd = static_cast<std::size_t>(end - begin);
+    if (!depth || nd < threshold) {
+        const std::string tmp(begin, end);
+        const auto ret = ::mpz_set_str(&rop, tmp.c_str(), base);
+        assert(ret == 0);
+        ignore(ret);
+        return;
+    }
+    const auto i = std::min(str_split_idx(nd), powers.size() - 1u);
+    const auto k = static_cast<std::ptrdiff_t>(std::size_t(1) << i);
+    mpz_raii hi;
+    str_par_invoke([&]() { str_to_mpz_dc(hi.m_mpz, begin, end - k, base, threshold, powers, depth - 1u); },
+                   [&]() { str_to_mpz_dc(rop, end - k, end, base, threshold, powers, depth - 1u); });
+    ::mpz_addmul(&rop, &hi.m_mpz, &powers[i].m_mpz);
+}
+
+} // namespace
+
+namespace
+{
+
+// Implementation of str_to_small_limbs(), operating on the range of digits [s, end).
+// Base, if nonzero, is the base as a compile-time constant, so that the compiler can optimise
+// the digit checks and the multiplications.
+template <unsigned Base>
+bool str_to_small_limbs_impl(const char *s, const char *end, int base, bool neg, ::mp_limb_t *out,
+                             mpz_size_t &size)
+{
+    const ::mp_limb_t b = Base ? Base : static_cast<::mp_limb_t>(base);
+    const auto &chunk = str_chunks()[static_cast<std::size_t>(base)];
+    // NOTE: the value of a string with at most 2 * ndigits digits is less
+    // than base**(2 * ndigits), and thus it fits in two limbs.
+    if (s == end || static_cast<std::size_t>(end - s) > 2u * chunk.ndigits) {
+        return false;
+    }
+    std::array<::mp_limb_t, 2> acc{};
+    ::mp_size_t n = 0;
+    while (s != end) {
+        // Accumulate up to ndigits digits into a single limb.
+        ::mp_limb_t l = 0, pow = 1;
+        for (unsigned i = 0; i < chunk.ndigits && s != end; ++i, ++s) {
+            const auto d = Base == 10u ? (static_cast<unsigned>(*s - '0') < 10u ? *s - '0' : -1)
+                                       : str_digit_value(*s, base);
+            if (d < 0) {
+                return false;
+            }
+            l = l * b + static_cast<::mp_limb_t>(d);
+            pow *= b;
+        }
+        // acc = acc * pow + l.
+        if (n) {
+            const auto c = ::mpn_mul_1(acc.data(), acc.data(), n, pow);
+            if (c) {
+                assert(n == 1);
+                acc[1] = c;
+                n = 2;
+            }
+            if (::mpn_add_1(acc.data(), acc.data(), n, l)) {
+                assert(n == 1);
+                acc[1] = 1;
+                n = 2;
+            }
+        } else if (l) {
+            acc[0] = l;
+            n = 1;
+        }
+    }
+    out[0] = acc[0];
+    out[1] = acc[1];
+    size = neg ? static_cast<mpz_size_t>(-n) : static_cast<mpz_size_t>(n);
+    return true;
+}
+
+// Dispatch str_to_small_limbs_impl() on the base.
+bool str_to_small_limbs_dispatch(const char *s, const char *end, int base, bool neg, ::mp_limb_t *out,
+                                 mpz_size_t &size)
+{
+    if (base == 10) {
+        return str_to_small_limbs_impl<10>(s, end, base, neg, out, size);
+    }
+    return str_to_small_limbs_impl<0>(s, end, base, neg, out, size);
+}
+
+} // namespace
+
+bool str_to_small_limbs(const char *s, int base, ::mp_limb_t *out, mpz_size_t &size)
+{
+    const bool neg = *s == '-';
+    s += neg;
+    base = str_effective_base(s, base);
+    if (!base) {
+        return false;
+    }
+    // NOTE: look for the terminator among the first 2 * ndigits + 1 characters
+    // only, so that long strings are rejected quickly.
+    const auto max_len = 2u * str_chunks()[static_cast<std::size_t>(base)].ndigits + 1u;
+    auto end = s;
+    for (std::size_t i = 0; i < max_len && *end != '\0'; ++i, ++end) {
+    }
+    return str_to_small_limbs_dispatch(s, end, base, neg, out, size);
+}
+
+int mpz_set_str_wrap(mpz_struct_t &rop, const char *s, int base)
+{
+    const bool neg = *s == '-';
+    const auto digits = s + static_cast<std::ptrdiff_t>(neg);
+    const auto eff_base = str_effective_base(digits, base);
+    if (!eff_base) {
+        return ::mpz_set_str(&rop, s, base);
+    }
+    const auto threshold = str_par_threshold * str_chunks()[static_cast<std::size_t>(eff_base)].ndigits;
+    const auto depth = str_par_depth();
+    const auto len = std::strlen(digits);
+    if (!depth || len < threshold
+        || !std::all_of(digits, digits + len, [eff_base](char c) { return str_digit_value(c, eff_base) >= 0; })) {
+        return ::mpz_set_str(&rop, s, base);
+    }
+    MPPP_MAYBE_TLS std::deque<mpz_raii> powers;
+    MPPP_MAYBE_TLS int powers_base = 0;
+    str_powers_update(powers, powers_base, eff_base, str_split_idx(len));
+    str_to_mpz_dc(rop, digits, digits + len, eff_base, threshold, powers, depth);
+    if (neg) {
+        ::mpz_neg(&rop, &rop);
+    }
+    return 0;
+}
+
 void mpz_to_str(std::vector<char> &out, const mpz_struct_t *mpz, int base)
 {
     assert(base >= 2 && base <= 62);
+    const auto asize = get_mpz_size(mpz);
+    if (asize <= 2u && small_mpz_to_str_base(base)) {
+        small_mpz_to_str(out, mpz, base);
+        return;
+    }
+    if (asize >= str_par_threshold && par_mpz_to_str(out, mpz, base)) {
+        return;
+    }
     const auto size_base = ::mpz_sizeinbase(mpz, base);
     // LCOV_EXCL_START
     if (mppp_unlikely(size_base > nl_max<std::size_t>() - 2u)) {
@@ -258,6 +859,202 @@ void mpz_to_str(std::vector<char> &out, const mpz_struct_t *mpz, int base)
     ::mpz_get_str(out.data(), base, mpz);
 }
 
+to_chars_result mpz_to_chars(char *first, char *last, const mpz_struct_t *mpz, int base)
+{
+    assert(base >= 2 && base <= 62);
+    assert(first <= last);
+    const auto avail = static_cast<std::size_t>(last - first);
+    const auto asize = get_mpz_size(mpz);
+    if (asize <= 2u && small_mpz_to_str_base(base)) {
+        std::array<char, small_mpz_str_max> buffer;
+        const auto end = buffer.data() + buffer.size();
+        const auto ptr = small_mpz_to_chars(end, mpz, base);
+        if (static_cast<std::size_t>(end - ptr) > avail) {
+            return {last, std::errc::value_too_large};
+        }
+        return {std::copy(ptr, end, first), std::errc{}};
+    }
+    if (asize < str_par_threshold) {
+        // If the output range can hold the size in base plus an optional sign and the
+        // null terminator, we can let mpz_get_str() write directly into it.
+        const auto size_base = ::mpz_sizeinbase(mpz, base);
+        if (size_base <= avail && avail - size_base >= 2u) {
+            ::mpz_get_str(first, base, mpz);
+            return {first + std::strlen(first), std::errc{}};
+        }
+    }
+    // Otherwise, go through a thread-local buffer (which, in the long run, will
+    // not need to allocate memory).
+    MPPP_MAYBE_TLS std::vector<char> tmp;
+    mpz_to_str(tmp, mpz, base);
+    const auto len = std::strlen(tmp.data());
+    if (len > avail) {
+        return {last, std::errc::value_too_large};
+    }
+    return {std::copy(tmp.data(), tmp.data() + len, first), std::errc{}};
+}
+
+from_chars_result mpz_from_chars(const char *first, const char *last, int base, ::mp_limb_t *limbs, mpz_size_t &size,
+                                 const mpz_struct_t *&mpz)
+{
+    assert(first <= last);
+    if (mppp_unlikely(base < 2 || base > 62)) {
+        return {first, std::errc::invalid_argument};
+    }
+    const bool neg = first != last && *first == '-';
+    const auto begin = first + static_cast<std::ptrdiff_t>(neg);
+    const auto end = std::find_if(begin, last, [base](char c) { return str_digit_value(c, base) < 0; });
+    if (begin == end) {
+        return {first, std::errc::invalid_argument};
+    }
+    if (str_to_small_limbs_dispatch(begin, end, base, neg, limbs, size)) {
+        mpz = nullptr;
+        return {end, std::errc{}};
+    }
+    // Large value: copy the (already validated) digits into a thread-local
+    // buffer, and parse it into a thread-local mpz.
+    MPPP_MAYBE_TLS std::vector<char> buffer;
+    MPPP_MAYBE_TLS mpz_raii tmp;
+    buffer.assign(begin, end);
+    buffer.push_back('\0');
+    const auto ret = mpz_set_str_wrap(tmp.m_mpz, buffer.data(), base);
+    assert(ret == 0);
+    ignore(ret);
+    if (neg) {
+        ::mpz_neg(&tmp.m_mpz, &tmp.m_mpz);
+    }
+    mpz = &tmp.m_mpz;
+    return {end, std::errc{}};
+}
+
+long long fp_shortest_digits(std::vector<char> &out, const mpz_struct_t *m, long long e, bool lower_closer, int base)
+{
+    assert(base >= 2 && base <= 62);
+    assert(mpz_sgn(m) > 0);
+    // NOTE: this is the general case of the Ryu algorithm (Adams, 2018), with the fixed-width
+    // arithmetic replaced by exact multiprecision arithmetic. Working in units of 2**(e - 2),
+    // the value is mv = 4 * m and the rounding interval (i.e., the set of values which round
+    // to m * 2**e) has bounds mm and mp. With round-to-nearest-even, the bounds are included
+    // if m is even.
+    MPPP_MAYBE_TLS mpz_raii mv, mp, mm, vr, vp, vm, den, pw, rem;
+    const auto e2 = e - 2;
+    const bool accept_bounds = mpz_even_p(m) != 0;
+    const auto b = static_cast<unsigned long>(base);
+
+    ::mpz_mul_2exp(&mv.m_mpz, m, 2);
+    ::mpz_add_ui(&mp.m_mpz, &mv.m_mpz, 2);
+    ::mpz_sub_ui(&mm.m_mpz, &mv.m_mpz, lower_closer ? 1u : 2u);
+    // NOTE: in order to round correctly also in odd bases, we keep track of
+    // 2 * mv (i.e., the value in units of 2**(e - 3)).
+    ::mpz_mul_2exp(&mv.m_mpz, &mv.m_mpz, 1);
+
+    // Choose the exponent q so that the width of the rounding interval, which is at least 3 * 2**e2,
+    // is at least 1.5 * base**3 when expressed in units of base**q. This guarantees (with some margin for
+    // the floating-point estimate) that vp - vm is at least base, and thus that at least one digit
+    // is removed below. The exponent is kept as large as possible in order to minimise the size of
+    // the operands (e.g., in the quadruple-precision case the bounds fit in 128 bits).
+    const auto q0 = static_cast<long long>(
+                        std::floor(static_cast<double>(e2 + 1) * std::log(2.) / std::log(static_cast<double>(base))))
+                    - 3;
+    auto q = q0;
+    // Compute the scaling factor, which is reused across calls with the same base and exponents
+    // (this is the common case when converting many values of similar magnitude).
+    MPPP_MAYBE_TLS int den_base = 0;
+    MPPP_MAYBE_TLS long long den_q = 0, den_e2 = 0;
+    const auto cur_e2 = (q >= 0 && e2 < 0) ? e2 : 0;
+    if (den_base != base || den_q != q || den_e2 != cur_e2) {
+        ::mpz_ui_pow_ui(&den.m_mpz, b, static_cast<unsigned long>(q >= 0 ? q : -q));
+        if (cur_e2) {
+            ::mpz_mul_2exp(&den.m_mpz, &den.m_mpz, static_cast<::mp_bitcnt_t>(-cur_e2));
+        }
+        den_base = base;
+        den_q = q;
+        den_e2 = cur_e2;
+    }
+    // Compute rop = floor(n * 2**e2 / base**q), returning true if the division is exact.
+    const auto scaled_floor = [&](mpz_struct_t &rop, const mpz_struct_t &n) -> bool {
+        if (q >= 0) {
+            if (e2 >= 0) {
+                ::mpz_mul_2exp(&rop, &n, static_cast<::mp_bitcnt_t>(e2));
+                ::mpz_tdiv_qr(&rop, &rem.m_mpz, &rop, &den.m_mpz);
+            } else {
+                ::mpz_tdiv_qr(&rop, &rem.m_mpz, &n, &den.m_mpz);
+            }
+            return mpz_sgn(&rem.m_mpz) == 0;
+        }
+        ::mpz_mul(&rop, &n, &den.m_mpz);
+        if (e2 >= 0) {
+            ::mpz_mul_2exp(&rop, &rop, static_cast<::mp_bitcnt_t>(e2));
+            return true;
+        }
+        const auto shift = static_cast<::mp_bitcnt_t>(-e2);
+        const bool exact = ::mpz_divisible_2exp_p(&rop, shift) != 0;
+        ::mpz_tdiv_q_2exp(&rop, &rop, shift);
+        return exact;
+    };
+    bool vm_tz = scaled_floor(vm.m_mpz, mm.m_mpz) && accept_bounds;
+    if (scaled_floor(vp.m_mpz, mp.m_mpz) && !accept_bounds) {
+        ::mpz_sub_ui(&vp.m_mpz, &vp.m_mpz, 1);
+    }
+    // NOTE: vr is floor(2 * value / base**q), vr_exact signals if the division is exact.
+    bool vr_exact = scaled_floor(vr.m_mpz, mv.m_mpz);
+    assert(::mpz_cmp(&vp.m_mpz, &vm.m_mpz) > 0);
+
+    // Remove digits from the bounds while their truncations differ. If the lower bound is included
+    // and exactly representable, keep on removing digits as long as they are zero in the lower bound.
+    // NOTE: rather than removing one digit at a time as in Ryu, we compute directly the number of digits
+    // to remove from the representations of the bounds in base b: the truncations of the bounds differ
+    // as long as they contain the first digit which differs in the two representations.
+    MPPP_MAYBE_TLS std::vector<char> vp_str, vm_str;
+    mpz_to_str(vp_str, &vp.m_mpz, base);
+    mpz_to_str(vm_str, &vm.m_mpz, base);
+    const auto lp = std::strlen(vp_str.data()), lm = std::strlen(vm_str.data());
+    assert(lp >= lm);
+    // Length of the common prefix of the representations (vm is implicitly padded
+    // with leading zeroes to the length of vp).
+    std::size_t cp = 0;
+    if (lp == lm) {
+        for (; vp_str[cp] == vm_str[cp]; ++cp) {
+        }
+    }
+    assert(cp < lp);
+    auto nr = lp - cp - 1u;
+    if (vm_tz) {
+        std::size_t tz = 0;
+        for (; tz + 1u < lm && vm_str[lm - 1u - tz] == '0'; ++tz) {
+        }
+        if (tz >= nr) {
+            nr = tz;
+        } else {
+            vm_tz = false;
+        }
+    }
+    assert(nr > 0u);
+    ::mpz_ui_pow_ui(&pw.m_mpz, b, static_cast<unsigned long>(nr));
+    ::mpz_tdiv_q(&vm.m_mpz, &vm.m_mpz, &pw.m_mpz);
+    ::mpz_tdiv_qr(&vr.m_mpz, &rem.m_mpz, &vr.m_mpz, &pw.m_mpz);
+    vr_exact = vr_exact && mpz_sgn(&rem.m_mpz) == 0;
+    q += static_cast<long long>(nr);
+
+    // Round the value to the digits that have been kept, to nearest with ties to even: with
+    // t = floor(2 * value / base**q), the value must be rounded up if t - 2 * floor(t / 2) is 1
+    // and the division is either inexact or floor(t / 2) is odd.
+    const bool half = ::mpz_tstbit(&vr.m_mpz, 0) != 0;
+    ::mpz_tdiv_q_2exp(&vr.m_mpz, &vr.m_mpz, 1);
+    // NOTE: if the truncation of the value is the truncation of the lower bound
+    // and the lower bound is not included, the value must be rounded up.
+    if ((half && (!vr_exact || mpz_odd_p(&vr.m_mpz))) || (!vm_tz && ::mpz_cmp(&vr.m_mpz, &vm.m_mpz) == 0)) {
+        ::mpz_add_ui(&vr.m_mpz, &vr.m_mpz, 1);
+    }
+    // Strip the trailing zeroes.
+    while (::mpz_divisible_ui_p(&vr.m_mpz, b)) {
+        ::mpz_divexact_ui(&vr.m_mpz, &vr.m_mpz, b);
+        ++q;
+    }
+    mpz_to_str(out, &vr.m_mpz, base);
+    return q;
+}
+
 std::ostream &integer_stream_operator_impl(std::ostream &os, const mpz_struct_t *n, int n_sgn)
 {
     // Get the stream width.
@@ -395,4 +1192,99 @@ void free_integer_caches()
 #endif
 }
 
+void trim_integer_caches(std::size_t max_bytes)
+{
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    detail::mpz_alloc_cache_inst.trim(max_bytes);
+#else
+    detail::ignore(max_bytes);
+#endif
+}
+
+void set_integer_cache_limits(std::size_t max_size, std::size_t max_entries)
+{
+    if (mppp_unlikely(max_size > detail::mpz_alloc_cache::max_supported_size)) {
+        throw std::invalid_argument("Cannot set the maximum size of the cached integer limb arrays to "
+                                    + detail::to_string(max_size) + ": the maximum allowed value is "
+                                    + detail::to_string(detail::mpz_alloc_cache::max_supported_size));
+    }
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    auto &mpzc = detail::mpz_alloc_cache_inst;
+    mpzc.max_size = max_size;
+    mpzc.max_entries = max_entries;
+    // Remove from the cache the arrays which do not satisfy the new limits.
+    std::vector<std::pair<::mp_limb_t *, std::size_t>> tmp;
+    for (std::size_t c = 0; c < detail::mpz_alloc_cache::nclasses; ++c) {
+        if (mpzc.sizes[c] <= max_entries && detail::mpz_cache_class_lo(c) <= max_size) {
+            // NOTE: the arrays in a size class all have a size greater than or equal
+            // to the lower bound of the class. Thus, if the last condition above is true,
+            // we might still need to remove arrays from this class, unless this is an exact class.
+            if (c < detail::mpz_cache_nexact || c + 1u == detail::mpz_alloc_cache::nclasses
+                || detail::mpz_cache_class_lo(c + 1u) - 1u <= max_size) {
+                continue;
+            }
+        }
+        // NOTE: reserve before modifying the cache, so that
+        // an exception will leave the cache untouched.
+        tmp.clear();
+        tmp.reserve(mpzc.sizes[c]);
+        while (mpzc.sizes[c]) {
+            std::size_t alloc = 0;
+            const auto ptr = detail::mpz_cache_pop(mpzc, c, alloc);
+            tmp.emplace_back(ptr, alloc);
+        }
+        // Re-insert in reverse order in order to preserve the original ordering.
+        for (auto it = tmp.rbegin(); it != tmp.rend(); ++it) {
+            if (it->second <= max_size && mpzc.sizes[c] < max_entries) {
+                detail::mpz_cache_push(mpzc, c, it->first, it->second);
+            } else {
+                detail::mpz_cache_free(it->first, it->second);
+            }
+        }
+    }
+#else
+    detail::ignore(max_entries);
+#endif
+}
+
+std::pair<std::size_t, std::size_t> get_integer_cache_limits()
+{
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    const auto &mpzc = detail::mpz_alloc_cache_inst;
+    return std::make_pair(mpzc.max_size, mpzc.max_entries);
+#else
+    return std::make_pair(std::size_t(0), std::size_t(0));
+#endif
+}
+
+integer_cache_stats get_integer_cache_stats()
+{
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    const auto &mpzc = detail::mpz_alloc_cache_inst;
+    return integer_cache_stats{mpzc.hits, mpzc.misses, mpzc.evictions, mpzc.nbytes};
+#else
+    return integer_cache_stats{0, 0, 0, 0};
+#endif
+}
+
+void reset_integer_cache_stats()
+{
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    auto &mpzc = detail::mpz_alloc_cache_inst;
+    mpzc.hits = 0;
+    mpzc.misses = 0;
+    mpzc.evictions = 0;
+#endif
+}
+
+void set_integer_str_nthreads(unsigned n)
+{
+    detail::str_nthreads.store(n, std::memory_order_relaxed);
+}
+
+unsigned get_integer_str_nthreads()
+{
+    return detail::str_nthreads.load(std::memory_order_relaxed);
+}
+
 } // namespace mppp
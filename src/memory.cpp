@@ -0,0 +1,218 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <mp++/config.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/memory.hpp>
+
+namespace mppp
+{
+
+namespace detail
+{
+
+namespace
+{
+
+// The alignment of the memory handed out by the arenas.
+constexpr std::size_t arena_align = alignof(std::max_align_t);
+
+// Round up n to a multiple of arena_align.
+std::size_t arena_round(std::size_t n) noexcept
+{
+    // LCOV_EXCL_START
+    if (mppp_unlikely(n > nl_max<std::size_t>() - (arena_align - 1u))) {
+        // NOTE: here we are doing what GMP does in case of memory allocation errors.
+        std::abort();
+    }
+    // LCOV_EXCL_STOP
+    return (n + (arena_align - 1u)) / arena_align * arena_align;
+}
+
+} // namespace
+
+arena::arena(std::size_t block_size) : m_next_size(block_size), m_nbytes(0)
+{
+    ::mp_get_memory_functions(&m_alloc, nullptr, &m_free);
+}
+
+arena::~arena()
+{
+    for (const auto &b : m_blocks) {
+        m_free(b.ptr, b.size);
+    }
+}
+
+void *arena::allocate(std::size_t size) noexcept
+{
+    size = arena_round(size);
+    if (m_blocks.empty() || m_blocks.back().size - m_blocks.back().top < size) {
+        // Not enough room in the current block, add a new one.
+        const auto bsize = arena_round(std::max(size, m_next_size));
+        // NOTE: GMP's allocation functions do not return on failure.
+        const auto ptr = static_cast<unsigned char *>(m_alloc(bsize));
+        try {
+            m_blocks.push_back(block{ptr, bsize, 0});
+            // LCOV_EXCL_START
+        } catch (...) {
+            // NOTE: memory resources cannot throw.
+            std::abort();
+        }
+        // LCOV_EXCL_STOP
+        m_next_size = bsize > nl_max<std::size_t>() / 2u ? bsize : bsize * 2u;
+    }
+    auto &b = m_blocks.back();
+    const auto retval = b.ptr + b.top;
+    b.top += size;
+    m_nbytes += size;
+    return retval;
+}
+
+void arena::deallocate(void *ptr, std::size_t size) noexcept
+{
+    assert(owns(ptr));
+    size = arena_round(size);
+    // NOTE: the memory is actually reclaimed only if this was
+    // the last allocation.
+    auto &b = m_blocks.back();
+    if (b.top >= size && static_cast<unsigned char *>(ptr) == b.ptr + (b.top - size)) {
+        b.top -= size;
+    }
+    m_nbytes -= size;
+}
+
+bool arena::owns(const void *ptr) const noexcept
+{
+    const auto p = static_cast<const unsigned char *>(ptr);
+    const std::less<const unsigned char *> lt;
+    // NOTE: look first in the most recent blocks.
+    return std::any_of(m_blocks.rbegin(), m_blocks.rend(),
+                       [p, &lt](const block &b) { return !lt(p, b.ptr) && lt(p, b.ptr + b.size); });
+}
+
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+
+namespace
+{
+
+// The stack of memory resources of the current thread.
+thread_local memory_resource_node *memory_resource_inst = nullptr;
+
+} // namespace
+
+void push_memory_resource(memory_resource_node &node)
+{
+    node.prev = memory_resource_inst;
+    memory_resource_inst = &node;
+}
+
+void pop_memory_resource(memory_resource_node &node)
+{
+    // NOTE: scopes are destroyed in reverse order of construction.
+    assert(memory_resource_inst == &node);
+    memory_resource_inst = node.prev;
+}
+
+memory_resource *get_thread_local_integer_resource()
+{
+    return memory_resource_inst == nullptr ? nullptr : memory_resource_inst->int_res;
+}
+
+memory_resource *get_thread_local_real_resource()
+{
+    return memory_resource_inst == nullptr ? nullptr : memory_resource_inst->real_res;
+}
+
+#else
+
+void push_memory_resource(memory_resource_node &) {}
+
+void pop_memory_resource(memory_resource_node &) {}
+
+memory_resource *get_thread_local_integer_resource()
+{
+    return nullptr;
+}
+
+memory_resource *get_thread_local_real_resource()
+{
+    return nullptr;
+}
+
+#endif
+
+heap_alloc_guard::heap_alloc_guard() : m_node{nullptr, nullptr, nullptr}
+{
+    push_memory_resource(m_node);
+}
+
+heap_alloc_guard::~heap_alloc_guard()
+{
+    pop_memory_resource(m_node);
+}
+
+} // namespace detail
+
+memory_resource::~memory_resource() {}
+
+memory_resource_scope::memory_resource_scope(memory_resource &res) : m_node{&res, &res, nullptr}
+{
+    detail::push_memory_resource(m_node);
+}
+
+memory_resource_scope::~memory_resource_scope()
+{
+    detail::pop_memory_resource(m_node);
+}
+
+#if MPPP_CPLUSPLUS < 201703L
+
+constexpr std::size_t arena_scope::default_block_size;
+
+#endif
+
+arena_scope::arena_scope(std::size_t block_size) : m_arena(block_size), m_node{nullptr, &m_arena, nullptr}
+{
+    if (mppp_unlikely(!block_size)) {
+        throw std::invalid_argument("The block size of an arena_scope must be nonzero");
+    }
+    // NOTE: the storage of integers keeps on being
+    // provided by the enclosing scope, if any.
+    m_node.int_res = detail::get_thread_local_integer_resource();
+    detail::push_memory_resource(m_node);
+}
+
+arena_scope::~arena_scope()
+{
+    detail::pop_memory_resource(m_node);
+}
+
+std::size_t arena_scope::get_nbytes() const
+{
+    return m_arena.m_nbytes;
+}
+
+std::size_t arena_scope::get_capacity() const
+{
+    std::size_t retval = 0;
+    for (const auto &b : m_arena.m_blocks) {
+        retval += b.size;
+    }
+    return retval;
+}
+
+} // namespace mppp
@@ -12,12 +12,18 @@
 #include <array>
 #include <atomic>
 #include <cassert>
+#include <cctype>
+#include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -33,6 +39,7 @@
 #include <flint/fmpz.h>
 
 #include <arb.h>
+#include <arb_hypgeom.h>
 #include <arf.h>
 #include <mag.h>
 
@@ -43,12 +50,17 @@
 #include <mp++/detail/type_traits.hpp>
 #include <mp++/detail/utils.hpp>
 #include <mp++/integer.hpp>
+#include <mp++/memory.hpp>
 #include <mp++/real.hpp>
 
 #if defined(MPPP_WITH_QUADMATH)
 #include <mp++/real128.hpp>
 #endif
 
+#if defined(MPPP_WITH_ARB)
+#include <mp++/real_ball.hpp>
+#endif
+
 namespace mppp
 {
 
@@ -236,29 +248,89 @@ thread_local const flint_cleanup flint_cleanup_inst;
 
 #endif
 
+// Per-thread workspace for the Arb wrappers.
+// NOTE: the arb_t objects are never cleared between uses, so that
+// their memory buffers are reused across calls (and across the wrappers).
+struct arb_workspace {
+    arb_workspace() = default;
+    arb_workspace(const arb_workspace &) = delete;
+    arb_workspace(arb_workspace &&) = delete;
+    arb_workspace &operator=(const arb_workspace &) = delete;
+    arb_workspace &operator=(arb_workspace &&) = delete;
+    ~arb_workspace()
+    {
+        if (m_vec != nullptr) {
+            ::_arb_vec_clear(m_vec, m_vec_size);
+        }
+    }
+    // Make sure that m_vec contains at least n elements.
+    void reserve_vec(::slong n)
+    {
+        if (n <= m_vec_size) {
+            return;
+        }
+        // NOTE: grow geometrically, and move the existing
+        // elements (together with their buffers) into the new vector.
+        const auto new_size = std::max(n, m_vec_size * 2);
+        auto new_vec = ::_arb_vec_init(new_size);
+        for (::slong i = 0; i < m_vec_size; ++i) {
+            ::arb_swap(new_vec + i, m_vec + i);
+        }
+        if (m_vec != nullptr) {
+            ::_arb_vec_clear(m_vec, m_vec_size);
+        }
+        m_vec = new_vec;
+        m_vec_size = new_size;
+    }
+    // Storage for the result and the operands
+    // of the scalar wrappers.
+    arb_raii m_rop, m_x, m_y, m_z;
+    arf_raii m_tmp;
+    // Storage for the operands of the batched wrappers.
+    ::arb_ptr m_vec = nullptr;
+    ::slong m_vec_size = 0;
+    std::vector<::mpfr_prec_t> m_precs;
+};
+
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+
+// The workspace for the current thread.
+// NOTE: this is defined after flint_cleanup_inst, so that
+// it is destroyed before flint_cleanup() is invoked.
+thread_local arb_workspace arb_ws;
+
+#define MPPP_ARB_WORKSPACE(ws) auto &ws = detail::arb_ws
+
+#else
+
+// NOTE: without a working thread_local, each call
+// uses its own workspace.
+#define MPPP_ARB_WORKSPACE(ws) detail::arb_workspace ws
+
+#endif
+
 #endif
 
 } // namespace
 
 #if defined(MPPP_WITH_ARB)
 
-// Helper for the implementation of unary Arb wrappers.
-// NOTE: it would probably pay off to put a bunch of thread-local arb_raii
-// objects in the unnamed namespace above, and use those, instead of function-local
-// statics, to convert to/from MPFR. However such a scheme would not work
-// on MinGW due to the thread_local issues, so as long as we support MinGW
-// (or any platform with non-functional thread_local), we cannot adopt this approach.
+// The implementation of the Arb wrappers is split in two parts:
+// - the conversion of the input values from MPFR to Arb,
+// - the computation, which writes the result directly into the
+//   output mpfr_t.
+// The scalar wrappers convert their operands into the thread-local workspace,
+// while the batched wrappers convert all the operands in a single pass before
+// performing any computation.
+
 #define MPPP_UNARY_ARB_WRAPPER(fname)                                                                                  \
-    void arb_##fname(::mpfr_t rop, const ::mpfr_t op)                                                                  \
+    void arb_##fname##_impl(::mpfr_t rop, const ::arb_t op, arb_workspace &ws)                                         \
     {                                                                                                                  \
-        MPPP_MAYBE_TLS arb_raii arb_rop, arb_op;                                                                       \
-        /* Turn op into an arb. */                                                                                     \
-        mpfr_to_arb(arb_op.m_arb, op);                                                                                 \
         /* Run the computation, using the precision of rop to mimic */                                                 \
         /* the behaviour of MPFR functions. */                                                                         \
-        ::arb_##fname(arb_rop.m_arb, arb_op.m_arb, mpfr_prec_to_arb_prec(mpfr_get_prec(rop)));                         \
+        ::arb_##fname(ws.m_rop.m_arb, op, mpfr_prec_to_arb_prec(mpfr_get_prec(rop)));                                  \
         /* Write the result into rop. */                                                                               \
-        arf_to_mpfr(rop, arb_midref(arb_rop.m_arb));                                                                   \
+        arf_to_mpfr(rop, arb_midref(ws.m_rop.m_arb));                                                                  \
     }
 
 // Implementation of the Arb MPFR wrappers.
@@ -266,25 +338,20 @@ MPPP_UNARY_ARB_WRAPPER(sqrt1pm1)
 
 // NOTE: log_hypot needs special handling for certain
 // input values.
-void arb_log_hypot(::mpfr_t rop, const ::mpfr_t x, const ::mpfr_t y)
+void arb_log_hypot_impl(::mpfr_t rop, const ::arb_t x, const ::arb_t y, arb_workspace &ws)
 {
     // Special handling if at least one of x and y is an inf,
     // and the other is not a NaN.
-    if (mpfr_inf_p(x) && !mpfr_nan_p(y)) {
+    if (::arf_is_inf(arb_midref(x)) && !::arf_is_nan(arb_midref(y))) {
         // x is inf, y not a nan. Return +inf.
         ::mpfr_set_inf(rop, 1);
-    } else if (!mpfr_nan_p(x) && mpfr_inf_p(y)) {
+    } else if (!::arf_is_nan(arb_midref(x)) && ::arf_is_inf(arb_midref(y))) {
         // y is inf, x not a nan. Return +inf.
         ::mpfr_set_inf(rop, 1);
     } else {
-        MPPP_MAYBE_TLS arb_raii arb_rop, arb_x, arb_y;
-
-        mpfr_to_arb(arb_x.m_arb, x);
-        mpfr_to_arb(arb_y.m_arb, y);
-
-        ::arb_log_hypot(arb_rop.m_arb, arb_x.m_arb, arb_y.m_arb, mpfr_prec_to_arb_prec(mpfr_get_prec(rop)));
+        ::arb_log_hypot(ws.m_rop.m_arb, x, y, mpfr_prec_to_arb_prec(mpfr_get_prec(rop)));
 
-        arf_to_mpfr(rop, arb_midref(arb_rop.m_arb));
+        arf_to_mpfr(rop, arb_midref(ws.m_rop.m_arb));
     }
 }
 
@@ -293,57 +360,47 @@ MPPP_UNARY_ARB_WRAPPER(cos_pi)
 
 // NOTE: tan_pi needs special handling for certain
 // input values.
-void arb_tan_pi(::mpfr_t rop, const ::mpfr_t op)
+void arb_tan_pi_impl(::mpfr_t rop, const ::arb_t op, arb_workspace &ws)
 {
-    MPPP_MAYBE_TLS arb_raii arb_op;
-    mpfr_to_arb(arb_op.m_arb, op);
-
     // If op is exactly n/2 (with n an odd integer),
     // the Arb function will return nan rather than +-inf.
     // Handle this case specially.
-    if (!::arf_is_int(arb_midref(arb_op.m_arb)) && ::arf_is_int_2exp_si(arb_midref(arb_op.m_arb), -1)) {
-        MPPP_MAYBE_TLS arf_raii arf_tmp;
-
+    if (!::arf_is_int(arb_midref(op)) && ::arf_is_int_2exp_si(arb_midref(op), -1)) {
         // The strategy is to truncate op and then, based
         // on the parity of the result, return +inf or -inf.
         // Because Arb does not have a truncation primitive,
         // we need to use floor/ceil depending on the sign
         // of op.
-        if (::arf_sgn(arb_midref(arb_op.m_arb)) == 1) {
+        if (::arf_sgn(arb_midref(op)) == 1) {
             // op > 0.
-            ::arf_floor(arf_tmp.m_arf, arb_midref(arb_op.m_arb));
-            ::mpfr_set_inf(rop, ::arf_is_int_2exp_si(arf_tmp.m_arf, 1) ? 1 : -1);
+            ::arf_floor(ws.m_tmp.m_arf, arb_midref(op));
+            ::mpfr_set_inf(rop, ::arf_is_int_2exp_si(ws.m_tmp.m_arf, 1) ? 1 : -1);
         } else {
             // op < 0.
-            assert(::arf_sgn(arb_midref(arb_op.m_arb)) == -1);
-            ::arf_ceil(arf_tmp.m_arf, arb_midref(arb_op.m_arb));
-            ::mpfr_set_inf(rop, ::arf_is_int_2exp_si(arf_tmp.m_arf, 1) ? -1 : 1);
+            assert(::arf_sgn(arb_midref(op)) == -1);
+            ::arf_ceil(ws.m_tmp.m_arf, arb_midref(op));
+            ::mpfr_set_inf(rop, ::arf_is_int_2exp_si(ws.m_tmp.m_arf, 1) ? -1 : 1);
         }
     } else {
-        MPPP_MAYBE_TLS arb_raii arb_rop;
+        ::arb_tan_pi(ws.m_rop.m_arb, op, mpfr_prec_to_arb_prec(mpfr_get_prec(rop)));
 
-        ::arb_tan_pi(arb_rop.m_arb, arb_op.m_arb, mpfr_prec_to_arb_prec(mpfr_get_prec(rop)));
-
-        arf_to_mpfr(rop, arb_midref(arb_rop.m_arb));
+        arf_to_mpfr(rop, arb_midref(ws.m_rop.m_arb));
     }
 }
 
 // NOTE: cot_pi needs special handling for certain
 // input values.
-void arb_cot_pi(::mpfr_t rop, const ::mpfr_t op)
+void arb_cot_pi_impl(::mpfr_t rop, const ::arb_t op, arb_workspace &ws)
 {
-    MPPP_MAYBE_TLS arb_raii arb_rop, arb_op;
-    mpfr_to_arb(arb_op.m_arb, op);
-
     // If op is exactly n (with n an integer),
     // the Arb function will return nan rather than +-inf.
     // Handle this case specially.
-    if (::arf_is_int(arb_midref(arb_op.m_arb))) {
-        ::mpfr_set_inf(rop, ::arf_is_int_2exp_si(arb_midref(arb_op.m_arb), 1) ? 1 : -1);
+    if (::arf_is_int(arb_midref(op))) {
+        ::mpfr_set_inf(rop, ::arf_is_int_2exp_si(arb_midref(op), 1) ? 1 : -1);
     } else {
-        ::arb_cot_pi(arb_rop.m_arb, arb_op.m_arb, mpfr_prec_to_arb_prec(mpfr_get_prec(rop)));
+        ::arb_cot_pi(ws.m_rop.m_arb, op, mpfr_prec_to_arb_prec(mpfr_get_prec(rop)));
 
-        arf_to_mpfr(rop, arb_midref(arb_rop.m_arb));
+        arf_to_mpfr(rop, arb_midref(ws.m_rop.m_arb));
     }
 }
 
@@ -351,26 +408,90 @@ MPPP_UNARY_ARB_WRAPPER(sinc)
 
 // NOTE: sinc_pi needs special handling for certain
 // input values.
-void arb_sinc_pi(::mpfr_t rop, const ::mpfr_t op)
+void arb_sinc_pi_impl(::mpfr_t rop, const ::arb_t op, arb_workspace &ws)
 {
     // The Arb function does not seem to handle
     // well infs or nans.
-    if (mpfr_inf_p(op)) {
+    if (::arf_is_inf(arb_midref(op))) {
         ::mpfr_set_zero(rop, 1);
-    } else if (mpfr_nan_p(op)) {
+    } else if (::arf_is_nan(arb_midref(op))) {
         ::mpfr_set_nan(rop);
     } else {
-        MPPP_MAYBE_TLS arb_raii arb_rop, arb_op;
-        mpfr_to_arb(arb_op.m_arb, op);
+        ::arb_sinc_pi(ws.m_rop.m_arb, op, mpfr_prec_to_arb_prec(mpfr_get_prec(rop)));
 
-        ::arb_sinc_pi(arb_rop.m_arb, arb_op.m_arb, mpfr_prec_to_arb_prec(mpfr_get_prec(rop)));
-
-        arf_to_mpfr(rop, arb_midref(arb_rop.m_arb));
+        arf_to_mpfr(rop, arb_midref(ws.m_rop.m_arb));
     }
 }
 
 #undef MPPP_UNARY_ARB_WRAPPER
 
+// The scalar wrappers.
+#define MPPP_UNARY_ARB_WRAPPER(fname)                                                                                  \
+    void arb_##fname(::mpfr_t rop, const ::mpfr_t op)                                                                  \
+    {                                                                                                                  \
+        MPPP_ARB_WORKSPACE(ws);                                                                                        \
+        /* Turn op into an arb. */                                                                                     \
+        mpfr_to_arb(ws.m_x.m_arb, op);                                                                                 \
+        arb_##fname##_impl(rop, ws.m_x.m_arb, ws);                                                                     \
+    }
+
+MPPP_UNARY_ARB_WRAPPER(sqrt1pm1)
+MPPP_UNARY_ARB_WRAPPER(sin_pi)
+MPPP_UNARY_ARB_WRAPPER(cos_pi)
+MPPP_UNARY_ARB_WRAPPER(tan_pi)
+MPPP_UNARY_ARB_WRAPPER(cot_pi)
+MPPP_UNARY_ARB_WRAPPER(sinc)
+MPPP_UNARY_ARB_WRAPPER(sinc_pi)
+
+#undef MPPP_UNARY_ARB_WRAPPER
+
+void arb_log_hypot(::mpfr_t rop, const ::mpfr_t x, const ::mpfr_t y)
+{
+    MPPP_ARB_WORKSPACE(ws);
+
+    mpfr_to_arb(ws.m_x.m_arb, x);
+    mpfr_to_arb(ws.m_y.m_arb, y);
+
+    arb_log_hypot_impl(rop, ws.m_x.m_arb, ws.m_y.m_arb, ws);
+}
+
+namespace
+{
+
+// Helper to set the precision of the output of a batched wrapper.
+// NOTE: the precision is changed (destructively) only if needed,
+// so that the buffers of outputs with matching precision are reused.
+void arb_batch_set_prec(real &rop, ::mpfr_prec_t p)
+{
+    if (rop.get_prec() != p) {
+        rop.set_prec(p);
+    }
+}
+
+// Implementation of the batched unary wrappers.
+template <typename F>
+void arb_batch_unary(const F &f, real *rop, const real *op, std::size_t n)
+{
+    MPPP_ARB_WORKSPACE(ws);
+
+    // Convert all the operands, and record their precisions.
+    // NOTE: after this step, the operands are not read any more,
+    // and thus the output array can overlap with them.
+    ws.reserve_vec(safe_cast<::slong>(n));
+    ws.m_precs.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        mpfr_to_arb(ws.m_vec + i, op[i].get_mpfr_t());
+        ws.m_precs[i] = op[i].get_prec();
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        arb_batch_set_prec(rop[i], ws.m_precs[i]);
+        f(rop[i]._get_mpfr_t(), ws.m_vec + i, ws);
+    }
+}
+
+} // namespace
+
 #endif
 
 // Wrapper for calling mpfr_lgamma().
@@ -405,6 +526,220 @@ void real_check_trunc_arg(const real &r)
     }
 }
 
+namespace
+{
+
+// Number of limbs in the significand of an mpfr_t with precision p.
+std::size_t mpfr_cache_nlimbs(::mpfr_prec_t p)
+{
+    assert(p > 0);
+    return static_cast<std::size_t>((p - 1) / GMP_NUMB_BITS) + 1u;
+}
+
+} // namespace
+
+bool mpfr_alloc_cache::get(mpfr_struct_t &m, ::mpfr_prec_t p) noexcept
+{
+    const auto n = mpfr_cache_nlimbs(p);
+    if (n > max_size || sizes[n - 1u] == 0u) {
+        return false;
+    }
+    // Pop the head of the list.
+    const auto ptr = heads[n - 1u];
+    std::memcpy(&heads[n - 1u], ptr, sizeof(::mp_limb_t *));
+    --sizes[n - 1u];
+    // NOTE: the cached significand has room for at least n limbs,
+    // thus mpfr_set_prec() will reuse it. mpfr_set_prec() will also
+    // set the sign and the exponent (the value will be NaN, as after mpfr_init2()).
+    m._mpfr_prec = p;
+    m._mpfr_sign = 1;
+    m._mpfr_d = ptr;
+    ::mpfr_set_prec(&m, p);
+    return true;
+}
+
+bool mpfr_alloc_cache::put(mpfr_struct_t &m) noexcept
+{
+    const auto n = mpfr_cache_nlimbs(m._mpfr_prec);
+    // NOTE: the significand must be large enough to contain the link.
+    if (n > max_size || sizes[n - 1u] >= max_entries || n * sizeof(::mp_limb_t) < sizeof(::mp_limb_t *)) {
+        return false;
+    }
+    std::memcpy(m._mpfr_d, &heads[n - 1u], sizeof(::mp_limb_t *));
+    heads[n - 1u] = m._mpfr_d;
+    ++sizes[n - 1u];
+    return true;
+}
+
+void mpfr_alloc_cache::clear() noexcept
+{
+#if !defined(NDEBUG)
+    std::cout << "Cleaning up the mpfr alloc cache." << std::endl;
+#endif
+    for (std::size_t i = 0; i < max_size; ++i) {
+        for (; sizes[i] != 0u; --sizes[i]) {
+            const auto ptr = heads[i];
+            std::memcpy(&heads[i], ptr, sizeof(::mp_limb_t *));
+            // NOTE: mpfr_clear() needs only the significand, but make
+            // sure to pass a fully initialised mpfr_t.
+            mpfr_struct_t m;
+            m._mpfr_prec = static_cast<::mpfr_prec_t>((i + 1u) * GMP_NUMB_BITS);
+            m._mpfr_sign = 1;
+            m._mpfr_d = ptr;
+            ::mpfr_set_nan(&m);
+            ::mpfr_clear(&m);
+        }
+        heads[i] = nullptr;
+    }
+}
+
+#if MPPP_CPLUSPLUS < 201703L
+
+constexpr std::size_t mpfr_alloc_cache::max_size;
+constexpr std::size_t mpfr_alloc_cache::max_entries;
+
+#endif
+
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+
+namespace
+{
+
+// Thread local significand cache.
+// NOTE: see the notes in integer.cpp regarding the
+// initialisation and destruction of the mpz cache.
+thread_local mpfr_alloc_cache mpfr_alloc_cache_inst;
+
+} // namespace
+
+mpfr_alloc_cache &get_thread_local_mpfr_cache()
+{
+    return mpfr_alloc_cache_inst;
+}
+
+#endif
+
+namespace
+{
+
+// NOTE: the significands taken from a memory resource are laid out as follows:
+// - the pointer to the owning resource,
+// - the word in which MPFR stores the number of limbs of the significands it allocates,
+//   which here is set to zero,
+// - the significand proper, set up via the custom interface of MPFR.
+// This allows to tell apart the significands taken from a memory resource
+// from the significands allocated by MPFR, without any lookup.
+// NOTE: this mirrors the type used by MPFR to store the number of limbs.
+union mpfr_size_word {
+    ::mp_size_t s;
+    ::mp_limb_t l;
+};
+
+// Size of the data preceding a significand taken from a memory resource.
+constexpr std::size_t mpfr_res_header_size
+    = (sizeof(memory_resource *) + sizeof(mpfr_size_word) - 1u) / sizeof(mpfr_size_word) * sizeof(mpfr_size_word)
+      + sizeof(mpfr_size_word);
+
+// Size of the memory block of a significand with precision p taken from a memory resource.
+std::size_t mpfr_res_block_size(::mpfr_prec_t p)
+{
+    return mpfr_res_header_size + mpfr_custom_get_size(p);
+}
+
+// Init m with precision p and a significand taken from res.
+void mpfr_init2_from_resource(mpfr_struct_t &m, ::mpfr_prec_t p, memory_resource *res)
+{
+    const auto ptr = static_cast<unsigned char *>(res->allocate(mpfr_res_block_size(p)));
+    std::memcpy(ptr, &res, sizeof(memory_resource *));
+    const ::mp_size_t zero = 0;
+    std::memcpy(ptr + (mpfr_res_header_size - sizeof(mpfr_size_word)), &zero, sizeof(::mp_size_t));
+    const auto sig = ptr + mpfr_res_header_size;
+    mpfr_custom_init(sig, p);
+    mpfr_custom_init_set(&m, MPFR_NAN_KIND, 0, p, sig);
+}
+
+} // namespace
+
+memory_resource *mpfr_get_resource(const mpfr_struct_t &m)
+{
+    assert(m._mpfr_d != nullptr);
+    const auto sig = reinterpret_cast<const unsigned char *>(m._mpfr_d);
+    ::mp_size_t size;
+    std::memcpy(&size, sig - sizeof(mpfr_size_word), sizeof(::mp_size_t));
+    if (size != 0) {
+        // The significand was allocated by MPFR.
+        return nullptr;
+    }
+    memory_resource *res;
+    std::memcpy(&res, sig - mpfr_res_header_size, sizeof(memory_resource *));
+    return res;
+}
+
+void mpfr_init2_wrap(::mpfr_t m, ::mpfr_prec_t p)
+{
+    if (const auto res = get_thread_local_real_resource()) {
+        // NOTE: if a memory resource is active, the cache is bypassed.
+        mpfr_init2_from_resource(*m, p, res);
+        return;
+    }
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    if (mpfr_alloc_cache_inst.get(*m, p)) {
+        return;
+    }
+#endif
+    ::mpfr_init2(m, p);
+}
+
+void mpfr_clear_wrap(mpfr_struct_t &m)
+{
+    if (const auto res = mpfr_get_resource(m)) {
+        // NOTE: significands taken from a memory resource
+        // are returned to it, and they never end up in the cache.
+        res->deallocate(reinterpret_cast<unsigned char *>(m._mpfr_d) - mpfr_res_header_size,
+                        mpfr_res_block_size(m._mpfr_prec));
+        return;
+    }
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    if (!mpfr_alloc_cache_inst.put(m)) {
+#endif
+        ::mpfr_clear(&m);
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    }
+#endif
+}
+
+void mpfr_set_prec_wrap(mpfr_struct_t &m, ::mpfr_prec_t p)
+{
+    if (const auto res = mpfr_get_resource(m)) {
+        // NOTE: a significand taken from a memory resource
+        // is reallocated in the same resource. Free the old
+        // significand first, so that an arena can reuse its memory.
+        mpfr_clear_wrap(m);
+        mpfr_init2_from_resource(m, p, res);
+    } else {
+        ::mpfr_set_prec(&m, p);
+    }
+}
+
+void mpfr_prec_round_wrap(mpfr_struct_t &m, ::mpfr_prec_t p)
+{
+    if (const auto res = mpfr_get_resource(m)) {
+        mpfr_struct_t tmp;
+        mpfr_init2_from_resource(tmp, p, res);
+        ::mpfr_set(&tmp, &m, MPFR_RNDN);
+        mpfr_clear_wrap(m);
+        m = tmp;
+    } else {
+        ::mpfr_prec_round(&m, p, MPFR_RNDN);
+    }
+}
+
+real make_heap_real()
+{
+    const heap_alloc_guard hg;
+    return real{};
+}
+
 void mpfr_to_stream(const ::mpfr_t r, std::ostream &os, int base)
 {
     // All chars potentially used by MPFR for representing the digits up to base 62, sorted.
@@ -520,7 +855,7 @@ real::real()
 {
     // Init with minimum or default precision.
     const auto dp = real_get_default_prec();
-    ::mpfr_init2(&m_mpfr, dp ? dp : real_prec_min());
+    detail::mpfr_init2_wrap(&m_mpfr, dp ? dp : real_prec_min());
     ::mpfr_set_zero(&m_mpfr, 1);
 }
 
@@ -531,7 +866,7 @@ real::real(const ptag &, ::mpfr_prec_t p, bool ignore_prec)
     assert(ignore_prec);
     assert(detail::real_prec_check(p));
     detail::ignore(ignore_prec);
-    ::mpfr_init2(&m_mpfr, p);
+    detail::mpfr_init2_wrap(&m_mpfr, p);
 }
 
 /// Copy constructor.
@@ -557,7 +892,7 @@ real::real(const real &other) : real(&other.m_mpfr) {}
 real::real(const real &other, ::mpfr_prec_t p)
 {
     // Init with custom precision, and then set.
-    ::mpfr_init2(&m_mpfr, check_init_prec(p));
+    detail::mpfr_init2_wrap(&m_mpfr, check_init_prec(p));
     ::mpfr_set(&m_mpfr, &other.m_mpfr, MPFR_RNDN);
 }
 
@@ -565,7 +900,7 @@ real::real(const real &other, ::mpfr_prec_t p)
 template <typename Func, typename T>
 void real::dispatch_fp_construction(const Func &func, const T &x, ::mpfr_prec_t p)
 {
-    ::mpfr_init2(&m_mpfr, compute_init_precision(p, x));
+    detail::mpfr_init2_wrap(&m_mpfr, compute_init_precision(p, x));
     func(&m_mpfr, x, MPFR_RNDN);
 }
 
@@ -596,20 +931,20 @@ void real::dispatch_construction(const bool &b, ::mpfr_prec_t p)
 void real::dispatch_construction(const real128 &x, ::mpfr_prec_t p)
 {
     // Init the value.
-    ::mpfr_init2(&m_mpfr, compute_init_precision(p, x));
+    detail::mpfr_init2_wrap(&m_mpfr, compute_init_precision(p, x));
     assign_real128(x);
 }
 #endif
 
 void real::dispatch_mpz_construction(const ::mpz_t n, ::mpfr_prec_t p)
 {
-    ::mpfr_init2(&m_mpfr, p);
+    detail::mpfr_init2_wrap(&m_mpfr, p);
     ::mpfr_set_z(&m_mpfr, n, MPFR_RNDN);
 }
 
 void real::dispatch_mpq_construction(const ::mpq_t q, ::mpfr_prec_t p)
 {
-    ::mpfr_init2(&m_mpfr, p);
+    detail::mpfr_init2_wrap(&m_mpfr, p);
     ::mpfr_set_q(&m_mpfr, q, MPFR_RNDN);
 }
 
@@ -625,10 +960,10 @@ void real::construct_from_c_string(const char *s, int base, ::mpfr_prec_t p)
         throw std::invalid_argument("Cannot construct a real from a string if the precision is not explicitly "
                                     "specified and no default precision has been set");
     }
-    ::mpfr_init2(&m_mpfr, prec);
+    detail::mpfr_init2_wrap(&m_mpfr, prec);
     const auto ret = ::mpfr_set_str(&m_mpfr, s, base, MPFR_RNDN);
     if (mppp_unlikely(ret == -1)) {
-        ::mpfr_clear(&m_mpfr);
+        detail::mpfr_clear_wrap(m_mpfr);
         throw std::invalid_argument(std::string{"The string '"} + s + "' does not represent a valid real in base "
                                     + detail::to_string(base));
     }
@@ -730,7 +1065,7 @@ real::real(real_kind k, int sign, ::mpfr_prec_t p)
         }
         prec = dp;
     }
-    ::mpfr_init2(&m_mpfr, prec);
+    detail::mpfr_init2_wrap(&m_mpfr, prec);
     // NOTE: handle all cases explicitly, in order to avoid
     // compiler warnings.
     switch (k) {
@@ -744,7 +1079,7 @@ real::real(real_kind k, int sign, ::mpfr_prec_t p)
             break;
         default:
             // Clean up before throwing.
-            ::mpfr_clear(&m_mpfr);
+            detail::mpfr_clear_wrap(m_mpfr);
             using kind_cast_t = std::underlying_type<::mpfr_kind_t>::type;
             throw std::invalid_argument(
                 "The 'real_kind' value passed to the constructor of a real ("
@@ -771,7 +1106,7 @@ real::real(real_kind k, int sign, ::mpfr_prec_t p)
 real::real(const ::mpfr_t x)
 {
     // Init with the same precision as other, and then set.
-    ::mpfr_init2(&m_mpfr, mpfr_get_prec(x));
+    detail::mpfr_init2_wrap(&m_mpfr, mpfr_get_prec(x));
     ::mpfr_set(&m_mpfr, x, MPFR_RNDN);
 }
 
@@ -793,7 +1128,7 @@ real &real::operator=(const real &other)
             set_prec_impl<false>(other.get_prec());
         } else {
             // this has been moved-from: init before setting.
-            ::mpfr_init2(&m_mpfr, other.get_prec());
+            detail::mpfr_init2_wrap(&m_mpfr, other.get_prec());
         }
         // Perform the actual copy from other.
         ::mpfr_set(&m_mpfr, &other.m_mpfr, MPFR_RNDN);
@@ -1032,15 +1367,13 @@ static_real<size_real_2_112> get_real_2_112()
 
 } // namespace
 
-} // namespace detail
-
-void real::assign_real128(const real128 &x)
+void mpfr_set_real128(::mpfr_t rop, const real128 &x)
 {
     // Get the IEEE repr. of x.
     const auto t = x.get_ieee();
     // A utility function to write the significand of x
-    // as a big integer inside m_mpfr.
-    auto write_significand = [this, &t]() {
+    // as a big integer inside rop.
+    auto write_significand = [rop, &t]() {
         // The 4 32-bits part of the significand, from most to least
         // significant digits.
         const auto p1 = std::get<2>(t) >> 32;
@@ -1049,13 +1382,13 @@ void real::assign_real128(const real128 &x)
         const auto p4 = std::get<3>(t) % (1ull << 32);
         // Build the significand, from most to least significant.
         // NOTE: unsigned long is guaranteed to be at least 32 bit.
-        ::mpfr_set_ui(&this->m_mpfr, static_cast<unsigned long>(p1), MPFR_RNDN);
-        ::mpfr_mul_2ui(&this->m_mpfr, &this->m_mpfr, 32ul, MPFR_RNDN);
-        ::mpfr_add_ui(&this->m_mpfr, &this->m_mpfr, static_cast<unsigned long>(p2), MPFR_RNDN);
-        ::mpfr_mul_2ui(&this->m_mpfr, &this->m_mpfr, 32ul, MPFR_RNDN);
-        ::mpfr_add_ui(&this->m_mpfr, &this->m_mpfr, static_cast<unsigned long>(p3), MPFR_RNDN);
-        ::mpfr_mul_2ui(&this->m_mpfr, &this->m_mpfr, 32ul, MPFR_RNDN);
-        ::mpfr_add_ui(&this->m_mpfr, &this->m_mpfr, static_cast<unsigned long>(p4), MPFR_RNDN);
+        ::mpfr_set_ui(rop, static_cast<unsigned long>(p1), MPFR_RNDN);
+        ::mpfr_mul_2ui(rop, rop, 32ul, MPFR_RNDN);
+        ::mpfr_add_ui(rop, rop, static_cast<unsigned long>(p2), MPFR_RNDN);
+        ::mpfr_mul_2ui(rop, rop, 32ul, MPFR_RNDN);
+        ::mpfr_add_ui(rop, rop, static_cast<unsigned long>(p3), MPFR_RNDN);
+        ::mpfr_mul_2ui(rop, rop, 32ul, MPFR_RNDN);
+        ::mpfr_add_ui(rop, rop, static_cast<unsigned long>(p4), MPFR_RNDN);
     };
     // Check if the significand is zero.
     const bool sig_zero = !std::get<2>(t) && !std::get<3>(t);
@@ -1063,36 +1396,43 @@ void real::assign_real128(const real128 &x)
         // Zero or subnormal numbers.
         if (sig_zero) {
             // Zero.
-            ::mpfr_set_zero(&m_mpfr, 1);
+            ::mpfr_set_zero(rop, 1);
         } else {
             // Subnormal.
             write_significand();
-            ::mpfr_div_2ui(&m_mpfr, &m_mpfr, 16382ul + 112ul, MPFR_RNDN);
+            ::mpfr_div_2ui(rop, rop, 16382ul + 112ul, MPFR_RNDN);
         }
     } else if (std::get<1>(t) == 32767u) {
         // NaN or inf.
         if (sig_zero) {
             // inf.
-            ::mpfr_set_inf(&m_mpfr, 1);
+            ::mpfr_set_inf(rop, 1);
         } else {
             // NaN.
-            ::mpfr_set_nan(&m_mpfr);
+            ::mpfr_set_nan(rop);
         }
     } else {
-        // Write the significand into this.
+        // Write the significand into rop.
         write_significand();
         // Add the hidden bit on top.
-        const auto r_2_112 = detail::get_real_2_112();
-        ::mpfr_add(&m_mpfr, &m_mpfr, &r_2_112.first, MPFR_RNDN);
+        const auto r_2_112 = get_real_2_112();
+        ::mpfr_add(rop, rop, &r_2_112.first, MPFR_RNDN);
         // Multiply by 2 raised to the adjusted exponent.
-        ::mpfr_mul_2si(&m_mpfr, &m_mpfr, static_cast<long>(std::get<1>(t)) - (16383l + 112), MPFR_RNDN);
+        ::mpfr_mul_2si(rop, rop, static_cast<long>(std::get<1>(t)) - (16383l + 112), MPFR_RNDN);
     }
     if (std::get<0>(t)) {
         // Negate if the sign bit is set.
-        ::mpfr_neg(&m_mpfr, &m_mpfr, MPFR_RNDN);
+        ::mpfr_neg(rop, rop, MPFR_RNDN);
     }
 }
 
+} // namespace detail
+
+void real::assign_real128(const real128 &x)
+{
+    detail::mpfr_set_real128(&m_mpfr, x);
+}
+
 real128 real::convert_to_real128() const
 {
     // Handle the special cases first.
@@ -1276,7 +1616,7 @@ real::~real()
     if (m_mpfr._mpfr_d) {
         // The object is not moved-from, destroy it.
         assert(detail::real_prec_check(get_prec()));
-        ::mpfr_clear(&m_mpfr);
+        detail::mpfr_clear_wrap(m_mpfr);
     }
 }
 
@@ -2251,13 +2591,216 @@ std::ostream &operator<<(std::ostream &os, const real &r)
 namespace detail
 {
 
-// NOTE: don't put in unnamed namespace as
-// this needs do be just in detail:: for friendship
-// with real.
-template <typename F>
-inline real real_constant(const F &f, ::mpfr_prec_t p)
+namespace
+{
+
+// Compute a short representation in base base of the absolute value of the nonzero finite value x, via
+// a search for the smallest number of digits whose correctly-rounded representation (as computed
+// by mpfr_get_str()) reads back to x. The cost of this function depends on the precision of x,
+// but (unlike fp_shortest_digits()) not on its exponent. The digits are written into out as a
+// null-terminated string, and the exponent of the last digit is returned.
+long long mpfr_shortest_digits_search(std::vector<char> &out, const ::mpfr_t x, int base)
+{
+    assert(mpfr_regular_p(x));
+    const auto prec = mpfr_get_prec(x);
+    // Thread-local value used to read back the candidate representations,
+    // re-initialised only if the precision changes.
+    MPPP_MAYBE_TLS mpfr_raii tmp(real_prec_min());
+    if (mpfr_get_prec(&tmp.m_mpfr) != prec) {
+        ::mpfr_set_prec(&tmp.m_mpfr, prec);
+    }
+    ::mpfr_exp_t exp(0);
+    // Write into out the digits of the correctly-rounded representation of |x| with n digits,
+    // and check if it reads back to x. The value is read back from the same buffer, by appending
+    // to the digits the exponent in the form "@e".
+    const auto try_digits = [&](std::size_t n) {
+        // NOTE: mpfr_get_str() needs room for the sign and the terminator (and at least
+        // 7 characters in total). The exponent needs room for '@', the sign and the digits.
+        constexpr auto exp_size = static_cast<std::size_t>(std::numeric_limits<long long>::digits10) + 4u;
+        out.resize(std::max(n + 2u, std::size_t(7)) + exp_size);
+        ::mpfr_get_str(out.data(), &exp, base, n, x, MPFR_RNDN);
+        if (out[0] == '-') {
+            std::copy(out.begin() + 1, out.begin() + static_cast<std::ptrdiff_t>(n + 1u), out.begin());
+        }
+        // The value is out * base**(exp - n). Write the exponent backwards from the end of the
+        // buffer, and then move it after the digits.
+        const auto e = static_cast<long long>(exp) - static_cast<long long>(n);
+        auto e_abs = e >= 0 ? static_cast<unsigned long long>(e) : 0ull - static_cast<unsigned long long>(e);
+        const auto eend = out.data() + out.size();
+        auto eptr = eend;
+        *--eptr = '\0';
+        do {
+            *--eptr = static_cast<char>('0' + static_cast<int>(e_abs % 10u));
+            e_abs /= 10u;
+        } while (e_abs);
+        if (e < 0) {
+            *--eptr = '-';
+        }
+        *--eptr = '@';
+        std::copy(eptr, eend, out.data() + n);
+        ::mpfr_set_str(&tmp.m_mpfr, out.data(), base, MPFR_RNDN);
+        out[n] = '\0';
+        return ::mpfr_cmpabs(&tmp.m_mpfr, x) == 0;
+    };
+    // NOTE: this is the number of digits that always suffices for reading back x (see the
+    // documentation of mpfr_get_str()), plus one for safety.
+    const auto n_max = static_cast<std::size_t>(
+        std::ceil(static_cast<double>(prec) * std::log(2.) / std::log(static_cast<double>(base)))) + 2u;
+    ignore(n_max);
+    // NOTE: reading back is not monotonic in the number of digits (a representation
+    // with n digits may read back to x by chance, while the one with n + 1 digits
+    // does not), thus the number of digits is searched linearly. Before MPFR 4,
+    // mpfr_get_str() requires at least 2 digits.
+    auto nd = MPFR_VERSION_MAJOR >= 4 ? std::size_t(1) : std::size_t(2);
+    while (!try_digits(nd)) {
+        ++nd;
+        assert(nd <= n_max);
+    }
+    // Strip the trailing zeroes.
+    auto n = nd;
+    for (; n > 1u && out[n - 1u] == '0'; --n) {
+    }
+    out[n] = '\0';
+    return static_cast<long long>(exp) - static_cast<long long>(n);
+}
+
+} // namespace
+
+} // namespace detail
+
+to_chars_result to_chars(char *first, char *last, const real &r, int base)
+{
+    if (mppp_unlikely(base < 2 || base > 62)) {
+        return {last, std::errc::invalid_argument};
+    }
+    auto ptr = first;
+    // Helper to append the range [begin, end) to the output range.
+    const auto append = [&ptr, last](const char *begin, const char *end) {
+        if (static_cast<std::size_t>(end - begin) > static_cast<std::size_t>(last - ptr)) {
+            return false;
+        }
+        ptr = std::copy(begin, end, ptr);
+        return true;
+    };
+    const auto append_char = [&ptr, last](char c) {
+        if (ptr == last) {
+            return false;
+        }
+        *ptr++ = c;
+        return true;
+    };
+    const auto too_large = to_chars_result{last, std::errc::value_too_large};
+
+    // Special values first, with the same format as mpfr_to_stream().
+    const auto x = r.get_mpfr_t();
+    if (mpfr_nan_p(x) || mpfr_inf_p(x)) {
+        if (mpfr_inf_p(x) && mpfr_sgn(x) < 0 && !append_char('-')) {
+            return too_large;
+        }
+        const char *str = mpfr_nan_p(x) ? (base <= 16 ? "nan" : "@nan@") : (base <= 16 ? "inf" : "@inf@");
+        return append(str, str + std::strlen(str)) ? to_chars_result{ptr, std::errc{}} : too_large;
+    }
+
+    // Zero is printed as a single digit, preserving the sign.
+    if (mpfr_zero_p(x)) {
+        if (mpfr_signbit(x) && !append_char('-')) {
+            return too_large;
+        }
+        return append_char('0') ? to_chars_result{ptr, std::errc{}} : too_large;
+    }
+
+    // Decompose the absolute value of r as m * 2**e, with m an integer of
+    // r.get_prec() bits, and compute the shortest representation in base base
+    // which reads back to r. The digits are written into a thread-local buffer
+    // (which, in the long run, will not need to allocate memory).
+    // NOTE: MPFR has no subnormal values, thus the lower neighbour of r
+    // is closer if and only if m is a power of two.
+    MPPP_MAYBE_TLS detail::mpz_raii m;
+    MPPP_MAYBE_TLS std::vector<char> digits;
+    const auto e = static_cast<long long>(::mpfr_get_z_2exp(&m.m_mpz, x));
+    ::mpz_abs(&m.m_mpz, &m.m_mpz);
+    const bool lower_closer = ::mpz_scan1(&m.m_mpz, 0) == ::mpz_sizeinbase(&m.m_mpz, 2) - 1u;
+    // NOTE: the operands in fp_shortest_digits() have about |e| bits, thus
+    // for large exponents we switch to a search via mpfr_get_str(), whose cost
+    // depends only on the precision.
+    const auto e_max = 4 * static_cast<long long>(r.get_prec()) + 16384;
+    const auto q = (e >= -e_max && e <= e_max) ? detail::fp_shortest_digits(digits, &m.m_mpz, e, lower_closer, base)
+                                               : detail::mpfr_shortest_digits_search(digits, x, base);
+
+    // Write the digits, inserting a decimal point after the first one
+    // (if there are other digits).
+    const auto dbegin = digits.data(), dend = dbegin + std::strlen(dbegin);
+    assert(dbegin != dend);
+    if ((mpfr_signbit(x) && !append_char('-')) || !append(dbegin, dbegin + 1)
+        || (dend - dbegin > 1 && (!append_char('.') || !append(dbegin + 1, dend)))) {
+        return too_large;
+    }
+
+    // Add the exponent of the first digit, if nonzero.
+    // NOTE: MPFR's exponents are well within the range of long long, and
+    // the number of digits is bounded by the precision, thus the computation
+    // of the exponent cannot overflow.
+    const auto z_exp = q + static_cast<long long>(dend - dbegin) - 1;
+    if (z_exp != 0) {
+        std::array<char, std::numeric_limits<unsigned long long>::digits10 + 4> ebuf;
+        const auto eend = ebuf.data() + ebuf.size();
+        auto eptr = eend;
+        auto e_abs = z_exp > 0 ? static_cast<unsigned long long>(z_exp) : 0ull - static_cast<unsigned long long>(z_exp);
+        do {
+            *--eptr = static_cast<char>('0' + static_cast<int>(e_abs % 10u));
+            e_abs /= 10u;
+        } while (e_abs);
+        *--eptr = z_exp > 0 ? '+' : '-';
+        *--eptr = base <= 10 ? 'e' : '@';
+        if (!append(eptr, eend)) {
+            return too_large;
+        }
+    }
+
+    return {ptr, std::errc{}};
+}
+
+from_chars_result from_chars(const char *first, const char *last, real &r, int base)
+{
+    // NOTE: mpfr_strtofr() skips leading whitespaces and accepts a leading '+',
+    // which are not allowed here.
+    if (mppp_unlikely(base < 2 || base > 62) || first == last || *first == '+'
+        || std::isspace(static_cast<unsigned char>(*first))) {
+        return {first, std::errc::invalid_argument};
+    }
+    // Copy the range into a null-terminated thread-local buffer. Only the characters which
+    // may be part of the value are copied, so that the cost of the parsing does not depend
+    // on the length of the rest of the range.
+    MPPP_MAYBE_TLS std::vector<char> buffer;
+    buffer.assign(first, detail::fp_str_prefix_end(first, last, base));
+    buffer.push_back('\0');
+    // Parse into a thread-local mpfr with the precision of r, so that r is not modified
+    // if the parsing fails. The thread-local mpfr is re-initialised only if the
+    // precision changes.
+    MPPP_MAYBE_TLS detail::mpfr_raii tmp(real_prec_min());
+    if (mpfr_get_prec(&tmp.m_mpfr) != r.get_prec()) {
+        ::mpfr_set_prec(&tmp.m_mpfr, r.get_prec());
+    }
+    char *endptr;
+    ::mpfr_strtofr(&tmp.m_mpfr, buffer.data(), &endptr, base, MPFR_RNDN);
+    if (endptr == buffer.data()) {
+        return {first, std::errc::invalid_argument};
+    }
+    // NOTE: the precisions are the same, thus this is an exact copy.
+    ::mpfr_set(r._get_mpfr_t(), &tmp.m_mpfr, MPFR_RNDN);
+    return {first + (endptr - buffer.data()), std::errc{}};
+}
+
+namespace detail
+{
+
+namespace
+{
+
+// Small helper to determine the precision of a real constant
+// from the precision p requested by the user.
+::mpfr_prec_t real_constant_prec(::mpfr_prec_t p)
 {
-    ::mpfr_prec_t prec;
     if (p) {
         if (mppp_unlikely(!real_prec_check(p))) {
             throw std::invalid_argument("Cannot init a real constant with a precision of " + detail::to_string(p)
@@ -2265,17 +2808,91 @@ inline real real_constant(const F &f, ::mpfr_prec_t p)
                                         + detail::to_string(real_prec_min()) + " and "
                                         + detail::to_string(real_prec_max()));
         }
-        prec = p;
+        return p;
     } else {
         const auto dp = real_get_default_prec();
         if (mppp_unlikely(!dp)) {
             throw std::invalid_argument("Cannot init a real constant with an automatically-deduced precision if "
                                         "the global default precision has not been set");
         }
-        prec = dp;
+        return dp;
+    }
+}
+
+// Cache for a real constant, shared by all threads.
+// It contains the constant computed at the highest
+// precision requested so far (or a zero if the
+// constant was never computed), and the ternary
+// value of such computation.
+// NOTE: the cache outlives the memory resources active in
+// the calling threads, thus its storage is taken from the heap.
+struct real_constant_cache {
+    std::mutex m_mutex;
+    real m_value = make_heap_real();
+    int m_inex = 0;
+};
+
+// Set rop to the value in a constant cache, rounded to the precision of rop.
+// NOTE: the cached value is itself the result of a rounding. Hence, if it lies exactly
+// halfway between two values representable at the precision of rop, rounding it
+// to nearest could produce a result different from the correctly rounded
+// value of the constant (double rounding). In such case, we use
+// the ternary value of the cached computation to establish
+// on which side of the midpoint the exact value lies.
+void real_constant_round(::mpfr_t rop, const ::mpfr_t cached, int inex)
+{
+    auto rnd = MPFR_RNDN;
+    if (inex != 0 && ::mpfr_min_prec(cached) == mpfr_get_prec(rop) + 1) {
+        // NOTE: inex > 0 means that the cached value is larger than the exact value.
+        rnd = inex > 0 ? MPFR_RNDD : MPFR_RNDU;
+    }
+    ::mpfr_set(rop, cached, rnd);
+}
+
+// Set rop to the constant computed by F, rounded to the precision of rop, using the cache.
+template <int (*F)(::mpfr_ptr, ::mpfr_rnd_t)>
+void real_constant_cached(::mpfr_t rop)
+{
+    // NOTE: the initialisation of function-level statics is thread-safe.
+    static real_constant_cache cache;
+
+    const auto p = mpfr_get_prec(rop);
+
+    {
+        std::lock_guard<std::mutex> lock(cache.m_mutex);
+        if (!cache.m_value.zero_p() && cache.m_value.get_prec() >= p) {
+            real_constant_round(rop, cache.m_value.get_mpfr_t(), cache.m_inex);
+            return;
+        }
+    }
+
+    // The cache does not have enough precision. Compute the
+    // constant without holding the lock.
+    const heap_alloc_guard hg;
+    real tmp{real_kind::zero, p};
+    const auto inex = F(tmp._get_mpfr_t(), MPFR_RNDN);
+    // NOTE: same precision, thus this is an exact copy.
+    ::mpfr_set(rop, tmp.get_mpfr_t(), MPFR_RNDN);
+
+    // Update the cache, unless another thread stored
+    // a higher precision value in the meantime.
+    std::lock_guard<std::mutex> lock(cache.m_mutex);
+    if (cache.m_value.zero_p() || cache.m_value.get_prec() < p) {
+        swap(cache.m_value, tmp);
+        cache.m_inex = inex;
     }
-    real retval{real::ptag{}, prec, true};
-    f(retval._get_mpfr_t(), MPFR_RNDN);
+}
+
+} // namespace
+
+// NOTE: don't put in unnamed namespace as
+// this needs do be just in detail:: for friendship
+// with real.
+template <typename F>
+inline real real_constant(const F &f, ::mpfr_prec_t p)
+{
+    real retval{real::ptag{}, real_constant_prec(p), true};
+    f(retval._get_mpfr_t());
     return retval;
 }
 
@@ -2284,7 +2901,7 @@ inline real real_constant(const F &f, ::mpfr_prec_t p)
 // pi constant.
 real real_pi(::mpfr_prec_t p)
 {
-    return detail::real_constant(::mpfr_const_pi, p);
+    return detail::real_constant(detail::real_constant_cached<::mpfr_const_pi>, p);
 }
 
 /// Set \link mppp::real real\endlink to \f$\pi\f$.
@@ -2298,8 +2915,661 @@ real real_pi(::mpfr_prec_t p)
  */
 real &real_pi(real &rop)
 {
-    ::mpfr_const_pi(rop._get_mpfr_t(), MPFR_RNDN);
+    detail::real_constant_cached<::mpfr_const_pi>(rop._get_mpfr_t());
     return rop;
 }
 
+// log(2) constant.
+real real_log2(::mpfr_prec_t p)
+{
+    return detail::real_constant(detail::real_constant_cached<::mpfr_const_log2>, p);
+}
+
+/// Set \link mppp::real real\endlink to \f$\log 2\f$.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ * \endrststar
+ *
+ * This function will set \p rop to \f$\log 2\f$. The precision
+ * of \p rop will not be altered.
+ *
+ * @param rop the \link mppp::real real\endlink that will be set to \f$\log 2\f$.
+ *
+ * @return a reference to \p rop.
+ */
+real &real_log2(real &rop)
+{
+    detail::real_constant_cached<::mpfr_const_log2>(rop._get_mpfr_t());
+    return rop;
+}
+
+// Euler-Mascheroni constant.
+real real_euler(::mpfr_prec_t p)
+{
+    return detail::real_constant(detail::real_constant_cached<::mpfr_const_euler>, p);
+}
+
+/// Set \link mppp::real real\endlink to the Euler-Mascheroni constant.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ * \endrststar
+ *
+ * This function will set \p rop to the Euler-Mascheroni constant \f$\gamma\f$. The precision
+ * of \p rop will not be altered.
+ *
+ * @param rop the \link mppp::real real\endlink that will be set to \f$\gamma\f$.
+ *
+ * @return a reference to \p rop.
+ */
+real &real_euler(real &rop)
+{
+    detail::real_constant_cached<::mpfr_const_euler>(rop._get_mpfr_t());
+    return rop;
+}
+
+// Catalan's constant.
+real real_catalan(::mpfr_prec_t p)
+{
+    return detail::real_constant(detail::real_constant_cached<::mpfr_const_catalan>, p);
+}
+
+/// Set \link mppp::real real\endlink to Catalan's constant.
+/**
+ * \rststar
+ * .. versionadded:: 0.20
+ * \endrststar
+ *
+ * This function will set \p rop to Catalan's constant \f$G\f$. The precision
+ * of \p rop will not be altered.
+ *
+ * @param rop the \link mppp::real real\endlink that will be set to \f$G\f$.
+ *
+ * @return a reference to \p rop.
+ */
+real &real_catalan(real &rop)
+{
+    detail::real_constant_cached<::mpfr_const_catalan>(rop._get_mpfr_t());
+    return rop;
+}
+
+// Precompute the real constants.
+void real_warm_up_constants(::mpfr_prec_t p)
+{
+    real tmp{real_kind::zero, detail::real_constant_prec(p)};
+    detail::real_constant_cached<::mpfr_const_pi>(tmp._get_mpfr_t());
+    detail::real_constant_cached<::mpfr_const_log2>(tmp._get_mpfr_t());
+    detail::real_constant_cached<::mpfr_const_euler>(tmp._get_mpfr_t());
+    detail::real_constant_cached<::mpfr_const_catalan>(tmp._get_mpfr_t());
+}
+
+#if defined(MPPP_WITH_ARB)
+
+namespace batch
+{
+
+#define MPPP_BATCH_ARB_UNARY(fname)                                                                                    \
+    void fname(real *rop, const real *op, std::size_t n)                                                               \
+    {                                                                                                                  \
+        detail::arb_batch_unary(detail::arb_##fname##_impl, rop, op, n);                                               \
+    }
+
+MPPP_BATCH_ARB_UNARY(sqrt1pm1)
+MPPP_BATCH_ARB_UNARY(sin_pi)
+MPPP_BATCH_ARB_UNARY(cos_pi)
+MPPP_BATCH_ARB_UNARY(tan_pi)
+MPPP_BATCH_ARB_UNARY(cot_pi)
+MPPP_BATCH_ARB_UNARY(sinc)
+MPPP_BATCH_ARB_UNARY(sinc_pi)
+
+#undef MPPP_BATCH_ARB_UNARY
+
+void log_hypot(real *rop, const real *x, const real *y, std::size_t n)
+{
+    MPPP_ARB_WORKSPACE(ws);
+
+    // Convert all the operands, storing the x values
+    // in the first half of the vector and the y values
+    // in the second half.
+    // NOTE: the precision of each output is the maximum
+    // precision of the corresponding operands.
+    const auto sn = detail::safe_cast<::slong>(n);
+    ws.reserve_vec(detail::safe_cast<::slong>(2u * n));
+    ws.m_precs.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        detail::mpfr_to_arb(ws.m_vec + i, x[i].get_mpfr_t());
+        detail::mpfr_to_arb(ws.m_vec + sn + static_cast<::slong>(i), y[i].get_mpfr_t());
+        ws.m_precs[i] = std::max(x[i].get_prec(), y[i].get_prec());
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        detail::arb_batch_set_prec(rop[i], ws.m_precs[i]);
+        detail::arb_log_hypot_impl(rop[i]._get_mpfr_t(), ws.m_vec + i, ws.m_vec + sn + static_cast<::slong>(i), ws);
+    }
+}
+
+} // namespace batch
+
+namespace detail
+{
+
+// Implementation details of real_ball.
+struct real_ball_ops {
+    // Check the precision requested for the construction of a real_ball.
+    static ::mpfr_prec_t check_init_prec(::mpfr_prec_t p)
+    {
+        if (mppp_unlikely(!real_prec_check(p))) {
+            throw std::invalid_argument("Cannot init a real_ball with a precision of " + to_string(p)
+                                        + ": the maximum allowed precision is " + to_string(real_prec_max())
+                                        + ", the minimum allowed precision is " + to_string(real_prec_min()));
+        }
+        return p;
+    }
+    // Convert a real_ball into an arb_t.
+    static void to_arb(::arb_t rop, const real_ball &x, arb_workspace &ws)
+    {
+        // NOTE: both conversions are exact, as the radius
+        // has the same precision as a mag_t.
+        ::arf_set_mpfr(arb_midref(rop), x.m_mid.get_mpfr_t());
+        ::arf_set_mpfr(ws.m_tmp.m_arf, x.m_rad.get_mpfr_t());
+        ::arf_get_mag(arb_radref(rop), ws.m_tmp.m_arf);
+    }
+    // If the exponent of the arf_t x is a multiprecision integer,
+    // replace x with a value of the same sign, whose exponent is still
+    // out of MPFR's range but representable as a small integer.
+    // NOTE: arf_get_mpfr() will then overflow or underflow
+    // according to the rounding mode, rather than aborting.
+    static void saturate_exp(::arf_t x)
+    {
+        if (!::arf_is_special(x) && COEFF_IS_MPZ(*ARF_EXPREF(x))) {
+            const auto e = ::fmpz_sgn(ARF_EXPREF(x)) > 0 ? COEFF_MAX / 2 : -COEFF_MAX / 2;
+            ::arf_set_si_2exp_si(x, ::arf_sgn(x), e);
+        }
+    }
+    // Set rop to the radius r.
+    static void set_rad(::mpfr_t rop, const ::mag_t r, arb_workspace &ws)
+    {
+        ::arf_set_mag(ws.m_tmp.m_arf, r);
+        saturate_exp(ws.m_tmp.m_arf);
+        ::arf_get_mpfr(rop, ws.m_tmp.m_arf, MPFR_RNDU);
+        if (mppp_unlikely(mpfr_zero_p(rop) && !::mag_is_zero(r))) {
+            // The radius underflowed: use the smallest positive value instead.
+            ::mpfr_nextabove(rop);
+        }
+    }
+    // Set rop to the ball x, with a precision of p.
+    // NOTE: x will be modified.
+    static void from_arb(real_ball &rop, ::arb_t x, ::mpfr_prec_t p, arb_workspace &ws)
+    {
+        // Round the midpoint to p bits, adding the rounding error
+        // (if any) to the radius. The midpoint can then be
+        // represented exactly by an mpfr_t with precision p.
+        ::arb_set_round(x, x, mpfr_prec_to_arb_prec(p));
+
+        if (rop.m_mid.get_prec() != p) {
+            rop.m_mid.set_prec(p);
+        }
+
+        const auto mid = arb_midref(x);
+        if (::arf_is_special(mid)) {
+            ::arf_get_mpfr(rop.m_mid._get_mpfr_t(), mid, MPFR_RNDN);
+        } else if (mppp_unlikely(COEFF_IS_MPZ(*ARF_EXPREF(mid))
+                                 || ::arf_get_mpfr(rop.m_mid._get_mpfr_t(), mid, MPFR_RNDN) != 0)) {
+            // NOTE: a nonzero ternary value signals that the midpoint is out of
+            // MPFR's exponent range. Return the ball containing all the real numbers.
+            ::mpfr_set_nan(rop.m_mid._get_mpfr_t());
+            ::mpfr_set_inf(rop.m_rad._get_mpfr_t(), 1);
+            return;
+        }
+
+        set_rad(rop.m_rad._get_mpfr_t(), arb_radref(x), ws);
+    }
+    template <typename F>
+    static void unary(const F &f, real_ball &rop, const real_ball &op)
+    {
+        MPPP_ARB_WORKSPACE(ws);
+
+        const auto p = op.get_prec();
+        const auto ap = mpfr_prec_to_arb_prec(p);
+        to_arb(ws.m_x.m_arb, op, ws);
+        f(ws.m_rop.m_arb, ws.m_x.m_arb, ap);
+        from_arb(rop, ws.m_rop.m_arb, p, ws);
+    }
+    // NOTE: the precision of the result is the maximum
+    // precision of the operands.
+    template <typename F>
+    static void binary(const F &f, real_ball &rop, const real_ball &a, const real_ball &b)
+    {
+        MPPP_ARB_WORKSPACE(ws);
+
+        const auto p = std::max(a.get_prec(), b.get_prec());
+        const auto ap = mpfr_prec_to_arb_prec(p);
+        to_arb(ws.m_x.m_arb, a, ws);
+        to_arb(ws.m_y.m_arb, b, ws);
+        f(ws.m_rop.m_arb, ws.m_x.m_arb, ws.m_y.m_arb, ap);
+        from_arb(rop, ws.m_rop.m_arb, p, ws);
+    }
+    template <typename F>
+    static void ternary(const F &f, real_ball &rop, const real_ball &a, const real_ball &b, const real_ball &c)
+    {
+        MPPP_ARB_WORKSPACE(ws);
+
+        const auto p = std::max(std::max(a.get_prec(), b.get_prec()), c.get_prec());
+        const auto ap = mpfr_prec_to_arb_prec(p);
+        to_arb(ws.m_x.m_arb, a, ws);
+        to_arb(ws.m_y.m_arb, b, ws);
+        to_arb(ws.m_z.m_arb, c, ws);
+        f(ws.m_rop.m_arb, ws.m_x.m_arb, ws.m_y.m_arb, ws.m_z.m_arb, ap);
+        from_arb(rop, ws.m_rop.m_arb, p, ws);
+    }
+    // Run a predicate on two balls.
+    template <typename F>
+    static bool pred(const F &f, const real_ball &a, const real_ball &b)
+    {
+        MPPP_ARB_WORKSPACE(ws);
+
+        to_arb(ws.m_x.m_arb, a, ws);
+        to_arb(ws.m_y.m_arb, b, ws);
+        return f(ws.m_x.m_arb, ws.m_y.m_arb) != 0;
+    }
+    // Lower/upper bound of a ball.
+    template <typename F>
+    static real bound(const F &f, const real_ball &x, ::mpfr_rnd_t rnd)
+    {
+        MPPP_ARB_WORKSPACE(ws);
+
+        const auto p = x.get_prec();
+        const auto ap = mpfr_prec_to_arb_prec(p);
+        to_arb(ws.m_x.m_arb, x, ws);
+        f(ws.m_tmp.m_arf, ws.m_x.m_arb, ap);
+        saturate_exp(ws.m_tmp.m_arf);
+        real retval{real_kind::nan, p};
+        ::arf_get_mpfr(retval._get_mpfr_t(), ws.m_tmp.m_arf, rnd);
+        return retval;
+    }
+    // Set rop to a ball containing num / den, with precision p.
+    static void ratio(real_ball &rop, const real &num, const real &den, ::mpfr_prec_t p)
+    {
+        MPPP_ARB_WORKSPACE(ws);
+
+        const auto ap = mpfr_prec_to_arb_prec(p);
+        mpfr_to_arb(ws.m_x.m_arb, num.get_mpfr_t());
+        mpfr_to_arb(ws.m_y.m_arb, den.get_mpfr_t());
+        ::arb_div(ws.m_rop.m_arb, ws.m_x.m_arb, ws.m_y.m_arb, ap);
+        from_arb(rop, ws.m_rop.m_arb, p, ws);
+    }
+    // Set rop to a ball containing the number represented by the string s, with precision p.
+    static void from_string(real_ball &rop, const char *s, ::mpfr_prec_t p)
+    {
+        MPPP_ARB_WORKSPACE(ws);
+
+        const auto ap = mpfr_prec_to_arb_prec(p);
+        if (mppp_unlikely(::arb_set_str(ws.m_rop.m_arb, s, ap) != 0)) {
+            throw std::invalid_argument(std::string{"The string '"} + s + "' does not represent a valid real_ball");
+        }
+        from_arb(rop, ws.m_rop.m_arb, p, ws);
+    }
+    // Determine the precision of a real_ball constructed from a string or
+    // a constant, from the precision p requested by the user.
+    static ::mpfr_prec_t deduce_prec(::mpfr_prec_t p)
+    {
+        if (p) {
+            return check_init_prec(p);
+        }
+        const auto dp = real_get_default_prec();
+        if (mppp_unlikely(!dp)) {
+            throw std::invalid_argument("Cannot init a real_ball with an automatically-deduced precision if "
+                                        "the global default precision has not been set");
+        }
+        return dp;
+    }
+};
+
+} // namespace detail
+
+real_ball::real_ball() : m_rad(real_kind::zero, detail::real_ball_rad_prec) {}
+
+real_ball::real_ball(const real &mid) : m_mid(mid), m_rad(real_kind::zero, detail::real_ball_rad_prec) {}
+
+real_ball::real_ball(real &&mid) : m_mid(std::move(mid)), m_rad(real_kind::zero, detail::real_ball_rad_prec) {}
+
+real_ball::real_ball(const real &mid, const real &rad) : real_ball(mid)
+{
+    if (mppp_unlikely(rad.nan_p() || rad.sgn() < 0)) {
+        throw std::invalid_argument("Cannot init a real_ball with a radius of " + rad.to_string()
+                                    + ": the radius must be a non-negative value");
+    }
+    // NOTE: use abs() in order to turn a negative zero into a positive zero.
+    ::mpfr_abs(m_rad._get_mpfr_t(), rad.get_mpfr_t(), MPFR_RNDU);
+}
+
+real_ball::real_ball(const ptag &, const real &num, const real &den, ::mpfr_prec_t p) : real_ball()
+{
+    detail::real_ball_ops::ratio(*this, num, den, detail::real_ball_ops::check_init_prec(p));
+}
+
+real_ball::real_ball(const ptag &, const char *s, ::mpfr_prec_t p) : real_ball()
+{
+    detail::real_ball_ops::from_string(*this, s, detail::real_ball_ops::deduce_prec(p));
+}
+
+real_ball::real_ball(const ptag &, const std::string &s, ::mpfr_prec_t p) : real_ball(ptag{}, s.c_str(), p) {}
+
+#if defined(MPPP_HAVE_STRING_VIEW)
+
+real_ball::real_ball(const ptag &, const std::string_view &s, ::mpfr_prec_t p) : real_ball(ptag{}, std::string(s), p)
+{
+}
+
+#endif
+
+/// Set the precision maintaining the current value.
+/**
+ * \rststar
+ * This method will set the precision of ``this`` to exactly ``p`` bits. If ``p``
+ * is smaller than the current precision of ``this``, the midpoint will be rounded
+ * and the rounding error will be added to the radius. Otherwise, the ball will be preserved exactly.
+ * \endrststar
+ *
+ * @param p the desired precision.
+ *
+ * @return a reference to \p this.
+ *
+ * @throws std::invalid_argument if the value of \p p is not in the range established by
+ * \link mppp::real_prec_min() real_prec_min()\endlink and \link mppp::real_prec_max() real_prec_max()\endlink.
+ */
+real_ball &real_ball::prec_round(::mpfr_prec_t p)
+{
+    if (mppp_unlikely(!detail::real_prec_check(p))) {
+        throw std::invalid_argument("Cannot set the precision of a real_ball to the value " + detail::to_string(p)
+                                    + ": the maximum allowed precision is " + detail::to_string(real_prec_max())
+                                    + ", the minimum allowed precision is " + detail::to_string(real_prec_min()));
+    }
+
+    if (p >= get_prec()) {
+        // NOTE: no rounding is needed.
+        m_mid.prec_round(p);
+    } else {
+        MPPP_ARB_WORKSPACE(ws);
+
+        detail::real_ball_ops::to_arb(ws.m_rop.m_arb, *this, ws);
+        detail::real_ball_ops::from_arb(*this, ws.m_rop.m_arb, p, ws);
+    }
+
+    return *this;
+}
+
+real real_ball::lower() const
+{
+    return detail::real_ball_ops::bound(::arb_get_lbound_arf, *this, MPFR_RNDD);
+}
+
+real real_ball::upper() const
+{
+    return detail::real_ball_ops::bound(::arb_get_ubound_arf, *this, MPFR_RNDU);
+}
+
+/// Check if the ball contains another ball.
+/**
+ * @param other the ball to be checked.
+ *
+ * @return \p true if \p other is entirely within \p this, \p false otherwise.
+ */
+bool real_ball::contains(const real_ball &other) const
+{
+    return detail::real_ball_ops::pred(::arb_contains, *this, other);
+}
+
+/// Check if the ball overlaps with another ball.
+/**
+ * @param other the other ball.
+ *
+ * @return \p true if \p this and \p other have at least one point in common, \p false otherwise.
+ */
+bool real_ball::overlaps(const real_ball &other) const
+{
+    return detail::real_ball_ops::pred(::arb_overlaps, *this, other);
+}
+
+/// Relative accuracy.
+/**
+ * \rststar
+ * This method will return the number of correct bits in the midpoint of ``this``, relative
+ * to the magnitude of the ball. Specifically, the returned value is approximately
+ * :math:`\log_2\left( \left| m \right| / r \right)`.
+ *
+ * If ``this`` is exact, the returned value is the maximum value representable by ``long long``.
+ * If the radius is infinite or the midpoint is NaN, the returned value is the minimum value
+ * representable by ``long long``.
+ * \endrststar
+ *
+ * @return the relative accuracy of \p this, in bits.
+ */
+long long real_ball::rel_accuracy_bits() const
+{
+    if (is_exact() && !m_mid.nan_p()) {
+        return detail::nl_max<long long>();
+    }
+    if (m_rad.inf_p() || m_mid.nan_p()) {
+        return detail::nl_min<long long>();
+    }
+
+    MPPP_ARB_WORKSPACE(ws);
+
+    detail::real_ball_ops::to_arb(ws.m_x.m_arb, *this, ws);
+    return static_cast<long long>(::arb_rel_accuracy_bits(ws.m_x.m_arb));
+}
+
+/// Convert to string.
+/**
+ * \rststar
+ * The ball is represented in decimal format as ``"[m +/- r]"``, where the midpoint ``m``
+ * is printed with (at most) a number of significant digits corresponding to the precision of ``this``.
+ * Exact balls are represented by their midpoint only. The ball represented by the returned string is guaranteed
+ * to contain ``this``, and it can be converted back to a :cpp:class:`~mppp::real_ball` via the string
+ * constructor.
+ * \endrststar
+ *
+ * @return \p this converted to a string.
+ *
+ * @throws std::invalid_argument if the precision of \p this is less than 2 bits.
+ */
+std::string real_ball::to_string() const
+{
+    MPPP_ARB_WORKSPACE(ws);
+
+    // NOTE: the number of decimal digits corresponding to the precision of this.
+    const auto ndigits = static_cast<::slong>(static_cast<double>(detail::mpfr_prec_to_arb_prec(get_prec()))
+                                              * 0.30102999566398120)
+                         + 1;
+    detail::real_ball_ops::to_arb(ws.m_x.m_arb, *this, ws);
+    std::unique_ptr<char, void (*)(void *)> str(::arb_get_str(ws.m_x.m_arb, ndigits, 0), ::flint_free);
+
+    return std::string(str.get());
+}
+
+namespace detail
+{
+
+namespace
+{
+
+// Wrappers for the Arb functions that do not
+// take a precision argument, or that need
+// additional arguments.
+void real_ball_arb_neg(::arb_t rop, const ::arb_t op, ::slong)
+{
+    ::arb_neg(rop, op);
+}
+
+void real_ball_arb_abs(::arb_t rop, const ::arb_t op, ::slong)
+{
+    ::arb_abs(rop, op);
+}
+
+void real_ball_arb_cbrt(::arb_t rop, const ::arb_t op, ::slong prec)
+{
+    ::arb_root_ui(rop, op, 3, prec);
+}
+
+void real_ball_arb_exp2(::arb_t rop, const ::arb_t op, ::slong prec)
+{
+    ::arb_ui_pow_arb(rop, 2, op, prec);
+}
+
+void real_ball_arb_exp10(::arb_t rop, const ::arb_t op, ::slong prec)
+{
+    ::arb_ui_pow_arb(rop, 10, op, prec);
+}
+
+void real_ball_arb_log2(::arb_t rop, const ::arb_t op, ::slong prec)
+{
+    ::arb_log_base_ui(rop, op, 2, prec);
+}
+
+void real_ball_arb_log10(::arb_t rop, const ::arb_t op, ::slong prec)
+{
+    ::arb_log_base_ui(rop, op, 10, prec);
+}
+
+} // namespace
+
+} // namespace detail
+
+// Implementation of the real_ball functions.
+#define MPPP_REAL_BALL_ARB_UNARY(name, fname)                                                                          \
+    real_ball &name(real_ball &rop, const real_ball &op)                                                               \
+    {                                                                                                                  \
+        detail::real_ball_ops::unary(fname, rop, op);                                                                  \
+        return rop;                                                                                                    \
+    }
+
+#define MPPP_REAL_BALL_ARB_BINARY(name, fname)                                                                         \
+    real_ball &name(real_ball &rop, const real_ball &a, const real_ball &b)                                            \
+    {                                                                                                                  \
+        detail::real_ball_ops::binary(fname, rop, a, b);                                                               \
+        return rop;                                                                                                    \
+    }
+
+#define MPPP_REAL_BALL_ARB_TERNARY(name, fname)                                                                        \
+    real_ball &name(real_ball &rop, const real_ball &a, const real_ball &b, const real_ball &c)                        \
+    {                                                                                                                  \
+        detail::real_ball_ops::ternary(fname, rop, a, b, c);                                                           \
+        return rop;                                                                                                    \
+    }
+
+MPPP_REAL_BALL_ARB_BINARY(add, ::arb_add)
+MPPP_REAL_BALL_ARB_BINARY(sub, ::arb_sub)
+MPPP_REAL_BALL_ARB_BINARY(mul, ::arb_mul)
+MPPP_REAL_BALL_ARB_BINARY(div, ::arb_div)
+MPPP_REAL_BALL_ARB_UNARY(neg, detail::real_ball_arb_neg)
+MPPP_REAL_BALL_ARB_UNARY(abs, detail::real_ball_arb_abs)
+MPPP_REAL_BALL_ARB_TERNARY(fma, ::arb_fma)
+
+MPPP_REAL_BALL_ARB_UNARY(sqrt, ::arb_sqrt)
+MPPP_REAL_BALL_ARB_UNARY(rec_sqrt, ::arb_rsqrt)
+MPPP_REAL_BALL_ARB_UNARY(sqrt1pm1, ::arb_sqrt1pm1)
+MPPP_REAL_BALL_ARB_UNARY(cbrt, detail::real_ball_arb_cbrt)
+MPPP_REAL_BALL_ARB_UNARY(sqr, ::arb_sqr)
+MPPP_REAL_BALL_ARB_BINARY(pow, ::arb_pow)
+MPPP_REAL_BALL_ARB_BINARY(hypot, ::arb_hypot)
+
+MPPP_REAL_BALL_ARB_UNARY(sin, ::arb_sin)
+MPPP_REAL_BALL_ARB_UNARY(cos, ::arb_cos)
+MPPP_REAL_BALL_ARB_UNARY(tan, ::arb_tan)
+MPPP_REAL_BALL_ARB_UNARY(cot, ::arb_cot)
+MPPP_REAL_BALL_ARB_UNARY(sec, ::arb_sec)
+MPPP_REAL_BALL_ARB_UNARY(csc, ::arb_csc)
+MPPP_REAL_BALL_ARB_UNARY(sin_pi, ::arb_sin_pi)
+MPPP_REAL_BALL_ARB_UNARY(cos_pi, ::arb_cos_pi)
+MPPP_REAL_BALL_ARB_UNARY(tan_pi, ::arb_tan_pi)
+MPPP_REAL_BALL_ARB_UNARY(cot_pi, ::arb_cot_pi)
+MPPP_REAL_BALL_ARB_UNARY(sinc, ::arb_sinc)
+MPPP_REAL_BALL_ARB_UNARY(sinc_pi, ::arb_sinc_pi)
+MPPP_REAL_BALL_ARB_UNARY(asin, ::arb_asin)
+MPPP_REAL_BALL_ARB_UNARY(acos, ::arb_acos)
+MPPP_REAL_BALL_ARB_UNARY(atan, ::arb_atan)
+MPPP_REAL_BALL_ARB_BINARY(atan2, ::arb_atan2)
+
+MPPP_REAL_BALL_ARB_UNARY(sinh, ::arb_sinh)
+MPPP_REAL_BALL_ARB_UNARY(cosh, ::arb_cosh)
+MPPP_REAL_BALL_ARB_UNARY(tanh, ::arb_tanh)
+MPPP_REAL_BALL_ARB_UNARY(coth, ::arb_coth)
+MPPP_REAL_BALL_ARB_UNARY(sech, ::arb_sech)
+MPPP_REAL_BALL_ARB_UNARY(csch, ::arb_csch)
+MPPP_REAL_BALL_ARB_UNARY(asinh, ::arb_asinh)
+MPPP_REAL_BALL_ARB_UNARY(acosh, ::arb_acosh)
+MPPP_REAL_BALL_ARB_UNARY(atanh, ::arb_atanh)
+
+MPPP_REAL_BALL_ARB_UNARY(exp, ::arb_exp)
+MPPP_REAL_BALL_ARB_UNARY(exp2, detail::real_ball_arb_exp2)
+MPPP_REAL_BALL_ARB_UNARY(exp10, detail::real_ball_arb_exp10)
+MPPP_REAL_BALL_ARB_UNARY(expm1, ::arb_expm1)
+MPPP_REAL_BALL_ARB_UNARY(log, ::arb_log)
+MPPP_REAL_BALL_ARB_UNARY(log2, detail::real_ball_arb_log2)
+MPPP_REAL_BALL_ARB_UNARY(log10, detail::real_ball_arb_log10)
+MPPP_REAL_BALL_ARB_UNARY(log1p, ::arb_log1p)
+MPPP_REAL_BALL_ARB_BINARY(log_hypot, ::arb_log_hypot)
+
+MPPP_REAL_BALL_ARB_UNARY(gamma, ::arb_gamma)
+MPPP_REAL_BALL_ARB_UNARY(lngamma, ::arb_lgamma)
+MPPP_REAL_BALL_ARB_UNARY(digamma, ::arb_digamma)
+
+MPPP_REAL_BALL_ARB_BINARY(agm, ::arb_agm)
+MPPP_REAL_BALL_ARB_UNARY(zeta, ::arb_zeta)
+MPPP_REAL_BALL_ARB_UNARY(erf, ::arb_hypgeom_erf)
+MPPP_REAL_BALL_ARB_UNARY(erfc, ::arb_hypgeom_erfc)
+
+#undef MPPP_REAL_BALL_ARB_UNARY
+#undef MPPP_REAL_BALL_ARB_BINARY
+#undef MPPP_REAL_BALL_ARB_TERNARY
+
+/// \link mppp::real_ball Ball\endlink \f$\pi\f$ constant.
+/**
+ * \rststar
+ * This function will return a :cpp:class:`~mppp::real_ball` containing :math:`\pi`,
+ * with a precision of ``p``. If ``p`` is zero, the precision
+ * will be set to the value returned by :cpp:func:`~mppp::real_get_default_prec()`.
+ * \endrststar
+ *
+ * @param p the desired precision.
+ *
+ * @return a \link mppp::real_ball real_ball\endlink containing \f$\pi\f$.
+ *
+ * @throws std::invalid_argument if \p p is not within the bounds established by
+ * \link mppp::real_prec_min() real_prec_min()\endlink and \link mppp::real_prec_max() real_prec_max()\endlink,
+ * or if \p p is zero but no default precision has been set.
+ */
+real_ball real_ball_pi(::mpfr_prec_t p)
+{
+    MPPP_ARB_WORKSPACE(ws);
+
+    const auto prec = detail::real_ball_ops::deduce_prec(p);
+    ::arb_const_pi(ws.m_rop.m_arb, detail::mpfr_prec_to_arb_prec(prec));
+    real_ball retval;
+    detail::real_ball_ops::from_arb(retval, ws.m_rop.m_arb, prec, ws);
+    return retval;
+}
+
+// Implementation of the real_ball comparison operators.
+#define MPPP_REAL_BALL_CMP_OPERATOR(op, fname)                                                                         \
+    bool operator op(const real_ball &a, const real_ball &b)                                                           \
+    {                                                                                                                  \
+        return detail::real_ball_ops::pred(fname, a, b);                                                               \
+    }
+
+MPPP_REAL_BALL_CMP_OPERATOR(==, ::arb_eq)
+MPPP_REAL_BALL_CMP_OPERATOR(!=, ::arb_ne)
+MPPP_REAL_BALL_CMP_OPERATOR(<, ::arb_lt)
+MPPP_REAL_BALL_CMP_OPERATOR(<=, ::arb_le)
+MPPP_REAL_BALL_CMP_OPERATOR(>, ::arb_gt)
+MPPP_REAL_BALL_CMP_OPERATOR(>=, ::arb_ge)
+
+#undef MPPP_REAL_BALL_CMP_OPERATOR
+
+#undef MPPP_ARB_WORKSPACE
+
+#endif
+
 } // namespace mppp
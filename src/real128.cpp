@@ -10,10 +10,20 @@
 
 #include <mp++/config.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <vector>
 
 #if defined(MPPP_HAVE_STRING_VIEW)
 
@@ -25,7 +35,9 @@
 // https://stackoverflow.com/questions/13780219/link-libquadmath-with-c-on-linux
 #include <quadmath.h>
 
+#include <mp++/charconv.hpp>
 #include <mp++/detail/utils.hpp>
+#include <mp++/integer.hpp>
 #include <mp++/real128.hpp>
 
 namespace mppp
@@ -42,15 +54,21 @@ namespace detail
 namespace
 {
 
-void float128_stream(std::ostream &os, const __float128 &x)
+// Print x into the buffer buf of size size.
+int float128_snprintf(char *buf, std::size_t size, const __float128 &x)
 {
-    char buf[100];
     // NOTE: 36 decimal digits ensure that reading back the string always produces the same value:
     // https://en.wikipedia.org/wiki/Quadruple-precision_floating-point_format
     // NOTE: when using the g/G format, the precision field represents the number
     // of significant digits:
     // https://linux.die.net/man/3/printf
-    const auto n = ::quadmath_snprintf(buf, sizeof(buf), "%.36Qg", x);
+    return ::quadmath_snprintf(buf, size, "%.36Qg", x);
+}
+
+void float128_stream(std::ostream &os, const __float128 &x)
+{
+    char buf[100];
+    const auto n = float128_snprintf(buf, sizeof(buf), x);
     // LCOV_EXCL_START
     if (mppp_unlikely(n < 0)) {
         throw std::runtime_error("A call to quadmath_snprintf() failed: a negative exit status of " + to_string(n)
@@ -64,6 +82,91 @@ void float128_stream(std::ostream &os, const __float128 &x)
     os << &buf[0];
 }
 
+// Write into buf the shortest decimal representation of the finite value x which
+// rounds back to x, either in fixed or in scientific notation (whichever is shorter).
+// The scientific notation is the one produced by quadmath_snprintf() with the "%Qe"
+// format string. buf must be large enough to contain at least 64 characters.
+// Returns a pointer to the end of the representation.
+char *float128_shortest(char *buf, const __float128 &x)
+{
+    ieee_float128 ie;
+    ie.value = x;
+    auto ptr = buf;
+    if (ie.i_eee.negative) {
+        *ptr++ = '-';
+    }
+    const auto biased_exp = static_cast<long long>(ie.i_eee.exponent);
+    assert(biased_exp != 0x7fff);
+    if (biased_exp == 0 && ie.i_eee.mant_high == 0u && ie.i_eee.mant_low == 0u) {
+        *ptr++ = '0';
+        return ptr;
+    }
+
+    // Build the significand and the exponent. Subnormal values have no implicit bit
+    // and the same exponent as the smallest normal value.
+    auto hi = std::uint_least64_t(ie.i_eee.mant_high);
+    if (biased_exp) {
+        hi |= std::uint_least64_t(1) << 48;
+    }
+    integer<2> m{hi};
+    m <<= 64;
+    m += std::uint_least64_t(ie.i_eee.mant_low);
+    const auto e = (biased_exp ? biased_exp : 1) - 16383 - 112;
+    const bool lower_closer = biased_exp > 1 && ie.i_eee.mant_high == 0u && ie.i_eee.mant_low == 0u;
+    MPPP_MAYBE_TLS std::vector<char> digits;
+    const auto exp10 = fp_shortest_digits(digits, m.get_mpz_view(), e, lower_closer, 10);
+    const auto n = static_cast<long long>(std::strlen(digits.data()));
+    assert(n > 0 && n <= 36);
+    const auto dbegin = digits.data();
+
+    // Decimal exponent of the first digit, and number of digits in the exponent
+    // of the scientific notation.
+    const auto x10 = exp10 + n - 1;
+    const auto x10_abs = static_cast<unsigned>(x10 < 0 ? -x10 : x10);
+    const auto x10_ndigits = x10_abs < 100u ? 2 : (x10_abs < 1000u ? 3 : 4);
+    // Like std::to_chars(), pick the shortest between the fixed and the scientific
+    // notations, preferring the fixed notation in case of ties.
+    const auto fixed_size = x10 >= 0 ? std::max(n, x10 + 1) + (n > x10 + 1 ? 1 : 0) : n + 1 - x10;
+    const auto sci_size = n + (n > 1 ? 1 : 0) + 2 + x10_ndigits;
+    if (fixed_size <= sci_size) {
+        if (x10 >= n) {
+            ptr = std::copy(dbegin, dbegin + n, ptr);
+            ptr = std::fill_n(ptr, x10 + 1 - n, '0');
+        } else if (x10 >= 0) {
+            ptr = std::copy(dbegin, dbegin + x10 + 1, ptr);
+            if (n > x10 + 1) {
+                *ptr++ = '.';
+                ptr = std::copy(dbegin + x10 + 1, dbegin + n, ptr);
+            }
+        } else {
+            *ptr++ = '0';
+            *ptr++ = '.';
+            ptr = std::fill_n(ptr, -x10 - 1, '0');
+            ptr = std::copy(dbegin, dbegin + n, ptr);
+        }
+        return ptr;
+    }
+    // Scientific notation, with at least two digits in the exponent.
+    *ptr++ = *dbegin;
+    if (n > 1) {
+        *ptr++ = '.';
+        ptr = std::copy(dbegin + 1, dbegin + n, ptr);
+    }
+    *ptr++ = 'e';
+    *ptr++ = x10 < 0 ? '-' : '+';
+    char ebuf[8];
+    auto eptr = ebuf + sizeof(ebuf);
+    auto tmp = x10_abs;
+    do {
+        *--eptr = static_cast<char>('0' + static_cast<int>(tmp % 10u));
+        tmp /= 10u;
+    } while (tmp);
+    if (x10_abs < 10u) {
+        *ptr++ = '0';
+    }
+    return std::copy(eptr, ebuf + sizeof(ebuf), ptr);
+}
+
 __float128 str_to_float128(const char *s)
 {
     char *endptr;
@@ -282,6 +385,679 @@ std::ostream &operator<<(std::ostream &os, const real128 &x)
     return os;
 }
 
+// Write the representation of x into [first, last).
+to_chars_result to_chars(char *first, char *last, const real128 &x)
+{
+    char buf[100];
+    std::size_t n;
+    if (x.finite()) {
+        n = static_cast<std::size_t>(detail::float128_shortest(buf, x.m_value) - buf);
+    } else {
+        const auto ret = detail::float128_snprintf(buf, sizeof(buf), x.m_value);
+        // LCOV_EXCL_START
+        if (mppp_unlikely(ret < 0 || unsigned(ret) >= sizeof(buf))) {
+            return {last, std::errc::invalid_argument};
+        }
+        // LCOV_EXCL_STOP
+        n = static_cast<std::size_t>(ret);
+    }
+    if (n > static_cast<std::size_t>(last - first)) {
+        return {last, std::errc::value_too_large};
+    }
+    return {std::copy(buf, buf + n, first), std::errc{}};
+}
+
+// Parse the real128 at the beginning of [first, last) into x.
+from_chars_result from_chars(const char *first, const char *last, real128 &x)
+{
+    // NOTE: strtoflt128() skips leading whitespaces and accepts a leading '+',
+    // which are not allowed here.
+    if (first == last || *first == '+' || std::isspace(static_cast<unsigned char>(*first))) {
+        return {first, std::errc::invalid_argument};
+    }
+    // Copy into a null-terminated buffer the characters which may be part of the value
+    // (in decimal or, with the "0x" prefix, in hexadecimal format). Short values
+    // are copied into a buffer on the stack.
+    const auto digits = first + (*first == '-');
+    const auto hex = last - digits >= 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X');
+    const auto end = detail::fp_str_prefix_end(first, last, hex ? 16 : 10);
+    const auto len = static_cast<std::size_t>(end - first);
+    char sbuf[128];
+    MPPP_MAYBE_TLS std::vector<char> vbuf;
+    const char *s;
+    if (len < sizeof(sbuf)) {
+        *std::copy(first, end, sbuf) = '\0';
+        s = sbuf;
+    } else {
+        vbuf.assign(first, end);
+        vbuf.push_back('\0');
+        s = vbuf.data();
+    }
+    char *endptr;
+    errno = 0;
+    const auto retval = ::strtoflt128(s, &endptr);
+    if (endptr == s) {
+        return {first, std::errc::invalid_argument};
+    }
+    const auto ptr = first + (endptr - s);
+    // NOTE: strtoflt128() sets ERANGE also when the result is a nonzero subnormal
+    // value, which is representable.
+    if (errno == ERANGE && (::isinfq(retval) || retval == 0)) {
+        return {ptr, std::errc::result_out_of_range};
+    }
+    x.m_value = retval;
+    return {ptr, std::errc{}};
+}
+
+#if defined(MPPP_HAVE_GCC_INT128)
+
+namespace detail
+{
+
+namespace
+{
+
+// Kernels for the batched real128 functions.
+//
+// The kernels below work almost entirely in double-precision arithmetic, avoiding
+// the (slow) software implementation of the quadruple-precision operations:
+//
+// - the input is split exactly into the sum of three doubles;
+// - the argument reduction and the polynomial evaluations are carried out
+//   via error-free transformations and double-double arithmetic;
+// - the result is formed as an unevaluated sum of doubles, which is then
+//   accumulated in a 128-bit integer and rounded once to quadruple precision.
+//
+// The only quadruple-precision values involved are the tabulated values of the functions,
+// which are computed once via libquadmath. The maximum error is about 1.5 ulps.
+
+// Error-free sum of a and b.
+inline void two_sum(double a, double b, double &s, double &e)
+{
+    s = a + b;
+    const auto bb = s - a;
+    e = (a - (s - bb)) + (b - bb);
+}
+
+// Error-free sum of a and b, assuming |a| >= |b|.
+inline void fast_two_sum(double a, double b, double &s, double &e)
+{
+    s = a + b;
+    e = b - (s - a);
+}
+
+// Error-free product of a and b.
+inline void two_prod(double a, double b, double &p, double &e)
+{
+    p = a * b;
+#if defined(FP_FAST_FMA)
+    e = std::fma(a, b, -p);
+#else
+    // Dekker's algorithm.
+    constexpr double split = 134217729.;
+    const auto ta = split * a, tb = split * b;
+    const auto a_hi = ta - (ta - a), a_lo = a - a_hi, b_hi = tb - (tb - b), b_lo = b - b_hi;
+    e = ((a_hi * b_hi - p) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo;
+#endif
+}
+
+// Double-double numbers, with about 106 bits of precision.
+struct dd_t {
+    double hi, lo;
+};
+
+inline dd_t dd_add(const dd_t &a, const dd_t &b)
+{
+    double s, e;
+    two_sum(a.hi, b.hi, s, e);
+    dd_t ret;
+    fast_two_sum(s, e + (a.lo + b.lo), ret.hi, ret.lo);
+    return ret;
+}
+
+inline dd_t dd_mul(const dd_t &a, const dd_t &b)
+{
+    double p, e;
+    two_prod(a.hi, b.hi, p, e);
+    dd_t ret;
+    fast_two_sum(p, e + (a.hi * b.lo + a.lo * b.hi), ret.hi, ret.lo);
+    return ret;
+}
+
+// Evaluate the polynomial c_dd[0] + c_dd[1] * x + ... + x**DDN * (c_d[0] + c_d[1] * x + ...).
+// The higher-order terms, with coefficients c_d, are evaluated in double precision.
+template <std::size_t DDN, std::size_t DN>
+inline dd_t dd_horner(const dd_t &x, const dd_t (&c_dd)[DDN], const double (&c_d)[DN])
+{
+    auto tail = c_d[DN - 1u];
+    for (std::size_t i = DN - 1u; i > 0u; --i) {
+        tail = tail * x.hi + c_d[i - 1u];
+    }
+    dd_t ret{tail, 0.};
+    for (std::size_t i = DDN; i > 0u; --i) {
+        ret = dd_add(dd_mul(ret, x), c_dd[i - 1u]);
+    }
+    return ret;
+}
+
+// Renormalise the N doubles in t, so that t[0], t[1] and t[2]
+// contain the three leading components of their sum, with the remainder
+// (if any) distributed in the other elements. The sum is unchanged.
+template <std::size_t N>
+inline void renorm3(double (&t)[N])
+{
+    for (std::size_t pass = 0; pass < 3u; ++pass) {
+        for (std::size_t i = N - 1u; i > pass; --i) {
+            two_sum(t[i - 1u], t[i], t[i - 1u], t[i]);
+        }
+    }
+}
+
+// 2**n, for n in the range of the normal double exponents.
+inline double pow2(int n)
+{
+    const auto bits = static_cast<std::uint64_t>(n + 1023) << 52;
+    double ret;
+    std::memcpy(&ret, &bits, sizeof(double));
+    return ret;
+}
+
+// Split exactly x into the sum of three doubles, so that x = t[0] + t[1] + t[2] with
+// |t[1]| < 2**-52 * |t[0]| and |t[2]| < 2**-105 * |t[0]|.
+// NOTE: x must be zero or a normal number with magnitude between 2**-900 and 2**900.
+inline void split_float128(const __float128 &x, double (&t)[3])
+{
+    ieee_float128 ief;
+    ief.value = x;
+    if (ief.i_eee.exponent == 0u) {
+        t[0] = t[1] = t[2] = 0;
+        return;
+    }
+    const auto m = (static_cast<__uint128_t>(1) << 112)
+                   | (static_cast<__uint128_t>(ief.i_eee.mant_high) << 64) | ief.i_eee.mant_low;
+    const auto e = static_cast<int>(ief.i_eee.exponent) - 16383 - 112;
+    // NOTE: all the conversions from integer to double are exact.
+    t[0] = static_cast<double>(static_cast<std::uint64_t>(m >> 60)) * pow2(e + 60);
+    t[1] = static_cast<double>(static_cast<std::uint64_t>(m >> 7) & ((std::uint64_t(1) << 53) - 1u)) * pow2(e + 7);
+    t[2] = static_cast<double>(static_cast<std::uint64_t>(m) & 127u) * pow2(e);
+    if (ief.i_eee.negative) {
+        t[0] = -t[0];
+        t[1] = -t[1];
+        t[2] = -t[2];
+    }
+}
+
+// Binary exponent of x: 2**e <= |x| < 2**(e + 1), for a normal nonzero x.
+inline int float128_ilogb(const __float128 &x)
+{
+    ieee_float128 ief;
+    ief.value = x;
+    return static_cast<int>(ief.i_eee.exponent) - 16383;
+}
+
+// Round to quadruple precision the sum of the N doubles in t, multiplied by 2**scale.
+// The sum is accumulated exactly in a 128-bit integer, except for the bits below 2**-120
+// times the largest term, which are truncated. The result is then rounded to nearest
+// (with ties away from zero), and negated if neg is true.
+// NOTE: the result must be a normal number, and the sum must not be much smaller than
+// its largest term.
+template <std::size_t N>
+inline __float128 float128_from_sum(const double (&t)[N], int scale, bool neg)
+{
+    static_assert(N < 32u, "Too many terms.");
+    std::uint64_t bits[N];
+    std::memcpy(bits, t, sizeof(bits));
+    int emax = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        emax = std::max(emax, static_cast<int>((bits[i] >> 52) & 2047u));
+    }
+    if (emax == 0) {
+        return neg ? -__float128(0) : __float128(0);
+    }
+    // The sum is acc * 2**base.
+    const auto base = emax - 1023 - 120;
+    __int128_t acc = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        const auto ef = static_cast<int>((bits[i] >> 52) & 2047u);
+        // NOTE: zero and subnormal terms are negligible.
+        if (ef == 0) {
+            continue;
+        }
+        const auto mant = (bits[i] & ((std::uint64_t(1) << 52) - 1u)) | (std::uint64_t(1) << 52);
+        const auto sh = ef - 1075 - base;
+        __uint128_t m;
+        if (sh >= 0) {
+            m = static_cast<__uint128_t>(mant) << sh;
+        } else if (sh > -53) {
+            m = mant >> -sh;
+        } else {
+            continue;
+        }
+        if (bits[i] >> 63) {
+            acc -= static_cast<__int128_t>(m);
+        } else {
+            acc += static_cast<__int128_t>(m);
+        }
+    }
+    if (acc < 0) {
+        acc = -acc;
+        neg = !neg;
+    }
+    auto u = static_cast<__uint128_t>(acc);
+    if (u == 0u) {
+        return neg ? -__float128(0) : __float128(0);
+    }
+    const auto u_hi = static_cast<std::uint64_t>(u >> 64);
+    auto p = u_hi ? 127 - __builtin_clzll(u_hi) : 63 - __builtin_clzll(static_cast<std::uint64_t>(u));
+    if (p > 112) {
+        const auto sh = p - 112;
+        u = (u + (static_cast<__uint128_t>(1) << (sh - 1))) >> sh;
+        if (u >> 113) {
+            u >>= 1;
+            ++p;
+        }
+    } else {
+        u <<= 112 - p;
+    }
+    ieee_float128 ief;
+    ief.i_eee.negative = neg;
+    ief.i_eee.exponent = static_cast<std::uint_least16_t>((base + p + scale + 16383) & 0x7fff);
+    ief.i_eee.mant_high = static_cast<std::uint64_t>(u >> 64) & ((std::uint64_t(1) << 48) - 1u);
+    ief.i_eee.mant_low = static_cast<std::uint64_t>(u);
+    return ief.value;
+}
+
+// Round to nearest integer a double whose magnitude is less than 2**51.
+inline double round_small(double x)
+{
+    constexpr double shift = 6755399441055744.;
+    return (x + shift) - shift;
+}
+
+// Exponential.
+// The argument is reduced as x = (256 * k + j) * ln(2) / 256 + r, with 0 <= j < 256 and |r| <= ln(2) / 512,
+// so that exp(x) = 2**k * T * (1 + r + p(r)), where T = 2**(j / 256) is tabulated.
+class exp_kernel
+{
+public:
+    exp_kernel()
+    {
+        for (int j = 0; j < 256; ++j) {
+            split_float128(::exp2q(static_cast<__float128>(j) / 256), m_table[j]);
+        }
+    }
+    __float128 operator()(const __float128 &x) const
+    {
+        // NOTE: outside this range, the result is subnormal or infinity, or the argument
+        // cannot be split into doubles. NaN is also excluded.
+        if (mppp_unlikely(!(::fabsq(x) < 11354) || ::fabsq(x) < 1E-250)) {
+            return ::expq(x);
+        }
+        double xs[3];
+        split_float128(x, xs);
+        // ln(2) / 256 as a sum of doubles. The first term has 30 significant bits.
+        constexpr double l0 = 0.0027076061742263846, l1 = -1.6409824502660487e-13, l2 = -5.1268353194473654e-30,
+                         l3 = -1.2921628623052048e-46;
+        // NOTE: |nd| < 2**22, thus nd * l0 is exact and, by Sterbenz's lemma, so is xs[0] - nd * l0.
+        const auto nd = round_small(xs[0] * 369.3299304675746);
+        double r[8];
+        r[0] = xs[0] - nd * l0;
+        r[1] = xs[1];
+        r[2] = xs[2];
+        two_prod(-nd, l1, r[3], r[4]);
+        two_prod(-nd, l2, r[5], r[6]);
+        r[7] = -nd * l3;
+        renorm3(r);
+        const auto n = static_cast<long>(nd);
+        const auto j = static_cast<int>(n & 255), k = static_cast<int>((n - j) / 256);
+        // p(r) = r**2 * (1 / 2! + r / 3! + ... + r**8 / 10!).
+        static const dd_t c_dd[] = {{0.5, 0.},
+                                    {0.16666666666666666, 9.25185853854297e-18},
+                                    {0.041666666666666664, 2.3129646346357427e-18},
+                                    {0.008333333333333333, 1.1564823173178714e-19},
+                                    {0.001388888888888889, -5.300543954373577e-20}};
+        static const double c_d[]
+            = {0.0001984126984126984, 2.48015873015873e-05, 2.7557319223985893e-06, 2.755731922398589e-07};
+        const dd_t rd{r[0], r[1]};
+        const auto p = dd_mul(dd_mul(rd, rd), dd_horner(rd, c_dd, c_d));
+        // T * (1 + r + p), expanded into a sum of doubles.
+        const auto &T = m_table[j];
+        double s[16];
+        s[0] = T[0];
+        s[1] = T[1];
+        s[2] = T[2];
+        two_prod(T[0], r[0], s[3], s[4]);
+        two_prod(T[0], p.hi, s[5], s[6]);
+        two_prod(T[0], r[1], s[7], s[8]);
+        two_prod(T[1], r[0], s[9], s[10]);
+        s[11] = T[0] * (r[2] + p.lo);
+        s[12] = T[1] * (r[1] + p.hi);
+        s[13] = T[2] * r[0];
+        s[14] = 0;
+        s[15] = 0;
+        return float128_from_sum(s, k, false);
+    }
+
+private:
+    double m_table[256][3];
+};
+
+// Natural logarithm.
+// The argument is reduced as x = 2**e * m, with sqrt(2) / 2 <= m < sqrt(2), and then
+// log(x) = e * ln(2) + log(c) + log(1 + z), where c = j / 256 is the closest such value to m,
+// z = (m - c) / c and log(c) is tabulated.
+class log_kernel
+{
+public:
+    log_kernel()
+    {
+        for (int j = 0; j < 183; ++j) {
+            split_float128(::logq(static_cast<__float128>(j + 181) / 256), m_table[j]);
+        }
+    }
+    __float128 operator()(const __float128 &x) const
+    {
+        ieee_float128 ief;
+        ief.value = x;
+        // NOTE: this excludes non-positive, subnormal, infinite and NaN values.
+        if (mppp_unlikely(ief.i_eee.negative || ief.i_eee.exponent == 0u || ief.i_eee.exponent == 32767u)) {
+            return ::logq(x);
+        }
+        auto e = static_cast<int>(ief.i_eee.exponent) - 16383;
+        ief.i_eee.exponent = 16383;
+        // NOTE: sqrt(2) ~ 1 + 0x6a09e667f3bc... / 2**48.
+        if (ief.i_eee.mant_high > 0x6a09e667f3bcull) {
+            ief.i_eee.exponent = 16382;
+            ++e;
+        }
+        double m[3];
+        split_float128(ief.value, m);
+        const auto j = static_cast<int>(round_small(m[0] * 256));
+        const auto c = j / 256.;
+        // z = (m - c) / c, as a sum of three doubles.
+        // NOTE: m[0] - c is exact by Sterbenz's lemma.
+        double z[3];
+        two_sum(m[0] - c, m[1], z[0], z[1]);
+        z[2] = m[2];
+        if (j != 256) {
+            // Long division by c.
+            double ph, pl, rh, rl, err;
+            const auto q0 = z[0] / c;
+            two_prod(q0, c, ph, pl);
+            two_sum(z[0] - ph, z[1], rh, rl);
+            two_sum(rh, -pl, rh, err);
+            rl += err + z[2];
+            const auto q1 = rh / c;
+            two_prod(q1, c, ph, pl);
+            z[0] = q0;
+            z[1] = q1;
+            z[2] = (((rh - ph) - pl) + rl) / c;
+        }
+        renorm3(z);
+        // log(1 + z) - z = z**2 * (-1 / 2 + z / 3 - ... - z**12 / 14).
+        static const dd_t c_dd[] = {{-0.5, 0.},
+                                    {0.3333333333333333, 1.850371707708594e-17},
+                                    {-0.25, 0.},
+                                    {0.2, -1.1102230246251566e-17},
+                                    {-0.16666666666666666, -9.25185853854297e-18},
+                                    {0.14285714285714285, 7.93016446160826e-18}};
+        static const double c_d[] = {-0.125, 0.1111111111111111, -0.1, 0.09090909090909091, -0.08333333333333333,
+                                     0.07692307692307693, -0.07142857142857142};
+        const dd_t zd{z[0], z[1]};
+        const auto p = dd_mul(dd_mul(zd, zd), dd_horner(zd, c_dd, c_d));
+        // ln(2) as a sum of doubles. The first term has 38 significant bits.
+        constexpr double l0 = 0.6931471805582987, l1 = 1.6465949582897082e-12, l2 = -1.0077949135905144e-28;
+        const auto &lc = m_table[j - 181];
+        const auto ed = static_cast<double>(e);
+        double s[12];
+        // NOTE: |e| <= 2**14, thus ed * l0 is exact.
+        s[0] = ed * l0;
+        two_prod(ed, l1, s[1], s[2]);
+        s[3] = ed * l2;
+        s[4] = lc[0];
+        s[5] = lc[1];
+        s[6] = lc[2];
+        s[7] = z[0];
+        s[8] = z[1];
+        s[9] = z[2];
+        s[10] = p.hi;
+        s[11] = p.lo;
+        return float128_from_sum(s, 0, false);
+    }
+
+private:
+    double m_table[183][3];
+};
+
+// Sine and cosine.
+// The argument is reduced as x = n * pi / 2 + r, with |r| <= pi / 4, and then
+// r = j / 64 + t, with |t| <= 1 / 128. The sine and cosine of r are computed
+// via the angle addition formulae from the tabulated values of sin(j / 64) and cos(j / 64)
+// and from the polynomial approximations of sin(t) and cos(t).
+class sincos_kernel
+{
+public:
+    sincos_kernel()
+    {
+        for (int j = 0; j < 53; ++j) {
+            const auto a = static_cast<__float128>(j) / 64;
+            split_float128(::sinq(a), m_sin_table[j]);
+            split_float128(::cosq(a), m_cos_table[j]);
+        }
+    }
+    // Compute sin(x) if Cos is false, cos(x) otherwise.
+    template <bool Cos>
+    __float128 compute(const __float128 &x) const
+    {
+        const auto ax = ::fabsq(x);
+        // NOTE: for larger arguments, the argument reduction would not be accurate enough.
+        // This also excludes infinities and NaN.
+        if (mppp_unlikely(!(ax < 1048576))) {
+            return Cos ? ::cosq(x) : ::sinq(x);
+        }
+        // NOTE: for small arguments, sin(x) and cos(x) round to x and 1 respectively.
+        if (ax < 1E-20) {
+            return Cos ? __float128(1) : x;
+        }
+        double xs[3];
+        split_float128(x, xs);
+        // pi / 2 as a sum of doubles. The first term has 33 significant bits.
+        constexpr double p0 = 1.5707963267341256, p1 = 6.077100506506192e-11, p2 = 3.5215598651832e-27,
+                         p3 = 2.0670321098263988e-43;
+        // NOTE: |nd| < 2**20, thus nd * p0 is exact and, by Sterbenz's lemma, so is xs[0] - nd * p0.
+        const auto nd = round_small(xs[0] * 0.6366197723675814);
+        double r[8];
+        r[0] = xs[0] - nd * p0;
+        r[1] = xs[1];
+        r[2] = xs[2];
+        two_prod(-nd, p1, r[3], r[4]);
+        two_prod(-nd, p2, r[5], r[6]);
+        r[7] = -nd * p3;
+        renorm3(r);
+        // NOTE: if x is very close to a multiple of pi / 2, the precision of the
+        // reduced argument is not sufficient.
+        if (mppp_unlikely(nd != 0 && std::abs(r[0]) < 9.094947017729282e-13)) {
+            return Cos ? ::cosq(x) : ::sinq(x);
+        }
+        auto q = static_cast<unsigned>(static_cast<long>(nd) & 3);
+        if (Cos) {
+            // cos(x) = sin(x + pi / 2).
+            q = (q + 1u) & 3u;
+        }
+        // Reduce to r >= 0, via sin(r) = -sin(-r) and cos(r) = cos(-r).
+        bool neg = (q & 2u) != 0u;
+        if (r[0] < 0) {
+            r[0] = -r[0];
+            r[1] = -r[1];
+            r[2] = -r[2];
+            if (!(q & 1u)) {
+                neg = !neg;
+            }
+        }
+        const auto j = static_cast<int>(round_small(r[0] * 64));
+        // NOTE: this is exact by Sterbenz's lemma.
+        double t[3];
+        two_sum(r[0] - j / 64., r[1], t[0], t[1]);
+        t[2] = r[2];
+        dd_t td;
+        fast_two_sum(t[0], t[1], td.hi, td.lo);
+        const auto t2 = dd_mul(td, td);
+        // sin(t) - t = t**3 * (-1 / 3! + t**2 / 5! - ... + t**10 / 13!).
+        static const dd_t s_dd[] = {{-0.16666666666666666, -9.25185853854297e-18},
+                                    {0.008333333333333333, 1.1564823173178714e-19},
+                                    {-0.0001984126984126984, -1.7209558293420705e-22},
+                                    {2.7557319223985893e-06, -1.858393274046472e-22}};
+        static const double s_d[] = {-2.505210838544172e-08, 1.6059043836821613e-10};
+        // cos(t) - 1 = t**2 * (-1 / 2! + t**2 / 4! - ... - t**12 / 14!).
+        static const dd_t c_dd[] = {{-0.5, 0.},
+                                    {0.041666666666666664, 2.3129646346357427e-18},
+                                    {-0.001388888888888889, 5.300543954373577e-20},
+                                    {2.48015873015873e-05, 2.1511947866775882e-23}};
+        static const double c_d[] = {-2.755731922398589e-07, 2.08767569878681e-09, -1.1470745597729725e-11};
+        const auto st = dd_mul(dd_mul(td, t2), dd_horner(t2, s_dd, s_d));
+        const auto ct = dd_mul(t2, dd_horner(t2, c_dd, c_d));
+        // With a = j / 64:
+        // sin(r) = sin(a) + cos(a) * t + sin(a) * ct + cos(a) * st,
+        // cos(r) = cos(a) - sin(a) * t + cos(a) * ct - sin(a) * st.
+        // A and B are the first two tabulated values, B multiplies t and st,
+        // and its sign is sb.
+        const auto &A = (q & 1u) ? m_cos_table[j] : m_sin_table[j];
+        const auto &B = (q & 1u) ? m_sin_table[j] : m_cos_table[j];
+        const double sb = (q & 1u) ? -1. : 1.;
+        double s[16];
+        s[0] = A[0];
+        s[1] = A[1];
+        s[2] = A[2];
+        two_prod(sb * B[0], t[0], s[3], s[4]);
+        two_prod(sb * B[0], t[1], s[5], s[6]);
+        two_prod(sb * B[1], t[0], s[7], s[8]);
+        s[9] = sb * (B[0] * t[2] + B[1] * t[1] + B[2] * t[0]);
+        two_prod(A[0], ct.hi, s[10], s[11]);
+        s[12] = A[0] * ct.lo + A[1] * ct.hi;
+        two_prod(sb * B[0], st.hi, s[13], s[14]);
+        s[15] = sb * (B[0] * st.lo + B[1] * st.hi);
+        return float128_from_sum(s, 0, neg);
+    }
+
+private:
+    double m_sin_table[53][3];
+    double m_cos_table[53][3];
+};
+
+// NOTE: the kernels are initialised on first use.
+const exp_kernel &get_exp_kernel()
+{
+    static const exp_kernel k;
+    return k;
+}
+
+const log_kernel &get_log_kernel()
+{
+    static const log_kernel k;
+    return k;
+}
+
+const sincos_kernel &get_sincos_kernel()
+{
+    static const sincos_kernel k;
+    return k;
+}
+
+} // namespace
+
+} // namespace detail
+
+#endif
+
+namespace batch
+{
+
+void exp(real128 *rop, const real128 *op, std::size_t n)
+{
+#if defined(MPPP_HAVE_GCC_INT128)
+    const auto &k = detail::get_exp_kernel();
+    for (std::size_t i = 0; i < n; ++i) {
+        rop[i].m_value = k(op[i].m_value);
+    }
+#else
+    for (std::size_t i = 0; i < n; ++i) {
+        rop[i].m_value = ::expq(op[i].m_value);
+    }
+#endif
+}
+
+void log(real128 *rop, const real128 *op, std::size_t n)
+{
+#if defined(MPPP_HAVE_GCC_INT128)
+    const auto &k = detail::get_log_kernel();
+    for (std::size_t i = 0; i < n; ++i) {
+        rop[i].m_value = k(op[i].m_value);
+    }
+#else
+    for (std::size_t i = 0; i < n; ++i) {
+        rop[i].m_value = ::logq(op[i].m_value);
+    }
+#endif
+}
+
+void sin(real128 *rop, const real128 *op, std::size_t n)
+{
+#if defined(MPPP_HAVE_GCC_INT128)
+    const auto &k = detail::get_sincos_kernel();
+    for (std::size_t i = 0; i < n; ++i) {
+        rop[i].m_value = k.compute<false>(op[i].m_value);
+    }
+#else
+    for (std::size_t i = 0; i < n; ++i) {
+        rop[i].m_value = ::sinq(op[i].m_value);
+    }
+#endif
+}
+
+void cos(real128 *rop, const real128 *op, std::size_t n)
+{
+#if defined(MPPP_HAVE_GCC_INT128)
+    const auto &k = detail::get_sincos_kernel();
+    for (std::size_t i = 0; i < n; ++i) {
+        rop[i].m_value = k.compute<true>(op[i].m_value);
+    }
+#else
+    for (std::size_t i = 0; i < n; ++i) {
+        rop[i].m_value = ::cosq(op[i].m_value);
+    }
+#endif
+}
+
+// Batched functions implemented via libquadmath.
+#define MPPP_REAL128_BATCH_QUADMATH(name)                                                                              \
+    void name(real128 *rop, const real128 *op, std::size_t n)                                                          \
+    {                                                                                                                  \
+        for (std::size_t i = 0; i < n; ++i) {                                                                          \
+            rop[i].m_value = ::name##q(op[i].m_value);                                                                 \
+        }                                                                                                              \
+    }
+
+MPPP_REAL128_BATCH_QUADMATH(sqrt)
+MPPP_REAL128_BATCH_QUADMATH(cbrt)
+MPPP_REAL128_BATCH_QUADMATH(tan)
+MPPP_REAL128_BATCH_QUADMATH(asin)
+MPPP_REAL128_BATCH_QUADMATH(acos)
+MPPP_REAL128_BATCH_QUADMATH(atan)
+MPPP_REAL128_BATCH_QUADMATH(sinh)
+MPPP_REAL128_BATCH_QUADMATH(cosh)
+MPPP_REAL128_BATCH_QUADMATH(tanh)
+MPPP_REAL128_BATCH_QUADMATH(asinh)
+MPPP_REAL128_BATCH_QUADMATH(acosh)
+MPPP_REAL128_BATCH_QUADMATH(atanh)
+MPPP_REAL128_BATCH_QUADMATH(log10)
+MPPP_REAL128_BATCH_QUADMATH(log2)
+MPPP_REAL128_BATCH_QUADMATH(lgamma)
+MPPP_REAL128_BATCH_QUADMATH(erf)
+
+#undef MPPP_REAL128_BATCH_QUADMATH
+
+} // namespace batch
+
 } // namespace mppp
 
 #endif
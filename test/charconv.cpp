@@ -0,0 +1,231 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <mp++/charconv.hpp>
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace mppp;
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
+                         std::integral_constant<std::size_t, 10>>;
+
+static int ntries = 1000;
+
+static std::mt19937 rng;
+
+struct integer_charconv_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1), bdist(2, 62);
+        std::uniform_int_distribution<unsigned> ldist(0, S::value * 2u + 3u);
+        std::vector<char> buffer;
+        for (int i = 0; i < ntries; ++i) {
+            random_integer(tmp, ldist(rng), rng);
+            integer n{&tmp.m_mpz};
+            if (sdist(rng)) {
+                n.neg();
+            }
+            const auto base = sdist(rng) ? 10 : bdist(rng);
+            const auto str = n.to_string(base);
+
+            // Exact fit.
+            buffer.assign(str.size(), 'x');
+            auto ret = to_chars(buffer.data(), buffer.data() + buffer.size(), n, base);
+            REQUIRE(ret.ec == std::errc{});
+            REQUIRE(ret.ptr == buffer.data() + buffer.size());
+            REQUIRE(std::string(buffer.data(), ret.ptr) == str);
+
+            // Large buffer.
+            buffer.assign(str.size() + 10u, 'x');
+            ret = to_chars(buffer.data(), buffer.data() + buffer.size(), n, base);
+            REQUIRE(ret.ec == std::errc{});
+            REQUIRE(std::string(buffer.data(), ret.ptr) == str);
+
+            // Buffer too small.
+            buffer.assign(str.size() - 1u, 'x');
+            ret = to_chars(buffer.data(), buffer.data() + buffer.size(), n, base);
+            REQUIRE(ret.ec == std::errc::value_too_large);
+            REQUIRE(ret.ptr == buffer.data() + buffer.size());
+
+            // Parse back, with trailing characters.
+            const auto in = str + "/x";
+            integer m{42};
+            const auto fret = from_chars(in.data(), in.data() + in.size(), m, base);
+            REQUIRE(fret.ec == std::errc{});
+            REQUIRE(fret.ptr == in.data() + str.size());
+            REQUIRE(m == n);
+        }
+    }
+};
+
+TEST_CASE("integer charconv")
+{
+    tuple_for_each(sizes{}, integer_charconv_tester{});
+
+    char buffer[100];
+    integer<1> n{123};
+    auto ret = to_chars(buffer, buffer + 100, n, 1);
+    REQUIRE(ret.ec == std::errc::invalid_argument);
+    REQUIRE(ret.ptr == buffer + 100);
+    REQUIRE(to_chars(buffer, buffer + 100, n, 63).ec == std::errc::invalid_argument);
+    ret = to_chars(buffer, buffer, integer<1>{});
+    REQUIRE(ret.ec == std::errc::value_too_large);
+    ret = to_chars(buffer, buffer + 1, integer<1>{});
+    REQUIRE(ret.ec == std::errc{});
+    REQUIRE(ret.ptr == buffer + 1);
+    REQUIRE(buffer[0] == '0');
+
+    // Parsing errors leave the output untouched.
+    const std::string bad[] = {"", "-", "+1", " 1", "x1", "--1", "-x"};
+    for (const auto &s : bad) {
+        const auto fret = from_chars(s.data(), s.data() + s.size(), n);
+        REQUIRE(fret.ec == std::errc::invalid_argument);
+        REQUIRE(fret.ptr == s.data());
+        REQUIRE(n == 123);
+    }
+    std::string s = "123";
+    REQUIRE(from_chars(s.data(), s.data() + s.size(), n, 0).ec == std::errc::invalid_argument);
+    REQUIRE(from_chars(s.data(), s.data() + s.size(), n, 63).ec == std::errc::invalid_argument);
+    REQUIRE(n == 123);
+
+    // Parsing stops at the first invalid digit.
+    s = "-1239a";
+    auto fret = from_chars(s.data(), s.data() + s.size(), n);
+    REQUIRE(fret.ec == std::errc{});
+    REQUIRE(fret.ptr == s.data() + 5);
+    REQUIRE(n == -1239);
+    fret = from_chars(s.data(), s.data() + s.size(), n, 16);
+    REQUIRE(fret.ptr == s.data() + 6);
+    REQUIRE(n == -0x1239a);
+    s = "-0";
+    fret = from_chars(s.data(), s.data() + s.size(), n);
+    REQUIRE(fret.ptr == s.data() + 2);
+    REQUIRE(n.is_zero());
+    // Case sensitivity in the large bases.
+    s = "aZ";
+    REQUIRE(from_chars(s.data(), s.data() + s.size(), n, 36).ptr == s.data() + 2);
+    REQUIRE(n == 10 * 36 + 35);
+    REQUIRE(from_chars(s.data(), s.data() + s.size(), n, 62).ptr == s.data() + 2);
+    REQUIRE(n == 36 * 62 + 35);
+    s = "az";
+    REQUIRE(from_chars(s.data(), s.data() + s.size(), n, 40).ptr == s.data() + 1);
+    REQUIRE(n == 36);
+
+    // Leading zeroes and long strings.
+    s = std::string(100, '0') + "1";
+    REQUIRE(from_chars(s.data(), s.data() + s.size(), n).ptr == s.data() + s.size());
+    REQUIRE(n == 1);
+    s = "-" + std::string(500, '7');
+    REQUIRE(from_chars(s.data(), s.data() + s.size(), n).ptr == s.data() + s.size());
+    REQUIRE(n == integer<1>{s});
+    REQUIRE(n.to_string() == s);
+}
+
+struct rational_charconv_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        using rational = rational<S::value>;
+
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1), bdist(2, 62);
+        std::uniform_int_distribution<unsigned> ldist(0, S::value * 2u + 3u);
+        std::vector<char> buffer;
+        for (int i = 0; i < ntries; ++i) {
+            random_integer(tmp, ldist(rng), rng);
+            integer num{&tmp.m_mpz};
+            random_integer(tmp, ldist(rng), rng);
+            integer den{&tmp.m_mpz};
+            if (den.is_zero()) {
+                den.set_one();
+            }
+            if (sdist(rng)) {
+                num.neg();
+            }
+            const rational q{num, den};
+            const auto base = sdist(rng) ? 10 : bdist(rng);
+            const auto str = q.to_string(base);
+
+            buffer.assign(str.size(), 'x');
+            auto ret = to_chars(buffer.data(), buffer.data() + buffer.size(), q, base);
+            REQUIRE(ret.ec == std::errc{});
+            REQUIRE(ret.ptr == buffer.data() + buffer.size());
+            REQUIRE(std::string(buffer.data(), ret.ptr) == str);
+
+            buffer.assign(str.size() - 1u, 'x');
+            ret = to_chars(buffer.data(), buffer.data() + buffer.size(), q, base);
+            REQUIRE(ret.ec == std::errc::value_too_large);
+
+            rational r{1, 2};
+            const auto in = str + " ";
+            const auto fret = from_chars(in.data(), in.data() + in.size(), r, base);
+            REQUIRE(fret.ec == std::errc{});
+            REQUIRE(fret.ptr == in.data() + str.size());
+            REQUIRE(r == q);
+        }
+    }
+};
+
+TEST_CASE("rational charconv")
+{
+    tuple_for_each(sizes{}, rational_charconv_tester{});
+
+    // The division operator must fit in the output range.
+    char buffer[100];
+    const rational<1> q{-3, 4};
+    REQUIRE(to_chars(buffer, buffer + 2, q).ec == std::errc::value_too_large);
+    REQUIRE(to_chars(buffer, buffer + 3, q).ec == std::errc::value_too_large);
+    auto ret = to_chars(buffer, buffer + 4, q);
+    REQUIRE(ret.ec == std::errc{});
+    REQUIRE(std::string(buffer, ret.ptr) == "-3/4");
+    REQUIRE(to_chars(buffer, buffer + 100, q, 70).ec == std::errc::invalid_argument);
+
+    // Parsing.
+    rational<1> r;
+    std::string s = "6/-4";
+    auto fret = from_chars(s.data(), s.data() + s.size(), r);
+    REQUIRE(fret.ec == std::errc{});
+    REQUIRE(fret.ptr == s.data() + 1);
+    REQUIRE(r == 6);
+    s = "6/";
+    fret = from_chars(s.data(), s.data() + s.size(), r);
+    REQUIRE(fret.ptr == s.data() + 1);
+    REQUIRE(r == 6);
+    s = "-6/4x";
+    fret = from_chars(s.data(), s.data() + s.size(), r);
+    REQUIRE(fret.ptr == s.data() + 4);
+    REQUIRE(r == rational<1>{-3, 2});
+    s = "6/0";
+    fret = from_chars(s.data(), s.data() + s.size(), r);
+    REQUIRE(fret.ec == std::errc::invalid_argument);
+    REQUIRE(fret.ptr == s.data());
+    REQUIRE(r == rational<1>{-3, 2});
+    s = "/3";
+    REQUIRE(from_chars(s.data(), s.data() + s.size(), r).ec == std::errc::invalid_argument);
+    REQUIRE(r == rational<1>{-3, 2});
+}
@@ -0,0 +1,460 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <complex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mp++/complex.hpp>
+#include <mp++/config.hpp>
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/memory.hpp>
+#include <mp++/rational.hpp>
+#include <mp++/real.hpp>
+
+#include "catch.hpp"
+
+using namespace mppp;
+
+// Check that the components of a are the components of the exact
+// value ref correctly rounded to the precision of a.
+static inline bool correctly_rounded(const complex &a, const complex &ref)
+{
+    return a.re() == real{ref.re(), a.get_prec()} && a.im() == real{ref.im(), a.get_prec()};
+}
+
+// Check that the components of a agree with the components of ref to p bits.
+static inline bool agree(const complex &a, const complex &ref, ::mpfr_prec_t p)
+{
+    const auto r = abs(ref);
+    return abs(a.re() - ref.re()) <= mul_2si(r, -static_cast<long>(p))
+           && abs(a.im() - ref.im()) <= mul_2si(r, -static_cast<long>(p));
+}
+
+// The exact product of a and b.
+static inline complex exact_mul(const complex &a, const complex &b)
+{
+    const auto p = a.get_prec() + b.get_prec() + 64;
+    const real ar{a.re(), p}, ai{a.im(), p};
+    return complex{ar * b.re() - ai * b.im(), ar * b.im() + ai * b.re()};
+}
+
+TEST_CASE("complex type traits")
+{
+    REQUIRE(is_complex_interoperable<int>::value);
+    REQUIRE(is_complex_interoperable<double>::value);
+    REQUIRE(is_complex_interoperable<real>::value);
+    REQUIRE(is_complex_interoperable<integer<1>>::value);
+    REQUIRE(is_complex_interoperable<rational<1>>::value);
+    REQUIRE(is_complex_interoperable<std::complex<double>>::value);
+    REQUIRE(!is_complex_interoperable<complex>::value);
+    REQUIRE(!is_complex_interoperable<std::vector<int>>::value);
+    REQUIRE(!is_complex_interoperable<real &>::value);
+    REQUIRE(are_complex_op_types<complex, int>::value);
+    REQUIRE(are_complex_op_types<const complex &, real &&>::value);
+    REQUIRE(are_complex_op_types<std::complex<double>, complex &>::value);
+    REQUIRE(!are_complex_op_types<real, int>::value);
+    REQUIRE(are_complex_in_place_op_types<complex &, int>::value);
+    REQUIRE(!are_complex_in_place_op_types<const complex &, int>::value);
+    REQUIRE(!are_complex_in_place_op_types<int &, complex>::value);
+}
+
+TEST_CASE("complex constructors")
+{
+    complex c;
+    REQUIRE(c.is_valid());
+    REQUIRE(c.zero_p());
+    REQUIRE(c.get_prec() == real{}.get_prec());
+
+    c = complex{1, 2};
+    REQUIRE(c.re() == 1);
+    REQUIRE(c.im() == 2);
+    REQUIRE(c.get_prec() == real{1}.get_prec());
+
+    // The precision is the largest among the components.
+    c = complex{real{1, 20}, real{2, 40}};
+    REQUIRE(c.get_prec() == 40);
+    REQUIRE(c.re().get_prec() == 40);
+    REQUIRE(c.im().get_prec() == 40);
+    c = complex{1.5, integer<1>{3}};
+    REQUIRE(c.re() == 1.5);
+    REQUIRE(c.im() == 3);
+
+    // Explicit precision.
+    c = complex{1, complex_prec_t(128)};
+    REQUIRE(c.get_prec() == 128);
+    REQUIRE(c.re() == 1);
+    REQUIRE(c.im().zero_p());
+    c = complex{rational<1>{1, 3}, 2, complex_prec_t(100)};
+    REQUIRE(c.get_prec() == 100);
+    REQUIRE(c.re() == real{rational<1>{1, 3}, 100});
+    REQUIRE(c.im() == 2);
+    c = complex{c, complex_prec_t(10)};
+    REQUIRE(c.get_prec() == 10);
+    REQUIRE(c.re() == real{rational<1>{1, 3}, 10});
+    REQUIRE_THROWS_AS((complex{1, complex_prec_t(0)}), std::invalid_argument);
+    REQUIRE_THROWS_AS((complex{1, 2, complex_prec_t(-1)}), std::invalid_argument);
+    REQUIRE_THROWS_AS((complex{c, complex_prec_t(real_prec_max() + 1)}), std::invalid_argument);
+
+    // Real components.
+    c = complex{real{3, 70}};
+    REQUIRE(c.get_prec() == 70);
+    REQUIRE(c.re() == 3);
+    REQUIRE(c.im().zero_p());
+
+    // std::complex.
+    c = complex{std::complex<double>{1.5, -2.5}};
+    REQUIRE(c.re() == 1.5);
+    REQUIRE(c.im() == -2.5);
+    REQUIRE(static_cast<std::complex<double>>(c) == std::complex<double>{1.5, -2.5});
+    c = complex{std::complex<float>{1, 2}, complex_prec_t(200)};
+    REQUIRE(c.get_prec() == 200);
+    c = std::complex<double>{3, 4};
+    REQUIRE(c == std::complex<double>{3, 4});
+
+    // Assignment from interoperable types.
+    c = 5;
+    REQUIRE(c == 5);
+    c = real{1, 300};
+    REQUIRE(c.get_prec() == 300);
+
+    // Moved-from objects.
+    complex d{std::move(c)};
+    REQUIRE(d.get_prec() == 300);
+    REQUIRE(!c.is_valid());
+    c = d;
+    REQUIRE(c.is_valid());
+    REQUIRE(c == d);
+}
+
+TEST_CASE("complex precision")
+{
+    complex c{1, 2, complex_prec_t(100)};
+    c.prec_round(200);
+    REQUIRE(c.get_prec() == 200);
+    REQUIRE(c == complex{1, 2});
+    c.set_prec(30);
+    REQUIRE(c.get_prec() == 30);
+    REQUIRE(c.re().nan_p());
+    REQUIRE(c.im().nan_p());
+    REQUIRE_THROWS_AS(c.set_prec(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(c.prec_round(real_prec_max() + 1), std::invalid_argument);
+}
+
+TEST_CASE("complex to_string")
+{
+    const complex c{1, -2};
+    REQUIRE(c.to_string() == '(' + real{1}.to_string() + ',' + real{-2}.to_string() + ')');
+    REQUIRE(c.to_string(2) == '(' + real{1}.to_string(2) + ',' + real{-2}.to_string(2) + ')');
+    std::ostringstream oss;
+    oss << c;
+    REQUIRE(oss.str() == c.to_string());
+}
+
+TEST_CASE("complex arithmetic")
+{
+    const complex a{1, 2}, b{3, -4};
+
+    REQUIRE(+a == a);
+    REQUIRE(-a == complex{-1, -2});
+    REQUIRE(a + b == complex{4, -2});
+    REQUIRE(a - b == complex{-2, 6});
+    REQUIRE(a * b == complex{11, 2});
+    REQUIRE(complex{11, 2} / b == a);
+
+    // Mixed-mode operations.
+    REQUIRE(a + 1 == complex{2, 2});
+    REQUIRE(1 + a == complex{2, 2});
+    REQUIRE(a - 1 == complex{0, 2});
+    REQUIRE(1 - a == complex{0, -2});
+    REQUIRE(a * 2 == complex{2, 4});
+    REQUIRE(2. * a == complex{2, 4});
+    REQUIRE(a / 2 == complex{.5, 1});
+    REQUIRE(2 / complex{1, 1} == complex{1, -1});
+    REQUIRE(a * real{3} == complex{3, 6});
+    REQUIRE(a + std::complex<double>{1, 1} == complex{2, 3});
+    REQUIRE(std::complex<double>{1, 1} - a == complex{0, -1});
+
+    // The precision of the result is the largest precision among the operands.
+    REQUIRE((a + real{1, 300}).get_prec() == 300);
+    REQUIRE((real{1, 300} - a).get_prec() == 300);
+    REQUIRE((a * real{1, 300}).im().get_prec() == 300);
+    REQUIRE((a / complex{1, 1, complex_prec_t(300)}).get_prec() == 300);
+
+    // In-place operators.
+    complex c{a};
+    c += b;
+    REQUIRE(c == complex{4, -2});
+    c -= 1;
+    REQUIRE(c == complex{3, -2});
+    c *= complex{0, 1};
+    REQUIRE(c == complex{2, 3});
+    c /= 2;
+    REQUIRE(c == complex{1, 1.5});
+    c += std::complex<double>{1, 1};
+    REQUIRE(c == complex{2, 2.5});
+    c += real{1, 300};
+    REQUIRE(c.get_prec() == 300);
+    REQUIRE(c.im().get_prec() == 300);
+    REQUIRE(c == complex{3, 2.5});
+    c *= c;
+    REQUIRE(c == complex{2.75, 15});
+
+    // Increment/decrement.
+    c = a;
+    REQUIRE(++c == complex{2, 2});
+    REQUIRE(c++ == complex{2, 2});
+    REQUIRE(c == complex{3, 2});
+    REQUIRE(--c == complex{2, 2});
+    REQUIRE(c-- == complex{2, 2});
+    REQUIRE(c == a);
+
+    // Equality.
+    REQUIRE(a != b);
+    REQUIRE(complex{3, 0} == 3);
+    REQUIRE(3 == complex{3, 0});
+    REQUIRE(complex{3, 1} != 3);
+    REQUIRE(std::complex<double>{1, 2} == a);
+
+    // Ternary forms.
+    complex rop;
+    REQUIRE(&add(rop, a, b) == &rop);
+    REQUIRE(rop == complex{4, -2});
+    sub(rop, a, b);
+    REQUIRE(rop == complex{-2, 6});
+    mul(rop, a, b);
+    REQUIRE(rop == complex{11, 2});
+    div(rop, rop, b);
+    REQUIRE(rop == a);
+    mul(rop, rop, rop);
+    REQUIRE(rop == complex{-3, 4});
+}
+
+TEST_CASE("complex mul")
+{
+    // Correct rounding at low and high precision, including the
+    // Karatsuba path and operands with heavy cancellation.
+    for (::mpfr_prec_t p : {10, 53, 113, 511, 512, 600, 1000, 2048}) {
+        const complex a{real_pi(p), sqrt(real{2, p}), complex_prec_t(p)},
+            b{real{1, p} / 3, -exp(real{1, p}), complex_prec_t(p)};
+        REQUIRE(correctly_rounded(a * b, exact_mul(a, b)));
+        REQUIRE(correctly_rounded(b * a, exact_mul(a, b)));
+
+        // a * conj(a) has an exactly zero imaginary part, and
+        // (x + yi) * (y + xi) a zero real part.
+        auto r = a * conj(a);
+        REQUIRE(r.im().zero_p());
+        REQUIRE(correctly_rounded(r, exact_mul(a, conj(a))));
+        r = a * complex{a.im(), a.re()};
+        REQUIRE(r.re().zero_p());
+        REQUIRE(correctly_rounded(r, exact_mul(a, complex{a.im(), a.re()})));
+
+        // Nearly cancelling products.
+        const complex c{real{1, p} + mul_2si(real{1, p}, 1 - p), 1, complex_prec_t(p)}, d{1, -1, complex_prec_t(p)};
+        REQUIRE(correctly_rounded(c * d, exact_mul(c, d)));
+
+        // Squaring.
+        REQUIRE(correctly_rounded(sqr(a), exact_mul(a, a)));
+        REQUIRE(correctly_rounded(a * a, exact_mul(a, a)));
+    }
+
+    // Special values.
+    const auto inf = real{"inf", 600}, nan = real{"nan", 600};
+    auto r = complex{inf, 1} * complex{1, complex_prec_t(600)};
+    REQUIRE(r.re().inf_p());
+    r = complex{nan, 1} * complex{1, 1, complex_prec_t(600)};
+    REQUIRE(r.re().nan_p());
+    REQUIRE(r.im().nan_p());
+}
+
+TEST_CASE("complex mul_add")
+{
+    for (::mpfr_prec_t p : {10, 53, 113, 600}) {
+        const complex a{real_pi(p), sqrt(real{2, p}), complex_prec_t(p)},
+            b{real{1, p} / 3, -exp(real{1, p}), complex_prec_t(p)};
+        const auto prod = exact_mul(a, b);
+        // A value which cancels most of the product.
+        const complex c{-real{prod.re(), p}, -real{prod.im(), p}};
+        complex rop;
+        mul_add(rop, a, b, c);
+        REQUIRE(rop.get_prec() == p);
+        REQUIRE(correctly_rounded(rop, prod + c));
+        REQUIRE(correctly_rounded(mul_add(a, b, c), prod + c));
+        REQUIRE(correctly_rounded(mul_add(a, b, complex{1, 1}), prod + complex{1, 1}));
+    }
+}
+
+TEST_CASE("complex elementary functions")
+{
+    for (::mpfr_prec_t p : {10, 53, 113, 600}) {
+        const complex a{real_pi(p), sqrt(real{2, p}), complex_prec_t(p)},
+            b{real{1, p} / -3, exp(real{1, p}), complex_prec_t(p)};
+        const auto wp = 2 * p + 64;
+        const complex aw{a, complex_prec_t(wp)}, bw{b, complex_prec_t(wp)};
+
+        REQUIRE(agree(a / b, exact_mul(aw, conj(bw)) / norm(bw), p - 2));
+        REQUIRE((a / b).get_prec() == p);
+
+        const auto sa = sqrt(a), sb = sqrt(b);
+        REQUIRE(sa.get_prec() == p);
+        REQUIRE(agree(sqr(complex{sa, complex_prec_t(wp)}), aw, p - 2));
+        REQUIRE(agree(sqr(complex{sb, complex_prec_t(wp)}), bw, p - 2));
+        REQUIRE(sa.re().sgn() > 0);
+        REQUIRE(sb.re().sgn() > 0);
+
+        const auto ea = exp(a);
+        REQUIRE(ea.get_prec() == p);
+        REQUIRE(agree(ea, complex{exp(aw.re()) * cos(aw.im()), exp(aw.re()) * sin(aw.im())}, p - 2));
+        REQUIRE(agree(log(ea), a, p - 3));
+
+        const auto lb = log(b);
+        REQUIRE(lb.get_prec() == p);
+        REQUIRE(agree(lb, complex{log(abs(bw)), atan2(bw.im(), bw.re())}, p - 2));
+        REQUIRE(lb.im() == arg(b));
+
+        // log() close to the unit circle.
+        const complex u{cos(real{1, p}), sin(real{1, p}), complex_prec_t(p)};
+        const complex uw{u, complex_prec_t(wp)};
+        const auto lu = log(u);
+        REQUIRE(abs(lu.re() - real{log1p(norm(uw) - 1) / 2, p}) <= mul_2si(abs(lu.re()), 2 - p));
+
+        REQUIRE(abs(a) == hypot(a.re(), a.im()));
+        REQUIRE(norm(a) == real{exact_mul(aw, conj(aw)).re(), p});
+        REQUIRE(norm(a).get_prec() == p);
+        REQUIRE(arg(a) == atan2(a.im(), a.re()));
+    }
+
+    // Exact cases and special values.
+    REQUIRE(sqrt(complex{-4, 0}) == complex{0, 2});
+    REQUIRE(sqrt(complex{-4, -0.}) == complex{0, -2});
+    REQUIRE(sqrt(complex{3, 4}) == complex{2, 1});
+    REQUIRE(sqrt(complex{0, 0}).zero_p());
+    REQUIRE(sqrt(complex{1, real{"inf", 53}}).re().inf_p());
+    REQUIRE(sqrt(complex{real{"nan", 53}, 1}).im().nan_p());
+    REQUIRE(exp(complex{0, 0}) == 1);
+    REQUIRE(exp(complex{real{1, 100}, 0}) == exp(real{1, 100}));
+    REQUIRE(log(complex{1, 0}).zero_p());
+    const auto lm1 = log(complex{-1, 0});
+    REQUIRE(lm1.re().zero_p());
+    REQUIRE(lm1.im() == real_pi(lm1.get_prec()));
+    REQUIRE(conj(complex{1, 2}) == complex{1, -2});
+
+    // In-place member functions.
+    complex c{3, 4};
+    c.sqrt();
+    REQUIRE(c == complex{2, 1});
+    c.sqr();
+    REQUIRE(c == complex{3, 4});
+    c.conj();
+    REQUIRE(c == complex{3, -4});
+    c.neg();
+    REQUIRE(c == complex{-3, 4});
+    c = complex{0, 0};
+    c.exp();
+    REQUIRE(c == 1);
+    c.log();
+    REQUIRE(c.zero_p());
+}
+
+TEST_CASE("complex rvalue stealing")
+{
+    // The storage of rvalue operands is re-used for the return value.
+    complex a{1, 2, complex_prec_t(600)}, b{3, 4, complex_prec_t(600)};
+    auto ptr = a.re().get_mpfr_t()->_mpfr_d;
+    auto r = std::move(a) + b;
+    REQUIRE(r.re().get_mpfr_t()->_mpfr_d == ptr);
+    REQUIRE(r == complex{4, 6});
+
+    ptr = b.im().get_mpfr_t()->_mpfr_d;
+    r = -std::move(b);
+    REQUIRE(r.im().get_mpfr_t()->_mpfr_d == ptr);
+    REQUIRE(r == complex{-3, -4});
+
+    // A lower-precision rvalue cannot be re-used.
+    complex c{1, 2, complex_prec_t(30)};
+    ptr = c.re().get_mpfr_t()->_mpfr_d;
+    r = std::move(c) + complex{1, 1, complex_prec_t(600)};
+    REQUIRE(r.get_prec() == 600);
+    REQUIRE(r.re().get_mpfr_t()->_mpfr_d != ptr);
+
+    // Ternary forms steal from rvalues when the return value
+    // does not have enough precision.
+    complex rop{0, complex_prec_t(10)};
+    complex d{5, 6, complex_prec_t(600)};
+    ptr = d.re().get_mpfr_t()->_mpfr_d;
+    add(rop, std::move(d), complex{1, 1});
+    REQUIRE(rop.get_prec() == 600);
+    REQUIRE(rop.re().get_mpfr_t()->_mpfr_d == ptr);
+    REQUIRE(rop == complex{6, 7});
+}
+
+TEST_CASE("complex arena")
+{
+    // The thread-local buffers of the operations must not end up with
+    // storage from an arena, nor hand their own storage to the return value.
+    for (::mpfr_prec_t p : {53, 600}) {
+        const complex a{real_pi(p), sqrt(real{2, p}), complex_prec_t(p)},
+            b{real{1, p} / -3, exp(real{1, p}), complex_prec_t(p)};
+        const auto ref_mul = a * b, ref_div = a / b, ref_mul_add = mul_add(a, b, a), ref_sqr = sqr(a),
+                   ref_sqrt = sqrt(a), ref_exp = exp(a), ref_log = log(a);
+
+        complex r1, r2, r3, r4, r5, r6, r7;
+        {
+            arena_scope as;
+
+            const complex aa{a}, ba{b};
+            complex rop;
+            REQUIRE(mul(rop, aa, ba) == ref_mul);
+            REQUIRE(div(rop, aa, ba) == ref_div);
+            REQUIRE(mul_add(rop, aa, ba, aa) == ref_mul_add);
+            REQUIRE(sqr(aa) == ref_sqr);
+            REQUIRE(sqrt(aa) == ref_sqrt);
+            REQUIRE(exp(aa) == ref_exp);
+            REQUIRE(log(aa) == ref_log);
+            complex c{aa};
+            REQUIRE(c.sqr() == ref_sqr);
+            c = aa;
+            REQUIRE(c.log() == ref_log);
+
+            // Results written into objects which outlive the scope.
+            mul(r1, aa, ba);
+            div(r2, aa, ba);
+            mul_add(r3, aa, ba, aa);
+            r4 = aa;
+            r4.sqr();
+            r5 = aa;
+            r5.sqrt();
+            r6 = aa;
+            r6.exp();
+            r7 = aa;
+            r7.log();
+        }
+
+        REQUIRE(r1 == ref_mul);
+        REQUIRE(r2 == ref_div);
+        REQUIRE(r3 == ref_mul_add);
+        REQUIRE(r4 == ref_sqr);
+        REQUIRE(r5 == ref_sqrt);
+        REQUIRE(r6 == ref_exp);
+        REQUIRE(r7 == ref_log);
+
+        // The thread-local buffers are still usable after the arena is gone.
+        REQUIRE(a * b == ref_mul);
+        REQUIRE(a / b == ref_div);
+        REQUIRE(mul_add(a, b, a) == ref_mul_add);
+        REQUIRE(sqr(a) == ref_sqr);
+        REQUIRE(sqrt(a) == ref_sqrt);
+        REQUIRE(exp(a) == ref_exp);
+        REQUIRE(log(a) == ref_log);
+    }
+}
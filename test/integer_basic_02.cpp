@@ -9,6 +9,7 @@
 #include <mp++/config.hpp>
 
 #include <atomic>
+#include <cctype>
 #include <cmath>
 #include <complex>
 #include <cstddef>
@@ -22,6 +23,7 @@
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #if defined(MPPP_HAVE_STRING_VIEW)
 #include <string_view>
@@ -445,6 +447,53 @@ struct to_string_tester {
                    == "Invalid base for string conversion: the base must be between "
                       "2 and 62, but a value of 63 was provided instead";
         });
+        // Random round trips in all bases, checked against GMP.
+        detail::mpz_raii m, m2;
+        std::uniform_int_distribution<unsigned> ldist(0, S::value + 2u), bdist(2, 62);
+        std::uniform_int_distribution<int> sdist(0, 1);
+        std::vector<char> buffer;
+        for (int i = 0; i < ntries; ++i) {
+            random_integer(m, ldist(rng), rng);
+            if (sdist(rng)) {
+                ::mpz_neg(&m.m_mpz, &m.m_mpz);
+            }
+            const auto base = static_cast<int>(bdist(rng));
+            buffer.resize(::mpz_sizeinbase(&m.m_mpz, base) + 2u);
+            ::mpz_get_str(buffer.data(), base, &m.m_mpz);
+            const std::string ref(buffer.data());
+            const integer n{&m.m_mpz};
+            REQUIRE(n.to_string(base) == ref);
+            REQUIRE(integer{ref, base} == n);
+            if (ref[0] != '-') {
+                REQUIRE(integer{"-" + ref, base} == -n);
+                // Leading zeroes.
+                REQUIRE(integer{"000" + ref, base} == n);
+            }
+            if (base == 10) {
+                REQUIRE(integer{ref, 0} == n);
+            }
+            if (base <= 36) {
+                std::string up(ref);
+                for (auto &c : up) {
+                    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+                }
+                REQUIRE(integer{up, base} == n);
+            }
+            // Values which fit in two limbs.
+            random_integer(m2, 2, rng);
+            buffer.resize(::mpz_sizeinbase(&m2.m_mpz, base) + 2u);
+            ::mpz_get_str(buffer.data(), base, &m2.m_mpz);
+            REQUIRE(integer{&m2.m_mpz}.to_string(base) == buffer.data());
+            REQUIRE(integer{buffer.data(), base} == integer{&m2.m_mpz});
+        }
+        // Invalid strings are still rejected.
+        REQUIRE_THROWS_AS((integer{"-", 10}), std::invalid_argument);
+        REQUIRE_THROWS_AS((integer{"", 10}), std::invalid_argument);
+        REQUIRE_THROWS_AS((integer{"12a", 10}), std::invalid_argument);
+        REQUIRE_THROWS_AS((integer{"z", 35}), std::invalid_argument);
+        REQUIRE(integer{" 1 2 ", 10} == 12);
+        REQUIRE(integer{"0x1f", 0} == 31);
+        REQUIRE(integer{"Zz", 62} == 35 * 62 + 61);
     }
 };
 
@@ -453,6 +502,53 @@ TEST_CASE("to_string")
     tuple_for_each(sizes{}, to_string_tester{});
 }
 
+TEST_CASE("large string conversions")
+{
+    // The conversions are serial by default.
+    REQUIRE(get_integer_str_nthreads() == 1u);
+    set_integer_str_nthreads(3);
+    REQUIRE(get_integer_str_nthreads() == 3u);
+
+    // Values large enough to trigger the parallel conversion routines.
+    detail::mpz_raii m, m2;
+    std::vector<char> buffer;
+    for (unsigned nthreads : {1u, 0u, 1000u}) {
+        set_integer_str_nthreads(nthreads);
+        for (int base : {2, 10, 16, 37, 62}) {
+            for (unsigned nl : {9000u, 25000u, 40000u}) {
+                random_integer(m, nl, rng);
+                if (base == 16) {
+                    ::mpz_neg(&m.m_mpz, &m.m_mpz);
+                }
+                buffer.resize(::mpz_sizeinbase(&m.m_mpz, base) + 2u);
+                ::mpz_get_str(buffer.data(), base, &m.m_mpz);
+                const integer<1> n{&m.m_mpz};
+                const auto str = n.to_string(base);
+                REQUIRE(str == buffer.data());
+                REQUIRE(integer<1>{str, base} == n);
+                // Values with zero digits in the middle of the representation.
+                ::mpz_ui_pow_ui(&m2.m_mpz, static_cast<unsigned long>(base), nl * 10u);
+                ::mpz_add_ui(&m2.m_mpz, &m2.m_mpz, 1u);
+                const integer<1> n2{&m2.m_mpz};
+                const auto str2 = n2.to_string(base);
+                REQUIRE(str2.size() == nl * 10u + 1u);
+                REQUIRE(str2.front() == '1');
+                REQUIRE(str2.back() == '1');
+                REQUIRE(str2.find_first_not_of('0', 1) == str2.size() - 1u);
+                REQUIRE(integer<1>{str2, base} == n2);
+            }
+        }
+    }
+    // Invalid characters in long strings.
+    set_integer_str_nthreads(0);
+    std::string str(300000u, '1');
+    str[150000] = ' ';
+    REQUIRE(integer<1>{str, 10} == integer<1>{str.substr(0, 150000) + str.substr(150001), 10});
+    str[150000] = 'x';
+    REQUIRE_THROWS_AS((integer<1>{str, 10}), std::invalid_argument);
+    set_integer_str_nthreads(1);
+}
+
 struct stream_tester {
     template <typename S>
     void operator()(const S &) const
@@ -0,0 +1,138 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace mppp;
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
+                         std::integral_constant<std::size_t, 10>>;
+
+static int ntries = 1000;
+
+static std::mt19937 rng;
+
+struct batch_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+
+        // Empty ranges.
+        integer *null_rop = nullptr;
+        const integer *null_op = nullptr;
+        batch::add(null_rop, null_op, null_op, 0);
+        batch::sub(null_rop, null_op, null_op, 0);
+        batch::mul(null_rop, null_op, null_op, 0);
+        batch::addmul(null_rop, null_op, null_op, 0);
+        batch::submul(null_rop, null_op, null_op, 0);
+
+        // Random testing against the scalar functions.
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1);
+        std::uniform_int_distribution<unsigned> ldist(0, S::value + 1u);
+        auto random_int = [&]() {
+            random_integer(tmp, ldist(rng), rng);
+            integer retval{&tmp.m_mpz};
+            if (sdist(rng)) {
+                retval.neg();
+            }
+            if (retval.is_static() && sdist(rng)) {
+                // Promote sometimes, if possible.
+                retval.promote();
+            }
+            return retval;
+        };
+
+        std::vector<integer> v1, v2, v3, v4;
+        for (int i = 0; i < ntries; ++i) {
+            v1.push_back(random_int());
+            v2.push_back(random_int());
+            v3.push_back(random_int());
+        }
+        const auto n = v1.size();
+
+        v4 = v3;
+        batch::add(v4.data(), v1.data(), v2.data(), n);
+        for (decltype(v1.size()) i = 0; i < n; ++i) {
+            REQUIRE(v4[i] == v1[i] + v2[i]);
+        }
+
+        v4 = v3;
+        batch::sub(v4.data(), v1.data(), v2.data(), n);
+        for (decltype(v1.size()) i = 0; i < n; ++i) {
+            REQUIRE(v4[i] == v1[i] - v2[i]);
+        }
+
+        v4 = v3;
+        batch::mul(v4.data(), v1.data(), v2.data(), n);
+        for (decltype(v1.size()) i = 0; i < n; ++i) {
+            REQUIRE(v4[i] == v1[i] * v2[i]);
+        }
+
+        v4 = v3;
+        batch::addmul(v4.data(), v1.data(), v2.data(), n);
+        for (decltype(v1.size()) i = 0; i < n; ++i) {
+            REQUIRE(v4[i] == v3[i] + v1[i] * v2[i]);
+        }
+
+        v4 = v3;
+        batch::submul(v4.data(), v1.data(), v2.data(), n);
+        for (decltype(v1.size()) i = 0; i < n; ++i) {
+            REQUIRE(v4[i] == v3[i] - v1[i] * v2[i]);
+        }
+
+        // Coinciding ranges.
+        v4 = v1;
+        batch::add(v4.data(), v4.data(), v2.data(), n);
+        for (decltype(v1.size()) i = 0; i < n; ++i) {
+            REQUIRE(v4[i] == v1[i] + v2[i]);
+        }
+
+        v4 = v1;
+        batch::sub(v4.data(), v2.data(), v4.data(), n);
+        for (decltype(v1.size()) i = 0; i < n; ++i) {
+            REQUIRE(v4[i] == v2[i] - v1[i]);
+        }
+
+        v4 = v1;
+        batch::mul(v4.data(), v4.data(), v4.data(), n);
+        for (decltype(v1.size()) i = 0; i < n; ++i) {
+            REQUIRE(v4[i] == v1[i] * v1[i]);
+        }
+
+        v4 = v1;
+        batch::addmul(v4.data(), v4.data(), v2.data(), n);
+        for (decltype(v1.size()) i = 0; i < n; ++i) {
+            REQUIRE(v4[i] == v1[i] + v1[i] * v2[i]);
+        }
+
+        v4 = v1;
+        batch::submul(v4.data(), v2.data(), v4.data(), n);
+        for (decltype(v1.size()) i = 0; i < n; ++i) {
+            REQUIRE(v4[i] == v1[i] - v2[i] * v1[i]);
+        }
+    }
+};
+
+TEST_CASE("batch")
+{
+    tuple_for_each(sizes{}, batch_tester{});
+}
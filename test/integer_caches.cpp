@@ -9,9 +9,12 @@
 #include <atomic>
 #include <cstddef>
 #include <random>
+#include <stdexcept>
+#include <string>
 #include <thread>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <mp++/config.hpp>
@@ -117,3 +120,183 @@ TEST_CASE("caches")
 {
     tuple_for_each(sizes{}, cache_tester{});
 }
+
+TEST_CASE("cache size classes")
+{
+    // Arrays whose sizes fall between the exact size classes
+    // and the first geometric size class.
+    void *(*afp)(std::size_t) = nullptr;
+    ::mp_get_memory_functions(&afp, nullptr, nullptr);
+    auto alloc_limbs = [afp](std::size_t n) { return static_cast<::mp_limb_t *>(afp(n * sizeof(::mp_limb_t))); };
+
+    detail::mpz_alloc_cache c;
+    c.max_size = 32u;
+    std::size_t expected_nbytes = 0;
+    for (std::size_t n = 16; n <= 20u; ++n) {
+        const auto ptr = alloc_limbs(n);
+        if (c.put(ptr, n)) {
+            expected_nbytes += n * sizeof(::mp_limb_t);
+        } else {
+            void (*ffp)(void *, std::size_t) = nullptr;
+            ::mp_get_memory_functions(nullptr, nullptr, &ffp);
+            ffp(ptr, n * sizeof(::mp_limb_t));
+        }
+        REQUIRE(c.nbytes == expected_nbytes);
+    }
+    // The 16 and 20-limb arrays are cached, the others are evicted.
+    REQUIRE(expected_nbytes == 36u * sizeof(::mp_limb_t));
+    REQUIRE(c.evictions == 3u);
+
+    // Fetch arrays of 16-19 limbs: a 16-limb request gets exactly 16 limbs,
+    // the others get the 20-limb array (or nothing, once it has been taken).
+    std::vector<std::pair<::mp_limb_t *, std::size_t>> fetched;
+    for (std::size_t n = 16; n <= 19u; ++n) {
+        std::size_t alloc = 0;
+        if (const auto ptr = c.get(n, alloc)) {
+            REQUIRE(alloc >= n);
+            REQUIRE((n == 16u ? alloc == 16u : alloc == 20u));
+            expected_nbytes -= alloc * sizeof(::mp_limb_t);
+            fetched.emplace_back(ptr, alloc);
+        }
+        REQUIRE(c.nbytes == expected_nbytes);
+    }
+    REQUIRE(fetched.size() == 2u);
+    REQUIRE(c.nbytes == 0u);
+
+    // Put them back in reverse order, and let the destructor
+    // free them with the correct sizes.
+    for (auto it = fetched.rbegin(); it != fetched.rend(); ++it) {
+        REQUIRE(c.put(it->first, it->second));
+    }
+    REQUIRE(c.nbytes == 36u * sizeof(::mp_limb_t));
+}
+
+TEST_CASE("cache limits and stats")
+{
+    using integer = integer<1>;
+    auto run = []() {
+        // Invalid limits.
+        REQUIRE_THROWS_PREDICATE(set_integer_cache_limits(8193u, 10u), std::invalid_argument,
+                                 [](const std::invalid_argument &ex) {
+                                     return std::string(ex.what())
+                                            == "Cannot set the maximum size of the cached integer limb arrays to "
+                                               "8193: the maximum allowed value is 8192";
+                                 });
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+        // Default values.
+        REQUIRE(get_integer_cache_limits().first == 10u);
+        REQUIRE(get_integer_cache_limits().second == 100u);
+        free_integer_caches();
+        reset_integer_cache_stats();
+        auto st = get_integer_cache_stats();
+        REQUIRE(st.hits == 0u);
+        REQUIRE(st.misses == 0u);
+        REQUIRE(st.evictions == 0u);
+        REQUIRE(st.nbytes == 0u);
+
+        // Large integers are not cached with the default settings.
+        integer n{1};
+        n <<= 100u * GMP_NUMB_BITS;
+        {
+            integer tmp{n};
+        }
+        st = get_integer_cache_stats();
+        REQUIRE(st.misses > 0u);
+        REQUIRE(st.evictions > 0u);
+        REQUIRE(st.nbytes == 0u);
+
+        // Increase the limits and check the cache is used.
+        set_integer_cache_limits(4096u, 2u);
+        REQUIRE(get_integer_cache_limits().first == 4096u);
+        REQUIRE(get_integer_cache_limits().second == 2u);
+        reset_integer_cache_stats();
+        {
+            integer tmp{n};
+        }
+        st = get_integer_cache_stats();
+        REQUIRE(st.hits == 0u);
+        REQUIRE(st.misses == 1u);
+        REQUIRE(st.evictions == 0u);
+        REQUIRE(st.nbytes >= 101u * sizeof(::mp_limb_t));
+        {
+            integer tmp{n};
+            REQUIRE(tmp == n);
+        }
+        st = get_integer_cache_stats();
+        REQUIRE(st.hits == 1u);
+        REQUIRE(st.misses == 1u);
+        REQUIRE(st.evictions == 0u);
+
+        // Fill up a size class.
+        {
+            std::vector<integer> v(5u, n);
+        }
+        st = get_integer_cache_stats();
+        REQUIRE(st.evictions == 3u);
+
+        // Arrays of various sizes.
+        for (unsigned i = 1; i < 4096u; i = i * 3u + 1u) {
+            integer m{1};
+            m <<= (i - 1u) * GMP_NUMB_BITS;
+            m.promote();
+            integer m2{m}, m3{m};
+            REQUIRE(m2 == m);
+            REQUIRE(m3 == m);
+        }
+        const auto nbytes = get_integer_cache_stats().nbytes;
+        REQUIRE(nbytes > 0u);
+
+        // Reuse of cached arrays of various sizes.
+        reset_integer_cache_stats();
+        for (unsigned i = 1; i < 4096u; i = i * 3u + 1u) {
+            integer m{1};
+            m <<= (i - 1u) * GMP_NUMB_BITS;
+            m.promote();
+            integer m2{m};
+            REQUIRE(m2 == m);
+        }
+        REQUIRE(get_integer_cache_stats().hits > 0u);
+
+        // Trimming.
+        trim_integer_caches(nbytes);
+        REQUIRE(get_integer_cache_stats().nbytes <= nbytes);
+        trim_integer_caches(nbytes / 2u);
+        REQUIRE(get_integer_cache_stats().nbytes <= nbytes / 2u);
+        REQUIRE(get_integer_cache_stats().nbytes > 0u);
+
+        // Lowering the limits flushes the arrays in excess.
+        set_integer_cache_limits(20u, 1u);
+        REQUIRE(get_integer_cache_stats().nbytes <= 16u * 20u * sizeof(::mp_limb_t));
+        for (const auto s : detail::get_thread_local_mpz_cache().sizes) {
+            REQUIRE(s <= 1u);
+        }
+        set_integer_cache_limits(0u, 100u);
+        REQUIRE(get_integer_cache_stats().nbytes == 0u);
+        trim_integer_caches(0);
+
+        // Restore the defaults.
+        set_integer_cache_limits(10u, 100u);
+        {
+            integer tmp{n};
+            tmp.promote();
+            integer tmp2{1};
+            tmp2.promote();
+        }
+        REQUIRE(get_integer_cache_stats().nbytes > 0u);
+        free_integer_caches();
+        REQUIRE(get_integer_cache_stats().nbytes == 0u);
+#else
+        set_integer_cache_limits(20u, 10u);
+        REQUIRE(get_integer_cache_limits().first == 0u);
+        REQUIRE(get_integer_cache_limits().second == 0u);
+        trim_integer_caches(0);
+        reset_integer_cache_stats();
+        REQUIRE(get_integer_cache_stats().nbytes == 0u);
+#endif
+    };
+
+    // Run in the main thread and in a separate thread.
+    run();
+    std::thread t(run);
+    t.join();
+}
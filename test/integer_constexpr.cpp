@@ -0,0 +1,187 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <mp++/config.hpp>
+
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace mppp;
+using namespace mppp_test;
+
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+
+static int ntries = 1000;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
+                         std::integral_constant<std::size_t, 10>>;
+
+static std::mt19937 rng;
+
+// Construction, arithmetic and comparison in constant expressions.
+static_assert(integer<1>{}.is_zero());
+static_assert(integer<1>{-42}.sgn() == -1);
+static_assert(integer<2>{42} == 42);
+static_assert(integer<3>{-42} != 42);
+static_assert(-integer<1>{42} == -42);
+static_assert(integer<1>{40} + 2 == 42);
+static_assert(2 - integer<2>{44} == -42);
+static_assert(integer<3>{-6} * 7 == -42);
+static_assert(integer<1>{-6} < integer<1>{-5});
+static_assert(integer<2>{6} >= 6u);
+static_assert(cmp(integer<3>{5}, integer<3>{-7}) > 0);
+
+// Multi-limb values.
+static_assert(integer<2>{GMP_NUMB_MAX} * integer<2>{GMP_NUMB_MAX} > integer<2>{GMP_NUMB_MAX});
+static_assert(integer<2>{GMP_NUMB_MAX} * GMP_NUMB_MAX - GMP_NUMB_MAX * integer<2>{GMP_NUMB_MAX} == 0);
+static_assert(integer<3>{-1} * GMP_NUMB_MAX * GMP_NUMB_MAX * GMP_NUMB_MAX + 1 < 0);
+
+// Literals.
+static_assert(42_z1 == 42);
+static_assert(-0x123456789abcdef012345_z3 == -(integer<3>{0x123456789abcdef0ull} * (1ul << 20) + 0x12345));
+static_assert(79228162514264337593543950335_z3 - 1 == 79228162514264337593543950334_z3);
+
+// A compile-time table of binomial coefficients.
+template <std::size_t N>
+struct binomial_table {
+    constexpr binomial_table()
+    {
+        for (std::size_t n = 0; n < N; ++n) {
+            m_table[n][0] = 1;
+            for (std::size_t k = 1; k <= n; ++k) {
+                m_table[n][k] = m_table[n - 1u][k - 1u] + m_table[n - 1u][k];
+            }
+        }
+    }
+    integer<3> m_table[N][N];
+};
+
+constexpr binomial_table<100> ct_bin;
+
+static_assert(ct_bin.m_table[4][2] == 6);
+static_assert(ct_bin.m_table[99][49] == 50445672272782096667406248628_z3);
+
+struct constexpr_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+
+        // Random testing of the static primitives used during constant evaluation
+        // against the runtime implementation.
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1);
+        auto random_xy = [&](unsigned x) {
+            random_integer(tmp, x, rng);
+            integer n{&tmp.m_mpz};
+            if (sdist(rng)) {
+                n.neg();
+            }
+            return n;
+        };
+
+        for (unsigned x = 0; x <= S::value; ++x) {
+            for (unsigned y = 0; y <= S::value; ++y) {
+                for (int i = 0; i < ntries; ++i) {
+                    const auto a = random_xy(x), b = random_xy(y);
+                    if (!a.is_static() || !b.is_static()) {
+                        continue;
+                    }
+
+                    REQUIRE(detail::sgn(cmp(a, b)) == detail::sgn(cmp_ct(a, b)));
+
+                    integer r;
+                    try {
+                        r = addsub_ct<true>(a, b);
+                        REQUIRE(r == a + b);
+                    } catch (const std::overflow_error &) {
+                        REQUIRE((a + b).size() > S::value);
+                    }
+                    try {
+                        r = addsub_ct<false>(a, b);
+                        REQUIRE(r == a - b);
+                    } catch (const std::overflow_error &) {
+                        REQUIRE((a - b).size() > S::value);
+                    }
+                    try {
+                        r = mul_ct(a, b);
+                        REQUIRE(r == a * b);
+                        REQUIRE(r.sgn() == (a * b).sgn());
+                    } catch (const std::overflow_error &) {
+                        REQUIRE((a * b).size() > S::value);
+                    }
+
+                    // Overlapping arguments.
+                    auto c(a);
+                    try {
+                        c = mul_ct(c, c);
+                        REQUIRE(c == a * a);
+                    } catch (const std::overflow_error &) {
+                        REQUIRE((a * a).size() > S::value);
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename Int>
+    static int cmp_ct(const Int &a, const Int &b)
+    {
+        return detail::constexpr_static_cmp(a._get_union().g_st(), b._get_union().g_st());
+    }
+    template <bool AddOrSub, typename Int>
+    static Int addsub_ct(const Int &a, const Int &b)
+    {
+        Int retval;
+        detail::constexpr_static_addsub<AddOrSub>(retval._get_union().g_st(), a._get_union().g_st(),
+                                                  b._get_union().g_st());
+        return retval;
+    }
+    template <typename Int>
+    static Int mul_ct(const Int &a, const Int &b)
+    {
+        Int retval;
+        detail::constexpr_static_mul(retval._get_union().g_st(), a._get_union().g_st(), b._get_union().g_st());
+        return retval;
+    }
+};
+
+#endif
+
+TEST_CASE("integer constexpr")
+{
+#if defined(MPPP_HAVE_CONSTEXPR_INTEGER)
+    // Check the table computed at compile time.
+    for (unsigned long n = 0; n < 100u; ++n) {
+        for (unsigned long k = 0; k <= n; ++k) {
+            REQUIRE(ct_bin.m_table[n][k] == binomial(integer<3>{n}, k));
+        }
+    }
+
+    tuple_for_each(sizes{}, constexpr_tester{});
+
+    // Overflow detection in the constexpr primitives.
+    REQUIRE_THROWS_PREDICATE(
+        constexpr_tester::mul_ct(integer<1>{GMP_NUMB_MAX}, integer<1>{GMP_NUMB_MAX}), std::overflow_error,
+        [](const std::overflow_error &ex) {
+            return std::string(ex.what())
+                   == "The result of a constant-evaluated integer operation does not fit in 1 static limb(s)";
+        });
+#endif
+}
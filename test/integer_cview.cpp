@@ -0,0 +1,257 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/integer_cview.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace mppp;
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
+                         std::integral_constant<std::size_t, 10>>;
+
+static int ntries = 1000;
+
+static std::mt19937 rng;
+
+struct cview_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1);
+        std::uniform_int_distribution<unsigned> ldist(0, S::value * 2u + 1u);
+        auto random_int = [&]() {
+            random_integer(tmp, ldist(rng), rng);
+            integer retval{&tmp.m_mpz};
+            if (sdist(rng)) {
+                retval.neg();
+            }
+            if (sdist(rng)) {
+                retval.promote();
+            }
+            return retval;
+        };
+
+        // Views on integers.
+        for (int i = 0; i < ntries; ++i) {
+            const auto n = random_int(), m = random_int();
+            const integer_cview vn{n}, vm{m};
+            REQUIRE(vn == n);
+            REQUIRE(n == vn);
+            REQUIRE(vn.size() == n.size());
+            REQUIRE(vn.sgn() == n.sgn());
+            REQUIRE(vn.is_zero() == n.is_zero());
+            REQUIRE(vn.nbits() == n.nbits());
+            REQUIRE(::mpz_cmp(vn.get_mpz_view(), n.get_mpz_view()) == 0);
+            REQUIRE(hash(vn) == hash(n));
+            REQUIRE(std::hash<integer_cview>{}(vn) == std::hash<integer>{}(n));
+            REQUIRE(vn.to_string(16) == n.to_string(16));
+            REQUIRE(static_cast<integer>(vn) == n);
+            REQUIRE(static_cast<mppp::integer<1>>(vn) == vn);
+
+            REQUIRE((vn == vm) == (n == m));
+            REQUIRE((vn != vm) == (n != m));
+            REQUIRE((vn < vm) == (n < m));
+            REQUIRE((vn <= m) == (n <= m));
+            REQUIRE((n > vm) == (n > m));
+            REQUIRE((vn >= vm) == (n >= m));
+
+            // Conversions.
+            long long ll;
+            if (n.get(ll)) {
+                REQUIRE(static_cast<long long>(vn) == ll);
+                REQUIRE(vn == ll);
+                REQUIRE(ll == vn);
+                REQUIRE(vn <= ll);
+                REQUIRE(!(vn < ll));
+            } else {
+                REQUIRE_THROWS_AS(static_cast<long long>(vn), std::overflow_error);
+            }
+            REQUIRE(static_cast<double>(vn) == static_cast<double>(n));
+            REQUIRE(static_cast<bool>(vn) == !n.is_zero());
+        }
+    }
+};
+
+TEST_CASE("integer_cview")
+{
+    tuple_for_each(sizes{}, cview_tester{});
+
+    // Default construction.
+    integer_cview v;
+    REQUIRE(v.is_zero());
+    REQUIRE(v.size() == 0u);
+    REQUIRE(v.nbits() == 0u);
+    REQUIRE(v.sgn() == 0);
+    REQUIRE(v.to_string() == "0");
+    REQUIRE(v == 0);
+    REQUIRE(v == integer<1>{});
+    REQUIRE(hash(v) == hash(integer<1>{}));
+    REQUIRE(static_cast<int>(v) == 0);
+    REQUIRE(static_cast<double>(v) == 0.);
+
+    // Construction from limbs.
+    const ::mp_limb_t arr[] = {5u, 6u, 0u};
+    v = integer_cview{arr, 2};
+    REQUIRE(v == integer<1>{arr, 2});
+    REQUIRE(v.data() == arr);
+    v = integer_cview{arr, -1};
+    REQUIRE(v == -5);
+    REQUIRE(v.to_string() == "-5");
+    REQUIRE(static_cast<short>(v) == -5);
+    v = integer_cview{nullptr, 0};
+    REQUIRE(v.is_zero());
+    REQUIRE_THROWS_PREDICATE((integer_cview{arr, -3}), std::invalid_argument, [](const std::invalid_argument &ex) {
+        return std::string(ex.what())
+               == "Invalid data detected in the construction of an integer_cview: the most "
+                  "significant limb of the value cannot be zero";
+    });
+
+    // Large values.
+    const auto big = -(integer<1>{1} << 1000) + 1;
+    v = integer_cview{big};
+    REQUIRE(v < 0);
+    REQUIRE(v < std::numeric_limits<long long>::min());
+    REQUIRE(std::numeric_limits<unsigned long long>::max() > v);
+    REQUIRE(static_cast<bool>(v));
+    REQUIRE(static_cast<double>(v) == static_cast<double>(big));
+    REQUIRE_THROWS_PREDICATE(static_cast<int>(v), std::overflow_error, [&big](const std::overflow_error &ex) {
+        return std::string(ex.what())
+               == "The conversion of the integer " + big.to_string() + " to the type 'int' results in overflow";
+    });
+    std::ostringstream oss1, oss2;
+    oss1 << std::hex << std::showbase << v;
+    oss2 << std::hex << std::showbase << big;
+    REQUIRE(oss1.str() == oss2.str());
+    REQUIRE_THROWS_AS(v.to_string(1), std::invalid_argument);
+
+    // Unordered containers.
+    std::unordered_set<integer_cview> us{integer_cview{arr, 1}, integer_cview{big}};
+    REQUIRE(us.count(integer_cview{arr, 1}) == 1u);
+    REQUIRE(us.count(integer_cview{arr, 2}) == 0u);
+}
+
+TEST_CASE("integer_cview binary_load")
+{
+    // Write a table of serialised integers back-to-back into a limb-aligned buffer.
+    detail::mpz_raii tmp;
+    std::uniform_int_distribution<unsigned> ldist(0, 20);
+    std::uniform_int_distribution<int> sdist(0, 1);
+    std::vector<integer<2>> values;
+    std::vector<std::size_t> offsets;
+    std::vector<::mp_limb_t> storage;
+    std::size_t off = 0;
+    for (int i = 0; i < ntries; ++i) {
+        random_integer(tmp, ldist(rng), rng);
+        values.emplace_back(&tmp.m_mpz);
+        if (sdist(rng)) {
+            values.back().neg();
+        }
+        offsets.push_back(off);
+        off += integer_cview::binary_size_aligned(off, values.back());
+    }
+    storage.resize(off / sizeof(::mp_limb_t) + 1u);
+    auto buffer = reinterpret_cast<char *>(storage.data());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(integer_cview::binary_save_aligned(buffer + offsets[i], values[i])
+                == (i + 1u < values.size() ? offsets[i + 1u] : off) - offsets[i]);
+    }
+
+    integer_cview v;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const auto size = (i + 1u < values.size() ? offsets[i + 1u] : off) - offsets[i];
+        REQUIRE(v.binary_load_aligned(buffer + offsets[i]) == size);
+        REQUIRE(v == values[i]);
+        // The view points into the buffer.
+        const auto pad = size - values[i].binary_size();
+        REQUIRE(pad < alignof(::mp_limb_t));
+        if (!v.is_zero()) {
+            REQUIRE(reinterpret_cast<const char *>(v.data())
+                    == buffer + offsets[i] + pad + sizeof(detail::mpz_size_t));
+        }
+        REQUIRE(v.binary_load_aligned(buffer + offsets[i], off - offsets[i]) == size);
+        REQUIRE(v == values[i]);
+        // The padded entries are regular serialised integers.
+        REQUIRE(v.binary_load(buffer + offsets[i] + pad) == values[i].binary_size());
+        REQUIRE(v == values[i]);
+        integer<2> tmp_n;
+        REQUIRE(tmp_n.binary_load(buffer + offsets[i] + pad) == values[i].binary_size());
+        REQUIRE(tmp_n == values[i]);
+    }
+
+    // Error handling.
+    const auto n = integer<1>{1} << 100;
+    std::vector<::mp_limb_t> st(10u);
+    buffer = reinterpret_cast<char *>(st.data());
+    const auto pad = integer_cview::binary_size_aligned(0, n) - n.binary_size();
+    n.binary_save(buffer + pad);
+    REQUIRE_THROWS_PREDICATE(v.binary_load(buffer + pad, n.binary_size() - 1u), std::invalid_argument,
+                             [&n](const std::invalid_argument &ex) {
+                                 return std::string(ex.what())
+                                        == "Invalid buffer size in the construction of an integer_cview: the number "
+                                           "of limbs stored in the buffer (1) is less than the integer size in limbs "
+                                           "stored in the header ("
+                                               + std::to_string(n.size()) + ")";
+                             });
+    REQUIRE_THROWS_PREDICATE(v.binary_load(buffer + pad, 1), std::invalid_argument,
+                             [](const std::invalid_argument &ex) {
+                                 return std::string(ex.what())
+                                        == "Invalid buffer size in the construction of an integer_cview: the buffer "
+                                           "size must be at least "
+                                               + std::to_string(sizeof(detail::mpz_size_t))
+                                               + " bytes, but it is only 1 bytes";
+                             });
+    if (alignof(::mp_limb_t) > 1u) {
+        n.binary_save(buffer + pad + 1);
+        REQUIRE_THROWS_PREDICATE(v.binary_load(buffer + pad + 1), std::invalid_argument,
+                                 [](const std::invalid_argument &ex) {
+                                     return std::string(ex.what())
+                                            == "Cannot construct an integer_cview from a serialised integer whose "
+                                               "limbs are not aligned to a multiple of "
+                                                   + std::to_string(alignof(::mp_limb_t)) + " bytes";
+                                 });
+    }
+    if (pad > 0u) {
+        REQUIRE_THROWS_PREDICATE(v.binary_load_aligned(buffer, pad - 1u), std::invalid_argument,
+                                 [pad](const std::invalid_argument &ex) {
+                                     return std::string(ex.what())
+                                            == "Invalid buffer size in the construction of an integer_cview: the "
+                                               "buffer size ("
+                                                   + std::to_string(pad - 1u)
+                                                   + ") is less than the alignment padding ("
+                                                   + std::to_string(pad) + ")";
+                                 });
+    }
+    REQUIRE_THROWS_AS(v.binary_load_aligned(buffer, pad + 1u), std::invalid_argument);
+    // Zero most significant limb.
+    integer<1>{1}.binary_save(buffer + pad);
+    std::fill(buffer + pad + sizeof(detail::mpz_size_t),
+              buffer + pad + sizeof(detail::mpz_size_t) + sizeof(::mp_limb_t), 0);
+    REQUIRE_THROWS_AS(v.binary_load(buffer + pad), std::invalid_argument);
+}
@@ -0,0 +1,104 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <list>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace mppp;
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
+                         std::integral_constant<std::size_t, 10>>;
+
+static int ntries = 1000;
+
+static std::mt19937 rng;
+
+struct dot_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+
+        // Empty ranges.
+        std::vector<integer> v1, v2;
+        REQUIRE(dot(v1.begin(), v1.end(), v2.begin(), integer{}).is_zero());
+        REQUIRE(dot(v1.begin(), v1.end(), v2.begin(), integer{-42}) == -42);
+
+        // Simple checks.
+        v1 = {integer{1}, integer{-2}, integer{3}};
+        v2 = {integer{4}, integer{5}, integer{-6}};
+        REQUIRE(dot(v1.begin(), v1.end(), v2.begin(), integer{}) == -24);
+        REQUIRE(dot(v1.begin(), v1.end(), v2.begin(), integer{24}).is_zero());
+        REQUIRE(dot(v1.cbegin(), v1.cend(), v2.cbegin(), integer{1}) == -23);
+        // Non-random-access iterators.
+        std::list<integer> l(v2.begin(), v2.end());
+        REQUIRE(dot(v1.begin(), v1.end(), l.begin(), integer{}) == -24);
+
+        // Products spilling over into the higher limbs of the accumulator.
+        v1.assign(100, integer{GMP_NUMB_MAX});
+        v2.assign(100, integer{GMP_NUMB_MAX});
+        integer cmp{GMP_NUMB_MAX};
+        cmp *= cmp;
+        cmp *= 100;
+        REQUIRE(dot(v1.begin(), v1.end(), v2.begin(), integer{}) == cmp);
+        v2.assign(100, -integer{GMP_NUMB_MAX});
+        REQUIRE(dot(v1.begin(), v1.end(), v2.begin(), integer{}) == -cmp);
+        v2[0] = integer{GMP_NUMB_MAX};
+        REQUIRE(dot(v1.begin(), v1.end(), v2.begin(), integer{})
+                == -cmp + 2 * integer{GMP_NUMB_MAX} * integer{GMP_NUMB_MAX});
+
+        // Random testing against addmul().
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1);
+        std::uniform_int_distribution<unsigned> ldist(0, S::value + 1u);
+        auto random_int = [&]() {
+            random_integer(tmp, ldist(rng), rng);
+            integer retval{&tmp.m_mpz};
+            if (sdist(rng)) {
+                retval.neg();
+            }
+            if (retval.is_static() && sdist(rng)) {
+                retval.promote();
+            }
+            return retval;
+        };
+        std::uniform_int_distribution<unsigned> ndist(0, 50);
+        for (int i = 0; i < ntries; ++i) {
+            const auto n = ndist(rng);
+            v1.clear();
+            v2.clear();
+            for (auto j = 0u; j < n; ++j) {
+                v1.push_back(random_int());
+                v2.push_back(random_int());
+            }
+            const auto init = random_int();
+            auto cmp_res = init;
+            for (auto j = 0u; j < n; ++j) {
+                addmul(cmp_res, v1[j], v2[j]);
+            }
+            REQUIRE(dot(v1.begin(), v1.end(), v2.begin(), init) == cmp_res);
+        }
+    }
+};
+
+TEST_CASE("dot")
+{
+    tuple_for_each(sizes{}, dot_tester{});
+}
@@ -0,0 +1,197 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/integer_soa.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace mppp;
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
+                         std::integral_constant<std::size_t, 10>>;
+
+static int ntries = 1000;
+
+static std::mt19937 rng;
+
+struct soa_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        using soa = integer_soa<S::value>;
+
+        // Basic API.
+        soa c;
+        REQUIRE(c.size() == 0u);
+        c = soa(5);
+        REQUIRE(c.size() == 5u);
+        for (std::size_t i = 0; i < c.size(); ++i) {
+            REQUIRE(c.get(i).is_zero());
+            REQUIRE(!c.is_dynamic(i));
+        }
+        c.set(0, integer{42});
+        REQUIRE(c.get(0) == 42);
+        REQUIRE(c.sizes_data()[0] == 1);
+        REQUIRE(c.limbs_data(0)[0] == 42u);
+        c[1] = integer{-7};
+        REQUIRE(static_cast<integer>(c[1]) == -7);
+        REQUIRE(c.sizes_data()[1] == -1);
+        c[2] = c[1];
+        REQUIRE(static_cast<integer>(c[2]) == -7);
+        const auto &cc = c;
+        REQUIRE(cc[2] == -7);
+        // Values which do not fit in the static storage go to the side table.
+        integer big{1};
+        big <<= GMP_NUMB_BITS * S::value;
+        big.neg();
+        c.set(3, big);
+        REQUIRE(c.is_dynamic(3));
+        REQUIRE(c.get(3) == big);
+        for (std::size_t j = 0; j < S::value; ++j) {
+            REQUIRE(c.limbs_data(j)[3] == 0u);
+        }
+        c.set(3, integer{1});
+        REQUIRE(!c.is_dynamic(3));
+        REQUIRE(c.get(3) == 1);
+        // A promoted integer with a small value is stored in the arrays.
+        integer p{3};
+        p.promote();
+        c.set(4, p);
+        REQUIRE(!c.is_dynamic(4));
+        REQUIRE(c.get(4) == 3);
+        c.push_back(big);
+        REQUIRE(c.size() == 6u);
+        REQUIRE(c.is_dynamic(5));
+        REQUIRE(c.get(5) == big);
+        c.resize(5);
+        REQUIRE(c.size() == 5u);
+        c.resize(6);
+        REQUIRE(!c.is_dynamic(5));
+        REQUIRE(c.get(5).is_zero());
+        std::vector<integer> v{integer{1}, big, integer{-3}};
+        soa c2(v.data(), v.data() + v.size());
+        REQUIRE(c2.size() == 3u);
+        REQUIRE(c2.get(0) == 1);
+        REQUIRE(c2.get(1) == big);
+        REQUIRE(c2.is_dynamic(1));
+        REQUIRE(c2.get(2) == -3);
+
+        // Size mismatch.
+        soa out;
+        REQUIRE_THROWS_PREDICATE(add(out, c, c2), std::invalid_argument, [](const std::invalid_argument &ex) {
+            return std::string(ex.what())
+                   == "Cannot perform a bulk operation on integer_soa objects of different sizes (6 vs 3)";
+        });
+        REQUIRE_THROWS_AS(sub(out, c, c2), std::invalid_argument);
+        REQUIRE_THROWS_AS(mul(out, c2, c), std::invalid_argument);
+
+        // Random testing against the scalar functions.
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1);
+        std::uniform_int_distribution<unsigned> ldist(0, S::value + 1u);
+        auto random_int = [&]() {
+            random_integer(tmp, ldist(rng), rng);
+            integer retval{&tmp.m_mpz};
+            if (sdist(rng)) {
+                retval.neg();
+            }
+            return retval;
+        };
+
+        std::vector<integer> v1, v2;
+        for (int i = 0; i < ntries; ++i) {
+            v1.push_back(random_int());
+            v2.push_back(random_int());
+        }
+        const soa a(v1.data(), v1.data() + v1.size()), b(v2.data(), v2.data() + v2.size());
+        const auto n = v1.size();
+        REQUIRE(a.size() == n);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(a.get(i) == v1[i]);
+            REQUIRE(b.get(i) == v2[i]);
+            REQUIRE(a.is_dynamic(i) == (v1[i].size() > S::value));
+        }
+
+        // Start from an output with different size and contents.
+        out = c;
+        REQUIRE(&add(out, a, b) == &out);
+        REQUIRE(out.size() == n);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out.get(i) == v1[i] + v2[i]);
+            REQUIRE(out.is_dynamic(i) == ((v1[i] + v2[i]).size() > S::value));
+        }
+
+        out = c;
+        REQUIRE(&sub(out, a, b) == &out);
+        REQUIRE(out.size() == n);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out.get(i) == v1[i] - v2[i]);
+        }
+
+        out = c;
+        REQUIRE(&mul(out, a, b) == &out);
+        REQUIRE(out.size() == n);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out.get(i) == v1[i] * v2[i]);
+        }
+
+        // Overlapping arguments.
+        out = a;
+        add(out, out, b);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out.get(i) == v1[i] + v2[i]);
+        }
+
+        out = a;
+        sub(out, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out.get(i) == v2[i] - v1[i]);
+        }
+
+        out = a;
+        mul(out, out, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out.get(i) == v1[i] * v1[i]);
+        }
+
+        // Overflow and cancellation in the fast paths.
+        soa m(2);
+        m.set(0, integer{GMP_NUMB_MAX});
+        m.set(1, -integer{GMP_NUMB_MAX});
+        out = soa{};
+        add(out, m, m);
+        REQUIRE(out.get(0) == 2 * integer{GMP_NUMB_MAX});
+        REQUIRE(out.get(1) == -2 * integer{GMP_NUMB_MAX});
+        sub(out, m, m);
+        REQUIRE(out.get(0).is_zero());
+        REQUIRE(out.get(1).is_zero());
+        REQUIRE(out.sizes_data()[0] == 0);
+        REQUIRE(out.sizes_data()[1] == 0);
+        mul(out, m, m);
+        REQUIRE(out.get(0) == integer{GMP_NUMB_MAX} * integer{GMP_NUMB_MAX});
+        REQUIRE(out.get(1) == integer{GMP_NUMB_MAX} * integer{GMP_NUMB_MAX});
+    }
+};
+
+TEST_CASE("integer_soa")
+{
+    tuple_for_each(sizes{}, soa_tester{});
+}
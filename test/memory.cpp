@@ -0,0 +1,325 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <mp++/config.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/memory.hpp>
+
+#if defined(MPPP_WITH_MPFR)
+
+#include <mp++/real.hpp>
+
+#endif
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace mppp;
+using namespace mppp_test;
+
+using int_t = integer<1>;
+
+// A memory resource keeping track of the allocated blocks. The blocks
+// are allocated via std::malloc(), so that they are compatible with GMP's
+// default memory functions.
+struct tracking_resource final : memory_resource {
+    void *allocate(std::size_t size) noexcept override
+    {
+        const auto retval = std::malloc(size);
+        if (retval == nullptr) {
+            std::abort();
+        }
+        blocks[retval] = size;
+        ++n_alloc;
+        return retval;
+    }
+    void deallocate(void *ptr, std::size_t size) noexcept override
+    {
+        if (blocks.at(ptr) != size) {
+            std::abort();
+        }
+        blocks.erase(ptr);
+        ++n_dealloc;
+        std::free(ptr);
+    }
+    bool owns(const void *ptr) const
+    {
+        return blocks.find(const_cast<void *>(ptr)) != blocks.end();
+    }
+    std::map<void *, std::size_t> blocks;
+    std::size_t n_alloc = 0;
+    std::size_t n_dealloc = 0;
+};
+
+TEST_CASE("memory_resource_scope")
+{
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    void *(*alloc_f)(std::size_t);
+    void *(*realloc_f)(void *, std::size_t, std::size_t);
+    void (*free_f)(void *, std::size_t);
+    ::mp_get_memory_functions(&alloc_f, &realloc_f, &free_f);
+    tracking_resource tr;
+    int_t out{1};
+    out <<= 1000;
+    {
+        memory_resource_scope ms(tr);
+        REQUIRE(detail::get_thread_local_integer_resource() == &tr);
+        REQUIRE(detail::get_thread_local_real_resource() == &tr);
+        // The GMP memory functions are not altered.
+        void *(*alloc_f2)(std::size_t);
+        void *(*realloc_f2)(void *, std::size_t, std::size_t);
+        void (*free_f2)(void *, std::size_t);
+        ::mp_get_memory_functions(&alloc_f2, &realloc_f2, &free_f2);
+        REQUIRE(alloc_f2 == alloc_f);
+        REQUIRE(realloc_f2 == realloc_f);
+        REQUIRE(free_f2 == free_f);
+        // The initial storage of integers is allocated by the resource,
+        // and it is then managed by GMP's memory functions.
+        {
+            int_t a{1};
+            REQUIRE(tr.n_alloc == 0u);
+            a <<= 1000;
+            REQUIRE(tr.n_alloc == 1u);
+            REQUIRE(tr.owns(a.get_mpz_t()->_mp_d));
+            a <<= 100000;
+            REQUIRE(tr.n_alloc == 1u);
+            a >>= 101000;
+            REQUIRE(a == 1);
+            std::vector<int_t> v;
+            for (int i = 1; i <= 100; ++i) {
+                v.emplace_back(i);
+                v.back() <<= 200;
+            }
+            REQUIRE(tr.n_alloc == 101u);
+            // Heap values stay on the heap.
+            out <<= 100000;
+            REQUIRE(tr.n_alloc == 101u);
+            out >>= 100000;
+        }
+        REQUIRE(tr.n_dealloc == 0u);
+        {
+            // Nesting with an arena: integers keep on using tr.
+            arena_scope as;
+            REQUIRE(detail::get_thread_local_integer_resource() == &tr);
+            REQUIRE(detail::get_thread_local_real_resource() != &tr);
+            int_t b{1};
+            b <<= 1000;
+            REQUIRE(tr.n_alloc == 102u);
+            REQUIRE(as.get_nbytes() == 0u);
+        }
+        REQUIRE(detail::get_thread_local_real_resource() == &tr);
+    }
+    REQUIRE(detail::get_thread_local_integer_resource() == nullptr);
+    REQUIRE(detail::get_thread_local_real_resource() == nullptr);
+    REQUIRE(out == int_t{1} << 1000);
+
+#if defined(MPPP_WITH_MPFR)
+    // The significands of reals are allocated, reallocated and
+    // deallocated by the resource.
+    real rout{1, 100};
+    const auto nblocks = tr.blocks.size();
+    const auto n_dealloc = tr.n_dealloc;
+    {
+        memory_resource_scope ms(tr);
+        std::vector<real> v;
+        for (int i = 0; i < 100; ++i) {
+            v.emplace_back(i, 200);
+        }
+        REQUIRE(tr.blocks.size() == nblocks + 100u);
+        REQUIRE(detail::mpfr_get_resource(*v[1].get_mpfr_t()) == &tr);
+        // Changing the precision reallocates the significand in the resource.
+        v[1].prec_round(10000);
+        REQUIRE(v[1] == 1);
+        REQUIRE(tr.blocks.size() == nblocks + 100u);
+        REQUIRE(tr.n_dealloc == n_dealloc + 1u);
+        v[2].set_prec(20000);
+        REQUIRE(tr.blocks.size() == nblocks + 100u);
+        REQUIRE(detail::mpfr_get_resource(*v[2].get_mpfr_t()) == &tr);
+        {
+            // Nesting with an arena.
+            arena_scope as;
+            real b{v.back()};
+            REQUIRE(detail::mpfr_get_resource(*b.get_mpfr_t()) != &tr);
+            REQUIRE(as.get_nbytes() > 0u);
+            // Values owned by tr are reallocated in tr.
+            v[3].prec_round(20000);
+            REQUIRE(detail::mpfr_get_resource(*v[3].get_mpfr_t()) == &tr);
+            b += v[3];
+            REQUIRE(b == 102);
+        }
+        // Heap values stay on the heap.
+        rout.prec_round(10000);
+        REQUIRE(detail::mpfr_get_resource(*rout.get_mpfr_t()) == nullptr);
+        rout = v[99];
+        REQUIRE(detail::mpfr_get_resource(*rout.get_mpfr_t()) == nullptr);
+    }
+    // The significands are returned to the resource, not to the cache.
+    REQUIRE(tr.blocks.size() == nblocks);
+    REQUIRE(rout == 99);
+    // A real created in the scope can be destroyed outside it.
+    {
+        std::vector<real> v;
+        {
+            memory_resource_scope ms(tr);
+            v.emplace_back(1, 1000);
+        }
+        REQUIRE(tr.blocks.size() == nblocks + 1u);
+        v.back().prec_round(2000);
+        REQUIRE(detail::mpfr_get_resource(*v.back().get_mpfr_t()) == &tr);
+    }
+    REQUIRE(tr.blocks.size() == nblocks);
+#endif
+#endif
+}
+
+TEST_CASE("arena_scope")
+{
+    REQUIRE_THROWS_PREDICATE(arena_scope{0}, std::invalid_argument, [](const std::invalid_argument &ex) {
+        return std::string(ex.what()) == "The block size of an arena_scope must be nonzero";
+    });
+
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    void *(*alloc_f)(std::size_t);
+    void *(*realloc_f)(void *, std::size_t, std::size_t);
+    void (*free_f)(void *, std::size_t);
+    ::mp_get_memory_functions(&alloc_f, &realloc_f, &free_f);
+    {
+        arena_scope as;
+        REQUIRE(detail::get_thread_local_real_resource() != nullptr);
+        REQUIRE(detail::get_thread_local_integer_resource() == nullptr);
+        REQUIRE(as.get_nbytes() == 0u);
+        REQUIRE(as.get_capacity() == 0u);
+        // The GMP memory functions are not altered.
+        void *(*alloc_f2)(std::size_t);
+        void *(*realloc_f2)(void *, std::size_t, std::size_t);
+        void (*free_f2)(void *, std::size_t);
+        ::mp_get_memory_functions(&alloc_f2, &realloc_f2, &free_f2);
+        REQUIRE(alloc_f2 == alloc_f);
+        REQUIRE(realloc_f2 == realloc_f);
+        REQUIRE(free_f2 == free_f);
+        // Integers do not use the arena.
+        int_t a{42};
+        a <<= 100000;
+        a >>= 100000;
+        REQUIRE(a == 42);
+        REQUIRE(as.get_nbytes() == 0u);
+        {
+            // Inside the arena, the heap can be selected explicitly.
+            detail::heap_alloc_guard hg;
+            REQUIRE(detail::get_thread_local_real_resource() == nullptr);
+            REQUIRE(detail::get_thread_local_integer_resource() == nullptr);
+        }
+        REQUIRE(detail::get_thread_local_real_resource() != nullptr);
+    }
+    REQUIRE(detail::get_thread_local_real_resource() == nullptr);
+
+#if defined(MPPP_WITH_MPFR)
+    // A value created before the arena, which must survive it.
+    real out{1, 100};
+    {
+        arena_scope as;
+        // Real values are allocated in the arena.
+        real a{42, 100};
+        REQUIRE(as.get_nbytes() > 0u);
+        REQUIRE(as.get_capacity() >= arena_scope::default_block_size);
+        REQUIRE(detail::mpfr_get_resource(*a.get_mpfr_t()) != nullptr);
+        // Changing the precision keeps the value in the arena.
+        a.prec_round(10000);
+        REQUIRE(a == 42);
+        REQUIRE(detail::mpfr_get_resource(*a.get_mpfr_t()) != nullptr);
+        a.set_prec(20000);
+        REQUIRE(a.nan_p());
+        REQUIRE(detail::mpfr_get_resource(*a.get_mpfr_t()) != nullptr);
+        a.set(42);
+        // Values allocated before the scope remain on the heap.
+        out.prec_round(10000);
+        REQUIRE(detail::mpfr_get_resource(*out.get_mpfr_t()) == nullptr);
+        // Lots of temporaries.
+        std::vector<real> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.emplace_back(i, 200);
+        }
+        real sum{0, 200};
+        for (const auto &x : v) {
+            sum += x;
+        }
+        REQUIRE(sum == 999 * 1000 / 2);
+        // Assign to the value created before the scope: the
+        // storage is still on the heap.
+        out = sum;
+        REQUIRE(detail::mpfr_get_resource(*out.get_mpfr_t()) == nullptr);
+        // Operations using thread-local temporaries.
+        REQUIRE(pow(a, 2) == 42 * 42);
+        REQUIRE(pow(2, a) == pow(real{2, 100}, a));
+        v.clear();
+        {
+            // Nested scope.
+            arena_scope as2(16);
+            real b{1, 1000};
+            REQUIRE(as2.get_nbytes() > 0u);
+            // Values belonging to the outer arena are reallocated in the outer arena.
+            const auto n1 = as.get_nbytes();
+            a.prec_round(200000);
+            REQUIRE(as.get_nbytes() > n1);
+            b += a;
+            REQUIRE(b == 43);
+        }
+    }
+    REQUIRE(detail::get_thread_local_real_resource() == nullptr);
+    REQUIRE(out == 999 * 1000 / 2);
+    // The thread-local temporaries created inside the arena are usable after it.
+    REQUIRE(pow(real{3, 100}, 2) == 9);
+    REQUIRE(pow(2, real{3, 100}) == 8);
+
+    // Deallocation of the last block reclaims memory.
+    {
+        arena_scope as;
+        {
+            real a{1, 1000};
+            REQUIRE(as.get_nbytes() > 0u);
+        }
+        REQUIRE(as.get_nbytes() == 0u);
+    }
+
+    // Arenas in multiple threads.
+    std::atomic<bool> fail(false);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&fail, i]() {
+            arena_scope as(1024);
+            real acc{0, 500};
+            for (int j = 0; j < 1000; ++j) {
+                real tmp{j + i, 500};
+                acc += tmp;
+                if (detail::mpfr_get_resource(*tmp.get_mpfr_t()) == nullptr) {
+                    fail.store(true);
+                }
+            }
+            if (acc != 1000 * i + 999 * 1000 / 2) {
+                fail.store(true);
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    REQUIRE(!fail.load());
+#endif
+#endif
+}
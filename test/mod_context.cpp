@@ -0,0 +1,195 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/exceptions.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/mod_context.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace mppp;
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
+                         std::integral_constant<std::size_t, 10>>;
+
+static int ntries = 1000;
+
+static std::mt19937 rng;
+
+struct mod_context_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        using ctx_t = mod_context<S::value>;
+
+        // Reference implementations.
+        auto fmod = [](const integer &n, const integer &m) {
+            integer q, r;
+            tdiv_qr(q, r, n, m);
+            if (r.sgn() < 0) {
+                r += m;
+            }
+            return r;
+        };
+        auto ref_powm = [](const integer &b, const integer &e, const integer &m) {
+            detail::mpz_raii tmp;
+            ::mpz_powm(&tmp.m_mpz, b.get_mpz_view(), e.get_mpz_view(), m.get_mpz_view());
+            return integer{&tmp.m_mpz};
+        };
+
+        // Error handling.
+        REQUIRE_THROWS_PREDICATE(ctx_t{integer{}}, zero_division_error, [](const zero_division_error &ex) {
+            return std::string(ex.what()) == "Cannot construct a modular arithmetic context with a zero modulus";
+        });
+        REQUIRE_THROWS_PREDICATE(ctx_t{integer{-3}}, std::invalid_argument, [](const std::invalid_argument &ex) {
+            return std::string(ex.what()) == "Cannot construct a modular arithmetic context with the negative modulus -3";
+        });
+        REQUIRE_THROWS_PREDICATE(powm(integer{2}, integer{-1}, ctx_t{integer{3}}), std::domain_error,
+                                 [](const std::domain_error &ex) {
+                                     return std::string(ex.what())
+                                            == "Cannot compute a modular power with the negative exponent -1";
+                                 });
+
+        // Simple checks.
+        ctx_t c1{integer{1}};
+        REQUIRE(c1.get_mod() == 1);
+        REQUIRE(mulm(integer{3}, integer{5}, c1).is_zero());
+        REQUIRE(sqrm(integer{-3}, c1).is_zero());
+        REQUIRE(powm(integer{3}, integer{0}, c1).is_zero());
+        ctx_t c7{integer{7}};
+        REQUIRE(mulm(integer{3}, integer{5}, c7) == 1);
+        REQUIRE(mulm(integer{-3}, integer{5}, c7) == 6);
+        REQUIRE(sqrm(integer{-3}, c7) == 2);
+        REQUIRE(powm(integer{3}, integer{0}, c7) == 1);
+        REQUIRE(powm(integer{3}, integer{6}, c7) == 1);
+        REQUIRE(powm(integer{0}, integer{0}, c7) == 1);
+        REQUIRE(powm(integer{0}, integer{5}, c7) == 0);
+
+        // Random testing.
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1);
+        std::uniform_int_distribution<unsigned> ldist(1, S::value + 1u);
+        auto random_int = [&](unsigned x) {
+            random_integer(tmp, x, rng);
+            return integer{&tmp.m_mpz};
+        };
+        for (int i = 0; i < ntries; ++i) {
+            auto m = random_int(ldist(rng));
+            if (m.is_zero()) {
+                continue;
+            }
+            // Test both odd and even moduli.
+            if (sdist(rng) && m.even_p()) {
+                ++m;
+            }
+            const ctx_t ctx{m};
+            REQUIRE(ctx.get_mod() == m);
+
+            for (int j = 0; j < 10; ++j) {
+                // Operands which are already reduced most of the time.
+                auto a = random_int(ldist(rng)), b = random_int(ldist(rng));
+                if (sdist(rng)) {
+                    a = fmod(a, m);
+                    b = fmod(b, m);
+                } else {
+                    if (sdist(rng)) {
+                        a.neg();
+                    }
+                    if (sdist(rng)) {
+                        b.promote();
+                    }
+                }
+
+                integer r;
+                if (sdist(rng)) {
+                    // Start from a dynamic rop sometimes.
+                    r = integer{&tmp.m_mpz};
+                    r.promote();
+                }
+                REQUIRE(mulm(r, a, b, ctx) == fmod(a * b, m));
+                if (m.is_static()) {
+                    // No allocation for static moduli.
+                    REQUIRE(r.is_static());
+                }
+                REQUIRE(mulm(a, b, ctx) == fmod(a * b, m));
+                REQUIRE(sqrm(r, a, ctx) == fmod(a * a, m));
+                REQUIRE(sqrm(a, ctx) == fmod(a * a, m));
+                if (m.is_static()) {
+                    REQUIRE(sqrm(a, ctx) == sqrm(fmod(a, m), m));
+                }
+
+                const auto e = random_int(ldist(rng));
+                REQUIRE(powm(r, a, e, ctx) == ref_powm(a, e, m));
+                REQUIRE(powm(a, e, ctx) == ref_powm(a, e, m));
+
+                // Overlapping arguments.
+                r = a;
+                mulm(r, r, r, ctx);
+                REQUIRE(r == fmod(a * a, m));
+                r = a;
+                sqrm(r, r, ctx);
+                REQUIRE(r == fmod(a * a, m));
+                r = a;
+                powm(r, r, e, ctx);
+                REQUIRE(r == ref_powm(a, e, m));
+            }
+
+            // Batched exponentiation.
+            std::vector<integer> v_b, v_e, v_r(10u);
+            for (int j = 0; j < 10; ++j) {
+                v_b.push_back(fmod(random_int(ldist(rng)), m));
+                v_e.push_back(random_int(ldist(rng)));
+            }
+            batch::powm(v_r.data(), v_b.data(), v_e.data(), v_r.size(), ctx);
+            for (std::size_t j = 0; j < v_r.size(); ++j) {
+                REQUIRE(v_r[j] == ref_powm(v_b[j], v_e[j], m));
+            }
+            batch::powm(v_r.data(), v_b.data(), v_e[0], v_r.size(), ctx);
+            for (std::size_t j = 0; j < v_r.size(); ++j) {
+                REQUIRE(v_r[j] == ref_powm(v_b[j], v_e[0], m));
+            }
+            // Overlapping ranges.
+            auto v_b_copy(v_b);
+            batch::powm(v_b.data(), v_b.data(), v_e.data(), v_b.size(), ctx);
+            for (std::size_t j = 0; j < v_b.size(); ++j) {
+                REQUIRE(v_b[j] == ref_powm(v_b_copy[j], v_e[j], m));
+            }
+            // Empty range.
+            batch::powm(v_r.data(), v_b.data(), v_e.data(), 0, ctx);
+        }
+
+        // Large moduli and exponents.
+        auto m = (integer{1} << (S::value * unsigned(GMP_NUMB_BITS))) - 1;
+        const ctx_t ctx{m};
+        const auto e = (integer{1} << (S::value * unsigned(GMP_NUMB_BITS) * 3u)) - 3;
+        REQUIRE(powm(m - 2, e, ctx) == ref_powm(m - 2, e, m));
+        REQUIRE(mulm(m - 1, m - 1, ctx) == 1);
+        m = m + 1;
+        const ctx_t ctx2{m};
+        REQUIRE(powm(m - 3, e, ctx2) == ref_powm(m - 3, e, m));
+        REQUIRE(mulm(m - 1, m - 1, ctx2) == 1);
+    }
+};
+
+TEST_CASE("mod_context")
+{
+    tuple_for_each(sizes{}, mod_context_tester{});
+}
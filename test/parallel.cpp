@@ -0,0 +1,120 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/parallel.hpp>
+#include <mp++/rational.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace mppp;
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
+                         std::integral_constant<std::size_t, 10>>;
+
+static std::mt19937 rng;
+
+struct parallel_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        using rational = rational<S::value>;
+
+        // Empty ranges.
+        std::vector<integer> v1, v2;
+        REQUIRE(parallel_sum(v1.begin(), v1.end()).is_zero());
+        REQUIRE(parallel_sum(v1.begin(), v1.end(), 4).is_zero());
+        REQUIRE(parallel_dot(v1.begin(), v1.end(), v2.begin()).is_zero());
+        REQUIRE(parallel_product(v1.begin(), v1.end()).is_one());
+        std::vector<rational> q1, q2;
+        REQUIRE(parallel_sum(q1.begin(), q1.end()).is_zero());
+        REQUIRE(parallel_dot(q1.begin(), q1.end(), q2.begin()).is_zero());
+        REQUIRE(parallel_product(q1.begin(), q1.end()).is_one());
+
+        // Random testing against the serial implementations, with various
+        // range sizes and numbers of threads.
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1);
+        std::uniform_int_distribution<unsigned> ldist(0, S::value + 1u);
+        auto random_int = [&]() {
+            random_integer(tmp, ldist(rng), rng);
+            integer retval{&tmp.m_mpz};
+            if (sdist(rng)) {
+                retval.neg();
+            }
+            return retval;
+        };
+        auto random_nonzero_int = [&]() {
+            auto retval = random_int();
+            if (retval.is_zero()) {
+                retval = 1;
+            }
+            return retval;
+        };
+        for (std::size_t n : {1u, 2u, 3u, 7u, 100u, 1001u}) {
+            v1.clear();
+            v2.clear();
+            q1.clear();
+            q2.clear();
+            for (std::size_t i = 0; i < n; ++i) {
+                v1.push_back(random_int());
+                v2.push_back(random_nonzero_int());
+                q1.emplace_back(random_int(), random_nonzero_int());
+                q2.emplace_back(random_int(), random_nonzero_int());
+            }
+            integer sum, dp, prod{1};
+            rational qsum, qdp, qprod{1};
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += v1[i];
+                dp += v1[i] * v2[i];
+                prod *= v2[i];
+                qsum += q1[i];
+                qdp += q1[i] * q2[i];
+                qprod *= q2[i];
+            }
+            for (unsigned nt : {0u, 1u, 2u, 3u, 8u, 2000u}) {
+                REQUIRE(parallel_sum(v1.begin(), v1.end(), nt) == sum);
+                REQUIRE(parallel_sum(v1.cbegin(), v1.cend(), nt) == sum);
+                REQUIRE(parallel_sum(v1.data(), v1.data() + n, nt) == sum);
+                REQUIRE(parallel_dot(v1.begin(), v1.end(), v2.begin(), nt) == dp);
+                REQUIRE(parallel_product(v2.begin(), v2.end(), nt) == prod);
+                REQUIRE(parallel_sum(q1.begin(), q1.end(), nt) == qsum);
+                REQUIRE(parallel_dot(q1.begin(), q1.end(), q2.begin(), nt) == qdp);
+                REQUIRE(parallel_product(q2.begin(), q2.end(), nt) == qprod);
+            }
+        }
+
+        // Exception propagation from the worker threads.
+        REQUIRE_THROWS_PREDICATE(
+            (detail::parallel_map_chunks<integer>(100, 4,
+                                                 [](std::size_t begin, std::size_t) -> integer {
+                                                     if (begin >= 50u) {
+                                                         throw std::invalid_argument("worker error");
+                                                     }
+                                                     return integer{};
+                                                 })),
+            std::invalid_argument, [](const std::invalid_argument &ex) { return std::string(ex.what()) == "worker error"; });
+    }
+};
+
+TEST_CASE("parallel")
+{
+    tuple_for_each(sizes{}, parallel_tester{});
+}
@@ -0,0 +1,201 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <mp++/real128.hpp>
+
+#include "catch.hpp"
+
+using namespace mppp;
+
+static std::mt19937 rng;
+
+static const int ntrials = 10000;
+
+// Check that a and b differ by at most n ulps.
+static inline bool ulp_close(const real128 &a, const real128 &b, int n)
+{
+    if (isnan(a) || isnan(b)) {
+        return isnan(a) && isnan(b);
+    }
+    auto tmp(b);
+    for (int i = 0; i <= n; ++i) {
+        if (tmp == a) {
+            return true;
+        }
+        tmp = nextafter(tmp, a);
+    }
+    return false;
+}
+
+// Random values of the form m * 2**e, with |m| < 1/2.
+// and all the bits of the significand randomly set.
+static inline std::vector<real128> random_vector(int emin, int emax, bool positive = false)
+{
+    std::uniform_int_distribution<unsigned long long> mdist;
+    std::uniform_int_distribution<int> edist(emin, emax);
+    std::vector<real128> retval;
+    for (int i = 0; i < ntrials; ++i) {
+        auto m = (real128{mdist(rng)} * real128{"1.8446744073709551616e19"} + mdist(rng)) / 2;
+        m = scalbn(m, -128);
+        if (!positive && (mdist(rng) & 1u)) {
+            m = -m;
+        }
+        retval.push_back(scalbn(m, edist(rng)));
+    }
+    return retval;
+}
+
+#define MPPP_CHECK_BATCH(f, v, n)                                                                                      \
+    {                                                                                                                  \
+        const std::vector<real128> &in = v;                                                                            \
+        std::vector<real128> out(in.size());                                                                           \
+        batch::f(out.data(), in.data(), in.size());                                                                    \
+        for (std::size_t i = 0; i < in.size(); ++i) {                                                                  \
+            REQUIRE(ulp_close(out[i], f(in[i]), n));                                                                   \
+        }                                                                                                              \
+        /* Overlapping input and output. */                                                                            \
+        out = in;                                                                                                      \
+        batch::f(out.data(), out.data(), out.size());                                                                  \
+        for (std::size_t i = 0; i < in.size(); ++i) {                                                                  \
+            REQUIRE(ulp_close(out[i], f(in[i]), n));                                                                   \
+        }                                                                                                              \
+    }
+
+TEST_CASE("real128 batch exp")
+{
+    MPPP_CHECK_BATCH(exp, random_vector(-10, 1), 3)
+    MPPP_CHECK_BATCH(exp, random_vector(-200, -10), 3)
+    MPPP_CHECK_BATCH(exp, random_vector(1, 14), 3)
+
+    // Special values.
+    const std::vector<real128> v{real128{},
+                                 -real128{},
+                                 real128_inf(),
+                                 -real128_inf(),
+                                 real128_nan(),
+                                 real128{12000},
+                                 real128{-12000},
+                                 real128{11355},
+                                 real128{-11355},
+                                 real128{"1E-300"},
+                                 real128{"-1E-4000"},
+                                 real128_denorm_min()};
+    std::vector<real128> out(v.size());
+    batch::exp(out.data(), v.data(), v.size());
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        REQUIRE(ulp_close(out[i], exp(v[i]), 3));
+    }
+    REQUIRE(out[0] == 1);
+    REQUIRE(out[3] == 0);
+    REQUIRE(isinf(out[2]));
+    REQUIRE(isnan(out[4]));
+
+    // Empty range.
+    batch::exp(out.data(), v.data(), 0);
+    REQUIRE(out[0] == 1);
+}
+
+TEST_CASE("real128 batch log")
+{
+    MPPP_CHECK_BATCH(log, random_vector(-2, 2, true), 3)
+    MPPP_CHECK_BATCH(log, random_vector(-16000, 16000, true), 3)
+
+    // Values close to 1.
+    std::vector<real128> v;
+    std::uniform_int_distribution<int> dist(-113, -1);
+    for (int i = 0; i < ntrials; ++i) {
+        v.push_back(1 + scalbn(real128{dist(rng)}, dist(rng)));
+    }
+    MPPP_CHECK_BATCH(log, v, 3)
+
+    // Special values.
+    v = {real128{},       -real128{},     real128{1},           real128{-1}, real128_inf(),
+         -real128_inf(),  real128_nan(),  real128_denorm_min(), real128_max(), real128_min()};
+    std::vector<real128> out(v.size());
+    batch::log(out.data(), v.data(), v.size());
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        REQUIRE(ulp_close(out[i], log(v[i]), 3));
+    }
+    REQUIRE(out[2] == 0);
+    REQUIRE(!signbit(out[2]));
+    REQUIRE(isnan(out[3]));
+}
+
+TEST_CASE("real128 batch sincos")
+{
+    MPPP_CHECK_BATCH(sin, random_vector(-10, 1), 3)
+    MPPP_CHECK_BATCH(cos, random_vector(-10, 1), 3)
+    MPPP_CHECK_BATCH(sin, random_vector(-100, -10), 3)
+    MPPP_CHECK_BATCH(cos, random_vector(-100, -10), 3)
+    MPPP_CHECK_BATCH(sin, random_vector(1, 20), 3)
+    MPPP_CHECK_BATCH(cos, random_vector(1, 20), 3)
+    MPPP_CHECK_BATCH(sin, random_vector(20, 100), 3)
+    MPPP_CHECK_BATCH(cos, random_vector(20, 100), 3)
+
+    // Values close to multiples of pi / 2.
+    std::vector<real128> v;
+    for (int i = -1000; i < 1000; ++i) {
+        v.push_back(real128_pi() * i / 2);
+        v.push_back(nextafter(real128_pi() * i / 2, real128_inf()));
+    }
+    MPPP_CHECK_BATCH(sin, v, 3)
+    MPPP_CHECK_BATCH(cos, v, 3)
+
+    // Special values.
+    v = {real128{}, -real128{}, real128_inf(), -real128_inf(), real128_nan(), real128_denorm_min(), real128_max()};
+    std::vector<real128> out(v.size());
+    batch::sin(out.data(), v.data(), v.size());
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        REQUIRE(ulp_close(out[i], sin(v[i]), 3));
+    }
+    REQUIRE(out[0] == 0);
+    REQUIRE(!signbit(out[0]));
+    REQUIRE(signbit(out[1]));
+    REQUIRE(out[5] == real128_denorm_min());
+    batch::cos(out.data(), v.data(), v.size());
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        REQUIRE(ulp_close(out[i], cos(v[i]), 3));
+    }
+    REQUIRE(out[0] == 1);
+    REQUIRE(out[1] == 1);
+}
+
+TEST_CASE("real128 batch other")
+{
+    const auto v = random_vector(-10, 3, true);
+    std::vector<real128> out(v.size());
+
+#define MPPP_CHECK_BATCH_EXACT(f)                                                                                      \
+    batch::f(out.data(), v.data(), v.size());                                                                          \
+    for (std::size_t i = 0; i < v.size(); ++i) {                                                                       \
+        REQUIRE(ulp_close(out[i], f(v[i]), 0));                                                                        \
+    }
+
+    MPPP_CHECK_BATCH_EXACT(sqrt)
+    MPPP_CHECK_BATCH_EXACT(cbrt)
+    MPPP_CHECK_BATCH_EXACT(tan)
+    MPPP_CHECK_BATCH_EXACT(asin)
+    MPPP_CHECK_BATCH_EXACT(acos)
+    MPPP_CHECK_BATCH_EXACT(atan)
+    MPPP_CHECK_BATCH_EXACT(sinh)
+    MPPP_CHECK_BATCH_EXACT(cosh)
+    MPPP_CHECK_BATCH_EXACT(tanh)
+    MPPP_CHECK_BATCH_EXACT(asinh)
+    MPPP_CHECK_BATCH_EXACT(acosh)
+    MPPP_CHECK_BATCH_EXACT(atanh)
+    MPPP_CHECK_BATCH_EXACT(log10)
+    MPPP_CHECK_BATCH_EXACT(log2)
+    MPPP_CHECK_BATCH_EXACT(lgamma)
+    MPPP_CHECK_BATCH_EXACT(erf)
+
+#undef MPPP_CHECK_BATCH_EXACT
+}
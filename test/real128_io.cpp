@@ -8,6 +8,10 @@
 
 #include <random>
 #include <sstream>
+#include <string>
+#include <system_error>
+
+#include <quadmath.h>
 
 #include <mp++/real128.hpp>
 
@@ -57,3 +61,184 @@ TEST_CASE("real128 io")
     check_round_trip(real128{"1E-4960"});
     check_round_trip(real128{"-1E-4960"});
 }
+
+// Normalise the decimal representation s into the significant digits
+// followed by the decimal exponent of the first digit.
+static inline std::string normalise_decimal(const std::string &s)
+{
+    std::string digits;
+    int exp = -1;
+    bool leading = true, dot = false;
+    std::size_t i = 0;
+    for (; i < s.size() && s[i] != 'e'; ++i) {
+        if (s[i] == '.') {
+            dot = true;
+        } else if (s[i] >= '0' && s[i] <= '9') {
+            if (leading && s[i] == '0') {
+                if (dot) {
+                    --exp;
+                }
+                continue;
+            }
+            leading = false;
+            digits.push_back(s[i]);
+            if (!dot) {
+                ++exp;
+            }
+        }
+    }
+    if (i < s.size()) {
+        exp += std::stoi(s.substr(i + 1));
+    }
+    while (digits.size() > 1u && digits.back() == '0') {
+        digits.pop_back();
+    }
+    return digits + "e" + std::to_string(exp);
+}
+
+// Check that the output of to_chars() is the shortest representation
+// of r which reads back to r.
+static inline void check_shortest(const real128 &r)
+{
+    char buffer[100], ref[100];
+    const auto ret = to_chars(buffer, buffer + 100, r);
+    REQUIRE(ret.ec == std::errc{});
+    const std::string str(buffer, ret.ptr);
+    real128 r2;
+    REQUIRE(from_chars(str.data(), str.data() + str.size(), r2).ptr == str.data() + str.size());
+    REQUIRE(r2.m_value == r.m_value);
+    REQUIRE(r2.signbit() == r.signbit());
+    REQUIRE((str[0] == '-') == r.signbit());
+    if (r.m_value == 0) {
+        return;
+    }
+    // Count the significant digits.
+    const auto norm = normalise_decimal(str);
+    const auto n = static_cast<int>(norm.find('e'));
+    // NOTE: at the lower boundary of a binade, the correctly-rounded n-digit representation
+    // might fall outside the rounding interval of r, in which case the output is a different
+    // n-digit representation.
+    ::quadmath_snprintf(ref, sizeof(ref), "%.*Qe", n - 1, r.m_value);
+    if (norm != normalise_decimal(ref)) {
+        REQUIRE(::strtoflt128(ref, nullptr) != r.m_value);
+    }
+    if (n > 1) {
+        ::quadmath_snprintf(ref, sizeof(ref), "%.*Qe", n - 2, r.m_value);
+        REQUIRE(::strtoflt128(ref, nullptr) != r.m_value);
+    }
+}
+
+TEST_CASE("real128 charconv")
+{
+    char buffer[100];
+    std::uniform_int_distribution<int> sdist(0, 1), edist(-16494, 16383);
+    std::uniform_real_distribution<double> dist(-1E10, 1E10), mdist(1., 2.);
+    for (int i = 0; i < ntries; ++i) {
+        const auto r = nextafter(real128{dist(rng)}, real128{1E11});
+        check_shortest(r);
+        check_shortest(real128{dist(rng)});
+        check_shortest(real128{static_cast<long long>(dist(rng))});
+        // Random binary exponents, including subnormals.
+        const auto x = scalbn(nextafter(real128{mdist(rng)}, real128{2}), edist(rng)) * (sdist(rng) ? 1 : -1);
+        check_shortest(x);
+        check_shortest(nextafter(x, real128{0}));
+        // Powers of two, whose lower neighbour is closer.
+        check_shortest(scalbn(real128{1}, edist(rng)));
+
+        const auto str = [&r, &buffer]() {
+            const auto ret = to_chars(buffer, buffer + 100, r);
+            return std::string(buffer, ret.ptr);
+        }();
+        auto ret = to_chars(buffer, buffer + str.size(), r);
+        REQUIRE(ret.ec == std::errc{});
+        ret = to_chars(buffer, buffer + str.size() - 1u, r);
+        REQUIRE(ret.ec == std::errc::value_too_large);
+        REQUIRE(ret.ptr == buffer + str.size() - 1u);
+
+        const auto in = str + "x";
+        real128 r2;
+        const auto fret = from_chars(in.data(), in.data() + in.size(), r2);
+        REQUIRE(fret.ec == std::errc{});
+        REQUIRE(fret.ptr == in.data() + str.size());
+        REQUIRE(r2 == r);
+    }
+    check_shortest(real128{});
+    check_shortest(-real128{});
+    check_shortest(real128_max());
+    check_shortest(real128_min());
+    check_shortest(real128_denorm_min());
+    check_shortest(-real128_denorm_min());
+    check_shortest(real128_epsilon());
+    check_shortest(real128{"0.1"});
+    check_shortest(real128{"1E-5"});
+    check_shortest(real128{"123456"});
+    check_shortest(real128{"1E36"});
+    check_shortest(real128{"1E37"});
+    check_shortest(real128{2} / 3);
+
+    auto ret = to_chars(buffer, buffer + 100, real128{"0.1"});
+    REQUIRE(std::string(buffer, ret.ptr) == "0.1");
+    ret = to_chars(buffer, buffer + 100, -real128{"1.5e-300"});
+    REQUIRE(std::string(buffer, ret.ptr) == "-1.5e-300");
+    ret = to_chars(buffer, buffer + 100, real128{100});
+    REQUIRE(std::string(buffer, ret.ptr) == "100");
+    ret = to_chars(buffer, buffer + 100, real128{1000});
+    REQUIRE(std::string(buffer, ret.ptr) == "1000");
+    ret = to_chars(buffer, buffer + 100, real128{100000});
+    REQUIRE(std::string(buffer, ret.ptr) == "1e+05");
+    ret = to_chars(buffer, buffer + 100, real128{"0.001"});
+    REQUIRE(std::string(buffer, ret.ptr) == "0.001");
+    ret = to_chars(buffer, buffer + 100, real128{"0.0001"});
+    REQUIRE(std::string(buffer, ret.ptr) == "1e-04");
+    ret = to_chars(buffer, buffer + 100, real128{"123.25"});
+    REQUIRE(std::string(buffer, ret.ptr) == "123.25");
+    ret = to_chars(buffer, buffer + 100, real128{"1E40"});
+    REQUIRE(std::string(buffer, ret.ptr) == "1e+40");
+    ret = to_chars(buffer, buffer + 100, -real128{});
+    REQUIRE(std::string(buffer, ret.ptr) == "-0");
+    ret = to_chars(buffer, buffer + 100, -real128_inf());
+    REQUIRE(std::string(buffer, ret.ptr) == "-inf");
+    ret = to_chars(buffer, buffer + 100, real128_nan());
+    REQUIRE(std::string(buffer, ret.ptr) == "nan");
+
+    // Parsing errors.
+    real128 r{42};
+    const std::string bad[] = {"", "+1", " 1", "x", "-"};
+    for (const auto &s : bad) {
+        const auto fret = from_chars(s.data(), s.data() + s.size(), r);
+        REQUIRE(fret.ec == std::errc::invalid_argument);
+        REQUIRE(fret.ptr == s.data());
+        REQUIRE(r == 42);
+    }
+    std::string s = "1e100000";
+    auto fret = from_chars(s.data(), s.data() + s.size(), r);
+    REQUIRE(fret.ec == std::errc::result_out_of_range);
+    REQUIRE(fret.ptr == s.data() + s.size());
+    REQUIRE(r == 42);
+    s = "-1.5e3";
+    fret = from_chars(s.data(), s.data() + s.size(), r);
+    REQUIRE(fret.ec == std::errc{});
+    REQUIRE(r == -1500);
+    // Long input, which does not fit in the stack buffer.
+    s = "0." + std::string(200, '0') + "1";
+    fret = from_chars(s.data(), s.data() + s.size(), r);
+    REQUIRE(fret.ptr == s.data() + s.size());
+    REQUIRE(r == real128{s});
+    // Only the value at the beginning of the range is consumed.
+    s = "-1.5e3 " + std::string(100000, '1');
+    fret = from_chars(s.data(), s.data() + s.size(), r);
+    REQUIRE(fret.ptr == s.data() + 6);
+    REQUIRE(r == -1500);
+    s = "0x1.8p1 2";
+    fret = from_chars(s.data(), s.data() + s.size(), r);
+    REQUIRE(fret.ptr == s.data() + 7);
+    REQUIRE(r == 3);
+    s = "-infinity1";
+    fret = from_chars(s.data(), s.data() + s.size(), r);
+    REQUIRE(fret.ptr == s.data() + 9);
+    REQUIRE(r == -real128_inf());
+    s = "nan(1)x";
+    fret = from_chars(s.data(), s.data() + s.size(), r);
+    REQUIRE(fret.ptr == s.data() + 6);
+    REQUIRE(r.isnan());
+}
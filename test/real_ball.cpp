@@ -0,0 +1,413 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <mp++/config.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+#include <mp++/real.hpp>
+#include <mp++/real_ball.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace mppp;
+using namespace mppp_test;
+
+static std::mt19937 rng;
+
+static const int ntrials = 100;
+
+TEST_CASE("real_ball basic")
+{
+    REQUIRE(std::is_nothrow_move_constructible<real_ball>::value);
+
+    // Default construction.
+    real_ball b;
+    REQUIRE(b.mid().zero_p());
+    REQUIRE(b.rad().zero_p());
+    REQUIRE(b.rad().get_prec() == 30);
+    REQUIRE(b.get_prec() == real_prec_min());
+    REQUIRE(b.is_exact());
+    REQUIRE(b.is_finite());
+
+    // Construction from real.
+    real_ball b1{real{"1.5", 100}};
+    REQUIRE(b1.get_prec() == 100);
+    REQUIRE(b1.mid() == 1.5);
+    REQUIRE(b1.is_exact());
+    real r{"-2.5", 42};
+    real_ball b2{std::move(r)};
+    REQUIRE(b2.get_prec() == 42);
+    REQUIRE(b2.mid() == -2.5);
+
+    // Midpoint and radius.
+    real_ball b3{real{1, 64}, real{"0.1", 100}};
+    REQUIRE(b3.get_prec() == 64);
+    REQUIRE(!b3.is_exact());
+    REQUIRE(b3.rad().get_prec() == 30);
+    // The radius is rounded up.
+    REQUIRE(b3.rad() >= real{"0.1", 100});
+    REQUIRE(real_ball{real{1, 64}, real{-0., 30}}.is_exact());
+    REQUIRE(!real_ball{real{1, 64}, real{-0., 30}}.rad().signbit());
+    REQUIRE(!real_ball{real{1, 64}, real{real_kind::inf, 30}}.is_finite());
+    REQUIRE_THROWS_AS((real_ball{real{1, 64}, real{-1, 30}}), std::invalid_argument);
+    REQUIRE_THROWS_AS((real_ball{real{1, 64}, real{real_kind::nan, 30}}), std::invalid_argument);
+
+    // Generic construction.
+    REQUIRE(real_ball{42}.is_exact());
+    REQUIRE(real_ball{42}.get_prec() == std::numeric_limits<int>::digits + 1);
+    REQUIRE(real_ball{42}.mid() == 42);
+    REQUIRE(real_ball{1.1}.is_exact());
+    REQUIRE(real_ball{1.1}.mid() == 1.1);
+    const integer<1> big{"123456789012345678901234567890"};
+    REQUIRE(real_ball{big}.is_exact());
+    REQUIRE(real_ball{big}.mid() == big);
+    REQUIRE(real_ball{true}.get_prec() == 2);
+    REQUIRE(real_ball{true}.mid() == 1);
+    // Rounding to a lower precision enlarges the radius.
+    real_ball b4{big, 20};
+    REQUIRE(b4.get_prec() == 20);
+    REQUIRE(!b4.is_exact());
+    REQUIRE(b4.contains(real{big}));
+    REQUIRE(real_ball{1024, 20}.is_exact());
+    // Rationals.
+    real_ball b5{rational<1>{1, 3}, 100};
+    REQUIRE(b5.get_prec() == 100);
+    REQUIRE(!b5.is_exact());
+    REQUIRE(b5.overlaps(real_ball{1, 200} / 3));
+    REQUIRE(b5.rel_accuracy_bits() >= 98);
+    REQUIRE(real_ball{rational<1>{1, 4}, 100}.is_exact());
+    REQUIRE(real_ball{rational<1>{1, 3}}.get_prec() == 2 * GMP_NUMB_BITS);
+    REQUIRE_THROWS_PREDICATE((real_ball{rational<1>{1, 3}, -1}), std::invalid_argument,
+                             [](const std::invalid_argument &ex) {
+                                 return ex.what()
+                                        == "Cannot init a real_ball with a precision of -1: the maximum allowed "
+                                           "precision is "
+                                               + std::to_string(real_prec_max())
+                                               + ", the minimum allowed precision is "
+                                               + std::to_string(real_prec_min());
+                             });
+    REQUIRE_THROWS_AS((real_ball{42, -1}), std::invalid_argument);
+
+    // Strings.
+    real_ball b6{"0.1", 100};
+    REQUIRE(b6.get_prec() == 100);
+    REQUIRE(!b6.is_exact());
+    REQUIRE(b6.overlaps(real_ball{rational<1>{1, 10}, 200}));
+    REQUIRE(real_ball{std::string{"1.5"}, 64}.is_exact());
+    REQUIRE(real_ball{std::string{"1.5"}, 64}.mid() == 1.5);
+    real_ball b7{"[1.5 +/- 0.25]", 64};
+    REQUIRE(b7.contains(real{"1.25", 64}));
+    REQUIRE(b7.contains(real{"1.75", 64}));
+    REQUIRE(!b7.contains(real{"1.8", 64}));
+#if defined(MPPP_HAVE_STRING_VIEW)
+    REQUIRE(real_ball{std::string_view{"1.5"}, 64}.mid() == 1.5);
+#endif
+    REQUIRE_THROWS_PREDICATE((real_ball{"foo", 64}), std::invalid_argument, [](const std::invalid_argument &ex) {
+        return ex.what() == std::string{"The string 'foo' does not represent a valid real_ball"};
+    });
+    REQUIRE_THROWS_PREDICATE((real_ball{"1.5"}), std::invalid_argument, [](const std::invalid_argument &ex) {
+        return ex.what()
+               == std::string{"Cannot init a real_ball with an automatically-deduced precision if "
+                              "the global default precision has not been set"};
+    });
+    real_set_default_prec(80);
+    REQUIRE(real_ball{"1.5"}.get_prec() == 80);
+    real_reset_default_prec();
+
+    // Copy/move.
+    auto b8 = b6;
+    REQUIRE(b8.mid() == b6.mid());
+    REQUIRE(b8.rad() == b6.rad());
+    auto b9 = std::move(b8);
+    REQUIRE(b9.mid() == b6.mid());
+    b8 = b9;
+    REQUIRE(b8.rad() == b6.rad());
+    b8 = std::move(b9);
+    REQUIRE(b8.rad() == b6.rad());
+}
+
+TEST_CASE("real_ball prec_round")
+{
+    real_ball b{real{1, 100} / 3};
+    REQUIRE(b.is_exact());
+    b.prec_round(200);
+    REQUIRE(b.get_prec() == 200);
+    REQUIRE(b.is_exact());
+    REQUIRE(b.mid() == real{1, 100} / 3);
+    b.prec_round(50);
+    REQUIRE(b.get_prec() == 50);
+    REQUIRE(!b.is_exact());
+    REQUIRE(b.contains(real{1, 100} / 3));
+    REQUIRE(b.rel_accuracy_bits() >= 45);
+    REQUIRE(b.rel_accuracy_bits() <= 55);
+    REQUIRE_THROWS_PREDICATE(b.prec_round(-1), std::invalid_argument, [](const std::invalid_argument &ex) {
+        return ex.what()
+               == "Cannot set the precision of a real_ball to the value -1: the maximum allowed precision is "
+                      + std::to_string(real_prec_max()) + ", the minimum allowed precision is "
+                      + std::to_string(real_prec_min());
+    });
+}
+
+TEST_CASE("real_ball bounds accuracy")
+{
+    real_ball b{real{1, 64}, real{"0.5", 30}};
+    REQUIRE(b.lower() == 0.5);
+    REQUIRE(b.upper() == 1.5);
+    REQUIRE(b.lower().get_prec() == 64);
+    REQUIRE(b.upper().get_prec() == 64);
+    REQUIRE(real_ball{real{1, 64}}.rel_accuracy_bits() == std::numeric_limits<long long>::max());
+    REQUIRE(real_ball{real{1, 64}, real{real_kind::inf, 30}}.rel_accuracy_bits()
+            == std::numeric_limits<long long>::min());
+    REQUIRE(real_ball{real{real_kind::nan, 64}}.rel_accuracy_bits() == std::numeric_limits<long long>::min());
+    REQUIRE(real_ball{real{1, 64}, real{"0.5", 30}}.rel_accuracy_bits() <= 1);
+
+    // Contains/overlaps.
+    REQUIRE(b.contains(real{1, 64}));
+    REQUIRE(b.contains(real_ball{real{1, 64}, real{"0.25", 30}}));
+    REQUIRE(!b.contains(real_ball{real{1, 64}, real{1, 30}}));
+    REQUIRE(b.overlaps(real_ball{real{2, 64}, real{1, 30}}));
+    REQUIRE(!b.overlaps(real_ball{real{3, 64}, real{1, 30}}));
+}
+
+TEST_CASE("real_ball arith")
+{
+    const auto third = real_ball{1, 128} / 3;
+    REQUIRE(third.get_prec() == 128);
+    REQUIRE(!third.is_exact());
+    REQUIRE(third.overlaps(real_ball{rational<1>{1, 3}, 256}));
+    REQUIRE((third * 3).contains(real{1}));
+    REQUIRE((3 * third).contains(real{1}));
+    REQUIRE((third + third + third - 1).contains(real{0}));
+    REQUIRE((1 - third).overlaps(real_ball{rational<1>{2, 3}, 256}));
+    REQUIRE((third / real{2, 10}).overlaps(real_ball{rational<1>{1, 6}, 256}));
+    REQUIRE((real{2, 10} / third).contains(real{6}));
+
+    // The precision of the result is the max precision of the operands.
+    REQUIRE((real_ball{real{1, 10}} + real_ball{real{1, 100}}).get_prec() == 100);
+    REQUIRE((real_ball{real{1, 100}} + real{1, 10}).get_prec() == 100);
+    REQUIRE((real_ball{real{1, 10}} * real{1, 100}).get_prec() == 100);
+
+    // In-place operators.
+    auto b = real_ball{real{1, 128}};
+    b += 1;
+    REQUIRE(b == 2);
+    b -= real_ball{real{"0.5", 128}};
+    REQUIRE(b == 1.5);
+    b *= real{2, 128};
+    REQUIRE(b == 3);
+    b /= 3;
+    REQUIRE(b == 1);
+    b /= 3;
+    REQUIRE(b.contains(third));
+    b = real_ball{real{1, 128}};
+    b /= 0;
+    REQUIRE(!b.is_finite());
+
+    // Increment and decrement.
+    b = real_ball{real{1, 128}};
+    REQUIRE(++b == 2);
+    REQUIRE(b++ == 2);
+    REQUIRE(b == 3);
+    REQUIRE(--b == 2);
+    REQUIRE(b-- == 2);
+    REQUIRE(b == 1);
+    REQUIRE(b.get_prec() == 128);
+    auto b3 = third;
+    ++b3;
+    REQUIRE(b3.overlaps(real_ball{rational<1>{4, 3}, 256}));
+
+    // Identity and negation.
+    REQUIRE((+third).mid() == third.mid());
+    REQUIRE((-third).mid() == -third.mid());
+    REQUIRE((-third).rad() == third.rad());
+    REQUIRE(abs(-third).mid() == third.mid());
+    real_ball rop;
+    REQUIRE(&neg(rop, third) == &rop);
+    REQUIRE(rop.mid() == -third.mid());
+    REQUIRE(&add(rop, rop, rop) == &rop);
+    REQUIRE(rop.overlaps(real_ball{rational<1>{-2, 3}, 256}));
+
+    // Random testing against MPFR.
+    std::uniform_real_distribution<double> dist(-100., 100.);
+    for (int i = 0; i < ntrials; ++i) {
+        const auto x = dist(rng), y = dist(rng);
+        const real_ball bx{x}, by{y};
+        REQUIRE((bx + by).contains(real{x} + real{y}));
+        REQUIRE((bx - by).contains(real{x} - real{y}));
+        REQUIRE((bx * by).contains(real{x} * real{y}));
+        // NOTE: the quotient is inexact.
+        REQUIRE((bx / by).overlaps(real_ball{rational<1>{x} / rational<1>{y}, 300}));
+    }
+}
+
+TEST_CASE("real_ball functions")
+{
+    for (::mpfr_prec_t p : {53, 113, 256, 1000}) {
+        const auto x = real_ball{rational<1>{3, 7}, p};
+        const auto hx = real{3, p + 64} / 7;
+        // Each result must overlap with the value computed by MPFR at a higher
+        // precision (enlarged by a small relative error), and it must be accurate
+        // to roughly the working precision.
+        auto close = [p](const real_ball &b, const real &h) {
+            const real_ball hb{h, abs(h) / real{integer<1>{1} << static_cast<unsigned>(p + 32), 30}};
+            return b.overlaps(hb) && b.rel_accuracy_bits() >= p - 20;
+        };
+        REQUIRE(close(sqrt(x), sqrt(hx)));
+        REQUIRE(close(rec_sqrt(x), rec_sqrt(hx)));
+        REQUIRE(close(cbrt(x), cbrt(hx)));
+        REQUIRE(close(sqr(x), sqr(hx)));
+        REQUIRE(close(pow(x, x), pow(hx, hx)));
+        REQUIRE(close(hypot(x, x), hypot(hx, hx)));
+        REQUIRE(close(sin(x), sin(hx)));
+        REQUIRE(close(cos(x), cos(hx)));
+        REQUIRE(close(tan(x), tan(hx)));
+        REQUIRE(close(cot(x), cot(hx)));
+        REQUIRE(close(asin(x), asin(hx)));
+        REQUIRE(close(acos(x), acos(hx)));
+        REQUIRE(close(atan(x), atan(hx)));
+        REQUIRE(close(atan2(x, x + 1), atan2(hx, hx + 1)));
+        REQUIRE(close(sinh(x), sinh(hx)));
+        REQUIRE(close(cosh(x), cosh(hx)));
+        REQUIRE(close(tanh(x), tanh(hx)));
+        REQUIRE(close(coth(x), coth(hx)));
+        REQUIRE(close(asinh(x), asinh(hx)));
+        REQUIRE(close(acosh(x + 1), acosh(hx + 1)));
+        REQUIRE(close(atanh(x), atanh(hx)));
+        REQUIRE(close(exp(x), exp(hx)));
+        REQUIRE(close(expm1(x), expm1(hx)));
+        REQUIRE(close(log(x), log(hx)));
+        REQUIRE(close(log1p(x), log1p(hx)));
+        REQUIRE(close(gamma(x), gamma(hx)));
+        REQUIRE(close(lngamma(x), lngamma(hx)));
+        REQUIRE(close(digamma(x), digamma(hx)));
+        REQUIRE(close(zeta(x), zeta(hx)));
+        REQUIRE(close(erf(x), erf(hx)));
+        REQUIRE(close(erfc(x), erfc(hx)));
+        REQUIRE(close(sin_pi(x), sin_pi(hx)));
+        REQUIRE(close(cos_pi(x), cos_pi(hx)));
+        REQUIRE(close(tan_pi(x), tan_pi(hx)));
+        REQUIRE(close(cot_pi(x), cot_pi(hx)));
+        REQUIRE(close(sinc(x), sinc(hx)));
+        REQUIRE(close(sinc_pi(x), sinc_pi(hx)));
+        REQUIRE(close(sqrt1pm1(x), sqrt1pm1(hx)));
+        REQUIRE(close(log_hypot(x, x), log_hypot(hx, hx)));
+        REQUIRE(close(agm(x, x + 1), agm(hx, hx + 1)));
+        REQUIRE(close(fma(x, x, x), fma(hx, hx, hx)));
+        REQUIRE(close(sec(x), sec(hx)));
+        REQUIRE(close(csc(x), csc(hx)));
+        REQUIRE(close(sech(x), sech(hx)));
+        REQUIRE(close(csch(x), csch(hx)));
+        REQUIRE(close(exp2(x), exp2(hx)));
+        REQUIRE(close(exp10(x), exp10(hx)));
+        REQUIRE(close(log2(x), log2(hx)));
+        REQUIRE(close(log10(x), log10(hx)));
+
+        // Mixed-mode binary functions.
+        REQUIRE(close(pow(x, 2), pow(hx, 2)));
+        REQUIRE(close(pow(2, x), pow(real{2, p + 64}, hx)));
+        REQUIRE(close(atan2(x, 1.5), atan2(hx, 1.5)));
+        REQUIRE(close(hypot(real{1, p}, x), hypot(real{1, p + 64}, hx)));
+        REQUIRE(close(log_hypot(x, integer<1>{2}), log_hypot(hx, 2)));
+        REQUIRE(close(agm(rational<1>{1, 2}, x), agm(real{rational<1>{1, 2}, p + 64}, hx)));
+        REQUIRE(close(real_ball_pi(p), real_pi(p + 64)));
+
+        // The precision of the result is the precision of the operand.
+        REQUIRE(exp(x).get_prec() == p);
+        real_ball rop;
+        REQUIRE(&exp(rop, x) == &rop);
+        REQUIRE(rop.get_prec() == p);
+        REQUIRE(&pow(rop, rop, x) == &rop);
+        REQUIRE(rop.get_prec() == p);
+        REQUIRE(&fma(rop, rop, x, x) == &rop);
+        REQUIRE(rop.get_prec() == p);
+        REQUIRE(pow(x, 2).get_prec() == p);
+    }
+
+    // Functions outside their domain produce non-finite balls.
+    REQUIRE(!sqrt(real_ball{-1, 64}).is_finite());
+    REQUIRE(!log(real_ball{0, 64}).is_finite());
+
+    // Balls straddling a singularity.
+    REQUIRE(!(real_ball{1, 64} / real_ball{real{0, 64}, real{1, 30}}).is_finite());
+
+    // Catastrophic cancellation is detected.
+    const auto a = real_ball{1, 64} + real_ball{rational<1>{1, 3 * (integer<1>{1} << 60)}, 64};
+    REQUIRE((a - 1).rel_accuracy_bits() < 10);
+    const auto a2 = real_ball{1, 256} + real_ball{rational<1>{1, 3 * (integer<1>{1} << 60)}, 256};
+    REQUIRE((a2 - 1).rel_accuracy_bits() > 180);
+
+    // Precision errors.
+    REQUIRE_THROWS_AS(exp(real_ball{real{1, 1}}), std::invalid_argument);
+    REQUIRE_THROWS_AS(real_ball_pi(-1), std::invalid_argument);
+    REQUIRE_THROWS_PREDICATE(real_ball_pi(), std::invalid_argument, [](const std::invalid_argument &ex) {
+        return ex.what()
+               == std::string{"Cannot init a real_ball with an automatically-deduced precision if "
+                              "the global default precision has not been set"};
+    });
+    real_set_default_prec(100);
+    REQUIRE(real_ball_pi().get_prec() == 100);
+    real_reset_default_prec();
+}
+
+TEST_CASE("real_ball comparisons")
+{
+    const real_ball a{real{1, 64}, real{"0.5", 30}};
+    const real_ball b{real{3, 64}, real{"0.5", 30}};
+    const real_ball c{real{2, 64}, real{"0.75", 30}};
+
+    REQUIRE(a < b);
+    REQUIRE(a <= b);
+    REQUIRE(b > a);
+    REQUIRE(b >= a);
+    REQUIRE(a != b);
+    REQUIRE(!(a == b));
+
+    // Overlapping balls: neither ordering nor (in)equality can be established.
+    REQUIRE(!(a < c));
+    REQUIRE(!(a > c));
+    REQUIRE(!(a == c));
+    REQUIRE(!(a != c));
+
+    // Equality requires exact balls.
+    REQUIRE(!(a == a));
+    REQUIRE(real_ball{real{1, 64}} == real_ball{real{1, 128}});
+    REQUIRE(real_ball{real{1, 64}} == 1);
+    REQUIRE(1 == real_ball{real{1, 64}});
+    REQUIRE(real_ball{real{1, 64}} == real{1, 10});
+    REQUIRE(real_ball{real{1, 64}} != 2);
+    REQUIRE(a < 2);
+    REQUIRE(0 < a);
+    REQUIRE(a > 0.25);
+    REQUIRE(a <= real{1.5, 64});
+    REQUIRE(real{"1.5", 64} >= a);
+}
+
+TEST_CASE("real_ball string")
+{
+    REQUIRE(real_ball{real{"1.5", 64}}.to_string().find("1.5") == 0u);
+    std::uniform_real_distribution<double> dist(-100., 100.);
+    for (int i = 0; i < ntrials; ++i) {
+        const auto x = real_ball{dist(rng), 100} / 3;
+        const auto s = x.to_string();
+        REQUIRE(s[0] == '[');
+        // The ball parsed from the string contains the original ball.
+        REQUIRE(real_ball{s, 100}.contains(x));
+        std::ostringstream oss;
+        oss << x;
+        REQUIRE(oss.str() == s);
+    }
+}
@@ -8,6 +8,7 @@
 
 #include <mp++/config.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <cmath>
 #include <initializer_list>
@@ -31,6 +32,7 @@
 #include <mp++/detail/mpfr.hpp>
 #include <mp++/detail/type_traits.hpp>
 #include <mp++/integer.hpp>
+#include <mp++/memory.hpp>
 #include <mp++/rational.hpp>
 #include <mp++/real.hpp>
 #include <mp++/type_name.hpp>
@@ -1640,6 +1642,88 @@ TEST_CASE("real mt cleanup")
     t4.join();
 }
 
+TEST_CASE("real cache")
+{
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    auto &c = detail::get_thread_local_mpfr_cache();
+    c.clear();
+    // Significands of at most mpfr_alloc_cache::max_size limbs are cached.
+    const auto d = [](const real &r) { return r.get_mpfr_t()->_mpfr_d; };
+    const ::mp_limb_t *ptr;
+    {
+        real r{42, GMP_NUMB_BITS + 1};
+        ptr = d(r);
+    }
+    REQUIRE(c.sizes[1] == 1u);
+    {
+        // A request for a precision with the same number of limbs reuses the significand.
+        real r{real_kind::nan, 2 * GMP_NUMB_BITS};
+        REQUIRE(d(r) == ptr);
+        REQUIRE(c.sizes[1] == 0u);
+        REQUIRE(r.nan_p());
+        REQUIRE(r.get_prec() == 2 * GMP_NUMB_BITS);
+        r = 42;
+        REQUIRE(r == 42);
+        // The internal mpfr_t can be reallocated and shrunk via the MPFR API.
+        ::mpfr_set_prec(r._get_mpfr_t(), 20 * GMP_NUMB_BITS);
+        ::mpfr_set_ui(r._get_mpfr_t(), 1, MPFR_RNDN);
+        ::mpfr_mul_2ui(r._get_mpfr_t(), r.get_mpfr_t(), 10 * GMP_NUMB_BITS, MPFR_RNDN);
+        REQUIRE(r == real{1, 20 * GMP_NUMB_BITS} * pow(real{2}, 10 * GMP_NUMB_BITS));
+        // Drop the significands of the temporaries above.
+        c.clear();
+        ::mpfr_set_prec(r._get_mpfr_t(), GMP_NUMB_BITS);
+        ::mpfr_set_ui(r._get_mpfr_t(), 3, MPFR_RNDN);
+        REQUIRE(r == 3);
+    }
+    // The shrunk significand is cached in the class of its current precision.
+    REQUIRE(c.sizes[0] == 1u);
+    {
+        real r{1, GMP_NUMB_BITS - 1};
+        REQUIRE(c.sizes[0] == 0u);
+        REQUIRE(r == 1);
+        r.set_prec(100 * GMP_NUMB_BITS);
+        r.set(1);
+        REQUIRE(r == 1);
+    }
+    // Large significands are not cached.
+    REQUIRE(c.sizes[0] == 0u);
+    {
+        real r{1, static_cast<::mpfr_prec_t>(detail::mpfr_alloc_cache::max_size + 1u) * GMP_NUMB_BITS};
+    }
+    REQUIRE(std::all_of(c.sizes.begin(), c.sizes.end(), [](std::size_t n) { return n == 0u; }));
+    // Limit on the number of entries per class.
+    {
+        std::vector<real> v;
+        for (std::size_t i = 0; i < detail::mpfr_alloc_cache::max_entries + 10u; ++i) {
+            v.emplace_back(i, 3 * GMP_NUMB_BITS);
+        }
+    }
+    REQUIRE(c.sizes[2] == detail::mpfr_alloc_cache::max_entries);
+    // Moved-from and mpfr_t-assigned values.
+    {
+        real r0{1, 3 * GMP_NUMB_BITS}, r1{std::move(r0)};
+        ::mpfr_t m;
+        ::mpfr_init2(m, 3 * GMP_NUMB_BITS);
+        ::mpfr_set_ui(m, 5, MPFR_RNDN);
+        r1 = std::move(m);
+        REQUIRE(r1 == 5);
+        REQUIRE(c.sizes[2] == detail::mpfr_alloc_cache::max_entries);
+    }
+    c.clear();
+    REQUIRE(std::all_of(c.sizes.begin(), c.sizes.end(), [](std::size_t n) { return n == 0u; }));
+    REQUIRE(std::all_of(c.heads.begin(), c.heads.end(), [](const ::mp_limb_t *p) { return p == nullptr; }));
+    // Memory resources bypass the cache.
+    {
+        arena_scope as;
+        {
+            real r{1, 2 * GMP_NUMB_BITS};
+            REQUIRE(as.get_nbytes() > 0u);
+        }
+        REQUIRE(c.sizes[1] == 0u);
+    }
+#endif
+}
+
 #if MPPP_CPLUSPLUS >= 201703L
 
 TEST_CASE("real nts")
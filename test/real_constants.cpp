@@ -6,10 +6,17 @@
 // Public License v. 2.0. If a copy of the MPL was not distributed
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
+#include <atomic>
+#include <random>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/memory.hpp>
 #include <mp++/real.hpp>
 
 #include "catch.hpp"
@@ -18,6 +25,18 @@
 using namespace mppp;
 using namespace mppp_test;
 
+static std::mt19937 rng;
+
+// Check that a constant from mp++ is identical
+// to the constant computed directly via MPFR.
+template <typename F>
+static inline bool check_constant(const real &r, const F &f)
+{
+    real cmp{real_kind::zero, r.get_prec()};
+    f(cmp._get_mpfr_t(), MPFR_RNDN);
+    return r.get_prec() == cmp.get_prec() && ::mpfr_equal_p(r.get_mpfr_t(), cmp.get_mpfr_t());
+}
+
 TEST_CASE("real pi")
 {
     auto r0 = real_pi(12);
@@ -47,3 +66,143 @@ TEST_CASE("real pi")
     REQUIRE(real_pi(r0).get_prec() == 86);
     REQUIRE((r0 == real{"3.141592653589793238462643402", 86}));
 }
+
+TEST_CASE("real log2 euler catalan")
+{
+    auto r0 = real_log2(12);
+    REQUIRE(r0.get_prec() == 12);
+    REQUIRE((r0 == real{"0.69315", 12}));
+    r0 = real_euler(12);
+    REQUIRE(r0.get_prec() == 12);
+    REQUIRE((r0 == real{"0.57722", 12}));
+    r0 = real_catalan(12);
+    REQUIRE(r0.get_prec() == 12);
+    REQUIRE((r0 == real{"0.91597", 12}));
+    REQUIRE_THROWS_PREDICATE(r0 = real_log2(-1), std::invalid_argument, [](const std::invalid_argument &ex) {
+        return ex.what()
+               == "Cannot init a real constant with a precision of -1: the value must be either zero or between "
+                      + std::to_string(real_prec_min()) + " and " + std::to_string(real_prec_max());
+    });
+    REQUIRE_THROWS_AS(r0 = real_euler(-1), std::invalid_argument);
+    REQUIRE_THROWS_AS(r0 = real_catalan(-1), std::invalid_argument);
+    REQUIRE_THROWS_PREDICATE(r0 = real_catalan(), std::invalid_argument, [](const std::invalid_argument &ex) {
+        return ex.what()
+               == std::string{"Cannot init a real constant with an automatically-deduced precision if "
+                              "the global default precision has not been set"};
+    });
+    REQUIRE_THROWS_AS(r0 = real_log2(), std::invalid_argument);
+    REQUIRE_THROWS_AS(r0 = real_euler(), std::invalid_argument);
+    real_set_default_prec(42);
+    REQUIRE(real_log2().get_prec() == 42);
+    REQUIRE(check_constant(real_log2(), ::mpfr_const_log2));
+    REQUIRE(real_euler().get_prec() == 42);
+    REQUIRE(check_constant(real_euler(), ::mpfr_const_euler));
+    REQUIRE(real_catalan().get_prec() == 42);
+    REQUIRE(check_constant(real_catalan(), ::mpfr_const_catalan));
+    real_reset_default_prec();
+    r0.set_prec(86);
+    REQUIRE(real_log2(r0).get_prec() == 86);
+    REQUIRE(check_constant(r0, ::mpfr_const_log2));
+    REQUIRE(real_euler(r0).get_prec() == 86);
+    REQUIRE(check_constant(r0, ::mpfr_const_euler));
+    REQUIRE(real_catalan(r0).get_prec() == 86);
+    REQUIRE(check_constant(r0, ::mpfr_const_catalan));
+}
+
+TEST_CASE("real constants cache")
+{
+    // Ascending precisions, which require recomputing the constants.
+    for (::mpfr_prec_t p = real_prec_min(); p < 300; p += 7) {
+        REQUIRE(check_constant(real_pi(p), ::mpfr_const_pi));
+        REQUIRE(check_constant(real_log2(p), ::mpfr_const_log2));
+        REQUIRE(check_constant(real_euler(p), ::mpfr_const_euler));
+        REQUIRE(check_constant(real_catalan(p), ::mpfr_const_catalan));
+    }
+
+    // All precisions below the cached one, which are served by rounding
+    // the cached values. This also checks that we do not incur in double rounding
+    // when the cached value lies halfway between two representable values.
+    real_warm_up_constants(1000);
+    for (::mpfr_prec_t p = 1000; p >= real_prec_min(); --p) {
+        REQUIRE(check_constant(real_pi(p), ::mpfr_const_pi));
+        REQUIRE(check_constant(real_log2(p), ::mpfr_const_log2));
+        REQUIRE(check_constant(real_euler(p), ::mpfr_const_euler));
+        REQUIRE(check_constant(real_catalan(p), ::mpfr_const_catalan));
+        real r{real_kind::nan, p};
+        REQUIRE(check_constant(real_pi(r), ::mpfr_const_pi));
+        REQUIRE(check_constant(real_catalan(r), ::mpfr_const_catalan));
+    }
+
+    // Random precisions.
+    std::uniform_int_distribution<::mpfr_prec_t> pdist(real_prec_min(), 2000);
+    for (int i = 0; i < 200; ++i) {
+        const auto p = pdist(rng);
+        REQUIRE(check_constant(real_pi(p), ::mpfr_const_pi));
+        REQUIRE(check_constant(real_log2(p), ::mpfr_const_log2));
+        REQUIRE(check_constant(real_euler(p), ::mpfr_const_euler));
+        REQUIRE(check_constant(real_catalan(p), ::mpfr_const_catalan));
+    }
+
+    // Warm up errors.
+    REQUIRE_THROWS_PREDICATE(real_warm_up_constants(-1), std::invalid_argument, [](const std::invalid_argument &ex) {
+        return ex.what()
+               == "Cannot init a real constant with a precision of -1: the value must be either zero or between "
+                      + std::to_string(real_prec_min()) + " and " + std::to_string(real_prec_max());
+    });
+    REQUIRE_THROWS_PREDICATE(real_warm_up_constants(), std::invalid_argument, [](const std::invalid_argument &ex) {
+        return ex.what()
+               == std::string{"Cannot init a real constant with an automatically-deduced precision if "
+                              "the global default precision has not been set"};
+    });
+    real_set_default_prec(2100);
+    REQUIRE_NOTHROW(real_warm_up_constants());
+    real_reset_default_prec();
+    REQUIRE(check_constant(real_euler(2100), ::mpfr_const_euler));
+}
+
+TEST_CASE("real constants multithreaded")
+{
+    std::atomic<bool> fail(false);
+    auto f = [&fail](unsigned n) {
+        std::mt19937 eng(n);
+        std::uniform_int_distribution<::mpfr_prec_t> pdist(real_prec_min(), 3000);
+        std::vector<::mpfr_prec_t> precs;
+        for (int i = 0; i < 100; ++i) {
+            precs.push_back(pdist(eng));
+        }
+        std::sort(precs.begin(), precs.end());
+        for (auto p : precs) {
+            if (!check_constant(real_pi(p), ::mpfr_const_pi) || !check_constant(real_log2(p), ::mpfr_const_log2)
+                || !check_constant(real_euler(p), ::mpfr_const_euler)
+                || !check_constant(real_catalan(p), ::mpfr_const_catalan)) {
+                fail.store(true);
+            }
+        }
+    };
+    std::thread t0(f, 0u), t1(f, 1u), t2(f, 2u), t3(f, 3u);
+    t0.join();
+    t1.join();
+    t2.join();
+    t3.join();
+    REQUIRE(!fail.load());
+}
+
+TEST_CASE("real constants arena")
+{
+    // The cache is updated while an arena is active: the cached
+    // values must not be allocated in the arena.
+    {
+        arena_scope as;
+        REQUIRE(check_constant(real_pi(10000), ::mpfr_const_pi));
+        REQUIRE(check_constant(real_log2(10000), ::mpfr_const_log2));
+        real_warm_up_constants(10100);
+        REQUIRE(detail::mpfr_get_resource(*real_pi(100).get_mpfr_t()) != nullptr);
+    }
+    REQUIRE(check_constant(real_pi(10000), ::mpfr_const_pi));
+    REQUIRE(check_constant(real_log2(10000), ::mpfr_const_log2));
+    REQUIRE(check_constant(real_euler(10100), ::mpfr_const_euler));
+    REQUIRE(check_constant(real_catalan(10100), ::mpfr_const_catalan));
+    // Replace the cached values.
+    REQUIRE(check_constant(real_pi(11000), ::mpfr_const_pi));
+    REQUIRE(check_constant(real_catalan(11000), ::mpfr_const_catalan));
+}
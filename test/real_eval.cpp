@@ -0,0 +1,171 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <mp++/config.hpp>
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+#include <mp++/real.hpp>
+#include <mp++/real_eval.hpp>
+
+#if defined(MPPP_WITH_ARB)
+
+#include <mp++/real_ball.hpp>
+
+#endif
+
+#include "catch.hpp"
+
+using namespace mppp;
+
+// Check that a agrees with b to p bits.
+static inline bool agree(const real &a, const real &b, ::mpfr_prec_t p)
+{
+    return abs(a - b) <= mul_2si(abs(b), -static_cast<long>(p));
+}
+
+TEST_CASE("eval_to_accuracy type traits")
+{
+    REQUIRE(is_real_eval_argument<real>::value);
+    REQUIRE(is_real_eval_argument<int>::value);
+    REQUIRE(is_real_eval_argument<double>::value);
+    REQUIRE(is_real_eval_argument<integer<1>>::value);
+    REQUIRE(is_real_eval_argument<rational<1>>::value);
+    REQUIRE(!is_real_eval_argument<std::vector<int>>::value);
+    REQUIRE(!is_real_eval_argument<real &>::value);
+}
+
+TEST_CASE("eval_to_accuracy real")
+{
+    // Ramanujan's constant.
+    auto f = [](::mpfr_prec_t wp, const real &x) { return exp(real_pi(wp) * sqrt(x)); };
+    // NOTE: the reference value needs guard bits on top of the
+    // largest target accuracy, as exp() amplifies the rounding errors.
+    const auto ref = f(1300, real{163, 1300});
+    for (::mpfr_prec_t p : {10, 53, 64, 113, 200, 1000}) {
+        const auto r = eval_to_accuracy(f, p, 163);
+        REQUIRE(std::is_same<decltype(eval_to_accuracy(f, p, 163)), real>::value);
+        REQUIRE(r.get_prec() == p);
+        REQUIRE(agree(r, ref, p - 1));
+    }
+
+    // Nullary functions.
+    auto r = eval_to_accuracy([](::mpfr_prec_t wp) { return real_pi(wp); }, 100);
+    REQUIRE(r.get_prec() == 100);
+    REQUIRE(agree(r, real_pi(200), 99));
+
+    // Multiple arguments of different types.
+    r = eval_to_accuracy([](::mpfr_prec_t, const real &a, const real &b, const real &c,
+                            const real &d) { return a * b + c / d; },
+                         80, real{1.5, 500}, 3, integer<1>{5}, rational<1>{1, 3});
+    REQUIRE(r.get_prec() == 80);
+    REQUIRE(agree(r, real{4.5, 80} + real{15, 80}, 79));
+
+    // Lvalue and rvalue callables.
+    const auto g = [](::mpfr_prec_t, const real &x) { return sqrt(x); };
+    REQUIRE(agree(eval_to_accuracy(g, 60, 2), sqrt(real{2, 200}), 59));
+    REQUIRE(agree(eval_to_accuracy([](::mpfr_prec_t, const real &x) { return sqrt(x); }, 60, 2), sqrt(real{2, 200}),
+                  59));
+}
+
+TEST_CASE("eval_to_accuracy working precision")
+{
+    // The arguments are rounded to the working precision, which
+    // is doubled at each step, and their storage is reused.
+    std::vector<::mpfr_prec_t> wps;
+    std::vector<const real *> addrs;
+    const real x{1, 1000};
+    auto r = eval_to_accuracy(
+        [&wps, &addrs](::mpfr_prec_t wp, const real &a, const real &b) {
+            REQUIRE(a.get_prec() == wp);
+            REQUIRE(b.get_prec() == wp);
+            REQUIRE(a == real{1, wp} / 3);
+            REQUIRE(b == 1);
+            wps.push_back(wp);
+            addrs.push_back(&a);
+            return a * b;
+        },
+        64, real{1, 1000} / 3, x);
+    REQUIRE(r.get_prec() == 64);
+    REQUIRE(r == real{1, 64} / 3);
+    REQUIRE(wps.size() == 2u);
+    REQUIRE(wps[0] == 96);
+    REQUIRE(wps[1] == 192);
+    REQUIRE(addrs[0] == addrs[1]);
+
+    // Special values are accepted if they are stable.
+    wps.clear();
+    r = eval_to_accuracy(
+        [&wps](::mpfr_prec_t wp) {
+            wps.push_back(wp);
+            return real{0, wp};
+        },
+        64);
+    REQUIRE(r.zero_p());
+    REQUIRE(r.get_prec() == 64);
+    REQUIRE(wps.size() == 2u);
+    r = eval_to_accuracy([](::mpfr_prec_t, const real &x) { return log(x); }, 64, -1);
+    REQUIRE(r.nan_p());
+    r = eval_to_accuracy([](::mpfr_prec_t, const real &x) { return log(x); }, 64, 0);
+    REQUIRE(r.inf_p());
+    REQUIRE(r.sgn() < 0);
+
+    // A result which does not stabilise.
+    wps.clear();
+    REQUIRE_THROWS_AS(eval_to_accuracy(
+                          [&wps](::mpfr_prec_t wp) {
+                              wps.push_back(wp);
+                              return sin(real_pi(wp));
+                          },
+                          64),
+                      std::runtime_error);
+    REQUIRE(wps.size() == 13u);
+    REQUIRE(wps.back() == 96l << 12);
+
+    // Invalid target accuracies.
+    auto h = [](::mpfr_prec_t wp) { return real{1, wp}; };
+    REQUIRE_THROWS_AS(eval_to_accuracy(h, 0), std::invalid_argument);
+    REQUIRE_THROWS_AS(eval_to_accuracy(h, -1), std::invalid_argument);
+    REQUIRE_THROWS_AS(eval_to_accuracy(h, real_prec_max() + 1), std::invalid_argument);
+}
+
+#if defined(MPPP_WITH_ARB)
+
+TEST_CASE("eval_to_accuracy real_ball")
+{
+    const auto ref = sin(real_pi(1000) / 7);
+    for (::mpfr_prec_t p : {10, 53, 64, 113, 200, 500}) {
+        const auto b = eval_to_accuracy(
+            [](::mpfr_prec_t wp, const real &x) { return sin(real_ball_pi(wp) / real_ball{x}); }, p, 7);
+        REQUIRE(std::is_same<decltype(b), const real_ball>::value);
+        REQUIRE(b.rel_accuracy_bits() >= p);
+        REQUIRE(b.contains(ref));
+    }
+
+    // The first step is enough for exact results.
+    unsigned count = 0;
+    auto b = eval_to_accuracy(
+        [&count](::mpfr_prec_t, const real &x) {
+            ++count;
+            return real_ball{x} * 2;
+        },
+        64, 3);
+    REQUIRE(count == 1u);
+    REQUIRE(b.is_exact());
+    REQUIRE(b.mid() == 6);
+
+    // A result whose accuracy does not improve.
+    REQUIRE_THROWS_AS(
+        eval_to_accuracy([](::mpfr_prec_t wp) { return sin(real_ball_pi(wp)); }, 64), std::runtime_error);
+}
+
+#endif
@@ -0,0 +1,149 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <random>
+#include <type_traits>
+#include <utility>
+
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/real.hpp>
+#include <mp++/real_expr.hpp>
+
+#include "catch.hpp"
+
+using namespace mppp;
+
+static std::mt19937 rng;
+
+static const int ntrials = 1000;
+
+static inline bool identical(const real &a, const real &b)
+{
+    return a.get_prec() == b.get_prec() && ::mpfr_equal_p(a.get_mpfr_t(), b.get_mpfr_t());
+}
+
+TEST_CASE("real_expr type traits")
+{
+    real a{1, 64};
+    REQUIRE(is_real_lazy<decltype(lazy(a))>::value);
+    REQUIRE(is_real_lazy<decltype(lazy(a) * a)>::value);
+    REQUIRE(is_real_lazy<decltype(a * lazy(a) + a)>::value);
+    REQUIRE(is_real_lazy<decltype(-(lazy(a) / a))>::value);
+    REQUIRE(!is_real_lazy<real>::value);
+    REQUIRE(!is_real_lazy<int>::value);
+    // Without a lazy operand, the eager operators are used.
+    REQUIRE(std::is_same<decltype(a * a + a), real>::value);
+}
+
+TEST_CASE("real_expr fused")
+{
+    std::uniform_real_distribution<double> dist(-100., 100.);
+    std::uniform_int_distribution<::mpfr_prec_t> pdist(real_prec_min(), 200);
+    for (int i = 0; i < ntrials; ++i) {
+        const real a{dist(rng), pdist(rng)}, b{dist(rng), pdist(rng)}, c{dist(rng), pdist(rng)},
+            d{dist(rng), pdist(rng)};
+        const auto p = std::max(std::max(a.get_prec(), b.get_prec()), std::max(c.get_prec(), d.get_prec()));
+        real cmp{real_kind::zero, p};
+
+        // a * b + c.
+        ::mpfr_set_prec(cmp._get_mpfr_t(), std::max(std::max(a.get_prec(), b.get_prec()), c.get_prec()));
+        ::mpfr_fma(cmp._get_mpfr_t(), a.get_mpfr_t(), b.get_mpfr_t(), c.get_mpfr_t(), MPFR_RNDN);
+        REQUIRE(identical(eval(lazy(a) * b + c), cmp));
+        REQUIRE(identical(eval(c + lazy(a) * b), cmp));
+
+        // a * b - c and c - a * b.
+        ::mpfr_fms(cmp._get_mpfr_t(), a.get_mpfr_t(), b.get_mpfr_t(), c.get_mpfr_t(), MPFR_RNDN);
+        REQUIRE(identical(eval(lazy(a) * b - c), cmp));
+        ::mpfr_neg(cmp._get_mpfr_t(), cmp.get_mpfr_t(), MPFR_RNDN);
+        REQUIRE(identical(eval(c - lazy(a) * b), cmp));
+
+        // a * b + c * d and a * b - c * d.
+        ::mpfr_set_prec(cmp._get_mpfr_t(), p);
+        ::mpfr_fmma(cmp._get_mpfr_t(), a.get_mpfr_t(), b.get_mpfr_t(), c.get_mpfr_t(), d.get_mpfr_t(), MPFR_RNDN);
+        REQUIRE(identical(eval(lazy(a) * b + lazy(c) * d), cmp));
+        ::mpfr_fmms(cmp._get_mpfr_t(), a.get_mpfr_t(), b.get_mpfr_t(), c.get_mpfr_t(), d.get_mpfr_t(), MPFR_RNDN);
+        REQUIRE(identical(eval(lazy(a) * b - lazy(c) * d), cmp));
+
+        // a * a.
+        ::mpfr_set_prec(cmp._get_mpfr_t(), a.get_prec());
+        ::mpfr_sqr(cmp._get_mpfr_t(), a.get_mpfr_t(), MPFR_RNDN);
+        REQUIRE(identical(eval(lazy(a) * a), cmp));
+
+        // Plain binary operations, which match the eager operators.
+        REQUIRE(identical(eval(lazy(a) + b), a + b));
+        REQUIRE(identical(eval(lazy(a) - b), a - b));
+        REQUIRE(identical(eval(lazy(a) * b), a * b));
+        REQUIRE(identical(eval(lazy(a) / b), a / b));
+        REQUIRE(identical(eval(-lazy(a)), -a));
+        REQUIRE(identical(eval(+lazy(a)), a));
+        REQUIRE(identical(eval(-(lazy(a) / b)), -(a / b)));
+    }
+
+    // Exact cancellation yields +0, as in the eager evaluation.
+    const real a{3, 100}, b{5, 100}, c{15, 100}, one{1, 100};
+    REQUIRE(identical(eval(c - lazy(a) * b), c - a * b));
+    REQUIRE(!eval(c - lazy(a) * b).signbit());
+    REQUIRE(identical(eval(lazy(c) / one - lazy(a) * b), c / one - a * b));
+    REQUIRE(!eval(lazy(c) / one - lazy(a) * b).signbit());
+    REQUIRE(identical(eval(lazy(a) * b - c), a * b - c));
+    REQUIRE(!eval(lazy(a) * b - c).signbit());
+    REQUIRE(identical(eval(lazy(a) * b - lazy(c) / one), a * b - c / one));
+    REQUIRE(!eval(lazy(a) * b - lazy(c) / one).signbit());
+}
+
+TEST_CASE("real_expr compound")
+{
+    std::uniform_real_distribution<double> dist(-100., 100.);
+    for (int i = 0; i < ntrials; ++i) {
+        // Exactly representable values, so that fused and eager evaluations coincide.
+        const real a{static_cast<int>(dist(rng)), 128}, b{static_cast<int>(dist(rng)), 64},
+            c{static_cast<int>(dist(rng)), 100}, d{static_cast<int>(dist(rng)), 32}, e{static_cast<int>(dist(rng)), 90};
+
+        REQUIRE(identical(eval(lazy(a) * b + lazy(c) * d - e), a * b + c * d - e));
+        REQUIRE(identical(eval(e - (lazy(a) * b + lazy(c) * d)), e - (a * b + c * d)));
+        REQUIRE(identical(eval((lazy(a) + b) * (lazy(c) - d)), (a + b) * (c - d)));
+        REQUIRE(identical(eval(lazy(a) * b + (lazy(c) - d)), a * b + (c - d)));
+        REQUIRE(identical(eval((lazy(c) - d) - lazy(a) * b), (c - d) - a * b));
+        REQUIRE(identical(eval(-(lazy(a) + b) * c), -(a + b) * c));
+        REQUIRE(identical(eval(a - (lazy(b) - (lazy(c) - (lazy(d) - e)))), a - (b - (c - (d - e)))));
+
+        // The precision of the result is the maximum precision of the leaves.
+        REQUIRE(eval(lazy(b) * d).get_prec() == 64);
+        REQUIRE(eval(lazy(b) * d + a).get_prec() == 128);
+    }
+}
+
+TEST_CASE("real_expr eval into")
+{
+    const real a{3, 64}, b{5, 100}, c{7, 80};
+
+    // Evaluation into an existing object with a different precision.
+    real out{1, 10};
+    REQUIRE(&eval(out, lazy(a) * b + c) == &out);
+    REQUIRE(out == 22);
+    REQUIRE(out.get_prec() == 100);
+
+    // The destination is a leaf of the expression.
+    real x{2, 64};
+    eval(x, lazy(x) * a + x);
+    REQUIRE(x == 8);
+    REQUIRE(x.get_prec() == 64);
+    eval(x, lazy(b) * c - x);
+    REQUIRE(x == 27);
+    REQUIRE(x.get_prec() == 100);
+    eval(x, lazy(x) * x);
+    REQUIRE(x == 729);
+    eval(x, (lazy(a) + x) / (lazy(x) - c));
+    REQUIRE(x == real{732, 100} / 722);
+
+    // Special values propagate.
+    const real n{"nan", 10, 64}, inf{"inf", 10, 64};
+    REQUIRE(eval(lazy(a) * n + b).nan_p());
+    REQUIRE(eval(lazy(a) * inf - b).inf_p());
+    REQUIRE(eval(lazy(inf) * a - lazy(inf) * b).nan_p());
+}
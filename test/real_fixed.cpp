@@ -0,0 +1,301 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <mp++/config.hpp>
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(MPPP_HAVE_STRING_VIEW)
+#include <string_view>
+#endif
+
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+#include <mp++/real.hpp>
+#include <mp++/real_fixed.hpp>
+
+#if defined(MPPP_WITH_QUADMATH)
+#include <mp++/real128.hpp>
+#endif
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace mppp;
+
+static std::mt19937 rng;
+
+static const int ntrials = 200;
+
+// Check that a real_fixed is identical to a real (including
+// the sign of zero).
+template <::mpfr_prec_t P>
+static inline bool identical(const real_fixed<P> &a, const real &b)
+{
+    const auto ar = static_cast<real>(a);
+    if (ar.get_prec() != b.get_prec()) {
+        return false;
+    }
+    if (ar.nan_p() || b.nan_p()) {
+        return ar.nan_p() && b.nan_p() && a.nan_p();
+    }
+    return ::mpfr_equal_p(ar.get_mpfr_t(), b.get_mpfr_t()) && ar.signbit() == b.signbit()
+           && a.signbit() == b.signbit() && a.sgn() == b.sgn() && a.zero_p() == b.zero_p()
+           && a.inf_p() == b.inf_p() && a.regular_p() == b.regular_p();
+}
+
+using rf256 = real_fixed<256>;
+using rf113 = real_fixed<113>;
+using rf1000 = real_fixed<1000>;
+
+TEST_CASE("real_fixed basic")
+{
+    REQUIRE(std::is_trivially_copyable<rf256>::value);
+    REQUIRE(std::is_trivially_copyable<rf1000>::value);
+    REQUIRE(rf256::get_prec() == 256);
+    REQUIRE(real_fixed<1>::get_prec() == 1);
+
+    // Default construction.
+    rf256 z;
+    REQUIRE(z.zero_p());
+    REQUIRE(!z.signbit());
+    REQUIRE(z.sgn() == 0);
+    REQUIRE(z.number_p());
+    REQUIRE(!z.regular_p());
+
+    // Construction and conversion.
+    rf256 a{42};
+    REQUIRE(a.regular_p());
+    REQUIRE(a.sgn() == 1);
+    REQUIRE(static_cast<int>(a) == 42);
+    REQUIRE(static_cast<real>(a) == 42);
+    REQUIRE(static_cast<real>(a).get_prec() == 256);
+    REQUIRE(static_cast<double>(rf113{1.5}) == 1.5);
+    REQUIRE(static_cast<integer<1>>(rf1000{-7}) == -7);
+    REQUIRE(identical(rf113{real{1, 10} / 3}, real{real{1, 10} / 3, 113}));
+    REQUIRE(identical(rf113{real{1, 300} / 3}, real{real{1, 300} / 3, 113}));
+    REQUIRE(identical(rf256{"1.1"}, real{"1.1", 256}));
+    REQUIRE(identical(rf256{"ff.8", 16}, real{"ff.8", 16, 256}));
+    REQUIRE_THROWS_AS(rf256{"foo"}, std::invalid_argument);
+    // Direct construction from the interoperable types,
+    // including rounding and large integral values.
+    REQUIRE(identical(rf113{true}, real{true, 113}));
+    REQUIRE(identical(real_fixed<10>{1023}, real{1023, 10}));
+    REQUIRE(identical(real_fixed<10>{-1025ll}, real{-1025ll, 10}));
+    REQUIRE(identical(rf113{detail::nl_max<unsigned long long>()}, real{detail::nl_max<unsigned long long>(), 113}));
+    REQUIRE(identical(rf113{detail::nl_min<long long>()}, real{detail::nl_min<long long>(), 113}));
+    REQUIRE(identical(real_fixed<10>{1.1f}, real{1.1f, 10}));
+    REQUIRE(identical(rf113{-0.}, real{-0., 113}));
+    REQUIRE(identical(rf256{1.1l}, real{1.1l, 256}));
+    REQUIRE(identical(rf256{integer<1>{1} << 300}, real{integer<1>{1} << 300, 256}));
+    REQUIRE(identical(real_fixed<10>{(integer<1>{1} << 300) + 1}, real{(integer<1>{1} << 300) + 1, 10}));
+    REQUIRE(identical(rf113{rational<1>{1, 3}}, real{rational<1>{1, 3}, 113}));
+#if defined(MPPP_WITH_QUADMATH)
+    REQUIRE(identical(rf256{real128{1} / 3}, real{real128{1} / 3, 256}));
+    REQUIRE(identical(real_fixed<10>{real128{1} / 3}, real{real128{1} / 3, 10}));
+#endif
+    REQUIRE(identical(rf113{std::string{"-1.1"}}, real{"-1.1", 113}));
+#if defined(MPPP_HAVE_STRING_VIEW)
+    REQUIRE(identical(rf113{std::string_view{"-1.1foo", 4}}, real{"-1.1", 113}));
+#endif
+    REQUIRE(identical(rf113{"@inf@", 62}, real{"@inf@", 62, 113}));
+    REQUIRE_THROWS_PREDICATE(rf256("1.1", 1), std::invalid_argument, [](const std::invalid_argument &ex) {
+        return std::string(ex.what())
+               == "Cannot construct a real_fixed from a string in base 1: the base must either be zero or in the "
+                  "[2,62] range";
+    });
+    REQUIRE_THROWS_PREDICATE(rf256{"foo"}, std::invalid_argument, [](const std::invalid_argument &ex) {
+        return std::string(ex.what()) == "The string 'foo' does not represent a valid real_fixed in base 10";
+    });
+
+    // Special values.
+    const rf256 nan{"nan"}, inf{"inf"}, minf{"-inf"}, mz{"-0"};
+    REQUIRE(nan.nan_p());
+    REQUIRE(!nan.number_p());
+    REQUIRE_THROWS_AS(nan.sgn(), std::domain_error);
+    REQUIRE(inf.inf_p());
+    REQUIRE(inf.sgn() == 1);
+    REQUIRE(minf.inf_p());
+    REQUIRE(minf.sgn() == -1);
+    REQUIRE(minf.signbit());
+    REQUIRE(mz.zero_p());
+    REQUIRE(mz.signbit());
+    REQUIRE(mz == z);
+    REQUIRE(!(nan == nan));
+    REQUIRE(nan != nan);
+    REQUIRE(!(nan < a));
+    REQUIRE((inf - inf).nan_p());
+    REQUIRE((a / z).inf_p());
+
+    // Unary operators.
+    REQUIRE(-a == rf256{-42});
+    REQUIRE(+a == a);
+    REQUIRE((-nan).nan_p());
+    REQUIRE((-nan).signbit());
+    REQUIRE(!abs(-nan).signbit());
+    REQUIRE((-z).signbit());
+    REQUIRE(abs(-a) == a);
+    REQUIRE(neg(a) == -a);
+    auto b(a);
+    REQUIRE(&b.neg() == &b);
+    REQUIRE(b == -a);
+    REQUIRE(&b.abs() == &b);
+    REQUIRE(b == a);
+
+    // Comparisons.
+    REQUIRE(rf256{1} < rf256{2});
+    REQUIRE(rf256{1} <= rf256{1});
+    REQUIRE(rf256{3} > rf256{2});
+    REQUIRE(rf256{2} >= rf256{2});
+    REQUIRE(rf256{1} != rf256{2});
+
+    // Strings and streams.
+    REQUIRE(a.to_string() == static_cast<real>(a).to_string());
+    REQUIRE(a.to_string(16) == static_cast<real>(a).to_string(16));
+    std::ostringstream oss1, oss2;
+    oss1 << a;
+    oss2 << static_cast<real>(a);
+    REQUIRE(oss1.str() == oss2.str());
+
+    // Relocation into vectors.
+    std::vector<rf256> v;
+    for (int i = 0; i < 100; ++i) {
+        v.emplace_back(i);
+        v.back() /= rf256{3};
+    }
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(identical(v[static_cast<unsigned>(i)], real{i, 256} / 3));
+    }
+}
+
+TEST_CASE("real_fixed arith")
+{
+    std::uniform_real_distribution<double> dist(-100., 100.);
+    for (int i = 0; i < ntrials; ++i) {
+        const real ra{dist(rng), 256}, rb{dist(rng), 256}, rc{dist(rng), 256};
+        const rf256 a{ra}, b{rb}, c{rc};
+
+        REQUIRE(identical(a + b, ra + rb));
+        REQUIRE(identical(a - b, ra - rb));
+        REQUIRE(identical(a * b, ra * rb));
+        REQUIRE(identical(a / b, ra / rb));
+        REQUIRE(identical(fma(a, b, c), fma(ra, rb, rc)));
+        REQUIRE(identical(fms(a, b, c), fms(ra, rb, rc)));
+        REQUIRE(identical(pow(abs(a), b), pow(abs(ra), rb)));
+        REQUIRE(identical(atan2(a, b), atan2(ra, rb)));
+        REQUIRE(identical(hypot(a, b), hypot(ra, rb)));
+
+        // Overlapping arguments.
+        auto x(a);
+        x += x;
+        REQUIRE(identical(x, ra + ra));
+        x = a;
+        x *= x;
+        REQUIRE(identical(x, ra * ra));
+        x = a;
+        x -= b;
+        REQUIRE(identical(x, ra - rb));
+        x = a;
+        x /= b;
+        REQUIRE(identical(x, ra / rb));
+        x = a;
+        sub(x, b, x);
+        REQUIRE(identical(x, rb - ra));
+        x = a;
+        fma(x, x, x, c);
+        REQUIRE(identical(x, fma(ra, ra, rc)));
+        x = a;
+        fma(x, b, c, x);
+        REQUIRE(identical(x, fma(rb, rc, ra)));
+        x = a;
+        fma(x, b, b, b);
+        REQUIRE(identical(x, fma(rb, rb, rb)));
+        x = a;
+        sqr(x, x);
+        REQUIRE(identical(x, sqr(ra)));
+
+        // Precision not multiple of the limb size.
+        const rf113 d{ra}, e{rb};
+        REQUIRE(identical(d * e, real{real{ra, 113} * real{rb, 113}, 113}));
+        REQUIRE(identical(d / e, real{ra, 113} / real{rb, 113}));
+    }
+}
+
+#define MPPP_TEST_REAL_FIXED_UNARY(f)                                                                                  \
+    {                                                                                                                  \
+        rf256 rop;                                                                                                     \
+        REQUIRE(identical(f(a), f(ra)));                                                                               \
+        REQUIRE(&f(rop, a) == &rop);                                                                                   \
+        REQUIRE(identical(rop, f(ra)));                                                                                \
+        rop = a;                                                                                                       \
+        f(rop, rop);                                                                                                   \
+        REQUIRE(identical(rop, f(ra)));                                                                                \
+    }
+
+TEST_CASE("real_fixed functions")
+{
+    std::uniform_real_distribution<double> dist(-10., 10.);
+    for (int i = 0; i < ntrials; ++i) {
+        const real ra{dist(rng), 256};
+        const rf256 a{ra};
+
+        MPPP_TEST_REAL_FIXED_UNARY(sqrt)
+        MPPP_TEST_REAL_FIXED_UNARY(rec_sqrt)
+        MPPP_TEST_REAL_FIXED_UNARY(cbrt)
+        MPPP_TEST_REAL_FIXED_UNARY(sqr)
+        MPPP_TEST_REAL_FIXED_UNARY(sin)
+        MPPP_TEST_REAL_FIXED_UNARY(cos)
+        MPPP_TEST_REAL_FIXED_UNARY(tan)
+        MPPP_TEST_REAL_FIXED_UNARY(sec)
+        MPPP_TEST_REAL_FIXED_UNARY(csc)
+        MPPP_TEST_REAL_FIXED_UNARY(cot)
+        MPPP_TEST_REAL_FIXED_UNARY(asin)
+        MPPP_TEST_REAL_FIXED_UNARY(acos)
+        MPPP_TEST_REAL_FIXED_UNARY(atan)
+        MPPP_TEST_REAL_FIXED_UNARY(sinh)
+        MPPP_TEST_REAL_FIXED_UNARY(cosh)
+        MPPP_TEST_REAL_FIXED_UNARY(tanh)
+        MPPP_TEST_REAL_FIXED_UNARY(sech)
+        MPPP_TEST_REAL_FIXED_UNARY(csch)
+        MPPP_TEST_REAL_FIXED_UNARY(coth)
+        MPPP_TEST_REAL_FIXED_UNARY(asinh)
+        MPPP_TEST_REAL_FIXED_UNARY(acosh)
+        MPPP_TEST_REAL_FIXED_UNARY(atanh)
+        MPPP_TEST_REAL_FIXED_UNARY(exp)
+        MPPP_TEST_REAL_FIXED_UNARY(exp2)
+        MPPP_TEST_REAL_FIXED_UNARY(exp10)
+        MPPP_TEST_REAL_FIXED_UNARY(expm1)
+        MPPP_TEST_REAL_FIXED_UNARY(log)
+        MPPP_TEST_REAL_FIXED_UNARY(log2)
+        MPPP_TEST_REAL_FIXED_UNARY(log10)
+        MPPP_TEST_REAL_FIXED_UNARY(log1p)
+        MPPP_TEST_REAL_FIXED_UNARY(gamma)
+        MPPP_TEST_REAL_FIXED_UNARY(lngamma)
+        MPPP_TEST_REAL_FIXED_UNARY(lgamma)
+        MPPP_TEST_REAL_FIXED_UNARY(digamma)
+        MPPP_TEST_REAL_FIXED_UNARY(j0)
+        MPPP_TEST_REAL_FIXED_UNARY(j1)
+        MPPP_TEST_REAL_FIXED_UNARY(y0)
+        MPPP_TEST_REAL_FIXED_UNARY(y1)
+        MPPP_TEST_REAL_FIXED_UNARY(li2)
+        MPPP_TEST_REAL_FIXED_UNARY(eint)
+        MPPP_TEST_REAL_FIXED_UNARY(zeta)
+        MPPP_TEST_REAL_FIXED_UNARY(erf)
+        MPPP_TEST_REAL_FIXED_UNARY(erfc)
+        MPPP_TEST_REAL_FIXED_UNARY(ai)
+        MPPP_TEST_REAL_FIXED_UNARY(neg)
+        MPPP_TEST_REAL_FIXED_UNARY(abs)
+    }
+}
@@ -8,13 +8,18 @@
 
 #include <mp++/config.hpp>
 
+#include <cstddef>
 #include <limits>
+#include <memory>
 #include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <mp++/detail/mpfr.hpp>
 #include <mp++/detail/type_traits.hpp>
@@ -121,3 +126,177 @@ TEST_CASE("real io")
         REQUIRE(::mpfr_equal_p(real{123, 100}.get_mpfr_t(), real{oss.str(), 100}.get_mpfr_t()));
     }
 }
+
+// Check that the output of to_chars() is the shortest representation
+// of r in base base which reads back to r.
+static void check_shortest(const real &r, int base)
+{
+    std::vector<char> buffer(static_cast<std::size_t>(r.get_prec()) + 100u);
+    const auto ret = to_chars(buffer.data(), buffer.data() + buffer.size(), r, base);
+    REQUIRE(ret.ec == std::errc{});
+    const std::string str(buffer.data(), ret.ptr);
+    // Exact fit and buffer too small.
+    REQUIRE(to_chars(buffer.data(), buffer.data() + str.size(), r, base).ptr == buffer.data() + str.size());
+    REQUIRE(to_chars(buffer.data(), buffer.data() + str.size() - 1u, r, base).ec == std::errc::value_too_large);
+
+    // Parse back, with trailing characters.
+    const auto in = str + " ";
+    real r2{0, r.get_prec()};
+    const auto fret = from_chars(in.data(), in.data() + in.size(), r2, base);
+    REQUIRE(fret.ec == std::errc{});
+    REQUIRE(fret.ptr == in.data() + str.size());
+    REQUIRE(r2.get_prec() == r.get_prec());
+    REQUIRE(::mpfr_equal_p(r.get_mpfr_t(), r2.get_mpfr_t()));
+    REQUIRE(r2.signbit() == r.signbit());
+
+    // Count the significant digits.
+    const auto epos = str.find(base <= 10 ? 'e' : '@');
+    const auto mant = str.substr(0, epos);
+    const auto n = mant.size() - static_cast<std::size_t>(mant[0] == '-')
+                   - static_cast<std::size_t>(mant.find('.') != std::string::npos);
+    // NOTE: mpfr_get_str() might require at least 2 digits.
+    if (n <= 2u) {
+        return;
+    }
+    // The correctly-rounded representations with less digits do not read back to r.
+    for (auto k = n - 1u; k >= 2u; --k) {
+        ::mpfr_exp_t exp(0);
+        std::unique_ptr<char, void (*)(char *)> d(::mpfr_get_str(nullptr, &exp, base, k, r.get_mpfr_t(), MPFR_RNDN),
+                                                  ::mpfr_free_str);
+        std::string sd(d.get());
+        const auto neg = sd[0] == '-';
+        sd.insert(neg ? 2u : 1u, ".");
+        sd += "@" + std::to_string(exp - 1);
+        real r3{0, r.get_prec()};
+        REQUIRE(from_chars(sd.data(), sd.data() + sd.size(), r3, base).ec == std::errc{});
+        REQUIRE(!::mpfr_equal_p(r.get_mpfr_t(), r3.get_mpfr_t()));
+    }
+}
+
+TEST_CASE("real charconv")
+{
+    std::uniform_int_distribution<int> bdist(2, 62), sdist(0, 1);
+    std::uniform_int_distribution<::mpfr_prec_t> pdist(real_prec_min(), 300);
+    std::uniform_int_distribution<long> edist(-10000, 10000);
+    std::uniform_real_distribution<double> dist(-1E10, 1E10);
+    for (int i = 0; i < 1000; ++i) {
+        const auto base = sdist(rng) ? 10 : bdist(rng);
+        check_shortest(real{dist(rng), 100}, base);
+        real r{dist(rng), pdist(rng)};
+        ::mpfr_div_ui(r._get_mpfr_t(), r.get_mpfr_t(), 3, MPFR_RNDN);
+        ::mpfr_mul_2si(r._get_mpfr_t(), r.get_mpfr_t(), edist(rng), MPFR_RNDN);
+        check_shortest(r, base);
+        check_shortest(real{dist(rng), 53}, base);
+        check_shortest(real{rational<1>{static_cast<long long>(dist(rng)), 100}, 113}, base);
+        // Powers of two, where the lower neighbour is closer.
+        check_shortest(mul_2si(real{1, pdist(rng)}, edist(rng)), base);
+    }
+
+    // Special values and exponents.
+    char cbuf[100];
+    auto ret = to_chars(cbuf, cbuf + 100, real{"-inf", 10});
+    REQUIRE(std::string(cbuf, ret.ptr) == "-inf");
+    ret = to_chars(cbuf, cbuf + 100, real{"nan", 10}, 20);
+    REQUIRE(std::string(cbuf, ret.ptr) == "@nan@");
+    REQUIRE(to_chars(cbuf, cbuf + 3, real{"-inf", 10}).ec == std::errc::value_too_large);
+    ret = to_chars(cbuf, cbuf + 100, real{"1.5e-300", 64});
+    REQUIRE(std::string(cbuf, ret.ptr) == "1.5e-300");
+    ret = to_chars(cbuf, cbuf + 100, real{"0.1", 53});
+    REQUIRE(std::string(cbuf, ret.ptr) == "1e-1");
+    ret = to_chars(cbuf, cbuf + 100, real{"-0.1", 200});
+    REQUIRE(std::string(cbuf, ret.ptr) == "-1e-1");
+    ret = to_chars(cbuf, cbuf + 100, real{1, 64});
+    REQUIRE(std::string(cbuf, ret.ptr) == "1");
+    ret = to_chars(cbuf, cbuf + 100, real{1000, 64});
+    REQUIRE(std::string(cbuf, ret.ptr) == "1e+3");
+    ret = to_chars(cbuf, cbuf + 100, real{"123.25", 64});
+    REQUIRE(std::string(cbuf, ret.ptr) == "1.2325e+2");
+    ret = to_chars(cbuf, cbuf + 100, real{255, 64}, 16);
+    REQUIRE(std::string(cbuf, ret.ptr) == "f.f@+1");
+    ret = to_chars(cbuf, cbuf + 100, real{0, 64});
+    REQUIRE(std::string(cbuf, ret.ptr) == "0");
+    ret = to_chars(cbuf, cbuf + 100, -real{0, 64});
+    REQUIRE(std::string(cbuf, ret.ptr) == "-0");
+    REQUIRE(to_chars(cbuf, cbuf + 100, real{0, 64}, 1).ec == std::errc::invalid_argument);
+    check_shortest(mul_2si(real{1, real_prec_min()}, 10000), 10);
+    check_shortest(mul_2si(real{-1, real_prec_min()}, -10000), 7);
+
+    // Very large exponents.
+    for (const long ex : {100000l, -100000l, 1000000000l, -1000000000l}) {
+        for (const int base : {2, 10, 16, 7, 62}) {
+            check_shortest(mul_2si(real{1, 53} / 3, ex), base);
+            check_shortest(mul_2si(real{-1, 113} / 7, ex), base);
+            check_shortest(mul_2si(real{1, 53}, ex), base);
+            check_shortest(mul_2si(real{"1.1", 300}, ex), base);
+        }
+    }
+    ret = to_chars(cbuf, cbuf + 100, mul_2si(real{1, 53}, 1000000000l), 2);
+    REQUIRE(std::string(cbuf, ret.ptr) == "1e+1000000000");
+    ret = to_chars(cbuf, cbuf + 100, mul_2si(real{-3, 53}, -1000000000l), 2);
+    REQUIRE(std::string(cbuf, ret.ptr) == "-1.1e-999999999");
+
+    // Parsing errors leave the output untouched.
+    real r{42, 64};
+    const std::string bad[] = {"", "+1", " 1", "x"};
+    for (const auto &s : bad) {
+        const auto fret = from_chars(s.data(), s.data() + s.size(), r);
+        REQUIRE(fret.ec == std::errc::invalid_argument);
+        REQUIRE(fret.ptr == s.data());
+        REQUIRE(r == 42);
+    }
+    std::string s = "1.5";
+    REQUIRE(from_chars(s.data(), s.data() + s.size(), r, 70).ec == std::errc::invalid_argument);
+    REQUIRE(r == 42);
+    // The precision of the output is preserved.
+    real r3{0, 10};
+    s = "0.1";
+    REQUIRE(from_chars(s.data(), s.data() + s.size(), r3).ptr == s.data() + s.size());
+    REQUIRE(r3.get_prec() == 10);
+    REQUIRE(r3 == real{"0.1", 10});
+
+    // Only the value at the beginning of the range is consumed.
+    const struct {
+        std::string str;
+        int base;
+        std::size_t len;
+        real value;
+    } prefixes[] = {{"-1.25e+2 1", 10, 8, real{-125, 64}},
+                    {"1e5e", 10, 3, real{100000, 64}},
+                    {"0x1.8p1 2", 16, 7, real{3, 64}},
+                    {"1.f@2z", 16, 5, real{496, 64}},
+                    {"-0b101.1p-1,", 2, 11, real{"-2.75", 64}},
+                    {"zZ.1@1!", 62, 6, real{(61 * 62 + 35) * 62 + 1, 64}},
+                    {"@inf@@inf@", 36, 5, real{"inf", 64}},
+                    {"-infinity1", 10, 9, -real{"inf", 64}},
+                    {"inf1", 10, 3, real{"inf", 64}}};
+    for (const auto &p : prefixes) {
+        real r4{0, 64};
+        const auto fret = from_chars(p.str.data(), p.str.data() + p.str.size(), r4, p.base);
+        REQUIRE(fret.ec == std::errc{});
+        REQUIRE(fret.ptr == p.str.data() + p.len);
+        REQUIRE(r4 == p.value);
+    }
+    const std::pair<std::string, std::size_t> nans[] = {{"nan(12_ab)x", 10}, {"@NaN@(1)x", 8}, {"nan(x", 3}};
+    for (const auto &p : nans) {
+        real r4{0, 64};
+        const auto fret = from_chars(p.first.data(), p.first.data() + p.first.size(), r4);
+        REQUIRE(fret.ec == std::errc{});
+        REQUIRE(fret.ptr == p.first.data() + p.second);
+        REQUIRE(r4.nan_p());
+    }
+
+    // Many values in a long range.
+    s.clear();
+    for (int i = 0; i < 100000; ++i) {
+        s += std::to_string(i) + ".5 ";
+    }
+    auto ptr = s.data();
+    for (int i = 0; i < 100000; ++i) {
+        real r4{0, 64};
+        const auto fret = from_chars(ptr, s.data() + s.size(), r4);
+        REQUIRE(fret.ec == std::errc{});
+        REQUIRE(r4 == real{i, 64} + 0.5);
+        ptr = fret.ptr + 1;
+    }
+    REQUIRE(ptr == s.data() + s.size());
+}
@@ -7,8 +7,10 @@
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <stdexcept>
+#include <cstddef>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <mp++/config.hpp>
 #include <mp++/integer.hpp>
@@ -419,4 +421,93 @@ TEST_CASE("real trig arb")
     }
 }
 
+// Check that two reals are identical (including NaNs and precision).
+static bool batch_identical(const real &a, const real &b)
+{
+    if (a.get_prec() != b.get_prec()) {
+        return false;
+    }
+    if (a.nan_p() || b.nan_p()) {
+        return a.nan_p() && b.nan_p();
+    }
+    return a == b && a.signbit() == b.signbit();
+}
+
+TEST_CASE("real batch arb")
+{
+    // Operands with various precisions and special values.
+    std::vector<real> v;
+    for (int i = -20; i <= 20; ++i) {
+        v.emplace_back(real{i, 64 + i * 3} / 7);
+        v.emplace_back(real{i, 128} / 2);
+    }
+    v.emplace_back(real{"inf", 100});
+    v.emplace_back(-real{"inf", 200});
+    v.emplace_back(real{"nan", 150});
+    v.emplace_back(real{0, 32});
+    v.emplace_back(-real{0, 300});
+
+#define MPPP_CHECK_BATCH_ARB(f)                                                                                        \
+    {                                                                                                                  \
+        /* Outputs with different precisions. */                                                                       \
+        std::vector<real> out(v.size(), real{1, 80});                                                                  \
+        batch::f(out.data(), v.data(), v.size());                                                                      \
+        for (std::size_t i = 0; i < v.size(); ++i) {                                                                   \
+            REQUIRE(batch_identical(out[i], f(v[i])));                                                                 \
+        }                                                                                                              \
+        /* Outputs with matching precisions. */                                                                        \
+        batch::f(out.data(), v.data(), v.size());                                                                      \
+        for (std::size_t i = 0; i < v.size(); ++i) {                                                                   \
+            REQUIRE(batch_identical(out[i], f(v[i])));                                                                 \
+        }                                                                                                              \
+        /* Overlapping input and output. */                                                                            \
+        out = v;                                                                                                       \
+        batch::f(out.data(), out.data(), out.size());                                                                  \
+        for (std::size_t i = 0; i < v.size(); ++i) {                                                                   \
+            REQUIRE(batch_identical(out[i], f(v[i])));                                                                 \
+        }                                                                                                              \
+        /* Partially overlapping input and output. */                                                                  \
+        out = v;                                                                                                       \
+        batch::f(out.data(), out.data() + 1, out.size() - 1u);                                                         \
+        for (std::size_t i = 0; i + 1u < v.size(); ++i) {                                                              \
+            REQUIRE(batch_identical(out[i], f(v[i + 1u])));                                                            \
+        }                                                                                                              \
+        /* Empty range. */                                                                                             \
+        batch::f(out.data(), v.data(), 0);                                                                             \
+    }
+
+    MPPP_CHECK_BATCH_ARB(sqrt1pm1)
+    MPPP_CHECK_BATCH_ARB(sin_pi)
+    MPPP_CHECK_BATCH_ARB(cos_pi)
+    MPPP_CHECK_BATCH_ARB(tan_pi)
+    MPPP_CHECK_BATCH_ARB(cot_pi)
+    MPPP_CHECK_BATCH_ARB(sinc)
+    MPPP_CHECK_BATCH_ARB(sinc_pi)
+
+#undef MPPP_CHECK_BATCH_ARB
+
+    // log_hypot.
+    std::vector<real> w(v.rbegin(), v.rend());
+    std::vector<real> out(v.size());
+    batch::log_hypot(out.data(), v.data(), w.data(), v.size());
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        REQUIRE(batch_identical(out[i], log_hypot(v[i], w[i])));
+    }
+    out = v;
+    batch::log_hypot(out.data(), out.data(), w.data(), v.size());
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        REQUIRE(batch_identical(out[i], log_hypot(v[i], w[i])));
+    }
+    out = w;
+    batch::log_hypot(out.data(), v.data(), out.data(), v.size());
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        REQUIRE(batch_identical(out[i], log_hypot(v[i], w[i])));
+    }
+
+    // Precision checking.
+    std::vector<real> bad{real{1, 1}};
+    out.resize(1);
+    REQUIRE_THROWS_AS(batch::sin_pi(out.data(), bad.data(), 1), std::invalid_argument);
+}
+
 #endif
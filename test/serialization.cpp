@@ -0,0 +1,557 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <mp++/config.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+#include <mp++/serialization.hpp>
+
+#if defined(MPPP_WITH_MPFR)
+#include <mp++/real.hpp>
+#endif
+
+#if defined(MPPP_WITH_QUADMATH)
+#include <mp++/real128.hpp>
+#endif
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace mppp;
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
+                         std::integral_constant<std::size_t, 10>>;
+
+static int ntries = 1000;
+
+static std::mt19937 rng;
+
+static std::vector<char> bytes(std::initializer_list<int> l)
+{
+    std::vector<char> retval;
+    for (auto c : l) {
+        retval.push_back(static_cast<char>(static_cast<unsigned char>(c)));
+    }
+    return retval;
+}
+
+template <typename T>
+static std::vector<char> save(const T &x)
+{
+    std::vector<char> retval;
+    REQUIRE(portable_binary_save(x, retval) == portable_binary_size(x));
+    REQUIRE(retval.size() == portable_binary_size(x));
+    return retval;
+}
+
+template <typename T, typename F>
+static void check_error(const std::vector<char> &buf, const F &pred)
+{
+    T tmp;
+    REQUIRE_THROWS_PREDICATE(portable_binary_load(tmp, buf), std::invalid_argument, pred);
+}
+
+struct s11n_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        using rational = rational<S::value>;
+
+        // Fixed encodings.
+        REQUIRE(save(integer{}) == bytes({1, 0, 0}));
+        REQUIRE(save(integer{1}) == bytes({1, 0, 2, 1, 0, 0, 0, 0, 0, 0, 0}));
+        REQUIRE(save(integer{-258}) == bytes({1, 0, 3, 2, 1, 0, 0, 0, 0, 0, 0}));
+        REQUIRE(save(-(integer{1} << 64)) == bytes({1, 0, 5, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0}));
+        REQUIRE(save(rational{-1, 2}) == bytes({1, 1, 3, 1, 0, 0, 0, 0, 0, 0, 0, 2, 2, 0, 0, 0, 0, 0, 0, 0}));
+        REQUIRE(save(rational{}) == bytes({1, 1, 0, 2, 1, 0, 0, 0, 0, 0, 0, 0}));
+
+        // Random round trips, using all the available interfaces.
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1);
+        std::uniform_int_distribution<unsigned> ldist(0, S::value * 2u + 1u);
+        auto random_int = [&]() {
+            random_integer(tmp, ldist(rng), rng);
+            integer retval{&tmp.m_mpz};
+            if (sdist(rng)) {
+                retval.neg();
+            }
+            if (sdist(rng)) {
+                retval.promote();
+            }
+            return retval;
+        };
+        std::vector<char> buf;
+        std::stringstream ss;
+        for (int i = 0; i < ntries; ++i) {
+            const auto n = random_int();
+            auto m = random_int();
+            buf.resize(portable_binary_size(n));
+            REQUIRE(portable_binary_save(n, buf.data()) == buf.size());
+            REQUIRE(portable_binary_load(m, buf.data(), buf.size()) == buf.size());
+            REQUIRE(m == n);
+            // The storage type depends only on the value.
+            REQUIRE(m.is_static() == (m.size() <= S::value));
+            m = random_int();
+            REQUIRE(portable_binary_load(m, save(n)) == buf.size());
+            REQUIRE(m == n);
+
+            auto den = random_int();
+            if (den.is_zero()) {
+                den = 1;
+            }
+            const rational q{n, den};
+            rational r{random_int(), 3};
+            REQUIRE(portable_binary_load(r, save(q)) == portable_binary_size(q));
+            REQUIRE(r == q);
+
+            // Streams, with multiple values.
+            ss.str("");
+            ss.clear();
+            REQUIRE(portable_binary_save(n, ss) == portable_binary_size(n));
+            REQUIRE(portable_binary_save(q, ss) == portable_binary_size(q));
+            REQUIRE(portable_binary_save(n, ss) == portable_binary_size(n));
+            m = random_int();
+            REQUIRE(portable_binary_load(m, ss) == portable_binary_size(n));
+            REQUIRE(m == n);
+            r = rational{random_int(), 5};
+            REQUIRE(portable_binary_load(r, ss) == portable_binary_size(q));
+            REQUIRE(r == q);
+            m = random_int();
+            REQUIRE(portable_binary_load(m, ss) == portable_binary_size(n));
+            REQUIRE(m == n);
+            // Reading past the end of the stream.
+            m = 42;
+            REQUIRE(portable_binary_load(m, ss) == 0u);
+            REQUIRE(m == 42);
+        }
+
+        // Truncated stream.
+        ss.str("");
+        ss.clear();
+        buf = save(integer{1} << 200);
+        buf.pop_back();
+        ss.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+        integer n{-3};
+        REQUIRE(portable_binary_load(n, ss) == 0u);
+        REQUIRE(n == -3);
+
+        // Error handling.
+        check_error<integer>(bytes({}), [](const std::invalid_argument &ex) {
+            return std::string(ex.what())
+                   == "Truncated data detected in a portable binary deserialisation: 2 byte(s) are needed, but only 0 "
+                      "are available in the source buffer";
+        });
+        check_error<integer>(bytes({1, 0, 4, 0, 0, 0}), [](const std::invalid_argument &ex) {
+            return std::string(ex.what())
+                   == "Truncated data detected in a portable binary deserialisation: 16 byte(s) are needed, but only 3 "
+                      "are available in the source buffer";
+        });
+        check_error<integer>(bytes({2, 0, 0}), [](const std::invalid_argument &ex) {
+            return std::string(ex.what())
+                   == "Unsupported version 2 of the portable binary serialisation format detected (the current "
+                      "version is 1)";
+        });
+        check_error<integer>(bytes({0, 0, 0}), [](const std::invalid_argument &ex) {
+            return std::string(ex.what())
+                   == "Unsupported version 0 of the portable binary serialisation format detected (the current "
+                      "version is 1)";
+        });
+        check_error<integer>(save(rational{}), [](const std::invalid_argument &ex) {
+            return std::string(ex.what())
+                   == "Invalid type tag detected in the portable binary deserialisation of an integer: the expected tag "
+                      "is 0, but the tag 1 was found instead";
+        });
+        check_error<rational>(save(integer{}), [](const std::invalid_argument &ex) {
+            return std::string(ex.what())
+                   == "Invalid type tag detected in the portable binary deserialisation of a rational: the expected "
+                      "tag is 1, but the tag 0 was found instead";
+        });
+        check_error<integer>(bytes({1, 0, 1}), [](const std::invalid_argument &ex) {
+            return std::string(ex.what())
+                   == "Invalid data detected in the portable binary deserialisation of an integer: zero cannot be "
+                      "negative";
+        });
+        check_error<integer>(bytes({1, 0, 4, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}),
+                             [](const std::invalid_argument &ex) {
+                                 return std::string(ex.what())
+                                        == "Invalid data detected in the portable binary deserialisation of an "
+                                           "integer: the most significant word of the value cannot be zero";
+                             });
+        check_error<integer>(bytes({1, 0, 128, 128, 128, 128, 128, 128, 128, 128, 128, 2}),
+                             [](const std::invalid_argument &ex) {
+                                 return std::string(ex.what())
+                                        == "Invalid data detected in a portable binary deserialisation: a "
+                                           "variable-length integer does not fit in 64 bits";
+                             });
+        check_error<rational>(bytes({1, 1, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0}), [](const std::invalid_argument &ex) {
+            return std::string(ex.what())
+                   == "Invalid data detected in the portable binary deserialisation of a rational: the denominator "
+                      "must be positive";
+        });
+        check_error<rational>(bytes({1, 1, 2, 1, 0, 0, 0, 0, 0, 0, 0, 3, 2, 0, 0, 0, 0, 0, 0, 0}),
+                              [](const std::invalid_argument &ex) {
+                                  return std::string(ex.what())
+                                         == "Invalid data detected in the portable binary deserialisation of a "
+                                            "rational: the denominator must be positive";
+                              });
+        check_error<rational>(bytes({1, 1, 2, 2, 0, 0, 0, 0, 0, 0, 0, 2, 4, 0, 0, 0, 0, 0, 0, 0}),
+                              [](const std::invalid_argument &ex) {
+                                  return std::string(ex.what())
+                                         == "Invalid data detected in the portable binary deserialisation of a "
+                                            "rational: the value is not in canonical form";
+                              });
+        // A failed load leaves integers untouched and resets rationals to zero.
+        n = 5;
+        REQUIRE_THROWS_AS(portable_binary_load(n, bytes({1, 0, 1})), std::invalid_argument);
+        REQUIRE(n == 5);
+        rational q{1, 3};
+        REQUIRE_THROWS_AS(portable_binary_load(q, bytes({1, 1, 2, 2, 0, 0, 0, 0, 0, 0, 0, 2, 4, 0, 0, 0, 0, 0, 0, 0})),
+                          std::invalid_argument);
+        REQUIRE(q.is_zero());
+        REQUIRE(q.get_den() == 1);
+    }
+};
+
+TEST_CASE("portable serialisation")
+{
+    tuple_for_each(sizes{}, s11n_tester{});
+
+    // Integers of different static sizes are compatible.
+    integer<3> n3;
+    REQUIRE(portable_binary_load(n3, save(integer<1>{1} << 150)) == 27u);
+    REQUIRE(n3 == integer<3>{1} << 150);
+    REQUIRE(n3.is_static());
+}
+
+struct s11n_range_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        using rational = rational<S::value>;
+
+        auto save_range = [](const std::vector<integer> &v) {
+            std::vector<char> retval;
+            REQUIRE(binary_save_range(v.data(), v.size(), retval) == binary_range_size(v.data(), v.size()));
+            REQUIRE(retval.size() == binary_range_size(v.data(), v.size()));
+            return retval;
+        };
+
+        // Fixed encodings.
+        std::vector<integer> vn{integer{}, integer{1}, integer{-258}}, vn2;
+        REQUIRE(save_range(vn)
+                == bytes({1, 4, 3, 2, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 0, 0, 0, 2, 3}));
+        std::vector<rational> vq{rational{-1, 2}}, vq2;
+        std::vector<char> buf;
+        REQUIRE(binary_save_range(vq.data(), vq.size(), buf) == 29u);
+        REQUIRE(buf
+                == bytes({1, 5, 1, 2, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 3, 2}));
+        REQUIRE(binary_load_range(vq2, buf) == 29u);
+        REQUIRE(vq2 == vq);
+
+        // Empty ranges.
+        REQUIRE(save_range(vn2) == bytes({1, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
+        vn = std::vector<integer>{integer{1}};
+        REQUIRE(binary_load_range(vn, bytes({1, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0})) == 11u);
+        REQUIRE(vn.empty());
+
+        // Random round trips.
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1);
+        std::uniform_int_distribution<unsigned> ldist(0, S::value * 2u + 1u), ndist(0, 20);
+        auto random_int = [&]() {
+            random_integer(tmp, ldist(rng), rng);
+            integer retval{&tmp.m_mpz};
+            if (sdist(rng)) {
+                retval.neg();
+            }
+            return retval;
+        };
+        for (int i = 0; i < ntries / 10; ++i) {
+            vn.resize(ndist(rng));
+            vq.resize(vn.size());
+            for (std::size_t j = 0; j < vn.size(); ++j) {
+                vn[j] = random_int();
+                auto den = random_int();
+                if (den.is_zero()) {
+                    den = 1;
+                }
+                vq[j] = rational{vn[j], den};
+            }
+            buf = save_range(vn);
+            // Start sometimes from a longer output vector.
+            vn2.resize(ndist(rng));
+            REQUIRE(binary_load_range(vn2, buf.data(), buf.size()) == buf.size());
+            REQUIRE(vn2 == vn);
+            for (const auto &n : vn2) {
+                REQUIRE(n.is_static() == (n.size() <= S::value));
+            }
+            buf.resize(binary_range_size(vq.data(), vq.size()));
+            REQUIRE(binary_save_range(vq.data(), vq.size(), buf.data()) == buf.size());
+            vq2.resize(ndist(rng));
+            REQUIRE(binary_load_range(vq2, buf) == buf.size());
+            REQUIRE(vq2 == vq);
+
+            // The range format is never larger than the concatenation of the individual values.
+            std::size_t tot = 0;
+            for (const auto &n : vn) {
+                tot += portable_binary_size(n);
+            }
+            REQUIRE(save_range(vn).size() <= tot + 20u);
+        }
+
+        // The storage of the existing values is reused.
+        vn = std::vector<integer>{integer{1} << (S::value * unsigned(GMP_NUMB_BITS) * 2u)};
+        const auto ptr = vn[0].get_mpz_t()->_mp_d;
+        REQUIRE(binary_load_range(vn, save_range({(integer{1} << (S::value * unsigned(GMP_NUMB_BITS) + 1u)) + 1}))
+                > 0u);
+        REQUIRE(vn[0] == (integer{1} << (S::value * unsigned(GMP_NUMB_BITS) + 1u)) + 1);
+        REQUIRE(vn[0].get_mpz_t()->_mp_d == ptr);
+
+        // Error handling.
+        REQUIRE_THROWS_PREDICATE(binary_load_range(vn, bytes({1, 5, 0, 0})), std::invalid_argument,
+                                 [](const std::invalid_argument &ex) {
+                                     return std::string(ex.what())
+                                            == "Invalid type tag detected in the portable binary deserialisation of "
+                                               "a range of integers: the expected tag is 4, but the tag 5 was "
+                                               "found instead";
+                                 });
+        REQUIRE_THROWS_PREDICATE(binary_load_range(vn, bytes({1, 4, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0})),
+                                 std::invalid_argument, [](const std::invalid_argument &ex) {
+                                     return std::string(ex.what())
+                                            == "Invalid data detected in the portable binary deserialisation of "
+                                               "a range of integers: the number of values is larger than the size of "
+                                               "the array of headers";
+                                 });
+        // More words in the headers than in the range, and vice versa.
+        for (const auto &b : {bytes({1, 4, 1, 0, 0, 0, 0, 0, 0, 0, 0, 2}),
+                              bytes({1, 4, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0})}) {
+            REQUIRE_THROWS_PREDICATE(binary_load_range(vn, b), std::invalid_argument,
+                                     [](const std::invalid_argument &ex) {
+                                         return std::string(ex.what())
+                                                == "Invalid data detected in the portable binary deserialisation of "
+                                                   "a range of integers: the number of words is inconsistent with the "
+                                                   "array of headers";
+                                     });
+        }
+        REQUIRE_THROWS_PREDICATE(binary_load_range(vn, bytes({1, 4, 1, 1, 0, 0, 0, 0, 0, 0, 0, 2, 1, 0})),
+                                 std::invalid_argument, [](const std::invalid_argument &ex) {
+                                     return std::string(ex.what())
+                                            == "Truncated data detected in a portable binary deserialisation: 8 "
+                                               "byte(s) are needed, but only 3 are available in the source buffer";
+                                 });
+        REQUIRE_THROWS_PREDICATE(
+            binary_load_range(vn, bytes({1, 4, 0, 0, 0, 0, 0, 0, 0, 0, 32})), std::overflow_error,
+            [](const std::overflow_error &ex) {
+                return std::string(ex.what())
+                       == "Overflow in the computation of the size of a range of values being deserialised from the "
+                          "portable binary format";
+            });
+        REQUIRE_THROWS_AS(binary_load_range(vn, bytes({1, 4, 2, 4})), std::invalid_argument);
+        REQUIRE_THROWS_AS(binary_load_range(vn, bytes({1, 4, 1, 0, 0, 0, 0, 0, 0, 0, 0})), std::invalid_argument);
+        REQUIRE_THROWS_AS(binary_load_range(vn, bytes({1, 4, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1})), std::invalid_argument);
+        // Zero denominator.
+        REQUIRE_THROWS_AS(
+            binary_load_range(vq, bytes({1, 5, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 2, 0})),
+            std::invalid_argument);
+        // Non-canonical rational.
+        REQUIRE_THROWS_AS(binary_load_range(vq, bytes({1, 5, 1, 2, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0,
+                                                       4, 0, 0, 0, 0, 0, 0, 0, 2, 2})),
+                          std::invalid_argument);
+    }
+};
+
+TEST_CASE("portable range serialisation")
+{
+    tuple_for_each(sizes{}, s11n_range_tester{});
+}
+
+TEST_CASE("portable serialisation limb packing")
+{
+    // Check the generic packing routines with 32-bit limbs against the fixed format.
+    std::uniform_int_distribution<std::uint32_t> dist;
+    std::uniform_int_distribution<unsigned> ldist(0, 9);
+    std::vector<std::uint32_t> l32, l32_2;
+    std::vector<char> buf, buf2;
+    for (int i = 0; i < ntries; ++i) {
+        const auto nl = ldist(rng);
+        l32.resize(nl);
+        for (auto &l : l32) {
+            l = dist(rng);
+        }
+        // Left-aligned storage, as in real.
+        const auto nw = nl / 2u + nl % 2u;
+        const auto shift = nw * 64u - nl * 32u;
+        buf.resize(nw * 8u);
+        detail::s11n_pack_limbs<32>(buf.data(), nw, l32.data(), nl, shift);
+        // Compare with the byte representation.
+        for (std::size_t j = 0; j < nl; ++j) {
+            for (std::size_t k = 0; k < 4u; ++k) {
+                REQUIRE(static_cast<unsigned char>(buf[shift / 8u + j * 4u + k]) == ((l32[j] >> (8u * k)) & 0xffu));
+            }
+        }
+        if (shift) {
+            REQUIRE(std::all_of(buf.begin(), buf.begin() + 4, [](char c) { return c == 0; }));
+        }
+        l32_2.resize(nl);
+        detail::s11n_unpack_limbs<32>(l32_2.data(), nl, buf.data(), nw, shift);
+        REQUIRE(l32 == l32_2);
+
+        // Odd bit sizes, and agreement with the 32-bit packing.
+        std::vector<std::uint64_t> l64(nl);
+        for (std::size_t j = 0; j < nl; ++j) {
+            l64[j] = l32[j];
+        }
+        buf2.resize(nw * 8u);
+        detail::s11n_pack_limbs<32>(buf2.data(), nw, l64.data(), nl, shift);
+        REQUIRE(buf == buf2);
+        std::vector<std::uint64_t> l21(nl * 2u);
+        for (auto &l : l21) {
+            l = dist(rng) & ((1u << 21) - 1u);
+        }
+        const auto nw21 = (nl * 42u) / 64u + ((nl * 42u) % 64u != 0u);
+        buf2.resize(nw21 * 8u);
+        detail::s11n_pack_limbs<21>(buf2.data(), nw21, l21.data(), l21.size(), 0);
+        std::vector<std::uint64_t> l21_2(l21.size());
+        detail::s11n_unpack_limbs<21>(l21_2.data(), l21_2.size(), buf2.data(), nw21, 0);
+        REQUIRE(l21 == l21_2);
+    }
+}
+
+#if defined(MPPP_WITH_MPFR)
+
+static bool identical(const real &a, const real &b)
+{
+    return a.get_prec() == b.get_prec()
+           && ((a.nan_p() && b.nan_p()) || (a == b && a.signbit() == b.signbit()));
+}
+
+TEST_CASE("portable serialisation real")
+{
+    REQUIRE(save(real{1, 53}) == bytes({1, 2, 53, 1, 2, 0, 0, 0, 0, 0, 0, 0, 128}));
+    REQUIRE(save(real{-0.75, 64}) == bytes({1, 2, 64, 129, 0, 0, 0, 0, 0, 0, 0, 0, 192}));
+    REQUIRE(save(real{0, 10}) == bytes({1, 2, 10, 0}));
+    REQUIRE(save(-real{0, 10}) == bytes({1, 2, 10, 128}));
+    REQUIRE(save(real{"inf", 200}) == bytes({1, 2, 200, 1, 2}));
+    REQUIRE(save(real{"-inf", 200}) == bytes({1, 2, 200, 1, 130}));
+    REQUIRE(save(real{"nan", 200}) == bytes({1, 2, 200, 1, 3}));
+
+    std::uniform_int_distribution<::mpfr_prec_t> pdist(real_prec_min(), 1000);
+    std::uniform_int_distribution<int> edist(-1000, 1000), sdist(0, 1);
+    std::stringstream ss;
+    for (int i = 0; i < ntries; ++i) {
+        const auto p = pdist(rng);
+        detail::mpz_raii tmp;
+        random_integer(tmp, static_cast<unsigned>(p / GMP_NUMB_BITS + 1), rng);
+        real x{integer<1>{&tmp.m_mpz}, p};
+        mul_2si(x, x, edist(rng));
+        if (sdist(rng)) {
+            x.neg();
+        }
+        real y{42, pdist(rng)};
+        REQUIRE(portable_binary_load(y, save(x)) == portable_binary_size(x));
+        REQUIRE(identical(x, y));
+        ss.str("");
+        ss.clear();
+        REQUIRE(portable_binary_save(x, ss) == portable_binary_size(x));
+        y = real{};
+        REQUIRE(portable_binary_load(y, ss) == portable_binary_size(x));
+        REQUIRE(identical(x, y));
+    }
+    for (const auto &x : {real{0, 12}, -real{0, 12}, real{"inf", 70}, real{"-inf", 70}, real{"nan", 700}}) {
+        real y{1, 100};
+        REQUIRE(portable_binary_load(y, save(x)) == portable_binary_size(x));
+        REQUIRE(identical(x, y));
+    }
+
+    // Error handling.
+    check_error<real>(bytes({1, 2, 0, 0}), [](const std::invalid_argument &ex) {
+        return std::string(ex.what())
+               == "Invalid data detected in the portable binary deserialisation of a real: the precision 0 is outside "
+                  "the allowed range";
+    });
+    check_error<real>(bytes({1, 2, 53, 4}), [](const std::invalid_argument &ex) {
+        return std::string(ex.what())
+               == "Invalid data detected in the portable binary deserialisation of a real: invalid kind byte 4";
+    });
+    check_error<real>(bytes({1, 2, 53, 131}), [](const std::invalid_argument &ex) {
+        return std::string(ex.what())
+               == "Invalid data detected in the portable binary deserialisation of a real: invalid kind byte 131";
+    });
+    check_error<real>(bytes({1, 2, 53, 1, 2, 0, 0, 0, 0, 0, 0, 0, 64}), [](const std::invalid_argument &ex) {
+        return std::string(ex.what())
+               == "Invalid data detected in the portable binary deserialisation of a real: the significand is not "
+                  "normalised";
+    });
+    check_error<real>(bytes({1, 2, 53, 1, 2, 1, 0, 0, 0, 0, 0, 0, 128}), [](const std::invalid_argument &ex) {
+        return std::string(ex.what())
+               == "Invalid data detected in the portable binary deserialisation of a real: the significand is not "
+                  "normalised";
+    });
+    check_error<real>(bytes({1, 2, 53, 1, 128, 128, 128, 128, 128, 128, 128, 128, 1, 0, 0, 0, 0, 0, 0, 0, 128}),
+                      [](const std::invalid_argument &ex) {
+                          return std::string(ex.what())
+                                 == "Invalid data detected in the portable binary deserialisation of a real: the "
+                                    "exponent is outside the current exponent range";
+                      });
+}
+
+#endif
+
+#if defined(MPPP_WITH_QUADMATH)
+
+TEST_CASE("portable serialisation real128")
+{
+    REQUIRE(save(real128{1}) == bytes({1, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 255, 63}));
+    REQUIRE(save(real128{-2}) == bytes({1, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 192}));
+    REQUIRE(save(real128{}) == bytes({1, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
+
+    std::uniform_real_distribution<double> dist(-1E6, 1E6);
+    std::stringstream ss;
+    for (int i = 0; i < ntries; ++i) {
+        const auto x = real128{dist(rng)} / 3;
+        real128 y;
+        REQUIRE(portable_binary_load(y, save(x)) == 18u);
+        REQUIRE(y == x);
+        REQUIRE(portable_binary_save(x, ss) == 18u);
+    }
+    for (const auto &x : {real128_inf(), -real128_inf(), -real128{}, real128_max(), real128_denorm_min()}) {
+        real128 y{42};
+        REQUIRE(portable_binary_load(y, save(x)) == 18u);
+        REQUIRE(y == x);
+        REQUIRE(y.signbit() == x.signbit());
+    }
+    real128 y;
+    REQUIRE(portable_binary_load(y, save(real128_nan())) == 18u);
+    REQUIRE(y.isnan());
+
+    check_error<real128>(save(integer<1>{}), [](const std::invalid_argument &ex) {
+        return std::string(ex.what())
+               == "Invalid type tag detected in the portable binary deserialisation of a real128: the expected tag "
+                  "is 3, but the tag 0 was found instead";
+    });
+}
+
+#endif
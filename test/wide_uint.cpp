@@ -0,0 +1,231 @@
+// Copyright 2016-2020 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <mp++/config.hpp>
+
+#include <cstddef>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/exceptions.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/wide_uint.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+using namespace mppp;
+using namespace mppp_test;
+
+using widths = std::tuple<std::integral_constant<std::size_t, GMP_NUMB_BITS>,
+                          std::integral_constant<std::size_t, GMP_NUMB_BITS * 2>,
+                          std::integral_constant<std::size_t, GMP_NUMB_BITS * 3>,
+                          std::integral_constant<std::size_t, 256>, std::integral_constant<std::size_t, 512>>;
+
+static int ntries = 1000;
+
+static std::mt19937 rng;
+
+#if MPPP_CPLUSPLUS >= 201402L
+
+// Constexpr testing.
+constexpr wide_uint<256> constexpr_test()
+{
+    wide_uint<256> a{1}, b{-1};
+    a <<= 200;
+    a = a * 3 + b;
+    a -= 2;
+    ++a;
+    a = (a ^ b) >> 1;
+    return a;
+}
+
+static_assert(constexpr_test() != wide_uint<256>{}, "");
+static_assert(wide_uint<256>{-1} + 1 == 0, "");
+static_assert(wide_uint<256>{-1}.nbits() == 256u, "");
+static_assert(static_cast<unsigned>(wide_uint<256>{1} << 10) == 1024u, "");
+static_assert((wide_uint<512>{1} << 511) > (wide_uint<512>{1} << 510), "");
+
+#endif
+
+struct wide_uint_tester {
+    template <typename B>
+    void operator()(const B &) const
+    {
+        using wide = wide_uint<B::value>;
+        using int_t = integer<1>;
+        constexpr auto nlimbs = B::value / GMP_NUMB_BITS;
+        REQUIRE(wide::nlimbs == nlimbs);
+
+        // The modulus.
+        const auto mod = int_t{1} << B::value;
+        auto reduce = [&mod](const int_t &n) {
+            int_t q, r;
+            tdiv_qr(q, r, n, mod);
+            if (r.sgn() < 0) {
+                r += mod;
+            }
+            return r;
+        };
+
+        // Construction and conversion.
+        REQUIRE(wide{}.is_zero());
+        REQUIRE(wide{}.size() == 0u);
+        REQUIRE(wide{}.nbits() == 0u);
+        REQUIRE(wide{42}.data()[0] == 42u);
+        REQUIRE(static_cast<unsigned>(wide{42}) == 42u);
+        REQUIRE(static_cast<bool>(wide{42}));
+        REQUIRE(!static_cast<bool>(wide{}));
+        REQUIRE(static_cast<int_t>(wide{-1}) == mod - 1);
+        REQUIRE(static_cast<int_t>(wide{-42ll}) == mod - 42);
+        REQUIRE(static_cast<unsigned long long>(wide{-1}) == static_cast<unsigned long long>(-1));
+        REQUIRE(static_cast<unsigned char>(wide{257}) == 1u);
+        REQUIRE(wide{true} == 1);
+        REQUIRE(wide{int_t{-3}} == wide{-3});
+        REQUIRE(wide{mod + 5} == 5);
+        REQUIRE(wide{-1}.nbits() == B::value);
+        REQUIRE(wide{-1}.size() == nlimbs);
+        REQUIRE(wide{12345}.to_string() == "12345");
+        REQUIRE(wide{255}.to_string(16) == "ff");
+        std::ostringstream oss;
+        oss << wide{-1};
+        REQUIRE(oss.str() == (mod - 1).to_string());
+
+        // Division by zero.
+        REQUIRE_THROWS_PREDICATE(wide{1} / wide{}, zero_division_error, [](const zero_division_error &ex) {
+            return std::string(ex.what()) == "Integer division by zero";
+        });
+        REQUIRE_THROWS_AS(wide{1} % wide{}, zero_division_error);
+
+        // Increment/decrement with carry propagation.
+        wide w{-1};
+        REQUIRE((++w).is_zero());
+        REQUIRE((w--).is_zero());
+        REQUIRE(w == wide{-1});
+        REQUIRE(w++ == wide{-1});
+        REQUIRE(w.is_zero());
+        --w;
+        REQUIRE(w == wide{-1});
+
+        // Hashing.
+        std::unordered_set<wide> us{wide{1}, wide{2}, wide{1}};
+        REQUIRE(us.size() == 2u);
+        REQUIRE(hash(wide{-1}) == std::hash<wide>{}(wide{-1}));
+
+        // Random testing against integer.
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<unsigned> ldist(0, static_cast<unsigned>(nlimbs) + 1u);
+        std::uniform_int_distribution<std::size_t> sdist(0, B::value + 10u);
+        auto random_int = [&]() {
+            random_integer(tmp, ldist(rng), rng);
+            return reduce(int_t{&tmp.m_mpz});
+        };
+        for (int i = 0; i < ntries; ++i) {
+            const auto a = random_int(), b = random_int();
+            const wide wa{a}, wb{b};
+            REQUIRE(static_cast<int_t>(wa) == a);
+            REQUIRE(wa.nbits() == a.nbits());
+            REQUIRE(wa.size() == a.size());
+            REQUIRE(static_cast<int_t>(wa + wb) == reduce(a + b));
+            REQUIRE(static_cast<int_t>(wa - wb) == reduce(a - b));
+            REQUIRE(static_cast<int_t>(wa * wb) == reduce(a * b));
+            REQUIRE(static_cast<int_t>(-wa) == reduce(-a));
+            REQUIRE(static_cast<int_t>(~wa) == mod - 1 - a);
+            REQUIRE(static_cast<int_t>(wa & wb) == (a & b));
+            REQUIRE(static_cast<int_t>(wa | wb) == (a | b));
+            REQUIRE(static_cast<int_t>(wa ^ wb) == (a ^ b));
+            const auto s = sdist(rng);
+            REQUIRE(static_cast<int_t>(wa << s) == reduce(a << s));
+            REQUIRE(static_cast<int_t>(wa >> s) == (a >> s));
+            REQUIRE((wa == wb) == (a == b));
+            REQUIRE((wa != wb) == (a != b));
+            REQUIRE((wa < wb) == (a < b));
+            REQUIRE((wa <= wb) == (a <= b));
+            REQUIRE((wa > wb) == (a > b));
+            REQUIRE((wa >= wb) == (a >= b));
+            if (!b.is_zero()) {
+                REQUIRE(static_cast<int_t>(wa / wb) == a / b);
+                REQUIRE(static_cast<int_t>(wa % wb) == a % b);
+                wide q, r;
+                tdiv_qr(q, r, wa, wb);
+                REQUIRE(q * wb + r == wa);
+                // Overlapping arguments.
+                auto wc(wa);
+                tdiv_qr(wc, r, wc, wb);
+                REQUIRE(wc == q);
+            }
+
+            // Overflow detection.
+            wide r;
+            REQUIRE(add_overflow(r, wa, wb) == (a + b >= mod));
+            REQUIRE(static_cast<int_t>(r) == reduce(a + b));
+            REQUIRE(sub_overflow(r, wa, wb) == (a < b));
+            REQUIRE(static_cast<int_t>(r) == reduce(a - b));
+            REQUIRE(mul_overflow(r, wa, wb) == (a * b >= mod));
+            REQUIRE(static_cast<int_t>(r) == reduce(a * b));
+            // Overlapping arguments.
+            r = wa;
+            mul_overflow(r, r, r);
+            REQUIRE(static_cast<int_t>(r) == reduce(a * a));
+            r = wa;
+            r *= r;
+            REQUIRE(static_cast<int_t>(r) == reduce(a * a));
+            r = wa;
+            r += r;
+            REQUIRE(static_cast<int_t>(r) == reduce(a + a));
+
+            // Compound operators and mixed-mode operations.
+            r = wa;
+            r += 1;
+            REQUIRE(static_cast<int_t>(r) == reduce(a + 1));
+            r -= wb;
+            REQUIRE(static_cast<int_t>(r) == reduce(a + 1 - b));
+            r = 3 * wa;
+            REQUIRE(static_cast<int_t>(r) == reduce(3 * a));
+            r <<= 3;
+            REQUIRE(static_cast<int_t>(r) == reduce(24 * a));
+            r >>= 2;
+            REQUIRE(static_cast<int_t>(r) == reduce(24 * a) >> 2);
+            r &= wb;
+            r |= wa;
+            r ^= wb;
+            REQUIRE(static_cast<int_t>(r) == ((((reduce(24 * a) >> 2) & b) | a) ^ b));
+            if (!b.is_zero()) {
+                r = wa;
+                r /= wb;
+                REQUIRE(static_cast<int_t>(r) == a / b);
+                r = wa;
+                r %= wb;
+                REQUIRE(static_cast<int_t>(r) == a % b);
+            }
+        }
+    }
+};
+
+TEST_CASE("wide_uint")
+{
+    tuple_for_each(widths{}, wide_uint_tester{});
+}
+
+TEST_CASE("wide_uint large width")
+{
+    // Widths beyond the static size limit of integer.
+    using wide = wide_uint<8192>;
+    const auto mod = integer<1>{1} << 8192;
+    REQUIRE(wide{12345}.to_string() == "12345");
+    REQUIRE(wide{-1}.to_string(16) == std::string(2048, 'f'));
+    REQUIRE(wide{-1}.to_string() == (mod - 1).to_string());
+    std::ostringstream oss;
+    oss << (wide{1} << 8191);
+    REQUIRE(oss.str() == (mod >> 1).to_string());
+}